@@ -0,0 +1,257 @@
+#ifndef BAG_SCHED_H
+#define BAG_SCHED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <rte_common.h>
+#include <rte_branch_prediction.h>
+#include "config.h"
+
+// ==========================================
+// AFDX BAG SCHEDULER (TX lcore başına timer wheel)
+// ==========================================
+// Her VL kendi BAG'i (iki frame arası minimum süre), Lmax'ı (frame boyutu)
+// ve jitter bütçesi ile gönderilir. Zamanlama TX worker'a özel bir timer
+// wheel (calendar queue) ile yapılır:
+//
+//   - Zaman, 2'nin kuvveti cycle'lık tick'lere bölünür (BAG_SCHED_TICK_NS).
+//     Wheel'de tick başına bir slot vardır; slot, o tick'te zamanı gelen
+//     VL'lerin tek yönlü listesinin başıdır (VL başına 16-bit link, ek bellek yok).
+//   - Wheel boyutu > 3 × en büyük BAG: poll en fazla en büyük BAG kadar
+//     geride kalır (yoksa resync), atlamalı yeniden planlama da due'yu
+//     earliest + BAG'den (≤ cur + 3 × BAG) öteye taşımaz. Yeniden planlanan
+//     VL daima bir tur içindeki slota düşer; pop yine de due > now_tick
+//     olanı (sonraki tur) slotta bırakır.
+//   - Paket başına maliyet: slot başından pop + due += BAG + push → O(1),
+//     VL sayısından bağımsız. Boş slotlar tick başına bir load ile geçilir.
+//   - Faz korunur: due = önceki due + BAG (gönderim anına göre değil), VL'ler
+//     başlangıçta BAG'leri içine eşit dağıtılır.
+//   - Geride kalma: geç çıkan frame'den sonraki frame, BAG - jitter bütçesi
+//     dolmadan çıkacaksa aradaki BAG'ler atlanır (skipped), catch-up burst'ü
+//     yapılmaz → ardışık frame'ler arası süre BAG - jitter bütçesinden kısa
+//     olmaz. Worker en büyük BAG'den uzun süre durursa wheel baştan kurulur
+//     (resync, O(VL)).
+//
+// Uygunluk (VL başına): frame, BAG başlangıcından (nominal zaman) en fazla
+// jitter bütçesi kadar geç çıkmalı (late), ardışık iki frame arası süre
+// BAG - jitter bütçesinden kısa olmamalı (min_gap). Sayaçlar tek yazarlıdır
+// (worker), stats lcore bag_sched_print_stats() ile okur.
+
+#define BAG_SCHED_MAX          64          // Kayıtlı scheduler (TX worker) sayısı
+#define BAG_SCHED_WHEEL_MAX    (1u << 18)  // Slot üst sınırı, aşılırsa tick büyütülür
+#define BAG_VL_NONE            0xFFFF
+
+/**
+ * Profil satırı: [vl_first, vl_last] aralığındaki VL'ler (config.h BAG_PROFILE_INIT)
+ */
+struct bag_profile_entry {
+    uint16_t vl_first;
+    uint16_t vl_last;
+    uint32_t bag_us;        // 0 = satır kullanılmaz
+    uint16_t lmax;          // 0 = modun paket boyutu
+    uint16_t jitter_us;
+};
+
+// Hot: poll/commit her paket için dokunur
+struct bag_vl {
+    uint64_t due;           // Nominal gönderim tick'i
+    uint32_t bag;           // BAG (tick, yukarı yuvarlanmış)
+    uint32_t jitter_budget; // cycles
+    uint16_t next;          // Wheel slot listesi
+    uint16_t pkt_size;
+};
+
+// Cold: sadece sahibi yazar (relaxed), stats lcore okur
+struct bag_vl_stats {
+    uint64_t sent;
+    uint64_t late;          // Nominal zamandan jitter bütçesinden geç çıkan
+    uint64_t skipped;       // Geride kalındığı için atlanan BAG sayısı
+    uint64_t tx_full;       // mbuf / TX ring dolu, frame gönderilemedi
+    uint64_t max_jitter;    // cycles (çıkış - nominal)
+    uint64_t min_gap;       // cycles, ardışık iki çıkış arası (0 = henüz yok)
+    uint64_t last_tx;       // cycles
+};
+
+struct bag_sched {
+    struct bag_vl *vl;              // [vl_count], index = worker VL offset
+    struct bag_vl_stats *st;        // [vl_count]
+    uint32_t *bag_us;               // [vl_count], rapor için
+    uint16_t *wheel;                // [wheel_mask + 1] slot başları
+    uint64_t base;                  // Tick 0'ın TSC değeri
+    uint64_t cur;                   // Boşaltılan slot'un tick'i
+    uint64_t max_bag;               // ticks
+    uint64_t resyncs;
+    double offered_bps;             // Σ Lmax × 8 / BAG (L2 frame, preamble/IFG hariç)
+    double offered_pps;
+    uint32_t wheel_mask;
+    uint32_t epoch;                 // Uygulanan son reset epoch'u (sadece sahibi yazar)
+    uint8_t tick_shift;
+    uint16_t vl_start;
+    uint16_t vl_count;
+    uint16_t port_id;
+    uint16_t queue_id;
+} __rte_cache_aligned;
+
+extern uint32_t bag_sched_epoch;
+
+/**
+ * Create (or return the existing) scheduler of a TX worker
+ * VL'ler [vl_start, vl_start + vl_count): BAG / Lmax / jitter profil tablosundan,
+ * profilde olmayanlar için BAG_DEFAULT_US (0 ise default_bag_cycles).
+ * Başlangıçta çağrılır (hot path değil), registry kısa bir lock ile korunur.
+ * @return scheduler pointer, NULL on allocation failure or registry full
+ */
+struct bag_sched *bag_sched_create(uint16_t port_id, uint16_t queue_id,
+                                   uint16_t vl_start, uint16_t vl_count,
+                                   uint64_t default_bag_cycles, int socket_id);
+
+/**
+ * VL'in profil BAG'i ve jitter bütçesi (profil satırı, yoksa BAG_DEFAULT_US)
+ * RX tarafı (rx_bag.h) beklenen BAG için kullanır.
+ * @return false if the VL has no configured BAG
+ */
+bool bag_profile_vl(uint16_t vl_id, uint32_t *bag_us, uint16_t *jitter_us);
+
+/**
+ * (Re)start the schedule at start_tsc: VL fazları BAG içine eşit dağıtılır
+ * Worker başında sahibi çağırır, sayaçlara dokunmaz.
+ */
+void bag_sched_start(struct bag_sched *s, uint64_t start_tsc);
+
+/**
+ * Tüm scheduler'ların uygunluk sayaçlarına sıfırlama iste (warm-up reset)
+ */
+void bag_sched_reset(void);
+
+// Sahibi çağırır (epoch değiştiğinde), bag_sched_sync üzerinden
+void bag_sched_clear(struct bag_sched *s);
+
+// Worker en büyük BAG'den uzun süre geride kaldı: wheel'i now_tick'e göre yeniden kur
+void bag_sched_resync(struct bag_sched *s, uint64_t now_tick);
+
+// Profil tablosu + startup'ta tek satırlık özet
+void bag_sched_print_config(const struct bag_sched *s);
+
+// Saniyelik tablo: worker başına VL, gönderilen, late/skipped, uygun VL oranı
+void bag_sched_print_stats(void);
+
+// Test sonu: uygun olmayan VL'lerin listesi
+void bag_sched_print_vl_report(void);
+
+// ==========================================
+// HOT PATH (sadece scheduler sahibi çağırır)
+// ==========================================
+
+// Döngü başına bir kez: bekleyen reset varsa uygula
+static inline void bag_sched_sync(struct bag_sched *s)
+{
+    if (unlikely(s->epoch != __atomic_load_n(&bag_sched_epoch, __ATOMIC_ACQUIRE)))
+        bag_sched_clear(s);
+}
+
+static inline void bag_wheel_push(struct bag_sched *s, uint16_t idx)
+{
+    uint16_t *head = &s->wheel[s->vl[idx].due & s->wheel_mask];
+
+    s->vl[idx].next = *head;
+    *head = idx;
+}
+
+static inline void bag_stat_set(uint64_t *ctr, uint64_t v)
+{
+    __atomic_store_n(ctr, v, __ATOMIC_RELAXED);
+}
+
+/**
+ * Pop up to max VLs whose BAG has started by now and schedule their next frame
+ * Dönen VL'ler bu çağrıda bir kez yer alır (aynı burst'te tekrar yok).
+ * @param out VL offset'leri (vl_start'a göre)
+ * @return number of due VLs
+ */
+static inline uint16_t bag_sched_poll(struct bag_sched *s, uint64_t now,
+                                      uint16_t *out, uint16_t max)
+{
+    if (unlikely(now < s->base))
+        return 0;
+
+    const uint64_t now_tick = (now - s->base) >> s->tick_shift;
+    uint16_t n = 0;
+
+    if (unlikely(now_tick > s->cur && now_tick - s->cur > s->max_bag))
+        bag_sched_resync(s, now_tick);
+
+    while (n < max && s->cur <= now_tick) {
+        uint16_t *link = &s->wheel[s->cur & s->wheel_mask];
+
+        // Sonraki turun VL'i (due > now_tick) slotta kalır: BAG'i dolmadan
+        // çıkmaz. Wheel > 3 × en büyük BAG olduğundan normalde liste boş geçilir.
+        while (*link != BAG_VL_NONE && unlikely(s->vl[*link].due > now_tick))
+            link = &s->vl[*link].next;
+
+        const uint16_t idx = *link;
+        if (idx == BAG_VL_NONE) {
+            s->cur++;
+            continue;
+        }
+
+        struct bag_vl *v = &s->vl[idx];
+        struct bag_vl_stats *st = &s->st[idx];
+        *link = v->next;
+
+        // Çıkış - nominal (due ≤ now_tick olduğundan negatif olmaz)
+        const uint64_t jitter = now - (s->base + (v->due << s->tick_shift));
+        if (jitter > st->max_jitter)
+            bag_stat_set(&st->max_jitter, jitter);
+        if (unlikely(jitter > v->jitter_budget))
+            bag_stat_set(&st->late, st->late + 1);
+
+        // Faz koruyan yeniden planlama: sonraki frame bu çıkıştan en az
+        // BAG - jitter bütçesi sonra (ve bu poll'dan sonra) olmalı, aradaki
+        // BAG'ler atlanır. Zamanında çıkan frame'de atlama olmaz.
+        const uint64_t jit_ticks = v->jitter_budget >> s->tick_shift;
+        const uint64_t earliest = now_tick + (jit_ticks < v->bag ? v->bag - jit_ticks : 1);
+        uint64_t next = v->due + v->bag;
+        if (unlikely(next < earliest)) {
+            const uint64_t k = (earliest - next + v->bag - 1) / v->bag;
+            next += k * v->bag;
+            bag_stat_set(&st->skipped, st->skipped + k);
+        }
+        v->due = next;
+        bag_wheel_push(s, idx);
+
+        out[n++] = idx;
+    }
+    return n;
+}
+
+/**
+ * Account a burst built from bag_sched_poll output: ilk nb_sent frame çıktı,
+ * kalanı (TX ring / mbuf dolu) gönderilemedi.
+ */
+static inline void bag_sched_commit(struct bag_sched *s, const uint16_t *idx,
+                                    uint16_t n, uint16_t nb_sent, uint64_t now)
+{
+    for (uint16_t i = 0; i < nb_sent; i++) {
+        struct bag_vl_stats *st = &s->st[idx[i]];
+        const uint64_t last = st->last_tx;
+
+        if (likely(last != 0)) {
+            const uint64_t gap = now - last;
+            if (st->min_gap == 0 || gap < st->min_gap)
+                bag_stat_set(&st->min_gap, gap);
+        }
+        bag_stat_set(&st->last_tx, now);
+        bag_stat_set(&st->sent, st->sent + 1);
+    }
+    for (uint16_t i = nb_sent; i < n; i++) {
+        struct bag_vl_stats *st = &s->st[idx[i]];
+        bag_stat_set(&st->tx_full, st->tx_full + 1);
+    }
+}
+
+static inline uint16_t bag_sched_pkt_size(const struct bag_sched *s, uint16_t idx)
+{
+    return s->vl[idx].pkt_size;
+}
+
+#endif /* BAG_SCHED_H */
@@ -0,0 +1,38 @@
+#ifndef BURST_TEST_H
+#define BURST_TEST_H
+
+#include <stdbool.h>
+#include "config.h"
+#include "port.h"
+
+// ==========================================
+// BACK-TO-BACK BURST CAPACITY TEST
+// ==========================================
+// Switch buffer boyutlandırması için, port ve VLAN priority sınıfı başına
+// kayıpsız iletilen en uzun line-rate burst'ü bulur (BURST_TEST_ENABLED):
+//
+//   1. Burst önceden mbuf'lara render edilir: paket i, portun TX queue'larına
+//      sırayla (VLAN = queue'nun VLAN'ı, VL = queue VL aralığında i'ye göre)
+//      dağıtılır, PCP sınıftan gelir. SEQ alanı = (etiket << 32) | i.
+//   2. Main lcore burst'ü TX queue 0'dan aralıksız gönderir, aynı anda paired
+//      RX portunun (p±1) tüm queue'larını boşaltır; etiketli frame'ler sayılır.
+//   3. BURST_TEST_DRAIN_MS sonra alınan < gönderilen ise burst kayıplıdır.
+//      RX imissed artmışsa kayıp tester'ındır: sonuç "tester-limited".
+//   4. Health monitor çalışıyorsa yeni döngünün sayaçları beklenir; switch
+//      portlarının toplam queue overflow (HP / LP / BE / toplam) ve policy
+//      drop farkı burst'e yazılır.
+//   5. Uzunluk 1'den ikiye katlanarak BURST_TEST_MAX_PKTS'e kadar artar;
+//      ilk kayıptan sonra son kayıpsız ile ilk kayıplı arasında binary search.
+//
+// Sonuç tablosu: port × sınıf için kayıpsız en uzun burst (paket, byte) ve
+// ilk kayıplı burst'ün kaybı ile overflow farkları. Normal TX/RX worker'ları
+// başlamadan çalışır: test süresince portlarda başka trafik yoktur.
+
+/**
+ * Run the burst search on every TX port (main lcore, blocking)
+ * start_latency_test() sonrası, start_txrx_workers() öncesi çağrılır.
+ * @return 0 when all ports finished, -1 on setup error or stop
+ */
+int start_burst_test(struct ports_config *ports_config, volatile bool *stop_flag);
+
+#endif /* BURST_TEST_H */
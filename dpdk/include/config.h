@@ -26,6 +26,238 @@
 #define TB_PACKETS_PER_VL_PER_WINDOW 1
 #endif
 
+// ==========================================
+// BURST TX MODE (tx_worker)
+// ==========================================
+// 0 = Her pacing slot'unda tek paket, tek rte_eth_tx_burst çağrısı (mevcut)
+// 1 = TX_BURST_WINDOW_US içinde zamanı gelen tüm paketler tek burst'te gönderilir
+//
+// Smooth pacing ve TOKEN_BUCKET_TX_ENABLED semantiği (ortalama rate, catch-up
+// politikası, faz ofsetleri) her iki modda da aynıdır; burst modu sadece
+// pencere içindeki slotları birleştirerek doorbell/descriptor maliyetini böler.
+// Paketler hiçbir zaman slot zamanından ÖNCE gönderilmez, en fazla
+// TX_BURST_WINDOW_US kadar geç gönderilir.
+#ifndef TX_BURST_MODE_ENABLED
+#define TX_BURST_MODE_ENABLED 0
+#endif
+
+// Toplama penceresi (mikrosaniye)
+#ifndef TX_BURST_WINDOW_US
+#define TX_BURST_WINDOW_US 20
+#endif
+
+// Tek rte_eth_tx_burst çağrısındaki maksimum paket sayısı
+#ifndef TX_BURST_MAX_PKTS
+#define TX_BURST_MAX_PKTS 32
+#endif
+
+// Hat üzerinde oluşan microburst üst sınırı (byte, tek burst için)
+// Switch buffer koruması: burst boyutu min(TX_BURST_MAX_PKTS, bu / paket boyutu)
+#ifndef TX_BURST_MAX_MICROBURST_BYTES
+#define TX_BURST_MAX_MICROBURST_BYTES (32 * 1024)
+#endif
+
+// ==========================================
+// AFDX BAG SCHEDULER (tx_worker)
+// ==========================================
+// 0 = VL aralığı tek bir toplam rate ile round-robin gönderilir (mevcut)
+// 1 = Her VL kendi BAG (Bandwidth Allocation Gap), Lmax ve jitter bütçesi
+//     ile gönderilir. TX lcore başına timer wheel (bag_sched.h): paket başına
+//     O(1), VL sayısından bağımsız. Zamanı gelen VL'ler TX_BURST_MAX_PKTS'e
+//     kadar tek burst'te çıkar; bir VL'in ardışık iki frame'i arası
+//     BAG - jitter bütçesinden kısa olmaz (geride kalınırsa BAG atlanır,
+//     catch-up yok).
+//     Toplam rate profil tarafından belirlenir, limiter rate'i kullanılmaz.
+// Profilde olmayan VL'ler BAG_DEFAULT_US ile gönderilir
+// (0 = mevcut moddaki round-robin periyodu: aynı toplam rate).
+#ifndef BAG_SCHED_ENABLED
+#define BAG_SCHED_ENABLED 0
+#endif
+
+// Timer wheel çözünürlüğü (ns, TSC'de en yakın 2'nin kuvvetine yuvarlanır)
+#ifndef BAG_SCHED_TICK_NS
+#define BAG_SCHED_TICK_NS 1000
+#endif
+
+#ifndef BAG_DEFAULT_US
+#define BAG_DEFAULT_US 0
+#endif
+
+// Jitter bütçesi: frame, BAG başlangıcından en fazla bu kadar geç çıkabilir
+// (ARINC 664 P7 end system sınırı 500 us)
+#ifndef BAG_DEFAULT_JITTER_US
+#define BAG_DEFAULT_JITTER_US 500
+#endif
+
+// Per-VL profil: { vl_first, vl_last, bag_us, lmax, jitter_us }
+// lmax = 0 → modun paket boyutu. IMIX kapalıyken RX sabit boyut doğruladığı için
+// lmax PACKET_SIZE'a sabitlenir. Örnek (AFDX BAG'leri 1..128 ms, 2'nin kuvveti):
+//   { 3, 34, 1000, 0, 500 }, { 35, 66, 2000, 0, 500 }, { 67, 130, 8000, 0, 500 }
+#ifndef BAG_PROFILE_INIT
+#define BAG_PROFILE_INIT { { 0, 0, 0, 0, 0 } }
+#endif
+
+// ==========================================
+// ZERO-COPY PRBS TX (tx_worker + external TX)
+// ==========================================
+// 0 = PRBS payload her mbuf'a port penceresinden kopyalanır (mevcut)
+// 1 = 2 segmentli mbuf: header+SEQ segmenti + paylaşılan PRBS dizisine işaret eden
+//     extbuf segmenti (rte_pktmbuf_attach_extbuf). PRBS kopyası yok.
+// NIC RTE_ETH_TX_OFFLOAD_MULTI_SEGS desteklemiyorsa otomatik kopya yoluna düşer.
+#ifndef TX_ZEROCOPY_PRBS_ENABLED
+#define TX_ZEROCOPY_PRBS_ENABLED 0
+#endif
+
+// TX queue başına extbuf segment havuzu (TX_RING_SIZE + burst + cache payı)
+#ifndef TX_ZEROCOPY_EXT_POOL_SIZE
+#define TX_ZEROCOPY_EXT_POOL_SIZE 4095
+#endif
+
+// Header template mikrobenchmark'ı (startup'ta cycles/paket: eski builder vs template)
+#ifndef HDR_TEMPLATE_BENCH_ENABLED
+#define HDR_TEMPLATE_BENCH_ENABLED 0
+#endif
+
+// PRBS verify mikrobenchmark'ı (startup'ta temiz/hatalı paket Mpps, her kernel)
+#ifndef PRBS_VERIFY_BENCH_ENABLED
+#define PRBS_VERIFY_BENCH_ENABLED 0
+#endif
+
+// RX PRBS doğrulama engine'i, RX port başına bit maskesi (bit n = port n)
+// 0 bit = cache yolu: beklenen payload port penceresinden okunur (mevcut)
+// 1 bit = LFSR yolu: seq'ten jump-ahead + register'da üretim, pencere okunmaz.
+//         >10G portlarda / az hugepage'li host'ta LLC thrash'ini önler.
+// Örn: 0x3000 = raw port 12, 13
+#ifndef PRBS_VERIFY_LFSR_PORT_MASK
+#define PRBS_VERIFY_LFSR_PORT_MASK 0x0000
+#endif
+
+// Paylaşılan PRBS dizisi üretimi/faz taraması için lcore sayısı
+// (0 = home NUMA node'daki tüm boş lcore'lar + main)
+#ifndef PRBS_GEN_MAX_LCORES
+#define PRBS_GEN_MAX_LCORES 0
+#endif
+
+// Paylaşılan PRBS dizisini restart'lar arasında dosyada sakla
+// 1 = PRBS_SEQ_FILE_DIR (yoksa /dev/shm) altında node başına dosya; sonraki
+//     başlangıçlar faz taraması + üretim yerine dosyayı read-only mmap eder.
+//     Header (polinom/seed/uzunluk/checksum) tutmazsa dosya yeniden üretilir.
+// 0 = her başlangıçta rte_malloc + üretim (mevcut)
+#ifndef PRBS_SEQ_FILE_ENABLED
+#define PRBS_SEQ_FILE_ENABLED 1
+#endif
+
+#ifndef PRBS_SEQ_FILE_DIR
+#define PRBS_SEQ_FILE_DIR "/dev/hugepages"
+#endif
+
+// PRBS generator benchmark'ı (startup'ta GB/s: bit-seri, 8-bit, 64-bit, çok lcore)
+#ifndef PRBS_GEN_BENCH_ENABLED
+#define PRBS_GEN_BENCH_ENABLED 0
+#endif
+
+// Per-lcore TX pps tablosu (her saniye ana istatistik tablosunun altına basılır)
+#ifndef TX_LCORE_STATS_ENABLED
+#define TX_LCORE_STATS_ENABLED 0
+#endif
+
+// ==========================================
+// IN-BAND LATENCY / JITTER (tx_worker → rx_worker, tam trafik altında)
+// ==========================================
+// 1 = Her DPDK TX paketi SEQ'in arkasında TX TSC taşır:
+//       [SEQ 8B][TX TSC 8B][PRBS ...]
+//     PRBS offset'i değişmez, akışın ilk 8 byte'ının yerine TSC yazılır
+//     (paket boyutu ve PRBS hizası normal modla aynı). RX worker'lar queue'ya
+//     özel VL başına latency + jitter histogramı tutar, stats lcore port ve
+//     DTN port bazında birleştirir (latency_hist.h).
+//     TX ve RX aynı host'ta, invariant/senkron TSC varsayılır.
+// 0 = [SEQ 8B][PRBS ...] (mevcut). Karşı taraf payload PRBS'ini baştan
+//     doğruluyorsa 0 kalmalı.
+// DPDK external TX ve raw socket paketleri bu düzeni kullanmaz.
+#ifndef INBAND_LATENCY_ENABLED
+#define INBAND_LATENCY_ENABLED 0
+#endif
+
+// RX queue başına histogram tutulan VL sayısı (sabit bellek, aşan VL'ler
+// queue'nun ortak "diğer" satırına yazılır, jitter'ları tutulmaz).
+// VL başına ~2.6 KB (latency + jitter, 160 × 64-bit bucket): 256 → ~670 KB/queue
+#ifndef LAT_HIST_VL_PER_QUEUE
+#define LAT_HIST_VL_PER_QUEUE 256
+#endif
+
+// ==========================================
+// RX BAG / JITTER CONFORMANCE ANALYZER (rx_worker)
+// ==========================================
+// 1 = Her RX queue, aldığı her VL için ardışık iki frame arası süreyi
+//     (inter-arrival) ölçer: min/ortalama/max gap, beklenen BAG'e göre jitter
+//     histogramı, BAG - jitter bütçesinden kısa gelen frame sayısı (ihlal).
+//     Beklenen BAG: BAG_PROFILE_INIT / BAG_DEFAULT_US (bag_sched ile aynı
+//     tablo). Profilde olmayan VL'lerde jitter = |gap - önceki gap|, ihlal
+//     sayılmaz. Sonuçlar health monitor'ün DUT policing sayaçlarıyla
+//     (traffic policy drop, max delay err) yan yana basılır (rx_bag.h).
+//     VL başına 64 B, queue'ya özel, paket başına kilit / syscall yok.
+#ifndef RX_BAG_MONITOR_ENABLED
+#define RX_BAG_MONITOR_ENABLED 0
+#endif
+
+// 1 = NIC RX timestamp (RTE_ETH_RX_OFFLOAD_TIMESTAMP + mbuf dynfield)
+//     kullanılır, NIC saati başlangıçta TSC'ye göre kalibre edilir.
+//     Offload veya rte_eth_read_clock desteklenmiyorsa port burst TSC'ye düşer.
+// 0 = Burst başına bir TSC (gap çözünürlüğü burst süresi kadar)
+#ifndef RX_BAG_HW_TIMESTAMP
+#define RX_BAG_HW_TIMESTAMP 0
+#endif
+
+// ==========================================
+// LIVE CONTROL (çalışırken rate / VL / IMIX değişikliği)
+// ==========================================
+// 1 = Main lcore, stats döngüsünde LIVE_CTL_SOCKET_PATH Unix datagram
+//     socket'ini dinler (live_ctl.h). "rate", "vls", "imix", "reload"
+//     komutları DPDK TX worker'larının parametre bloğunu RCU tarzı değiştirir
+//     (tx_live.h): worker döngü başına bir pointer karşılaştırır, yeni bloğa
+//     geçince eskisi serbest bırakılır. Sequence'lar ve RX tracker'ları
+//     olduğu gibi kalır, restart / warm-up / latency testleri tekrarlanmaz.
+//     Token bucket ve BAG build'lerinde pacing VL düzeninden gelir, TX
+//     komutları reddedilir.
+#ifndef LIVE_CTL_ENABLED
+#define LIVE_CTL_ENABLED 1
+#endif
+
+#ifndef LIVE_CTL_SOCKET_PATH
+#define LIVE_CTL_SOCKET_PATH "/tmp/dpdk_app.ctl"
+#endif
+
+// ==========================================
+// RFC 2544 THROUGHPUT SEARCH (rfc2544.h)
+// ==========================================
+// 1 = Worker'lar başladıktan sonra, stats döngüsünden önce port grubu başına
+//     kayıpsız en yüksek rate binary search ile bulunur. Trial'lar çalışan
+//     TX worker'larının rate'ini canlı değiştirir (tx_live, restart yok);
+//     karar stats snapshot'ındaki loss / PRBS sayaçlarından verilir.
+//     Frame boyutu taraması IMIX_ENABLED build'lerde yapılır (uniform pattern),
+//     aksi halde tek satır: PACKET_SIZE.
+#ifndef RFC2544_ENABLED
+#define RFC2544_ENABLED 0
+#endif
+
+// Grup başına port bitmask'ı (aynı offered load), kayıp paired RX portlarında
+// ölçülür. 0 = aktif her port ayrı bir grup.
+#define RFC2544_PORT_GROUPS_INIT { 0 }
+
+// Frame boyutları (VLAN dahil, FCS hariç). IMIX_MIN_PACKET_SIZE altı atlanır
+// (RX short packet filtresi), IMIX satırı profildeki pattern ile eklenir.
+#define RFC2544_FRAME_SIZES_INIT { 64, 128, 256, 512, 1024, 1280, 1518 }
+#define RFC2544_IMIX_ROW 1
+
+#define RFC2544_TRIAL_SEC        10     // Ölçüm penceresi (RFC 2544: 60 s)
+#define RFC2544_SETTLE_MS        2000   // Rate değişiminden sonra, ölçümden önce
+#define RFC2544_MAX_GBPS         0.0    // Port başına üst sınır, 0 = link hızı (L2)
+#define RFC2544_RESOLUTION_PCT   0.5    // Arama durur: (hi - lo) <= max × %
+#define RFC2544_MAX_TRIALS       20
+#define RFC2544_LOSS_TOL_PPM     0      // İzin verilen kayıp (RFC 2544: 0)
+#define RFC2544_TX_MIN_PCT       98.0   // Gönderilen / offered bunun altındaysa tester-limited
+#define RFC2544_EXIT_WHEN_DONE   1      // 0 = sonuçtan sonra profil rate'leriyle devam
+
 // ==========================================
 // LATENCY TEST CONFIGURATION
 // ==========================================
@@ -44,6 +276,44 @@
 #define LATENCY_TEST_TIMEOUT_SEC 5    // Paket bekleme timeout (saniye)
 #define LATENCY_TEST_PACKET_SIZE 1518 // Test paketi boyutu (MAX)
 
+// ==========================================
+// BURST CAPACITY TEST (switch buffer sizing)
+// ==========================================
+// Etkinleştirildiğinde normal moddan önce (latency testinden sonra) her TX
+// port ve VLAN priority sınıfı için line-rate back-to-back burst gönderilir:
+// - Burst uzunluğu 1, 2, 4, ... BURST_TEST_MAX_PKTS; ilk kayıptan sonra son
+//   kayıpsız ile ilk kayıplı arasında binary search
+// - Burst portun tüm VLAN / VL'lerine dağıtılır (VL başına birkaç paket,
+//   BAG policing'e takılmasın); policy drop yine de raporlanır
+// - Kayıp paired RX portunda (p±1) sayılır; RX imissed artarsa sonuç
+//   "tester-limited" işaretlenir
+// - Health monitor çalışıyorsa switch queue overflow (HP / LP / BE / toplam)
+//   farkları ilk kayıplı burst'le birlikte basılır. BURST_TEST_HEALTH_WAIT 1
+//   ise her burst sonrası yeni döngü beklenir (fark o burst'e aittir); 0 ise
+//   beklenmez, sayaçlar o anki değerden okunur (fark sonraki burst'lere kayabilir)
+// - Sınıf sadece 802.1Q PCP'yi değiştirir. DUT kuyruğu VL tablosundan
+//   seçiyorsa HP / LP / BE overflow sütunları hangi kuyruğun taştığını
+//   yine gösterir.
+
+#ifndef BURST_TEST_ENABLED
+#define BURST_TEST_ENABLED 0
+#endif
+
+// En uzun burst (paket). TX_RING_SIZE'dan (2048) uzun burst'ler bt_trial'daki
+// refill döngüsüyle gönderilir: ring dolunca RX o döngü içinde poll edilir ve
+// yer açıldıkça ring yeniden doldurulur. Ring'den uzun burst'lerde back-to-back
+// gönderim bu döngünün ring boşalmadan yetişmesine bağlıdır.
+#define BURST_TEST_MAX_PKTS     4096
+#define BURST_TEST_PACKET_SIZE  PACKET_SIZE  // Frame boyutu (VLAN dahil, FCS hariç)
+#define BURST_TEST_DRAIN_MS     50     // Burst sonrası RX bekleme (switch kuyruğu boşalsın)
+#define BURST_TEST_REPEAT       1      // Burst uzunluğu başına tekrar (hepsi kayıpsız olmalı)
+#ifndef BURST_TEST_HEALTH_WAIT
+#define BURST_TEST_HEALTH_WAIT  1      // 1 = her burst sonrası yeni health döngüsü bekle
+#endif
+
+// { isim, PCP } - VLAN kapalı build'lerde tek sınıf ("ALL") kullanılır
+#define BURST_TEST_CLASSES_INIT { { "HP", 7 }, { "LP", 3 }, { "BE", 0 } }
+
 // ==========================================
 // IMIX (Internet Mix) CONFIGURATION
 // ==========================================
@@ -108,25 +378,37 @@
 #define RAW_SOCKET_PORT_ID_START 12
 #define MAX_RAW_TARGETS 8 // Maksimum hedef sayısı per port
 
+// *_BACKEND: RAW_BACKEND_AF_PACKET veya RAW_BACKEND_AF_XDP (raw_xdp.h), port başına
+// *_TX_SUBMIT: AF_PACKET TX gönderim yolu (raw_tx_batch.h), port başına:
+//   RAW_TX_SUBMIT_RING (PACKET_TX_RING), RAW_TX_SUBMIT_SENDMMSG, RAW_TX_SUBMIT_IO_URING
+
 // Port 12 configuration (1G copper)
 #define RAW_SOCKET_PORT_12_PCI "01:00.0"
 #define RAW_SOCKET_PORT_12_IFACE "eno12399"
 #define RAW_SOCKET_PORT_12_IS_1G true
+#define RAW_SOCKET_PORT_12_BACKEND RAW_BACKEND_AF_PACKET
+#define RAW_SOCKET_PORT_12_TX_SUBMIT RAW_TX_SUBMIT_RING
 
 // Port 13 configuration (100M copper)
 #define RAW_SOCKET_PORT_13_PCI "01:00.1"
 #define RAW_SOCKET_PORT_13_IFACE "eno12409"
 #define RAW_SOCKET_PORT_13_IS_1G false
+#define RAW_SOCKET_PORT_13_BACKEND RAW_BACKEND_AF_PACKET
+#define RAW_SOCKET_PORT_13_TX_SUBMIT RAW_TX_SUBMIT_RING
 
 // Port 14 configuration (1G copper - ATE mode only)
 #define RAW_SOCKET_PORT_14_PCI "01:00.2"
 #define RAW_SOCKET_PORT_14_IFACE "eno12419"
 #define RAW_SOCKET_PORT_14_IS_1G true
+#define RAW_SOCKET_PORT_14_BACKEND RAW_BACKEND_AF_PACKET
+#define RAW_SOCKET_PORT_14_TX_SUBMIT RAW_TX_SUBMIT_RING
 
 // Port 15 configuration (100M copper - ATE mode only)
 #define RAW_SOCKET_PORT_15_PCI "01:00.3"
 #define RAW_SOCKET_PORT_15_IFACE "eno12429"
 #define RAW_SOCKET_PORT_15_IS_1G false
+#define RAW_SOCKET_PORT_15_BACKEND RAW_BACKEND_AF_PACKET
+#define RAW_SOCKET_PORT_15_TX_SUBMIT RAW_TX_SUBMIT_RING
 
 // ==========================================
 // MULTI-TARGET CONFIGURATION
@@ -279,6 +561,21 @@ struct raw_rx_source_config
     {.source_port = 13, .vl_id_start = 4131, .vl_id_count = 32},       \
 }
 
+// Raw port veri yolu (RAW_SOCKET_PORT_xx_BACKEND, profilde "backend =")
+enum raw_port_backend
+{
+  RAW_BACKEND_AF_PACKET = 0, // PACKET_MMAP TX ring + PACKET_FANOUT RX
+  RAW_BACKEND_AF_XDP,        // XSK + UMEM, XDP VL-ID yönlendirme (raw_xdp.h)
+};
+
+// AF_PACKET TX gönderim yolu (RAW_SOCKET_PORT_xx_TX_SUBMIT, profilde "tx_submit =")
+enum raw_tx_submit
+{
+  RAW_TX_SUBMIT_RING = 0,    // PACKET_TX_RING + send() kick, doluyken poll(1 ms)
+  RAW_TX_SUBMIT_SENDMMSG,    // Port havuzu + sendmmsg() batch (raw_tx_batch.h)
+  RAW_TX_SUBMIT_IO_URING,    // Registered buffer + WRITE_FIXED zinciri (raw_tx_batch.h)
+};
+
 // Raw socket port configuration structure
 struct raw_socket_port_config
 {
@@ -286,6 +583,8 @@ struct raw_socket_port_config
   const char *pci_addr;       // PCI address (for identification)
   const char *interface_name; // Kernel interface name
   bool is_1g_port;            // true for 1G, false for 100M
+  uint8_t backend;            // enum raw_port_backend (AF_XDP kurulamazsa AF_PACKET)
+  uint8_t tx_submit;          // enum raw_tx_submit (AF_PACKET; kurulamazsa TX ring)
 
   // TX targets
   uint16_t tx_target_count;
@@ -310,6 +609,8 @@ struct raw_socket_port_config
      .pci_addr = RAW_SOCKET_PORT_12_PCI,               \
      .interface_name = RAW_SOCKET_PORT_12_IFACE,       \
      .is_1g_port = RAW_SOCKET_PORT_12_IS_1G,           \
+     .backend = RAW_SOCKET_PORT_12_BACKEND,            \
+     .tx_submit = RAW_SOCKET_PORT_12_TX_SUBMIT,        \
      .tx_target_count = PORT_12_TX_TARGET_COUNT,       \
      .tx_targets = INIT_TX_TARGETS_12,                 \
      .rx_source_count = PORT_12_RX_SOURCE_COUNT,       \
@@ -320,6 +621,8 @@ struct raw_socket_port_config
       .pci_addr = RAW_SOCKET_PORT_13_PCI,              \
       .interface_name = RAW_SOCKET_PORT_13_IFACE,      \
       .is_1g_port = RAW_SOCKET_PORT_13_IS_1G,          \
+      .backend = RAW_SOCKET_PORT_13_BACKEND,           \
+      .tx_submit = RAW_SOCKET_PORT_13_TX_SUBMIT,       \
       .tx_target_count = PORT_13_TX_TARGET_COUNT,      \
       .tx_targets = INIT_TX_TARGETS_13,                \
       .rx_source_count = PORT_13_RX_SOURCE_COUNT,      \
@@ -340,6 +643,8 @@ struct raw_socket_port_config
      .pci_addr = RAW_SOCKET_PORT_12_PCI,                                \
      .interface_name = RAW_SOCKET_PORT_12_IFACE,                        \
      .is_1g_port = RAW_SOCKET_PORT_12_IS_1G,                            \
+     .backend = RAW_SOCKET_PORT_12_BACKEND,                             \
+     .tx_submit = RAW_SOCKET_PORT_12_TX_SUBMIT,                         \
      .tx_target_count = ATE_PORT_12_TX_TARGET_COUNT,                    \
      .tx_targets = ATE_PORT_12_TX_TARGETS_INIT,                         \
      .rx_source_count = ATE_PORT_12_RX_SOURCE_COUNT,                    \
@@ -349,6 +654,8 @@ struct raw_socket_port_config
      .pci_addr = RAW_SOCKET_PORT_13_PCI,                                \
      .interface_name = RAW_SOCKET_PORT_13_IFACE,                        \
      .is_1g_port = RAW_SOCKET_PORT_13_IS_1G,                            \
+     .backend = RAW_SOCKET_PORT_13_BACKEND,                             \
+     .tx_submit = RAW_SOCKET_PORT_13_TX_SUBMIT,                         \
      .tx_target_count = ATE_PORT_13_TX_TARGET_COUNT,                    \
      .tx_targets = ATE_PORT_13_TX_TARGETS_INIT,                         \
      .rx_source_count = ATE_PORT_13_RX_SOURCE_COUNT,                    \
@@ -358,6 +665,8 @@ struct raw_socket_port_config
      .pci_addr = RAW_SOCKET_PORT_14_PCI,                                \
      .interface_name = RAW_SOCKET_PORT_14_IFACE,                        \
      .is_1g_port = RAW_SOCKET_PORT_14_IS_1G,                            \
+     .backend = RAW_SOCKET_PORT_14_BACKEND,                             \
+     .tx_submit = RAW_SOCKET_PORT_14_TX_SUBMIT,                         \
      .tx_target_count = ATE_PORT_14_TX_TARGET_COUNT,                    \
      .tx_targets = ATE_PORT_14_TX_TARGETS_INIT,                         \
      .rx_source_count = ATE_PORT_14_RX_SOURCE_COUNT,                    \
@@ -367,6 +676,8 @@ struct raw_socket_port_config
      .pci_addr = RAW_SOCKET_PORT_15_PCI,                                \
      .interface_name = RAW_SOCKET_PORT_15_IFACE,                        \
      .is_1g_port = RAW_SOCKET_PORT_15_IS_1G,                            \
+     .backend = RAW_SOCKET_PORT_15_BACKEND,                             \
+     .tx_submit = RAW_SOCKET_PORT_15_TX_SUBMIT,                         \
      .tx_target_count = ATE_PORT_15_TX_TARGET_COUNT,                    \
      .tx_targets = ATE_PORT_15_TX_TARGETS_INIT,                         \
      .rx_source_count = ATE_PORT_15_RX_SOURCE_COUNT,                    \
@@ -957,6 +1268,27 @@ struct ptp_session_config
 #define ATE_HEALTH_MONITOR_ENABLED 0
 #endif
 
+// ==========================================
+// RAW VL-ID FLOW STEERING (DPDK RX)
+// ==========================================
+// Raw socket portlarının (12/13) DPDK portlarına gönderdiği VLAN'sız (0x0800)
+// trafik VLAN kurallarına uymaz ve RSS'e düşer: aynı VL birden fazla queue'ya
+// bölünür, queue içi sıra/kayıp merge'de sadece tahmin olur.
+//
+// RAW_VL_FLOW_STEERING_ENABLED=1: raw port tx_targets'tan üretilen rte_flow
+// kuralları her hedefin VL aralığını tek bir RX queue'ya sabitler
+// (hedef sırası % NUM_RX_CORES). VL aralığı hizalı 2^k bloklara bölünür,
+// her blok tek kural (maskeli eşleşme):
+//   1. ETH DST MAC byte 4-5 (VL-ID) + type 0x0800
+//   2. PMD reddederse IPv4 DST 224.224.X.X (aynı VL-ID, byte 2-3)
+//   3. O da olmazsa RSS (eski davranış)
+
+#ifndef RAW_VL_FLOW_STEERING_ENABLED
+#define RAW_VL_FLOW_STEERING_ENABLED 1
+#endif
+
+#define RAW_VL_FLOW_MAX_RULES_PER_PORT 64   // Port başına blok kuralı üst sınırı
+
 // ==========================================
 // DTN PORT-BASED STATISTICS MODE
 // ==========================================
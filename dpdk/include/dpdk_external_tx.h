@@ -5,9 +5,9 @@
 #include <stdbool.h>
 #include <rte_mbuf.h>
 #include <rte_mempool.h>
-#include <rte_atomic.h>
 #include "config.h"
 #include "port.h"
+#include "stats_shard.h"
 
 // ==========================================
 // DPDK EXTERNAL TX SYSTEM
@@ -31,15 +31,6 @@ struct dpdk_ext_tx_worker_params {
     volatile bool *stop_flag;
 };
 
-// Per-port external TX statistics
-struct dpdk_ext_tx_stats {
-    rte_atomic64_t tx_pkts;     // Gönderilen paket sayısı
-    rte_atomic64_t tx_bytes;    // Gönderilen byte sayısı
-};
-
-// Global external TX statistics
-extern struct dpdk_ext_tx_stats dpdk_ext_tx_stats_per_port[DPDK_EXT_TX_PORT_COUNT];
-
 // External TX port runtime structure
 struct dpdk_ext_tx_port {
     uint16_t port_id;
@@ -47,18 +38,19 @@ struct dpdk_ext_tx_port {
     struct dpdk_ext_tx_port_config config;
     struct rte_mempool *mbuf_pool;
 
-    // PRBS cache (shared with main system or separate)
-    uint8_t *prbs_cache_ext;
-    size_t prbs_cache_size;
+    // PRBS window (shared sequence, see prbs_seq.h)
+    const struct prbs_window *prbs_win;
     bool prbs_initialized;
 
-    // Per-VL-ID sequence numbers
-    uint64_t *vl_sequences;  // [MAX_VL_ID + 1]
+    // Per-VL-ID sequence'lar worker'a aittir (tx_sequence.h, TX_SEQ_DOMAIN_DPDK_EXT)
 };
 
 // Global external TX ports array
 extern struct dpdk_ext_tx_port dpdk_ext_tx_ports[DPDK_EXT_TX_PORT_COUNT];
 
+// Port / hedef tablosu (dpdk_ext_tx_init bunu dpdk_ext_tx_ports'a kopyalar)
+extern struct dpdk_ext_tx_port_config dpdk_ext_tx_configs[DPDK_EXT_TX_PORT_COUNT];
+
 /**
  * Initialize the DPDK external TX system
  * @param mbuf_pools Array of mbuf pools for each port
@@ -83,23 +75,19 @@ int dpdk_ext_tx_worker(void *arg);
 
 /**
  * Get external TX statistics for a port
+ * @param snap Collector snapshot (stats_snapshot_take, STATS_DOM_EXT_TX)
  * @param port_id DPDK port ID
  * @param tx_pkts Output: packet count
  * @param tx_bytes Output: byte count
  */
-void dpdk_ext_tx_get_stats(uint16_t port_id, uint64_t *tx_pkts, uint64_t *tx_bytes);
+void dpdk_ext_tx_get_stats(const struct stats_snapshot *snap, uint16_t port_id,
+                           uint64_t *tx_pkts, uint64_t *tx_bytes);
 
 /**
  * Print external TX statistics
+ * @param snap Collector snapshot (stats_snapshot_take)
  */
-void dpdk_ext_tx_print_stats(void);
-
-/**
- * Check if a VL-ID belongs to external TX range
- * @param vl_id VL-ID to check
- * @return Source port ID if external, -1 if not
- */
-int dpdk_ext_tx_get_source_port(uint16_t vl_id);
+void dpdk_ext_tx_print_stats(const struct stats_snapshot *snap);
 
 #endif /* DPDK_EXT_TX_ENABLED */
 
@@ -0,0 +1,91 @@
+#ifndef FLOW_REGISTRY_H
+#define FLOW_REGISTRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <rte_branch_prediction.h>
+#include "config.h"
+#include "prbs_seq.h"
+#include "vl_map.h"
+
+// ==========================================
+// VL-ID FLOW REGISTRY
+// ==========================================
+// RX tarafında "bu VL-ID'yi kim gönderdi, hangi PRBS akışıyla doğrulanır"
+// sorusu tek tabloda cevaplanır. Tablo startup'ta bir kez kurulur:
+//   - port_vlans[].tx_vl_ids      → DPDK kaynak portları (bitmask)
+//   - raw_port_configs tx_targets → raw socket kaynakları (+ TB blok düzeni)
+//   - raw_port_configs rx_sources → alıcı raw portun source index'i
+//   - DPDK_EXT_TX hedefleri       → DPDK external TX kaynakları
+// ve vl_map dense index'i ile indekslenir: flow_lookup() = vl_map_index + tek load.
+// Sınıflandırma maliyeti tanımlı port/hedef sayısından bağımsızdır.
+//
+// Aynı VL-ID birden fazla DPDK portundan gönderilebilir (örn. Port 2, 8-11 hepsi
+// 3..514), bu yüzden DPDK kaynakları tek port değil bitmask olarak tutulur.
+// Harici kaynak (raw / DPDK ext) VL başına tektir.
+
+enum flow_src_kind {
+    FLOW_SRC_NONE = 0,      // Harici kaynak yok (sadece DPDK veya bilinmiyor)
+    FLOW_SRC_RAW,           // Raw socket TX hedefi (VLAN'sız, RAW_PKT_* düzeni)
+    FLOW_SRC_DPDK_EXT,      // DPDK external TX (switch VLAN'ı söker, NUM_PRBS_BYTES düzeni)
+};
+
+#define FLOW_RAW_SOURCE_NONE (-1)
+
+struct flow_entry {
+    const struct prbs_window *prbs;     // Harici kaynağın PRBS akışı (NULL = doğrulanamaz)
+    uint16_t dpdk_src_mask;             // Bu VL'i gönderen DPDK portları (bit n = port n)
+    uint16_t src_port;                  // Harici kaynak port'u (raw: 12.., ext: DPDK port)
+    uint16_t prbs_step;                 // seq başına PRBS offset adımı (byte)
+    uint16_t prbs_len;                  // Sabit boyutta karşılaştırılacak PRBS byte'ı
+    uint8_t kind;                       // enum flow_src_kind
+    int8_t raw_rx_source[MAX_RAW_SOCKET_PORTS];  // raw port index → rx_sources index
+};
+
+extern const struct flow_entry *flow_table;
+extern uint16_t flow_table_size;
+extern const struct flow_entry flow_entry_none;
+
+// ==========================================
+// HOT PATH
+// ==========================================
+
+// Dense index zaten elde ise (rx_seq_update ile aynı idx): tek load
+static inline const struct flow_entry *flow_at(uint16_t idx)
+{
+    return likely(idx < flow_table_size) ? &flow_table[idx] : &flow_entry_none;
+}
+
+/**
+ * Flow entry of a VL-ID (kayıtlı değilse boş entry, asla NULL değil)
+ */
+static inline const struct flow_entry *flow_lookup(uint16_t vl_id)
+{
+    return flow_at(vl_map_index(vl_id));
+}
+
+// VL-ID bu DPDK portunun TX aralıklarından birinde mi? (eski is_valid_tx_vl_id_for_source_port)
+static inline bool flow_is_dpdk_src(const struct flow_entry *e, uint16_t src_port_id)
+{
+    return src_port_id < MAX_PORTS_CONFIG && ((e->dpdk_src_mask >> src_port_id) & 1);
+}
+
+// ==========================================
+// SETUP (startup, hot path değil)
+// ==========================================
+
+/**
+ * Build the registry (ve vl_map kayıtları)
+ * init_raw_socket_ports ve dpdk_ext_tx_init'ten sonra, RX worker'lar
+ * başlamadan önce çağrılmalı. Tekrar çağrılırsa bir şey yapmaz.
+ * @return 0 on success, -1 on map overflow or allocation failure
+ */
+int flow_registry_build(void);
+
+/**
+ * i-th VL-ID of a raw socket TX target (TB blok düzeni dahil), i < vl_id_count
+ * Registry'nin kullandığı düzenle aynı (DPDK RX flow steering kuralları için).
+ */
+uint16_t flow_raw_target_vl(uint16_t raw_port_id, const struct raw_tx_target_config *tc, uint16_t i);
+
+#endif /* FLOW_REGISTRY_H */
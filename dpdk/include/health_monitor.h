@@ -36,6 +36,21 @@ struct health_monitor_stats {
     uint8_t  last_response_count; // Responses in last cycle
 };
 
+/**
+ * DUT policing / queue counters of one switch port (last received cycle)
+ * RX BAG analizörü (rx_bag.h) alıcıda ölçülen BAG ihlalleriyle, burst testi
+ * (burst_test.h) kayıplı burst'leri queue overflow'larıyla karşılaştırır.
+ */
+struct health_port_policing {
+    uint64_t traffic_policy_drop; // PORT_OFF_TRAFFIC_POLICY_DROP
+    uint64_t max_delay_err;       // PORT_OFF_MAX_DELAY_ERR
+    uint64_t queue_overflow;      // PORT_OFF_QUEUE_OVERFLOW
+    uint64_t hp_queue_overflow;   // PORT_OFF_HP_QUEUE_OVERFLOW
+    uint64_t lp_queue_overflow;   // PORT_OFF_LP_QUEUE_OVERFLOW
+    uint64_t be_queue_overflow;   // PORT_OFF_BE_QUEUE_OVERFLOW
+    bool     valid;               // Port en az bir döngüde alındı
+};
+
 // ==========================================
 // HEALTH MONITOR STATE
 // ==========================================
@@ -58,6 +73,8 @@ struct health_monitor_state {
 
     // Statistics
     struct health_monitor_stats stats;
+    struct health_port_policing assistant_policing[HEALTH_MAX_PORTS];
+    struct health_port_policing manager_policing[HEALTH_MAX_PORTS];
     pthread_spinlock_t stats_lock;
 };
 
@@ -94,6 +111,14 @@ void cleanup_health_monitor(void);
  */
 void get_health_monitor_stats(struct health_monitor_stats *stats);
 
+/**
+ * @brief Get last per-port policing counters (thread-safe copy)
+ * @param assistant Output array, HEALTH_MAX_PORTS entries
+ * @param manager Output array, HEALTH_MAX_PORTS entries
+ */
+void get_health_port_policing(struct health_port_policing *assistant,
+                              struct health_port_policing *manager);
+
 /**
  * @brief Print health monitor statistics
  */
@@ -29,7 +29,11 @@ static void signal_handler(int signum)
 void helper_reset_stats(const struct ports_config *ports_config,
                         uint64_t prev_tx_bytes[], uint64_t prev_rx_bytes[]);
 
+struct stats_snapshot;
+
 // Her saniye çağır: büyük tablo + kuyruk dağılımları yazdırır
+// PRBS/kayıp sütunları snap'ten (stats_snapshot_take), HW sayaçları ethdev'den
 void helper_print_stats(const struct ports_config *ports_config,
+                        const struct stats_snapshot *snap,
                         const uint64_t prev_tx_bytes[], const uint64_t prev_rx_bytes[],
                         bool warmup_complete, unsigned loop_count, unsigned test_time);
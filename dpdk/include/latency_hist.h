@@ -0,0 +1,229 @@
+#ifndef LATENCY_HIST_H
+#define LATENCY_HIST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <rte_common.h>
+#include <rte_branch_prediction.h>
+#include "config.h"
+#include "port.h"
+
+// ==========================================
+// IN-BAND LATENCY / JITTER HISTOGRAMS
+// ==========================================
+// INBAND_LATENCY_ENABLED iken her DPDK TX paketi SEQ'in arkasında TX TSC
+// taşır (packet.h, INBAND_TS_BYTES). RX worker burst başına bir TSC okur ve
+// paket başına:
+//   lat = rx_tsc - tx_tsc
+//   jit = |lat - önceki lat|   (aynı VL, RFC 3550 D farkı)
+// değerlerini queue'ya özel log-linear (HDR tarzı) histogramlara yazar.
+//
+//   - Bucket: 32 cycle birim, her 2'nin kuvveti 8 alt bucket'a bölünür
+//     (bağıl hata ≤ %12.5), ~2^27 cycle (~45 ms @ 3 GHz) üstü son bucket'a düşer.
+//     Histogram boyutu sabittir (160 bucket), trafik süresinden bağımsız.
+//   - Tek yazar: sahibi rx_worker (relaxed store, RMW yok); stats lcore
+//     lat_snapshot_take() ile port / DTN port bazında toplar.
+//   - VL başına slot: queue'da ilk görülen LAT_HIST_VL_PER_QUEUE - 1 VL kendi
+//     slot'unu alır, kalanlar slot 0'da ("diğer VL'ler", jitter'sız) toplanır.
+//   - Reset (warm-up): rx_sequence ile aynı epoch düzeni; sahibi worker
+//     bir sonraki burst'te kendi histogramlarını temizler.
+//
+// RX TSC burst granülerliğindedir: ölçülen değer NIC → host kuyruk gecikmesini
+// (burst içinde bekleme dahil) içerir. TSC'ler aynı sunucuda (TX ve RX aynı
+// makinede, invariant TSC) karşılaştırılabilir.
+
+#define LAT_HIST_UNIT_SHIFT  5     // 1 birim = 32 cycle
+#define LAT_HIST_SUB_BITS    3     // 2^k başına 8 alt bucket
+#define LAT_HIST_MAX_EXP     21    // 2^(21+1) birim üstü → son bucket
+#define LAT_HIST_SUB         (1u << LAT_HIST_SUB_BITS)
+#define LAT_HIST_BUCKETS     ((LAT_HIST_MAX_EXP - LAT_HIST_SUB_BITS + 2) * LAT_HIST_SUB)
+
+#define LAT_MAX_QUEUES       64
+#define LAT_SLOT_NONE        0xFFFF
+#define LAT_TOP_VLS          8
+
+struct lat_hist {
+    uint64_t count;         // En son yazılır (release)
+    uint64_t sum;           // cycles
+    uint64_t min;           // cycles (count == 0 iken anlamsız)
+    uint64_t max;
+    uint64_t bucket[LAT_HIST_BUCKETS];
+};
+
+struct lat_vl_slot {
+    uint64_t last_lat;      // Jitter için önceki latency (cycles)
+    uint16_t vl_idx;        // vl_map dense index (slot 0: LAT_SLOT_NONE)
+    struct lat_hist lat;
+    struct lat_hist jit;
+};
+
+struct lat_queue {
+    struct lat_vl_slot *slot;   // [LAT_HIST_VL_PER_QUEUE], sahibinin NUMA node'unda
+    uint16_t *slot_of;          // [vl_count]: dense index → slot (LAT_SLOT_NONE = atanmadı)
+    uint64_t invalid;           // rx_tsc < tx_tsc (bozuk / başka kaynaktan TSC)
+    uint32_t epoch;             // Uygulanan son reset epoch'u (sadece sahibi yazar)
+    uint16_t nb_slots;          // Kullanılan slot sayısı (slot 0 dahil)
+    uint16_t vl_count;
+    uint16_t port_id;
+    uint16_t queue_id;
+    uint16_t dtn_port;          // STATS_MODE_DTN: queue → DTN port (yoksa 0xFFFF)
+} __rte_cache_aligned;
+
+extern uint32_t lat_epoch;
+
+/**
+ * Create (or return the existing) histogram set for an RX queue
+ * Başlangıçta çağrılır (hot path değil), registry kısa bir lock ile korunur.
+ * @return queue pointer, NULL on allocation failure or registry full
+ */
+struct lat_queue *lat_queue_create(uint16_t port_id, uint16_t queue_id,
+                                   uint16_t vl_count, int socket_id);
+
+/**
+ * Tüm queue'lara sıfırlama iste (warm-up reset, init_rx_stats)
+ */
+void lat_reset(void);
+
+// Sahibi çağırır (epoch değiştiğinde), lat_queue_sync üzerinden
+void lat_queue_clear(struct lat_queue *q);
+
+// VL'in slot'u yoksa ata (slot'lar doluysa slot 0), VL başına bir kez
+struct lat_vl_slot *lat_queue_assign(struct lat_queue *q, uint16_t vl_idx);
+
+// ==========================================
+// HOT PATH (sadece queue sahibi çağırır)
+// ==========================================
+
+// Burst başına bir kez: bekleyen reset varsa uygula
+static inline void lat_queue_sync(struct lat_queue *q)
+{
+    if (unlikely(q->epoch != __atomic_load_n(&lat_epoch, __ATOMIC_ACQUIRE)))
+        lat_queue_clear(q);
+}
+
+// cycles → bucket index (log-linear, sabit zaman: tek clz)
+static inline uint32_t lat_hist_index(uint64_t cycles)
+{
+    const uint64_t u = cycles >> LAT_HIST_UNIT_SHIFT;
+
+    if (u < LAT_HIST_SUB)
+        return (uint32_t)u;
+
+    const uint32_t e = 63u - (uint32_t)__builtin_clzll(u);
+    if (unlikely(e > LAT_HIST_MAX_EXP))
+        return LAT_HIST_BUCKETS - 1;
+
+    return (e - LAT_HIST_SUB_BITS + 1) * LAT_HIST_SUB +
+           (uint32_t)((u >> (e - LAT_HIST_SUB_BITS)) & (LAT_HIST_SUB - 1));
+}
+
+static inline void lat_hist_add(struct lat_hist *h, uint64_t v)
+{
+    const uint64_t n = h->count;
+    uint64_t *b = &h->bucket[lat_hist_index(v)];
+
+    __atomic_store_n(b, *b + 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&h->sum, h->sum + v, __ATOMIC_RELAXED);
+    if (unlikely(n == 0 || v < h->min))
+        __atomic_store_n(&h->min, v, __ATOMIC_RELAXED);
+    if (v > h->max)
+        __atomic_store_n(&h->max, v, __ATOMIC_RELAXED);
+    // count en son: okuyucu n'i gördüyse bucket/sum/min/max'ı da görür
+    __atomic_store_n(&h->count, n + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * Record one packet; vl_idx = vl_map_index(vl_id), vl_idx < q->vl_count olmalı
+ */
+static inline void lat_record(struct lat_queue *q, uint16_t vl_idx,
+                              uint64_t tx_tsc, uint64_t rx_tsc)
+{
+    if (unlikely(rx_tsc < tx_tsc)) {
+        __atomic_store_n(&q->invalid, q->invalid + 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    const uint64_t lat = rx_tsc - tx_tsc;
+    const uint16_t s = q->slot_of[vl_idx];
+    struct lat_vl_slot *slot;
+
+    if (likely(s != LAT_SLOT_NONE)) {
+        slot = &q->slot[s];
+    } else {
+        slot = lat_queue_assign(q, vl_idx);
+    }
+
+    // Slot 0 farklı VL'leri karıştırır: jitter anlamsız
+    if (likely(slot != q->slot)) {
+        if (likely(slot->lat.count != 0)) {
+            const uint64_t prev = slot->last_lat;
+            lat_hist_add(&slot->jit, lat > prev ? lat - prev : prev - lat);
+        }
+        slot->last_lat = lat;
+    }
+    lat_hist_add(&slot->lat, lat);
+}
+
+// ==========================================
+// SNAPSHOT / REPORT (stats lcore)
+// ==========================================
+
+/**
+ * Özet (ns), lat_hist_summarize çıktısı
+ */
+struct lat_summary {
+    uint64_t count;
+    double min_ns;
+    double mean_ns;
+    double p50_ns;
+    double p90_ns;
+    double p99_ns;
+    double p999_ns;
+    double max_ns;
+};
+
+struct lat_hist_pair {
+    struct lat_hist lat;
+    struct lat_hist jit;
+};
+
+struct lat_worst_vl {
+    uint16_t port_id;
+    uint16_t queue_id;
+    uint16_t vl_id;
+    struct lat_summary lat;
+    struct lat_summary jit;
+};
+
+struct lat_snapshot {
+    struct lat_hist_pair port[MAX_PORTS];
+#if STATS_MODE_DTN
+    struct lat_hist_pair dtn[DTN_PORT_COUNT];
+#endif
+    struct lat_worst_vl worst[LAT_TOP_VLS];    // p99 latency'ye göre azalan
+    uint32_t nb_worst;
+    uint64_t invalid;
+};
+
+/**
+ * Merge every queue (reset'i uygulamış olanlar) into port / DTN rows
+ * ve p99'u en yüksek LAT_TOP_VLS (port, queue, VL) slot'unu seç.
+ */
+void lat_snapshot_take(struct lat_snapshot *snap);
+
+// Başka worker'ın histogramını oku: önce count (acquire), sonra kalan alanlar
+void lat_hist_read(const struct lat_hist *src, struct lat_hist *dst);
+
+// dst += src (ikisi de yerel kopya)
+void lat_hist_merge(struct lat_hist *dst, const struct lat_hist *src);
+
+// Histogram → ns özeti (percentile = bucket orta noktası, [min, max] ile sınırlı)
+void lat_hist_summarize(const struct lat_hist *h, struct lat_summary *out);
+
+// Saniyelik tablo: port (veya DTN port) bazında latency + jitter, en kötü VL'ler
+void lat_print_stats(const struct lat_snapshot *snap);
+
+// Test sonu: her (port, queue, VL) slot'u için tam tablo
+void lat_print_vl_table(void);
+
+#endif /* LATENCY_HIST_H */
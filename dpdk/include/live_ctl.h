@@ -0,0 +1,45 @@
+#ifndef LIVE_CTL_H
+#define LIVE_CTL_H
+
+#include <stdbool.h>
+#include "config.h"
+
+// ==========================================
+// LIVE CONTROL SOCKET
+// ==========================================
+// Çalışan dpdk_app'e restart olmadan komut göndermek için Unix datagram
+// socket'i (LIVE_CTL_SOCKET_PATH). Socket sadece main lcore'da, stats
+// döngüsünün beklemesi içinde okunur: signal handler'dan hiçbir şey
+// yapılmaz, worker'lar sadece tx_live bloğunu görür.
+//
+//   socat - UNIX-SENDTO:/tmp/dpdk_app.ctl,bind=/tmp/ctl.$$ <<< "rate 2 1.5"
+//
+// Komutlar:
+//   help
+//   status                    slot başına gen / rate / VL / IMIX
+//   rate <port> <gbps>        portun toplam TX rate'i
+//   vls <port> <count>        queue başına aktif VL sayısı (1..VL aralığı)
+//   imix a,b,...              IMIX_PATTERN_SIZE boyut (IMIX build'lerinde)
+//   reload [path]             profilden rate + IMIX (varsayılan: yüklenen profil)
+//
+// Gönderen socket bind edilmişse cevap geri yollanır; her cevap ayrıca
+// [LIVE] önekiyle stdout'a basılır.
+
+#define LIVE_CTL_MAX_CMD   512
+#define LIVE_CTL_MAX_REPLY 4096
+
+/**
+ * Create the control socket (main loop'tan önce)
+ * @return 0 on success, -1 on error (uygulama socket'siz devam eder)
+ */
+int live_ctl_init(void);
+
+/**
+ * Wait up to timeout_ms, serving commands as they arrive
+ * Stats döngüsündeki sleep(1) yerine; sinyalde / *stop_flag set olunca erken döner.
+ */
+void live_ctl_wait(unsigned int timeout_ms, volatile bool *stop_flag);
+
+void live_ctl_close(void);
+
+#endif /* LIVE_CTL_H */
@@ -3,11 +3,14 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include <rte_ether.h>
 #include <rte_ip.h>
 #include <rte_udp.h>
 #include <rte_mbuf.h>
+#include <rte_memcpy.h>
 #include "config.h"  // IMIX configuration
+#include "prbs_seq.h"
 
 /*
  *  Paket yapısı:
@@ -32,9 +35,7 @@
 // ==========================================
 // PRBS-31 CONFIGURATION
 // ==========================================
-#define PRBS31_PERIOD     0x7FFFFFFF
-#define PRBS_CACHE_SIZE   ((PRBS31_PERIOD / 8) + 1)  // ~268 MB
-#define PRBS_CACHE_MASK   (PRBS_CACHE_SIZE - 1)
+// PRBS31_PERIOD / PRBS_CACHE_SIZE: prbs_seq.h (paylaşılan dizi)
 #define SEQ_BYTES         8
 
 // ==========================================
@@ -51,6 +52,16 @@
 #define TX_TIMESTAMP_BYTES      8
 #define LATENCY_PAYLOAD_OFFSET  (SEQ_BYTES + TX_TIMESTAMP_BYTES)  // 16 bytes header
 
+// In-band latency (INBAND_LATENCY_ENABLED, normal trafik):
+//   [Sequence 8B][TX TSC 8B][PRBS Data 1451B]
+// TSC, PRBS akışının ilk 8 byte'ının yerini alır: PRBS karşılaştırması
+// (seq × MAX_PRBS_BYTES + INBAND_TS_BYTES) offset'inden başlar.
+#if INBAND_LATENCY_ENABLED
+#define INBAND_TS_BYTES         TX_TIMESTAMP_BYTES
+#else
+#define INBAND_TS_BYTES         0
+#endif
+
 // Latency test modunda PRBS boyutu (1518 - 18 - 20 - 8 - 16 = 1456)
 #if VLAN_ENABLED
 #define LATENCY_PRBS_BYTES  (LATENCY_TEST_PACKET_SIZE - ETH_HDR_SIZE - VLAN_HDR_SIZE - IP_HDR_SIZE - UDP_HDR_SIZE - SEQ_BYTES - TX_TIMESTAMP_BYTES)
@@ -174,9 +185,9 @@ struct packet_config {
 // ==========================================
 // PRBS-31 CACHE STRUCTURE (per-port)
 // ==========================================
+// Port başına ayrı buffer yok: pencere paylaşılan diziye faz offset'iyle bakar
 struct prbs_cache {
-    uint8_t  *cache;         // Main PRBS cache
-    uint8_t  *cache_ext;     // Extended cache (wraparound)
+    struct prbs_window win;  // Shared sequence window (+ wraparound seam)
     uint32_t  initial_state; // Initial PRBS-31 state
     bool      initialized;
     int       socket_id;
@@ -192,8 +203,7 @@ extern struct prbs_cache port_prbs_cache[MAX_PRBS_CACHE_PORTS];
 // PRBS utilities
 void init_prbs_cache_for_all_ports(uint16_t nb_ports, const struct ports_config *ports);
 void cleanup_prbs_cache(void);
-uint8_t* get_prbs_cache_for_port(uint16_t port_id);
-uint8_t* get_prbs_cache_ext_for_port(uint16_t port_id);
+const struct prbs_window *get_prbs_window_for_port(uint16_t port_id);
 
 // Packet building utilities
 void init_packet_config(struct packet_config *config);
@@ -223,11 +233,22 @@ static inline void fill_payload_with_prbs31(struct rte_mbuf *mbuf, uint16_t port
 // IMIX HELPER FUNCTIONS
 // ==========================================
 
+// IMIX pattern: IMIX_PATTERN_INIT, traffic profile (imix = ...) ile değişebilir.
+// Uzunluk sabit (IMIX_PATTERN_SIZE), boyutlar [IMIX_MIN, IMIX_MAX] içinde kalır.
+extern uint16_t imix_pattern[IMIX_PATTERN_SIZE];
+extern uint32_t imix_avg_packet_size;   // Rate hesabı için pattern ortalaması
+
+// Verilen pattern tablosundan paket boyutu (canlı IMIX: worker'ın tx_live bloğu)
+static inline uint16_t get_imix_packet_size_from(const uint16_t *pattern, uint64_t pkt_counter,
+                                                 uint8_t worker_offset)
+{
+    return pattern[(pkt_counter + worker_offset) % IMIX_PATTERN_SIZE];
+}
+
 // IMIX pattern'den paket boyutu al (worker'ın offset + counter'ına göre)
 static inline uint16_t get_imix_packet_size(uint64_t pkt_counter, uint8_t worker_offset)
 {
-    static const uint16_t imix_pattern[IMIX_PATTERN_SIZE] = IMIX_PATTERN_INIT;
-    return imix_pattern[(pkt_counter + worker_offset) % IMIX_PATTERN_SIZE];
+    return get_imix_packet_size_from(imix_pattern, pkt_counter, worker_offset);
 }
 
 // Paket boyutundan payload boyutunu hesapla
@@ -246,4 +267,222 @@ static inline uint16_t calc_prbs_size(uint16_t pkt_size)
 int build_packet_dynamic(struct rte_mbuf *mbuf, const struct packet_config *config,
                           uint16_t packet_size);
 
+// ==========================================
+// PER-VL HEADER TEMPLATES
+// ==========================================
+// Worker başında VL aralığındaki her VL-ID için hazır header üretilir:
+//   [ETH (+VLAN)][IPv4 (checksum hazır)][UDP][SEQ alanı] → 42/46 + 8 byte
+// 64 byte'a (1 cache line) yuvarlanır. TX'te paket başına sadece:
+//   1x 64 byte kopya + sequence yazımı + PRBS kopyası
+// Template MAX paket boyutu için render edilir; IMIX'te farklı boyutlarda
+// total_length/dgram_len ve IP checksum artımsal (RFC 1624) güncellenir.
+// Üretilen byte'lar eski builder'larla (build_packet*, build_raw_packet,
+// ext TX) birebir aynıdır.
+
+#define HDR_TEMPLATE_SIZE 64
+
+struct hdr_template {
+    uint8_t bytes[HDR_TEMPLATE_SIZE];
+} __rte_aligned(RTE_CACHE_LINE_SIZE);
+
+// Bir worker'ın VL aralığı için template tablosu (index = vl_id - vl_start)
+struct hdr_template_set {
+    uint16_t vl_start;
+    uint16_t vl_count;
+    uint16_t l2_len;            // 14 (VLAN'sız) veya 18 (VLAN)
+    uint16_t tmpl_pkt_size;     // Template'in render edildiği paket boyutu
+    struct hdr_template *tmpl;  // [vl_count], worker'ın NUMA node'unda
+};
+
+/**
+ * Allocate template table for [vl_start, vl_start + vl_count) on socket_id
+ * @return 0 on success, -1 on allocation failure
+ */
+int hdr_template_set_alloc(struct hdr_template_set *set, uint16_t vl_start,
+                           uint16_t vl_count, uint16_t l2_len,
+                           uint16_t tmpl_pkt_size, int socket_id);
+
+/**
+ * Render templates for every VL-ID in the set from a base packet_config
+ * DST MAC (03:00:00:00:VV:VV) ve DST IP (224.224.VV.VV) VL-ID'den yazılır.
+ */
+void hdr_template_set_render(struct hdr_template_set *set,
+                             const struct packet_config *base_cfg);
+
+void hdr_template_set_free(struct hdr_template_set *set);
+
+// Template'i olmayan VL-ID için NULL döner
+static inline const struct hdr_template *
+hdr_template_get(const struct hdr_template_set *set, uint16_t vl_id)
+{
+    uint16_t idx = (uint16_t)(vl_id - set->vl_start);
+    return (idx < set->vl_count) ? &set->tmpl[idx] : NULL;
+}
+
+/**
+ * RFC 1624 artımsal IPv4 checksum güncellemesi (tek 16-bit alan değişimi)
+ * Değerler network byte order'da verilir.
+ */
+static inline uint16_t ip_cksum_adjust16(uint16_t cksum, uint16_t old_be, uint16_t new_be)
+{
+    uint32_t sum = (uint16_t)~cksum + (uint16_t)~old_be + new_be;
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    return (uint16_t)~sum;
+}
+
+/**
+ * Template'den kopyalanmış header'ın uzunluk alanlarını pkt_size'a göre düzelt
+ * (IMIX). tmpl_pkt_size == pkt_size ise çağırmaya gerek yok.
+ */
+static inline void hdr_template_patch_len(uint8_t *hdr, uint16_t l2_len, uint16_t pkt_size)
+{
+    struct rte_ipv4_hdr *ip = (struct rte_ipv4_hdr *)(hdr + l2_len);
+    struct rte_udp_hdr *udp = (struct rte_udp_hdr *)(hdr + l2_len + IP_HDR_SIZE);
+    uint16_t old_total = ip->total_length;
+    uint16_t new_total = rte_cpu_to_be_16(pkt_size - l2_len);
+
+    ip->total_length = new_total;
+    ip->hdr_checksum = ip_cksum_adjust16(ip->hdr_checksum, old_total, new_total);
+    udp->dgram_len = rte_cpu_to_be_16(pkt_size - l2_len - IP_HDR_SIZE);
+}
+
+/**
+ * Header + sequence'ı tek 64 byte kopya ile mbuf'a bas, mbuf uzunluklarını ayarla
+ * PRBS payload'ı çağıran yazar (SEQ'den sonraki byte'lar).
+ */
+static inline void hdr_template_stamp(struct rte_mbuf *mbuf, const struct hdr_template_set *set,
+                                      const struct hdr_template *t, uint64_t seq,
+                                      uint16_t pkt_size)
+{
+    uint8_t *dst = rte_pktmbuf_mtod(mbuf, uint8_t *);
+
+    rte_mov64(dst, t->bytes);
+    if (unlikely(pkt_size != set->tmpl_pkt_size))
+        hdr_template_patch_len(dst, set->l2_len, pkt_size);
+    memcpy(dst + set->l2_len + IP_HDR_SIZE + UDP_HDR_SIZE, &seq, SEQ_BYTES);
+
+    mbuf->data_len = pkt_size;
+    mbuf->pkt_len = pkt_size;
+}
+
+// PRBS kopyası (fill_payload_with_prbs31_dynamic'in kontrolsüz hot-path hali)
+static inline void fill_prbs_after_template(struct rte_mbuf *mbuf, const struct prbs_window *win,
+                                            uint16_t l2_len, uint64_t seq, uint16_t prbs_len)
+{
+    uint8_t *prbs_ptr = rte_pktmbuf_mtod_offset(mbuf, uint8_t *,
+                                                l2_len + IP_HDR_SIZE + UDP_HDR_SIZE + SEQ_BYTES);
+    const uint64_t start_offset = (seq * (uint64_t)MAX_PRBS_BYTES) % (uint64_t)PRBS_CACHE_SIZE;
+    rte_memcpy(prbs_ptr, prbs_window_at(win, start_offset, prbs_len), prbs_len);
+}
+
+// ==========================================
+// ZERO-COPY PRBS PAYLOAD (extbuf mbuf zinciri)
+// ==========================================
+// TX_ZEROCOPY_PRBS_ENABLED=1 iken paket 2 segment olarak gönderilir:
+//   seg0: [ETH (+VLAN)][IPv4][UDP][SEQ]  → template'den, 1 cache line
+//         (tx_worker, INBAND_LATENCY_ENABLED: + [TX TSC], çağıran yazar)
+//   seg1: extbuf → win->base + (seq × MAX_PRBS_BYTES + ts_len) % PRBS_CACHE_SIZE
+// PRBS byte'ları hiç kopyalanmaz, NIC doğrudan hugepage'deki diziden DMA yapar.
+// seg1 mbuf'ları data room'suz ayrı bir havuzdan gelir; shared info worker
+// başına tek tanedir ve worker referansı (refcnt 1) tutulduğu sürece
+// free_cb çağrılmaz. NIC MULTI_SEGS desteklemiyorsa, IOVA hugepage sınırında
+// süreksizse, payload pencere sonundaki seam'e düşüyorsa ya da extbuf havuzu
+// boşsa paket kopya yoluyla gönderilir.
+// Hat üzerindeki byte'lar kopya yoluyla birebir aynıdır.
+
+#define PRBS_ZC_POOL_CACHE 256
+
+struct prbs_zc_ctx {
+    bool enabled;                              // false → her paket kopya yolu
+    bool iova_va;                              // IOVA == VA (sayfa tablosu gereksiz)
+    uint8_t page_shift;                        // log2(hugepage boyutu)
+    uint32_t nb_pages;
+    uintptr_t page_base;                       // Pencereyi kapsayan ilk hugepage
+    rte_iova_t *page_iova;                     // [nb_pages] hugepage başına IOVA
+    const struct prbs_window *win;
+    struct rte_mempool *ext_pool;              // seg1 mbuf'ları (data room = 0)
+    struct rte_mbuf_ext_shared_info *shinfo;   // rte_malloc, son referansla serbest
+    uint64_t zc_pkts;                          // zero-copy gönderilen
+    uint64_t copy_pkts;                        // kopya yoluna düşen
+};
+
+/**
+ * Zero-copy context'i hazırla (worker başında)
+ * NIC MULTI_SEGS desteklemiyorsa enabled=false ile 0 döner (kopya yolu).
+ * @return 0 on success, -1 on allocation failure
+ */
+int prbs_zc_init(struct prbs_zc_ctx *zc, uint16_t port_id, uint16_t queue_id,
+                 const struct prbs_window *win, int socket_id);
+
+void prbs_zc_free(struct prbs_zc_ctx *zc);
+
+// [va, va+len) tek IOVA aralığına düşüyorsa başlangıç IOVA'sını yaz
+static inline bool prbs_zc_iova(const struct prbs_zc_ctx *zc, const uint8_t *va,
+                                uint16_t len, rte_iova_t *iova)
+{
+    if (zc->iova_va) {
+        *iova = (rte_iova_t)(uintptr_t)va;
+        return true;
+    }
+
+    const uint64_t off = (uintptr_t)va - zc->page_base;
+    const uint32_t first = (uint32_t)(off >> zc->page_shift);
+    const uint32_t last = (uint32_t)((off + len - 1) >> zc->page_shift);
+
+    if (unlikely(last != first &&
+                 zc->page_iova[last] != zc->page_iova[first] + ((uint64_t)(last - first) << zc->page_shift)))
+        return false;
+
+    *iova = zc->page_iova[first] + (off & ((1ULL << zc->page_shift) - 1));
+    return true;
+}
+
+/**
+ * hdr_template_stamp sonrası PRBS'i extbuf segmenti olarak bağla
+ * Bağlanamazsa PRBS tek segmente kopyalanır (fill_prbs_after_template).
+ * @param ts_len SEQ'in arkasında head segment'te bırakılan byte (in-band TSC,
+ *               çağıran yazar); PRBS segmenti akışta o kadar ileriden başlar
+ */
+static inline void prbs_zc_attach_payload(struct prbs_zc_ctx *zc, struct rte_mbuf *head,
+                                          uint16_t l2_len, uint64_t seq, uint16_t prbs_len,
+                                          uint16_t ts_len)
+{
+    const uint16_t hdr_len = l2_len + IP_HDR_SIZE + UDP_HDR_SIZE + SEQ_BYTES + ts_len;
+    const uint16_t seg_len = prbs_len - ts_len;
+    const uint64_t off = (seq * (uint64_t)MAX_PRBS_BYTES + ts_len) % (uint64_t)PRBS_CACHE_SIZE;
+    uint8_t *src = (uint8_t *)(uintptr_t)(zc->win->base + off);
+    struct rte_mbuf *seg = NULL;
+    rte_iova_t iova;
+
+    if (likely(zc->enabled && off + seg_len <= PRBS_CACHE_SIZE &&
+               prbs_zc_iova(zc, src, seg_len, &iova)))
+        seg = rte_pktmbuf_alloc(zc->ext_pool);
+
+    if (unlikely(seg == NULL)) {
+        fill_prbs_after_template(head, zc->win, l2_len, seq, prbs_len);
+        zc->copy_pkts++;
+        return;
+    }
+
+    rte_mbuf_ext_refcnt_update(zc->shinfo, 1);
+    rte_pktmbuf_attach_extbuf(seg, src, iova, seg_len, zc->shinfo);
+    seg->data_len = seg_len;
+    seg->pkt_len = seg_len;
+
+    head->data_len = hdr_len;
+    head->pkt_len = hdr_len + seg_len;
+    head->nb_segs = 2;
+    head->next = seg;
+    zc->zc_pkts++;
+}
+
+#if HDR_TEMPLATE_BENCH_ENABLED
+/**
+ * Mikrobenchmark: build_packet_mbuf + fill_payload vs template stamp + PRBS
+ * Sonuç cycles/paket olarak yazdırılır (startup'ta bir kez).
+ */
+void hdr_template_benchmark(struct rte_mempool *mbuf_pool, uint16_t port_id);
+#endif
+
 #endif /* PACKET_H */
@@ -0,0 +1,140 @@
+#ifndef PRBS_SEQ_H
+#define PRBS_SEQ_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <rte_branch_prediction.h>
+#include "config.h"
+
+// ==========================================
+// SHARED PRBS-31 SEQUENCE
+// ==========================================
+// Tüm portların PRBS akışları aynı x^31 + x^28 + 1 m-dizisinin farklı
+// fazlarıdır:
+//   - DPDK portları: sağa kaydırmalı LFSR, seed = 0x0F + port_id
+//   - Raw portlar:   sola kaydırmalı LFSR, seed = 0x0F + port_id + 100
+//     (aynı rekürans: o[k+31] = o[k] ^ o[k+3], sadece state gösterimi farklı)
+// Bu yüzden port başına ayrı 256 MB cache yerine NUMA node başına tek bir
+// kopya (replica) tutulur, her port bu kopyaya kendi faz offset'iyle bakar.
+//
+// Üretim: 64-bit kelime başına tek adım (kare alınmış rekürans), dizi
+// PRBS_GEN_MAX_LCORES kadar boş lcore'a jump-ahead ile bölünür.
+//
+// Byte akışı: bit periyodu T = 2^31 - 1 tek sayı olduğundan byte-hizalı
+// okuma da T byte'ta tekrar eder ve her bit fazı tam bir byte index'e denk
+// gelir (index = faz × 8^-1 mod T = faz × 2^28 mod T). Replica T byte +
+// en sondaki port penceresinin taşan kısmı kadardır (~2 GB / node).
+// Eski düzen port başına cache + cache_ext = 512 MB idi (12 DPDK + 4 raw port).
+//
+// PRBS_SEQ_FILE_ENABLED: replica'lar hugetlbfs/tmpfs'te node başına dosyada
+// saklanır; restart'ta faz tablosu header'dan okunur, dosya read-only mmap
+// edilir (tarama ve üretim atlanır, checksum tutmazsa yeniden üretilir).
+//
+// Eski cache'ler PRBS_CACHE_SIZE (2^28) byte'ta sarıyordu: sınırı aşan paket
+// cache'in başından devam ediyordu. Hat üzerindeki byte'ların birebir aynı
+// kalması için her pencere küçük bir seam tamponu tutar:
+//   seam = [pencerenin son PRBS_SEAM_HALF byte'ı | ilk PRBS_SEAM_HALF byte'ı]
+
+#define PRBS31_PERIOD     0x7FFFFFFF
+#define PRBS_CACHE_SIZE   ((PRBS31_PERIOD / 8) + 1)  // ~268 MB (port penceresi)
+#define PRBS_CACHE_MASK   (PRBS_CACHE_SIZE - 1)
+
+#define PRBS_SEQ_BYTES    ((uint64_t)PRBS31_PERIOD)  // Byte periyodu (T)
+#define PRBS_SEAM_HALF    2048                       // >= en büyük PRBS payload
+
+/**
+ * Bir portun paylaşılan dizi üzerindeki görünümü
+ * base[0 .. PRBS_CACHE_SIZE) eski cache ile birebir aynıdır.
+ */
+struct prbs_window {
+    const uint8_t *base;     // replica + phase
+    uint8_t *seam;           // [2 × PRBS_SEAM_HALF], pencerenin NUMA node'unda
+    uint32_t phase;          // Paylaşılan dizideki byte index
+    uint32_t state;          // Sağa kaydırmalı LFSR gösteriminde başlangıç state'i
+    int socket_id;
+};
+
+// ==========================================
+// HOT PATH
+// ==========================================
+
+/**
+ * Eski cache_ext + off ile aynı byte'ları döndür (len <= PRBS_SEAM_HALF)
+ * off, (seq × PRBS_BYTES) % PRBS_CACHE_SIZE olarak hesaplanmış olmalı.
+ */
+static inline const uint8_t *prbs_window_at(const struct prbs_window *w, uint64_t off,
+                                            uint32_t len)
+{
+    if (likely(off + len <= PRBS_CACHE_SIZE))
+        return w->base + off;
+    return w->seam + (off - (PRBS_CACHE_SIZE - PRBS_SEAM_HALF));
+}
+
+// ==========================================
+// SEED → STATE
+// ==========================================
+
+static inline uint32_t prbs_seq_dpdk_state(uint16_t port_id)
+{
+    return 0x0000000F + port_id;
+}
+
+/**
+ * Raw port seed'ini (sola kaydırmalı LFSR) sağa kaydırmalı state'e çevir
+ * Sonuç: raw akışın ilk 31 biti, LSB ilk bit olacak şekilde.
+ */
+uint32_t prbs_seq_raw_state(uint16_t raw_port_id);
+
+/**
+ * Jump-ahead: state'i nbits bit adımı ileri taşı (GF(2) M^(2^k) tablosu)
+ * En fazla 31 matris-vektör çarpımı; dizi periyodu modunda çalışır.
+ */
+uint32_t prbs_seq_jump(uint32_t state, uint64_t nbits);
+
+/**
+ * RX hot path jump-ahead: state'i byte_off byte ileri taşı
+ * 4-bit hane başına önceden çarpılmış, dilimlenmiş matris (7 × 8 tablo okuması);
+ * byte_off < PRBS_CACHE_SIZE olmalı. prbs_seq_init'ten sonra çağrılmalı.
+ */
+uint32_t prbs_seq_state_at(uint32_t state, uint32_t byte_off);
+
+// ==========================================
+// SETUP (startup, hot path değil)
+// ==========================================
+
+/**
+ * Faz tablosunu çıkar ve socket_id üzerinde ilk replica'yı üret (veya dosyadan yükle)
+ * Bilinen tüm DPDK (0..MAX_PRBS_CACHE_PORTS-1) ve raw port
+ * (RAW_SOCKET_PORT_ID_START..+MAX_RAW_SOCKET_PORTS-1) seed'leri için
+ * byte index'i tek taramada bulunur. Tekrar çağrılırsa bir şey yapmaz.
+ * @return 0 on success, -1 on allocation failure
+ */
+int prbs_seq_init(int socket_id);
+
+/**
+ * socket_id üzerindeki replica (yoksa ilk replica'dan kopyalanır)
+ * SOCKET_ID_ANY → ilk replica.
+ */
+const uint8_t *prbs_seq_replica(int socket_id);
+
+/**
+ * state'i faz tablosundan bulup pencereyi ve seam tamponunu hazırla
+ * @return 0 on success, -1 if state is unknown or allocation fails
+ */
+int prbs_window_init(struct prbs_window *w, uint32_t state, int socket_id);
+
+void prbs_window_free(struct prbs_window *w);
+
+// Tüm replica'ları serbest bırak (pencereler önceden free edilmeli, dosyalar kalır)
+void prbs_seq_cleanup(void);
+
+#if PRBS_GEN_BENCH_ENABLED
+/**
+ * Generator benchmark: bit-seri (eski) vs 8-bit adım vs 64-bit kelime vs
+ * çok lcore; GB/s ve referansla birebirlik yazdırılır (startup'ta bir kez).
+ */
+void prbs_seq_gen_benchmark(void);
+#endif
+
+#endif /* PRBS_SEQ_H */
@@ -0,0 +1,90 @@
+#ifndef PRBS_VERIFY_H
+#define PRBS_VERIFY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "prbs_seq.h"
+
+// ==========================================
+// PRBS VERIFICATION KERNEL
+// ==========================================
+// Alınan PRBS payload'ını beklenen cache kesitiyle karşılaştırır ve
+// tek geçişte bit hatalarını sayar: popcount(recv XOR exp).
+// Dönüş değeri 0 ise paket GOOD, aksi halde bit hata sayısıdır.
+//
+// Kernel startup'ta CPU özelliklerine göre seçilir:
+//   AVX-512 + VPOPCNTDQ > AVX-512BW > AVX2 > scalar (64-bit popcount)
+// Temiz paketlerde sadece XOR/OR/test yapılır; popcount yalnızca farkın
+// görüldüğü blokta çalışır, bu yüzden hatalı linkte de throughput düşmez.
+// Tüm kernel'ler aynı sonucu üretir (scalar referans ile birebir).
+
+typedef uint32_t (*prbs_verify_fn_t)(const uint8_t *recv, const uint8_t *exp, uint32_t len);
+
+extern prbs_verify_fn_t prbs_verify_impl;
+
+/**
+ * Select the fastest kernel supported by this CPU (RX worker'lardan önce çağır)
+ * Çağrılmazsa scalar kernel kullanılır.
+ */
+void prbs_verify_init(void);
+
+const char *prbs_verify_kernel_name(void);
+
+static inline uint32_t prbs_verify(const uint8_t *recv, const uint8_t *exp, uint32_t len)
+{
+    return prbs_verify_impl(recv, exp, len);
+}
+
+// ==========================================
+// LFSR ENGINE (cache'siz doğrulama)
+// ==========================================
+// Beklenen payload pencereden okunmaz: pencere state'i sequence'ten türetilen
+// offset kadar jump-ahead ile ilerletilir (prbs_seq_state_at), payload
+// SIMD register'larında L1'deki bir yığın tamponuna üretilip aktif kernel ile
+// karşılaştırılır. Paket dışında okunan tek bellek portlardan bağımsız 56 KB
+// jump tablosu; rastgele offset'li 256 MB pencere okumaları (LLC thrash)
+// yoktur. Sonuç cache yoluyla birebir aynıdır.
+// Port başına PRBS_VERIFY_LFSR_PORT_MASK ile seçilir (RX yapan port).
+
+/**
+ * state'ten başlayan PRBS akışını üret ve recv ile karşılaştır
+ * @return bit hata sayısı (0 = GOOD)
+ */
+uint32_t prbs_verify_lfsr(const uint8_t *recv, uint32_t state, uint32_t len);
+
+static inline bool prbs_verify_port_uses_lfsr(uint16_t port_id)
+{
+    return port_id < 32 && ((PRBS_VERIFY_LFSR_PORT_MASK >> port_id) & 1);
+}
+
+/**
+ * Pencerenin off'taki len byte'ını doğrula (lfsr → cache'siz engine)
+ * off + len pencere sonunu aşarsa eski cache gibi pencerenin başına sarar.
+ */
+static inline uint32_t prbs_window_verify(const struct prbs_window *w, uint64_t off,
+                                          const uint8_t *recv, uint32_t len, bool lfsr)
+{
+    if (likely(!lfsr))
+        return prbs_verify(recv, prbs_window_at(w, off, len), len);
+
+    uint32_t state = prbs_seq_state_at(w->state, (uint32_t)off);
+    if (likely(off + len <= PRBS_CACHE_SIZE))
+        return prbs_verify_lfsr(recv, state, len);
+
+    const uint32_t first = (uint32_t)(PRBS_CACHE_SIZE - off);
+    return prbs_verify_lfsr(recv, state, first) +
+           prbs_verify_lfsr(recv + first, w->state, len - first);
+}
+
+#if PRBS_VERIFY_BENCH_ENABLED
+/**
+ * Mikrobenchmark: memcmp + byte popcount (eski) vs her desteklenen kernel
+ * Temiz ve hatalı paket için Mpps / GB/s yazdırılır (startup'ta bir kez).
+ * Ardından cache (sıcak / LLC-soğuk) vs LFSR engine: cycles/paket + LLC miss.
+ * prbs_seq_init'ten sonra çağrılmalı.
+ */
+void prbs_verify_benchmark(void);
+#endif
+
+#endif /* PRBS_VERIFY_H */
@@ -6,7 +6,13 @@
 #include <pthread.h>
 #include <linux/if_packet.h>
 #include "config.h"
+#include "tx_sequence.h"
+#include "prbs_seq.h"
+#include "stats_shard.h"
 
+struct raw_xdp_port;     // raw_xdp.h (AF_XDP backend)
+struct raw_xdp_queue;
+struct raw_tx_batch;     // raw_tx_batch.h (sendmmsg / io_uring TX)
 
 // PACKET_MMAP ring buffer configuration for zero-copy
 // Increased for higher throughput (865 Mbps = ~72K pkt/sec)
@@ -15,6 +21,20 @@
 #define RAW_SOCKET_RING_FRAME_SIZE  2048         // Max frame size
 #define RAW_SOCKET_RING_FRAME_NR    ((RAW_SOCKET_RING_BLOCK_SIZE / RAW_SOCKET_RING_FRAME_SIZE) * RAW_SOCKET_RING_BLOCK_NR)
 
+// Multi-queue RX ring modu: TPACKET_V3 (blok) veya TPACKET_V2 (frame)
+// V3'te kernel frame'leri değişken boyutla bloğa yazar ve bloğu dolunca ya da
+// retire timeout'unda kullanıcıya verir: worker frame başına status okumak
+// ve her boş frame'de poll() ile uyanmak yerine blok başına bir kez uyanır.
+// Kernel V3'ü reddederse queue V2 ile kurulur. 0 = eski V2 yolu (A/B ölçümü).
+#ifndef RAW_SOCKET_RX_TPACKET_V3
+#define RAW_SOCKET_RX_TPACKET_V3    1
+#endif
+#define RAW_SOCKET_V3_BLOCK_SIZE    (1 << 18)    // 256KB (~170 x 1518B frame)
+#define RAW_SOCKET_V3_BLOCK_NR      32           // 8MB total, V2 ring ile aynı
+#define RAW_SOCKET_V3_RETIRE_TOV_MS 2            // Kısmen dolu blok en geç bu kadar bekler
+#define RAW_SOCKET_V3_POLL_MS       10           // Boşta poll() timeout (stop flag kontrolü)
+#define RAW_SOCKET_V3_STATS_BLOCKS  256          // Yük altında PACKET_STATISTICS okuma aralığı
+
 // ==========================================
 // MULTI-QUEUE RX CONFIGURATION
 // ==========================================
@@ -27,6 +47,15 @@
 #define PORT_15_RX_QUEUE_COUNT      2            // Port 15: 2 queues for 100M (ATE mode)
 #define RAW_SOCKET_FANOUT_GROUP_ID  0xCAFE       // Unique fanout group ID
 
+// Fanout dağıtımı: PACKET_FANOUT_HASH aynı VL'in frame'lerini farklı queue'lara
+// verebilir. VL steering (PACKET_FANOUT_CBPF) socket'i DST MAC byte 4-5'ten
+// (VL-ID % queue sayısı) seçer: her VL hep aynı queue'da kalır, per-VL
+// tracker'lar tek yazarlıdır (kayıp / sıra dışı kesin, atomic RMW / spinlock
+// yok). Kernel CBPF fanout'u reddederse HASH. 0 = eski HASH dağıtımı.
+#ifndef RAW_SOCKET_FANOUT_VL_STEER
+#define RAW_SOCKET_FANOUT_VL_STEER  1
+#endif
+
 // Packet sizes (no VLAN header)
 #define RAW_PKT_ETH_HDR_SIZE   14
 #define RAW_PKT_IP_HDR_SIZE    20
@@ -75,8 +104,10 @@
     RAW_IMIX_SIZE_6, RAW_IMIX_SIZE_6, RAW_IMIX_SIZE_6 \
 }
 
-// Maximum VL-ID for array sizing
-#define MAX_TOTAL_VL_IDS       4096
+// Runtime pattern: DPDK IMIX pattern'inin VLAN'sız karşılığı (boyut - 4),
+// traffic profile imix = ... ile birlikte güncellenir
+extern uint16_t raw_imix_pattern[IMIX_PATTERN_SIZE];
+extern uint32_t raw_imix_avg_packet_size;
 
 // ==========================================
 // RATE LIMITER
@@ -95,34 +126,14 @@ struct raw_rate_limiter {
     bool smooth_pacing_enabled;  // Use smooth pacing instead of token bucket
 };
 
-// ==========================================
-// PER-TARGET STATISTICS
-// ==========================================
-
-struct raw_target_stats {
-    uint64_t tx_packets;
-    uint64_t tx_bytes;
-    uint64_t tx_errors;
-    uint64_t rx_packets;
-    uint64_t rx_bytes;
-    uint64_t good_pkts;
-    uint64_t bad_pkts;
-    uint64_t bit_errors;
-    uint64_t lost_pkts;
-    uint64_t out_of_order_pkts;
-    uint64_t duplicate_pkts;
-    pthread_spinlock_t lock;
-};
-
 // ==========================================
 // VL-ID SEQUENCE TRACKER
 // ==========================================
 
+// RX tarafı VL tracker'ı (TX sequence'ları worker'a ait: tx_sequence.h)
 struct raw_vl_sequence {
-    uint64_t tx_sequence;       // TX sequence counter
     uint64_t rx_expected_seq;   // Expected RX sequence
     bool rx_initialized;        // RX tracker initialized?
-    pthread_spinlock_t tx_lock;
     pthread_spinlock_t rx_lock;
 };
 
@@ -133,9 +144,9 @@ struct raw_vl_sequence {
 struct raw_tx_target_state {
     struct raw_tx_target_config config;      // Target configuration
     struct raw_rate_limiter limiter;         // Rate limiter for this target
-    struct raw_vl_sequence *vl_sequences;    // VL-ID sequence trackers
+    struct tx_seq_block *tx_seq;             // VL-ID TX sequence'ları (TX worker'a ait)
+    struct hdr_template *hdr_templates;      // Per-VL hazır header [vl_id_count] (TX worker)
     uint16_t current_vl_offset;              // Round-robin offset
-    struct raw_target_stats stats;           // Per-target statistics
 };
 
 // ==========================================
@@ -145,7 +156,6 @@ struct raw_tx_target_state {
 struct raw_rx_source_state {
     struct raw_rx_source_config config;      // Source configuration
     struct raw_vl_sequence *vl_sequences;    // VL-ID sequence trackers
-    struct raw_target_stats stats;           // Per-source statistics
 };
 
 // ==========================================
@@ -162,6 +172,9 @@ struct raw_rx_queue {
     uint16_t cpu_core;                      // Pinned CPU core
     volatile bool *stop_flag;               // Pointer to stop flag
     bool running;                           // Thread running state
+    bool tpacket_v3;                        // Blok modu ring (RAW_SOCKET_RX_TPACKET_V3)
+    uint32_t block_nr;                      // V3: ring'deki blok sayısı
+    struct raw_xdp_queue *xdp;              // AF_XDP backend: XSK soketi (NULL = AF_PACKET)
 
     // Per-queue statistics
     uint64_t rx_packets;
@@ -170,7 +183,9 @@ struct raw_rx_queue {
     uint64_t bad_pkts;
     uint64_t bit_errors;
     uint64_t lost_pkts;
-    uint64_t kernel_drops;                  // Kernel-reported packet drops
+    uint64_t kernel_drops;                  // Kernel-reported packet drops (PACKET_STATISTICS, birikimli)
+    uint64_t kernel_freezes;                // V3: blok kalmadığı için kuyruğun donma sayısı
+    uint64_t blocks;                        // V3: işlenen blok sayısı
 
     // VL-ID tracking for debugging hash distribution
     uint16_t vl_id_min;                     // Minimum VL-ID seen
@@ -192,6 +207,12 @@ struct raw_socket_port {
     // Configuration
     struct raw_socket_port_config config;
 
+    // AF_XDP backend (config.backend, kurulabildiyse): TX ve RX aynı UMEM'de
+    struct raw_xdp_port *xdp;
+
+    // Batched TX (config.tx_submit sendmmsg / io_uring, NULL = TX ring)
+    struct raw_tx_batch *tx_batch;
+
     // Zero-copy ring buffers (TX)
     void *tx_ring;
     size_t tx_ring_size;
@@ -204,6 +225,7 @@ struct raw_socket_port {
 
     // Multi-queue RX (for Port 12 with PACKET_FANOUT)
     bool use_multi_queue_rx;                // Enable multi-queue RX
+    bool rx_vl_steered;                     // Her VL tek queue'da (CBPF fanout veya tek queue)
     int rx_queue_count;                     // Number of active RX queues
     struct raw_rx_queue rx_queues[RAW_SOCKET_RX_QUEUE_COUNT];
     uint16_t rx_cpu_cores[RAW_SOCKET_RX_QUEUE_COUNT];  // Allocated CPU cores
@@ -216,12 +238,8 @@ struct raw_socket_port {
     uint16_t rx_source_count;
     struct raw_rx_source_state rx_sources[MAX_RAW_TARGETS];
 
-    // DPDK External TX packets received (aggregated from all queues)
-    struct raw_target_stats dpdk_ext_rx_stats;
-
-    // PRBS cache
-    uint8_t *prbs_cache;
-    uint8_t *prbs_cache_ext;
+    // PRBS window (shared sequence, raw seed phase)
+    struct prbs_window prbs_win;
     bool prbs_initialized;
 
     // Thread control
@@ -293,7 +311,8 @@ bool raw_check_smooth_pacing(struct raw_rate_limiter *limiter);
 // STATISTICS & UTILITY FUNCTIONS
 // ==========================================
 
-void print_raw_socket_stats(void);
+// Sayaçlar stats_shard'lardan: STATS_DOM_RAW_TX / RAW_RX / RAW_EXT_RX
+void print_raw_socket_stats(const struct stats_snapshot *snap);
 void reset_raw_socket_stats(void);
 void cleanup_raw_socket_ports(void);
 uint64_t get_time_ns(void);
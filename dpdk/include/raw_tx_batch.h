@@ -0,0 +1,125 @@
+#ifndef RAW_TX_BATCH_H
+#define RAW_TX_BATCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <rte_branch_prediction.h>
+#include "raw_socket_port.h"
+
+// ==========================================
+// BATCHED TX SUBMISSION (raw socket portları)
+// ==========================================
+// AF_PACKET portunun TX gönderim yolu config.tx_submit ile seçilir
+// (RAW_SOCKET_PORT_xx_TX_SUBMIT veya profil "tx_submit ="):
+//
+//   RAW_TX_SUBMIT_RING      PACKET_TX_RING + send(NULL) kick (varsayılan).
+//                           Ring doluyken poll(POLLOUT, 1 ms) ile beklenir.
+//   RAW_TX_SUBMIT_SENDMMSG  Frame'ler port'a ait havuzda kurulur, batch tek
+//                           sendmmsg() ile gönderilir. Soket bloklayan: kernel
+//                           sndbuf dolunca syscall içinde bekler (poll yok).
+//   RAW_TX_SUBMIT_IO_URING  Havuz io_uring'e registered buffer, soket
+//                           registered file olarak verilir; batch tek
+//                           io_uring_enter ile IORING_OP_WRITE_FIXED zinciri
+//                           olarak gönderilir; io-wq'ya düşen yazmaların
+//                           completion'ı GETEVENTS ile beklenir, poll yok.
+//                           liburing yok: syscall.
+//
+// Üç yol da raw_socket_port.c'deki raw_tx_frame_acquire / commit / flush
+// arkasındadır; paket kurulumu, pacing, sequence ve sayaçlar ortaktır.
+// Sıra korunur: batch IOSQE_IO_LINK zinciridir ve flush tüm completion'ları
+// alınmadan dönmez (uçuşta önceki batch kalmaz). NIC kuyruğu doluyken
+// (PACKET_QDISC_BYPASS → ENOBUFS) sendmmsg aynı frame'i, io_uring ise
+// başarısız frame'den itibaren iptal edilen zinciri sırayla tekrar gönderir
+// (RAW_TX_BATCH_RETRY). Gönderilemeyen frame'ler tek tek hata sayılır.
+// io_uring kurulamazsa sendmmsg, o da kurulamazsa TX ring kullanılır.
+//
+// Karşılaştırma (rate, CPU, paketler arası jitter): tests/raw_tx_bench.c,
+//   make raw-tx-bench && sudo ./tests/raw_tx_bench <tx_if> <rx_if> [Mbps] [paket]
+// veth'te TX hiç beklemez: ring'in poll(1 ms) yolu ve ENOBUFS tekrarı ancak
+// gerçek NIC'te (kablo ile bağlı iki port) devreye girer, seçim orada yapılmalı.
+
+#define RAW_TX_BATCH_FRAMES     256     // Port başına TX frame havuzu
+#define RAW_TX_BATCH_MAX        64      // Tek sendmmsg / io_uring_enter'daki frame
+#define RAW_TX_BATCH_FRAME_SIZE 2048    // Frame yuvası (max paket ≤ 1518 B)
+#define RAW_TX_BATCH_RETRY      1000    // ENOBUFS/EAGAIN'de aynı mesaj için deneme
+
+struct raw_tx_uring;                    // raw_tx_batch.c (SQ/CQ ring mmap'leri)
+struct mmsghdr;                         // _GNU_SOURCE <sys/socket.h>
+
+struct raw_tx_batch {
+    uint8_t mode;                       // enum raw_tx_submit (SENDMMSG / IO_URING)
+    int fd;                             // = port->tx_socket
+    uint8_t *frames;                    // [RAW_TX_BATCH_FRAMES][RAW_TX_BATCH_FRAME_SIZE]
+
+    // Henüz gönderilmemiş batch (kuruluş sırasıyla)
+    uint32_t count;
+    uint16_t idx[RAW_TX_BATCH_MAX];     // Frame yuvası
+    struct iovec iov[RAW_TX_BATCH_MAX];
+    struct mmsghdr *msgs;               // [RAW_TX_BATCH_MAX], msg_iov = &iov[i]
+
+    // Boş frame yuvaları (sendmmsg: batch gönderilince hepsi geri döner)
+    uint32_t free_count;
+    uint16_t free_idx[RAW_TX_BATCH_FRAMES];
+
+    struct raw_tx_uring *uring;         // IO_URING modunda
+    uint32_t in_flight;                 // Submit edilmiş, completion'ı alınmamış
+    uint32_t fail_pos;                  // Zincirde ilk başarısız batch konumu (yoksa count)
+    int32_t fail_res;                   // Onun completion sonucu (-errno)
+    uint64_t errors;                    // Gönderilemeyen frame (birikimli)
+    uint64_t errors_reported;           // raw_tx_batch_submit'in bildirdiği
+};
+
+/**
+ * Open the TX socket (TX ring olmadan) and the submission backend of mode
+ * port->tx_socket ve port->tx_batch doldurulur. io_uring kurulamazsa sendmmsg.
+ * @return 0 on success, -1 on error (port TX ring ile kurulabilir)
+ */
+int raw_tx_batch_open(struct raw_socket_port *port, uint8_t mode);
+
+/**
+ * Free the pool and the io_uring instance (soket port cleanup'ında kapanır)
+ */
+void raw_tx_batch_close(struct raw_socket_port *port);
+
+/**
+ * Submit the pending batch (io_uring: tüm completion'lar alınır)
+ * @return number of frames dropped since the previous call (0 = hepsi gitti)
+ */
+uint32_t raw_tx_batch_submit(struct raw_tx_batch *b);
+
+/**
+ * Make a frame slot available: bekleyen batch gönderilir
+ * @return 0 when raw_tx_batch_frame() will succeed, -1 on error
+ */
+int raw_tx_batch_wait(struct raw_tx_batch *b);
+
+/**
+ * Mode name for logs ("ring", "sendmmsg", "io_uring")
+ */
+const char *raw_tx_submit_name(uint8_t mode);
+
+// ==========================================
+// HOT PATH (TX worker)
+// ==========================================
+
+// Sıradaki frame yuvası, havuz boşsa NULL (önce submit / wait)
+static inline uint8_t *raw_tx_batch_frame(struct raw_tx_batch *b)
+{
+    if (unlikely(b->free_count == 0 || b->count == RAW_TX_BATCH_MAX))
+        return NULL;
+    return b->frames + (size_t)b->free_idx[b->free_count - 1] * RAW_TX_BATCH_FRAME_SIZE;
+}
+
+// raw_tx_batch_frame() ile alınan frame'i batch'e ekle
+static inline void raw_tx_batch_add(struct raw_tx_batch *b, uint8_t *frame, uint16_t len)
+{
+    const uint32_t n = b->count++;
+
+    b->idx[n] = b->free_idx[--b->free_count];
+    b->iov[n].iov_base = frame;
+    b->iov[n].iov_len = len;
+}
+
+#endif /* RAW_TX_BATCH_H */
@@ -0,0 +1,218 @@
+#ifndef RAW_XDP_H
+#define RAW_XDP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <linux/if_xdp.h>
+#include <rte_branch_prediction.h>
+#include "raw_socket_port.h"
+
+// ==========================================
+// AF_XDP BACKEND (raw socket portları)
+// ==========================================
+// backend = RAW_BACKEND_AF_XDP olan port AF_PACKET yerine AF_XDP soketleriyle
+// çalışır (config.h RAW_SOCKET_PORT_xx_BACKEND veya profil "backend = af_xdp"):
+//
+//   - Port başına tek UMEM: ilk RAW_XDP_TX_FRAMES frame TX havuzu, ardından
+//     her RX queue'ya RAW_XDP_RX_FRAMES frame (kendi fill ring'inde).
+//   - NIC RX queue başına bir XSK soketi; queue 0 soketi UMEM'in sahibi ve TX
+//     ring'i de taşır, diğerleri XDP_SHARED_UMEM ile bağlanır.
+//   - Önce XDP_ZEROCOPY denenir, sürücü desteklemiyorsa XDP_COPY. Program
+//     önce native (DRV), olmazsa generic (SKB) modda bağlanır.
+//   - XDP programı (libbpf yok: bpf() syscall + elle kurulmuş eBPF) IPv4
+//     frame'in DST MAC byte 4-5'indeki VL-ID'yi vl_map'te arar; bizimse
+//     rx_queue_index'in soketine yönlendirir, değilse XDP_PASS (kernel).
+//   - Program BPF link ile bağlanır: process ölünce kendiliğinden sökülür.
+//
+// TX frame'leri ve RX doğrulaması AF_PACKET yoluyla aynı kodu kullanır
+// (raw_tx_worker / mq_rx_frame): sayaçlar ve PRBS semantiği değişmez.
+// Kurulum başarısız olursa port AF_PACKET ile devam eder. veth çiftinde de
+// çalışır (native XDP, copy mode).
+
+#define RAW_XDP_FRAME_SIZE      2048    // UMEM chunk; RX'te XDP_PACKET_HEADROOM sonrası 1792 B
+#define RAW_XDP_RX_FRAMES       2048    // Queue başına RX frame (= RX ve fill ring boyu)
+#define RAW_XDP_TX_FRAMES       2048    // TX havuzu (= TX ve completion ring boyu)
+#define RAW_XDP_RX_BATCH        64      // RX worker'ın tek seferde aldığı descriptor
+#define RAW_XDP_POLL_MS         10      // Boşta poll() timeout (stop flag kontrolü)
+#define RAW_XDP_STATS_BATCHES   1024    // Yük altında XDP_STATISTICS okuma aralığı
+#define RAW_XDP_VL_MAP_SIZE     65536   // VL-ID → yönlendir (BPF array, DST MAC byte 4-5)
+
+// Kernel ile paylaşılan tek üretici / tek tüketici ring (mmap)
+struct raw_xdp_ring {
+    uint32_t cached_prod;
+    uint32_t cached_cons;                   // Üretici ring'de: consumer + size
+    uint32_t mask;
+    uint32_t size;
+    uint32_t *producer;
+    uint32_t *consumer;
+    uint32_t *flags;                        // XDP_RING_NEED_WAKEUP
+    void *ring;
+    void *map;                              // munmap için
+    size_t map_size;
+};
+
+struct raw_xdp_queue {
+    int fd;                                 // XSK soketi
+    uint16_t queue_id;                      // NIC RX queue
+    bool zerocopy;                          // XDP_ZEROCOPY bağlandı
+    bool drv_mode;                          // Program native modda
+    struct raw_xdp_ring rx;                 // RX worker
+    struct raw_xdp_ring fill;               // RX worker
+    struct raw_xdp_ring tx;                 // Sadece queue 0: TX worker
+    struct raw_xdp_ring comp;               // Sadece queue 0: TX worker
+};
+
+struct raw_xdp_port {
+    uint8_t *umem;
+    size_t umem_size;
+    int queue_count;
+    struct raw_xdp_queue queues[RAW_SOCKET_RX_QUEUE_COUNT];
+
+    int prog_fd;
+    int link_fd;
+    int xsk_map_fd;                         // rx_queue_index → XSK
+    int vl_map_fd;                          // VL-ID → 1 (bizim)
+    bool need_wakeup;
+
+    // TX frame havuzu (TX worker'a ait, kilitsiz)
+    uint32_t tx_free_count;
+    uint64_t tx_free[RAW_XDP_TX_FRAMES];
+};
+
+// ==========================================
+// SETUP (startup, hot path değil)
+// ==========================================
+
+/**
+ * Open UMEM, XSK sockets and attach the steering program
+ * port->xdp, rx_queues[].xdp, rx_queue_count ve use_multi_queue_rx doldurulur.
+ * Hata durumunda her şey geri alınır, port AF_PACKET ile kurulabilir.
+ * @return 0 on success, -1 on error
+ */
+int raw_xdp_port_open(struct raw_socket_port *port);
+
+/**
+ * Fill the VL-ID steering map from the flow registry
+ * flow_registry_build() sonrası, RX worker'lar başlamadan çağrılır.
+ * @return number of steered VL-IDs, -1 on error
+ */
+int raw_xdp_port_steer(struct raw_socket_port *port);
+
+/**
+ * Detach the program, close sockets and free the UMEM (worker'lar durmuş olmalı)
+ */
+void raw_xdp_port_close(struct raw_socket_port *port);
+
+/**
+ * Kernel-side drops of a queue (XDP_STATISTICS, birikimli: rx_dropped + rx_ring_full)
+ */
+uint64_t raw_xdp_queue_drops(const struct raw_xdp_queue *xq);
+
+/**
+ * Wake the kernel for pending TX descriptors (need_wakeup / copy mode)
+ * @return 0 on success or transient busy, -1 on error
+ */
+int raw_xdp_tx_kick(struct raw_xdp_port *x);
+
+// ==========================================
+// RING PRIMITIVES (hot path)
+// ==========================================
+
+static inline uint32_t raw_xdp_cons_peek(struct raw_xdp_ring *r, uint32_t nb, uint32_t *idx)
+{
+    uint32_t entries = r->cached_prod - r->cached_cons;
+
+    if (entries == 0) {
+        r->cached_prod = __atomic_load_n(r->producer, __ATOMIC_ACQUIRE);
+        entries = r->cached_prod - r->cached_cons;
+    }
+    if (entries > nb)
+        entries = nb;
+    *idx = r->cached_cons;
+    r->cached_cons += entries;
+    return entries;
+}
+
+static inline void raw_xdp_cons_release(struct raw_xdp_ring *r, uint32_t nb)
+{
+    __atomic_store_n(r->consumer, *r->consumer + nb, __ATOMIC_RELEASE);
+}
+
+static inline uint32_t raw_xdp_prod_reserve(struct raw_xdp_ring *r, uint32_t nb, uint32_t *idx)
+{
+    if (r->cached_cons - r->cached_prod < nb) {
+        r->cached_cons = __atomic_load_n(r->consumer, __ATOMIC_ACQUIRE) + r->size;
+        if (r->cached_cons - r->cached_prod < nb)
+            return 0;
+    }
+    *idx = r->cached_prod;
+    r->cached_prod += nb;
+    return nb;
+}
+
+static inline void raw_xdp_prod_submit(struct raw_xdp_ring *r, uint32_t nb)
+{
+    __atomic_store_n(r->producer, *r->producer + nb, __ATOMIC_RELEASE);
+}
+
+static inline struct xdp_desc *raw_xdp_desc(const struct raw_xdp_ring *r, uint32_t idx)
+{
+    return &((struct xdp_desc *)r->ring)[idx & r->mask];
+}
+
+static inline uint64_t *raw_xdp_addr(const struct raw_xdp_ring *r, uint32_t idx)
+{
+    return &((uint64_t *)r->ring)[idx & r->mask];
+}
+
+static inline bool raw_xdp_needs_wakeup(const struct raw_xdp_port *x, const struct raw_xdp_ring *r)
+{
+    return !x->need_wakeup || (__atomic_load_n(r->flags, __ATOMIC_RELAXED) & XDP_RING_NEED_WAKEUP);
+}
+
+// ==========================================
+// TX (queue 0 soketi, TX worker)
+// ==========================================
+
+/**
+ * Free TX frame from the pool (tamamlananlar önce geri alınır)
+ * @return frame data in the UMEM, NULL if all frames are in flight
+ */
+static inline uint8_t *raw_xdp_tx_frame(struct raw_xdp_port *x)
+{
+    if (x->tx_free_count == 0) {
+        struct raw_xdp_ring *comp = &x->queues[0].comp;
+        uint32_t idx;
+        uint32_t n = raw_xdp_cons_peek(comp, RAW_XDP_TX_FRAMES, &idx);
+
+        for (uint32_t i = 0; i < n; i++)
+            x->tx_free[x->tx_free_count++] = *raw_xdp_addr(comp, idx + i);
+        if (n > 0)
+            raw_xdp_cons_release(comp, n);
+        if (x->tx_free_count == 0)
+            return NULL;
+    }
+    return x->umem + x->tx_free[--x->tx_free_count];
+}
+
+/**
+ * Queue a frame taken with raw_xdp_tx_frame() (gönderim raw_xdp_tx_kick ile)
+ * Frame sayısı = TX ring boyu: elde frame varsa ring'de yer vardır.
+ */
+static inline void raw_xdp_tx_submit(struct raw_xdp_port *x, const uint8_t *frame, uint32_t len)
+{
+    struct raw_xdp_ring *tx = &x->queues[0].tx;
+    uint32_t idx;
+
+    if (unlikely(raw_xdp_prod_reserve(tx, 1, &idx) == 0)) {
+        x->tx_free[x->tx_free_count++] = (uint64_t)(frame - x->umem);
+        return;
+    }
+    struct xdp_desc *d = raw_xdp_desc(tx, idx);
+    d->addr = (uint64_t)(frame - x->umem);
+    d->len = len;
+    d->options = 0;
+    raw_xdp_prod_submit(tx, 1);
+}
+
+#endif /* RAW_XDP_H */
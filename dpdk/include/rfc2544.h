@@ -0,0 +1,35 @@
+#ifndef RFC2544_H
+#define RFC2544_H
+
+#include <stdbool.h>
+#include "config.h"
+#include "port.h"
+
+// ==========================================
+// RFC 2544 THROUGHPUT SEARCH
+// ==========================================
+// Port grubu ve frame boyutu başına kayıpsız en yüksek offered load:
+//
+//   1. Frame boyutu tüm TX worker'larına uniform IMIX pattern olarak verilir
+//      (tx_live_set_imix), rate korunur.
+//   2. İlk trial üst sınırda (link hızı, L2); geçerse sonuç odur. Geçmezse
+//      [0, max] aralığında binary search, RFC2544_RESOLUTION_PCT'ye kadar.
+//   3. Trial: gruptaki portlara tx_live_set_rate → RFC2544_SETTLE_MS bekle →
+//      snapshot → RFC2544_TRIAL_SEC → snapshot. Paired RX portlarında
+//      lost / bad PRBS / bit error farkı 0 (tolerans içinde) ve RX > 0 ise
+//      PASS. Gönderilen paket offered'ın RFC2544_TX_MIN_PCT'sinden azsa
+//      tester yetişmiyordur: FAIL + "tester-limited" işareti.
+//   4. Grup bitince portlar başlangıç rate'ine döner.
+//
+// Diğer grupların portları kendi rate'lerinde göndermeye devam eder (DUT
+// arka plan yükü). Sonuç tablosu: Gbps (L2, port başına), Mpps, üst sınır
+// (link hızı, preamble + IFG + FCS = 24 B düşülmüş L2) ve ona oranı, trial sayısı.
+
+/**
+ * Run the search for every configured port group (main lcore, blocking)
+ * start_txrx_workers() sonrası, stats döngüsünden önce çağrılır.
+ * @return 0 when all groups finished, -1 on setup error or stop
+ */
+int rfc2544_run(const struct ports_config *ports_config, volatile bool *stop_flag);
+
+#endif /* RFC2544_H */
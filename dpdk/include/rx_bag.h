@@ -0,0 +1,240 @@
+#ifndef RX_BAG_H
+#define RX_BAG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <rte_common.h>
+#include <rte_branch_prediction.h>
+#include <rte_mbuf.h>
+#include "config.h"
+#if RX_BAG_HW_TIMESTAMP
+#include <rte_mbuf_dyn.h>
+#endif
+#include "port.h"
+#include "latency_hist.h"
+
+// ==========================================
+// RX BAG / JITTER CONFORMANCE ANALYZER
+// ==========================================
+// RX_BAG_MONITOR_ENABLED iken rx_worker, VL'i çözülen her frame için
+// rx_bag_rx() çağırır; queue'ya özel VL kaydı ardışık iki frame arası süreyi
+// (gap) tutar:
+//   - min / ortalama / max gap, en büyük |jitter|
+//   - jitter = |gap - BAG| (BAG profilde yoksa |gap - önceki gap|),
+//     queue başına log-linear histogram (latency_hist.h lat_hist)
+//   - ihlal: gap < BAG - jitter bütçesi (switch'in policing'inden geçmemesi
+//     gereken frame). DUT sayaçları (health monitor: traffic policy drop,
+//     max delay err) rapora yan yana basılır.
+//
+// Zaman kaynağı queue başına sabittir: NIC RX timestamp (RX_BAG_HW_TIMESTAMP,
+// port kalibre edildiyse) veya burst TSC. Gap kaynağın biriminde ölçülüp
+// 32.32 sabit noktalı çarpanla cycle'a çevrilir (TSC'de çarpan 1).
+// Burst TSC'de çözünürlük burst süresidir: aynı burst'te aynı VL'den iki
+// frame gap = 0 olarak (BAG biliniyorsa ihlal) sayılır.
+//
+// Bellek: VL başına 64 B (vl_map_count() kadar) + 16 B beklenti, queue başına
+// sabit. Tek yazar (sahibi rx_worker), relaxed store; stats lcore
+// rx_bag_snapshot_take() ile okur. Reset rx_sequence ile aynı epoch düzeni.
+
+#define RX_BAG_MAX_QUEUES    64
+#define RX_BAG_TOP_VLS       8
+#define RX_BAG_CALIB_MS      20     // NIC saati ↔ TSC kalibrasyon süresi
+#define RX_BAG_MULT_ONE      (1ULL << 32)
+
+// VL başına beklenen BAG (queue'ya kopya, salt okunur)
+struct rx_bag_expect {
+    uint64_t bag;           // cycles, 0 = BAG bilinmiyor
+    uint64_t floor;         // BAG - jitter bütçesi (cycles), altı ihlal
+};
+
+// VL başına (tam bir cache line)
+struct rx_bag_vl {
+    uint64_t last_ts;       // Son frame, kaynak biriminde (0 = henüz yok)
+    uint64_t prev_gap;      // cycles, BAG bilinmiyorsa jitter referansı
+    uint64_t gaps;          // Ölçülen gap sayısı, en son yazılır (release)
+    uint64_t sum_gap;
+    uint64_t min_gap;
+    uint64_t max_gap;
+    uint64_t max_jitter;
+    uint64_t violations;
+};
+
+struct rx_bag_queue {
+    struct rx_bag_vl *vl;               // [vl_count], sahibinin NUMA node'unda
+    struct rx_bag_expect *exp;          // [vl_count]
+    struct lat_hist jit;                // Queue'daki tüm VL'lerin jitter'ı
+    uint64_t ts_mult;                   // Kaynak birimi → cycle (32.32)
+    uint64_t ts_flag;                   // HW timestamp ol_flags biti (0 = TSC)
+    uint64_t no_ts;                     // HW modunda timestamp'siz gelen frame
+    uint64_t invalid;                   // Zaman geri gitti (ts < last_ts)
+    int ts_off;                         // mbuf dynfield offset'i
+    uint32_t epoch;                     // Uygulanan son reset epoch'u (sadece sahibi yazar)
+    uint16_t vl_count;
+    uint16_t port_id;
+    uint16_t queue_id;
+    uint16_t dtn_port;                  // STATS_MODE_DTN: queue → DTN port (yoksa 0xFFFF)
+} __rte_cache_aligned;
+
+extern uint32_t rx_bag_epoch;
+
+/**
+ * Create (or return the existing) analyzer state for an RX queue
+ * Beklenen BAG'ler bag_profile_vl() ile VL başına bir kez çözülür, zaman
+ * kaynağı portun kalibrasyonundan alınır (rx_bag_hw_ts_setup).
+ * Başlangıçta çağrılır (hot path değil), registry kısa bir lock ile korunur.
+ * @return queue pointer, NULL on allocation failure or registry full
+ */
+struct rx_bag_queue *rx_bag_queue_create(uint16_t port_id, uint16_t queue_id,
+                                         uint16_t vl_count, int socket_id);
+
+/**
+ * Calibrate the NIC RX timestamp clock of a started port against the TSC
+ * RX_BAG_HW_TIMESTAMP ve RTE_ETH_RX_OFFLOAD_TIMESTAMP açık portlar için
+ * init_port_txrx çağırır; başarısızsa port TSC ile devam eder.
+ */
+void rx_bag_hw_ts_setup(uint16_t port_id);
+
+/**
+ * Tüm queue'lara sıfırlama iste (warm-up reset, init_rx_stats)
+ * Health monitor'ün policing sayaçlarının o anki değeri referans alınır.
+ */
+void rx_bag_reset(void);
+
+// Sahibi çağırır (epoch değiştiğinde), rx_bag_queue_sync üzerinden
+void rx_bag_queue_clear(struct rx_bag_queue *q);
+
+// ==========================================
+// HOT PATH (sadece queue sahibi çağırır)
+// ==========================================
+
+// Burst başına bir kez: bekleyen reset varsa uygula
+static inline void rx_bag_queue_sync(struct rx_bag_queue *q)
+{
+    if (unlikely(q->epoch != __atomic_load_n(&rx_bag_epoch, __ATOMIC_ACQUIRE)))
+        rx_bag_queue_clear(q);
+}
+
+static inline void rx_bag_stat_set(uint64_t *ctr, uint64_t v)
+{
+    __atomic_store_n(ctr, v, __ATOMIC_RELAXED);
+}
+
+/**
+ * Record one frame; ts kaynak biriminde, vl_idx < q->vl_count olmalı
+ */
+static inline void rx_bag_record(struct rx_bag_queue *q, uint16_t vl_idx, uint64_t ts)
+{
+    struct rx_bag_vl *v = &q->vl[vl_idx];
+    const uint64_t last = v->last_ts;
+
+    v->last_ts = ts;
+    if (unlikely(last == 0))
+        return;
+    if (unlikely(ts < last)) {
+        rx_bag_stat_set(&q->invalid, q->invalid + 1);
+        return;
+    }
+
+    const uint64_t gap = (uint64_t)(((unsigned __int128)(ts - last) * q->ts_mult) >> 32);
+    const struct rx_bag_expect *e = &q->exp[vl_idx];
+    const uint64_t n = v->gaps;
+    uint64_t jit = 0;
+
+    if (likely(e->bag != 0)) {
+        jit = gap > e->bag ? gap - e->bag : e->bag - gap;
+        if (unlikely(gap < e->floor))
+            rx_bag_stat_set(&v->violations, v->violations + 1);
+        lat_hist_add(&q->jit, jit);
+    } else {
+        // BAG bilinmiyor: ardışık iki gap farkı (ilk gap'te referans yok)
+        const uint64_t prev = v->prev_gap;
+        if (n != 0) {
+            jit = gap > prev ? gap - prev : prev - gap;
+            lat_hist_add(&q->jit, jit);
+        }
+        v->prev_gap = gap;
+    }
+
+    rx_bag_stat_set(&v->sum_gap, v->sum_gap + gap);
+    if (n == 0 || gap < v->min_gap)
+        rx_bag_stat_set(&v->min_gap, gap);
+    if (gap > v->max_gap)
+        rx_bag_stat_set(&v->max_gap, gap);
+    if (jit > v->max_jitter)
+        rx_bag_stat_set(&v->max_jitter, jit);
+    // gaps en son: okuyucu n'i gördüyse diğer alanları da görür
+    __atomic_store_n(&v->gaps, n + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * Record one received frame: HW timestamp (queue HW moddaysa) veya burst TSC
+ */
+static inline void rx_bag_rx(struct rx_bag_queue *q, uint16_t vl_idx,
+                             const struct rte_mbuf *m, uint64_t rx_tsc)
+{
+#if RX_BAG_HW_TIMESTAMP
+    if (q->ts_flag != 0) {
+        // Kaynaklar karıştırılmaz: timestamp'siz frame ölçülmez
+        if (unlikely(!(m->ol_flags & q->ts_flag))) {
+            rx_bag_stat_set(&q->no_ts, q->no_ts + 1);
+            return;
+        }
+        rx_tsc = *RTE_MBUF_DYNFIELD(m, q->ts_off, const rte_mbuf_timestamp_t *);
+    }
+#else
+    RTE_SET_USED(m);
+#endif
+    rx_bag_record(q, vl_idx, rx_tsc);
+}
+
+// ==========================================
+// SNAPSHOT / REPORT (stats lcore)
+// ==========================================
+
+// Port veya DTN port satırı
+struct rx_bag_row {
+    uint64_t gaps;
+    uint64_t violations;
+    uint32_t vls;               // Gap'i olan (queue, VL) sayısı
+    uint32_t vls_known;         // Bunlardan BAG'i bilinen
+    uint32_t viol_vls;          // En az bir ihlali olan
+    double min_ratio;           // min(min_gap / BAG), vls_known > 0 iken
+    struct lat_hist jit;
+};
+
+struct rx_bag_worst_vl {
+    uint16_t port_id;
+    uint16_t queue_id;
+    uint16_t vl_id;
+    double ratio;               // min_gap / BAG
+    double min_gap_us;
+    double bag_us;
+    double max_jitter_us;
+    uint64_t violations;
+};
+
+struct rx_bag_snapshot {
+    struct rx_bag_row port[MAX_PORTS];
+#if STATS_MODE_DTN
+    struct rx_bag_row dtn[DTN_PORT_COUNT];
+#endif
+    struct rx_bag_worst_vl worst[RX_BAG_TOP_VLS];  // min_gap / BAG artan
+    uint32_t nb_worst;
+    uint64_t violations;
+    uint64_t no_ts;
+    uint64_t invalid;
+};
+
+/**
+ * Merge every queue (reset'i uygulamış olanlar) into port / DTN rows
+ * ve min_gap / BAG oranı en düşük RX_BAG_TOP_VLS (port, queue, VL)'i seç.
+ */
+void rx_bag_snapshot_take(struct rx_bag_snapshot *snap);
+
+// Saniyelik tablo + DUT policing sayaçları (reset'ten bu yana artış)
+void rx_bag_print_stats(const struct rx_bag_snapshot *snap);
+
+// Test sonu: ihlali olan VL'ler ve switch portu bazında policing sayaçları
+void rx_bag_print_vl_report(void);
+
+#endif /* RX_BAG_H */
@@ -0,0 +1,135 @@
+#ifndef RX_SEQUENCE_H
+#define RX_SEQUENCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <rte_common.h>
+#include <rte_branch_prediction.h>
+#include "vl_map.h"
+
+// ==========================================
+// QUEUE-PRIVATE RX SEQUENCE TRACKERS
+// ==========================================
+// Her RX queue, aldığı VL'ler için kendi (özel) tracker dizisini tutar.
+// Dizi ham VL-ID yerine vl_map dense index'i ile indekslenir (32 B / VL,
+// birkaç bin VL'de bile queue başına working set L2'ye sığar):
+//
+//   - Hot path'te atomic RMW, CAS veya başka queue ile paylaşılan cache
+//     line yoktur; tek yazar sahibi olan rx_worker'dır (relaxed/release store)
+//   - Stats lcore periyodik olarak rx_seq_merge() ile queue'ları birleştirir:
+//       lost = span - N      (span > N ise)
+//       dup  = N - span      (N > span ise; kayıp yoksa kesin, varsa alt sınır)
+//       ooo  = Σ queue içi geç gelen paket (seq < o queue'nun max_seq'i)
+//     N = tüm queue'lardaki paket sayısı toplamı,
+//     span = max_seq - min_seq + 1 (watermark: TX sequence'ları reset'te
+//            sıfırlanmadığı için 0'dan değil ilk görülen sequence'tan)
+//   - Queue'lar arası sıra anlamsızdır (RSS aynı VL'yi bölebilir), bu yüzden
+//     reorder yalnızca queue içinde sayılır. VLAN ve raw VL flow kuralları
+//     (RAW_VL_FLOW_STEERING_ENABLED) bir VL'i tek queue'ya sabitlediğinde
+//     sonuçlar kesindir.
+//   - Canlı değer bir tahmindir: henüz başka queue'nun ring'inde bekleyen
+//     paketler geçici kayıp gibi görünür; worker'lar durduktan sonraki merge kesindir.
+//
+// Reset (warm-up): rx_seq_reset() global epoch'u artırır, her worker bir
+// sonraki burst'te kendi dizisini sıfırlar. Epoch'u eski olan queue'lar
+// merge'de atlanır. reset ve merge aynı (stats/main) lcore'dan çağrılmalı.
+
+#define RX_SEQ_MAX_QUEUES 64
+
+struct rx_seq_track {
+    uint64_t max_seq;       // Bu queue'da görülen en yüksek sequence
+    uint64_t min_seq;       // Görülen en düşük sequence (watermark tabanı)
+    uint64_t pkt_count;     // Bu queue'ya düşen paket sayısı (0 = VL görülmedi)
+    uint64_t late_count;    // seq < max_seq ile gelen paketler (queue içi reorder)
+};
+
+struct rx_seq_queue {
+    struct rx_seq_track *vl;    // [vl_count], index = vl_map_index(), sahibinin NUMA node'unda
+    uint32_t epoch;             // Uygulanan son reset epoch'u (sadece sahibi yazar)
+    uint16_t vl_count;
+    uint16_t port_id;
+    uint16_t queue_id;
+} __rte_cache_aligned;
+
+/**
+ * Merge sonucu (bir port + VL aralığı için)
+ */
+struct rx_seq_totals {
+    uint64_t pkts;
+    uint64_t lost;
+    uint64_t out_of_order;
+    uint64_t duplicate;
+};
+
+extern uint32_t rx_seq_epoch;
+
+/**
+ * Create (or return the existing) tracker array for an RX queue
+ * Başlangıçta çağrılır (hot path değil), registry kısa bir lock ile korunur.
+ * @return queue pointer, NULL on allocation failure or registry full
+ */
+struct rx_seq_queue *rx_seq_queue_create(uint16_t port_id, uint16_t queue_id,
+                                         uint16_t vl_count, int socket_id);
+
+/**
+ * Tüm queue'lara sıfırlama iste (warm-up reset, init_rx_stats)
+ */
+void rx_seq_reset(void);
+
+// Sahibi çağırır (epoch değiştiğinde), rx_seq_queue_sync üzerinden
+void rx_seq_queue_clear(struct rx_seq_queue *q);
+
+// ==========================================
+// HOT PATH (sadece queue sahibi çağırır)
+// ==========================================
+
+// Burst başına bir kez: bekleyen reset varsa uygula
+static inline void rx_seq_queue_sync(struct rx_seq_queue *q)
+{
+    if (unlikely(q->epoch != __atomic_load_n(&rx_seq_epoch, __ATOMIC_ACQUIRE)))
+        rx_seq_queue_clear(q);
+}
+
+/**
+ * Record one packet; idx = vl_map_index(vl_id), idx < q->vl_count olmalı
+ * @return bu queue içinde atlanan sequence sayısı (seq > max_seq + 1 ise), aksi 0
+ */
+static inline uint64_t rx_seq_update(struct rx_seq_queue *q, uint16_t idx, uint64_t seq)
+{
+    struct rx_seq_track *t = &q->vl[idx];
+    const uint64_t n = t->pkt_count;
+    uint64_t gap = 0;
+
+    if (unlikely(n == 0)) {
+        __atomic_store_n(&t->min_seq, seq, __ATOMIC_RELAXED);
+        __atomic_store_n(&t->max_seq, seq, __ATOMIC_RELAXED);
+    } else if (likely(seq > t->max_seq)) {
+        gap = seq - t->max_seq - 1;
+        __atomic_store_n(&t->max_seq, seq, __ATOMIC_RELAXED);
+    } else if (seq < t->max_seq) {
+        __atomic_store_n(&t->late_count, t->late_count + 1, __ATOMIC_RELAXED);
+        // İlk paketten önce gönderilmiş geç paket: watermark tabanı aşağı iner
+        if (unlikely(seq < t->min_seq))
+            __atomic_store_n(&t->min_seq, seq, __ATOMIC_RELAXED);
+    }
+    // pkt_count en son: okuyucu n'i gördüyse n. paketin max/min'ini de görür
+    __atomic_store_n(&t->pkt_count, n + 1, __ATOMIC_RELEASE);
+    return gap;
+}
+
+// ==========================================
+// MERGE (stats lcore)
+// ==========================================
+
+/**
+ * Combine every registered queue of a port over VL-IDs [vl_start, vl_end)
+ * Kayıtlı olmayan VL-ID'ler atlanır.
+ * @return number of queues merged (0 → port'un aktif RX queue'su yok)
+ */
+uint32_t rx_seq_merge(uint16_t port_id, uint32_t vl_start, uint32_t vl_end,
+                      struct rx_seq_totals *out);
+
+// Tüm kayıtlı VL'ler üzerinden (dense index sırasıyla)
+uint32_t rx_seq_merge_all(uint16_t port_id, struct rx_seq_totals *out);
+
+#endif /* RX_SEQUENCE_H */
@@ -0,0 +1,172 @@
+#ifndef STATS_SHARD_H
+#define STATS_SHARD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <rte_common.h>
+#include "config.h"
+#include "port.h"
+
+// ==========================================
+// SHARDED PER-WORKER STATISTICS
+// ==========================================
+// Her worker (DPDK lcore veya raw socket pthread) kendi cache-aligned sayaç
+// bloğuna (shard) yazar; paylaşılan atomic, spinlock veya flush eşiği yoktur:
+//
+//   - Tek yazar: shard'ın sahibi worker'dır, güncelleme plain (relaxed) store
+//     ile yapılır (load + add + store, RMW yok). Worker'lar yerel sayaçlarını
+//     burst / send() batch başına yayınlar → düşük hızda da bayat değer yok.
+//   - Bir grup güncelleme stats_shard_begin/end arasında yapılır (seqcount);
+//     okuyucu yırtılmamış, kendi içinde tutarlı bir shard görür.
+//   - Collector (stats lcore) stats_snapshot_take() ile tüm shard'ları
+//     domain/port/alt-index bazında toplar; tablolar tek snapshot'tan çizilir.
+//   - Reset (warm-up) sayaçlara yazmaz: collector her shard'ın o anki değerini
+//     baseline olarak saklar, sonraki snapshot'lar farkı döner.
+//
+// Sıra dışı/kayıp/duplicate (VL sequence merge) worker sayacı değildir;
+// merge sonucu stats_publish_port_seq() ile snapshot'a eklenir.
+
+#define STATS_MAX_SHARDS  512
+#define STATS_DTN_NONE    0xFFFF
+
+// Shard'ın sayaçlarının ait olduğu tablo
+enum stats_domain {
+    STATS_DOM_PORT_RX = 0,      // rx_worker, group = DPDK port, sub = queue
+    STATS_DOM_RAW_TX,           // raw_tx_worker, group = raw index, sub = target
+    STATS_DOM_RAW_RX,           // raw RX worker'ları, group = raw index, sub = rx source
+    STATS_DOM_RAW_EXT_RX,       // raw port'a gelen DPDK external TX, group = raw index
+    STATS_DOM_EXT_TX,           // dpdk_ext_tx_worker, group = ext port index
+    STATS_DOM_COUNT
+};
+
+/**
+ * Sayaç seti (shard ve snapshot aynı düzeni kullanır, hepsi uint64_t)
+ * Her domain yalnızca kendisiyle ilgili alanları doldurur.
+ */
+struct stats_counters {
+    uint64_t pkts;              // RX: alınan, TX: gönderilen
+    uint64_t bytes;
+    uint64_t errors;            // TX: send() hatası
+    uint64_t good_pkts;
+    uint64_t bad_pkts;
+    uint64_t bit_errors;
+    uint64_t lost_pkts;
+    uint64_t out_of_order_pkts;
+    uint64_t duplicate_pkts;
+    uint64_t short_pkts;        // Minimum uzunluktan kısa paketler
+    uint64_t external_pkts;     // Harici hatlardan gelen (VL-ID kaynak aralığı dışı)
+    uint64_t raw_pkts;          // DPDK RX'e gelen raw socket (non-VLAN) paketler
+    uint64_t raw_bytes;
+};
+
+#define STATS_COUNTER_WORDS (sizeof(struct stats_counters) / sizeof(uint64_t))
+
+struct stats_shard {
+    struct stats_counters c;    // Sadece sahibi yazar
+    uint32_t seq;               // seqcount: tek = yazım sürüyor
+    uint16_t group;
+    uint16_t sub;
+    uint16_t instance;          // Aynı (group, sub)'a yazan worker'lar (queue id)
+    uint16_t dtn_port;          // STATS_DOM_PORT_RX: DTN tablosuna da eklenir
+    uint8_t domain;             // enum stats_domain
+
+    // Collector'a ait (reset baseline), ayrı cache line
+    struct stats_counters base __rte_cache_aligned;
+} __rte_cache_aligned;
+
+/**
+ * Collector çıktısı: tüm tablolar tek seferde toplanır
+ */
+struct stats_snapshot {
+    struct stats_counters port_rx[MAX_PORTS];
+#if STATS_MODE_DTN
+    struct stats_counters dtn[DTN_PORT_COUNT];
+#endif
+    struct stats_counters raw_tx[MAX_RAW_SOCKET_PORTS][MAX_RAW_TARGETS];
+    struct stats_counters raw_rx[MAX_RAW_SOCKET_PORTS][MAX_RAW_TARGETS];
+    struct stats_counters raw_ext_rx[MAX_RAW_SOCKET_PORTS];
+    struct stats_counters ext_tx[DPDK_EXT_TX_PORT_COUNT];
+};
+
+/**
+ * Create (or return the existing) shard of a worker
+ * Aynı (domain, group, sub, instance) için ikinci çağrı aynı shard'ı döner
+ * (worker yeniden başlasa da sayaçlar devam eder). Hot path değil.
+ * @param socket_id NUMA node (raw pthread'ler için SOCKET_ID_ANY)
+ * @return shard pointer, NULL on allocation failure or registry full
+ */
+struct stats_shard *stats_shard_create(enum stats_domain domain, uint16_t group,
+                                       uint16_t sub, uint16_t instance, int socket_id);
+
+// ==========================================
+// HOT PATH (sadece shard sahibi çağırır)
+// ==========================================
+
+// Yayın grubu başı/sonu (seqcount), arada yalnızca stats_add
+static inline void stats_shard_begin(struct stats_shard *s)
+{
+    __atomic_store_n(&s->seq, s->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static inline void stats_shard_end(struct stats_shard *s)
+{
+    __atomic_store_n(&s->seq, s->seq + 1, __ATOMIC_RELEASE);
+}
+
+// Tek yazar: RMW yok, okuyucu yırtılmamış 64-bit değer görür
+static inline void stats_add(uint64_t *ctr, uint64_t v)
+{
+    __atomic_store_n(ctr, *ctr + v, __ATOMIC_RELAXED);
+}
+
+/**
+ * Publish a worker's local counters into its shard and zero them
+ * Burst / batch sonunda bir kez: tek seqcount grubu, RMW yok.
+ */
+static inline void stats_shard_publish(struct stats_shard *s, struct stats_counters *local)
+{
+    uint64_t *dst = (uint64_t *)&s->c;
+    uint64_t *src = (uint64_t *)local;
+
+    stats_shard_begin(s);
+    for (size_t i = 0; i < STATS_COUNTER_WORDS; i++) {
+        if (src[i]) {
+            stats_add(&dst[i], src[i]);
+            src[i] = 0;
+        }
+    }
+    stats_shard_end(s);
+}
+
+// ==========================================
+// COLLECTOR (stats lcore)
+// ==========================================
+
+/**
+ * Sum every shard into snap (baseline düşülmüş)
+ * Sequence merge sonuçları (stats_publish_*_seq) da eklenir.
+ */
+void stats_snapshot_take(struct stats_snapshot *snap);
+
+/**
+ * Warm-up reset: mevcut değerler baseline olur, worker'lar yazmaya devam eder
+ * Yayınlanmış sequence sonuçları da sıfırlanır.
+ */
+void stats_reset(void);
+
+/**
+ * Publish a VL sequence merge result into port_rx[port_id] (set, add değil)
+ * Merge ile aynı (stats) lcore'dan çağrılır.
+ */
+void stats_publish_port_seq(uint16_t port_id, uint64_t lost,
+                            uint64_t out_of_order, uint64_t duplicate);
+
+#if STATS_MODE_DTN
+// Aynısı, DTN satırı için
+void stats_publish_dtn_seq(uint16_t dtn_port, uint64_t lost,
+                           uint64_t out_of_order, uint64_t duplicate);
+#endif
+
+#endif /* STATS_SHARD_H */
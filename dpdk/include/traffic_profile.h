@@ -0,0 +1,113 @@
+#ifndef TRAFFIC_PROFILE_H
+#define TRAFFIC_PROFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+// ==========================================
+// RUNTIME TRAFFIC PROFILE
+// ==========================================
+// Rate, VLAN / VL-ID haritası, raw port hedefleri, DPDK external TX hedefleri
+// ve IMIX pattern'i başlangıçta bir metin dosyasından okunur; config.h
+// makroları sadece varsayılan tablolardır (profil yoksa davranış aynıdır).
+// Konfigürasyon değişikliği için yeniden derleme / deploy gerekmez:
+//
+//   sudo ./dpdk_app --profile /etc/dpdk_app/ate.profile -l 0-255 -n 16
+//
+// --profile verilmezse TRAFFIC_PROFILE_PATH (varsa) okunur.
+//
+// Format (satır başına bir anahtar, '#' sonrası yorum):
+//
+//   mode    = any            # normal | ate | any: bölümler hangi modda uygulanır
+//   pacing  = rate_limiter   # rate_limiter | token_bucket | bag (build ile aynı olmalı)
+//   imix    = 100,200,400,800,1200,1200,1200,1518,1518,1518
+//
+//   [port 2]                 # DPDK port (0..MAX_PORTS_CONFIG-1)
+//   rate_gbps = 3.5
+//   tx_vlans  = 97,98,99,100
+//   tx_vl_ids = 3,131,259,387     # queue başına VL aralığı başlangıcı
+//   rx_vlans  = 225,226,227,228
+//   rx_vl_ids = 3,131,259,387
+//
+//   [raw 12]                 # raw socket port (aktif raw port tablosunda olmalı)
+//   target = 0,13,80,4099,128     # id, dest_port, rate_mbps, vl_start, vl_count
+//   source = 13,6275,32           # source_port, vl_start, vl_count
+//   backend = af_xdp              # af_packet | af_xdp (raw_xdp.h)
+//   tx_submit = io_uring          # ring | sendmmsg | io_uring (raw_tx_batch.h)
+//   interface = veth-p12          # config.h arayüzü yerine (örn. veth testi)
+//
+//   [ext 2]                  # DPDK external TX portu
+//   dest_port = 12
+//   target = 0,97,4291,32,220     # queue, vlan, vl_start, vl_count, rate_mbps
+//
+// Bir bölümdeki ilk 'target' / 'source' satırı o portun listesini baştan kurar.
+//
+// Hot path'e dokunulmaz: sabitler (VL_RANGE_SIZE_PER_QUEUE, IMIX_PATTERN_SIZE,
+// NUM_TX/RX_CORES) derleme zamanında kalır, profil sadece tablo içeriklerini
+// değiştirir. Pacing modu (TOKEN_BUCKET_TX_ENABLED / BAG_SCHED_ENABLED) ayrı
+// kod yollarıdır; profil modu doğrular, farklıysa yükleme reddedilir.
+
+#ifndef TRAFFIC_PROFILE_PATH
+#define TRAFFIC_PROFILE_PATH "/etc/dpdk_app/traffic.profile"
+#endif
+
+#define TRAFFIC_PROFILE_MAX_LINE 512
+
+/**
+ * Parse and validate a profile file (EAL'den önce, bir kez)
+ * IMIX pattern hemen uygulanır; port / raw / ext bölümleri mod seçildikten
+ * sonra traffic_profile_apply_*() ile uygulanır.
+ * @param path Profile file, NULL = TRAFFIC_PROFILE_PATH (yoksa varsayılanlar)
+ * @return 0 on success, -1 on read / parse / validation error
+ */
+int traffic_profile_load(const char *path);
+
+// Yüklenen profilin yolu (profil yoksa NULL)
+const char *traffic_profile_path(void);
+
+/**
+ * Mode defaults + profile overrides for DPDK ports and external TX
+ * port_vlans_load_config() sonrasında çağrılır: port rate tablosu, port_vlans
+ * ve dpdk_ext_tx_configs.
+ */
+void traffic_profile_apply_ports(bool ate_mode);
+
+/**
+ * Profile overrides for raw socket ports (raw_socket_ports_load_config sonrası)
+ */
+void traffic_profile_apply_raw(bool ate_mode);
+
+/**
+ * Port hedef rate'i (Gbps): profil, yoksa mod varsayılanı (config.h)
+ */
+double traffic_port_rate_gbps(uint16_t port_id);
+
+// Rapor için: "FAST" / "MID" / "SLOW" / "PROFILE" / "LIVE"
+const char *traffic_port_rate_class(uint16_t port_id);
+
+// ==========================================
+// LIVE RELOAD (live_ctl "reload")
+// ==========================================
+
+// Çalışırken uygulanabilen kısım: port rate'leri ve IMIX
+struct traffic_profile_live {
+    bool rate_set[MAX_PORTS_CONFIG];
+    double rate_gbps[MAX_PORTS_CONFIG];
+    bool imix_set;
+    uint16_t imix[IMIX_PATTERN_SIZE];
+    bool restart_needed;        // VLAN / VL / raw / ext bölümleri var (sadece başlangıçta)
+    bool mode_mismatch;         // mode = ... çalışan moda uymuyor, port bölümleri atlandı
+};
+
+/**
+ * Parse a profile without touching the running tables
+ * Başlangıçta yüklenen profil durumu değişmez.
+ * @return 0 on success, -1 on read / parse / validation error
+ */
+int traffic_profile_read_live(const char *path, bool ate_mode, struct traffic_profile_live *out);
+
+// Canlı rate değişikliğini rate tablosuna yansıt (sınıf "LIVE")
+void traffic_port_rate_update(uint16_t port_id, double rate_gbps);
+
+#endif /* TRAFFIC_PROFILE_H */
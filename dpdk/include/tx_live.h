@@ -0,0 +1,140 @@
+#ifndef TX_LIVE_H
+#define TX_LIVE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <rte_common.h>
+#include <rte_branch_prediction.h>
+#include "config.h"
+
+// ==========================================
+// LIVE TX PARAMETERS (RCU tarzı blok değişimi)
+// ==========================================
+// Her DPDK TX worker'ın bir slot'u vardır; slot o an geçerli parametre
+// bloğunu (paket arası süre, aktif VL sayısı, IMIX pattern) gösterir.
+//
+//   - Kontrol tarafı (main lcore, live_ctl) yeni bloğu ayırıp doldurur ve
+//     pointer'ı release ile yayınlar. Blok yayınlandıktan sonra değişmez.
+//   - Worker döngü başına pointer'ı karşılaştırır; farklıysa değerleri
+//     yerel değişkenlerine alır ve gördüğü gen'i yazar (quiescent state).
+//   - Eski blok ancak worker yeni gen'i onayladıktan (veya worker durduktan)
+//     sonra serbest bırakılır; onay gelmeden ikinci değişiklik reddedilir.
+//
+// Worker'ın TX sequence bloğu, header template'leri ve RX tarafındaki
+// tracker'lar bloğun parçası değildir: değişiklikte sıfırlanmazlar. Aktif
+// VL sayısı küçülürse dışarıda kalan VL'ler duraklar (sequence'ları yerinde
+// kalır, RX tarafında kayıp olarak görünmez), büyüyünce kaldıkları yerden
+// devam eder.
+
+// Token bucket ve BAG modlarında paket arası süre VL düzeninden gelir
+#define TX_LIVE_ACTIVE (LIVE_CTL_ENABLED && !TOKEN_BUCKET_TX_ENABLED && !BAG_SCHED_ENABLED)
+
+#define TX_LIVE_MAX_SLOTS      64
+#define TX_LIVE_GRACE_MS       1000    // Worker onayı için en fazla bekleme
+#define TX_LIVE_MIN_GBPS       0.01    // Port başına alt sınır (onay süresi sınırlı kalsın)
+#define TX_LIVE_MAX_GBPS       100.0
+
+// Yayınlandıktan sonra salt okunur
+struct tx_live_params {
+    uint64_t gen;
+    uint64_t delay_cycles;              // Queue'nun paket arası süresi
+    double rate_gbps;                   // Port toplamı (queue'lara eşit bölünür)
+    uint32_t imix_avg;                  // Rate → pps için ortalama boyut
+    uint16_t vl_count;                  // Aktif VL sayısı [1, slot vl_range]
+    uint16_t imix[IMIX_PATTERN_SIZE];
+};
+
+struct tx_live_slot {
+    struct tx_live_params *cur;         // Yayınlanan blok (kontrol yazar, release)
+    uint64_t seen_gen;                  // Worker'ın geçtiği son gen (sadece worker yazar)
+    bool running;                       // Worker döngüde (attach / detach)
+    struct tx_live_params *retired;     // Onay bekleyen eski blok (sadece kontrol)
+    uint64_t changes;
+    int socket_id;
+    uint16_t port_id;
+    uint16_t queue_id;
+    uint16_t vl_range;                  // Worker'ın ayrılmış VL aralığı (üst sınır)
+} __rte_cache_aligned;
+
+/**
+ * Create (or return the existing) live slot of a TX worker
+ * İlk blok: rate_gbps (port toplamı), tüm VL aralığı aktif, mevcut IMIX pattern.
+ * Worker yeniden başlatıldıysa mevcut slot (son canlı değerleriyle) döner.
+ * Başlangıçta çağrılır (hot path değil), registry kısa bir lock ile korunur.
+ * @return slot pointer, NULL on allocation failure or registry full
+ */
+struct tx_live_slot *tx_live_register(uint16_t port_id, uint16_t queue_id,
+                                      uint16_t vl_range, double rate_gbps, int socket_id);
+
+/**
+ * Portun tüm TX queue'larına yeni toplam rate (hepsi ya da hiçbiri)
+ * @return number of queues updated, negative errno on failure
+ *         (-EBUSY: bir queue önceki değişikliği henüz görmedi, hiçbiri değişmedi)
+ */
+int tx_live_set_rate(uint16_t port_id, double rate_gbps);
+
+/**
+ * Portun queue başına aktif VL sayısı (1..VL aralığı), hepsi ya da hiçbiri
+ * @return number of queues updated, negative errno on failure
+ */
+int tx_live_set_vls(uint16_t port_id, uint16_t vl_count);
+
+/**
+ * Portun kayıtlı TX queue (slot) sayısı
+ */
+int tx_live_port_queues(uint16_t port_id);
+
+/**
+ * Tüm TX worker'larına yeni IMIX pattern (IMIX_PATTERN_SIZE boyut, rate korunur),
+ * hepsi ya da hiçbiri
+ * @return number of queues updated, negative errno on failure
+ */
+int tx_live_set_imix(const uint16_t *pattern);
+
+/**
+ * Slot başına gen / rate / VL / bekleyen onay (status komutu)
+ * @return bytes written to buf (NUL hariç, len'e sığacak kadar kesilir)
+ */
+size_t tx_live_format_status(char *buf, size_t len);
+
+// ==========================================
+// HOT PATH (sadece slot sahibi worker çağırır)
+// ==========================================
+
+// Worker başında: geçerli bloğu al, onayla
+// Sıra önemli: running cur okunmadan önce görünmeli. Fence tx_live_reclaim'deki
+// ile eşlidir: ya kontrol tarafı running=true görüp onay bekler, ya da worker
+// yeni cur'u okur. Aksi halde load ile running store'u arasına düşen publish
+// running=false görür ve worker'ın okuduğu bloğu serbest bırakır.
+static inline const struct tx_live_params *tx_live_attach(struct tx_live_slot *s)
+{
+    __atomic_store_n(&s->running, true, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    const struct tx_live_params *p = __atomic_load_n(&s->cur, __ATOMIC_ACQUIRE);
+    __atomic_store_n(&s->seen_gen, p->gen, __ATOMIC_RELEASE);
+    return p;
+}
+
+// Worker çıkışı: artık blok tutmuyor, kontrol tarafı onay beklemez
+static inline void tx_live_detach(struct tx_live_slot *s)
+{
+    __atomic_store_n(&s->running, false, __ATOMIC_RELEASE);
+}
+
+/**
+ * Döngü başına: yeni blok yayınlandıysa ona geç ve onayla
+ * @return true if *p changed (çağıran türetilmiş değerleri yeniden hesaplar)
+ */
+static inline bool tx_live_sync(struct tx_live_slot *s, const struct tx_live_params **p)
+{
+    const struct tx_live_params *n = __atomic_load_n(&s->cur, __ATOMIC_ACQUIRE);
+    if (likely(n == *p))
+        return false;
+    *p = n;
+    // Eski bloğa artık dokunulmuyor: kontrol tarafı serbest bırakabilir
+    __atomic_store_n(&s->seen_gen, n->gen, __ATOMIC_RELEASE);
+    return true;
+}
+
+#endif /* TX_LIVE_H */
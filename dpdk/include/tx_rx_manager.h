@@ -7,6 +7,12 @@
 #include <rte_atomic.h>
 #include "port.h"
 #include "packet.h"
+#include "tx_sequence.h"
+#include "rx_sequence.h"
+#include "vl_map.h"
+#include "stats_shard.h"
+#include "latency_hist.h"
+#include "rx_bag.h"
 #include "config.h"
 
 #define TX_RING_SIZE 2048
@@ -18,19 +24,19 @@
 // VL-ID range limits
 // Her port'un tx_vl_ids başlangıç değerleri farklı olabilir (örn: Port 7 → 3971)
 // Her queue için 128 VL-ID aralığı var
-// Raw socket portları için genişletildi:
-//   - Raw Port 0 (1G): 4099-4226 (128 VL-ID)
-//   - Raw Port 1 (100M): 4227-4258 (32 VL-ID)
-// DPDK External TX için genişletildi:
-//   - Port 2: 4259-4386, Port 3: 4387-4514
-//   - Port 0: 4515-4642, Port 1: 4643-4770
-#define MAX_VL_ID 4800  // Increased to support DPDK external TX (up to 4770)
+// Üst sınır yok: per-VL tablolar vl_map dense index'i ile boyutlanır (vl_map.h)
 #define MIN_VL_ID 3
 #define VL_RANGE_SIZE_PER_QUEUE 128  // Her queue için 128 VL-ID
 
 // Global VLAN configuration for all ports
 extern struct port_vlan_config port_vlans[MAX_PORTS_CONFIG];
 
+// Phase 2 port eşlemesi (TX → RX): çift port → +1, tek port → -1
+static inline uint16_t paired_port(uint16_t port_id)
+{
+    return (port_id % 2 == 0) ? (uint16_t)(port_id + 1) : (uint16_t)(port_id - 1);
+}
+
 /**
  * @brief Load VLAN config based on ATE mode
  * Call after g_ate_mode is set (after latency test sequence).
@@ -50,45 +56,14 @@ struct rate_limiter
     uint64_t tsc_hz;         // TSC frequency
 };
 
-// RX Statistics per port
-struct rx_stats
-{
-    rte_atomic64_t total_rx_pkts;
-    rte_atomic64_t good_pkts;
-    rte_atomic64_t bad_pkts;
-    rte_atomic64_t bit_errors;
-    rte_atomic64_t out_of_order_pkts;  // Sıra dışı gelen paketler
-    rte_atomic64_t lost_pkts;          // Kayıp paketler (sequence gap)
-    rte_atomic64_t duplicate_pkts;     // Tekrar eden paketler
-    rte_atomic64_t short_pkts;         // Minimum uzunluktan kısa paketler
-    rte_atomic64_t external_pkts;      // Harici hatlardan gelen paketler (VL-ID aralık dışı)
-    // Raw socket paketleri (non-VLAN) - DPDK'dan ayrı takip
-    rte_atomic64_t raw_socket_rx_pkts; // Raw socket'ten gelen paket sayısı
-    rte_atomic64_t raw_socket_rx_bytes; // Raw socket'ten gelen byte sayısı
-};
-
-extern struct rx_stats rx_stats_per_port[MAX_PORTS];
+// RX istatistikleri: queue başına shard (stats_shard.h, STATS_DOM_PORT_RX),
+// tablolar stats_snapshot_take() ile toplanır
 
 // ==========================================
 // DTN PORT-BASED STATISTICS (STATS_MODE_DTN)
 // ==========================================
 #if STATS_MODE_DTN
 
-// DTN port bazlı PRBS istatistikleri
-// DTN TX (DTN→Server) kalite metrikleri: Server RX tarafında ölçülür
-struct dtn_port_stats {
-    rte_atomic64_t good_pkts;
-    rte_atomic64_t bad_pkts;
-    rte_atomic64_t bit_errors;
-    rte_atomic64_t lost_pkts;
-    rte_atomic64_t out_of_order_pkts;
-    rte_atomic64_t duplicate_pkts;
-    rte_atomic64_t short_pkts;
-    rte_atomic64_t total_rx_pkts;     // Server RX = DTN TX paket sayısı
-};
-
-extern struct dtn_port_stats dtn_stats[DTN_PORT_COUNT];
-
 // DTN port mapping tablosu (runtime'da config'den yüklenir)
 extern struct dtn_port_map_entry dtn_port_map[DTN_PORT_COUNT];
 
@@ -100,11 +75,6 @@ extern uint8_t vlan_to_dtn_port[DTN_VLAN_LOOKUP_SIZE];
  */
 void init_dtn_port_map(void);
 
-/**
- * Initialize DTN port statistics
- */
-void init_dtn_stats(void);
-
 /**
  * Install VLAN-based rte_flow rules for RX queue steering
  * Her VLAN → ilgili RX queue'ya yönlendirilir (1:1 mapping)
@@ -118,29 +88,27 @@ void dtn_flow_rules_remove(uint16_t port_id);
 
 #endif /* STATS_MODE_DTN */
 
+#if RAW_VL_FLOW_STEERING_ENABLED
 /**
- * VL-ID based sequence tracking (lock-free, watermark-based)
- * Uses highest-seen watermark instead of expected sequence
- * This approach handles RSS-induced reordering correctly
+ * Pin untagged raw socket VL ranges arriving on a DPDK port to single RX queues
+ * Kurallar raw_port_configs tx_targets'tan üretilir (dest_port == port_id).
+ * Port start sonrası, flow_registry_build() ile aynı aşamada çağrılır.
+ * @return number of installed rules (0 = port'a raw trafik yok), -1 on RSS fallback
  */
-struct vl_sequence_tracker {
-    volatile uint64_t max_seq;       // Highest sequence seen for this VL-ID
-    volatile uint64_t min_seq;       // Lowest sequence seen (first packet - for watermark calc)
-    volatile uint64_t pkt_count;     // Total packets received for this VL-ID
-    volatile uint64_t expected_seq;  // Expected next sequence for real-time gap detection
-    volatile int initialized;        // Has this VL-ID been seen before? (0=false, 1=true)
-};
+int raw_vl_flow_rules_install(uint16_t port_id, uint16_t nb_queues);
 
 /**
- * Per-port VL-ID sequence tracking table
- * Lock-free design: each VL-ID tracker uses atomic operations
+ * Remove the raw VL-ID rules of a port
  */
-struct port_vl_tracker {
-    struct vl_sequence_tracker vl_trackers[MAX_VL_ID + 1];  // Index by VL-ID
-    // No lock needed - using lock-free atomic operations per VL-ID
-};
+void raw_vl_flow_rules_remove(uint16_t port_id);
+#endif
 
-extern struct port_vl_tracker port_vl_trackers[MAX_PORTS];
+/**
+ * Merge queue-private VL sequence trackers and publish lost / out_of_order /
+ * duplicate into the stats snapshot (stats_publish_*_seq, set, add değil).
+ * Stats lcore'dan saniyede bir, worker'lar durduktan sonra final=true ile çağrılır.
+ */
+void merge_rx_sequence_stats(bool final);
 
 /**
  * TX/RX configuration for a port
@@ -168,6 +136,8 @@ struct tx_worker_params
     struct rte_mempool *mbuf_pool;
     volatile bool *stop_flag;
     uint64_t sequence_number;  // Not used anymore - VL-ID based now
+    struct tx_seq_block *seq_block;  // Worker'a ait VL sequence'ları (index = VL offset)
+    struct tx_live_slot *live;       // Canlı rate / VL / IMIX bloğu (tx_live.h), NULL = sabit
     struct rate_limiter limiter;
 
     // External TX parameters (for Port 12 via switch)
@@ -181,6 +151,27 @@ struct tx_worker_params
     uint16_t nb_ports;
 };
 
+/**
+ * Per-lcore TX throughput counters
+ * Tek yazıcı (ilgili TX worker), okuyucu stats döngüsü - atomic gerekmez
+ */
+struct tx_lcore_stats
+{
+    uint16_t port_id;
+    uint16_t queue_id;
+    volatile bool active;
+    volatile uint64_t tx_pkts;     // Gönderilen paket sayısı
+    volatile uint64_t tx_bursts;   // Başarılı rte_eth_tx_burst çağrısı sayısı
+    uint64_t start_tsc;            // Worker başlangıç zamanı
+} __rte_cache_aligned;
+
+extern struct tx_lcore_stats tx_lcore_stats[RTE_MAX_LCORE];
+
+/**
+ * Print per-lcore TX pps (son aralık + ortalama) and average burst size
+ */
+void print_tx_lcore_stats(void);
+
 /**
  * RX worker parameters
  */
@@ -193,6 +184,10 @@ struct rx_worker_params
     uint16_t vlan_id;       // VLAN header tag (802.1Q)
     uint16_t vl_id;         // VL ID for MAC/IP (different from VLAN)
     volatile bool *stop_flag;
+    struct rx_seq_queue *seq_queue;  // Queue'ya özel VL sequence tracker'ları
+    struct stats_shard *stats;       // Queue'ya özel sayaç bloğu (tek yazar)
+    struct lat_queue *lat_queue;     // In-band latency histogramları (INBAND_LATENCY_ENABLED)
+    struct rx_bag_queue *bag_queue;  // VL inter-arrival / BAG analizörü (RX_BAG_MONITOR_ENABLED)
 };
 
 /**
@@ -267,7 +262,7 @@ int start_txrx_workers(struct ports_config *ports_config, volatile bool *stop_fl
 void print_port_stats(struct ports_config *ports_config);
 
 /**
- * Initialize RX statistics and VL-ID trackers
+ * Reset RX statistics (tüm stats shard'ları, baseline) and VL-ID trackers
  */
 void init_rx_stats(void);
 
@@ -0,0 +1,117 @@
+#ifndef TX_SEQUENCE_H
+#define TX_SEQUENCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <rte_common.h>
+
+// ==========================================
+// WORKER-OWNED TX SEQUENCE BLOCKS
+// ==========================================
+// Her VL-ID yalnızca tek bir TX worker tarafından gönderilir. Bu yüzden
+// sequence sayaçları o worker'a ait, yoğun (dense) ve cache-aligned bir
+// dizide tutulur: index = VL'nin worker aralığındaki sırası.
+//
+//   - Hot path'te lock, atomic RMW veya başka worker ile paylaşılan
+//     cache line yoktur (peek / commit sadece sahibi çağırır)
+//   - Commit relaxed 64-bit store'dur; stats/test okuyucuları
+//     tx_seq_snapshot() ile tutarlı (yırtılmamış) değer görür
+//   - Bloklar process ömrü boyunca yaşar, worker yeniden başlasa bile
+//     aynı (domain, port, vl_start) için aynı blok döner → sequence sürekliliği
+//
+// VL eşlemesi: idx → vl_start + (idx / block_size) * block_step + idx % block_size
+// Ardışık aralıklar için block_size = block_step = vl_count (token bucket
+// modundaki raw port blok/step düzeni de aynı formülle ifade edilir).
+
+// Sequence sahibinin türü (aynı port numarası farklı domain'lerde tekrar edebilir)
+enum tx_seq_domain {
+    TX_SEQ_DOMAIN_DPDK = 0,     // tx_worker (port → paired port)
+    TX_SEQ_DOMAIN_DPDK_EXT,     // dpdk_ext_tx_worker (port → switch → raw port)
+    TX_SEQ_DOMAIN_RAW,          // raw_tx_worker (raw port → target)
+    TX_SEQ_DOMAIN_COUNT
+};
+
+#define TX_SEQ_MAX_BLOCKS 256
+
+struct tx_seq_block {
+    uint64_t *seq;              // [vl_count], sahibinin NUMA node'unda
+    uint16_t vl_start;
+    uint16_t vl_count;
+    uint16_t block_size;        // Ardışık VL sayısı (blok içi)
+    uint16_t block_step;        // Bloklar arası VL-ID adımı
+    uint16_t port_id;
+    uint8_t domain;             // enum tx_seq_domain
+} __rte_cache_aligned;
+
+/**
+ * Create (or return the existing) sequence block for a worker's VL range
+ * Aynı (domain, port_id, vl_start, vl_count) için ikinci çağrı aynı bloğu döner.
+ * Başlangıçta çağrılır (hot path değil), registry kısa bir lock ile korunur.
+ * @return block pointer, NULL on allocation failure or registry full
+ */
+struct tx_seq_block *tx_seq_block_create(enum tx_seq_domain domain, uint16_t port_id,
+                                         uint16_t vl_start, uint16_t vl_count,
+                                         uint16_t block_size, uint16_t block_step,
+                                         int socket_id);
+
+// Ardışık VL aralığı için kısayol
+static inline struct tx_seq_block *
+tx_seq_block_create_contig(enum tx_seq_domain domain, uint16_t port_id,
+                           uint16_t vl_start, uint16_t vl_count, int socket_id)
+{
+    return tx_seq_block_create(domain, port_id, vl_start, vl_count,
+                               vl_count, vl_count, socket_id);
+}
+
+/**
+ * Zero every registered block of a domain (warm-up reset, test başlangıcı)
+ * Worker'lar durmuşken çağrılmalı.
+ */
+void tx_seq_reset_domain(enum tx_seq_domain domain);
+
+// ==========================================
+// HOT PATH (sadece blok sahibi çağırır)
+// ==========================================
+
+static inline uint64_t tx_seq_peek(const struct tx_seq_block *b, uint16_t idx)
+{
+    return b->seq[idx];
+}
+
+// Paket gerçekten gönderildikten / ring'e konduktan sonra artır
+static inline void tx_seq_commit(struct tx_seq_block *b, uint16_t idx)
+{
+    __atomic_store_n(&b->seq[idx], b->seq[idx] + 1, __ATOMIC_RELAXED);
+}
+
+// Peek + commit tek adımda (test modu kasıtlı gap üretimi gibi durumlar)
+static inline uint64_t tx_seq_next(struct tx_seq_block *b, uint16_t idx)
+{
+    uint64_t seq = b->seq[idx];
+    __atomic_store_n(&b->seq[idx], seq + 1, __ATOMIC_RELAXED);
+    return seq;
+}
+
+static inline uint16_t tx_seq_vl_id(const struct tx_seq_block *b, uint16_t idx)
+{
+    return (uint16_t)(b->vl_start + (idx / b->block_size) * b->block_step +
+                      idx % b->block_size);
+}
+
+// ==========================================
+// READ-ONLY SNAPSHOT API (stats / test, herhangi bir thread)
+// ==========================================
+
+/**
+ * Read the next sequence to be sent for a VL-ID (= gönderilen paket sayısı)
+ * @return true if (domain, port_id, vl_id) belongs to a registered block
+ */
+bool tx_seq_snapshot(enum tx_seq_domain domain, uint16_t port_id, uint16_t vl_id,
+                     uint64_t *seq);
+
+/**
+ * Sum of all committed sequences of a port in a domain
+ */
+uint64_t tx_seq_snapshot_port_total(enum tx_seq_domain domain, uint16_t port_id);
+
+#endif /* TX_SEQUENCE_H */
@@ -0,0 +1,66 @@
+#ifndef VL_MAP_H
+#define VL_MAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ==========================================
+// VL-ID → DENSE INDEX MAP
+// ==========================================
+// VL-ID, DST MAC'in son 2 byte'ıdır (16 bit) ama port başına yalnızca birkaç
+// yüz VL aktiftir. Per-VL tablolar (RX sequence tracker'ları, stats) ham VL-ID
+// yerine startup'ta kurulan yoğun (dense) index ile boyutlandırılır:
+//
+//   - İki seviyeli tablo: dir[vl_id >> 8] → 256 girişlik sayfa (uint16_t index)
+//     Hiç VL'i olmayan üst byte'lar ortak "boş" sayfaya bakar → hot path'te
+//     dal yok, iki load. Sayfalar statik havuzdan gelir (~512 B / sayfa).
+//   - Index'ler kayıt sırasıyla verilir (0..count-1), ters tablo vl_map_vl_id()
+//   - Kayıt sadece startup'ta (tek thread, worker'lar başlamadan önce):
+//     TX/RX VL aralıkları, DPDK external TX ve raw socket hedefleri
+//   - Sınır: VL_MAP_MAX_ENTRIES farklı VL, VL_MAP_MAX_PAGES dolu sayfa;
+//     eski MAX_VL_ID (4800) tavanı yok, 0..65535 arası her VL-ID geçerli
+
+#define VL_MAP_INVALID      0xFFFF
+#define VL_MAP_MAX_ENTRIES  8192
+#define VL_MAP_MAX_PAGES    64
+
+extern const uint16_t *vl_map_dir[256];
+
+// ==========================================
+// HOT PATH
+// ==========================================
+
+/**
+ * Dense index of a VL-ID
+ * @return 0..vl_map_count()-1, VL_MAP_INVALID if the VL-ID was never registered
+ */
+static inline uint16_t vl_map_index(uint16_t vl_id)
+{
+    return vl_map_dir[vl_id >> 8][vl_id & 0xFF];
+}
+
+// ==========================================
+// SETUP (startup, hot path değil)
+// ==========================================
+
+/**
+ * Register a VL-ID (zaten kayıtlıysa mevcut index döner)
+ * @return dense index, VL_MAP_INVALID if the map is full
+ */
+uint16_t vl_map_add(uint16_t vl_id);
+
+/**
+ * Register vl_start + (i / block_size) * block_step + i % block_size, i < vl_count
+ * Ardışık aralık için block_size = block_step = vl_count.
+ * @return 0 on success, -1 if the map is full
+ */
+int vl_map_add_range(uint16_t vl_start, uint16_t vl_count,
+                     uint16_t block_size, uint16_t block_step);
+
+// Kayıtlı VL sayısı (per-VL dizilerin boyutu)
+uint16_t vl_map_count(void);
+
+// Ters eşleme (stats / debug): index → VL-ID
+uint16_t vl_map_vl_id(uint16_t idx);
+
+#endif /* VL_MAP_H */
@@ -0,0 +1,35 @@
+# Traffic profile örneği (format: include/traffic_profile.h)
+#   sudo ./dpdk_app --profile profiles/example.profile -l 0-255 -n 16
+#   make run PROFILE=profiles/example.profile
+#
+# Verilmeyen her şey config.h varsayılanında kalır. Aşağıdaki değerler
+# normal mod varsayılanlarıdır; sadece değiştirmek istediğin satırları tut.
+
+mode   = normal          # normal | ate | any
+pacing = rate_limiter    # build ile aynı olmalı (rate_limiter | token_bucket | bag)
+# imix = 100,200,400,800,1200,1200,1200,1518,1518,1518   # IMIX_ENABLED build'lerde
+
+# DPDK-DPDK portları (FAST)
+[port 1]
+rate_gbps = 3.74
+
+[port 7]
+rate_gbps = 3.74
+
+# Port 12'ye de gönderen portlar (MID)
+[port 2]
+rate_gbps = 3.50
+tx_vlans  = 97,98,99,100
+tx_vl_ids = 3,131,259,387
+rx_vlans  = 245,246,247,248
+rx_vl_ids = 3,131,259,387
+
+# Raw socket port 12 (1G): hedef listesi baştan kurulur
+[raw 12]
+target = 0,2,230,4259,32     # id, dest_port, rate_mbps, vl_start, vl_count
+target = 1,3,230,4227,32
+target = 2,4,230,4195,32
+target = 3,5,230,4163,32
+# backend   = af_xdp     # af_packet | af_xdp (AF_XDP kurulamazsa af_packet)
+# tx_submit = io_uring   # ring | sendmmsg | io_uring (kurulamazsa ring)
+# interface = veth-p12   # config.h arayüzü yerine (veth çiftiyle test)
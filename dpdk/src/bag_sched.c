@@ -0,0 +1,366 @@
+#include "bag_sched.h"
+#include "packet.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <rte_cycles.h>
+#include <rte_malloc.h>
+#include <rte_spinlock.h>
+
+uint32_t bag_sched_epoch = 0;
+
+static const struct bag_profile_entry bag_profile[] = BAG_PROFILE_INIT;
+#define BAG_PROFILE_COUNT (sizeof(bag_profile) / sizeof(bag_profile[0]))
+
+// Kayıtlı scheduler'lar (yalnızca eklenir, process ömrü boyunca silinmez)
+static struct bag_sched *bag_scheds[BAG_SCHED_MAX];
+static uint32_t bag_nb_scheds = 0;
+static rte_spinlock_t bag_reg_lock = RTE_SPINLOCK_INITIALIZER;
+
+static inline uint32_t bag_sched_count(void)
+{
+    return __atomic_load_n(&bag_nb_scheds, __ATOMIC_ACQUIRE);
+}
+
+static const struct bag_profile_entry *bag_profile_lookup(uint16_t vl_id)
+{
+    for (uint32_t i = 0; i < BAG_PROFILE_COUNT; i++) {
+        const struct bag_profile_entry *e = &bag_profile[i];
+        if (e->bag_us != 0 && vl_id >= e->vl_first && vl_id <= e->vl_last)
+            return e;
+    }
+    return NULL;
+}
+
+bool bag_profile_vl(uint16_t vl_id, uint32_t *bag_us, uint16_t *jitter_us)
+{
+    const struct bag_profile_entry *e = bag_profile_lookup(vl_id);
+
+    if (e != NULL) {
+        *bag_us = e->bag_us;
+        *jitter_us = e->jitter_us;
+        return true;
+    }
+    if (BAG_DEFAULT_US > 0) {
+        *bag_us = BAG_DEFAULT_US;
+        *jitter_us = BAG_DEFAULT_JITTER_US;
+        return true;
+    }
+    return false;
+}
+
+// Profil Lmax'ı → gönderilebilir frame boyutu (RX'in doğrulayabildiği aralık)
+static uint16_t bag_frame_size(uint16_t lmax)
+{
+#if IMIX_ENABLED
+    if (lmax == 0 || lmax > IMIX_MAX_PACKET_SIZE)
+        return IMIX_MAX_PACKET_SIZE;
+    if (lmax < IMIX_MIN_PACKET_SIZE)
+        return IMIX_MIN_PACKET_SIZE;
+    return lmax;
+#else
+    // RX sabit NUM_PRBS_BYTES doğrular: tüm VL'ler PACKET_SIZE
+    RTE_SET_USED(lmax);
+    return PACKET_SIZE;
+#endif
+}
+
+static inline uint64_t bag_us_to_cycles(uint64_t us, uint64_t tsc_hz)
+{
+    return us * tsc_hz / 1000000ULL;
+}
+
+struct bag_sched *bag_sched_create(uint16_t port_id, uint16_t queue_id,
+                                   uint16_t vl_start, uint16_t vl_count,
+                                   uint64_t default_bag_cycles, int socket_id)
+{
+    struct bag_sched *s = NULL;
+    const uint64_t tsc_hz = rte_get_tsc_hz();
+    uint64_t max_bag_cycles = 0;
+    uint32_t lmax_clamped = 0;
+
+    if (vl_count == 0 || vl_count >= BAG_VL_NONE)
+        return NULL;
+
+    rte_spinlock_lock(&bag_reg_lock);
+
+    // Worker yeniden başlatıldıysa mevcut scheduler'ı döndür
+    for (uint32_t i = 0; i < bag_nb_scheds; i++) {
+        struct bag_sched *e = bag_scheds[i];
+        if (e->port_id == port_id && e->queue_id == queue_id &&
+            e->vl_start == vl_start && e->vl_count == vl_count) {
+            s = e;
+            goto out;
+        }
+    }
+
+    if (bag_nb_scheds >= BAG_SCHED_MAX) {
+        printf("Error: BAG scheduler registry full (%u workers)\n", BAG_SCHED_MAX);
+        goto out;
+    }
+
+    s = rte_zmalloc_socket("bag_sched", sizeof(*s), RTE_CACHE_LINE_SIZE, socket_id);
+    if (s == NULL)
+        goto out;
+
+    s->vl = rte_zmalloc_socket("bag_vl", (size_t)vl_count * sizeof(struct bag_vl),
+                               RTE_CACHE_LINE_SIZE, socket_id);
+    s->st = rte_zmalloc_socket("bag_vl_stats", (size_t)vl_count * sizeof(struct bag_vl_stats),
+                               RTE_CACHE_LINE_SIZE, socket_id);
+    s->bag_us = rte_zmalloc_socket("bag_vl_us", (size_t)vl_count * sizeof(uint32_t),
+                                   RTE_CACHE_LINE_SIZE, socket_id);
+    if (s->vl == NULL || s->st == NULL || s->bag_us == NULL)
+        goto fail;
+
+    // VL başına profil: BAG (cycles), Lmax, jitter bütçesi
+    uint64_t *bag_cycles = rte_zmalloc_socket("bag_tmp", (size_t)vl_count * sizeof(uint64_t),
+                                              0, socket_id);
+    if (bag_cycles == NULL)
+        goto fail;
+
+    for (uint16_t i = 0; i < vl_count; i++) {
+        const struct bag_profile_entry *e = bag_profile_lookup((uint16_t)(vl_start + i));
+        uint64_t jitter_us = BAG_DEFAULT_JITTER_US;
+        uint16_t lmax = 0;
+
+        if (e != NULL) {
+            bag_cycles[i] = bag_us_to_cycles(e->bag_us, tsc_hz);
+            s->bag_us[i] = e->bag_us;
+            jitter_us = e->jitter_us;
+            lmax = e->lmax;
+        } else if (BAG_DEFAULT_US > 0) {
+            bag_cycles[i] = bag_us_to_cycles(BAG_DEFAULT_US, tsc_hz);
+            s->bag_us[i] = BAG_DEFAULT_US;
+        } else {
+            bag_cycles[i] = default_bag_cycles;
+            s->bag_us[i] = (uint32_t)(default_bag_cycles * 1000000ULL / tsc_hz);
+        }
+        if (bag_cycles[i] == 0)
+            bag_cycles[i] = 1;
+
+        s->vl[i].pkt_size = bag_frame_size(lmax);
+        if (lmax != 0 && lmax != s->vl[i].pkt_size)
+            lmax_clamped++;
+
+        uint64_t jb = bag_us_to_cycles(jitter_us, tsc_hz);
+        s->vl[i].jitter_budget = jb > UINT32_MAX ? UINT32_MAX : (uint32_t)jb;
+
+        if (bag_cycles[i] > max_bag_cycles)
+            max_bag_cycles = bag_cycles[i];
+        s->offered_pps += (double)tsc_hz / (double)bag_cycles[i];
+        s->offered_bps += (double)s->vl[i].pkt_size * 8.0 * (double)tsc_hz / (double)bag_cycles[i];
+    }
+
+    // Tick: BAG_SCHED_TICK_NS'e en yakın (altındaki) 2'nin kuvveti cycle;
+    // wheel (> 3 × en büyük BAG, bkz. bag_sched_poll) BAG_SCHED_WHEEL_MAX'a
+    // sığana kadar büyütülür
+    uint64_t tick_target = tsc_hz * (uint64_t)BAG_SCHED_TICK_NS / 1000000000ULL;
+    uint8_t shift = 0;
+    while (shift < 40 && (2ULL << shift) <= tick_target)
+        shift++;
+
+    uint64_t slots;
+    for (;;) {
+        const uint64_t max_bag = (max_bag_cycles + (1ULL << shift) - 1) >> shift;
+        slots = 1;
+        while (slots <= 3 * max_bag)
+            slots <<= 1;
+        if (slots <= BAG_SCHED_WHEEL_MAX)
+            break;
+        shift++;
+    }
+    s->tick_shift = shift;
+    s->wheel_mask = (uint32_t)(slots - 1);
+
+    s->max_bag = 0;
+    for (uint16_t i = 0; i < vl_count; i++) {
+        // Yukarı yuvarla: gerçekleşen BAG asla profilden kısa olmaz
+        uint64_t t = (bag_cycles[i] + (1ULL << shift) - 1) >> shift;
+        s->vl[i].bag = (uint32_t)t;
+        if (t > s->max_bag)
+            s->max_bag = t;
+    }
+    rte_free(bag_cycles);
+
+    s->wheel = rte_zmalloc_socket("bag_wheel", (size_t)slots * sizeof(uint16_t),
+                                  RTE_CACHE_LINE_SIZE, socket_id);
+    if (s->wheel == NULL)
+        goto fail;
+
+    s->vl_start = vl_start;
+    s->vl_count = vl_count;
+    s->port_id = port_id;
+    s->queue_id = queue_id;
+    s->epoch = __atomic_load_n(&bag_sched_epoch, __ATOMIC_ACQUIRE);
+
+    if (lmax_clamped > 0)
+        printf("Warning: BAG Port %u Queue %u: %u VL Lmax'ı %s aralığına sabitlendi\n",
+               port_id, queue_id, lmax_clamped, IMIX_ENABLED ? "IMIX" : "PACKET_SIZE");
+
+    bag_scheds[bag_nb_scheds] = s;
+    __atomic_store_n(&bag_nb_scheds, bag_nb_scheds + 1, __ATOMIC_RELEASE);
+    goto out;
+
+fail:
+    rte_free(s->vl);
+    rte_free(s->st);
+    rte_free(s->bag_us);
+    rte_free(s);
+    s = NULL;
+out:
+    rte_spinlock_unlock(&bag_reg_lock);
+    return s;
+}
+
+void bag_sched_start(struct bag_sched *s, uint64_t start_tsc)
+{
+    memset(s->wheel, 0xFF, (size_t)(s->wheel_mask + 1) * sizeof(uint16_t));
+    s->base = start_tsc;
+    s->cur = 0;
+
+    // Aynı BAG'li VL'ler BAG içine eşit aralıkla yayılır (tick 0'da toplu çıkış yok)
+    for (uint16_t i = 0; i < s->vl_count; i++) {
+        s->vl[i].due = (uint64_t)s->vl[i].bag * i / s->vl_count;
+        bag_wheel_push(s, i);
+    }
+}
+
+void bag_sched_resync(struct bag_sched *s, uint64_t now_tick)
+{
+    memset(s->wheel, 0xFF, (size_t)(s->wheel_mask + 1) * sizeof(uint16_t));
+
+    for (uint16_t i = 0; i < s->vl_count; i++) {
+        struct bag_vl *v = &s->vl[i];
+        if (v->due <= now_tick) {
+            const uint64_t k = (now_tick - v->due) / v->bag + 1;
+            v->due += k * v->bag;
+            bag_stat_set(&s->st[i].skipped, s->st[i].skipped + k);
+        }
+        bag_wheel_push(s, i);
+    }
+    s->cur = now_tick + 1;
+    bag_stat_set(&s->resyncs, s->resyncs + 1);
+}
+
+void bag_sched_reset(void)
+{
+    __atomic_store_n(&bag_sched_epoch, bag_sched_epoch + 1, __ATOMIC_RELEASE);
+}
+
+void bag_sched_clear(struct bag_sched *s)
+{
+    // Zamanlama (due/wheel) korunur, sadece uygunluk sayaçları sıfırlanır
+    memset(s->st, 0, (size_t)s->vl_count * sizeof(struct bag_vl_stats));
+    bag_stat_set(&s->resyncs, 0);
+    __atomic_store_n(&s->epoch, __atomic_load_n(&bag_sched_epoch, __ATOMIC_ACQUIRE),
+                     __ATOMIC_RELEASE);
+}
+
+// ==========================================
+// REPORT (stats lcore)
+// ==========================================
+
+// VL uygun mu: geç çıkış / atlanan BAG yok, ardışık frame arası ≥ BAG - jitter bütçesi
+static bool bag_vl_conformant(const struct bag_sched *s, uint16_t i, uint64_t *min_gap)
+{
+    const struct bag_vl_stats *st = &s->st[i];
+    const uint64_t bag_cycles = (uint64_t)s->vl[i].bag << s->tick_shift;
+    const uint64_t gap = __atomic_load_n(&st->min_gap, __ATOMIC_RELAXED);
+
+    *min_gap = gap;
+    if (__atomic_load_n(&st->late, __ATOMIC_RELAXED) != 0 ||
+        __atomic_load_n(&st->skipped, __ATOMIC_RELAXED) != 0)
+        return false;
+    return gap == 0 || gap + s->vl[i].jitter_budget >= bag_cycles;
+}
+
+void bag_sched_print_config(const struct bag_sched *s)
+{
+    const double tsc_hz = (double)rte_get_tsc_hz();
+    uint32_t bag_min = UINT32_MAX, bag_max = 0;
+
+    for (uint16_t i = 0; i < s->vl_count; i++) {
+        if (s->bag_us[i] < bag_min)
+            bag_min = s->bag_us[i];
+        if (s->bag_us[i] > bag_max)
+            bag_max = s->bag_us[i];
+    }
+
+    printf("  *** BAG SCHEDULER - %u VL, BAG %.3f..%.3f ms, offered %.1f Mbps (%.0f pkt/s) ***\n",
+           s->vl_count, bag_min / 1000.0, bag_max / 1000.0, s->offered_bps / 1e6, s->offered_pps);
+    printf("  -> Timer wheel: %u slot × %.0f ns tick (span %.1f ms)\n",
+           s->wheel_mask + 1, (double)(1ULL << s->tick_shift) * 1e9 / tsc_hz,
+           (double)(s->wheel_mask + 1) * (double)(1ULL << s->tick_shift) * 1e3 / tsc_hz);
+}
+
+void bag_sched_print_stats(void)
+{
+    const uint32_t n = bag_sched_count();
+    const double us_per_cycle = 1e6 / (double)rte_get_tsc_hz();
+
+    printf("\n  BAG Scheduler Conformance:\n");
+    printf("  ┌──────┬───────┬───────┬──────────────┬────────────┬────────────┬────────────┬────────────┬─────────────┐\n");
+    printf("  │ Port │ Queue │  VLs  │     Sent     │    Late    │  Skipped   │  TX Full   │ Max Jit us │ Uygun VL %%  │\n");
+    printf("  ├──────┼───────┼───────┼──────────────┼────────────┼────────────┼────────────┼────────────┼─────────────┤\n");
+
+    for (uint32_t k = 0; k < n; k++) {
+        const struct bag_sched *s = bag_scheds[k];
+        uint64_t sent = 0, late = 0, skipped = 0, tx_full = 0, max_jit = 0;
+        uint32_t ok = 0;
+
+        for (uint16_t i = 0; i < s->vl_count; i++) {
+            const struct bag_vl_stats *st = &s->st[i];
+            uint64_t gap, jit;
+
+            sent += __atomic_load_n(&st->sent, __ATOMIC_RELAXED);
+            late += __atomic_load_n(&st->late, __ATOMIC_RELAXED);
+            skipped += __atomic_load_n(&st->skipped, __ATOMIC_RELAXED);
+            tx_full += __atomic_load_n(&st->tx_full, __ATOMIC_RELAXED);
+            jit = __atomic_load_n(&st->max_jitter, __ATOMIC_RELAXED);
+            if (jit > max_jit)
+                max_jit = jit;
+            ok += bag_vl_conformant(s, i, &gap);
+        }
+
+        printf("  │  %2u  │  %3u  │ %5u │ %12lu │ %10lu │ %10lu │ %10lu │ %10.1f │ %10.2f%% │\n",
+               s->port_id, s->queue_id, s->vl_count, sent, late, skipped, tx_full,
+               (double)max_jit * us_per_cycle, 100.0 * ok / s->vl_count);
+    }
+    printf("  └──────┴───────┴───────┴──────────────┴────────────┴────────────┴────────────┴────────────┴─────────────┘\n");
+}
+
+void bag_sched_print_vl_report(void)
+{
+    const uint32_t n = bag_sched_count();
+    const double us_per_cycle = 1e6 / (double)rte_get_tsc_hz();
+    uint64_t bad_total = 0;
+
+    printf("\n=== BAG Conformance per VL (uygun olmayanlar) ===\n");
+
+    for (uint32_t k = 0; k < n; k++) {
+        const struct bag_sched *s = bag_scheds[k];
+        uint32_t bad = 0;
+
+        for (uint16_t i = 0; i < s->vl_count; i++) {
+            const struct bag_vl_stats *st = &s->st[i];
+            uint64_t gap;
+
+            if (bag_vl_conformant(s, i, &gap))
+                continue;
+
+            if (bad++ == 0)
+                printf("  Port %u Queue %u (resync: %lu):\n", s->port_id, s->queue_id,
+                       (unsigned long)s->resyncs);
+            printf("    VL %5u: BAG %8.3f ms, sent %lu, late %lu, skipped %lu, tx_full %lu, "
+                   "max jitter %.1f us (bütçe %.1f), min gap %.3f ms\n",
+                   s->vl_start + i, s->bag_us[i] / 1000.0, st->sent, st->late, st->skipped,
+                   st->tx_full, (double)st->max_jitter * us_per_cycle,
+                   (double)s->vl[i].jitter_budget * us_per_cycle,
+                   (double)gap * us_per_cycle / 1000.0);
+        }
+        bad_total += bad;
+    }
+
+    if (bad_total == 0)
+        printf("  Tüm VL'ler BAG ve jitter bütçesine uygun\n");
+}
@@ -0,0 +1,514 @@
+#include "burst_test.h"
+#include "tx_rx_manager.h"      // port_vlans, VL_RANGE_SIZE_PER_QUEUE, BURST_SIZE
+#include "packet.h"             // build_packet_dynamic, L2_HEADER_SIZE
+#include "health_monitor.h"
+#include "embedded_latency/embedded_latency.h"  // ate_mode_enabled()
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <rte_cycles.h>
+#include <rte_ethdev.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+
+#if BURST_TEST_ENABLED
+
+#if BURST_TEST_PACKET_SIZE > PACKET_SIZE
+#error "BURST_TEST_PACKET_SIZE mbuf veri alanına sığmaz (PACKET_SIZE üst sınır)"
+#endif
+
+#define BT_PAYLOAD_OFFSET (L2_HEADER_SIZE + IP_HDR_SIZE + UDP_HDR_SIZE)
+#define BT_TAG_BASE       0xB5700000u  // SEQ üst 32 bit: BT_TAG_BASE + trial
+#define BT_TX_CHUNK       256          // rte_eth_tx_burst çağrısı başına
+#define BT_TX_TIMEOUT_MS  1000         // Ring bu sürede boşalmazsa link yok sayılır
+
+struct burst_class {
+    const char *name;
+    uint8_t pcp;
+};
+
+// Switch sayaçları (health monitor, tüm switch portları A + M toplamı)
+struct burst_dut {
+    uint64_t overflow;
+    uint64_t hp_overflow;
+    uint64_t lp_overflow;
+    uint64_t be_overflow;
+    uint64_t policy_drop;
+};
+
+struct burst_trial {
+    bool pass;
+    uint32_t sent;
+    uint32_t received;
+    uint64_t missed;                // RX imissed + rx_nombuf farkı (tester tarafı)
+    bool dut_valid;                 // Trial sonrası yeni health döngüsü alındı
+    struct burst_dut dut;
+};
+
+struct burst_row {
+    uint16_t port_id;
+    const struct burst_class *cls;
+    uint32_t max_ok;                // Kayıpsız en uzun burst, 0 = tek paket bile kayıplı
+    uint32_t fail_len;              // En kısa kayıplı burst, 0 = BURST_TEST_MAX_PKTS'e kadar kayıp yok
+    uint32_t fail_lost;
+    bool tester_limited;            // En kısa kayıplı burst'te RX tarafı paket kaçırdı
+    bool dut_valid;
+    struct burst_dut fail_dut;
+    uint32_t trials;
+};
+
+static struct rte_mbuf **bt_pkts;
+static uint32_t bt_tag = BT_TAG_BASE;
+
+static bool bt_health;              // Health sayaçları trial'lara bağlanabiliyor
+static struct burst_dut bt_dut_prev;
+
+// ==========================================
+// HELPERS
+// ==========================================
+
+static bool bt_port_active(const struct ports_config *pc, uint16_t port_id)
+{
+    for (uint16_t i = 0; i < pc->nb_ports; i++) {
+        if (pc->ports[i].port_id == port_id)
+            return pc->ports[i].is_valid;
+    }
+    return false;
+}
+
+static inline uint64_t bt_delta(uint64_t now, uint64_t base)
+{
+    return now >= base ? now - base : 0;    // Switch sayaç reset'i
+}
+
+// ==========================================
+// HEALTH MONITOR
+// ==========================================
+
+static void bt_dut_read(struct burst_dut *sum)
+{
+    static struct health_port_policing ast[HEALTH_MAX_PORTS], mgr[HEALTH_MAX_PORTS];
+
+    memset(sum, 0, sizeof(*sum));
+    get_health_port_policing(ast, mgr);
+    for (int p = 0; p < HEALTH_MAX_PORTS; p++) {
+        const struct health_port_policing *side[2] = { &ast[p], &mgr[p] };
+        for (int s = 0; s < 2; s++) {
+            if (!side[s]->valid)
+                continue;
+            sum->overflow += side[s]->queue_overflow;
+            sum->hp_overflow += side[s]->hp_queue_overflow;
+            sum->lp_overflow += side[s]->lp_queue_overflow;
+            sum->be_overflow += side[s]->be_queue_overflow;
+            sum->policy_drop += side[s]->traffic_policy_drop;
+        }
+    }
+}
+
+// Burst bittikten sonra başlayan bir döngünün tamamlanmasını bekle:
+// queries_sent döngü başında artar, policing döngü sonunda güncellenir
+static bool bt_health_wait(volatile bool *stop_flag)
+{
+    struct health_monitor_stats st;
+    get_health_monitor_stats(&st);
+    const uint64_t target = st.queries_sent + 2;
+
+    for (unsigned int ms = 0; ms < 3 * HEALTH_MONITOR_QUERY_INTERVAL_MS && !*stop_flag; ms += 10) {
+        usleep(10000);
+        get_health_monitor_stats(&st);
+        if (st.queries_sent >= target)
+            return true;
+    }
+    return false;
+}
+
+// Trial'ın switch sayaç farkı; yeni döngü gelmediyse false (sonraki trial
+// eski baseline ile devam eder, fark o trial'a yazılır).
+// BURST_TEST_HEALTH_WAIT 0: beklemeden son döngünün sayaçları okunur
+static bool bt_dut_sample(struct burst_dut *d, volatile bool *stop_flag)
+{
+    struct burst_dut now;
+
+    if (!bt_health)
+        return false;
+#if BURST_TEST_HEALTH_WAIT
+    if (!bt_health_wait(stop_flag))
+        return false;
+#else
+    RTE_SET_USED(stop_flag);
+#endif
+    bt_dut_read(&now);
+    d->overflow = bt_delta(now.overflow, bt_dut_prev.overflow);
+    d->hp_overflow = bt_delta(now.hp_overflow, bt_dut_prev.hp_overflow);
+    d->lp_overflow = bt_delta(now.lp_overflow, bt_dut_prev.lp_overflow);
+    d->be_overflow = bt_delta(now.be_overflow, bt_dut_prev.be_overflow);
+    d->policy_drop = bt_delta(now.policy_drop, bt_dut_prev.policy_drop);
+    bt_dut_prev = now;
+    return true;
+}
+
+// Monitor normalde raw socket worker'larından sonra başlar; test için
+// erken başlatılırsa sonunda durdurulur, main normal akışta yeniden kurar
+static bool bt_health_start(volatile bool *stop_flag, bool *started_here)
+{
+    *started_here = false;
+#if ENABLE_RAW_SOCKET_PORTS && HEALTH_MONITOR_ENABLED
+    if (!is_health_monitor_running()) {
+        if (ate_mode_enabled() && !ATE_HEALTH_MONITOR_ENABLED) {
+            printf("[BURST] Health monitor disabled in ATE mode, no overflow correlation\n");
+            return false;
+        }
+        if (init_health_monitor() != 0 || start_health_monitor(stop_flag) != 0) {
+            printf("[BURST] Health monitor unavailable, no overflow correlation\n");
+            cleanup_health_monitor();
+            return false;
+        }
+        *started_here = true;
+    }
+
+    // İlk döngü: baseline + switch cevap veriyor mu
+    static struct health_port_policing ast[HEALTH_MAX_PORTS], mgr[HEALTH_MAX_PORTS];
+    bool any = false;
+    if (bt_health_wait(stop_flag)) {
+        get_health_port_policing(ast, mgr);
+        for (int p = 0; p < HEALTH_MAX_PORTS; p++)
+            any |= ast[p].valid || mgr[p].valid;
+    }
+    if (!any) {
+        printf("[BURST] No health response from the switch, no overflow correlation\n");
+        return false;
+    }
+    bt_dut_read(&bt_dut_prev);
+    return true;
+#else
+    RTE_SET_USED(stop_flag);
+    printf("[BURST] Health monitor not built, no overflow correlation\n");
+    return false;
+#endif
+}
+
+// ==========================================
+// BURST TX / RX
+// ==========================================
+
+// Burst'ü render et: paket i → queue (i % nq) VLAN'ı, VL aralığında (i / nq)
+static int bt_build(struct rte_mempool *mp, uint16_t port_id, uint8_t pcp,
+                    uint32_t tag, uint32_t n, struct rte_mbuf **pkts)
+{
+    const struct port_vlan_config *vc = &port_vlans[port_id];
+    const uint16_t nq = vc->tx_vlan_count;
+    struct packet_config cfg;
+
+    if (rte_pktmbuf_alloc_bulk(mp, pkts, n) != 0) {
+        printf("[BURST] Port %u: cannot allocate %u mbufs\n", port_id, n);
+        return -1;
+    }
+
+    init_packet_config(&cfg);
+#if VLAN_ENABLED
+    cfg.vlan_priority = pcp;
+#else
+    RTE_SET_USED(pcp);
+#endif
+    cfg.src_ip = (10U << 24);
+    cfg.src_port = DEFAULT_SRC_PORT;
+    cfg.dst_port = DEFAULT_DST_PORT;
+    cfg.ttl = DEFAULT_TTL;
+
+    for (uint32_t i = 0; i < n; i++) {
+        const uint16_t q = (uint16_t)(i % nq);
+        const uint16_t vl_id = (uint16_t)(vc->tx_vl_ids[q] + (i / nq) % VL_RANGE_SIZE_PER_QUEUE);
+#if VLAN_ENABLED
+        cfg.vlan_id = vc->tx_vlans[q];
+#endif
+        cfg.vl_id = vl_id;
+        cfg.dst_mac.addr_bytes[4] = (uint8_t)(vl_id >> 8);
+        cfg.dst_mac.addr_bytes[5] = (uint8_t)(vl_id & 0xFF);
+        cfg.dst_ip = (224U << 24) | (224U << 16) | ((uint32_t)(vl_id >> 8) << 8) | (vl_id & 0xFF);
+
+        build_packet_dynamic(pkts[i], &cfg, BURST_TEST_PACKET_SIZE);
+        // Payload'ın geri kalanı kontrol edilmez, sadece SEQ etiketi
+        *(uint64_t *)(rte_pktmbuf_mtod(pkts[i], uint8_t *) + BT_PAYLOAD_OFFSET) =
+            ((uint64_t)tag << 32) | i;
+    }
+    return 0;
+}
+
+// @return tag'li frame sayısı; *nb_seen (NULL olabilir) tüm alınanlar
+static uint32_t bt_rx_poll(uint16_t rx_port, uint16_t nb_rxq, uint32_t tag, uint32_t *nb_seen)
+{
+    struct rte_mbuf *rx[BURST_SIZE];
+    uint32_t matched = 0;
+
+    for (uint16_t q = 0; q < nb_rxq; q++) {
+        const uint16_t nb = rte_eth_rx_burst(rx_port, q, rx, BURST_SIZE);
+        if (nb_seen != NULL)
+            *nb_seen += nb;
+        for (uint16_t j = 0; j < nb; j++) {
+            if (rx[j]->data_len >= BT_PAYLOAD_OFFSET + SEQ_BYTES) {
+                const uint64_t seq = *(const uint64_t *)(rte_pktmbuf_mtod(rx[j], uint8_t *) +
+                                                         BT_PAYLOAD_OFFSET);
+                matched += (uint32_t)(seq >> 32) == tag;
+            }
+        }
+        if (nb > 0)
+            rte_pktmbuf_free_bulk(rx, nb);
+    }
+    return matched;
+}
+
+static int bt_trial(uint16_t port_id, uint16_t rx_port, uint16_t nb_rxq,
+                    struct rte_mempool *mp, uint8_t pcp, uint32_t n,
+                    volatile bool *stop_flag, struct burst_trial *t)
+{
+    const uint64_t tsc_hz = rte_get_tsc_hz();
+    const uint32_t tag = ++bt_tag;
+    struct rte_eth_stats s0, s1;
+
+    memset(t, 0, sizeof(*t));
+
+    // Önceki burst'ten gecikenler
+    for (uint32_t seen = 1; seen > 0; ) {
+        seen = 0;
+        bt_rx_poll(rx_port, nb_rxq, 0, &seen);
+    }
+
+    if (bt_build(mp, port_id, pcp, tag, n, bt_pkts) != 0)
+        return -1;
+
+    rte_eth_stats_get(rx_port, &s0);
+
+    // Ring dolu olduğu sürece NIC aralıksız gönderir; RX sadece ring doluyken
+    // okunur ki TX ring'i hiç boşalmasın
+    const uint64_t deadline = rte_get_tsc_cycles() + tsc_hz * BT_TX_TIMEOUT_MS / 1000;
+    while (t->sent < n) {
+        const uint16_t want = (uint16_t)RTE_MIN(n - t->sent, (uint32_t)BT_TX_CHUNK);
+        const uint16_t nb = rte_eth_tx_burst(port_id, 0, bt_pkts + t->sent, want);
+        t->sent += nb;
+        if (nb == want)
+            continue;
+        t->received += bt_rx_poll(rx_port, nb_rxq, tag, NULL);
+        if (rte_get_tsc_cycles() > deadline) {
+            printf("[BURST] Port %u: TX ring not draining (link down?), %u/%u sent\n",
+                   port_id, t->sent, n);
+            rte_pktmbuf_free_bulk(bt_pkts + t->sent, n - t->sent);
+            return -1;
+        }
+    }
+
+    const uint64_t drain_end = rte_get_tsc_cycles() + tsc_hz * BURST_TEST_DRAIN_MS / 1000;
+    while (rte_get_tsc_cycles() < drain_end && t->received < n)
+        t->received += bt_rx_poll(rx_port, nb_rxq, tag, NULL);
+
+    rte_eth_stats_get(rx_port, &s1);
+    t->missed = bt_delta(s1.imissed, s0.imissed) + bt_delta(s1.rx_nombuf, s0.rx_nombuf);
+    t->pass = t->received >= n;
+
+    t->dut_valid = bt_dut_sample(&t->dut, stop_flag);
+    return *stop_flag ? -1 : 0;
+}
+
+// BURST_TEST_REPEAT trial'ın hepsi kayıpsızsa geçer; kayıp ve sayaçlar toplanır
+static int bt_probe(uint16_t port_id, uint16_t rx_port, uint16_t nb_rxq,
+                    struct rte_mempool *mp, uint32_t n, volatile bool *stop_flag,
+                    struct burst_row *row, bool *pass)
+{
+    struct burst_trial t;
+    struct burst_dut dut = { 0 };
+    uint32_t lost = 0;
+    bool missed = false;
+    bool dut_valid = true;
+
+    *pass = true;
+    for (int r = 0; r < BURST_TEST_REPEAT; r++) {
+        if (bt_trial(port_id, rx_port, nb_rxq, mp, row->cls->pcp, n, stop_flag, &t) != 0)
+            return -1;
+        row->trials++;
+        *pass &= t.pass;
+        lost += t.pass ? 0 : t.sent - t.received;
+        missed |= t.missed > 0;
+        dut_valid &= t.dut_valid;
+        dut.overflow += t.dut.overflow;
+        dut.hp_overflow += t.dut.hp_overflow;
+        dut.lp_overflow += t.dut.lp_overflow;
+        dut.be_overflow += t.dut.be_overflow;
+        dut.policy_drop += t.dut.policy_drop;
+    }
+
+    if (!*pass && (row->fail_len == 0 || n < row->fail_len)) {
+        row->fail_len = n;
+        row->fail_lost = lost;
+        row->tester_limited = missed;
+        row->fail_dut = dut;
+        row->dut_valid = dut_valid;
+    }
+    return 0;
+}
+
+// ==========================================
+// SEARCH
+// ==========================================
+
+static int bt_search(uint16_t port_id, uint16_t rx_port, uint16_t nb_rxq,
+                     struct rte_mempool *mp, volatile bool *stop_flag, struct burst_row *row)
+{
+    uint32_t lo = 0;                // Kayıpsız en uzun
+    uint32_t hi = 0;                // Kayıplı en kısa, 0 = henüz yok
+    bool pass;
+
+    // 1, 2, 4, ... BURST_TEST_MAX_PKTS
+    for (uint32_t n = 1; hi == 0 && lo < BURST_TEST_MAX_PKTS; n = RTE_MIN(n * 2, (uint32_t)BURST_TEST_MAX_PKTS)) {
+        if (bt_probe(port_id, rx_port, nb_rxq, mp, n, stop_flag, row, &pass) != 0)
+            return -1;
+        if (pass)
+            lo = n;
+        else
+            hi = n;
+    }
+
+    while (hi > lo + 1) {
+        const uint32_t mid = lo + (hi - lo) / 2;
+        if (bt_probe(port_id, rx_port, nb_rxq, mp, mid, stop_flag, row, &pass) != 0)
+            return -1;
+        if (pass)
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    row->max_ok = lo;
+    printf("[BURST] Port %u %s: max zero-loss burst %u%s (%u trials)\n",
+           port_id, row->cls->name, lo, hi == 0 ? "+" : "", row->trials);
+    return 0;
+}
+
+// ==========================================
+// REPORT
+// ==========================================
+
+static void bt_print(const struct burst_row *rows, int nb_rows)
+{
+    printf("\n=== Burst Capacity (%u B frames, back-to-back, max %u) ===\n",
+           BURST_TEST_PACKET_SIZE, BURST_TEST_MAX_PKTS);
+    printf("  ┌──────┬──────┬─────┬───────────┬────────────┬───────────┬─────────┬──────────┬──────────┬──────────┬──────────┬──────────┬────────┐\n");
+    printf("  │ Port │ Cls  │ PCP │ Max burst │ Max bytes  │ 1st fail  │  Lost   │  HP ovf  │  LP ovf  │  BE ovf  │ Tot ovf  │ Pol drop │ Trials │\n");
+    printf("  ├──────┼──────┼─────┼───────────┼────────────┼───────────┼─────────┼──────────┼──────────┼──────────┼──────────┼──────────┼────────┤\n");
+
+    for (int i = 0; i < nb_rows; i++) {
+        const struct burst_row *r = &rows[i];
+        char fail[16], lost[16], ovf[5][16];
+
+        if (r->fail_len == 0) {
+            snprintf(fail, sizeof(fail), "%9s", "-");
+            snprintf(lost, sizeof(lost), "%7s", "-");
+        } else {
+            snprintf(fail, sizeof(fail), "%9u", r->fail_len);
+            snprintf(lost, sizeof(lost), "%6u%s", r->fail_lost, r->tester_limited ? "*" : " ");
+        }
+
+        const uint64_t v[5] = { r->fail_dut.hp_overflow, r->fail_dut.lp_overflow,
+                                r->fail_dut.be_overflow, r->fail_dut.overflow,
+                                r->fail_dut.policy_drop };
+        for (int k = 0; k < 5; k++) {
+            if (r->fail_len != 0 && r->dut_valid)
+                snprintf(ovf[k], sizeof(ovf[k]), "%8lu", (unsigned long)v[k]);
+            else
+                snprintf(ovf[k], sizeof(ovf[k]), "%8s", "-");
+        }
+
+        printf("  │ %4u │ %-4s │ %3u │ %8u%s │ %10lu │ %s │ %s │ %s │ %s │ %s │ %s │ %s │ %6u │\n",
+               r->port_id, r->cls->name, r->cls->pcp,
+               r->max_ok, r->fail_len == 0 ? "+" : " ",
+               (unsigned long)r->max_ok * BURST_TEST_PACKET_SIZE,
+               fail, lost, ovf[0], ovf[1], ovf[2], ovf[3], ovf[4], r->trials);
+    }
+
+    printf("  └──────┴──────┴─────┴───────────┴────────────┴───────────┴─────────┴──────────┴──────────┴──────────┴──────────┴──────────┴────────┘\n");
+    printf("  Max burst '+': BURST_TEST_MAX_PKTS'e kadar kayıp yok. Lost '*': RX imissed arttı (tester-limited).\n");
+    printf("  Overflow / policy drop: ilk kayıplı burst sırasında tüm switch portlarının toplam farkı.\n");
+}
+
+// ==========================================
+// ENTRY
+// ==========================================
+
+int start_burst_test(struct ports_config *ports_config, volatile bool *stop_flag)
+{
+#if VLAN_ENABLED
+    static const struct burst_class classes[] = BURST_TEST_CLASSES_INIT;
+#else
+    static const struct burst_class classes[] = { { "ALL", 0 } };
+#endif
+    static struct burst_row rows[MAX_PORTS * RTE_DIM(classes)];
+    int nb_rows = 0;
+    bool health_started = false;
+    int ret = 0;
+
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════════╗\n");
+    printf("║                 BURST CAPACITY TEST BASLIYOR                     ║\n");
+    printf("║  Frame: %4u bytes | Max burst: %5u | Sinif: %zu                 ║\n",
+           BURST_TEST_PACKET_SIZE, BURST_TEST_MAX_PKTS, RTE_DIM(classes));
+    printf("╚══════════════════════════════════════════════════════════════════╝\n");
+
+    bt_pkts = rte_zmalloc("burst_test_pkts", BURST_TEST_MAX_PKTS * sizeof(*bt_pkts), 0);
+    if (bt_pkts == NULL) {
+        printf("[BURST] Cannot allocate burst table\n");
+        return -1;
+    }
+
+    bt_health = bt_health_start(stop_flag, &health_started);
+
+    for (uint16_t i = 0; i < ports_config->nb_ports && ret == 0; i++) {
+        const struct port *port = &ports_config->ports[i];
+        const uint16_t port_id = port->port_id;
+        const uint16_t rx_port = paired_port(port_id);
+
+        if (!port->is_valid || port_id >= MAX_PORTS_CONFIG)
+            continue;
+        if (port_vlans[port_id].tx_vlan_count == 0) {
+            printf("[BURST] Port %u: no TX VLANs, skipped\n", port_id);
+            continue;
+        }
+        if (!bt_port_active(ports_config, rx_port)) {
+            printf("[BURST] Port %u: paired RX port %u not active, skipped\n", port_id, rx_port);
+            continue;
+        }
+
+        char pool_name[32];
+        snprintf(pool_name, sizeof(pool_name), "mbuf_pool_%u_%u", port->numa_node, port_id);
+        struct rte_mempool *mp = rte_mempool_lookup(pool_name);
+        struct rte_eth_dev_info dev_info;
+        if (mp == NULL || rte_eth_dev_info_get(rx_port, &dev_info) != 0) {
+            printf("[BURST] Port %u: no mbuf pool or RX dev info, skipped\n", port_id);
+            continue;
+        }
+
+        printf("\n[BURST] Port %u -> RX %u (%u RX queues)\n", port_id, rx_port, dev_info.nb_rx_queues);
+        for (size_t c = 0; c < RTE_DIM(classes) && ret == 0; c++) {
+            struct burst_row *row = &rows[nb_rows++];
+            memset(row, 0, sizeof(*row));
+            row->port_id = port_id;
+            row->cls = &classes[c];
+            ret = bt_search(port_id, rx_port, dev_info.nb_rx_queues, mp, stop_flag, row);
+        }
+    }
+
+    bt_print(rows, ret == 0 ? nb_rows : nb_rows - 1);
+
+    if (health_started) {
+        stop_health_monitor();
+        cleanup_health_monitor();
+    }
+    rte_free(bt_pkts);
+    bt_pkts = NULL;
+
+    if (ret != 0)
+        printf("[BURST] Test aborted%s\n", *stop_flag ? " (stop requested)" : "");
+    else
+        printf("\n=== Burst capacity test complete ===\n");
+    return ret != 0 ? -1 : 0;
+}
+
+#endif /* BURST_TEST_ENABLED */
@@ -19,6 +19,7 @@
 #include "dpdk_external_tx.h"
 #include "packet.h"
 #include "tx_rx_manager.h"
+#include "tx_sequence.h"
 
 #if DPDK_EXT_TX_ENABLED
 
@@ -26,20 +27,14 @@
 // GLOBAL VARIABLES
 // ==========================================
 
-// External TX statistics
-struct dpdk_ext_tx_stats dpdk_ext_tx_stats_per_port[DPDK_EXT_TX_PORT_COUNT];
-
 // External TX ports
 struct dpdk_ext_tx_port dpdk_ext_tx_ports[DPDK_EXT_TX_PORT_COUNT];
 
-// Per-port per-VL-ID sequence numbers (separate from main system)
-static uint64_t ext_tx_sequences[DPDK_EXT_TX_PORT_COUNT][MAX_VL_ID + 1];
-
 // Worker parameters storage
 static struct dpdk_ext_tx_worker_params ext_worker_params[DPDK_EXT_TX_PORT_COUNT * DPDK_EXT_TX_QUEUES_PER_PORT];
 
-// Configuration
-static struct dpdk_ext_tx_port_config ext_tx_configs[] = DPDK_EXT_TX_PORTS_CONFIG_INIT;
+// Configuration (config.h varsayılanı, traffic profile [ext N] bölümleri günceller)
+struct dpdk_ext_tx_port_config dpdk_ext_tx_configs[DPDK_EXT_TX_PORT_COUNT] = DPDK_EXT_TX_PORTS_CONFIG_INIT;
 
 // ==========================================
 // RATE LIMITER (Token Bucket)
@@ -97,57 +92,69 @@ static inline bool ext_consume_tokens(struct ext_rate_limiter *limiter, uint64_t
 // HELPER FUNCTIONS
 // ==========================================
 
-static inline uint64_t get_ext_tx_sequence(uint16_t port_idx, uint16_t vl_id)
+/**
+ * Ext TX header'ını yaz: ETH + 802.1Q + IPv4 + UDP (payload hariç)
+ * Worker başında VL template'lerini render etmek için kullanılır.
+ */
+static void ext_render_header(uint8_t *pkt, uint16_t port_id, uint16_t vlan_id,
+                              uint16_t vl_id, uint16_t pkt_size)
 {
-    if (port_idx >= DPDK_EXT_TX_PORT_COUNT || vl_id > MAX_VL_ID) {
-        return 0;
-    }
-    return ext_tx_sequences[port_idx][vl_id]++;
-}
+    const uint16_t l2_len = sizeof(struct rte_ether_hdr) + 4; // +4 for VLAN tag
+    const uint16_t payload_size = pkt_size - l2_len - sizeof(struct rte_ipv4_hdr) - sizeof(struct rte_udp_hdr);
 
-// Peek without incrementing — for send-then-commit pattern
-static inline uint64_t peek_ext_tx_sequence(uint16_t port_idx, uint16_t vl_id)
-{
-    if (port_idx >= DPDK_EXT_TX_PORT_COUNT || vl_id > MAX_VL_ID) {
-        return 0;
-    }
-    return ext_tx_sequences[port_idx][vl_id];
-}
+    // ==========================================
+    // ETHERNET HEADER
+    // ==========================================
+    struct rte_ether_hdr *eth = (struct rte_ether_hdr *)pkt;
+
+    // Source MAC: 02:00:00:00:00:PP (PP = port)
+    eth->src_addr.addr_bytes[0] = 0x02;
+    eth->src_addr.addr_bytes[1] = 0x00;
+    eth->src_addr.addr_bytes[2] = 0x00;
+    eth->src_addr.addr_bytes[3] = 0x00;
+    eth->src_addr.addr_bytes[4] = 0x00;
+    eth->src_addr.addr_bytes[5] = (uint8_t)port_id;
+
+    // Destination MAC: 03:00:00:00:VV:VV (VV = VL-ID)
+    eth->dst_addr.addr_bytes[0] = 0x03;
+    eth->dst_addr.addr_bytes[1] = 0x00;
+    eth->dst_addr.addr_bytes[2] = 0x00;
+    eth->dst_addr.addr_bytes[3] = 0x00;
+    eth->dst_addr.addr_bytes[4] = (uint8_t)(vl_id >> 8);
+    eth->dst_addr.addr_bytes[5] = (uint8_t)(vl_id & 0xFF);
+
+    // VLAN tag (802.1Q) - target's VLAN ID
+    eth->ether_type = rte_cpu_to_be_16(0x8100);
+    uint8_t *vlan_tag = pkt + sizeof(struct rte_ether_hdr);
+    *(uint16_t *)vlan_tag = rte_cpu_to_be_16(vlan_id);
+    *(uint16_t *)(vlan_tag + 2) = rte_cpu_to_be_16(0x0800); // IPv4
 
-// Commit after successful send
-static inline void commit_ext_tx_sequence(uint16_t port_idx, uint16_t vl_id)
-{
-    if (port_idx >= DPDK_EXT_TX_PORT_COUNT || vl_id > MAX_VL_ID) {
-        return;
-    }
-    ext_tx_sequences[port_idx][vl_id]++;
-}
+    // ==========================================
+    // IP HEADER (dinamik total_length)
+    // ==========================================
+    struct rte_ipv4_hdr *ip = (struct rte_ipv4_hdr *)(pkt + l2_len);
+    ip->version_ihl = 0x45;
+    ip->type_of_service = 0;
+    ip->total_length = rte_cpu_to_be_16(pkt_size - l2_len);
+    ip->packet_id = 0;
+    ip->fragment_offset = 0;
+    ip->time_to_live = 1;
+    ip->next_proto_id = IPPROTO_UDP;
+    ip->src_addr = rte_cpu_to_be_32(0x0A000000); // 10.0.0.0
+    // Destination IP: 224.224.VV.VV
+    ip->dst_addr = rte_cpu_to_be_32((224U << 24) | (224U << 16) |
+                                    ((vl_id >> 8) << 8) | (vl_id & 0xFF));
+    ip->hdr_checksum = 0;
+    ip->hdr_checksum = rte_ipv4_cksum(ip);
 
-int dpdk_ext_tx_get_source_port(uint16_t vl_id)
-{
-    // VL-ID ranges must match config.h DPDK_EXT_TX_PORT_*_TARGETS
-    //
-    // Port 12 hedefli (Port 2,3,4,5):
-    //   Port 2 → VL-ID 4291-4322 (32 VL-ID)
-    //   Port 3 → VL-ID 4323-4354 (32 VL-ID)
-    //   Port 4 → VL-ID 4355-4386 (32 VL-ID)
-    //   Port 5 → VL-ID 4387-4418 (32 VL-ID)
-    //
-    // Port 13 hedefli (Port 0,6):
-    //   Port 0 → VL-ID 4099-4114 (16 VL-ID)
-    //   Port 6 → VL-ID 4115-4130 (16 VL-ID)
-
-    // Port 12 hedefli
-    if (vl_id >= 4291 && vl_id < 4323) return 2;
-    if (vl_id >= 4323 && vl_id < 4355) return 3;
-    if (vl_id >= 4355 && vl_id < 4387) return 4;
-    if (vl_id >= 4387 && vl_id < 4419) return 5;
-
-    // Port 13 hedefli
-    if (vl_id >= 4099 && vl_id < 4115) return 0;
-    if (vl_id >= 4115 && vl_id < 4131) return 6;
-
-    return -1; // Not an external TX VL-ID
+    // ==========================================
+    // UDP HEADER (dinamik dgram_len)
+    // ==========================================
+    struct rte_udp_hdr *udp = (struct rte_udp_hdr *)(pkt + l2_len + sizeof(struct rte_ipv4_hdr));
+    udp->src_port = rte_cpu_to_be_16(100);
+    udp->dst_port = rte_cpu_to_be_16(100);
+    udp->dgram_len = rte_cpu_to_be_16(sizeof(struct rte_udp_hdr) + payload_size);
+    udp->dgram_cksum = 0;
 }
 
 // ==========================================
@@ -159,20 +166,14 @@ int dpdk_ext_tx_init(struct rte_mempool *mbuf_pools[])
     printf("\n=== Initializing DPDK External TX System ===\n");
     printf("Ports: %d, Queues per port: %d\n", DPDK_EXT_TX_PORT_COUNT, DPDK_EXT_TX_QUEUES_PER_PORT);
 
-    // Initialize statistics
-    for (int i = 0; i < DPDK_EXT_TX_PORT_COUNT; i++) {
-        rte_atomic64_init(&dpdk_ext_tx_stats_per_port[i].tx_pkts);
-        rte_atomic64_init(&dpdk_ext_tx_stats_per_port[i].tx_bytes);
-    }
-
-    // Initialize sequence counters
-    memset(ext_tx_sequences, 0, sizeof(ext_tx_sequences));
+    // Initialize sequence counters (bloklar worker başında oluşturulur)
+    tx_seq_reset_domain(TX_SEQ_DOMAIN_DPDK_EXT);
 
     // Initialize port structures
     for (int i = 0; i < DPDK_EXT_TX_PORT_COUNT; i++) {
         struct dpdk_ext_tx_port *port = &dpdk_ext_tx_ports[i];
-        port->port_id = ext_tx_configs[i].port_id;
-        port->config = ext_tx_configs[i];
+        port->port_id = dpdk_ext_tx_configs[i].port_id;
+        port->config = dpdk_ext_tx_configs[i];
         port->mbuf_pool = mbuf_pools[i];  // Use index i, not port_id
 
         // Check for NULL mbuf_pool - port won't be able to TX without it
@@ -223,9 +224,9 @@ int dpdk_ext_tx_worker(void *arg)
     int port_idx = -1;
     struct dpdk_ext_tx_port_config *port_config = NULL;
     for (int i = 0; i < DPDK_EXT_TX_PORT_COUNT; i++) {
-        if (ext_tx_configs[i].port_id == params->port_id) {
+        if (dpdk_ext_tx_configs[i].port_id == params->port_id) {
             port_idx = i;
-            port_config = &ext_tx_configs[i];
+            port_config = &dpdk_ext_tx_configs[i];
             break;
         }
     }
@@ -234,6 +235,14 @@ int dpdk_ext_tx_worker(void *arg)
         return -1;
     }
 
+    // Worker'a özel stats shard'ı (ext port satırı, instance = queue)
+    struct stats_shard *tx_stats = stats_shard_create(STATS_DOM_EXT_TX, (uint16_t)port_idx, 0,
+                                                      params->queue_id, (int)rte_socket_id());
+    if (tx_stats == NULL) {
+        printf("Error: Cannot allocate stats shard for ExtTX port %u\n", params->port_id);
+        return -1;
+    }
+
     // Check for valid mbuf_pool
     if (!params->mbuf_pool) {
         printf("Error: mbuf_pool is NULL for port %u\n", params->port_id);
@@ -253,13 +262,22 @@ int dpdk_ext_tx_worker(void *arg)
         return -1;
     }
 
-    // Get PRBS cache (reuse existing per-port cache)
-    uint8_t *prbs_cache_ext = get_prbs_cache_ext_for_port(params->port_id);
-    if (!prbs_cache_ext) {
+    // Get PRBS window (reuse existing per-port window on the shared sequence)
+    const struct prbs_window *prbs_win = get_prbs_window_for_port(params->port_id);
+    if (!prbs_win) {
         printf("Error: PRBS cache not available for port %u\n", params->port_id);
         return -1;
     }
 
+    // Worker'a ait sequence bloğu: tüm target VL'leri [vl_id_start, +vl_id_count)
+    struct tx_seq_block *seqb = tx_seq_block_create_contig(
+        TX_SEQ_DOMAIN_DPDK_EXT, params->port_id, params->vl_id_start,
+        params->vl_id_count, (int)rte_socket_id());
+    if (!seqb) {
+        printf("Error: Cannot allocate ext TX sequence block for port %u\n", params->port_id);
+        return -1;
+    }
+
     // Multi-target state: round-robin through all targets
     uint16_t target_count = port_config->target_count;
     uint16_t current_target = 0;
@@ -269,8 +287,38 @@ int dpdk_ext_tx_worker(void *arg)
         return -1;
     }
 
+    // ==========================================
+    // HEADER TEMPLATES: Tüm target'ların VL-ID'leri için hazır header
+    // ==========================================
+    struct hdr_template_set tmpl_set;
+    if (hdr_template_set_alloc(&tmpl_set, params->vl_id_start, params->vl_id_count,
+                               l2_len, PACKET_SIZE_VLAN, rte_socket_id()) != 0) {
+        free(vl_offsets);
+        return -1;
+    }
+    for (int t = 0; t < target_count; t++) {
+        struct dpdk_ext_tx_target *target = &port_config->targets[t];
+        for (uint16_t v = 0; v < target->vl_id_count; v++) {
+            uint16_t vl = target->vl_id_start + v;
+            struct hdr_template *tmpl = (struct hdr_template *)hdr_template_get(&tmpl_set, vl);
+            if (tmpl)
+                ext_render_header(tmpl->bytes, params->port_id, target->vlan_id, vl, PACKET_SIZE_VLAN);
+        }
+    }
+
+#if TX_ZEROCOPY_PRBS_ENABLED
+    // PRBS payload'ı extbuf segmenti olarak gönder (NIC desteklemiyorsa kopya)
+    struct prbs_zc_ctx zc;
+    if (prbs_zc_init(&zc, params->port_id, params->queue_id, prbs_win,
+                     rte_socket_id()) != 0) {
+        hdr_template_set_free(&tmpl_set);
+        free(vl_offsets);
+        return -1;
+    }
+#endif
+
 #if IMIX_ENABLED
-    const uint64_t avg_pkt_size = IMIX_AVG_PACKET_SIZE;
+    const uint64_t avg_pkt_size = imix_avg_packet_size;
 #else
     const uint64_t avg_pkt_size = PACKET_SIZE_VLAN;
 #endif
@@ -320,7 +368,7 @@ int dpdk_ext_tx_worker(void *arg)
     printf("  *** TOKEN BUCKET MODE - %u total VL-IDX, 1ms window ***\n", total_tb_vl_count);
 #elif IMIX_ENABLED
     printf("  *** IMIX MODE + SMOOTH PACING ***\n");
-    printf("  -> IMIX pattern: 100, 200, 400, 800, 1200x3, 1518x3 (avg=%lu bytes)\n", avg_pkt_size);
+    printf("  -> IMIX pattern: %d entries (avg=%lu bytes)\n", IMIX_PATTERN_SIZE, avg_pkt_size);
     printf("  -> Worker offset: %u (hybrid shuffle)\n", imix_offset);
 #else
     printf("  *** SMOOTH PACING - 1 saniyeye yayılmış trafik ***\n");
@@ -334,9 +382,8 @@ int dpdk_ext_tx_worker(void *arg)
     printf("  -> Pacing: %.1f us/paket (%.0f paket/s), stagger=%lums\n",
            inter_packet_us, (double)packets_per_sec, stagger_offset * 1000 / tsc_hz);
 
-    uint64_t local_tx_pkts = 0;
-    uint64_t local_tx_bytes = 0;
-    const uint32_t STATS_FLUSH = 1024;
+    struct stats_counters lc = {0};
+    const uint32_t STATS_PUBLISH_BATCH = 32;
 
     while (!(*params->stop_flag))
     {
@@ -375,7 +422,6 @@ int dpdk_ext_tx_worker(void *arg)
         }
 
         struct rte_mbuf *m = pkts[0];
-        uint8_t *pkt = rte_pktmbuf_mtod(m, uint8_t *);
 
         // Get current target (round-robin between all targets)
         struct dpdk_ext_tx_target *target = &port_config->targets[current_target];
@@ -388,96 +434,33 @@ int dpdk_ext_tx_worker(void *arg)
         current_target = (current_target + 1) % target_count;
 
         // Peek sequence WITHOUT incrementing — only commit after successful send
-        uint64_t seq = peek_ext_tx_sequence(port_idx, curr_vl);
-
-        // ==========================================
-        // BUILD ETHERNET HEADER
-        // ==========================================
-        struct rte_ether_hdr *eth = (struct rte_ether_hdr *)pkt;
-
-        // Source MAC: 02:00:00:00:00:PP (PP = port)
-        eth->src_addr.addr_bytes[0] = 0x02;
-        eth->src_addr.addr_bytes[1] = 0x00;
-        eth->src_addr.addr_bytes[2] = 0x00;
-        eth->src_addr.addr_bytes[3] = 0x00;
-        eth->src_addr.addr_bytes[4] = 0x00;
-        eth->src_addr.addr_bytes[5] = (uint8_t)params->port_id;
-
-        // Destination MAC: 03:00:00:00:VV:VV (VV = VL-ID)
-        eth->dst_addr.addr_bytes[0] = 0x03;
-        eth->dst_addr.addr_bytes[1] = 0x00;
-        eth->dst_addr.addr_bytes[2] = 0x00;
-        eth->dst_addr.addr_bytes[3] = 0x00;
-        eth->dst_addr.addr_bytes[4] = (uint8_t)(curr_vl >> 8);
-        eth->dst_addr.addr_bytes[5] = (uint8_t)(curr_vl & 0xFF);
-
-        // VLAN tag (802.1Q) - use target's VLAN ID
-        eth->ether_type = rte_cpu_to_be_16(0x8100);
-        uint8_t *vlan_tag = pkt + sizeof(struct rte_ether_hdr);
-        uint16_t vlan_tci = target->vlan_id;
-        *(uint16_t *)vlan_tag = rte_cpu_to_be_16(vlan_tci);
-        *(uint16_t *)(vlan_tag + 2) = rte_cpu_to_be_16(0x0800); // IPv4
+        uint64_t seq = tx_seq_peek(seqb, (uint16_t)(curr_vl - params->vl_id_start));
 
 #if IMIX_ENABLED
         // IMIX: Paket boyutunu pattern'den al
         uint16_t pkt_size = get_imix_packet_size(imix_counter, imix_offset);
         uint16_t prbs_len = calc_prbs_size(pkt_size);
-        uint16_t payload_size = pkt_size - l2_len - sizeof(struct rte_ipv4_hdr) - sizeof(struct rte_udp_hdr);
         imix_counter++;
 #else
         const uint16_t pkt_size = PACKET_SIZE_VLAN;
         const uint16_t prbs_len = NUM_PRBS_BYTES;
-        const uint16_t payload_size = PAYLOAD_SIZE_VLAN;
 #endif
 
         // ==========================================
-        // BUILD IP HEADER (dinamik total_length)
+        // HEADER: Hazır VL template'i (tek 64 byte kopya) + Sequence
+        // IMIX: total_length/dgram_len + checksum artımsal düzeltilir
         // ==========================================
-        struct rte_ipv4_hdr *ip = (struct rte_ipv4_hdr *)(pkt + l2_len);
-        ip->version_ihl = 0x45;
-        ip->type_of_service = 0;
-        ip->total_length = rte_cpu_to_be_16(pkt_size - l2_len);
-        ip->packet_id = 0;
-        ip->fragment_offset = 0;
-        ip->time_to_live = 1;
-        ip->next_proto_id = IPPROTO_UDP;
-        ip->src_addr = rte_cpu_to_be_32(0x0A000000); // 10.0.0.0
-        // Destination IP: 224.224.VV.VV
-        ip->dst_addr = rte_cpu_to_be_32((224U << 24) | (224U << 16) |
-                                        ((curr_vl >> 8) << 8) | (curr_vl & 0xFF));
-        ip->hdr_checksum = 0;
-        ip->hdr_checksum = rte_ipv4_cksum(ip);
+        hdr_template_stamp(m, &tmpl_set, hdr_template_get(&tmpl_set, curr_vl), seq, pkt_size);
 
         // ==========================================
-        // BUILD UDP HEADER (dinamik dgram_len)
+        // PAYLOAD: PRBS (IMIX: offset hep MAX ile hesaplanır, boyut dinamik)
         // ==========================================
-        struct rte_udp_hdr *udp = (struct rte_udp_hdr *)(pkt + l2_len + sizeof(struct rte_ipv4_hdr));
-        udp->src_port = rte_cpu_to_be_16(100);
-        udp->dst_port = rte_cpu_to_be_16(100);
-        udp->dgram_len = rte_cpu_to_be_16(sizeof(struct rte_udp_hdr) + payload_size);
-        udp->dgram_cksum = 0;
-
-        // ==========================================
-        // BUILD PAYLOAD (Sequence + PRBS)
-        // ==========================================
-        uint8_t *payload = pkt + l2_len + sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr);
-
-        // Sequence number (8 bytes)
-        *(uint64_t *)payload = seq;
-
-        // PRBS data (IMIX: offset hep MAX ile hesaplanır, boyut dinamik)
-#if IMIX_ENABLED
-        uint64_t prbs_offset = (seq * (uint64_t)MAX_PRBS_BYTES) % PRBS_CACHE_SIZE;
-        memcpy(payload + 8, prbs_cache_ext + prbs_offset, prbs_len);
+#if TX_ZEROCOPY_PRBS_ENABLED
+        prbs_zc_attach_payload(&zc, m, l2_len, seq, prbs_len, 0);
 #else
-        uint64_t prbs_offset = (seq * (uint64_t)NUM_PRBS_BYTES) % PRBS_CACHE_SIZE;
-        memcpy(payload + 8, prbs_cache_ext + prbs_offset, NUM_PRBS_BYTES);
+        fill_prbs_after_template(m, prbs_win, l2_len, seq, prbs_len);
 #endif
 
-        // Set packet length (dinamik)
-        m->data_len = pkt_size;
-        m->pkt_len = pkt_size;
-
         // Send single packet
         uint16_t nb_tx = rte_eth_tx_burst(params->port_id, params->queue_id, pkts, 1);
 
@@ -488,29 +471,29 @@ int dpdk_ext_tx_worker(void *arg)
 
         if (nb_tx > 0) {
             // Sequence'ı sadece başarılı gönderimden sonra artır
-            commit_ext_tx_sequence(port_idx, curr_vl);
-            local_tx_pkts++;
-            local_tx_bytes += pkt_size;
+            tx_seq_commit(seqb, (uint16_t)(curr_vl - params->vl_id_start));
+            lc.pkts++;
+            lc.bytes += pkt_size;
         } else {
             // TX queue dolu — paketi at, sequence artırma (tekrar denenecek)
             rte_pktmbuf_free(pkts[0]);
         }
 
-        // Flush stats periodically
-        if (local_tx_pkts >= STATS_FLUSH) {
-            rte_atomic64_add(&dpdk_ext_tx_stats_per_port[port_idx].tx_pkts, local_tx_pkts);
-            rte_atomic64_add(&dpdk_ext_tx_stats_per_port[port_idx].tx_bytes, local_tx_bytes);
-            local_tx_pkts = 0;
-            local_tx_bytes = 0;
-        }
+        // Tek paketlik burst'ler: shard'a birkaç düzine pakette bir yayınla
+        if (lc.pkts >= STATS_PUBLISH_BATCH)
+            stats_shard_publish(tx_stats, &lc);
     }
 
     // Final stats flush
-    if (local_tx_pkts > 0) {
-        rte_atomic64_add(&dpdk_ext_tx_stats_per_port[port_idx].tx_pkts, local_tx_pkts);
-        rte_atomic64_add(&dpdk_ext_tx_stats_per_port[port_idx].tx_bytes, local_tx_bytes);
-    }
+    stats_shard_publish(tx_stats, &lc);
 
+#if TX_ZEROCOPY_PRBS_ENABLED
+    printf("ExtTX Port %u Q%u: %lu zero-copy, %lu copy-fallback packets\n",
+           params->port_id, params->queue_id,
+           (unsigned long)zc.zc_pkts, (unsigned long)zc.copy_pkts);
+    prbs_zc_free(&zc);
+#endif
+    hdr_template_set_free(&tmpl_set);
     free(vl_offsets);
     printf("ExtTX Worker stopped: Port %u Q%u\n", params->port_id, params->queue_id);
     return 0;
@@ -532,7 +515,7 @@ int dpdk_ext_tx_start_workers(struct ports_config *ports_config, volatile bool *
 
     for (int p = 0; p < DPDK_EXT_TX_PORT_COUNT; p++)
     {
-        uint16_t port_id = ext_tx_configs[p].port_id;
+        uint16_t port_id = dpdk_ext_tx_configs[p].port_id;
         struct dpdk_ext_tx_port *ext_port = &dpdk_ext_tx_ports[p];
 
         // Skip ports that weren't properly initialized (no mbuf_pool)
@@ -593,12 +576,13 @@ int dpdk_ext_tx_start_workers(struct ports_config *ports_config, volatile bool *
 // STATISTICS
 // ==========================================
 
-void dpdk_ext_tx_get_stats(uint16_t port_id, uint64_t *tx_pkts, uint64_t *tx_bytes)
+void dpdk_ext_tx_get_stats(const struct stats_snapshot *snap, uint16_t port_id,
+                           uint64_t *tx_pkts, uint64_t *tx_bytes)
 {
     for (int i = 0; i < DPDK_EXT_TX_PORT_COUNT; i++) {
-        if (ext_tx_configs[i].port_id == port_id) {
-            *tx_pkts = rte_atomic64_read(&dpdk_ext_tx_stats_per_port[i].tx_pkts);
-            *tx_bytes = rte_atomic64_read(&dpdk_ext_tx_stats_per_port[i].tx_bytes);
+        if (dpdk_ext_tx_configs[i].port_id == port_id) {
+            *tx_pkts = snap->ext_tx[i].pkts;
+            *tx_bytes = snap->ext_tx[i].bytes;
             return;
         }
     }
@@ -606,7 +590,7 @@ void dpdk_ext_tx_get_stats(uint16_t port_id, uint64_t *tx_pkts, uint64_t *tx_byt
     *tx_bytes = 0;
 }
 
-void dpdk_ext_tx_print_stats(void)
+void dpdk_ext_tx_print_stats(const struct stats_snapshot *snap)
 {
     static uint64_t prev_bytes[DPDK_EXT_TX_PORT_COUNT] = {0};
     static uint64_t last_time_ns = 0;
@@ -631,27 +615,27 @@ void dpdk_ext_tx_print_stats(void)
     double total_to_12_mbps = 0, total_to_13_mbps = 0;
 
     for (int i = 0; i < DPDK_EXT_TX_PORT_COUNT; i++) {
-        uint64_t pkts = rte_atomic64_read(&dpdk_ext_tx_stats_per_port[i].tx_pkts);
-        uint64_t bytes = rte_atomic64_read(&dpdk_ext_tx_stats_per_port[i].tx_bytes);
+        uint64_t pkts = snap->ext_tx[i].pkts;
+        uint64_t bytes = snap->ext_tx[i].bytes;
 
         uint64_t bytes_delta = bytes - prev_bytes[i];
         double mbps = (bytes_delta * 8.0) / (elapsed_sec * 1000000.0);
         prev_bytes[i] = bytes;
 
         // Get VL-ID range from config
-        uint16_t vl_start = ext_tx_configs[i].targets[0].vl_id_start;
-        uint16_t vl_end = ext_tx_configs[i].targets[ext_tx_configs[i].target_count - 1].vl_id_start +
-                          ext_tx_configs[i].targets[ext_tx_configs[i].target_count - 1].vl_id_count;
+        uint16_t vl_start = dpdk_ext_tx_configs[i].targets[0].vl_id_start;
+        uint16_t vl_end = dpdk_ext_tx_configs[i].targets[dpdk_ext_tx_configs[i].target_count - 1].vl_id_start +
+                          dpdk_ext_tx_configs[i].targets[dpdk_ext_tx_configs[i].target_count - 1].vl_id_count;
 
         printf("║  P%-3u  ║  P%-4u  ║ %12lu ║ %13lu ║ %9.2f ║  %5u - %-5u      ║\n",
-               ext_tx_configs[i].port_id, ext_tx_configs[i].dest_port,
+               dpdk_ext_tx_configs[i].port_id, dpdk_ext_tx_configs[i].dest_port,
                pkts, bytes, mbps, vl_start, vl_end - 1);
 
-        if (ext_tx_configs[i].dest_port == 12) {
+        if (dpdk_ext_tx_configs[i].dest_port == 12) {
             total_to_12_pkts += pkts;
             total_to_12_bytes += bytes;
             total_to_12_mbps += mbps;
-        } else if (ext_tx_configs[i].dest_port == 13) {
+        } else if (dpdk_ext_tx_configs[i].dest_port == 13) {
             total_to_13_pkts += pkts;
             total_to_13_bytes += bytes;
             total_to_13_mbps += mbps;
@@ -0,0 +1,194 @@
+#include "flow_registry.h"
+#include "tx_rx_manager.h"      // port_vlans, VL_RANGE_SIZE_PER_QUEUE
+#include "raw_socket_port.h"    // raw_ports, raw_port_configs
+#include "dpdk_external_tx.h"   // dpdk_ext_tx_ports
+
+#include <stdio.h>
+#include <string.h>
+#include <rte_malloc.h>
+
+_Static_assert(MAX_PORTS_CONFIG <= 16, "flow_entry.dpdk_src_mask is 16 bits");
+
+const struct flow_entry *flow_table = NULL;
+uint16_t flow_table_size = 0;
+
+const struct flow_entry flow_entry_none = {
+    .kind = FLOW_SRC_NONE,
+    .raw_rx_source = { [0 ... MAX_RAW_SOCKET_PORTS - 1] = FLOW_RAW_SOURCE_NONE },
+};
+
+// vl_start + (i / block_size) * block_step + i % block_size
+static inline uint16_t flow_block_vl(uint16_t vl_start, uint16_t i,
+                                     uint16_t block_size, uint16_t block_step)
+{
+    return (uint16_t)(vl_start + (i / block_size) * block_step + i % block_size);
+}
+
+static void raw_target_layout(uint16_t port_id, uint16_t vl_count,
+                              uint16_t *block_size, uint16_t *block_step)
+{
+#if TOKEN_BUCKET_TX_ENABLED
+    (void)vl_count;
+    *block_size = (port_id == 12) ? TB_PORT_12_VL_BLOCK_SIZE : TB_PORT_13_VL_BLOCK_SIZE;
+    *block_step = (port_id == 12) ? TB_PORT_12_VL_BLOCK_STEP : TB_PORT_13_VL_BLOCK_STEP;
+#else
+    (void)port_id;
+    *block_size = vl_count;
+    *block_step = vl_count;
+#endif
+}
+
+uint16_t flow_raw_target_vl(uint16_t raw_port_id, const struct raw_tx_target_config *tc, uint16_t i)
+{
+    uint16_t bs, step;
+    raw_target_layout(raw_port_id, tc->vl_id_count, &bs, &step);
+    return flow_block_vl(tc->vl_id_start, i, bs, step);
+}
+
+// Pass 1: tüm VL'leri vl_map'e kaydet (tablo boyutu = vl_map_count)
+static int flow_register_vl_ids(void)
+{
+    for (uint16_t p = 0; p < MAX_PORTS_CONFIG; p++) {
+        for (uint16_t q = 0; q < port_vlans[p].tx_vlan_count; q++) {
+            if (vl_map_add_range(port_vlans[p].tx_vl_ids[q], VL_RANGE_SIZE_PER_QUEUE,
+                                 VL_RANGE_SIZE_PER_QUEUE, VL_RANGE_SIZE_PER_QUEUE) != 0)
+                return -1;
+        }
+        for (uint16_t q = 0; q < port_vlans[p].rx_vlan_count; q++) {
+            if (vl_map_add_range(port_vlans[p].rx_vl_ids[q], VL_RANGE_SIZE_PER_QUEUE,
+                                 VL_RANGE_SIZE_PER_QUEUE, VL_RANGE_SIZE_PER_QUEUE) != 0)
+                return -1;
+        }
+    }
+
+    for (int i = 0; i < active_raw_port_count; i++) {
+        const struct raw_socket_port_config *cfg = &raw_port_configs[i];
+        for (int t = 0; t < cfg->tx_target_count; t++) {
+            const struct raw_tx_target_config *tc = &cfg->tx_targets[t];
+            uint16_t bs, step;
+            raw_target_layout(cfg->port_id, tc->vl_id_count, &bs, &step);
+            if (vl_map_add_range(tc->vl_id_start, tc->vl_id_count, bs, step) != 0)
+                return -1;
+        }
+        for (int s = 0; s < cfg->rx_source_count; s++) {
+            const struct raw_rx_source_config *sc = &cfg->rx_sources[s];
+            if (vl_map_add_range(sc->vl_id_start, sc->vl_id_count,
+                                 sc->vl_id_count, sc->vl_id_count) != 0)
+                return -1;
+        }
+    }
+
+#if DPDK_EXT_TX_ENABLED
+    for (int i = 0; i < DPDK_EXT_TX_PORT_COUNT; i++) {
+        const struct dpdk_ext_tx_port_config *cfg = &dpdk_ext_tx_ports[i].config;
+        for (int t = 0; t < cfg->target_count; t++) {
+            const struct dpdk_ext_tx_target *tc = &cfg->targets[t];
+            if (vl_map_add_range(tc->vl_id_start, tc->vl_id_count,
+                                 tc->vl_id_count, tc->vl_id_count) != 0)
+                return -1;
+        }
+    }
+#endif
+    return 0;
+}
+
+// Harici kaynak ata; aynı VL'e ikinci kaynak yapılandırma hatasıdır (ilk kazanır)
+static void flow_set_ext(struct flow_entry *e, uint16_t vl_id, uint8_t kind, uint16_t src_port,
+                         const struct prbs_window *prbs, uint16_t step, uint16_t len)
+{
+    if (e->kind != FLOW_SRC_NONE) {
+        if (e->kind != kind || e->src_port != src_port)
+            printf("Warning: VL-ID %u claimed by port %u and port %u, keeping port %u\n",
+                   vl_id, e->src_port, src_port, e->src_port);
+        return;
+    }
+    e->kind = kind;
+    e->src_port = src_port;
+    e->prbs = prbs;
+    e->prbs_step = step;
+    e->prbs_len = len;
+}
+
+int flow_registry_build(void)
+{
+    if (flow_table != NULL)
+        return 0;
+
+    if (flow_register_vl_ids() != 0) {
+        printf("Error: VL-ID map registration failed\n");
+        return -1;
+    }
+
+    const uint16_t n = vl_map_count();
+    struct flow_entry *tbl = rte_zmalloc("flow_table", (size_t)(n ? n : 1) * sizeof(*tbl),
+                                         RTE_CACHE_LINE_SIZE);
+    if (tbl == NULL) {
+        printf("Error: Cannot allocate flow registry (%u entries)\n", n);
+        return -1;
+    }
+    for (uint16_t i = 0; i < n; i++)
+        tbl[i] = flow_entry_none;
+
+    // DPDK kaynakları (tx_worker): port başına bitmask
+    for (uint16_t p = 0; p < MAX_PORTS_CONFIG; p++) {
+        for (uint16_t q = 0; q < port_vlans[p].tx_vlan_count; q++) {
+            for (uint16_t i = 0; i < VL_RANGE_SIZE_PER_QUEUE; i++) {
+                uint16_t vl = (uint16_t)(port_vlans[p].tx_vl_ids[q] + i);
+                tbl[vl_map_index(vl)].dpdk_src_mask |= (uint16_t)(1u << p);
+            }
+        }
+    }
+
+    // Raw socket kaynakları ve alıcı raw portların source index'leri
+    for (int r = 0; r < active_raw_port_count && r < MAX_RAW_SOCKET_PORTS; r++) {
+        const struct raw_socket_port_config *cfg = &raw_port_configs[r];
+        const struct prbs_window *prbs = raw_ports[r].prbs_initialized ? &raw_ports[r].prbs_win : NULL;
+#if IMIX_ENABLED
+        const uint16_t step = MAX_PRBS_BYTES;     // IMIX: offset hep MAX boyutla
+#else
+        const uint16_t step = RAW_PKT_PRBS_BYTES;
+#endif
+        for (int t = 0; t < cfg->tx_target_count; t++) {
+            const struct raw_tx_target_config *tc = &cfg->tx_targets[t];
+            uint16_t bs, bstep;
+            raw_target_layout(cfg->port_id, tc->vl_id_count, &bs, &bstep);
+            for (uint16_t i = 0; i < tc->vl_id_count; i++) {
+                uint16_t vl = flow_block_vl(tc->vl_id_start, i, bs, bstep);
+                flow_set_ext(&tbl[vl_map_index(vl)], vl, FLOW_SRC_RAW, cfg->port_id,
+                             prbs, step, RAW_PKT_PRBS_BYTES);
+            }
+        }
+        for (int s = 0; s < cfg->rx_source_count; s++) {
+            const struct raw_rx_source_config *sc = &cfg->rx_sources[s];
+            for (uint16_t i = 0; i < sc->vl_id_count; i++) {
+                struct flow_entry *e = &tbl[vl_map_index((uint16_t)(sc->vl_id_start + i))];
+                if (e->raw_rx_source[r] == FLOW_RAW_SOURCE_NONE)
+                    e->raw_rx_source[r] = (int8_t)s;
+            }
+        }
+    }
+
+#if DPDK_EXT_TX_ENABLED
+    // DPDK external TX: kaynak portun kendi PRBS penceresi, offset adımı NUM_PRBS_BYTES
+    for (int i = 0; i < DPDK_EXT_TX_PORT_COUNT; i++) {
+        const struct dpdk_ext_tx_port_config *cfg = &dpdk_ext_tx_ports[i].config;
+        const struct prbs_window *prbs = dpdk_ext_tx_ports[i].prbs_initialized ?
+                                         dpdk_ext_tx_ports[i].prbs_win : NULL;
+        for (int t = 0; t < cfg->target_count; t++) {
+            const struct dpdk_ext_tx_target *tc = &cfg->targets[t];
+            for (uint16_t v = 0; v < tc->vl_id_count; v++) {
+                uint16_t vl = (uint16_t)(tc->vl_id_start + v);
+                flow_set_ext(&tbl[vl_map_index(vl)], vl, FLOW_SRC_DPDK_EXT, cfg->port_id,
+                             prbs, NUM_PRBS_BYTES, NUM_PRBS_BYTES);
+            }
+        }
+    }
+#endif
+
+    flow_table = tbl;
+    __atomic_store_n(&flow_table_size, n, __ATOMIC_RELEASE);
+
+    printf("Flow registry: %u VL-IDs (%zu B table, %zu B tracker state per RX queue)\n",
+           n, (size_t)n * sizeof(struct flow_entry), (size_t)n * sizeof(struct rx_seq_track));
+    return 0;
+}
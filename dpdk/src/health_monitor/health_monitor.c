@@ -610,6 +610,28 @@ static int receive_health_responses(int timeout_ms, struct health_cycle_data *cy
     return 0;
 }
 
+// ==========================================
+// POLICING COUNTERS
+// ==========================================
+
+// Bu döngüde gelen portları güncelle; cevap gelmeyen port son değerini korur
+static void health_update_policing(struct health_port_policing *dst,
+                                   const struct health_fpga_data *fpga)
+{
+    for (int i = 0; i < HEALTH_MAX_PORTS; i++) {
+        const struct health_port_info *p = &fpga->ports[i];
+        if (!p->valid)
+            continue;
+        dst[i].traffic_policy_drop = p->traffic_policy_drop;
+        dst[i].max_delay_err = p->max_delay_err;
+        dst[i].queue_overflow = p->queue_overflow;
+        dst[i].hp_queue_overflow = p->hp_queue_overflow;
+        dst[i].lp_queue_overflow = p->lp_queue_overflow;
+        dst[i].be_queue_overflow = p->be_queue_overflow;
+        dst[i].valid = true;
+    }
+}
+
 // ==========================================
 // THREAD FUNCTION
 // ==========================================
@@ -658,6 +680,8 @@ static void *health_monitor_thread_func(void *arg)
         if (cycle.total_responses_received < HEALTH_MONITOR_EXPECTED_RESPONSES) {
             state->stats.timeouts++;
         }
+        health_update_policing(state->assistant_policing, &cycle.assistant);
+        health_update_policing(state->manager_policing, &cycle.manager);
         pthread_spin_unlock(&state->stats_lock);
 
         // 6. Increment sequence (255 -> 1, skip 0)
@@ -822,6 +846,17 @@ void get_health_monitor_stats(struct health_monitor_stats *stats)
     pthread_spin_unlock(&state->stats_lock);
 }
 
+void get_health_port_policing(struct health_port_policing *assistant,
+                              struct health_port_policing *manager)
+{
+    struct health_monitor_state *state = &g_health_monitor;
+
+    pthread_spin_lock(&state->stats_lock);
+    memcpy(assistant, state->assistant_policing, sizeof(state->assistant_policing));
+    memcpy(manager, state->manager_policing, sizeof(state->manager_policing));
+    pthread_spin_unlock(&state->stats_lock);
+}
+
 void print_health_monitor_stats(void)
 {
     struct health_monitor_stats stats;
@@ -4,12 +4,13 @@
 #include <string.h>
 #include <stdbool.h>
 #include <rte_ethdev.h>
-#include <rte_atomic.h>
 
 #include "config.h"
-#include "tx_rx_manager.h"  // rx_stats_per_port için
+#include "tx_rx_manager.h"  // init_rx_stats için
+#include "stats_shard.h"    // struct stats_snapshot
 #include "dpdk_external_tx.h" // External TX stats için
 #include "raw_socket_port.h"  // reset_raw_socket_stats için
+#include "bag_sched.h"        // bag_sched_reset için
 
 // Daemon mode flag - when true, ANSI escape codes are disabled
 bool g_daemon_mode = false;
@@ -35,14 +36,16 @@ void helper_reset_stats(const struct ports_config *ports_config,
     }
 
     // RX doğrulama istatistikleri (PRBS) sıfırla
+    // (stats_reset: port, DTN ve raw shard'ların hepsi baseline'a alınır)
     init_rx_stats();
 
-#if STATS_MODE_DTN
-    init_dtn_stats();
-#endif
-
     // Raw socket ve global sequence tracking sıfırla
     reset_raw_socket_stats();
+
+#if BAG_SCHED_ENABLED
+    // BAG uygunluk sayaçları (zamanlama korunur, worker bir sonraki turda sıfırlar)
+    bag_sched_reset();
+#endif
 }
 
 #if STATS_MODE_DTN
@@ -54,7 +57,7 @@ void helper_reset_stats(const struct ports_config *ports_config,
 //
 // DTN TX (DTN→Server) = Server RX = HW q_ipackets[queue]
 // DTN RX (Server→DTN) = Server TX = HW q_opackets[queue]
-// PRBS = dtn_stats[dtn_port] (RX worker'dan)
+// PRBS = snap->dtn[dtn_port] (RX worker shard'ları + sequence merge)
 
 // Per-queue prev bytes (DTN port bazlı delta hesaplama için)
 // [dtn_port][0=tx_bytes, 1=rx_bytes]
@@ -62,6 +65,7 @@ static uint64_t dtn_prev_tx_bytes[DTN_PORT_COUNT];
 static uint64_t dtn_prev_rx_bytes[DTN_PORT_COUNT];
 
 static void helper_print_dtn_stats(const struct ports_config *ports_config,
+                                   const struct stats_snapshot *snap,
                                    bool warmup_complete, unsigned loop_count,
                                    unsigned test_time)
 {
@@ -106,10 +110,8 @@ static void helper_print_dtn_stats(const struct ports_config *ports_config,
     uint64_t port12_target_tx_pkts[MAX_RAW_TARGETS] = {0};
     uint16_t port12_target_dest[MAX_RAW_TARGETS] = {0};
     for (uint16_t t = 0; t < port12->tx_target_count; t++) {
-        pthread_spin_lock(&port12->tx_targets[t].stats.lock);
-        port12_target_tx_bytes[t] = port12->tx_targets[t].stats.tx_bytes;
-        port12_target_tx_pkts[t] = port12->tx_targets[t].stats.tx_packets;
-        pthread_spin_unlock(&port12->tx_targets[t].stats.lock);
+        port12_target_tx_bytes[t] = snap->raw_tx[0][t].bytes;
+        port12_target_tx_pkts[t] = snap->raw_tx[0][t].pkts;
         port12_target_dest[t] = port12->tx_targets[t].config.dest_port;
     }
 
@@ -148,11 +150,11 @@ static void helper_print_dtn_stats(const struct ports_config *ports_config,
         dtn_prev_tx_bytes[dtn] = dtn_tx_bytes;
         dtn_prev_rx_bytes[dtn] = dtn_rx_bytes;
 
-        // PRBS istatistikleri (dtn_stats'ten)
-        uint64_t good = rte_atomic64_read(&dtn_stats[dtn].good_pkts);
-        uint64_t bad = rte_atomic64_read(&dtn_stats[dtn].bad_pkts);
-        uint64_t lost = rte_atomic64_read(&dtn_stats[dtn].lost_pkts);
-        uint64_t bit_errors = rte_atomic64_read(&dtn_stats[dtn].bit_errors);
+        // PRBS istatistikleri (snapshot'tan)
+        uint64_t good = snap->dtn[dtn].good_pkts;
+        uint64_t bad = snap->dtn[dtn].bad_pkts;
+        uint64_t lost = snap->dtn[dtn].lost_pkts;
+        uint64_t bit_errors = snap->dtn[dtn].bit_errors;
 
         // BER hesaplama
         double ber = 0.0;
@@ -169,26 +171,23 @@ static void helper_print_dtn_stats(const struct ports_config *ports_config,
     }
 
     // DTN Port 32 (Port 12 - 1G raw socket)
-    // DTN TX = DTN→Server = dpdk_ext_rx_stats (server bu port'tan alıyor)
+    // DTN TX = DTN→Server = raw_ext_rx (server bu port'tan alıyor)
     // DTN RX = Server→DTN = raw socket TX aggregate (server bu port'tan gönderiyor)
     {
         struct raw_socket_port *port12 = &raw_ports[0];
         // DTN TX: Server Port 12'den aldığı (DPDK External TX RX stats)
-        pthread_spin_lock(&port12->dpdk_ext_rx_stats.lock);
-        uint64_t dtn32_tx_pkts = port12->dpdk_ext_rx_stats.rx_packets;
-        uint64_t dtn32_tx_bytes = port12->dpdk_ext_rx_stats.rx_bytes;
-        uint64_t dtn32_good = port12->dpdk_ext_rx_stats.good_pkts;
-        uint64_t dtn32_bad = port12->dpdk_ext_rx_stats.bad_pkts;
-        uint64_t dtn32_bit_err = port12->dpdk_ext_rx_stats.bit_errors;
-        pthread_spin_unlock(&port12->dpdk_ext_rx_stats.lock);
+        const struct stats_counters *ext = &snap->raw_ext_rx[0];
+        uint64_t dtn32_tx_pkts = ext->pkts;
+        uint64_t dtn32_tx_bytes = ext->bytes;
+        uint64_t dtn32_good = ext->good_pkts;
+        uint64_t dtn32_bad = ext->bad_pkts;
+        uint64_t dtn32_bit_err = ext->bit_errors;
 
         // DTN RX: Server'ın Port 12 üzerinden gönderdiği (raw socket TX aggregate)
         uint64_t dtn32_rx_pkts = 0, dtn32_rx_bytes = 0;
         for (uint16_t t = 0; t < port12->tx_target_count; t++) {
-            pthread_spin_lock(&port12->tx_targets[t].stats.lock);
-            dtn32_rx_pkts += port12->tx_targets[t].stats.tx_packets;
-            dtn32_rx_bytes += port12->tx_targets[t].stats.tx_bytes;
-            pthread_spin_unlock(&port12->tx_targets[t].stats.lock);
+            dtn32_rx_pkts += snap->raw_tx[0][t].pkts;
+            dtn32_rx_bytes += snap->raw_tx[0][t].bytes;
         }
 
         uint64_t tx_delta = dtn32_tx_bytes - dtn_prev_tx_bytes[DTN_RAW_PORT_12];
@@ -214,21 +213,18 @@ static void helper_print_dtn_stats(const struct ports_config *ports_config,
     {
         struct raw_socket_port *port13 = &raw_ports[1];
         // DTN TX: Server Port 13'ten aldığı (DPDK External TX RX stats)
-        pthread_spin_lock(&port13->dpdk_ext_rx_stats.lock);
-        uint64_t dtn33_tx_pkts = port13->dpdk_ext_rx_stats.rx_packets;
-        uint64_t dtn33_tx_bytes = port13->dpdk_ext_rx_stats.rx_bytes;
-        uint64_t dtn33_good = port13->dpdk_ext_rx_stats.good_pkts;
-        uint64_t dtn33_bad = port13->dpdk_ext_rx_stats.bad_pkts;
-        uint64_t dtn33_bit_err = port13->dpdk_ext_rx_stats.bit_errors;
-        pthread_spin_unlock(&port13->dpdk_ext_rx_stats.lock);
+        const struct stats_counters *ext = &snap->raw_ext_rx[1];
+        uint64_t dtn33_tx_pkts = ext->pkts;
+        uint64_t dtn33_tx_bytes = ext->bytes;
+        uint64_t dtn33_good = ext->good_pkts;
+        uint64_t dtn33_bad = ext->bad_pkts;
+        uint64_t dtn33_bit_err = ext->bit_errors;
 
         // DTN RX: Server'ın Port 13 üzerinden gönderdiği
         uint64_t dtn33_rx_pkts = 0, dtn33_rx_bytes = 0;
         for (uint16_t t = 0; t < port13->tx_target_count; t++) {
-            pthread_spin_lock(&port13->tx_targets[t].stats.lock);
-            dtn33_rx_pkts += port13->tx_targets[t].stats.tx_packets;
-            dtn33_rx_bytes += port13->tx_targets[t].stats.tx_bytes;
-            pthread_spin_unlock(&port13->tx_targets[t].stats.lock);
+            dtn33_rx_pkts += snap->raw_tx[1][t].pkts;
+            dtn33_rx_bytes += snap->raw_tx[1][t].bytes;
         }
 
         uint64_t tx_delta = dtn33_tx_bytes - dtn_prev_tx_bytes[DTN_RAW_PORT_13];
@@ -255,9 +251,9 @@ static void helper_print_dtn_stats(const struct ports_config *ports_config,
     // DTN uyarılar
     bool has_warning = false;
     for (uint16_t dtn = 0; dtn < DTN_DPDK_PORT_COUNT; dtn++) {
-        uint64_t bad = rte_atomic64_read(&dtn_stats[dtn].bad_pkts);
-        uint64_t bit_err = rte_atomic64_read(&dtn_stats[dtn].bit_errors);
-        uint64_t lost = rte_atomic64_read(&dtn_stats[dtn].lost_pkts);
+        uint64_t bad = snap->dtn[dtn].bad_pkts;
+        uint64_t bit_err = snap->dtn[dtn].bit_errors;
+        uint64_t lost = snap->dtn[dtn].lost_pkts;
 
         if (bad > 0 || bit_err > 0 || lost > 0) {
             if (!has_warning) {
@@ -281,6 +277,7 @@ static void helper_print_dtn_stats(const struct ports_config *ports_config,
 // SERVER PORT-BASED STATISTICS TABLE (Eski tablo)
 // ==========================================
 static void helper_print_server_stats(const struct ports_config *ports_config,
+                                      const struct stats_snapshot *snap,
                                       const uint64_t prev_tx_bytes[],
                                       const uint64_t prev_rx_bytes[],
                                       bool warmup_complete, unsigned loop_count,
@@ -335,10 +332,11 @@ static void helper_print_server_stats(const struct ports_config *ports_config,
         double rx_gbps = to_gbps(rx_bytes_delta);
 
         // PRBS doğrulama istatistikleri
-        uint64_t good = rte_atomic64_read(&rx_stats_per_port[port_id].good_pkts);
-        uint64_t bad = rte_atomic64_read(&rx_stats_per_port[port_id].bad_pkts);
-        uint64_t lost = rte_atomic64_read(&rx_stats_per_port[port_id].lost_pkts);
-        uint64_t bit_errors = rte_atomic64_read(&rx_stats_per_port[port_id].bit_errors);
+        const struct stats_counters *prx = &snap->port_rx[port_id];
+        uint64_t good = prx->good_pkts;
+        uint64_t bad = prx->bad_pkts;
+        uint64_t lost = prx->lost_pkts;
+        uint64_t bit_errors = prx->bit_errors;
 
         // Bit Error Rate (BER) hesaplama
         double ber = 0.0;
@@ -362,9 +360,9 @@ static void helper_print_server_stats(const struct ports_config *ports_config,
     for (uint16_t i = 0; i < ports_config->nb_ports; i++) {
         uint16_t port_id = ports_config->ports[i].port_id;
 
-        uint64_t bad_pkts = rte_atomic64_read(&rx_stats_per_port[port_id].bad_pkts);
-        uint64_t bit_errors = rte_atomic64_read(&rx_stats_per_port[port_id].bit_errors);
-        uint64_t lost_pkts = rte_atomic64_read(&rx_stats_per_port[port_id].lost_pkts);
+        uint64_t bad_pkts = snap->port_rx[port_id].bad_pkts;
+        uint64_t bit_errors = snap->port_rx[port_id].bit_errors;
+        uint64_t lost_pkts = snap->port_rx[port_id].lost_pkts;
 
         if (bad_pkts > 0 || bit_errors > 0 || lost_pkts > 0) {
             if (!has_warning) {
@@ -402,15 +400,16 @@ static void helper_print_server_stats(const struct ports_config *ports_config,
 // STATS_MODE_DTN flag'ine göre DTN veya Server tablosunu çizer
 
 void helper_print_stats(const struct ports_config *ports_config,
+                        const struct stats_snapshot *snap,
                         const uint64_t prev_tx_bytes[], const uint64_t prev_rx_bytes[],
                         bool warmup_complete, unsigned loop_count, unsigned test_time)
 {
 #if STATS_MODE_DTN
-    helper_print_dtn_stats(ports_config, warmup_complete, loop_count, test_time);
+    helper_print_dtn_stats(ports_config, snap, warmup_complete, loop_count, test_time);
     (void)prev_tx_bytes;
     (void)prev_rx_bytes;
 #else
-    helper_print_server_stats(ports_config, prev_tx_bytes, prev_rx_bytes,
+    helper_print_server_stats(ports_config, snap, prev_tx_bytes, prev_rx_bytes,
                               warmup_complete, loop_count, test_time);
 #endif
 }
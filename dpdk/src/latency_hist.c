@@ -0,0 +1,406 @@
+#include "latency_hist.h"
+#include "vl_map.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <rte_cycles.h>
+#include <rte_malloc.h>
+#include <rte_spinlock.h>
+
+uint32_t lat_epoch = 0;
+
+// Kayıtlı queue'lar (yalnızca eklenir, process ömrü boyunca silinmez)
+static struct lat_queue *lat_queues[LAT_MAX_QUEUES];
+static uint32_t lat_nb_queues = 0;
+static rte_spinlock_t lat_reg_lock = RTE_SPINLOCK_INITIALIZER;
+
+static inline uint32_t lat_queue_count(void)
+{
+    return __atomic_load_n(&lat_nb_queues, __ATOMIC_ACQUIRE);
+}
+
+// Slot dizisi + VL → slot eşlemesi boş hale getirilir (create ve clear ortak)
+static void lat_queue_init_slots(struct lat_queue *q)
+{
+    memset(q->slot, 0, (size_t)LAT_HIST_VL_PER_QUEUE * sizeof(struct lat_vl_slot));
+    memset(q->slot_of, 0xFF, (size_t)q->vl_count * sizeof(uint16_t));
+    q->slot[0].vl_idx = LAT_SLOT_NONE;
+    __atomic_store_n(&q->invalid, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&q->nb_slots, 1, __ATOMIC_RELEASE);
+}
+
+struct lat_queue *lat_queue_create(uint16_t port_id, uint16_t queue_id,
+                                   uint16_t vl_count, int socket_id)
+{
+    struct lat_queue *q = NULL;
+
+    if (vl_count == 0)
+        return NULL;
+
+    rte_spinlock_lock(&lat_reg_lock);
+
+    // Worker yeniden başlatıldıysa mevcut histogramları döndür
+    for (uint32_t i = 0; i < lat_nb_queues; i++) {
+        struct lat_queue *e = lat_queues[i];
+        if (e->port_id == port_id && e->queue_id == queue_id && e->vl_count == vl_count) {
+            q = e;
+            goto out;
+        }
+    }
+
+    if (lat_nb_queues >= LAT_MAX_QUEUES) {
+        printf("Error: Latency histogram registry full (%u queues)\n", LAT_MAX_QUEUES);
+        goto out;
+    }
+
+    q = rte_zmalloc_socket("lat_queue", sizeof(*q), RTE_CACHE_LINE_SIZE, socket_id);
+    if (q == NULL)
+        goto out;
+
+    q->slot = rte_zmalloc_socket("lat_vl_slot",
+                                 (size_t)LAT_HIST_VL_PER_QUEUE * sizeof(struct lat_vl_slot),
+                                 RTE_CACHE_LINE_SIZE, socket_id);
+    q->slot_of = rte_zmalloc_socket("lat_slot_of", (size_t)vl_count * sizeof(uint16_t),
+                                    RTE_CACHE_LINE_SIZE, socket_id);
+    if (q->slot == NULL || q->slot_of == NULL) {
+        rte_free(q->slot);
+        rte_free(q->slot_of);
+        rte_free(q);
+        q = NULL;
+        goto out;
+    }
+
+    q->vl_count = vl_count;
+    q->port_id = port_id;
+    q->queue_id = queue_id;
+    q->dtn_port = 0xFFFF;
+    lat_queue_init_slots(q);
+    q->epoch = __atomic_load_n(&lat_epoch, __ATOMIC_ACQUIRE);
+
+    lat_queues[lat_nb_queues] = q;
+    __atomic_store_n(&lat_nb_queues, lat_nb_queues + 1, __ATOMIC_RELEASE);
+
+out:
+    rte_spinlock_unlock(&lat_reg_lock);
+    return q;
+}
+
+void lat_reset(void)
+{
+    __atomic_store_n(&lat_epoch, lat_epoch + 1, __ATOMIC_RELEASE);
+}
+
+void lat_queue_clear(struct lat_queue *q)
+{
+    // Epoch eşleşmediği sürece snapshot bu queue'yu okumaz
+    lat_queue_init_slots(q);
+    __atomic_store_n(&q->epoch, __atomic_load_n(&lat_epoch, __ATOMIC_ACQUIRE),
+                     __ATOMIC_RELEASE);
+}
+
+struct lat_vl_slot *lat_queue_assign(struct lat_queue *q, uint16_t vl_idx)
+{
+    const uint16_t n = q->nb_slots;
+
+    if (n >= LAT_HIST_VL_PER_QUEUE) {
+        q->slot_of[vl_idx] = 0;
+        return &q->slot[0];
+    }
+
+    q->slot[n].vl_idx = vl_idx;
+    q->slot_of[vl_idx] = n;
+    // nb_slots en son: okuyucu slot'u gördüyse vl_idx'i de görür
+    __atomic_store_n(&q->nb_slots, n + 1, __ATOMIC_RELEASE);
+    return &q->slot[n];
+}
+
+// ==========================================
+// HISTOGRAM MATH
+// ==========================================
+
+// Bucket'ın kapsadığı aralığın orta noktası (cycles)
+static double lat_bucket_mid(uint32_t idx)
+{
+    double low, width;
+
+    if (idx < LAT_HIST_SUB) {
+        low = (double)idx;
+        width = 1.0;
+    } else {
+        const uint32_t e = idx / LAT_HIST_SUB + LAT_HIST_SUB_BITS - 1;
+        low = (double)((uint64_t)(LAT_HIST_SUB + idx % LAT_HIST_SUB) << (e - LAT_HIST_SUB_BITS));
+        width = (double)(1ULL << (e - LAT_HIST_SUB_BITS));
+    }
+    return (low + width * 0.5) * (double)(1u << LAT_HIST_UNIT_SHIFT);
+}
+
+// Percentile (cycles), [min, max] ile sınırlı; count == 0 ise 0
+static double lat_hist_percentile(const struct lat_hist *h, uint64_t count, double pct)
+{
+    if (count == 0)
+        return 0.0;
+
+    uint64_t rank = (uint64_t)(pct * (double)count / 100.0 + 0.5);
+    if (rank == 0)
+        rank = 1;
+
+    uint64_t acc = 0;
+    double v = (double)h->max;
+    for (uint32_t i = 0; i < LAT_HIST_BUCKETS; i++) {
+        acc += h->bucket[i];
+        if (acc >= rank) {
+            v = lat_bucket_mid(i);
+            break;
+        }
+    }
+
+    if (v < (double)h->min)
+        v = (double)h->min;
+    if (v > (double)h->max)
+        v = (double)h->max;
+    return v;
+}
+
+void lat_hist_summarize(const struct lat_hist *h, struct lat_summary *out)
+{
+    const double ns_per_cycle = 1e9 / (double)rte_get_tsc_hz();
+    const uint64_t n = h->count;
+
+    memset(out, 0, sizeof(*out));
+    out->count = n;
+    if (n == 0)
+        return;
+
+    out->min_ns = (double)h->min * ns_per_cycle;
+    out->max_ns = (double)h->max * ns_per_cycle;
+    out->mean_ns = (double)h->sum / (double)n * ns_per_cycle;
+    out->p50_ns = lat_hist_percentile(h, n, 50.0) * ns_per_cycle;
+    out->p90_ns = lat_hist_percentile(h, n, 90.0) * ns_per_cycle;
+    out->p99_ns = lat_hist_percentile(h, n, 99.0) * ns_per_cycle;
+    out->p999_ns = lat_hist_percentile(h, n, 99.9) * ns_per_cycle;
+}
+
+// Başka worker'ın histogramını oku: önce count (acquire), sonra kalan alanlar
+void lat_hist_read(const struct lat_hist *src, struct lat_hist *dst)
+{
+    dst->count = __atomic_load_n(&src->count, __ATOMIC_ACQUIRE);
+    if (dst->count == 0) {
+        memset(dst, 0, sizeof(*dst));
+        return;
+    }
+    dst->sum = __atomic_load_n(&src->sum, __ATOMIC_RELAXED);
+    dst->min = __atomic_load_n(&src->min, __ATOMIC_RELAXED);
+    dst->max = __atomic_load_n(&src->max, __ATOMIC_RELAXED);
+    for (uint32_t i = 0; i < LAT_HIST_BUCKETS; i++)
+        dst->bucket[i] = __atomic_load_n(&src->bucket[i], __ATOMIC_RELAXED);
+}
+
+void lat_hist_merge(struct lat_hist *dst, const struct lat_hist *src)
+{
+    if (src->count == 0)
+        return;
+
+    if (dst->count == 0 || src->min < dst->min)
+        dst->min = src->min;
+    if (src->max > dst->max)
+        dst->max = src->max;
+    dst->count += src->count;
+    dst->sum += src->sum;
+    for (uint32_t i = 0; i < LAT_HIST_BUCKETS; i++)
+        dst->bucket[i] += src->bucket[i];
+}
+
+// ==========================================
+// SNAPSHOT (stats lcore)
+// ==========================================
+
+void lat_snapshot_take(struct lat_snapshot *snap)
+{
+    const uint32_t epoch = __atomic_load_n(&lat_epoch, __ATOMIC_ACQUIRE);
+    const uint32_t n = lat_queue_count();
+    // En kötü slot'lar: p99 (cycles) azalan, özet sonunda bir kez çıkarılır
+    const struct lat_queue *wq[LAT_TOP_VLS];
+    struct lat_hist wl[LAT_TOP_VLS], wj[LAT_TOP_VLS];
+    double wp99[LAT_TOP_VLS];
+    uint16_t wvl[LAT_TOP_VLS];
+    uint32_t nw = 0;
+    struct lat_hist lat, jit;
+
+    memset(snap, 0, sizeof(*snap));
+
+    for (uint32_t i = 0; i < n; i++) {
+        const struct lat_queue *q = lat_queues[i];
+        if (__atomic_load_n(&q->epoch, __ATOMIC_ACQUIRE) != epoch)
+            continue;
+
+        snap->invalid += __atomic_load_n(&q->invalid, __ATOMIC_RELAXED);
+
+        const uint16_t ns = __atomic_load_n(&q->nb_slots, __ATOMIC_ACQUIRE);
+        for (uint16_t s = 0; s < ns; s++) {
+            const struct lat_vl_slot *slot = &q->slot[s];
+
+            lat_hist_read(&slot->lat, &lat);
+            if (lat.count == 0)
+                continue;
+            lat_hist_read(&slot->jit, &jit);
+
+            if (q->port_id < MAX_PORTS) {
+                lat_hist_merge(&snap->port[q->port_id].lat, &lat);
+                lat_hist_merge(&snap->port[q->port_id].jit, &jit);
+            }
+#if STATS_MODE_DTN
+            if (q->dtn_port < DTN_PORT_COUNT) {
+                lat_hist_merge(&snap->dtn[q->dtn_port].lat, &lat);
+                lat_hist_merge(&snap->dtn[q->dtn_port].jit, &jit);
+            }
+#endif
+            // Slot 0 tek bir VL değil: sıralamaya girmez
+            if (s == 0)
+                continue;
+
+            const double p99 = lat_hist_percentile(&lat, lat.count, 99.0);
+            uint32_t pos = nw;
+            while (pos > 0 && wp99[pos - 1] < p99)
+                pos--;
+            if (pos >= LAT_TOP_VLS)
+                continue;
+
+            const uint32_t last = (nw < LAT_TOP_VLS) ? nw : LAT_TOP_VLS - 1;
+            for (uint32_t k = last; k > pos; k--) {
+                wq[k] = wq[k - 1];
+                wl[k] = wl[k - 1];
+                wj[k] = wj[k - 1];
+                wp99[k] = wp99[k - 1];
+                wvl[k] = wvl[k - 1];
+            }
+            wq[pos] = q;
+            wl[pos] = lat;
+            wj[pos] = jit;
+            wp99[pos] = p99;
+            wvl[pos] = slot->vl_idx;
+            if (nw < LAT_TOP_VLS)
+                nw++;
+        }
+    }
+
+    for (uint32_t k = 0; k < nw; k++) {
+        struct lat_worst_vl *w = &snap->worst[k];
+        w->port_id = wq[k]->port_id;
+        w->queue_id = wq[k]->queue_id;
+        w->vl_id = vl_map_vl_id(wvl[k]);
+        lat_hist_summarize(&wl[k], &w->lat);
+        lat_hist_summarize(&wj[k], &w->jit);
+    }
+    snap->nb_worst = nw;
+}
+
+// ==========================================
+// REPORT
+// ==========================================
+
+static void lat_print_header(const char *key)
+{
+    printf("  ┌────────┬──────────────┬──────────┬──────────┬──────────┬──────────┬──────────┬──────────┬──────────┬──────────┐\n");
+    printf("  │ %-6s │   Packets    │ Min (us) │ Avg (us) │ P50 (us) │ P99 (us) │P99.9(us) │ Max (us) │ J50 (us) │ J99 (us) │\n", key);
+    printf("  ├────────┼──────────────┼──────────┼──────────┼──────────┼──────────┼──────────┼──────────┼──────────┼──────────┤\n");
+}
+
+static void lat_print_footer(void)
+{
+    printf("  └────────┴──────────────┴──────────┴──────────┴──────────┴──────────┴──────────┴──────────┴──────────┴──────────┘\n");
+}
+
+static void lat_print_row(const char *label, const struct lat_summary *l,
+                          const struct lat_summary *j)
+{
+    printf("  │ %-6s │ %12lu │ %8.2f │ %8.2f │ %8.2f │ %8.2f │ %8.2f │ %8.2f │ %8.2f │ %8.2f │\n",
+           label, l->count, l->min_ns / 1000.0, l->mean_ns / 1000.0, l->p50_ns / 1000.0,
+           l->p99_ns / 1000.0, l->p999_ns / 1000.0, l->max_ns / 1000.0,
+           j->p50_ns / 1000.0, j->p99_ns / 1000.0);
+}
+
+void lat_print_stats(const struct lat_snapshot *snap)
+{
+    struct lat_summary l, j;
+    char label[16];
+
+    printf("\n  In-band Latency / Jitter (TX TSC → RX burst TSC, J = |Δlat| aynı VL):\n");
+#if STATS_MODE_DTN
+    lat_print_header("DTN");
+    for (uint16_t d = 0; d < DTN_PORT_COUNT; d++) {
+        if (snap->dtn[d].lat.count == 0)
+            continue;
+        lat_hist_summarize(&snap->dtn[d].lat, &l);
+        lat_hist_summarize(&snap->dtn[d].jit, &j);
+        snprintf(label, sizeof(label), "%u", d);
+        lat_print_row(label, &l, &j);
+    }
+#else
+    lat_print_header("Port");
+    for (uint16_t p = 0; p < MAX_PORTS; p++) {
+        if (snap->port[p].lat.count == 0)
+            continue;
+        lat_hist_summarize(&snap->port[p].lat, &l);
+        lat_hist_summarize(&snap->port[p].jit, &j);
+        snprintf(label, sizeof(label), "%u", p);
+        lat_print_row(label, &l, &j);
+    }
+#endif
+    lat_print_footer();
+
+    if (snap->nb_worst > 0) {
+        printf("  En yüksek P99 VL'ler:");
+        for (uint32_t k = 0; k < snap->nb_worst; k++) {
+            const struct lat_worst_vl *w = &snap->worst[k];
+            printf(" P%u/Q%u/VL%u=%.2fus", w->port_id, w->queue_id, w->vl_id,
+                   w->lat.p99_ns / 1000.0);
+        }
+        printf("\n");
+    }
+    if (snap->invalid > 0)
+        printf("  ⚠ Geçersiz TX TSC (rx < tx): %lu paket\n", snap->invalid);
+}
+
+void lat_print_vl_table(void)
+{
+    const uint32_t epoch = __atomic_load_n(&lat_epoch, __ATOMIC_ACQUIRE);
+    const uint32_t n = lat_queue_count();
+    struct lat_hist lat, jit;
+    struct lat_summary l, j;
+
+    printf("\n=== In-band Latency per VL ===\n");
+
+    for (uint32_t i = 0; i < n; i++) {
+        const struct lat_queue *q = lat_queues[i];
+        if (__atomic_load_n(&q->epoch, __ATOMIC_ACQUIRE) != epoch)
+            continue;
+
+        const uint16_t ns = __atomic_load_n(&q->nb_slots, __ATOMIC_ACQUIRE);
+        bool first = true;
+        for (uint16_t s = 1; s <= ns; s++) {
+            // Slot 0 ("diğer VL'ler") queue'nun son satırı
+            const struct lat_vl_slot *slot = &q->slot[s < ns ? s : 0];
+            char label[16];
+
+            lat_hist_read(&slot->lat, &lat);
+            if (lat.count == 0)
+                continue;
+            lat_hist_read(&slot->jit, &jit);
+
+            if (first) {
+                printf("\n  Port %u Queue %u (%u VL slot):\n", q->port_id, q->queue_id, ns - 1);
+                lat_print_header("VL-ID");
+                first = false;
+            }
+            if (s < ns)
+                snprintf(label, sizeof(label), "%u", vl_map_vl_id(slot->vl_idx));
+            else
+                snprintf(label, sizeof(label), "other");
+            lat_hist_summarize(&lat, &l);
+            lat_hist_summarize(&jit, &j);
+            lat_print_row(label, &l, &j);
+        }
+        if (!first)
+            lat_print_footer();
+    }
+}
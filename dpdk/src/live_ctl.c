@@ -0,0 +1,323 @@
+#include "live_ctl.h"
+#include "tx_live.h"
+#include "traffic_profile.h"
+#include "packet.h"         // imix_pattern
+#include "embedded_latency/embedded_latency.h"  // ate_mode_enabled()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#if LIVE_CTL_ENABLED
+
+static int ctl_fd = -1;
+
+// Cevap tamponu: komut başına doldurulur, stdout + (varsa) gönderene
+static char ctl_reply[LIVE_CTL_MAX_REPLY];
+static size_t ctl_reply_len;
+
+static void ctl_out(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+static void ctl_out(const char *fmt, ...)
+{
+    if (ctl_reply_len >= sizeof(ctl_reply) - 1)
+        return;
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(ctl_reply + ctl_reply_len, sizeof(ctl_reply) - ctl_reply_len, fmt, ap);
+    va_end(ap);
+    if (n > 0)
+        ctl_reply_len = RTE_MIN(ctl_reply_len + (size_t)n, sizeof(ctl_reply) - 1);
+}
+
+static const char *ctl_strerror(int ret)
+{
+    switch (ret) {
+    case -EINVAL:  return "invalid value";
+    case -ENOENT:  return "no TX worker on that port";
+    case -EBUSY:   return "previous change still pending, retry";
+    case -ENOTSUP: return "not supported in this build (token bucket / BAG / IMIX off)";
+    case -ENOMEM:  return "allocation failed";
+    default:       return strerror(-ret);
+    }
+}
+
+// ==========================================
+// COMMANDS
+// ==========================================
+
+static int ctl_parse_u16(const char *s, uint16_t *out)
+{
+    char *end;
+    errno = 0;
+    unsigned long v = strtoul(s, &end, 0);
+    if (errno != 0 || end == s || *end != '\0' || v > UINT16_MAX || *s == '-')
+        return -1;
+    *out = (uint16_t)v;
+    return 0;
+}
+
+static int ctl_parse_gbps(const char *s, double *out)
+{
+    char *end;
+    errno = 0;
+    double v = strtod(s, &end);
+    if (errno != 0 || end == s || *end != '\0')
+        return -1;
+    *out = v;
+    return 0;
+}
+
+static void ctl_cmd_rate(const char *port_s, const char *gbps_s)
+{
+    uint16_t port;
+    double gbps;
+    if (port_s == NULL || gbps_s == NULL ||
+        ctl_parse_u16(port_s, &port) != 0 || ctl_parse_gbps(gbps_s, &gbps) != 0) {
+        ctl_out("usage: rate <port> <gbps>\n");
+        return;
+    }
+    int ret = tx_live_set_rate(port, gbps);
+    if (ret < 0) {
+        ctl_out("rate port %u: %s\n", port, ctl_strerror(ret));
+        return;
+    }
+    // Profil rate'i yalnızca portun tüm queue'ları geçtiyse (tx_live_update
+    // hepsi ya da hiçbiri yayınlar; queue sayısı yine de doğrulanır)
+    const int queues = tx_live_port_queues(port);
+    if (ret != queues) {
+        ctl_out("rate port %u: %d of %d queues updated, profile rate unchanged\n",
+                port, ret, queues);
+        return;
+    }
+    traffic_port_rate_update(port, gbps);
+    ctl_out("rate port %u -> %.3f Gbps (%d queues)\n", port, gbps, ret);
+}
+
+static void ctl_cmd_vls(const char *port_s, const char *count_s)
+{
+    uint16_t port, count;
+    if (port_s == NULL || count_s == NULL ||
+        ctl_parse_u16(port_s, &port) != 0 || ctl_parse_u16(count_s, &count) != 0) {
+        ctl_out("usage: vls <port> <count>\n");
+        return;
+    }
+    int ret = tx_live_set_vls(port, count);
+    if (ret < 0) {
+        ctl_out("vls port %u: %s\n", port, ctl_strerror(ret));
+        return;
+    }
+    ctl_out("vls port %u -> %u per queue, clamped to VL range (%d queues)\n", port, count, ret);
+}
+
+static int ctl_parse_imix(char *list, uint16_t *pattern)
+{
+    int n = 0;
+    char *save = NULL;
+    for (char *tok = strtok_r(list, ",", &save); tok != NULL; tok = strtok_r(NULL, ",", &save)) {
+        if (n >= IMIX_PATTERN_SIZE || ctl_parse_u16(tok, &pattern[n]) != 0)
+            return -1;
+        n++;
+    }
+    return n == IMIX_PATTERN_SIZE ? 0 : -1;
+}
+
+static void ctl_apply_imix(const uint16_t *pattern)
+{
+    int ret = tx_live_set_imix(pattern);
+    if (ret < 0) {
+        ctl_out("imix: %s\n", ctl_strerror(ret));
+        return;
+    }
+    ctl_out("imix ->");
+    for (int i = 0; i < IMIX_PATTERN_SIZE; i++)
+        ctl_out(" %u", pattern[i]);
+    ctl_out(" (%d queues)\n", ret);
+}
+
+static void ctl_cmd_imix(char *list)
+{
+    uint16_t pattern[IMIX_PATTERN_SIZE];
+    if (list == NULL || ctl_parse_imix(list, pattern) != 0) {
+        ctl_out("usage: imix <%d comma separated sizes>\n", IMIX_PATTERN_SIZE);
+        return;
+    }
+    ctl_apply_imix(pattern);
+}
+
+static void ctl_cmd_reload(const char *path)
+{
+    static struct traffic_profile_live lp;     // Büyük yapı, stack yerine
+
+    if (path == NULL)
+        path = traffic_profile_path();
+    if (path == NULL) {
+        ctl_out("reload: no profile loaded at startup, give a path\n");
+        return;
+    }
+    if (traffic_profile_read_live(path, ate_mode_enabled(), &lp) != 0) {
+        ctl_out("reload %s: parse error (see console), nothing changed\n", path);
+        return;
+    }
+
+    ctl_out("reload %s\n", path);
+    if (lp.mode_mismatch)
+        ctl_out(" profile mode does not match the running mode, port sections ignored\n");
+    if (lp.imix_set)
+        ctl_apply_imix(lp.imix);
+    for (uint16_t p = 0; p < MAX_PORTS_CONFIG; p++) {
+        if (!lp.rate_set[p])
+            continue;
+        char port_s[8], gbps_s[32];
+        snprintf(port_s, sizeof(port_s), "%u", p);
+        snprintf(gbps_s, sizeof(gbps_s), "%.6f", lp.rate_gbps[p]);
+        ctl_cmd_rate(port_s, gbps_s);
+    }
+    if (lp.restart_needed)
+        ctl_out(" VLAN / VL map, raw and ext sections need a restart, not applied\n");
+}
+
+static void ctl_cmd_help(void)
+{
+    ctl_out("commands:\n"
+            "  status\n"
+            "  rate <port> <gbps>\n"
+            "  vls <port> <count>\n"
+            "  imix a,b,... (%d sizes)\n"
+            "  reload [path]\n", IMIX_PATTERN_SIZE);
+}
+
+static void ctl_dispatch(char *line)
+{
+    char *save = NULL;
+    char *cmd = strtok_r(line, " \t\r\n", &save);
+    char *a1 = strtok_r(NULL, " \t\r\n", &save);
+    char *a2 = strtok_r(NULL, " \t\r\n", &save);
+
+    if (cmd == NULL || strcmp(cmd, "help") == 0) {
+        ctl_cmd_help();
+    } else if (strcmp(cmd, "status") == 0) {
+        ctl_reply_len += tx_live_format_status(ctl_reply + ctl_reply_len,
+                                               sizeof(ctl_reply) - ctl_reply_len);
+    } else if (strcmp(cmd, "rate") == 0) {
+        ctl_cmd_rate(a1, a2);
+    } else if (strcmp(cmd, "vls") == 0) {
+        ctl_cmd_vls(a1, a2);
+    } else if (strcmp(cmd, "imix") == 0) {
+        ctl_cmd_imix(a1);
+    } else if (strcmp(cmd, "reload") == 0) {
+        ctl_cmd_reload(a1);
+    } else {
+        ctl_out("unknown command '%s' (try help)\n", cmd);
+    }
+}
+
+// ==========================================
+// SOCKET
+// ==========================================
+
+int live_ctl_init(void)
+{
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+
+    if (strlen(LIVE_CTL_SOCKET_PATH) >= sizeof(addr.sun_path)) {
+        printf("[LIVE] Socket path too long: %s\n", LIVE_CTL_SOCKET_PATH);
+        return -1;
+    }
+    strcpy(addr.sun_path, LIVE_CTL_SOCKET_PATH);
+
+    ctl_fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (ctl_fd < 0) {
+        printf("[LIVE] socket() failed: %s\n", strerror(errno));
+        return -1;
+    }
+
+    unlink(LIVE_CTL_SOCKET_PATH);   // Önceki çalışmadan kalan socket dosyası
+    if (bind(ctl_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        printf("[LIVE] bind(%s) failed: %s\n", LIVE_CTL_SOCKET_PATH, strerror(errno));
+        close(ctl_fd);
+        ctl_fd = -1;
+        return -1;
+    }
+
+    printf("[LIVE] Control socket: %s (rate / vls / imix / reload / status)\n",
+           LIVE_CTL_SOCKET_PATH);
+    return 0;
+}
+
+static void ctl_serve_one(void)
+{
+    char cmd[LIVE_CTL_MAX_CMD];
+    struct sockaddr_un peer;
+    socklen_t peer_len = sizeof(peer);
+
+    ssize_t n = recvfrom(ctl_fd, cmd, sizeof(cmd) - 1, 0, (struct sockaddr *)&peer, &peer_len);
+    if (n < 0)
+        return;
+    cmd[n] = '\0';
+
+    ctl_reply_len = 0;
+    ctl_reply[0] = '\0';
+    ctl_dispatch(cmd);
+
+    // Konsol kaydı (stats tablosunun arasında görünür)
+    for (const char *l = ctl_reply; *l != '\0'; ) {
+        const char *nl = strchr(l, '\n');
+        const int len = nl != NULL ? (int)(nl - l) : (int)strlen(l);
+        printf("[LIVE] %.*s\n", len, l);
+        l += len + (nl != NULL);
+    }
+    fflush(stdout);
+
+    // Adressiz (unbound) gönderene cevap gidemez
+    if (peer_len > sizeof(sa_family_t))
+        sendto(ctl_fd, ctl_reply, ctl_reply_len, MSG_DONTWAIT,
+               (struct sockaddr *)&peer, peer_len);
+}
+
+static uint64_t ctl_now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+void live_ctl_wait(unsigned int timeout_ms, volatile bool *stop_flag)
+{
+    if (ctl_fd < 0) {
+        usleep(timeout_ms * 1000);
+        return;
+    }
+
+    const uint64_t deadline = ctl_now_ms() + timeout_ms;
+    while (!*stop_flag) {
+        const uint64_t now = ctl_now_ms();
+        if (now >= deadline)
+            break;
+
+        struct pollfd pfd = { .fd = ctl_fd, .events = POLLIN };
+        int r = poll(&pfd, 1, (int)(deadline - now));
+        if (r < 0 && errno == EINTR)
+            break;                  // Ctrl+C: stats döngüsü stop_flag'i görsün
+        if (r > 0 && (pfd.revents & POLLIN))
+            ctl_serve_one();
+    }
+}
+
+void live_ctl_close(void)
+{
+    if (ctl_fd < 0)
+        return;
+    close(ctl_fd);
+    ctl_fd = -1;
+    unlink(LIVE_CTL_SOCKET_PATH);
+}
+
+#endif /* LIVE_CTL_ENABLED */
@@ -15,11 +15,18 @@
 #include "socket.h"
 #include "packet.h"
 #include "tx_rx_manager.h"
+#include "bag_sched.h"      // AFDX BAG conformance raporu
+#include "rx_bag.h"         // RX tarafı BAG / jitter analizörü
+#include "prbs_verify.h"    // SIMD PRBS verification kernel
 #include "raw_socket_port.h"  // Raw socket port support (non-DPDK NICs)
 #include "dpdk_external_tx.h" // DPDK External TX (independent system)
 #include "embedded_latency/embedded_latency.h"  // Embedded HW timestamp latency test
 #include "ptp_slave.h"        // PTP slave for IEEE 1588v2 synchronization
 #include "health_monitor.h"   // Health monitor for DTN status queries
+#include "traffic_profile.h"   // Runtime traffic profile (--profile <file>)
+#include "live_ctl.h"          // Canlı rate / VL / IMIX komutları (Unix socket)
+#include "rfc2544.h"           // RFC 2544 throughput search (RFC2544_ENABLED)
+#include "burst_test.h"        // Back-to-back burst capacity test (BURST_TEST_ENABLED)
 
 // Enable/disable raw socket ports
 #ifndef ENABLE_RAW_SOCKET_PORTS
@@ -52,6 +59,31 @@ static bool check_and_remove_daemon_flag(int *argc, char const *argv[]) {
     return found;
 }
 
+// Check for "--profile <file>" and remove it from argv (EAL bilmez)
+// Returns the file path, NULL if not given; *error set if the value is missing
+static const char *check_and_remove_profile_arg(int *argc, char const *argv[], bool *error) {
+    const char *path = NULL;
+    int new_argc = 0;
+
+    *error = false;
+    for (int i = 0; i < *argc; i++) {
+        if (strcmp(argv[i], "--profile") == 0) {
+            if (i + 1 >= *argc) {
+                *error = true;
+                break;
+            }
+            path = argv[++i];
+        } else {
+            argv[new_argc] = argv[i];
+            new_argc++;
+        }
+    }
+
+    if (!*error)
+        *argc = new_argc;
+    return path;
+}
+
 // force_quit ve signal_handler genelde helpers.h içinde deklarasyon/definasyona sahiptir.
 // Eğer sende helpers.h içinde yoksa, şu satırları açabilirsin:
 // volatile bool force_quit = false;
@@ -63,6 +95,14 @@ int main(int argc, char const *argv[])
     // so it doesn't confuse DPDK EAL argument parser
     bool daemon_mode = check_and_remove_daemon_flag(&argc, argv);
 
+    // --profile <file>: rate / VLAN / VL / IMIX tabloları (yoksa TRAFFIC_PROFILE_PATH)
+    bool profile_arg_error;
+    const char *profile_path = check_and_remove_profile_arg(&argc, argv, &profile_arg_error);
+    if (profile_arg_error) {
+        printf("Error: --profile requires a file path\n");
+        return 1;
+    }
+
     // Set daemon mode flag for helper functions (disables ANSI escape codes in logs)
     helper_set_daemon_mode(daemon_mode);
 
@@ -96,6 +136,12 @@ int main(int argc, char const *argv[])
 #endif
     printf("\n");
 
+    // Traffic profile: hatalı profil ile trafik başlatılmaz (interaktif testlerden önce)
+    if (traffic_profile_load(profile_path) != 0) {
+        printf("Error: traffic profile rejected, exiting\n");
+        return 1;
+    }
+
     // =========================================================================
     // EMBEDDED HW TIMESTAMP LATENCY TEST (runs BEFORE DPDK takes over NICs!)
     // Full sequence: Loopback (switch) + Unit Test (device) + Combined Results
@@ -191,6 +237,9 @@ int main(int argc, char const *argv[])
     }
 #endif
 
+    // Mod tabloları (normal / ATE) + profil: port rate'leri, port_vlans, ext TX hedefleri
+    traffic_profile_apply_ports(ate_mode_enabled());
+
     // Initialize DPDK EAL
     initialize_eal(argc, argv);
 
@@ -230,20 +279,28 @@ int main(int argc, char const *argv[])
     init_rx_stats();
 
 #if STATS_MODE_DTN
-    // Initialize DTN port mapping and statistics
+    // Initialize DTN port mapping (DTN istatistikleri RX shard'larından toplanır)
     init_dtn_port_map();
-    init_dtn_stats();
 #endif
 
     // *** PRBS-31 CACHE INITIALIZATION ***
     printf("\n=== Initializing PRBS-31 Cache ===\n");
-    printf("This will take a few minutes as we generate ~%u MB per port...\n",
-           (unsigned)(PRBS_CACHE_SIZE / (1024 * 1024)));
+    printf("Generating one shared ~%u MB sequence per NUMA node (per-port phase)...\n",
+           (unsigned)(PRBS_SEQ_BYTES / (1024 * 1024)));
 
     init_prbs_cache_for_all_ports((uint16_t)nb_ports, &ports_config);
+#if PRBS_GEN_BENCH_ENABLED
+    prbs_seq_gen_benchmark();
+#endif
 
     printf("PRBS-31 cache initialization complete!\n\n");
 
+    // RX doğrulama kernel'i (AVX-512/AVX2/scalar) CPU'ya göre seçilir
+    prbs_verify_init();
+#if PRBS_VERIFY_BENCH_ENABLED
+    prbs_verify_benchmark();
+#endif
+
     // Configure TX/RX for each port
     printf("\n=== Configuring Ports ===\n");
     struct txrx_config txrx_configs[MAX_PORTS];
@@ -320,10 +377,17 @@ int main(int argc, char const *argv[])
 
     printf("All ports configured\n");
 
+#if HDR_TEMPLATE_BENCH_ENABLED
+    // Header template mikrobenchmark (cycles/paket: eski builder vs template)
+    if (nb_ports > 0)
+        hdr_template_benchmark(txrx_configs[0].mbuf_pool, txrx_configs[0].port_id);
+#endif
+
 #if ENABLE_RAW_SOCKET_PORTS
     // *** RAW SOCKET PORTS INITIALIZATION ***
     // Load ATE or normal config before initializing ports
     raw_socket_ports_load_config(ate_mode_enabled());
+    traffic_profile_apply_raw(ate_mode_enabled());
 
     printf("\n=== Initializing Raw Socket Ports (Non-DPDK) ===\n");
     printf("These ports use AF_PACKET with zero-copy (PACKET_MMAP)\n");
@@ -350,11 +414,10 @@ int main(int argc, char const *argv[])
         printf("\n=== Initializing DPDK External TX System ===\n");
 
         // Gather mbuf pools for external TX ports
-        // Port order in ext_tx_configs: Port 2,3,4,5 (→P12), Port 0,6 (→P13)
-        static struct dpdk_ext_tx_port_config ext_configs[] = DPDK_EXT_TX_PORTS_CONFIG_INIT;
+        // Port order in dpdk_ext_tx_configs: Port 2,3,4,5 (→P12), Port 0,6 (→P13)
         struct rte_mempool *ext_mbuf_pools[DPDK_EXT_TX_PORT_COUNT];
         for (int i = 0; i < DPDK_EXT_TX_PORT_COUNT; i++) {
-            uint16_t port_id = ext_configs[i].port_id;
+            uint16_t port_id = dpdk_ext_tx_configs[i].port_id;
             if (port_id < nb_ports) {
                 ext_mbuf_pools[i] = txrx_configs[port_id].mbuf_pool;
                 printf("  Ext TX Port %u: mbuf_pool from txrx_configs[%u]\n", port_id, port_id);
@@ -380,13 +443,16 @@ int main(int argc, char const *argv[])
     printf("  RX cores per port: %d\n", NUM_RX_CORES);
     printf("  Expected TX workers: %d\n", nb_ports * NUM_TX_CORES);
     printf("  Expected RX workers: %d\n", nb_ports * NUM_RX_CORES);
-    printf("  PRBS-31 cache: Ready (~%.2f GB total)\n",
-           (nb_ports * PRBS_CACHE_SIZE) / (1024.0 * 1024.0 * 1024.0));
+    printf("  PRBS-31 cache: Ready (~%.2f GB per NUMA node, shared)\n",
+           PRBS_SEQ_BYTES / (1024.0 * 1024.0 * 1024.0));
     printf("  Payload per packet: %u bytes (SEQ: %u + PRBS: %u)\n",
            PAYLOAD_SIZE, SEQ_BYTES, NUM_PRBS_BYTES);
     printf("  Sequence Validation: ENABLED\n");
 #if LATENCY_TEST_ENABLED
     printf("  Latency Test: ENABLED (will run before normal mode)\n");
+#endif
+#if BURST_TEST_ENABLED
+    printf("  Burst Capacity Test: ENABLED (will run before normal mode)\n");
 #endif
     printf("\n");
 
@@ -417,6 +483,21 @@ int main(int argc, char const *argv[])
     printf("\n=== Latency test complete, starting normal TX/RX workers ===\n\n");
 #endif
 
+#if BURST_TEST_ENABLED
+    // *** BURST CAPACITY TEST - RUNS BEFORE NORMAL MODE ***
+    if (start_burst_test(&ports_config, &force_quit) < 0) {
+        printf("Warning: Burst capacity test failed, continuing with normal mode\n");
+    }
+
+    if (force_quit) {
+        printf("User interrupted during burst test, exiting...\n");
+        cleanup_prbs_cache();
+        cleanup_ports(&ports_config);
+        cleanup_eal();
+        return 0;
+    }
+#endif
+
     int start_ret = start_txrx_workers(&ports_config, &force_quit);
     if (start_ret < 0)
     {
@@ -538,6 +619,13 @@ int main(int argc, char const *argv[])
     }
 #endif
 
+#if RFC2544_ENABLED
+    // Kayıpsız en yüksek rate araması: worker'lar çalışırken rate canlı değişir
+    rfc2544_run(&ports_config, &force_quit);
+    if (RFC2544_EXIT_WHEN_DONE)
+        force_quit = true;
+#endif
+
     printf("\n=== Running (Press Ctrl+C to stop) ===\n");
     printf("⚙️  WARM-UP PHASE: First 60 seconds (stats will reset)\n\n");
 
@@ -545,6 +633,20 @@ int main(int argc, char const *argv[])
     static uint64_t prev_tx_bytes[MAX_PORTS] = {0};
     static uint64_t prev_rx_bytes[MAX_PORTS] = {0};
 
+    // Her saniye stats lcore'da (main) toplanan tüm worker sayaçları
+    static struct stats_snapshot stats_snap;
+#if INBAND_LATENCY_ENABLED
+    static struct lat_snapshot lat_snap;
+#endif
+#if RX_BAG_MONITOR_ENABLED
+    static struct rx_bag_snapshot bag_snap;
+#endif
+
+#if LIVE_CTL_ENABLED
+    // Restart olmadan rate / VL / IMIX değişikliği: stats döngüsü beklerken dinlenir
+    live_ctl_init();
+#endif
+
     // Main loop - print stats table every second
     uint32_t loop_count = 0;
     bool warmup_complete = false;
@@ -552,7 +654,11 @@ int main(int argc, char const *argv[])
 
     while (!force_quit)
     {
+#if LIVE_CTL_ENABLED
+        live_ctl_wait(1000, &force_quit);
+#else
         sleep(1);
+#endif
         loop_count++;
 
         // Warm-up tamamlanınca sıfırla
@@ -584,17 +690,44 @@ int main(int argc, char const *argv[])
             test_time++;
         }
 
+        // Queue'ya özel VL sequence tracker'larından lost/ooo/dup topla,
+        // ardından tüm worker shard'larını tek snapshot'ta birleştir
+        merge_rx_sequence_stats(false);
+        stats_snapshot_take(&stats_snap);
+
         // Büyük tablo + kuyruk dağılımları (includes DPDK External TX stats)
-        helper_print_stats(&ports_config, prev_tx_bytes, prev_rx_bytes,
+        helper_print_stats(&ports_config, &stats_snap, prev_tx_bytes, prev_rx_bytes,
                            warmup_complete, loop_count, test_time);
 
+#if INBAND_LATENCY_ENABLED
+        // Kayıp / BER tablosunun yanında: port (DTN) bazında latency + jitter
+        lat_snapshot_take(&lat_snap);
+        lat_print_stats(&lat_snap);
+#endif
+
+#if RX_BAG_MONITOR_ENABLED
+        // Alıcıda VL inter-arrival: BAG ihlali / jitter, DUT policing ile yan yana
+        rx_bag_snapshot_take(&bag_snap);
+        rx_bag_print_stats(&bag_snap);
+#endif
+
+#if TX_LCORE_STATS_ENABLED
+        // Lcore başına TX pps (NUM_TX_CORES boyutlandırması için)
+        print_tx_lcore_stats();
+#endif
+
+#if BAG_SCHED_ENABLED
+        // Worker başına BAG / jitter uygunluğu
+        bag_sched_print_stats();
+#endif
+
 #if ENABLE_RAW_SOCKET_PORTS
         // Print raw socket port stats (only if initialized)
         // DTN modunda raw socket tablosu ayrıca basılmaz, DTN tablosu yeterli
 #if !STATS_MODE_DTN
         if (raw_ports_initialized)
         {
-            print_raw_socket_stats();
+            print_raw_socket_stats(&stats_snap);
         }
 #endif
 #endif
@@ -622,6 +755,9 @@ int main(int argc, char const *argv[])
     }
 
     printf("\n=== Shutting down ===\n");
+#if LIVE_CTL_ENABLED
+    live_ctl_close();
+#endif
 
 #if PTP_ENABLED
     if (ptp_active) {
@@ -647,7 +783,8 @@ int main(int argc, char const *argv[])
     {
         printf("Stopping raw socket workers...\n");
         stop_raw_socket_workers();
-        print_raw_socket_stats();  // Final stats
+        stats_snapshot_take(&stats_snap);  // Worker'ların son yayınları dahil
+        print_raw_socket_stats(&stats_snap);  // Final stats
     }
 #endif
 
@@ -657,6 +794,27 @@ int main(int argc, char const *argv[])
     // Wait for all DPDK workers to stop
     rte_eal_mp_wait_lcore();
 
+    // Worker'lar durdu: ring'lerde bekleyen paket yok, watermark sonucu kesin
+    merge_rx_sequence_stats(true);
+
+#if INBAND_LATENCY_ENABLED
+    // Son histogramlar: port/DTN özeti + VL başına tam tablo
+    lat_snapshot_take(&lat_snap);
+    lat_print_stats(&lat_snap);
+    lat_print_vl_table();
+#endif
+
+#if BAG_SCHED_ENABLED
+    bag_sched_print_stats();
+    bag_sched_print_vl_report();
+#endif
+
+#if RX_BAG_MONITOR_ENABLED
+    rx_bag_snapshot_take(&bag_snap);
+    rx_bag_print_stats(&bag_snap);
+    rx_bag_print_vl_report();
+#endif
+
     // Cleanup
 #if PTP_ENABLED
     if (ptp_active)
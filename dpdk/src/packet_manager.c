@@ -6,65 +6,37 @@
 #include <stdlib.h>
 #include <rte_malloc.h>
 #include <rte_memcpy.h>
+#include <rte_cycles.h>
+#include <rte_lcore.h>
+#include <rte_eal.h>
+#include <rte_ethdev.h>
+#include <rte_memory.h>
 
 // Global PRBS cache for all ports
 struct prbs_cache port_prbs_cache[MAX_PRBS_CACHE_PORTS];
 
-/**
- * PRBS-31 next bit generator
- * Polynomial: x^31 + x^28 + 1
- * Taps at positions 31 and 28
- */
-static inline uint32_t prbs31_next(uint32_t *state)
-{
-    uint32_t output = *state & 0x01;
-    // XOR bit 0 and bit 3 (for 31 and 28 positions)
-    uint32_t new_bit = ((*state & 0x01) ^ ((*state >> 3) & 0x01)) & 0x01;
-    // Shift right and insert new bit at position 30
-    *state = (new_bit << 30 | (*state >> 1)) & 0x7FFFFFFF;
-    return output;
-}
+// IMIX pattern (traffic_profile.c profil yüklerken günceller)
+uint16_t imix_pattern[IMIX_PATTERN_SIZE] = IMIX_PATTERN_INIT;
+uint32_t imix_avg_packet_size = IMIX_AVG_PACKET_SIZE;
 
 /**
- * Fill buffer with PRBS-31 sequence
- * 
- * @param buffer Destination buffer
- * @param initial_state Initial PRBS-31 state (31-bit)
- */
-static void fill_buffer_with_prbs31(uint8_t *buffer, const uint32_t initial_state)
-{
-    uint32_t state = initial_state;
-    
-    printf("Generating PRBS-31 sequence (this may take a minute)...\n");
-    
-    for (size_t i = 0; i < PRBS_CACHE_SIZE; i++) {
-        buffer[i] = 0;
-        // Generate 8 bits per byte
-        for (int j = 0; j < 8; j++) {
-            buffer[i] = (buffer[i] << 1) | prbs31_next(&state);
-        }
-        
-        // Progress indicator every 10MB
-        if ((i % (10 * 1024 * 1024)) == 0 && i > 0) {
-            printf("  Generated %zu MB / %u MB (%.1f%%)\n", 
-                   i / (1024 * 1024), 
-                   (unsigned)(PRBS_CACHE_SIZE / (1024 * 1024)),
-                   (100.0 * i) / PRBS_CACHE_SIZE);
-        }
-    }
-    
-    printf("PRBS-31 generation complete!\n");
-}
-
-/**
- * Initialize PRBS cache for all ports
+ * Initialize PRBS windows for all ports
+ * Tek paylaşılan PRBS-31 dizisi üretilir (prbs_seq.c), her port kendi
+ * NUMA node'undaki replica'ya faz offset'iyle bakar.
  */
 void init_prbs_cache_for_all_ports(uint16_t nb_ports, const struct ports_config *ports)
 {
     printf("\n=== Initializing PRBS-31 Cache ===\n");
-    printf("Cache size per port: %u MB\n", (unsigned)(PRBS_CACHE_SIZE / (1024 * 1024)));
-    printf("Extended cache: +%u bytes for wraparound\n", NUM_PRBS_BYTES);
-    
+    printf("Window size per port: %u MB (shared sequence, per-port phase)\n",
+           (unsigned)(PRBS_CACHE_SIZE / (1024 * 1024)));
+    printf("Wraparound seam: %u bytes per port\n", 2 * PRBS_SEAM_HALF);
+
+    int home_socket = (ports && nb_ports > 0) ? ports->ports[0].numa_node : 0;
+    if (prbs_seq_init(home_socket) != 0) {
+        printf("Error: Shared PRBS sequence could not be initialized\n");
+        return;
+    }
+
     for (uint16_t port = 0; port < nb_ports && port < MAX_PRBS_CACHE_PORTS; port++) {
         printf("\nPort %u:\n", port);
         
@@ -77,94 +49,30 @@ void init_prbs_cache_for_all_ports(uint16_t nb_ports, const struct ports_config
         port_prbs_cache[port].socket_id = socket_id;
         
         // Unique initial state for each port (0x0000000F + port_id)
-        port_prbs_cache[port].initial_state = 0x0000000F + port;
+        port_prbs_cache[port].initial_state = prbs_seq_dpdk_state(port);
         
         printf("  NUMA socket: %d\n", socket_id);
         printf("  Initial PRBS state: 0x%08X\n", port_prbs_cache[port].initial_state);
         
-        // Allocate main cache on correct NUMA node
-        port_prbs_cache[port].cache = (uint8_t *)rte_malloc_socket(
-            NULL, 
-            PRBS_CACHE_SIZE, 
-            0, 
-            socket_id
-        );
-        
-        if (!port_prbs_cache[port].cache) {
-            printf("Error: Failed to allocate PRBS cache for port %u\n", port);
-            port_prbs_cache[port].initialized = false;
-            continue;
-        }
-        
-        // Allocate extended cache (main + extra bytes for wraparound)
-        size_t ext_size = (size_t)PRBS_CACHE_SIZE + (size_t)NUM_PRBS_BYTES;
-        port_prbs_cache[port].cache_ext = (uint8_t *)rte_malloc_socket(
-            NULL,
-            ext_size,
-            0,
-            socket_id
-        );
-        
-        if (!port_prbs_cache[port].cache_ext) {
-            printf("Error: Failed to allocate extended PRBS cache for port %u\n", port);
-            rte_free(port_prbs_cache[port].cache);
-            port_prbs_cache[port].cache = NULL;
+        if (prbs_window_init(&port_prbs_cache[port].win,
+                             port_prbs_cache[port].initial_state, socket_id) != 0) {
+            printf("Error: Failed to set up PRBS window for port %u\n", port);
             port_prbs_cache[port].initialized = false;
             continue;
         }
         
-        // Generate PRBS-31 sequence
-        fill_buffer_with_prbs31(port_prbs_cache[port].cache, 
-                                port_prbs_cache[port].initial_state);
-        
-        // Copy to extended cache (main + wraparound bytes)
-        rte_memcpy(port_prbs_cache[port].cache_ext, 
-                   port_prbs_cache[port].cache, 
-                   PRBS_CACHE_SIZE);
-        rte_memcpy(port_prbs_cache[port].cache_ext + PRBS_CACHE_SIZE,
-                   port_prbs_cache[port].cache,
-                   NUM_PRBS_BYTES);
-        
         port_prbs_cache[port].initialized = true;
 
+        printf("  Sequence phase: byte %u\n", port_prbs_cache[port].win.phase);
         printf("  Status: PRBS cache initialized successfully\n");
-
-        // Debug: İlk 4 iterasyonu göster
-        {
-            uint32_t debug_state = port_prbs_cache[port].initial_state;
-            printf("  First 4 iterations:\n");
-            for (int iter = 0; iter < 4; iter++) {
-                uint32_t state_before = debug_state;
-                uint32_t output = debug_state & 0x01;
-                uint32_t new_bit = ((debug_state & 0x01) ^ ((debug_state >> 3) & 0x01)) & 0x01;
-                debug_state = (new_bit << 30 | (debug_state >> 1)) & 0x7FFFFFFF;
-                printf("    [%d] state=0x%08X -> output=%u, new_bit=%u -> state=0x%08X\n",
-                       iter, state_before, output, new_bit, debug_state);
-            }
-        }
     }
     
-    printf("\nTotal PRBS cache memory: %.2f GB\n", 
-           (nb_ports * PRBS_CACHE_SIZE) / (1024.0 * 1024.0 * 1024.0));
+    printf("\nTotal PRBS cache memory: %.2f GB per NUMA node (shared by all ports)\n",
+           (double)PRBS_SEQ_BYTES / (1024.0 * 1024.0 * 1024.0));
     printf("PRBS cache initialization complete\n\n");
 }
 
-uint8_t* get_prbs_cache_for_port(uint16_t port_id)
-{
-    if (port_id >= MAX_PRBS_CACHE_PORTS) {
-        printf("Error: Invalid port_id %u for PRBS cache\n", port_id);
-        return NULL;
-    }
-    
-    if (!port_prbs_cache[port_id].initialized) {
-        printf("Error: PRBS cache not initialized for port %u\n", port_id);
-        return NULL;
-    }
-    
-    return port_prbs_cache[port_id].cache;
-}
-
-uint8_t* get_prbs_cache_ext_for_port(uint16_t port_id)
+const struct prbs_window *get_prbs_window_for_port(uint16_t port_id)
 {
     if (port_id >= MAX_PRBS_CACHE_PORTS) {
         printf("Error: Invalid port_id %u for PRBS cache\n", port_id);
@@ -176,7 +84,7 @@ uint8_t* get_prbs_cache_ext_for_port(uint16_t port_id)
         return NULL;
     }
     
-    return port_prbs_cache[port_id].cache_ext;
+    return &port_prbs_cache[port_id].win;
 }
 
 void fill_payload_with_prbs31_dynamic(struct rte_mbuf *mbuf, uint16_t port_id,
@@ -199,10 +107,6 @@ void fill_payload_with_prbs31_dynamic(struct rte_mbuf *mbuf, uint16_t port_id,
         return;
     }
 
-    if (unlikely(!port_prbs_cache[port_id].cache_ext)) {
-        printf("Error: PRBS cache_ext is NULL for port %u\n", port_id);
-        return;
-    }
 
     const uint32_t payload_offset = l2_len + sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr);
 
@@ -224,9 +128,9 @@ void fill_payload_with_prbs31_dynamic(struct rte_mbuf *mbuf, uint16_t port_id,
     // Bu sayede RX tarafı sequence'dan offset'i hesaplayabilir
     const uint64_t start_offset = (sequence_number * (uint64_t)MAX_PRBS_BYTES) % (uint64_t)PRBS_CACHE_SIZE;
 
-    // Use extended cache - sadece prbs_len kadar kopyala
+    // Pencere sonunu aşan kesit seam'den gelir - sadece prbs_len kadar kopyala
     rte_memcpy(prbs_ptr,
-               &port_prbs_cache[port_id].cache_ext[start_offset],
+               prbs_window_at(&port_prbs_cache[port_id].win, start_offset, prbs_len),
                prbs_len);
 }
 
@@ -236,19 +140,12 @@ void cleanup_prbs_cache(void)
     
     for (uint16_t port = 0; port < MAX_PRBS_CACHE_PORTS; port++) {
         if (port_prbs_cache[port].initialized) {
-            if (port_prbs_cache[port].cache) {
-                rte_free(port_prbs_cache[port].cache);
-                port_prbs_cache[port].cache = NULL;
-            }
-            
-            if (port_prbs_cache[port].cache_ext) {
-                rte_free(port_prbs_cache[port].cache_ext);
-                port_prbs_cache[port].cache_ext = NULL;
-            }
-            
+            prbs_window_free(&port_prbs_cache[port].win);
             port_prbs_cache[port].initialized = false;
         }
     }
+
+    prbs_seq_cleanup();
     
     printf("PRBS cache cleanup complete\n");
 }
@@ -412,15 +309,13 @@ int build_packet_mbuf(struct rte_mbuf *mbuf, const struct packet_config *config)
     return 0;
 }
 
-int build_packet_dynamic(struct rte_mbuf *mbuf, const struct packet_config *config,
-                          uint16_t packet_size)
+/**
+ * ETH(+VLAN)/IPv4/UDP header'larını pkt_data'ya yaz (payload'a dokunmaz)
+ * build_packet_dynamic ve header template'leri ortak kullanır.
+ */
+static void render_l2l4_header(uint8_t *pkt_data, const struct packet_config *config,
+                               uint16_t packet_size)
 {
-    if (!mbuf || !config) {
-        return -1;
-    }
-
-    uint8_t *pkt_data = rte_pktmbuf_mtod(mbuf, uint8_t *);
-
     // Payload boyutunu hesapla
 #if VLAN_ENABLED
     const uint16_t l2_len = ETH_HDR_SIZE + VLAN_HDR_SIZE;
@@ -479,6 +374,16 @@ int build_packet_dynamic(struct rte_mbuf *mbuf, const struct packet_config *conf
     udp->dst_port = rte_cpu_to_be_16(config->dst_port);
     udp->dgram_len = rte_cpu_to_be_16(UDP_HDR_SIZE + payload_size);
     udp->dgram_cksum = 0;  // UDP checksum disabled
+}
+
+int build_packet_dynamic(struct rte_mbuf *mbuf, const struct packet_config *config,
+                          uint16_t packet_size)
+{
+    if (!mbuf || !config) {
+        return -1;
+    }
+
+    render_l2l4_header(rte_pktmbuf_mtod(mbuf, uint8_t *), config, packet_size);
 
     // ==========================================
     // SET MBUF LENGTHS (dinamik)
@@ -489,6 +394,252 @@ int build_packet_dynamic(struct rte_mbuf *mbuf, const struct packet_config *conf
     return 0;
 }
 
+// ==========================================
+// PER-VL HEADER TEMPLATES
+// ==========================================
+
+int hdr_template_set_alloc(struct hdr_template_set *set, uint16_t vl_start,
+                           uint16_t vl_count, uint16_t l2_len,
+                           uint16_t tmpl_pkt_size, int socket_id)
+{
+    set->vl_start = vl_start;
+    set->vl_count = vl_count;
+    set->l2_len = l2_len;
+    set->tmpl_pkt_size = tmpl_pkt_size;
+    set->tmpl = rte_zmalloc_socket("hdr_templates",
+                                   (size_t)vl_count * sizeof(struct hdr_template),
+                                   RTE_CACHE_LINE_SIZE, socket_id);
+    if (!set->tmpl) {
+        printf("Error: Failed to allocate %u header templates on socket %d\n",
+               vl_count, socket_id);
+        return -1;
+    }
+    return 0;
+}
+
+void hdr_template_set_render(struct hdr_template_set *set,
+                             const struct packet_config *base_cfg)
+{
+    for (uint16_t i = 0; i < set->vl_count; i++) {
+        uint16_t vl_id = set->vl_start + i;
+        struct packet_config cfg = *base_cfg;
+
+        cfg.vl_id = vl_id;
+        cfg.dst_mac.addr_bytes[0] = 0x03;
+        cfg.dst_mac.addr_bytes[1] = 0x00;
+        cfg.dst_mac.addr_bytes[2] = 0x00;
+        cfg.dst_mac.addr_bytes[3] = 0x00;
+        cfg.dst_mac.addr_bytes[4] = (uint8_t)((vl_id >> 8) & 0xFF);
+        cfg.dst_mac.addr_bytes[5] = (uint8_t)(vl_id & 0xFF);
+        cfg.dst_ip = (uint32_t)((224U << 24) | (224U << 16) |
+                                ((uint32_t)((vl_id >> 8) & 0xFF) << 8) |
+                                (uint32_t)(vl_id & 0xFF));
+
+        memset(&set->tmpl[i], 0, sizeof(struct hdr_template));
+        render_l2l4_header(set->tmpl[i].bytes, &cfg, set->tmpl_pkt_size);
+    }
+}
+
+void hdr_template_set_free(struct hdr_template_set *set)
+{
+    if (set->tmpl) {
+        rte_free(set->tmpl);
+        set->tmpl = NULL;
+    }
+    set->vl_count = 0;
+}
+
+// ==========================================
+// ZERO-COPY PRBS CONTEXT
+// ==========================================
+
+// Son extbuf referansı bırakıldığında shared info'yu serbest bırak
+static void prbs_zc_shinfo_free_cb(void *addr, void *opaque)
+{
+    RTE_SET_USED(addr);
+    rte_free(opaque);
+}
+
+// IOVA-PA modunda port penceresini kapsayan her hugepage'in IOVA'sını çıkar
+// (seam'e düşen paketler zaten kopya yolundan gider)
+static int prbs_zc_build_page_table(struct prbs_zc_ctx *zc, int socket_id)
+{
+    const size_t win_size = (size_t)PRBS_CACHE_SIZE;
+    const struct rte_memseg *ms = rte_mem_virt2memseg(zc->win->base, NULL);
+
+    if (ms == NULL || ms->hugepage_sz == 0)
+        return -1;
+
+    zc->page_shift = (uint8_t)__builtin_ctzll(ms->hugepage_sz);
+    zc->page_base = RTE_ALIGN_FLOOR((uintptr_t)zc->win->base, (uintptr_t)ms->hugepage_sz);
+    zc->nb_pages = (uint32_t)((((uintptr_t)zc->win->base + win_size - 1 - zc->page_base)
+                               >> zc->page_shift) + 1);
+
+    zc->page_iova = rte_malloc_socket("prbs_zc_iova", zc->nb_pages * sizeof(rte_iova_t),
+                                      RTE_CACHE_LINE_SIZE, socket_id);
+    if (zc->page_iova == NULL)
+        return -1;
+
+    for (uint32_t i = 0; i < zc->nb_pages; i++) {
+        const void *va = (const void *)(zc->page_base + ((uintptr_t)i << zc->page_shift));
+        ms = rte_mem_virt2memseg(va, NULL);
+        if (ms == NULL || ms->iova == RTE_BAD_IOVA)
+            return -1;
+        zc->page_iova[i] = ms->iova + (rte_iova_t)((uintptr_t)va - (uintptr_t)ms->addr);
+    }
+    return 0;
+}
+
+int prbs_zc_init(struct prbs_zc_ctx *zc, uint16_t port_id, uint16_t queue_id,
+                 const struct prbs_window *win, int socket_id)
+{
+    struct rte_eth_dev_info dev_info;
+    char pool_name[32];
+
+    memset(zc, 0, sizeof(*zc));
+    zc->win = win;
+
+    if (rte_eth_dev_info_get(port_id, &dev_info) != 0 ||
+        !(dev_info.tx_offload_capa & RTE_ETH_TX_OFFLOAD_MULTI_SEGS)) {
+        printf("  Zero-copy PRBS: Port %u has no MULTI_SEGS TX offload, using copy\n", port_id);
+        return 0;
+    }
+
+    // NIC extbuf'a DMA yapar: pencere DPDK belleğinde olmalı (her iki IOVA
+    // modunda). prbs_seq_file_to_heap başarısızsa replica düz mmap kalır.
+    if (rte_mem_virt2memseg(win->base, NULL) == NULL ||
+        rte_mem_virt2memseg(win->base + PRBS_CACHE_SIZE - 1, NULL) == NULL) {
+        printf("  Zero-copy PRBS: Port %u Queue %u window not in DPDK memory, using copy\n",
+               port_id, queue_id);
+        return 0;
+    }
+
+    if (rte_eal_iova_mode() == RTE_IOVA_VA) {
+        zc->iova_va = true;
+    } else if (prbs_zc_build_page_table(zc, socket_id) != 0) {
+        printf("  Zero-copy PRBS: Port %u Queue %u IOVA lookup failed, using copy\n",
+               port_id, queue_id);
+        prbs_zc_free(zc);
+        zc->win = win;
+        return 0;
+    }
+
+    // Worker yeniden başlatılırsa aynı isimli havuz tekrar kullanılır
+    snprintf(pool_name, sizeof(pool_name), "zc_ext_%u_%u", port_id, queue_id);
+    zc->ext_pool = rte_mempool_lookup(pool_name);
+    if (zc->ext_pool == NULL)
+        zc->ext_pool = rte_pktmbuf_pool_create(pool_name, TX_ZEROCOPY_EXT_POOL_SIZE,
+                                               PRBS_ZC_POOL_CACHE, 0, 0, socket_id);
+
+    zc->shinfo = rte_zmalloc_socket("prbs_zc_shinfo", sizeof(*zc->shinfo),
+                                    RTE_CACHE_LINE_SIZE, socket_id);
+
+    if (zc->ext_pool == NULL || zc->shinfo == NULL) {
+        printf("Error: Zero-copy PRBS setup failed for Port %u Queue %u\n", port_id, queue_id);
+        rte_free(zc->shinfo);  // Henüz referans yok, doğrudan serbest bırak
+        zc->shinfo = NULL;
+        prbs_zc_free(zc);
+        return -1;
+    }
+
+    zc->shinfo->free_cb = prbs_zc_shinfo_free_cb;
+    zc->shinfo->fcb_opaque = zc->shinfo;
+    rte_mbuf_ext_refcnt_set(zc->shinfo, 1);  // Worker referansı
+    zc->enabled = true;
+
+    printf("  Zero-copy PRBS: Port %u Queue %u enabled (IOVA %s, %u ext mbufs)\n",
+           port_id, queue_id, zc->iova_va ? "VA" : "PA", TX_ZEROCOPY_EXT_POOL_SIZE);
+    return 0;
+}
+
+void prbs_zc_free(struct prbs_zc_ctx *zc)
+{
+    // NIC'te bekleyen extbuf segmentleri varsa shinfo son segmentle serbest kalır
+    if (zc->shinfo) {
+        if (rte_mbuf_ext_refcnt_update(zc->shinfo, -1) == 0)
+            rte_free(zc->shinfo);
+        zc->shinfo = NULL;
+    }
+    if (zc->page_iova) {
+        rte_free(zc->page_iova);
+        zc->page_iova = NULL;
+    }
+    // ext_pool serbest bırakılmaz: TX ring'deki segmentler hâlâ ona dönecek
+    zc->enabled = false;
+}
+
+#if HDR_TEMPLATE_BENCH_ENABLED
+#define HDR_BENCH_ITERATIONS 1000000
+#define HDR_BENCH_VL_COUNT   128
+
+void hdr_template_benchmark(struct rte_mempool *mbuf_pool, uint16_t port_id)
+{
+    const struct prbs_window *prbs = get_prbs_window_for_port(port_id);
+    struct rte_mbuf *m = rte_pktmbuf_alloc(mbuf_pool);
+    if (!prbs || !m) {
+        printf("[HDR BENCH] Skipped: PRBS cache or mbuf not available (port %u)\n", port_id);
+        if (m)
+            rte_pktmbuf_free(m);
+        return;
+    }
+
+    struct packet_config base;
+    init_packet_config(&base);
+    const uint16_t vl_start = 1027;
+
+    struct hdr_template_set set;
+    if (hdr_template_set_alloc(&set, vl_start, HDR_BENCH_VL_COUNT, L2_HEADER_SIZE,
+                               PACKET_SIZE, rte_socket_id()) != 0) {
+        rte_pktmbuf_free(m);
+        return;
+    }
+    hdr_template_set_render(&set, &base);
+
+    // 1) Eski yol: config kopyası + build_packet_mbuf (tam header + memset) + PRBS
+    uint64_t t0 = rte_rdtsc();
+    for (uint32_t i = 0; i < HDR_BENCH_ITERATIONS; i++) {
+        uint16_t vl = vl_start + (i % HDR_BENCH_VL_COUNT);
+        struct packet_config cfg = base;
+        cfg.vl_id = vl;
+        cfg.dst_mac.addr_bytes[4] = (uint8_t)(vl >> 8);
+        cfg.dst_mac.addr_bytes[5] = (uint8_t)(vl & 0xFF);
+        cfg.dst_ip = (224U << 24) | (224U << 16) | vl;
+        build_packet_mbuf(m, &cfg);
+        fill_payload_with_prbs31(m, port_id, i, L2_HEADER_SIZE);
+    }
+    uint64_t legacy_cycles = rte_rdtsc() - t0;
+
+    // 2) Template yolu: 64 byte stamp + PRBS
+    t0 = rte_rdtsc();
+    for (uint32_t i = 0; i < HDR_BENCH_ITERATIONS; i++) {
+        uint16_t vl = vl_start + (i % HDR_BENCH_VL_COUNT);
+        hdr_template_stamp(m, &set, hdr_template_get(&set, vl), i, PACKET_SIZE);
+        fill_prbs_after_template(m, prbs, L2_HEADER_SIZE, i, NUM_PRBS_BYTES);
+    }
+    uint64_t tmpl_cycles = rte_rdtsc() - t0;
+
+    // 3) Sadece header: PRBS kopyası hariç
+    t0 = rte_rdtsc();
+    for (uint32_t i = 0; i < HDR_BENCH_ITERATIONS; i++) {
+        uint16_t vl = vl_start + (i % HDR_BENCH_VL_COUNT);
+        hdr_template_stamp(m, &set, hdr_template_get(&set, vl), i, PACKET_SIZE);
+    }
+    uint64_t stamp_cycles = rte_rdtsc() - t0;
+
+    printf("\n=== Header Template Microbenchmark (Port %u, %u pkts) ===\n",
+           port_id, HDR_BENCH_ITERATIONS);
+    printf("  build_packet_mbuf + PRBS : %8.1f cycles/pkt\n",
+           (double)legacy_cycles / HDR_BENCH_ITERATIONS);
+    printf("  template stamp + PRBS    : %8.1f cycles/pkt\n",
+           (double)tmpl_cycles / HDR_BENCH_ITERATIONS);
+    printf("  template stamp only      : %8.1f cycles/pkt\n",
+           (double)stamp_cycles / HDR_BENCH_ITERATIONS);
+
+    hdr_template_set_free(&set);
+    rte_pktmbuf_free(m);
+}
+#endif /* HDR_TEMPLATE_BENCH_ENABLED */
+
 uint16_t calculate_ip_checksum(struct rte_ipv4_hdr *ip)
 {
     uint32_t sum = 0;
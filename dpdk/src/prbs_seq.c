@@ -0,0 +1,997 @@
+#include "prbs_seq.h"
+#include "packet.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/vfs.h>
+#include <sys/syscall.h>
+#include <linux/magic.h>
+#include <linux/mempolicy.h>
+#include <rte_malloc.h>
+#include <rte_memcpy.h>
+#include <rte_cycles.h>
+#include <rte_lcore.h>
+#include <rte_launch.h>
+
+// Faz tablosu: bilinen her seed'in paylaşılan dizideki byte index'i
+#define PRBS_SEQ_NB_STATES (MAX_PRBS_CACHE_PORTS + MAX_RAW_SOCKET_PORTS)
+
+// Referans: DPDK port 0 akışı paylaşılan dizinin byte 0'ından başlar
+#define PRBS_SEQ_REF_STATE 0x0000000F
+
+struct prbs_seq_phase {
+    uint32_t state;
+    uint32_t phase;
+    bool found;
+};
+
+static struct prbs_seq_phase prbs_seq_phases[PRBS_SEQ_NB_STATES];
+static uint32_t prbs_seq_nb_phases = 0;
+
+/**
+ * NUMA node başına replica
+ * map != NULL → kalıcı dosyanın mmap'i (munmap), aksi halde rte_malloc (rte_free).
+ */
+struct prbs_seq_replica {
+    uint8_t *data;
+    void *map;
+    size_t map_len;
+};
+
+static struct prbs_seq_replica prbs_seq_replicas[RTE_MAX_NUMA_NODES];
+static int prbs_seq_home_socket = -1;
+static size_t prbs_seq_len = 0;          // PRBS_SEQ_BYTES + en sondaki pencerenin taşması
+
+static uint8_t prbs_seq_bitrev[256];
+
+/**
+ * Sağa kaydırmalı LFSR'ı 8 bit ilerlet
+ * State bit i = sıradaki i. çıkış biti; yeni 8 bit o[k+31+j] = o[k+j] ^ o[k+3+j]
+ * hepsi mevcut state'ten hesaplanır (j + 3 < 31).
+ */
+static inline uint32_t prbs_seq_step8(uint32_t s)
+{
+    uint32_t nb = (s ^ (s >> 3)) & 0xFF;
+    return (s >> 8) | (nb << 23);
+}
+
+// Byte'a MSB-first paketle (eski fill_buffer_with_prbs31 ile aynı bit sırası)
+static inline uint8_t prbs_seq_byte(uint32_t s)
+{
+    return prbs_seq_bitrev[s & 0xFF];
+}
+
+static void prbs_seq_init_bitrev(void)
+{
+    for (uint32_t i = 0; i < 256; i++) {
+        uint8_t r = 0;
+        for (int b = 0; b < 8; b++)
+            r |= (uint8_t)(((i >> b) & 1) << (7 - b));
+        prbs_seq_bitrev[i] = r;
+    }
+}
+
+uint32_t prbs_seq_raw_state(uint16_t raw_port_id)
+{
+    // init_raw_prbs_cache'teki LFSR: bit = s[30] ^ s[27], s = (s << 1) | bit
+    uint32_t s = 0x0000000F + raw_port_id + 100;
+    uint32_t out = 0;
+
+    for (int i = 0; i < 31; i++) {
+        uint32_t bit = ((s >> 30) ^ (s >> 27)) & 1;
+        s = ((s << 1) | bit) & 0x7FFFFFFF;
+        out |= bit << i;
+    }
+    return out;
+}
+
+// ==========================================
+// GF(2) JUMP-AHEAD
+// ==========================================
+// Tek bit adımı lineer bir 31x31 GF(2) dönüşümüdür. col[i] = A(e_i) olarak
+// saklanır; M^(2^k) tablosu ile herhangi bir n için state'e n adım sonrası
+// en fazla 31 matris-vektör çarpımıyla hesaplanır.
+
+struct prbs_gf2_mat {
+    uint32_t col[31];
+};
+
+static struct prbs_gf2_mat prbs_jump_pow2[31];  // M^(2^k), k = 0..30
+static bool prbs_jump_ready = false;
+
+// RX jump tablosu: byte offset'in c. 4-bit hanesi v için A = M^(8 × v × 16^c),
+// state'in 4-bit dilimleriyle önceden çarpılmış: slice[c][v][n][u] = A(u << 4n).
+// Matris-vektör çarpımı 8 bağımsız okuma + XOR; off < 2^28 → 7 çarpım.
+// 7 × 16 × 8 × 16 × 4 B = 56 KB, tüm portlar için ortak (L2'de kalır).
+#define PRBS_JUMP_NIBBLES 7
+static uint32_t prbs_jump_slice[PRBS_JUMP_NIBBLES][16][8][16];
+
+static inline uint32_t prbs_gf2_apply(const struct prbs_gf2_mat *a, uint32_t x)
+{
+    uint32_t r = 0;
+    while (x) {
+        r ^= a->col[__builtin_ctz(x)];
+        x &= x - 1;
+    }
+    return r;
+}
+
+static void prbs_jump_init(void)
+{
+    if (prbs_jump_ready)
+        return;
+
+    // M: tek bit adımı (s >> 1, yeni bit = s[0] ^ s[3] → bit 30)
+    for (int i = 0; i < 31; i++) {
+        uint32_t e = 1u << i;
+        prbs_jump_pow2[0].col[i] = (e >> 1) | (((e ^ (e >> 3)) & 1) << 30);
+    }
+    for (int k = 1; k < 31; k++)
+        for (int i = 0; i < 31; i++)
+            prbs_jump_pow2[k].col[i] = prbs_gf2_apply(&prbs_jump_pow2[k - 1],
+                                                      prbs_jump_pow2[k - 1].col[i]);
+    prbs_jump_ready = true;
+
+    for (int c = 0; c < PRBS_JUMP_NIBBLES; c++) {
+        for (uint64_t v = 0; v < 16; v++) {
+            struct prbs_gf2_mat a;
+            for (int i = 0; i < 31; i++)
+                a.col[i] = prbs_seq_jump(1u << i, 8 * (v << (4 * c)));
+            for (int n = 0; n < 8; n++)
+                for (uint32_t u = 0; u < 16; u++)
+                    prbs_jump_slice[c][v][n][u] = prbs_gf2_apply(&a, (u << (4 * n)) & 0x7FFFFFFF);
+        }
+    }
+}
+
+uint32_t prbs_seq_jump(uint32_t state, uint64_t nbits)
+{
+    prbs_jump_init();
+
+    nbits %= PRBS31_PERIOD;
+    for (int k = 0; nbits != 0; k++, nbits >>= 1)
+        if (nbits & 1)
+            state = prbs_gf2_apply(&prbs_jump_pow2[k], state);
+    return state;
+}
+
+uint32_t prbs_seq_state_at(uint32_t state, uint32_t byte_off)
+{
+    byte_off &= PRBS_CACHE_MASK;  // Tablo sınırı (7 hane)
+    for (int c = 0; c < PRBS_JUMP_NIBBLES; c++, byte_off >>= 4) {
+        const uint32_t (*t)[16] = prbs_jump_slice[c][byte_off & 0xF];
+        state = t[0][state & 0xF] ^ t[1][(state >> 4) & 0xF] ^
+                t[2][(state >> 8) & 0xF] ^ t[3][(state >> 12) & 0xF] ^
+                t[4][(state >> 16) & 0xF] ^ t[5][(state >> 20) & 0xF] ^
+                t[6][(state >> 24) & 0xF] ^ t[7][state >> 28];
+    }
+    return state;
+}
+
+// ==========================================
+// WORD-PARALLEL GENERATOR
+// ==========================================
+// Çıkış MSB-first 64-bit kelimeler olarak üretilir (big-endian yazılınca
+// byte sırası eski cache ile aynı). o[m] = o[m-31] ^ o[m-28] reküransının
+// iki kez karesi alınırsa o[m] = o[m-124] ^ o[m-112] olur; yani önceki iki
+// kelimeden sıradaki 64 bit tek adımda çıkar:
+//   w[k+2] = (w[k] << 4 | w[k+1] >> 60) ^ (w[k] << 16 | w[k+1] >> 48)
+
+static void prbs_seq_fill_words(uint8_t *dst, size_t len, uint32_t state)
+{
+    uint64_t w0 = 0, w1 = 0;
+    size_t i = 0;
+
+    // İlk 16 byte: 8-bit adımlarla (kelime geçmişi için)
+    for (; i < 16 && i < len; i++) {
+        dst[i] = prbs_seq_byte(state);
+        state = prbs_seq_step8(state);
+    }
+    if (len < 16)
+        return;
+
+    for (int b = 0; b < 8; b++) {
+        w0 = (w0 << 8) | dst[b];
+        w1 = (w1 << 8) | dst[8 + b];
+    }
+
+    for (; i + 8 <= len; i += 8) {
+        uint64_t w2 = ((w0 << 4) | (w1 >> 60)) ^ ((w0 << 16) | (w1 >> 48));
+        uint64_t be = __builtin_bswap64(w2);
+        memcpy(dst + i, &be, 8);
+        w0 = w1;
+        w1 = w2;
+    }
+
+    if (i < len) {
+        uint64_t w2 = ((w0 << 4) | (w1 >> 60)) ^ ((w0 << 16) | (w1 >> 48));
+        for (int b = 0; i < len; i++, b++)
+            dst[i] = (uint8_t)(w2 >> (56 - 8 * b));
+    }
+}
+
+// ==========================================
+// LCORE-PARALLEL JOBS
+// ==========================================
+// Dizi lcore sayısı kadar parçaya bölünür; her parçanın başlangıç state'i
+// jump-ahead ile hesaplanır (ref state + 8 × başlangıç byte'ı bit adımı).
+// Startup'ta worker lcore'lar henüz boşta; meşgul lcore'un işini main yapar.
+
+#define PRBS_SEQ_JOB_ALIGN 4096
+
+enum prbs_seq_job_op {
+    PRBS_SEQ_JOB_FILL,       // buf'a diziyi üret
+    PRBS_SEQ_JOB_SCAN,       // Faz taraması
+    PRBS_SEQ_JOB_SUM,        // buf üzerinde checksum (kalıcı dosya doğrulaması)
+};
+
+struct prbs_seq_job {
+    uint64_t start;          // Byte index
+    uint64_t len;
+    uint32_t state;          // start'taki state
+    enum prbs_seq_job_op op;
+    uint8_t *buf;            // FILL: hedef, SUM: kaynak (parçanın başı)
+    uint64_t sum;            // SUM sonucu
+    uint32_t found[PRBS_SEQ_NB_STATES];  // Tarama sonucu (UINT32_MAX = yok)
+} __rte_cache_aligned;
+
+static struct prbs_seq_job prbs_seq_jobs[RTE_MAX_LCORE];
+
+/**
+ * Parçadaki her byte index'teki state'i seed tablosuyla karşılaştır
+ * 8, T ile aralarında asal → T byte adımı tüm bit fazlarını tam bir kez gezer.
+ * Düşük 16 bit üzerinden bitmap filtresi: byte başına tek L1 erişimi.
+ */
+static void prbs_seq_scan_chunk(struct prbs_seq_job *job, const uint64_t *filter)
+{
+    uint32_t s = job->state;
+
+    for (uint64_t j = 0; j < job->len; j++) {
+        uint32_t lo = s & 0xFFFF;
+        if (unlikely((filter[lo >> 6] >> (lo & 63)) & 1)) {
+            for (uint32_t i = 0; i < prbs_seq_nb_phases; i++)
+                if (prbs_seq_phases[i].state == s && job->found[i] == UINT32_MAX)
+                    job->found[i] = (uint32_t)(job->start + j);
+        }
+        s = prbs_seq_step8(s);
+    }
+}
+
+static uint64_t prbs_seq_filter[65536 / 64];
+
+/**
+ * Konum ağırlıklı checksum: Σ w[i] × (2i + 1) mod 2^64
+ * w[i] = buf'taki i. 64-bit kelime (little-endian), kuyruk byte'ları byte
+ * index'iyle ağırlıklanır. Terimler mutlak konuma bağlı olduğundan parçaların
+ * toplamı tüm tamponunkiyle aynıdır; kaymış/yer değiştirmiş bloklar yakalanır.
+ * start 8'in katı olmalı.
+ */
+static uint64_t prbs_seq_sum_chunk(const uint8_t *buf, uint64_t start, uint64_t len)
+{
+    uint64_t sum = 0;
+    uint64_t i = 0;
+
+    for (; i + 8 <= len; i += 8) {
+        uint64_t w;
+        memcpy(&w, buf + i, 8);
+        sum += w * (2 * ((start + i) >> 3) + 1);
+    }
+    for (; i < len; i++)
+        sum += (uint64_t)buf[i] * (2 * (start + i) + 1);
+    return sum;
+}
+
+static int prbs_seq_job_main(void *arg)
+{
+    struct prbs_seq_job *job = arg;
+
+    switch (job->op) {
+    case PRBS_SEQ_JOB_FILL:
+        prbs_seq_fill_words(job->buf, job->len, job->state);
+        break;
+    case PRBS_SEQ_JOB_SCAN:
+        prbs_seq_scan_chunk(job, prbs_seq_filter);
+        break;
+    case PRBS_SEQ_JOB_SUM:
+        job->sum = prbs_seq_sum_chunk(job->buf, job->start, job->len);
+        break;
+    }
+    return 0;
+}
+
+/**
+ * [0, len) byte aralığını socket_id'deki boş lcore'lara böl ve op'u çalıştır
+ * SCAN için buf NULL olmalı.
+ * @return kullanılan lcore sayısı (main dahil)
+ */
+static unsigned prbs_seq_run_jobs(enum prbs_seq_job_op op, uint8_t *buf, uint64_t len,
+                                  int socket_id)
+{
+    unsigned lcores[RTE_MAX_LCORE];
+    unsigned nb = 0;
+    unsigned lcore_id;
+    const unsigned max_workers = PRBS_GEN_MAX_LCORES > 0 ? PRBS_GEN_MAX_LCORES - 1 : RTE_MAX_LCORE;
+
+    RTE_LCORE_FOREACH_WORKER(lcore_id) {
+        if (socket_id >= 0 && (int)rte_lcore_to_socket_id(lcore_id) != socket_id)
+            continue;
+        if (nb >= max_workers)
+            break;
+        lcores[nb++] = lcore_id;
+    }
+
+    const unsigned nb_jobs = nb + 1;  // + main lcore
+    uint64_t chunk = (len + nb_jobs - 1) / nb_jobs;
+    chunk = (chunk + PRBS_SEQ_JOB_ALIGN - 1) & ~(uint64_t)(PRBS_SEQ_JOB_ALIGN - 1);
+
+    for (unsigned j = 0; j < nb_jobs; j++) {
+        struct prbs_seq_job *job = &prbs_seq_jobs[j];
+        job->start = (uint64_t)j * chunk;
+        job->len = job->start >= len ? 0 : RTE_MIN(chunk, len - job->start);
+        job->state = op == PRBS_SEQ_JOB_SUM ? 0 : prbs_seq_jump(PRBS_SEQ_REF_STATE, job->start * 8);
+        job->op = op;
+        job->buf = buf ? buf + job->start : NULL;
+        job->sum = 0;
+        memset(job->found, 0xFF, sizeof(job->found));
+    }
+
+    bool launched[RTE_MAX_LCORE] = { false };
+    for (unsigned j = 1; j < nb_jobs; j++)
+        launched[j] = rte_eal_remote_launch(prbs_seq_job_main, &prbs_seq_jobs[j],
+                                            lcores[j - 1]) == 0;
+
+    prbs_seq_job_main(&prbs_seq_jobs[0]);
+    for (unsigned j = 1; j < nb_jobs; j++) {
+        if (launched[j])
+            rte_eal_wait_lcore(lcores[j - 1]);
+        else
+            prbs_seq_job_main(&prbs_seq_jobs[j]);  // lcore meşgul: main yapar
+    }
+    return nb_jobs;
+}
+
+static void prbs_seq_scan_phases(int socket_id)
+{
+    memset(prbs_seq_filter, 0, sizeof(prbs_seq_filter));
+    for (uint32_t i = 0; i < prbs_seq_nb_phases; i++) {
+        uint32_t lo = prbs_seq_phases[i].state & 0xFFFF;
+        prbs_seq_filter[lo >> 6] |= 1ULL << (lo & 63);
+    }
+
+    unsigned nb_jobs = prbs_seq_run_jobs(PRBS_SEQ_JOB_SCAN, NULL, PRBS_SEQ_BYTES, socket_id);
+
+    // Parçalar artan sırada: ilk bulunan = en küçük index
+    for (uint32_t i = 0; i < prbs_seq_nb_phases; i++) {
+        for (unsigned j = 0; j < nb_jobs; j++) {
+            if (prbs_seq_jobs[j].found[i] != UINT32_MAX) {
+                prbs_seq_phases[i].phase = prbs_seq_jobs[j].found[i];
+                prbs_seq_phases[i].found = true;
+                break;
+            }
+        }
+    }
+}
+
+static void prbs_seq_add_state(uint32_t state)
+{
+    for (uint32_t i = 0; i < prbs_seq_nb_phases; i++)
+        if (prbs_seq_phases[i].state == state)
+            return;
+
+    prbs_seq_phases[prbs_seq_nb_phases].state = state;
+    prbs_seq_phases[prbs_seq_nb_phases].found = false;
+    prbs_seq_nb_phases++;
+}
+
+/**
+ * socket_id üzerinde rte_malloc replica'sı
+ * src NULL → dizi lcore'larda üretilir, aksi halde src'den kopyalanır.
+ * @return kullanılan lcore sayısı, 0 = allocation failure
+ */
+static unsigned prbs_seq_replica_malloc(int socket_id, const uint8_t *src,
+                                        struct prbs_seq_replica *r)
+{
+    uint8_t *buf = rte_malloc_socket("prbs_seq_replica", prbs_seq_len,
+                                     RTE_CACHE_LINE_SIZE, socket_id);
+    if (buf == NULL)
+        return 0;
+
+    unsigned nb_lcores = 1;
+    if (src)
+        rte_memcpy(buf, src, prbs_seq_len);
+    else
+        nb_lcores = prbs_seq_run_jobs(PRBS_SEQ_JOB_FILL, buf, prbs_seq_len, socket_id);
+
+    r->data = buf;
+    r->map = NULL;
+    r->map_len = 0;
+    return nb_lcores;
+}
+
+#if PRBS_SEQ_FILE_ENABLED
+// ==========================================
+// PERSISTENT SEQUENCE FILE
+// ==========================================
+// Replica hugetlbfs (yoksa tmpfs) üzerinde NUMA node başına bir dosyada
+// tutulur; sonraki başlangıçlar faz taraması ve üretim yapmadan dosyayı
+// read-only mmap eder. Dosya adı polinom, referans seed ve pencere
+// uzunluğuyla anahtarlanır; header faz tablosunu, data uzunluğunu ve
+// checksum'ı taşır. Header veya checksum tutmazsa dosya yeniden üretilir.
+//
+// Düzen: [header (PRBS_SEQ_FILE_HDR_SIZE) | data (prbs_seq_len byte)]
+
+#define PRBS_SEQ_FILE_MAGIC        "PRBS31SQ"
+#define PRBS_SEQ_FILE_VERSION      1
+#define PRBS_SEQ_FILE_HDR_SIZE     4096
+#define PRBS_SEQ_FILE_POLY         ((31u << 8) | 28u)   // x^31 + x^28 + 1
+#define PRBS_SEQ_FILE_FALLBACK_DIR "/dev/shm"
+
+struct prbs_seq_file_hdr {
+    char magic[8];
+    uint32_t version;
+    uint32_t poly;
+    uint32_t ref_state;
+    uint32_t window_len;     // PRBS_CACHE_SIZE
+    uint64_t len;            // Data byte sayısı
+    uint64_t checksum;       // prbs_seq_sum_chunk(data, 0, len)
+    uint32_t nb_phases;
+    uint32_t complete;       // En son yazılır: 1 = data + checksum geçerli
+    struct {
+        uint32_t state;
+        uint32_t phase;      // UINT32_MAX = dizide yok
+    } phases[PRBS_SEQ_NB_STATES];
+};
+
+static const char *const prbs_seq_file_dirs[] = {
+    PRBS_SEQ_FILE_DIR,
+    PRBS_SEQ_FILE_FALLBACK_DIR,
+};
+
+static void prbs_seq_file_path(char *path, size_t size, const char *dir, int socket_id)
+{
+    snprintf(path, size, "%s/prbs31_p%04x_s%08x_w%u_node%d.bin", dir, PRBS_SEQ_FILE_POLY,
+             PRBS_SEQ_REF_STATE, (unsigned)PRBS_CACHE_SIZE, socket_id);
+}
+
+static uint64_t prbs_seq_checksum(uint8_t *buf, uint64_t len, int socket_id)
+{
+    unsigned nb_jobs = prbs_seq_run_jobs(PRBS_SEQ_JOB_SUM, buf, len, socket_id);
+    uint64_t sum = 0;
+
+    for (unsigned j = 0; j < nb_jobs; j++)
+        sum += prbs_seq_jobs[j].sum;
+    return sum;
+}
+
+// hugetlbfs'te dosya boyu huge page katı olmalı (2 MB / 1 GB)
+static size_t prbs_seq_file_map_len(int fd, uint64_t data_len)
+{
+    struct statfs sfs;
+    uint64_t pg = 4096;
+
+    if (fstatfs(fd, &sfs) == 0 && sfs.f_type == HUGETLBFS_MAGIC && sfs.f_bsize > 0)
+        pg = (uint64_t)sfs.f_bsize;
+    return (size_t)((PRBS_SEQ_FILE_HDR_SIZE + data_len + pg - 1) / pg * pg);
+}
+
+/**
+ * Mapping'in sayfalarını socket_id node'una bağla (libnuma yok: doğrudan mbind)
+ * hugetlbfs/tmpfs'te politika dosyaya yazılır; sonraki fault'lar bu node'dan.
+ */
+static void prbs_seq_file_bind(void *addr, size_t len, int socket_id)
+{
+    unsigned long mask = 1UL << socket_id;
+
+    if (syscall(SYS_mbind, addr, len, MPOL_BIND, &mask, sizeof(mask) * 8 + 1, 0) != 0)
+        printf("Warning: PRBS file mbind to node %d failed: %s\n", socket_id, strerror(errno));
+}
+
+/**
+ * Header'ı mevcut seed tablosuna göre doğrula
+ * home → faz tablosu ve uzunluk header'dan alınacak (sadece tutarlılık),
+ * aksi halde home replica'nınkiyle birebir aynı olmalı.
+ * @return NULL if valid, otherwise reason
+ */
+static const char *prbs_seq_file_check(const struct prbs_seq_file_hdr *h, size_t file_len,
+                                       bool home)
+{
+    if (memcmp(h->magic, PRBS_SEQ_FILE_MAGIC, sizeof(h->magic)) != 0 ||
+        h->version != PRBS_SEQ_FILE_VERSION)
+        return "bad magic/version";
+    if (h->complete != 1)
+        return "incomplete";
+    if (h->poly != PRBS_SEQ_FILE_POLY || h->ref_state != PRBS_SEQ_REF_STATE ||
+        h->window_len != PRBS_CACHE_SIZE)
+        return "polynomial/seed/window mismatch";
+    if (h->len < PRBS_SEQ_BYTES || PRBS_SEQ_FILE_HDR_SIZE + h->len > file_len ||
+        (!home && h->len != prbs_seq_len))
+        return "length mismatch";
+    if (h->nb_phases != prbs_seq_nb_phases)
+        return "seed table mismatch";
+
+    for (uint32_t i = 0; i < prbs_seq_nb_phases; i++) {
+        const struct prbs_seq_phase *p = &prbs_seq_phases[i];
+        uint32_t phase = h->phases[i].phase;
+
+        if (h->phases[i].state != p->state)
+            return "seed table mismatch";
+        if (phase != UINT32_MAX && (uint64_t)phase + PRBS_CACHE_SIZE > h->len)
+            return "phase out of range";
+        if (!home && phase != (p->found ? p->phase : UINT32_MAX))
+            return "phase table mismatch";
+    }
+    return NULL;
+}
+
+/**
+ * Node dosyasını read-only mmap et ve doğrula (header + checksum)
+ * home → faz tablosu ve prbs_seq_len header'dan yüklenir (tarama atlanır).
+ * @return 0 on success, -1 if missing or stale (çağıran yeniden üretir)
+ */
+static int prbs_seq_file_load(const char *path, int socket_id, bool home,
+                              struct prbs_seq_replica *r)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+
+    const char *why = NULL;
+    void *map = MAP_FAILED;
+    struct stat st;
+
+    // Başka bir süreç dosyayı üretiyorsa bitirmesini bekle
+    if (flock(fd, LOCK_SH) != 0 || fstat(fd, &st) != 0) {
+        why = strerror(errno);
+        goto fail;
+    }
+    if ((size_t)st.st_size < PRBS_SEQ_FILE_HDR_SIZE) {
+        why = "truncated";
+        goto fail;
+    }
+
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED | MAP_POPULATE, fd, 0);
+    if (map == MAP_FAILED) {
+        why = strerror(errno);
+        goto fail;
+    }
+
+    const struct prbs_seq_file_hdr *h = map;
+    why = prbs_seq_file_check(h, (size_t)st.st_size, home);
+    if (why)
+        goto fail;
+
+    uint8_t *data = (uint8_t *)map + PRBS_SEQ_FILE_HDR_SIZE;
+    if (prbs_seq_checksum(data, h->len, socket_id) != h->checksum) {
+        why = "checksum mismatch";
+        goto fail;
+    }
+
+    prbs_seq_file_bind(map, (size_t)st.st_size, socket_id);
+
+    if (home) {
+        for (uint32_t i = 0; i < prbs_seq_nb_phases; i++) {
+            prbs_seq_phases[i].found = h->phases[i].phase != UINT32_MAX;
+            prbs_seq_phases[i].phase = prbs_seq_phases[i].found ? h->phases[i].phase : 0;
+        }
+        prbs_seq_len = (size_t)h->len;
+    }
+
+    close(fd);
+    r->data = data;
+    r->map = map;
+    r->map_len = (size_t)st.st_size;
+    printf("Shared PRBS-31 loaded from %s\n", path);
+    return 0;
+
+fail:
+    printf("PRBS file %s unusable (%s), rebuilding\n", path, why);
+    if (map != MAP_FAILED)
+        munmap(map, (size_t)st.st_size);
+    close(fd);
+    return -1;
+}
+
+/**
+ * Node dosyasını yeniden oluştur ve data'yı doldur
+ * src NULL → dizi lcore'larda doğrudan mapping'e üretilir, aksi halde src'den
+ * kopyalanır (ek node replica'sı). complete en son yazılır, mapping read-only'e
+ * çevrilir. Üretim boyunca LOCK_EX tutulur.
+ * @return kullanılan lcore sayısı, 0 = dosya oluşturulamadı
+ */
+static unsigned prbs_seq_file_create(const char *path, int socket_id, const uint8_t *src,
+                                     struct prbs_seq_replica *r)
+{
+    unlink(path);
+    int fd = open(path, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0)
+        return 0;
+
+    const size_t map_len = prbs_seq_file_map_len(fd, prbs_seq_len);
+    void *map = MAP_FAILED;
+    int err;
+
+    if (flock(fd, LOCK_EX) != 0 || ftruncate(fd, (off_t)map_len) != 0) {
+        err = errno;
+        goto fail;
+    }
+
+    map = mmap(NULL, map_len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        err = errno;
+        goto fail;
+    }
+    prbs_seq_file_bind(map, map_len, socket_id);
+
+    // Sayfaları şimdi ayır: dolu tmpfs/hugetlbfs'te SIGBUS yerine hata dönsün
+    err = posix_fallocate(fd, 0, (off_t)map_len);
+    if (err != 0)
+        goto fail;
+
+    struct prbs_seq_file_hdr *h = map;
+    uint8_t *data = (uint8_t *)map + PRBS_SEQ_FILE_HDR_SIZE;
+    unsigned nb_lcores = 1;
+
+    if (src)
+        rte_memcpy(data, src, prbs_seq_len);
+    else
+        nb_lcores = prbs_seq_run_jobs(PRBS_SEQ_JOB_FILL, data, prbs_seq_len, socket_id);
+
+    memset(h, 0, PRBS_SEQ_FILE_HDR_SIZE);
+    memcpy(h->magic, PRBS_SEQ_FILE_MAGIC, sizeof(h->magic));
+    h->version = PRBS_SEQ_FILE_VERSION;
+    h->poly = PRBS_SEQ_FILE_POLY;
+    h->ref_state = PRBS_SEQ_REF_STATE;
+    h->window_len = PRBS_CACHE_SIZE;
+    h->len = prbs_seq_len;
+    h->checksum = prbs_seq_checksum(data, prbs_seq_len, socket_id);
+    h->nb_phases = prbs_seq_nb_phases;
+    for (uint32_t i = 0; i < prbs_seq_nb_phases; i++) {
+        h->phases[i].state = prbs_seq_phases[i].state;
+        h->phases[i].phase = prbs_seq_phases[i].found ? prbs_seq_phases[i].phase : UINT32_MAX;
+    }
+    __atomic_store_n(&h->complete, 1, __ATOMIC_RELEASE);
+
+    mprotect(map, map_len, PROT_READ);
+    close(fd);  // LOCK_EX bırakılır
+
+    r->data = data;
+    r->map = map;
+    r->map_len = map_len;
+    printf("Shared PRBS-31 saved to %s\n", path);
+    return nb_lcores;
+
+fail:
+    printf("Warning: Cannot create PRBS file %s: %s\n", path, strerror(err));
+    if (map != MAP_FAILED)
+        munmap(map, map_len);
+    close(fd);
+    unlink(path);
+    return 0;
+}
+
+#if TX_ZEROCOPY_PRBS_ENABLED
+/**
+ * Zero-copy TX extbuf'ları NIC DMA'sı için DPDK belleği ister (memseg/IOVA):
+ * dosya mapping'ini hugepage heap'ine kopyala. Dosya yine de tarama +
+ * üretimi atlatır; kopya başarısızsa mapping kalır (zc kopya yoluna düşer).
+ */
+static void prbs_seq_file_to_heap(int socket_id, struct prbs_seq_replica *r)
+{
+    uint8_t *buf = rte_malloc_socket("prbs_seq_replica", prbs_seq_len,
+                                     RTE_CACHE_LINE_SIZE, socket_id);
+    if (buf == NULL) {
+        printf("Warning: PRBS file replica not in DPDK memory, zero-copy TX disabled\n");
+        return;
+    }
+
+    rte_memcpy(buf, r->data, prbs_seq_len);
+    munmap(r->map, r->map_len);
+    r->data = buf;
+    r->map = NULL;
+    r->map_len = 0;
+}
+#endif
+
+/**
+ * socket_id replica'sını node dosyasından yükle; yoksa/bozuksa oluştur
+ * Dizinler sırayla denenir (PRBS_SEQ_FILE_DIR, sonra /dev/shm).
+ * load_only → home replica'da faz taraması yapılmadan önceki ilk deneme.
+ * @return kullanılan lcore sayısı (yüklemede 1), 0 = dosya yolu kullanılamadı
+ */
+static unsigned prbs_seq_file_replica(int socket_id, bool home, bool load_only,
+                                      const uint8_t *src, struct prbs_seq_replica *r)
+{
+    char path[256];
+    unsigned nb_lcores = 0;
+
+    for (size_t d = 0; d < RTE_DIM(prbs_seq_file_dirs) && nb_lcores == 0; d++) {
+        prbs_seq_file_path(path, sizeof(path), prbs_seq_file_dirs[d], socket_id);
+        if (load_only)
+            nb_lcores = prbs_seq_file_load(path, socket_id, home, r) == 0 ? 1 : 0;
+        else
+            nb_lcores = prbs_seq_file_create(path, socket_id, src, r);
+    }
+
+#if TX_ZEROCOPY_PRBS_ENABLED
+    if (nb_lcores > 0)
+        prbs_seq_file_to_heap(socket_id, r);
+#endif
+    return nb_lcores;
+}
+#endif /* PRBS_SEQ_FILE_ENABLED */
+
+// ==========================================
+// PUBLIC API
+// ==========================================
+
+int prbs_seq_init(int socket_id)
+{
+    if (prbs_seq_home_socket >= 0)
+        return 0;
+
+    if (socket_id < 0 || socket_id >= RTE_MAX_NUMA_NODES)
+        socket_id = 0;
+
+    prbs_seq_init_bitrev();
+    prbs_jump_init();
+
+    prbs_seq_nb_phases = 0;
+    for (uint16_t p = 0; p < MAX_PRBS_CACHE_PORTS; p++)
+        prbs_seq_add_state(prbs_seq_dpdk_state(p));
+    for (uint16_t r = 0; r < MAX_RAW_SOCKET_PORTS; r++)
+        prbs_seq_add_state(prbs_seq_raw_state(RAW_SOCKET_PORT_ID_START + r));
+
+    struct prbs_seq_replica *home = &prbs_seq_replicas[socket_id];
+    const double hz = (double)rte_get_tsc_hz();
+    uint64_t t0 = rte_get_tsc_cycles();
+
+#if PRBS_SEQ_FILE_ENABLED
+    if (prbs_seq_file_replica(socket_id, true, true, NULL, home) > 0) {
+        prbs_seq_home_socket = socket_id;
+        printf("Shared PRBS-31 ready (%.2f GB, socket %d): file load + verify %.2f s\n",
+               prbs_seq_len / (1024.0 * 1024.0 * 1024.0), socket_id,
+               (rte_get_tsc_cycles() - t0) / hz);
+        return 0;
+    }
+#endif
+
+    printf("Scanning PRBS-31 phases for %u seeds...\n", prbs_seq_nb_phases);
+    prbs_seq_scan_phases(socket_id);
+    uint64_t t1 = rte_get_tsc_cycles();
+
+    // Replica uzunluğu: en sona düşen pencere de kesintisiz okunabilmeli
+    uint64_t end = PRBS_SEQ_BYTES;
+    for (uint32_t i = 0; i < prbs_seq_nb_phases; i++) {
+        const struct prbs_seq_phase *p = &prbs_seq_phases[i];
+        if (!p->found) {
+            printf("Warning: PRBS state 0x%08X not on the PRBS-31 sequence\n", p->state);
+            continue;
+        }
+        if ((uint64_t)p->phase + PRBS_CACHE_SIZE > end)
+            end = (uint64_t)p->phase + PRBS_CACHE_SIZE;
+    }
+    prbs_seq_len = (size_t)end;
+
+    printf("Generating shared PRBS-31 sequence (%.2f GB, socket %d)...\n",
+           prbs_seq_len / (1024.0 * 1024.0 * 1024.0), socket_id);
+
+    unsigned nb_lcores = 0;
+#if PRBS_SEQ_FILE_ENABLED
+    nb_lcores = prbs_seq_file_replica(socket_id, true, false, NULL, home);
+#endif
+    if (nb_lcores == 0)
+        nb_lcores = prbs_seq_replica_malloc(socket_id, NULL, home);
+    if (nb_lcores == 0) {
+        printf("Error: Failed to allocate shared PRBS sequence (%.2f GB) on socket %d\n",
+               prbs_seq_len / (1024.0 * 1024.0 * 1024.0), socket_id);
+        prbs_seq_len = 0;
+        return -1;
+    }
+    uint64_t t2 = rte_get_tsc_cycles();
+
+    prbs_seq_home_socket = socket_id;
+
+    const double gen_s = (t2 - t1) / hz;
+    printf("Shared PRBS-31 ready on %u lcores: phase scan %.2f s, generation %.2f s (%.2f GB/s)\n",
+           nb_lcores, (t1 - t0) / hz, gen_s,
+           gen_s > 0 ? prbs_seq_len / gen_s / 1e9 : 0.0);
+    return 0;
+}
+
+const uint8_t *prbs_seq_replica(int socket_id)
+{
+    if (prbs_seq_home_socket < 0)
+        return NULL;
+
+    const uint8_t *home = prbs_seq_replicas[prbs_seq_home_socket].data;
+
+    if (socket_id < 0 || socket_id >= RTE_MAX_NUMA_NODES)
+        return home;
+
+    struct prbs_seq_replica *r = &prbs_seq_replicas[socket_id];
+    if (r->data != NULL)
+        return r->data;
+
+    unsigned ok = 0;
+#if PRBS_SEQ_FILE_ENABLED
+    ok = prbs_seq_file_replica(socket_id, false, true, NULL, r);
+    if (ok == 0)
+        ok = prbs_seq_file_replica(socket_id, false, false, home, r);
+#endif
+    if (ok == 0)
+        ok = prbs_seq_replica_malloc(socket_id, home, r);
+    if (ok == 0) {
+        printf("Warning: No PRBS replica on socket %d, using socket %d (remote reads)\n",
+               socket_id, prbs_seq_home_socket);
+        return home;
+    }
+
+    printf("Shared PRBS-31 replicated to socket %d\n", socket_id);
+    return r->data;
+}
+
+int prbs_window_init(struct prbs_window *w, uint32_t state, int socket_id)
+{
+    const struct prbs_seq_phase *p = NULL;
+
+    memset(w, 0, sizeof(*w));
+
+    for (uint32_t i = 0; i < prbs_seq_nb_phases; i++) {
+        if (prbs_seq_phases[i].state == state && prbs_seq_phases[i].found) {
+            p = &prbs_seq_phases[i];
+            break;
+        }
+    }
+    if (p == NULL) {
+        printf("Error: PRBS state 0x%08X has no known phase\n", state);
+        return -1;
+    }
+
+    const uint8_t *replica = prbs_seq_replica(socket_id);
+    if (replica == NULL)
+        return -1;
+
+    w->seam = rte_malloc_socket("prbs_seam", 2 * PRBS_SEAM_HALF, RTE_CACHE_LINE_SIZE,
+                                socket_id < 0 ? SOCKET_ID_ANY : socket_id);
+    if (w->seam == NULL)
+        return -1;
+
+    w->base = replica + p->phase;
+    w->phase = p->phase;
+    w->state = state;
+    w->socket_id = socket_id;
+
+    // Eski cache_ext düzeni: 2^28 sınırını aşan okuma pencerenin başına sarar
+    memcpy(w->seam, w->base + PRBS_CACHE_SIZE - PRBS_SEAM_HALF, PRBS_SEAM_HALF);
+    memcpy(w->seam + PRBS_SEAM_HALF, w->base, PRBS_SEAM_HALF);
+    return 0;
+}
+
+void prbs_window_free(struct prbs_window *w)
+{
+    if (w->seam)
+        rte_free(w->seam);
+    memset(w, 0, sizeof(*w));
+}
+
+void prbs_seq_cleanup(void)
+{
+    for (int s = 0; s < RTE_MAX_NUMA_NODES; s++) {
+        struct prbs_seq_replica *r = &prbs_seq_replicas[s];
+
+        if (r->map)
+            munmap(r->map, r->map_len);  // Dosya kalır: sonraki başlangıç kullanır
+        else if (r->data)
+            rte_free(r->data);
+        memset(r, 0, sizeof(*r));
+    }
+    prbs_seq_home_socket = -1;
+    prbs_seq_len = 0;
+    prbs_seq_nb_phases = 0;
+}
+
+#if PRBS_GEN_BENCH_ENABLED
+// ==========================================
+// GENERATOR BENCHMARK
+// ==========================================
+#define PRBS_GEN_BENCH_BYTES        (256u * 1024 * 1024)
+#define PRBS_GEN_BENCH_SERIAL_BYTES (16u * 1024 * 1024)
+
+// Eski fill_buffer_with_prbs31: bit başına bir LFSR adımı
+static void prbs_gen_bench_bitserial(uint8_t *dst, size_t len, uint32_t state)
+{
+    for (size_t i = 0; i < len; i++) {
+        uint8_t byte = 0;
+        for (int b = 0; b < 8; b++) {
+            uint32_t out = state & 1;
+            uint32_t nb = (state ^ (state >> 3)) & 1;
+            state = (nb << 30) | (state >> 1);
+            byte = (uint8_t)((byte << 1) | out);
+        }
+        dst[i] = byte;
+    }
+}
+
+static void prbs_gen_bench_step8(uint8_t *dst, size_t len, uint32_t state)
+{
+    for (size_t i = 0; i < len; i++) {
+        dst[i] = prbs_seq_byte(state);
+        state = prbs_seq_step8(state);
+    }
+}
+
+static void prbs_gen_bench_report(const char *name, uint64_t cycles, size_t bytes,
+                                  double base_gbps, bool match)
+{
+    const double s = (double)cycles / (double)rte_get_tsc_hz();
+    const double gbps = s > 0 ? bytes / s / 1e9 : 0.0;
+
+    printf("  %-22s %8.3f GB/s  x%-7.1f %s\n", name, gbps,
+           base_gbps > 0 ? gbps / base_gbps : 1.0, match ? "OK" : "MISMATCH");
+}
+
+void prbs_seq_gen_benchmark(void)
+{
+    uint8_t *serial = rte_malloc(NULL, PRBS_GEN_BENCH_SERIAL_BYTES, RTE_CACHE_LINE_SIZE);
+    uint8_t *ref = rte_malloc(NULL, PRBS_GEN_BENCH_BYTES, RTE_CACHE_LINE_SIZE);
+    uint8_t *out = rte_malloc(NULL, PRBS_GEN_BENCH_BYTES, RTE_CACHE_LINE_SIZE);
+
+    if (!serial || !ref || !out) {
+        printf("PRBS generator benchmark: allocation failed\n");
+        goto out;
+    }
+
+    prbs_seq_init_bitrev();
+    prbs_jump_init();
+
+    printf("\n=== PRBS-31 Generator Benchmark (%u MB) ===\n",
+           PRBS_GEN_BENCH_BYTES / (1024 * 1024));
+
+    uint64_t t0 = rte_rdtsc();
+    prbs_gen_bench_bitserial(serial, PRBS_GEN_BENCH_SERIAL_BYTES, PRBS_SEQ_REF_STATE);
+    uint64_t c = rte_rdtsc() - t0;
+    const double base_gbps = PRBS_GEN_BENCH_SERIAL_BYTES /
+                             ((double)c / (double)rte_get_tsc_hz()) / 1e9;
+    prbs_gen_bench_report("bit-serial (legacy)", c, PRBS_GEN_BENCH_SERIAL_BYTES, 0, true);
+
+    t0 = rte_rdtsc();
+    prbs_gen_bench_step8(ref, PRBS_GEN_BENCH_BYTES, PRBS_SEQ_REF_STATE);
+    c = rte_rdtsc() - t0;
+    prbs_gen_bench_report("8-bit step", c, PRBS_GEN_BENCH_BYTES, base_gbps,
+                          memcmp(ref, serial, PRBS_GEN_BENCH_SERIAL_BYTES) == 0);
+
+    t0 = rte_rdtsc();
+    prbs_seq_fill_words(out, PRBS_GEN_BENCH_BYTES, PRBS_SEQ_REF_STATE);
+    c = rte_rdtsc() - t0;
+    prbs_gen_bench_report("64-bit word", c, PRBS_GEN_BENCH_BYTES, base_gbps,
+                          memcmp(out, ref, PRBS_GEN_BENCH_BYTES) == 0);
+
+    memset(out, 0, PRBS_GEN_BENCH_BYTES);
+    t0 = rte_rdtsc();
+    unsigned nb = prbs_seq_run_jobs(PRBS_SEQ_JOB_FILL, out, PRBS_GEN_BENCH_BYTES, (int)rte_socket_id());
+    c = rte_rdtsc() - t0;
+    char name[32];
+    snprintf(name, sizeof(name), "64-bit word x%u lcore", nb);
+    prbs_gen_bench_report(name, c, PRBS_GEN_BENCH_BYTES, base_gbps,
+                          memcmp(out, ref, PRBS_GEN_BENCH_BYTES) == 0);
+
+    // Jump-ahead: rastgele offset'te state == 8-bit adımla varılan state
+    uint32_t s = PRBS_SEQ_REF_STATE;
+    for (uint32_t i = 0; i < 12345; i++)
+        s = prbs_seq_step8(s);
+    printf("  jump-ahead check       %s\n\n",
+           prbs_seq_jump(PRBS_SEQ_REF_STATE, 12345ULL * 8) == s ? "OK" : "MISMATCH");
+
+out:
+    rte_free(serial);
+    rte_free(ref);
+    rte_free(out);
+}
+#endif
@@ -0,0 +1,611 @@
+#include "prbs_verify.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <rte_branch_prediction.h>
+#include <rte_cycles.h>
+
+#if PRBS_VERIFY_BENCH_ENABLED
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include <rte_memory.h>
+#endif
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+// ==========================================
+// SCALAR KERNEL (referans + fallback)
+// ==========================================
+
+static uint32_t prbs_verify_scalar(const uint8_t *recv, const uint8_t *exp, uint32_t len)
+{
+    uint64_t bits = 0;
+    uint32_t i = 0;
+
+    // Temiz paket: libc memcmp (zaten vektörel) ile erken çıkış
+    if (likely(memcmp(recv, exp, len) == 0))
+        return 0;
+
+    for (; i + 8 <= len; i += 8) {
+        uint64_t r, e;
+        memcpy(&r, recv + i, 8);
+        memcpy(&e, exp + i, 8);
+        bits += (uint64_t)__builtin_popcountll(r ^ e);
+    }
+    for (; i < len; i++)
+        bits += (uint64_t)__builtin_popcount(recv[i] ^ exp[i]);
+
+    return (uint32_t)bits;
+}
+
+#if defined(__x86_64__)
+
+// ==========================================
+// AVX2 KERNEL
+// ==========================================
+// 128 byte'lık bloklar: 4x XOR → OR → testz. Fark yoksa popcount atlanır.
+// Popcount: nibble LUT (pshufb) + sad_epu8 ile 64-bit akümülatör.
+
+__attribute__((target("avx2")))
+static inline __m256i popcnt256_epi64(__m256i v)
+{
+    const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                         0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0F);
+    __m256i lo = _mm256_and_si256(v, low_mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lut, lo), _mm256_shuffle_epi8(lut, hi));
+    return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+
+__attribute__((target("avx2")))
+static uint32_t prbs_verify_avx2(const uint8_t *recv, const uint8_t *exp, uint32_t len)
+{
+    __m256i acc = _mm256_setzero_si256();
+    uint32_t i = 0;
+
+    for (; i + 128 <= len; i += 128) {
+        __m256i x0 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(recv + i)),
+                                      _mm256_loadu_si256((const __m256i *)(exp + i)));
+        __m256i x1 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(recv + i + 32)),
+                                      _mm256_loadu_si256((const __m256i *)(exp + i + 32)));
+        __m256i x2 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(recv + i + 64)),
+                                      _mm256_loadu_si256((const __m256i *)(exp + i + 64)));
+        __m256i x3 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(recv + i + 96)),
+                                      _mm256_loadu_si256((const __m256i *)(exp + i + 96)));
+        __m256i any = _mm256_or_si256(_mm256_or_si256(x0, x1), _mm256_or_si256(x2, x3));
+
+        if (unlikely(!_mm256_testz_si256(any, any))) {
+            acc = _mm256_add_epi64(acc, popcnt256_epi64(x0));
+            acc = _mm256_add_epi64(acc, popcnt256_epi64(x1));
+            acc = _mm256_add_epi64(acc, popcnt256_epi64(x2));
+            acc = _mm256_add_epi64(acc, popcnt256_epi64(x3));
+        }
+    }
+
+    for (; i + 32 <= len; i += 32) {
+        __m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(recv + i)),
+                                     _mm256_loadu_si256((const __m256i *)(exp + i)));
+        if (unlikely(!_mm256_testz_si256(x, x)))
+            acc = _mm256_add_epi64(acc, popcnt256_epi64(x));
+    }
+
+    uint64_t bits = (uint64_t)_mm256_extract_epi64(acc, 0) + (uint64_t)_mm256_extract_epi64(acc, 1) +
+                    (uint64_t)_mm256_extract_epi64(acc, 2) + (uint64_t)_mm256_extract_epi64(acc, 3);
+
+    if (i < len)
+        bits += prbs_verify_scalar(recv + i, exp + i, len - i);
+
+    return (uint32_t)bits;
+}
+
+// ==========================================
+// AVX-512BW KERNEL
+// ==========================================
+// 256 byte'lık bloklar, kuyruk maskeli load ile (sayfa sınırı güvenli).
+
+__attribute__((target("avx512f,avx512bw")))
+static inline __m512i popcnt512_lut_epi64(__m512i v)
+{
+    const __m512i lut = _mm512_broadcast_i32x4(_mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3,
+                                                             1, 2, 2, 3, 2, 3, 3, 4));
+    const __m512i low_mask = _mm512_set1_epi8(0x0F);
+    __m512i lo = _mm512_and_si512(v, low_mask);
+    __m512i hi = _mm512_and_si512(_mm512_srli_epi16(v, 4), low_mask);
+    __m512i cnt = _mm512_add_epi8(_mm512_shuffle_epi8(lut, lo), _mm512_shuffle_epi8(lut, hi));
+    return _mm512_sad_epu8(cnt, _mm512_setzero_si512());
+}
+
+#define PRBS_VERIFY_AVX512_BODY(POPCNT)                                                  \
+    __m512i acc = _mm512_setzero_si512();                                                \
+    uint32_t i = 0;                                                                      \
+                                                                                         \
+    for (; i + 256 <= len; i += 256) {                                                   \
+        __m512i x0 = _mm512_xor_si512(_mm512_loadu_si512(recv + i),                      \
+                                      _mm512_loadu_si512(exp + i));                      \
+        __m512i x1 = _mm512_xor_si512(_mm512_loadu_si512(recv + i + 64),                 \
+                                      _mm512_loadu_si512(exp + i + 64));                 \
+        __m512i x2 = _mm512_xor_si512(_mm512_loadu_si512(recv + i + 128),                \
+                                      _mm512_loadu_si512(exp + i + 128));                \
+        __m512i x3 = _mm512_xor_si512(_mm512_loadu_si512(recv + i + 192),                \
+                                      _mm512_loadu_si512(exp + i + 192));                \
+        __m512i any = _mm512_or_si512(_mm512_or_si512(x0, x1), _mm512_or_si512(x2, x3)); \
+                                                                                         \
+        if (unlikely(_mm512_test_epi64_mask(any, any) != 0)) {                           \
+            acc = _mm512_add_epi64(acc, POPCNT(x0));                                     \
+            acc = _mm512_add_epi64(acc, POPCNT(x1));                                     \
+            acc = _mm512_add_epi64(acc, POPCNT(x2));                                     \
+            acc = _mm512_add_epi64(acc, POPCNT(x3));                                     \
+        }                                                                                \
+    }                                                                                    \
+                                                                                         \
+    for (; i < len; i += 64) {                                                           \
+        uint32_t n = len - i;                                                            \
+        __mmask64 m = (n >= 64) ? ~(__mmask64)0 : (((__mmask64)1 << n) - 1);            \
+        __m512i x = _mm512_xor_si512(_mm512_maskz_loadu_epi8(m, recv + i),               \
+                                     _mm512_maskz_loadu_epi8(m, exp + i));               \
+        if (unlikely(_mm512_test_epi64_mask(x, x) != 0))                                 \
+            acc = _mm512_add_epi64(acc, POPCNT(x));                                      \
+    }                                                                                    \
+                                                                                         \
+    return (uint32_t)_mm512_reduce_add_epi64(acc);
+
+__attribute__((target("avx512f,avx512bw")))
+static uint32_t prbs_verify_avx512bw(const uint8_t *recv, const uint8_t *exp, uint32_t len)
+{
+    PRBS_VERIFY_AVX512_BODY(popcnt512_lut_epi64)
+}
+
+// ==========================================
+// AVX-512 VPOPCNTDQ KERNEL
+// ==========================================
+
+__attribute__((target("avx512f,avx512bw,avx512vpopcntdq")))
+static uint32_t prbs_verify_avx512_vpopcnt(const uint8_t *recv, const uint8_t *exp, uint32_t len)
+{
+    PRBS_VERIFY_AVX512_BODY(_mm512_popcnt_epi64)
+}
+
+#undef PRBS_VERIFY_AVX512_BODY
+
+#endif /* __x86_64__ */
+
+// ==========================================
+// LFSR ENGINE
+// ==========================================
+// Beklenen payload L1'deki yığın tamponunda üretilir, sonra aktif kernel ile
+// karşılaştırılır. Reküransın 8. ve 32. kuvvetleri bit kaydırmalarını byte
+// sınırına getirir (x^248 + x^224 + 1, x^992 + x^896 + 1):
+//   E[i] = E[i - 31]  ^ E[i - 28]    (ilk 128 byte, 64-bit kelimelerle)
+//   E[i] = E[i - 124] ^ E[i - 112]   (geri kalan, 128 byte'lık geçmiş → SIMD)
+// İlk 32 byte doğrudan state'ten: state o[k..k+30] bitlerini tutar
+// (bit i = o[k+i]), sonraki 31 bit tek adımda o[k+31+j] = o[k+j] ^ o[k+3+j].
+
+#define PRBS_LFSR_SEED_BYTES 128
+#define PRBS_LFSR_MAX_CHUNK  2048  // Tek seferde üretilen en uzun kesit
+
+typedef void (*prbs_lfsr_gen_fn_t)(uint8_t *e, uint32_t len);
+
+static inline uint32_t prbs_lfsr_next31(uint32_t s)
+{
+    uint32_t t = s ^ (s >> 3);    // bit 0..27
+    t ^= (t & 7) << 28;           // bit 28..30: o[k+28+j] ^ o[k+31+j]
+    return t & 0x7FFFFFFF;
+}
+
+// Her byte'ın bit sırasını ters çevir (LSB-first bitler → MSB-first byte'lar)
+static inline uint64_t prbs_lfsr_rev_bytes(uint64_t x)
+{
+    x = ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+    x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+    return x;
+}
+
+/**
+ * e[0 .. PRBS_LFSR_SEED_BYTES) = state'ten başlayan akış
+ * Kelimeler little-endian: byte 8k+j, w[k]'nin j. byte'ı.
+ */
+static inline void prbs_lfsr_seed(uint8_t *e, uint32_t state)
+{
+    uint32_t s[9];
+    uint64_t w[PRBS_LFSR_SEED_BYTES / 8];
+
+    s[0] = state;
+    for (int i = 1; i < 9; i++)
+        s[i] = prbs_lfsr_next31(s[i - 1]);
+
+    // 9 × 31 bit → ilk 256 bit
+    w[0] = prbs_lfsr_rev_bytes((uint64_t)s[0] | ((uint64_t)s[1] << 31) | ((uint64_t)s[2] << 62));
+    w[1] = prbs_lfsr_rev_bytes((uint64_t)(s[2] >> 2) | ((uint64_t)s[3] << 29) | ((uint64_t)s[4] << 60));
+    w[2] = prbs_lfsr_rev_bytes((uint64_t)(s[4] >> 4) | ((uint64_t)s[5] << 27) | ((uint64_t)s[6] << 58));
+    w[3] = prbs_lfsr_rev_bytes((uint64_t)(s[6] >> 6) | ((uint64_t)s[7] << 25) | ((uint64_t)s[8] << 56));
+
+    // E[i] = E[i-31] ^ E[i-28]: 8(k-4)+1 ve 8(k-4)+4 byte'larından başlayan kelimeler
+    for (int k = 4; k < PRBS_LFSR_SEED_BYTES / 8; k++)
+        w[k] = ((w[k - 4] >> 8) | (w[k - 3] << 56)) ^ ((w[k - 4] >> 32) | (w[k - 3] << 32));
+
+    memcpy(e, w, sizeof(w));
+}
+
+// E[i] = E[i-124] ^ E[i-112], 8 byte'lık adımlar
+static void prbs_lfsr_gen_scalar(uint8_t *e, uint32_t len)
+{
+    for (uint32_t i = PRBS_LFSR_SEED_BYTES; i < len; i += 8) {
+        uint64_t a, b;
+        memcpy(&a, e + i - 124, 8);
+        memcpy(&b, e + i - 112, 8);
+        a ^= b;
+        memcpy(e + i, &a, 8);
+    }
+}
+
+#if defined(__x86_64__)
+/**
+ * 32 byte'lık bloklar register'da: C[k] = (C[k-4]:C[k-3]) kesitinin 4. ve 16.
+ * byte'tan başlayan 32 byte'ı. mid = [C[k-4].hi | C[k-3].lo] = 16. byte'tan kesit.
+ */
+__attribute__((target("avx2")))
+static void prbs_lfsr_gen_avx2(uint8_t *e, uint32_t len)
+{
+    __m256i c0 = _mm256_load_si256((const __m256i *)e);
+    __m256i c1 = _mm256_load_si256((const __m256i *)(e + 32));
+    __m256i c2 = _mm256_load_si256((const __m256i *)(e + 64));
+    __m256i c3 = _mm256_load_si256((const __m256i *)(e + 96));
+
+    for (uint32_t i = PRBS_LFSR_SEED_BYTES; i < len; i += 32) {
+        __m256i mid = _mm256_permute2x128_si256(c0, c1, 0x21);
+        __m256i c4 = _mm256_xor_si256(_mm256_alignr_epi8(mid, c0, 4), mid);
+        _mm256_store_si256((__m256i *)(e + i), c4);
+        c0 = c1;
+        c1 = c2;
+        c2 = c3;
+        c3 = c4;
+    }
+}
+
+// 64 byte'lık bloklar: Z[k] = (Z[k-2]:Z[k-1]) kesitinin 1. ve 4. dword'ünden başlayan 64 byte
+__attribute__((target("avx512f")))
+static void prbs_lfsr_gen_avx512(uint8_t *e, uint32_t len)
+{
+    __m512i z0 = _mm512_load_si512((const void *)e);
+    __m512i z1 = _mm512_load_si512((const void *)(e + 64));
+
+    for (uint32_t i = PRBS_LFSR_SEED_BYTES; i < len; i += 64) {
+        __m512i z2 = _mm512_xor_si512(_mm512_alignr_epi32(z1, z0, 1),
+                                      _mm512_alignr_epi32(z1, z0, 4));
+        _mm512_store_si512((void *)(e + i), z2);
+        z0 = z1;
+        z1 = z2;
+    }
+}
+#endif
+
+static prbs_lfsr_gen_fn_t prbs_lfsr_gen_impl = prbs_lfsr_gen_scalar;
+
+uint32_t prbs_verify_lfsr(const uint8_t *recv, uint32_t state, uint32_t len)
+{
+    uint8_t exp[PRBS_LFSR_MAX_CHUNK + 64] __attribute__((aligned(64)));
+    uint32_t bits = 0;
+
+    for (;;) {
+        const uint32_t n = len < PRBS_LFSR_MAX_CHUNK ? len : PRBS_LFSR_MAX_CHUNK;
+
+        prbs_lfsr_seed(exp, state);
+        if (n > PRBS_LFSR_SEED_BYTES)
+            prbs_lfsr_gen_impl(exp, n);
+        bits += prbs_verify_impl(recv, exp, n);
+
+        len -= n;
+        if (likely(len == 0))
+            return bits;
+        recv += n;
+        state = prbs_seq_state_at(state, n);
+    }
+}
+
+// ==========================================
+// RUNTIME DISPATCH
+// ==========================================
+
+struct prbs_verify_kernel {
+    const char *name;
+    prbs_verify_fn_t fn;
+    int (*supported)(void);
+};
+
+static int prbs_cpu_scalar(void) { return 1; }
+
+#if defined(__x86_64__)
+static int prbs_cpu_avx2(void)
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+static int prbs_cpu_avx512bw(void)
+{
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+}
+
+static int prbs_cpu_avx512_vpopcnt(void)
+{
+    return prbs_cpu_avx512bw() && __builtin_cpu_supports("avx512vpopcntdq");
+}
+#endif
+
+// Tercih sırasına göre (ilk desteklenen seçilir)
+static const struct prbs_verify_kernel prbs_verify_kernels[] = {
+#if defined(__x86_64__)
+    { "avx512-vpopcntdq", prbs_verify_avx512_vpopcnt, prbs_cpu_avx512_vpopcnt },
+    { "avx512bw",         prbs_verify_avx512bw,       prbs_cpu_avx512bw },
+    { "avx2",             prbs_verify_avx2,           prbs_cpu_avx2 },
+#endif
+    { "scalar",           prbs_verify_scalar,         prbs_cpu_scalar },
+};
+
+#define PRBS_VERIFY_NB_KERNELS (sizeof(prbs_verify_kernels) / sizeof(prbs_verify_kernels[0]))
+
+prbs_verify_fn_t prbs_verify_impl = prbs_verify_scalar;
+static const char *prbs_verify_name = "scalar";
+
+void prbs_verify_init(void)
+{
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+#endif
+    for (size_t k = 0; k < PRBS_VERIFY_NB_KERNELS; k++) {
+        if (prbs_verify_kernels[k].supported()) {
+            prbs_verify_impl = prbs_verify_kernels[k].fn;
+            prbs_verify_name = prbs_verify_kernels[k].name;
+            break;
+        }
+    }
+    printf("PRBS verify kernel: %s\n", prbs_verify_name);
+
+#if defined(__x86_64__)
+    if (prbs_cpu_avx512bw())
+        prbs_lfsr_gen_impl = prbs_lfsr_gen_avx512;
+    else if (prbs_cpu_avx2())
+        prbs_lfsr_gen_impl = prbs_lfsr_gen_avx2;
+#endif
+
+#if PRBS_VERIFY_LFSR_PORT_MASK
+    printf("PRBS verify engine: LFSR (cacheless) on ports");
+    for (uint16_t p = 0; p < 32; p++)
+        if (prbs_verify_port_uses_lfsr(p))
+            printf(" %u", p);
+    printf(", cache on the rest\n");
+#endif
+}
+
+const char *prbs_verify_kernel_name(void)
+{
+    return prbs_verify_name;
+}
+
+#if PRBS_VERIFY_BENCH_ENABLED
+// ==========================================
+// BENCHMARK
+// ==========================================
+
+#define PRBS_BENCH_LEN        1459          // VLAN'lı MAX PRBS boyutu
+#define PRBS_BENCH_BUF_SIZE   (64 * 1024)   // L2'de kalan "cache" kesiti
+#define PRBS_BENCH_ITERATIONS 2000000
+#define PRBS_BENCH_BAD_BITS   16            // Hatalı pakette çevrilen bit sayısı
+
+// Eski RX yolu: memcmp, fark varsa byte byte popcount
+static uint32_t prbs_verify_legacy(const uint8_t *recv, const uint8_t *exp, uint32_t len)
+{
+    if (memcmp(recv, exp, len) == 0)
+        return 0;
+    uint32_t bits = 0;
+    for (uint32_t b = 0; b < len; b++)
+        bits += (uint32_t)__builtin_popcount(recv[b] ^ exp[b]);
+    return bits;
+}
+
+static void prbs_bench_run(const char *name, prbs_verify_fn_t fn,
+                           const uint8_t *recv, const uint8_t *exp, uint32_t expect_bits)
+{
+    const uint64_t hz = rte_get_tsc_hz();
+    const uint32_t slots = (PRBS_BENCH_BUF_SIZE - PRBS_BENCH_LEN) / 64;
+    volatile uint64_t sink = 0;
+    uint64_t bits = 0;
+
+    // Doğruluk: her kernel scalar referans ile aynı sonucu vermeli
+    uint32_t check = fn(recv, exp, PRBS_BENCH_LEN);
+
+    uint64_t start = rte_rdtsc();
+    for (uint32_t it = 0; it < PRBS_BENCH_ITERATIONS; it++) {
+        uint32_t off = (it % slots) * 64 + (it & 7);  // Hizasız başlangıçlar dahil
+        bits += fn(recv + off, exp + off, PRBS_BENCH_LEN);
+    }
+    uint64_t cycles = rte_rdtsc() - start;
+    sink += bits;
+
+    double sec = (double)cycles / (double)hz;
+    printf("  %-18s %-4s %8.1f cyc/pkt %8.2f Mpps %7.2f GB/s  %s\n",
+           name, expect_bits ? "BAD" : "GOOD",
+           (double)cycles / PRBS_BENCH_ITERATIONS,
+           PRBS_BENCH_ITERATIONS / sec / 1e6,
+           (double)PRBS_BENCH_ITERATIONS * PRBS_BENCH_LEN / sec / 1e9,
+           check == expect_bits ? "ok" : "MISMATCH");
+    (void)sink;
+}
+
+// ------------------------------------------
+// Engine: cache vs LFSR
+// ------------------------------------------
+// Gerçek port penceresi (DPDK port 0) üzerinde rastgele seq'ler. Paket havuzu
+// sıcak tutulur (DDIO ile LLC'ye gelen RX verisi gibi). "cache-cold" her turda
+// beklenen kesitleri clflush eder: port başına 256 MB'lık rastgele okumaların
+// LLC'de tutunamadığı durum. LLC miss'ler perf_event ile sayılır (yoksa n/a).
+
+#define PRBS_ENGINE_BENCH_PKTS   1024
+#define PRBS_ENGINE_BENCH_STRIDE 1536
+#define PRBS_ENGINE_BENCH_ROUNDS 256
+
+static int prbs_llc_open(void)
+{
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static void prbs_engine_flush(const struct prbs_window *w, const uint64_t *offs)
+{
+#if defined(__x86_64__)
+    for (uint32_t k = 0; k < PRBS_ENGINE_BENCH_PKTS; k++) {
+        const uint8_t *exp = prbs_window_at(w, offs[k], PRBS_BENCH_LEN);
+        for (uint32_t b = 0; b < PRBS_BENCH_LEN + 64; b += 64)
+            _mm_clflush(exp + b);
+    }
+    _mm_mfence();
+#else
+    (void)w;
+    (void)offs;
+#endif
+}
+
+static void prbs_engine_bench_run(const char *name, const struct prbs_window *w,
+                                  const uint8_t *pkts, const uint64_t *offs,
+                                  bool lfsr, bool cold, int llc_fd)
+{
+    uint64_t cycles = 0, bits = 0, misses = 0;
+
+    if (llc_fd >= 0)
+        ioctl(llc_fd, PERF_EVENT_IOC_RESET, 0);
+
+    for (uint32_t r = 0; r < PRBS_ENGINE_BENCH_ROUNDS; r++) {
+        if (cold)
+            prbs_engine_flush(w, offs);
+        if (llc_fd >= 0)
+            ioctl(llc_fd, PERF_EVENT_IOC_ENABLE, 0);
+
+        uint64_t start = rte_rdtsc();
+        for (uint32_t k = 0; k < PRBS_ENGINE_BENCH_PKTS; k++)
+            bits += prbs_window_verify(w, offs[k], pkts + (size_t)k * PRBS_ENGINE_BENCH_STRIDE,
+                                       PRBS_BENCH_LEN, lfsr);
+        cycles += rte_rdtsc() - start;
+
+        if (llc_fd >= 0)
+            ioctl(llc_fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+
+    const double nb_pkts = (double)PRBS_ENGINE_BENCH_PKTS * PRBS_ENGINE_BENCH_ROUNDS;
+    const double sec = (double)cycles / (double)rte_get_tsc_hz();
+    char llc[24] = "n/a";
+
+    if (llc_fd >= 0 && read(llc_fd, &misses, sizeof(misses)) == sizeof(misses))
+        snprintf(llc, sizeof(llc), "%.2f", (double)misses / nb_pkts);
+
+    printf("  %-18s %8.1f cyc/pkt %8.2f Mpps  LLC miss/pkt %-8s %s\n",
+           name, (double)cycles / nb_pkts, nb_pkts / sec / 1e6, llc,
+           bits == 0 ? "ok" : "MISMATCH");
+}
+
+static void prbs_engine_benchmark(void)
+{
+    struct prbs_window w;
+    uint8_t *pkts = NULL;
+    uint64_t *offs = NULL;
+
+    if (prbs_window_init(&w, prbs_seq_dpdk_state(0), SOCKET_ID_ANY) != 0) {
+        printf("PRBS engine benchmark: shared sequence not initialized, skipped\n");
+        return;
+    }
+
+    pkts = aligned_alloc(64, (size_t)PRBS_ENGINE_BENCH_PKTS * PRBS_ENGINE_BENCH_STRIDE);
+    offs = malloc(PRBS_ENGINE_BENCH_PKTS * sizeof(*offs));
+    if (!pkts || !offs) {
+        printf("PRBS engine benchmark: allocation failed\n");
+        goto out;
+    }
+
+    // Paket k: rastgele seq, TX ile aynı offset formülü, payload pencereden
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    for (uint32_t k = 0; k < PRBS_ENGINE_BENCH_PKTS; k++) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        offs[k] = ((x >> 16) * (uint64_t)PRBS_BENCH_LEN) % PRBS_CACHE_SIZE;
+        memcpy(pkts + (size_t)k * PRBS_ENGINE_BENCH_STRIDE,
+               prbs_window_at(&w, offs[k], PRBS_BENCH_LEN), PRBS_BENCH_LEN);
+    }
+
+    int llc_fd = prbs_llc_open();
+
+    printf("=== PRBS Verify Engine Benchmark (%u B payload, %u random seqs x %u rounds) ===\n",
+           PRBS_BENCH_LEN, PRBS_ENGINE_BENCH_PKTS, PRBS_ENGINE_BENCH_ROUNDS);
+    prbs_engine_bench_run("cache (warm)", &w, pkts, offs, false, false, llc_fd);
+#if defined(__x86_64__)
+    prbs_engine_bench_run("cache (LLC-cold)", &w, pkts, offs, false, true, llc_fd);
+#endif
+    prbs_engine_bench_run("lfsr (cacheless)", &w, pkts, offs, true, false, llc_fd);
+    printf("\n");
+
+    if (llc_fd >= 0)
+        close(llc_fd);
+out:
+    free(pkts);
+    free(offs);
+    prbs_window_free(&w);
+}
+
+void prbs_verify_benchmark(void)
+{
+    uint8_t *exp = aligned_alloc(64, PRBS_BENCH_BUF_SIZE);
+    uint8_t *good = aligned_alloc(64, PRBS_BENCH_BUF_SIZE);
+    uint8_t *bad = aligned_alloc(64, PRBS_BENCH_BUF_SIZE);
+
+    if (!exp || !good || !bad) {
+        printf("PRBS verify benchmark: allocation failed\n");
+        goto out;
+    }
+
+    uint32_t lfsr = 0x1234567;
+    for (uint32_t i = 0; i < PRBS_BENCH_BUF_SIZE; i++) {
+        lfsr = lfsr * 1103515245u + 12345u;
+        exp[i] = (uint8_t)(lfsr >> 16);
+    }
+    memcpy(good, exp, PRBS_BENCH_BUF_SIZE);
+    memcpy(bad, exp, PRBS_BENCH_BUF_SIZE);
+
+    // Her 64 byte'lık slotta PRBS_BENCH_BAD_BITS bit çevir (her paket hatalı olsun)
+    for (uint32_t i = 0; i + 64 <= PRBS_BENCH_BUF_SIZE; i += 64)
+        for (uint32_t b = 0; b < PRBS_BENCH_BAD_BITS; b++)
+            bad[i + (b * 37) % 64] ^= (uint8_t)(1u << (b & 7));
+    uint32_t bad_bits = prbs_verify_scalar(bad, exp, PRBS_BENCH_LEN);
+
+    printf("\n=== PRBS Verify Benchmark (%u B payload, %u iterations) ===\n",
+           PRBS_BENCH_LEN, PRBS_BENCH_ITERATIONS);
+    prbs_bench_run("legacy-memcmp", prbs_verify_legacy, good, exp, 0);
+    prbs_bench_run("legacy-memcmp", prbs_verify_legacy, bad, exp, bad_bits);
+    for (size_t k = 0; k < PRBS_VERIFY_NB_KERNELS; k++) {
+        if (!prbs_verify_kernels[k].supported())
+            continue;
+        prbs_bench_run(prbs_verify_kernels[k].name, prbs_verify_kernels[k].fn, good, exp, 0);
+        prbs_bench_run(prbs_verify_kernels[k].name, prbs_verify_kernels[k].fn, bad, exp, bad_bits);
+    }
+    printf("  Active kernel: %s\n\n", prbs_verify_name);
+
+    prbs_engine_benchmark();
+
+out:
+    free(exp);
+    free(good);
+    free(bad);
+}
+#endif /* PRBS_VERIFY_BENCH_ENABLED */
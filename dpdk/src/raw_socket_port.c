@@ -1,7 +1,11 @@
 #define _GNU_SOURCE
 #include "raw_socket_port.h"
+#include "raw_xdp.h"
+#include "raw_tx_batch.h"
 #include "packet.h"
 #include "dpdk_external_tx.h"
+#include "prbs_verify.h"
+#include "flow_registry.h"
 #include "socket.h"  // for get_unused_cores()
 #include <stdio.h>
 #include <stdlib.h>
@@ -17,6 +21,7 @@
 #include <netinet/ip.h>
 #include <netinet/udp.h>
 #include <linux/if_packet.h>
+#include <linux/filter.h>
 #include <arpa/inet.h>
 #include <poll.h>
 #include <sched.h>
@@ -31,6 +36,9 @@ struct raw_socket_port raw_ports[MAX_RAW_SOCKET_PORTS];
 struct raw_socket_port_config raw_port_configs[MAX_RAW_SOCKET_PORTS] = RAW_SOCKET_PORTS_CONFIG_INIT;
 int active_raw_port_count = NORMAL_RAW_SOCKET_PORT_COUNT;
 
+uint16_t raw_imix_pattern[IMIX_PATTERN_SIZE] = RAW_IMIX_PATTERN_INIT;
+uint32_t raw_imix_avg_packet_size = RAW_IMIX_AVG_PACKET_SIZE;
+
 static volatile bool *g_stop_flag = NULL;
 
 // ATE mode config (4 port: 12↔14, 13↔15 full-duplex)
@@ -53,7 +61,8 @@ void raw_socket_ports_load_config(bool ate_mode)
 // ==========================================
 // Bu yapı tüm multi-queue RX thread'leri tarafından paylaşılır.
 // PACKET_FANOUT_HASH aynı VL-ID'yi farklı queue'lara dağıtabildiği için
-// global tracking gerekli.
+// global tracking gerekli. VL steering'de (port->rx_vl_steered) her VL'in
+// tek yazarı vardır: RMW yerine relaxed load/store, sıra dışı da sayılır.
 
 // Port 12: VL-ID 4291-4418 (from Port 2,3,4,5)
 #define GLOBAL_SEQ_VL_ID_START_P12 4291
@@ -71,6 +80,7 @@ struct global_vl_seq_state {
     _Atomic uint64_t min_seq;      // İlk görülen sequence
     _Atomic uint64_t max_seq;      // En yüksek sequence
     _Atomic uint64_t rx_count;     // Alınan paket sayısı
+    _Atomic uint64_t reordered;    // Max'tan küçük seq: geç / tekrar (sadece VL steering'de)
     _Atomic bool initialized;      // İlk paket alındı mı?
 };
 
@@ -88,6 +98,7 @@ void reset_global_sequence_tracking(void)
         atomic_store(&g_vl_seq_p12[i].min_seq, UINT64_MAX);
         atomic_store(&g_vl_seq_p12[i].max_seq, 0);
         atomic_store(&g_vl_seq_p12[i].rx_count, 0);
+        atomic_store(&g_vl_seq_p12[i].reordered, 0);
         atomic_store(&g_vl_seq_p12[i].initialized, false);
     }
     // Reset Port 13 tracking
@@ -95,6 +106,7 @@ void reset_global_sequence_tracking(void)
         atomic_store(&g_vl_seq_p13[i].min_seq, UINT64_MAX);
         atomic_store(&g_vl_seq_p13[i].max_seq, 0);
         atomic_store(&g_vl_seq_p13[i].rx_count, 0);
+        atomic_store(&g_vl_seq_p13[i].reordered, 0);
         atomic_store(&g_vl_seq_p13[i].initialized, false);
     }
     atomic_store(&g_seq_tracking_reset, false);
@@ -136,6 +148,15 @@ uint64_t get_global_sequence_lost_p13(void)
     return total_lost;
 }
 
+// Sıra dışı gelen paketler (VL steering aktifken, aksi halde 0)
+static uint64_t global_sequence_reordered(const struct global_vl_seq_state *t, int count)
+{
+    uint64_t total = 0;
+    for (int i = 0; i < count; i++)
+        total += atomic_load_explicit(&t[i].reordered, memory_order_relaxed);
+    return total;
+}
+
 // Debug: Print per-VL-ID sequence statistics
 void print_global_sequence_debug(void)
 {
@@ -245,7 +266,7 @@ void init_raw_rate_limiter_smooth(struct raw_rate_limiter *limiter, uint32_t rat
     // bytes_per_sec = rate_mbps * 1000000 / 8
     uint64_t bytes_per_sec = (uint64_t)rate_mbps * 125000ULL;
 #if IMIX_ENABLED
-    uint64_t packets_per_sec = bytes_per_sec / RAW_IMIX_AVG_PACKET_SIZE;
+    uint64_t packets_per_sec = bytes_per_sec / raw_imix_avg_packet_size;
 #else
     uint64_t packets_per_sec = bytes_per_sec / RAW_PKT_TOTAL_SIZE;
 #endif
@@ -348,52 +369,29 @@ bool raw_consume_tokens(struct raw_rate_limiter *limiter, uint64_t bytes)
 // PRBS-31 CACHE INITIALIZATION
 // ==========================================
 
-#define PRBS31_TAP1 31
-#define PRBS31_TAP2 28
-#define RAW_PRBS_CACHE_SIZE (268435456)
-
-static uint32_t prbs31_next(uint32_t state)
-{
-    uint32_t bit = ((state >> (PRBS31_TAP1 - 1)) ^ (state >> (PRBS31_TAP2 - 1))) & 1;
-    return ((state << 1) | bit) & 0x7FFFFFFF;
-}
+#define RAW_PRBS_CACHE_SIZE PRBS_CACHE_SIZE
 
+/**
+ * Raw portun PRBS penceresini paylaşılan diziye bağla
+ * Eski sola kaydırmalı LFSR (taps 31/28, seed 0x0F + port_id + 100) aynı
+ * m-dizisinin bir fazıdır; byte'lar eski 256 MB cache ile birebir aynıdır.
+ * Raw soketler NUMA'ya bağlı değil, ilk replica kullanılır.
+ */
 int init_raw_prbs_cache(struct raw_socket_port *port)
 {
     if (port->prbs_initialized) return 0;
 
-    printf("[Raw Port %d] Initializing PRBS cache (~256MB)...\n", port->port_id);
-
-    port->prbs_cache = aligned_alloc(4096, RAW_PRBS_CACHE_SIZE);
-    if (!port->prbs_cache) {
-        fprintf(stderr, "[Raw Port %d] Failed to allocate PRBS cache\n", port->port_id);
-        return -1;
-    }
+    printf("[Raw Port %d] Attaching PRBS window to shared sequence...\n", port->port_id);
 
-    size_t ext_size = RAW_PRBS_CACHE_SIZE + RAW_PKT_PRBS_BYTES;
-    port->prbs_cache_ext = aligned_alloc(4096, ext_size);
-    if (!port->prbs_cache_ext) {
-        fprintf(stderr, "[Raw Port %d] Failed to allocate PRBS cache ext\n", port->port_id);
-        free(port->prbs_cache);
+    if (prbs_window_init(&port->prbs_win, prbs_seq_raw_state(port->port_id),
+                         SOCKET_ID_ANY) != 0) {
+        fprintf(stderr, "[Raw Port %d] Failed to set up PRBS window\n", port->port_id);
         return -1;
     }
 
-    uint32_t state = 0x0000000F + port->port_id + 100;
-
-    for (size_t i = 0; i < RAW_PRBS_CACHE_SIZE; i++) {
-        uint8_t byte_val = 0;
-        for (int b = 0; b < 8; b++) {
-            state = prbs31_next(state);
-            byte_val = (byte_val << 1) | (state & 1);
-        }
-        port->prbs_cache[i] = byte_val;
-    }
-
-    memcpy(port->prbs_cache_ext, port->prbs_cache, RAW_PRBS_CACHE_SIZE);
-    memcpy(port->prbs_cache_ext + RAW_PRBS_CACHE_SIZE, port->prbs_cache, RAW_PKT_PRBS_BYTES);
-
     port->prbs_initialized = true;
-    printf("[Raw Port %d] PRBS cache initialized\n", port->port_id);
+    printf("[Raw Port %d] PRBS window at sequence byte %u\n", port->port_id,
+           port->prbs_win.phase);
 
     return 0;
 }
@@ -543,7 +541,6 @@ int build_raw_packet_dynamic(uint8_t *buffer, const uint8_t *src_mac,
 // IMIX paket boyutu al (raw socket için - VLAN'sız)
 static inline uint16_t get_raw_imix_packet_size(uint64_t pkt_counter, uint8_t worker_offset)
 {
-    static const uint16_t raw_imix_pattern[IMIX_PATTERN_SIZE] = RAW_IMIX_PATTERN_INIT;
     return raw_imix_pattern[(pkt_counter + worker_offset) % IMIX_PATTERN_SIZE];
 }
 
@@ -737,6 +734,154 @@ int setup_raw_rx_ring(struct raw_socket_port *port)
 // MULTI-QUEUE RX SETUP (PACKET_FANOUT)
 // ==========================================
 
+#if RAW_SOCKET_RX_TPACKET_V3
+// TPACKET_V3 blok ring'i; kernel reddederse -1 (soket V2 için hâlâ kullanılabilir,
+// PACKET_VERSION ring kurulmadan değiştirilebilir)
+static int mq_setup_rx_ring_v3(struct raw_socket_port *port, struct raw_rx_queue *queue)
+{
+    int version = TPACKET_V3;
+    if (setsockopt(queue->socket_fd, SOL_PACKET, PACKET_VERSION,
+                   &version, sizeof(version)) < 0) {
+        fprintf(stderr, "[Port %u Q%u] TPACKET_V3 not supported (%s), using TPACKET_V2\n",
+                port->port_id, queue->queue_id, strerror(errno));
+        return -1;
+    }
+
+    struct tpacket_req3 req = {0};
+    req.tp_block_size = RAW_SOCKET_V3_BLOCK_SIZE;
+    req.tp_block_nr = RAW_SOCKET_V3_BLOCK_NR;
+    req.tp_frame_size = RAW_SOCKET_RING_FRAME_SIZE;   // V3'te sadece doğrulama için
+    req.tp_frame_nr = (RAW_SOCKET_V3_BLOCK_SIZE / RAW_SOCKET_RING_FRAME_SIZE) * RAW_SOCKET_V3_BLOCK_NR;
+    req.tp_retire_blk_tov = RAW_SOCKET_V3_RETIRE_TOV_MS;
+
+    if (setsockopt(queue->socket_fd, SOL_PACKET, PACKET_RX_RING,
+                   &req, sizeof(req)) < 0) {
+        fprintf(stderr, "[Port %u Q%u] TPACKET_V3 RX ring failed (%s), using TPACKET_V2\n",
+                port->port_id, queue->queue_id, strerror(errno));
+        return -1;
+    }
+
+    queue->ring_size = (size_t)req.tp_block_size * req.tp_block_nr;
+    queue->ring = mmap(NULL, queue->ring_size,
+                       PROT_READ | PROT_WRITE, MAP_SHARED,
+                       queue->socket_fd, 0);
+    if (queue->ring == MAP_FAILED) {
+        fprintf(stderr, "[Port %u Q%u] Failed to mmap V3 ring: %s\n",
+                port->port_id, queue->queue_id, strerror(errno));
+        queue->ring = NULL;
+        return -2;
+    }
+
+    queue->tpacket_v3 = true;
+    queue->block_nr = req.tp_block_nr;
+    return 0;
+}
+#endif
+
+static int mq_setup_rx_ring(struct raw_socket_port *port, struct raw_rx_queue *queue)
+{
+    queue->tpacket_v3 = false;
+#if RAW_SOCKET_RX_TPACKET_V3
+    const int ret = mq_setup_rx_ring_v3(port, queue);
+    if (ret == 0)
+        return 0;
+    if (ret == -2)
+        return -1;      // Ring kuruldu ama map edilemedi: V2'ye dönülemez
+#endif
+
+    // Set TPACKET_V2
+    int version = TPACKET_V2;
+    if (setsockopt(queue->socket_fd, SOL_PACKET, PACKET_VERSION,
+                   &version, sizeof(version)) < 0) {
+        fprintf(stderr, "[Port %u Q%u] Failed to set TPACKET_V2: %s\n",
+                port->port_id, queue->queue_id, strerror(errno));
+        return -1;
+    }
+
+    struct tpacket_req req = {0};
+    req.tp_block_size = RAW_SOCKET_RING_BLOCK_SIZE;
+    req.tp_block_nr = RAW_SOCKET_RING_BLOCK_NR;
+    req.tp_frame_size = RAW_SOCKET_RING_FRAME_SIZE;
+    req.tp_frame_nr = RAW_SOCKET_RING_FRAME_NR;
+
+    if (setsockopt(queue->socket_fd, SOL_PACKET, PACKET_RX_RING,
+                   &req, sizeof(req)) < 0) {
+        fprintf(stderr, "[Port %u Q%u] Failed to setup RX ring: %s\n",
+                port->port_id, queue->queue_id, strerror(errno));
+        return -1;
+    }
+
+    queue->ring_size = req.tp_block_size * req.tp_block_nr;
+    queue->ring = mmap(NULL, queue->ring_size,
+                       PROT_READ | PROT_WRITE, MAP_SHARED,
+                       queue->socket_fd, 0);
+    if (queue->ring == MAP_FAILED) {
+        fprintf(stderr, "[Port %u Q%u] Failed to mmap ring: %s\n",
+                port->port_id, queue->queue_id, strerror(errno));
+        queue->ring = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+// Queue soketini portun fanout grubuna ekle. İlk soket grubun tipini
+// belirler: VL steering (CBPF) kurulamazsa tüm grup PACKET_FANOUT_HASH.
+static int mq_join_fanout(struct raw_socket_port *port, struct raw_rx_queue *queue)
+{
+    // Use port_id in group ID to ensure each port has unique fanout group
+    const uint16_t fanout_group_id = (RAW_SOCKET_FANOUT_GROUP_ID + port->port_id) & 0xFFFF;
+    int fanout_arg;
+
+#if RAW_SOCKET_FANOUT_VL_STEER
+    if (queue->queue_id == 0 || port->rx_vl_steered) {
+        // A = DST MAC[4..5] (VL-ID, ingress'te data IP header'da: SKF_LL_OFF),
+        // kernel dönüşü grup üye sayısına böler → soket = VL-ID % queue sayısı
+        static struct sock_filter vl_hash[] = {
+            BPF_STMT(BPF_LD | BPF_H | BPF_ABS, SKF_LL_OFF + 4),
+            BPF_STMT(BPF_RET | BPF_A, 0),
+        };
+        struct sock_fprog fprog = {
+            .len = sizeof(vl_hash) / sizeof(vl_hash[0]),
+            .filter = vl_hash,
+        };
+
+        fanout_arg = fanout_group_id | (PACKET_FANOUT_CBPF << 16);
+        if (setsockopt(queue->socket_fd, SOL_PACKET, PACKET_FANOUT,
+                       &fanout_arg, sizeof(fanout_arg)) == 0) {
+            if (queue->queue_id > 0)
+                return 0;
+            // Program grup başına bir kez; grup programsız kalırsa her şey Q0'a gider
+            if (setsockopt(queue->socket_fd, SOL_PACKET, PACKET_FANOUT_DATA,
+                           &fprog, sizeof(fprog)) < 0) {
+                fprintf(stderr, "[Port %u] Fanout VL steering program rejected: %s\n",
+                        port->port_id, strerror(errno));
+                return -1;
+            }
+            port->rx_vl_steered = true;
+            printf("[Port %u] Fanout: VL-ID steering (CBPF, DST MAC byte 4-5)\n", port->port_id);
+            return 0;
+        }
+        if (queue->queue_id > 0) {
+            fprintf(stderr, "[Port %u Q%u] Failed to join CBPF fanout: %s\n",
+                    port->port_id, queue->queue_id, strerror(errno));
+            return -1;
+        }
+        printf("[Port %u] Fanout CBPF not supported (%s), using PACKET_FANOUT_HASH\n",
+               port->port_id, strerror(errno));
+    }
+#endif
+
+    // PACKET_FANOUT_HASH distributes based on packet hash (src/dst IP+port)
+    fanout_arg = fanout_group_id | (PACKET_FANOUT_HASH << 16);
+    if (setsockopt(queue->socket_fd, SOL_PACKET, PACKET_FANOUT,
+                   &fanout_arg, sizeof(fanout_arg)) < 0) {
+        fprintf(stderr, "[Port %u Q%u] Failed to set PACKET_FANOUT: %s\n",
+                port->port_id, queue->queue_id, strerror(errno));
+        // Continue without fanout - will still work but may have contention
+    }
+    return 0;
+}
+
 int setup_multi_queue_rx(struct raw_socket_port *port)
 {
     // Determine queue count based on port type (1G=4 queues, 100M=2 queues)
@@ -775,38 +920,8 @@ int setup_multi_queue_rx(struct raw_socket_port *port)
             return -1;
         }
 
-        // Set TPACKET_V2
-        int version = TPACKET_V2;
-        if (setsockopt(queue->socket_fd, SOL_PACKET, PACKET_VERSION,
-                       &version, sizeof(version)) < 0) {
-            fprintf(stderr, "[Port %u Q%d] Failed to set TPACKET_V2: %s\n",
-                    port->port_id, q, strerror(errno));
-            close(queue->socket_fd);
-            return -1;
-        }
-
-        // Setup RX ring buffer
-        struct tpacket_req req = {0};
-        req.tp_block_size = RAW_SOCKET_RING_BLOCK_SIZE;
-        req.tp_block_nr = RAW_SOCKET_RING_BLOCK_NR;
-        req.tp_frame_size = RAW_SOCKET_RING_FRAME_SIZE;
-        req.tp_frame_nr = RAW_SOCKET_RING_FRAME_NR;
-
-        if (setsockopt(queue->socket_fd, SOL_PACKET, PACKET_RX_RING,
-                       &req, sizeof(req)) < 0) {
-            fprintf(stderr, "[Port %u Q%d] Failed to setup RX ring: %s\n",
-                    port->port_id, q, strerror(errno));
-            close(queue->socket_fd);
-            return -1;
-        }
-
-        queue->ring_size = req.tp_block_size * req.tp_block_nr;
-        queue->ring = mmap(NULL, queue->ring_size,
-                           PROT_READ | PROT_WRITE, MAP_SHARED,
-                           queue->socket_fd, 0);
-        if (queue->ring == MAP_FAILED) {
-            fprintf(stderr, "[Port %u Q%d] Failed to mmap ring: %s\n",
-                    port->port_id, q, strerror(errno));
+        // Setup RX ring buffer (V3 blok modu, olmazsa V2)
+        if (mq_setup_rx_ring(port, queue) < 0) {
             close(queue->socket_fd);
             return -1;
         }
@@ -826,15 +941,10 @@ int setup_multi_queue_rx(struct raw_socket_port *port)
         }
 
         // Setup PACKET_FANOUT for load distribution across queues
-        // PACKET_FANOUT_HASH distributes based on packet hash (src/dst IP+port)
-        // Use port_id in group ID to ensure each port has unique fanout group
-        uint16_t fanout_group_id = (RAW_SOCKET_FANOUT_GROUP_ID + port->port_id) & 0xFFFF;
-        int fanout_arg = fanout_group_id | (PACKET_FANOUT_HASH << 16);
-        if (setsockopt(queue->socket_fd, SOL_PACKET, PACKET_FANOUT,
-                       &fanout_arg, sizeof(fanout_arg)) < 0) {
-            fprintf(stderr, "[Port %u Q%d] Failed to set PACKET_FANOUT: %s\n",
-                    port->port_id, q, strerror(errno));
-            // Continue without fanout - will still work but may have contention
+        if (mq_join_fanout(port, queue) < 0) {
+            munmap(queue->ring, queue->ring_size);
+            close(queue->socket_fd);
+            return -1;
         }
 
         // Set promiscuous mode
@@ -844,10 +954,14 @@ int setup_multi_queue_rx(struct raw_socket_port *port)
         setsockopt(queue->socket_fd, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &mreq, sizeof(mreq));
 
         queue->ring_offset = 0;
-        printf("  Queue %d: socket=%d, ring=%zu KB, CPU core=%u\n",
-               q, queue->socket_fd, queue->ring_size / 1024, queue->cpu_core);
+        printf("  Queue %d: socket=%d, ring=%zu KB (TPACKET_V%d), CPU core=%u\n",
+               q, queue->socket_fd, queue->ring_size / 1024, queue->tpacket_v3 ? 3 : 2,
+               queue->cpu_core);
     }
 
+    // Tek queue'da da her VL'in tek yazarı var
+    if (port->rx_queue_count == 1)
+        port->rx_vl_steered = true;
     port->use_multi_queue_rx = true;
     printf("=== Multi-Queue RX Setup Complete ===\n");
     return 0;
@@ -950,20 +1064,8 @@ int init_raw_socket_port(int raw_index, const struct raw_socket_port_config *con
         }
 #endif
 
-        // Allocate VL-ID sequence trackers
-        target->vl_sequences = calloc(target->config.vl_id_count, sizeof(struct raw_vl_sequence));
-        if (!target->vl_sequences) {
-            fprintf(stderr, "[Port %u] Failed to allocate TX VL sequences for target %d\n",
-                    config->port_id, t);
-            return -1;
-        }
-
-        for (uint16_t i = 0; i < target->config.vl_id_count; i++) {
-            pthread_spin_init(&target->vl_sequences[i].tx_lock, PTHREAD_PROCESS_PRIVATE);
-            pthread_spin_init(&target->vl_sequences[i].rx_lock, PTHREAD_PROCESS_PRIVATE);
-        }
-
-        pthread_spin_init(&target->stats.lock, PTHREAD_PROCESS_PRIVATE);
+        // TX sequence bloğu TX worker başında oluşturulur (raw_attach_tx_seq_blocks)
+        target->tx_seq = NULL;
     }
 
     // Initialize RX sources
@@ -981,19 +1083,27 @@ int init_raw_socket_port(int raw_index, const struct raw_socket_port_config *con
         }
 
         for (uint16_t i = 0; i < source->config.vl_id_count; i++) {
-            pthread_spin_init(&source->vl_sequences[i].tx_lock, PTHREAD_PROCESS_PRIVATE);
             pthread_spin_init(&source->vl_sequences[i].rx_lock, PTHREAD_PROCESS_PRIVATE);
         }
+    }
 
-        pthread_spin_init(&source->stats.lock, PTHREAD_PROCESS_PRIVATE);
+    // Sayaçlar worker'ların stats shard'larında (worker başlarken oluşturulur)
+
+    // AF_XDP backend: TX ve RX aynı UMEM'de; kurulamazsa AF_PACKET
+    if (config->backend == RAW_BACKEND_AF_XDP && raw_xdp_port_open(port) < 0) {
+        fprintf(stderr, "[Port %u] AF_XDP setup failed, falling back to AF_PACKET\n",
+                port->port_id);
     }
 
-    // Initialize DPDK External RX stats (separate from raw socket sources)
-    memset(&port->dpdk_ext_rx_stats, 0, sizeof(port->dpdk_ext_rx_stats));
-    pthread_spin_init(&port->dpdk_ext_rx_stats.lock, PTHREAD_PROCESS_PRIVATE);
+    // TX gönderim yolu: sendmmsg / io_uring kurulamazsa TX ring
+    if (port->xdp == NULL && config->tx_submit != RAW_TX_SUBMIT_RING &&
+        raw_tx_batch_open(port, config->tx_submit) < 0) {
+        fprintf(stderr, "[Port %u] %s TX setup failed, falling back to TX ring\n",
+                port->port_id, raw_tx_submit_name(config->tx_submit));
+    }
 
     // Setup TX ring
-    if (setup_raw_tx_ring(port) < 0) return -1;
+    if (port->xdp == NULL && port->tx_batch == NULL && setup_raw_tx_ring(port) < 0) return -1;
 
     // Allocate dedicated CPU core for TX thread
     uint16_t tx_core = 0;
@@ -1011,20 +1121,30 @@ int init_raw_socket_port(int raw_index, const struct raw_socket_port_config *con
     // Setup RX - multi-queue for Port 12 and Port 13
     // Port 12: Multi-queue RX for high throughput DPDK external packets
     // Port 13: Multi-queue RX for better packet distribution
-    printf("[Port %u] Setting up multi-queue RX (PACKET_FANOUT)\n", port->port_id);
-    if (setup_multi_queue_rx(port) < 0) {
-        fprintf(stderr, "[Port %u] Failed to setup multi-queue RX, falling back to single queue\n",
-                port->port_id);
-        // Fallback to single queue
-        if (setup_raw_rx_ring(port) < 0) {
-            munmap(port->tx_ring, port->tx_ring_size);
-            close(port->tx_socket);
-            return -1;
+    // (AF_XDP: queue'lar raw_xdp_port_open'da kuruldu)
+    if (port->xdp == NULL) {
+        printf("[Port %u] Setting up multi-queue RX (PACKET_FANOUT)\n", port->port_id);
+        if (setup_multi_queue_rx(port) < 0) {
+            fprintf(stderr, "[Port %u] Failed to setup multi-queue RX, falling back to single queue\n",
+                    port->port_id);
+            // Fallback to single queue
+            if (setup_raw_rx_ring(port) < 0) {
+                raw_tx_batch_close(port);
+                munmap(port->tx_ring, port->tx_ring_size);
+                close(port->tx_socket);
+                return -1;
+            }
         }
     }
 
     // Initialize PRBS cache
     if (init_raw_prbs_cache(port) < 0) {
+        if (port->xdp) {
+            port->use_multi_queue_rx = false;
+            raw_xdp_port_close(port);
+            return -1;
+        }
+        raw_tx_batch_close(port);
         munmap(port->tx_ring, port->tx_ring_size);
         if (port->use_multi_queue_rx) {
             stop_multi_queue_rx_workers(port);  // Cleanup multi-queue
@@ -1036,8 +1156,10 @@ int init_raw_socket_port(int raw_index, const struct raw_socket_port_config *con
         return -1;
     }
 
-    printf("[Port %u] Initialization complete%s\n", port->port_id,
-           port->use_multi_queue_rx ? " (multi-queue RX)" : "");
+    printf("[Port %u] Initialization complete%s, TX: %s\n", port->port_id,
+           port->xdp ? " (AF_XDP)" : port->use_multi_queue_rx ? " (multi-queue RX)" : "",
+           port->xdp ? "XSK" : raw_tx_submit_name(port->tx_batch ? port->tx_batch->mode
+                                                                  : RAW_TX_SUBMIT_RING));
     return 0;
 }
 
@@ -1060,14 +1182,208 @@ int init_raw_socket_ports(void)
     return 0;
 }
 
+// ==========================================
+// TX HEADER TEMPLATES
+// ==========================================
+
+#define RAW_PKT_HDR_LEN (RAW_PKT_ETH_HDR_SIZE + RAW_PKT_IP_HDR_SIZE + RAW_PKT_UDP_HDR_SIZE)
+
+// Target içindeki VL index'inden VL-ID hesapla
+static inline uint16_t raw_target_vl_id(const struct raw_socket_port *port,
+                                        const struct raw_tx_target_state *target,
+                                        uint16_t vl_index)
+{
+#if TOKEN_BUCKET_TX_ENABLED
+    // Token bucket: Non-contiguous VL-ID ranges
+    // Port 12: 4'lü bloklar, 8 step (block_size=4, step=8)
+    // Port 13: tekil VL, 4 step (block_size=1, step=4)
+    uint16_t tb_block_size, tb_block_step;
+    if (port->port_id == 12) {
+        tb_block_size = TB_PORT_12_VL_BLOCK_SIZE;
+        tb_block_step = TB_PORT_12_VL_BLOCK_STEP;
+    } else {
+        tb_block_size = TB_PORT_13_VL_BLOCK_SIZE;
+        tb_block_step = TB_PORT_13_VL_BLOCK_STEP;
+    }
+    uint16_t block = vl_index / tb_block_size;
+    uint16_t offset_in_block = vl_index % tb_block_size;
+    return target->config.vl_id_start + block * tb_block_step + offset_in_block;
+#else
+    (void)port;
+    return target->config.vl_id_start + vl_index;
+#endif
+}
+
+/**
+ * Her target'ın VL-ID'leri için header template'lerini render et
+ * build_raw_packet bir kez çalıştırılıp ilk 64 byte saklanır (byte-birebir aynı).
+ */
+static int raw_build_hdr_templates(struct raw_socket_port *port)
+{
+    uint8_t scratch[RAW_PKT_TOTAL_SIZE];
+
+    for (int t = 0; t < port->tx_target_count; t++) {
+        struct raw_tx_target_state *target = &port->tx_targets[t];
+        size_t bytes = (size_t)target->config.vl_id_count * sizeof(struct hdr_template);
+
+        target->hdr_templates = aligned_alloc(RTE_CACHE_LINE_SIZE, bytes);
+        if (!target->hdr_templates) {
+            printf("[Port %u TX] Error: header template allocation failed (target %d)\n",
+                   port->port_id, t);
+            return -1;
+        }
+
+        for (uint16_t i = 0; i < target->config.vl_id_count; i++) {
+            build_raw_packet(scratch, port->mac_addr, raw_target_vl_id(port, target, i),
+                             0, port->prbs_win.base);
+            memcpy(target->hdr_templates[i].bytes, scratch, HDR_TEMPLATE_SIZE);
+        }
+    }
+    return 0;
+}
+
+/**
+ * Her target için TX worker'a ait sequence bloğunu al (lock'suz, dense)
+ * Token bucket modunda blok/step düzeni raw_target_vl_id ile aynıdır.
+ */
+static int raw_attach_tx_seq_blocks(struct raw_socket_port *port)
+{
+    for (int t = 0; t < port->tx_target_count; t++) {
+        struct raw_tx_target_state *target = &port->tx_targets[t];
+        uint16_t count = target->config.vl_id_count;
+#if TOKEN_BUCKET_TX_ENABLED
+        uint16_t block_size = (port->port_id == 12) ? TB_PORT_12_VL_BLOCK_SIZE : TB_PORT_13_VL_BLOCK_SIZE;
+        uint16_t block_step = (port->port_id == 12) ? TB_PORT_12_VL_BLOCK_STEP : TB_PORT_13_VL_BLOCK_STEP;
+#else
+        uint16_t block_size = count;
+        uint16_t block_step = count;
+#endif
+        target->tx_seq = tx_seq_block_create(TX_SEQ_DOMAIN_RAW, port->port_id,
+                                             target->config.vl_id_start, count,
+                                             block_size, block_step, SOCKET_ID_ANY);
+        if (!target->tx_seq) {
+            printf("[Port %u TX] Error: sequence block allocation failed (target %d)\n",
+                   port->port_id, t);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void raw_free_hdr_templates(struct raw_socket_port *port)
+{
+    for (int t = 0; t < port->tx_target_count; t++) {
+        free(port->tx_targets[t].hdr_templates);
+        port->tx_targets[t].hdr_templates = NULL;
+    }
+}
+
 // ==========================================
 // TX WORKER (Multi-Target with Smooth Pacing)
+// ==========================================
+// TX FRAME BACKEND (AF_PACKET TX ring / sendmmsg / io_uring / AF_XDP UMEM)
+// ==========================================
+
+static inline bool raw_tx_stopping(const struct raw_socket_port *port)
+{
+    return port->stop_flag || (g_stop_flag && *g_stop_flag);
+}
+
+// Biriken frame'leri kernel'e ver
+// @return gönderilemeyen frame sayısı (batch yolları), kick hatasında -1
+static inline int raw_tx_flush(struct raw_socket_port *port)
+{
+    if (port->xdp)
+        return raw_xdp_tx_kick(port->xdp);
+    if (port->tx_batch)
+        return (int)raw_tx_batch_submit(port->tx_batch);
+    return send(port->tx_socket, NULL, 0, 0) < 0 ? -1 : 0;
+}
+
+// Sıradaki boş TX frame'inin veri alanı (NULL = stop). Beklerken birikmiş
+// batch gönderilir ki ring / UMEM havuzu boşalsın.
+static uint8_t *raw_tx_frame_acquire(struct raw_socket_port *port, uint32_t *batch_count)
+{
+    int wait_count = 0;
+
+    if (port->xdp) {
+        uint8_t *frame;
+        while ((frame = raw_xdp_tx_frame(port->xdp)) == NULL) {
+            if (raw_tx_stopping(port))
+                return NULL;
+            // Copy mode'da TX sadece kick ile ilerler: her turda
+            raw_xdp_tx_kick(port->xdp);
+            *batch_count = 0;
+            if (++wait_count > 100) {
+                struct pollfd pfd = {port->xdp->queues[0].fd, POLLOUT, 0};
+                poll(&pfd, 1, 1);
+                wait_count = 0;
+            }
+        }
+        return frame;
+    }
+
+    if (port->tx_batch) {
+        uint8_t *frame;
+        // Batch dolu veya havuz uçuşta: gönder / completion bekle (poll yok)
+        while ((frame = raw_tx_batch_frame(port->tx_batch)) == NULL) {
+            if (raw_tx_stopping(port))
+                return NULL;
+            raw_tx_batch_wait(port->tx_batch);
+            *batch_count = 0;
+        }
+        return frame;
+    }
+
+    struct tpacket2_hdr *hdr = (struct tpacket2_hdr *)(
+        (uint8_t *)port->tx_ring +
+        (port->tx_ring_offset * RAW_SOCKET_RING_FRAME_SIZE));
+
+    // Wait for frame to be available
+    while (hdr->tp_status != TP_STATUS_AVAILABLE) {
+        if (raw_tx_stopping(port))
+            return NULL;
+        // Flush pending packets if waiting
+        if (*batch_count > 0) {
+            send(port->tx_socket, NULL, 0, 0);
+            *batch_count = 0;
+        }
+        if (++wait_count > 100) {
+            struct pollfd pfd = {port->tx_socket, POLLOUT, 0};
+            poll(&pfd, 1, 1);
+            wait_count = 0;
+        }
+    }
+    return (uint8_t *)hdr + TPACKET2_HDRLEN - sizeof(struct sockaddr_ll);
+}
+
+// Frame'i gönderime işaretle (gönderim raw_tx_flush ile)
+static inline void raw_tx_frame_commit(struct raw_socket_port *port, uint8_t *frame_data,
+                                       uint16_t pkt_size)
+{
+    if (port->xdp) {
+        raw_xdp_tx_submit(port->xdp, frame_data, pkt_size);
+        return;
+    }
+    if (port->tx_batch) {
+        raw_tx_batch_add(port->tx_batch, frame_data, pkt_size);
+        return;
+    }
+
+    struct tpacket2_hdr *hdr = (struct tpacket2_hdr *)(
+        frame_data - (TPACKET2_HDRLEN - sizeof(struct sockaddr_ll)));
+    hdr->tp_len = pkt_size;
+    hdr->tp_status = TP_STATUS_SEND_REQUEST;
+
+    // Advance ring offset
+    port->tx_ring_offset = (port->tx_ring_offset + 1) % RAW_SOCKET_RING_FRAME_NR;
+}
+
 // ==========================================
 
 void *raw_tx_worker(void *arg)
 {
     struct raw_socket_port *port = (struct raw_socket_port *)arg;
-    uint8_t packet_buffer[RAW_PKT_TOTAL_SIZE];  // Max boyut
     bool first_tx[MAX_RAW_TARGETS] = {false};
 
 #if IMIX_ENABLED
@@ -1082,13 +1398,18 @@ void *raw_tx_worker(void *arg)
 #elif IMIX_ENABLED
     printf("[Port %u TX Worker] Started with %u targets (IMIX MODE + SMOOTH PACING)\n",
            port->port_id, port->tx_target_count);
-    printf("[Port %u TX] IMIX pattern: 96, 196, 396, 796, 1196x3, 1514x3 (avg=%d bytes)\n",
-           port->port_id, RAW_IMIX_AVG_PACKET_SIZE);
+    printf("[Port %u TX] IMIX pattern: %d entries (avg=%u bytes)\n",
+           port->port_id, IMIX_PATTERN_SIZE, raw_imix_avg_packet_size);
 #else
     printf("[Port %u TX Worker] Started with %u targets (INTERLEAVED SMOOTH PACING)\n",
            port->port_id, port->tx_target_count);
 #endif
 
+    if (raw_build_hdr_templates(port) != 0 || raw_attach_tx_seq_blocks(port) != 0) {
+        raw_free_hdr_templates(port);
+        return NULL;
+    }
+
     port->tx_running = true;
 
     // Print target info
@@ -1142,12 +1463,22 @@ void *raw_tx_worker(void *arg)
     const uint32_t BATCH_SIZE = 16;  // Reduced batch for lower burst (was 64)
     const uint32_t MAX_CATCHUP_PER_TARGET = 4;   // Max catch-up per target per round (was 64)
 #endif
-    const uint64_t STATS_FLUSH_INTERVAL = 1024;    // Flush local stats every N packets (smaller = more accurate rate display)
-
-    // Local stats accumulators per target (avoid per-packet lock)
-    uint64_t local_tx_packets[MAX_RAW_TARGETS] = {0};
-    uint64_t local_tx_bytes[MAX_RAW_TARGETS] = {0};
-    uint64_t local_tx_errors[MAX_RAW_TARGETS] = {0};
+    // Local stats accumulators per target, her send() turu sonunda
+    // target'ın shard'ına yayınlanır (lock / flush eşiği yok)
+    struct stats_counters tx_lc[MAX_RAW_TARGETS];
+    struct stats_shard *tx_stats[MAX_RAW_TARGETS];
+    memset(tx_lc, 0, sizeof(tx_lc));
+    for (int t = 0; t < port->tx_target_count; t++) {
+        tx_stats[t] = stats_shard_create(STATS_DOM_RAW_TX, (uint16_t)port->raw_index,
+                                         (uint16_t)t, 0, SOCKET_ID_ANY);
+        if (tx_stats[t] == NULL) {
+            fprintf(stderr, "[Port %u TX] Cannot allocate stats shard for target %d\n",
+                    port->port_id, t);
+            raw_free_hdr_templates(port);
+            port->tx_running = false;
+            return NULL;
+        }
+    }
     uint64_t total_local_pkts = 0;
 
     while (!port->stop_flag && (g_stop_flag == NULL || !*g_stop_flag)) {
@@ -1178,27 +1509,10 @@ void *raw_tx_worker(void *arg)
 #endif
                 // Get current VL-ID
                 uint16_t vl_index = target->current_vl_offset;
-#if TOKEN_BUCKET_TX_ENABLED
-                // Token bucket: Non-contiguous VL-ID ranges
-                // Port 12: 4'lü bloklar, 8 step (block_size=4, step=8)
-                // Port 13: tekil VL, 4 step (block_size=1, step=4)
-                uint16_t tb_block_size, tb_block_step;
-                if (port->port_id == 12) {
-                    tb_block_size = TB_PORT_12_VL_BLOCK_SIZE;
-                    tb_block_step = TB_PORT_12_VL_BLOCK_STEP;
-                } else {
-                    tb_block_size = TB_PORT_13_VL_BLOCK_SIZE;
-                    tb_block_step = TB_PORT_13_VL_BLOCK_STEP;
-                }
-                uint16_t block = vl_index / tb_block_size;
-                uint16_t offset_in_block = vl_index % tb_block_size;
-                uint16_t vl_id = target->config.vl_id_start + block * tb_block_step + offset_in_block;
-#else
-                uint16_t vl_id = target->config.vl_id_start + target->current_vl_offset;
-#endif
+                uint16_t vl_id = raw_target_vl_id(port, target, vl_index);
 
                 // Peek sequence WITHOUT incrementing — commit after frame is placed in ring
-                uint64_t seq = target->vl_sequences[vl_index].tx_sequence;
+                uint64_t seq = tx_seq_peek(target->tx_seq, vl_index);
 
 #if IMIX_ENABLED
                 // IMIX: Paket boyutunu pattern'den al
@@ -1208,56 +1522,35 @@ void *raw_tx_worker(void *arg)
 
                 // IMIX: PRBS offset hesabı HEP MAX boyut ile yapılır
                 uint64_t prbs_offset = (seq * (uint64_t)RAW_MAX_PRBS_BYTES) % RAW_PRBS_CACHE_SIZE;
-                uint8_t *prbs_data = port->prbs_cache_ext + prbs_offset;
-
-                // Build packet (dinamik boyut)
-                build_raw_packet_dynamic(packet_buffer, port->mac_addr, vl_id, seq,
-                                          prbs_data, prbs_len, pkt_size);
 #else
-                // Get PRBS data
+                const uint16_t pkt_size = RAW_PKT_TOTAL_SIZE;
+                const uint16_t prbs_len = RAW_PKT_PRBS_BYTES;
                 uint64_t prbs_offset = (seq * (uint64_t)RAW_PKT_PRBS_BYTES) % RAW_PRBS_CACHE_SIZE;
-                uint8_t *prbs_data = port->prbs_cache_ext + prbs_offset;
-
-                // Build packet
-                build_raw_packet(packet_buffer, port->mac_addr, vl_id, seq, prbs_data);
-                uint16_t pkt_size = RAW_PKT_TOTAL_SIZE;
 #endif
+                const uint8_t *prbs_data = prbs_window_at(&port->prbs_win, prbs_offset, prbs_len);
 
-                // Get TX frame from ring
-                struct tpacket2_hdr *hdr = (struct tpacket2_hdr *)(
-                    (uint8_t *)port->tx_ring +
-                    (port->tx_ring_offset * RAW_SOCKET_RING_FRAME_SIZE));
-
-                // Wait for frame to be available
-                int wait_count = 0;
-                while (hdr->tp_status != TP_STATUS_AVAILABLE) {
-                    if (port->stop_flag || (g_stop_flag && *g_stop_flag)) {
-                        goto exit_tx;
-                    }
-                    // Flush pending packets if waiting
-                    if (batch_count > 0) {
-                        send(port->tx_socket, NULL, 0, 0);
-                        batch_count = 0;
-                    }
-                    if (++wait_count > 100) {
-                        struct pollfd pfd = {port->tx_socket, POLLOUT, 0};
-                        poll(&pfd, 1, 1);
-                        wait_count = 0;
-                    }
-                }
+                // Get TX frame (AF_PACKET ring veya AF_XDP UMEM)
+                uint8_t *frame_data = raw_tx_frame_acquire(port, &batch_count);
+                if (frame_data == NULL)
+                    goto exit_tx;
 
-                // Copy packet to ring buffer (dinamik boyut)
-                uint8_t *frame_data = (uint8_t *)hdr + TPACKET2_HDRLEN - sizeof(struct sockaddr_ll);
-                memcpy(frame_data, packet_buffer, pkt_size);
-                hdr->tp_len = pkt_size;
-                hdr->tp_status = TP_STATUS_SEND_REQUEST;
+                // Build packet directly in the frame:
+                // hazır header (tek 64 byte kopya) + SEQ + PRBS (ara buffer yok)
+                memcpy(frame_data, target->hdr_templates[vl_index].bytes, HDR_TEMPLATE_SIZE);
+#if IMIX_ENABLED
+                if (pkt_size != RAW_PKT_TOTAL_SIZE)
+                    hdr_template_patch_len(frame_data, RAW_PKT_ETH_HDR_SIZE, pkt_size);
+#endif
+                memcpy(frame_data + RAW_PKT_HDR_LEN, &seq, RAW_PKT_SEQ_BYTES);
+                memcpy(frame_data + RAW_PKT_HDR_LEN + RAW_PKT_SEQ_BYTES, prbs_data, prbs_len);
+                raw_tx_frame_commit(port, frame_data, pkt_size);
 
                 // Commit sequence AFTER frame is placed in ring buffer
-                target->vl_sequences[vl_index].tx_sequence = seq + 1;
+                tx_seq_commit(target->tx_seq, vl_index);
 
                 // Local stats accumulation (no lock)
-                local_tx_packets[t]++;
-                local_tx_bytes[t] += pkt_size;
+                tx_lc[t].pkts++;
+                tx_lc[t].bytes += pkt_size;
                 total_local_pkts++;
 
                 if (!first_tx[t]) {
@@ -1266,18 +1559,15 @@ void *raw_tx_worker(void *arg)
                     first_tx[t] = true;
                 }
 
-                // Advance ring offset
-                port->tx_ring_offset = (port->tx_ring_offset + 1) % RAW_SOCKET_RING_FRAME_NR;
-
                 // Round-robin through VL-IDs
                 target->current_vl_offset = (target->current_vl_offset + 1) % target->config.vl_id_count;
                 any_sent = true;
                 batch_count++;
                 // Flush batch periodically
                 if (batch_count >= BATCH_SIZE) {
-                    if (send(port->tx_socket, NULL, 0, 0) < 0) {
-                        local_tx_errors[t]++;
-                    }
+                    int lost = raw_tx_flush(port);
+                    if (lost != 0)
+                        tx_lc[t].errors += lost < 0 ? 1 : (uint64_t)lost;
                     batch_count = 0;
                 }
             }
@@ -1285,26 +1575,18 @@ void *raw_tx_worker(void *arg)
         }  // end while (any_due) interleaved round-robin
 
         // Flush any remaining packets
+        // (batch target'ları karışık taşır: tur sonu kaybı ilk target'a yazılır)
         if (batch_count > 0) {
-            send(port->tx_socket, NULL, 0, 0);
+            int lost = raw_tx_flush(port);
+            if (lost > 0)
+                tx_lc[0].errors += (uint64_t)lost;
             batch_count = 0;
         }
 
-        // Periodically flush local stats to shared counters
-        if (total_local_pkts >= STATS_FLUSH_INTERVAL) {
-            for (int t = 0; t < port->tx_target_count; t++) {
-                if (local_tx_packets[t] > 0) {
-                    struct raw_tx_target_state *target = &port->tx_targets[t];
-                    pthread_spin_lock(&target->stats.lock);
-                    target->stats.tx_packets += local_tx_packets[t];
-                    target->stats.tx_bytes += local_tx_bytes[t];
-                    target->stats.tx_errors += local_tx_errors[t];
-                    pthread_spin_unlock(&target->stats.lock);
-                    local_tx_packets[t] = 0;
-                    local_tx_bytes[t] = 0;
-                    local_tx_errors[t] = 0;
-                }
-            }
+        // Bu turda gönderilenleri shard'lara yayınla (plain store, tek yazar)
+        if (total_local_pkts > 0) {
+            for (int t = 0; t < port->tx_target_count; t++)
+                stats_shard_publish(tx_stats[t], &tx_lc[t]);
             total_local_pkts = 0;
         }
 
@@ -1317,20 +1599,14 @@ void *raw_tx_worker(void *arg)
 exit_tx:
     // Flush remaining TX packets
     if (batch_count > 0) {
-        send(port->tx_socket, NULL, 0, 0);
+        raw_tx_flush(port);
     }
 
     // Final flush of local stats
-    for (int t = 0; t < port->tx_target_count; t++) {
-        if (local_tx_packets[t] > 0) {
-            struct raw_tx_target_state *target = &port->tx_targets[t];
-            pthread_spin_lock(&target->stats.lock);
-            target->stats.tx_packets += local_tx_packets[t];
-            target->stats.tx_bytes += local_tx_bytes[t];
-            target->stats.tx_errors += local_tx_errors[t];
-            pthread_spin_unlock(&target->stats.lock);
-        }
-    }
+    for (int t = 0; t < port->tx_target_count; t++)
+        stats_shard_publish(tx_stats[t], &tx_lc[t]);
+
+    raw_free_hdr_templates(port);
 
     printf("[Port %u TX Worker] Stopped\n", port->port_id);
     port->tx_running = false;
@@ -1341,13 +1617,56 @@ exit_tx:
 // RX WORKER (Multi-Source)
 // ==========================================
 
+// RX worker'ları yerel sayaçlarını bu kadar pakette bir yayınlar (ve boşta kalınca)
+#define RAW_RX_PUBLISH_BATCH 64
+
+// Yerel RX sayaçlarını worker'ın shard'larına yayınla (DPDK ext + kaynak başına)
+static void raw_rx_publish(struct stats_shard *ext_stats, struct stats_counters *ext_lc,
+                           struct stats_shard **src_stats, struct stats_counters *src_lc,
+                           uint16_t src_count)
+{
+    // Shard ayrılamadıysa (registry dolu) sayaçlar atılır, birikmez
+    if (ext_lc->pkts) {
+        if (ext_stats)
+            stats_shard_publish(ext_stats, ext_lc);
+        else
+            memset(ext_lc, 0, sizeof(*ext_lc));
+    }
+
+    for (uint16_t s = 0; s < src_count && s < MAX_RAW_TARGETS; s++) {
+        if (!src_lc[s].pkts)
+            continue;
+        if (src_stats[s])
+            stats_shard_publish(src_stats[s], &src_lc[s]);
+        else
+            memset(&src_lc[s], 0, sizeof(src_lc[s]));
+    }
+}
+
+// Multi-queue: queue'nun kendi (debug) sayaçları da aynı noktada güncellenir
+static void mq_rx_publish(struct raw_rx_queue *queue,
+                          struct stats_shard *ext_stats, struct stats_counters *ext_lc,
+                          struct stats_shard **src_stats, struct stats_counters *src_lc,
+                          uint16_t src_count)
+{
+    queue->rx_packets += ext_lc->pkts;
+    queue->rx_bytes += ext_lc->bytes;
+    queue->good_pkts += ext_lc->good_pkts;
+    queue->bad_pkts += ext_lc->bad_pkts;
+    queue->bit_errors += ext_lc->bit_errors;
+
+    raw_rx_publish(ext_stats, ext_lc, src_stats, src_lc, src_count);
+}
+
 void *raw_rx_worker(void *arg)
 {
     struct raw_socket_port *port = (struct raw_socket_port *)arg;
     bool first_rx[MAX_RAW_TARGETS] = {false};
 
-    printf("[Port %u RX Worker] Started, expecting from %u sources\n",
-           port->port_id, port->rx_source_count);
+    const bool prbs_lfsr = prbs_verify_port_uses_lfsr(port->port_id);
+
+    printf("[Port %u RX Worker] Started, expecting from %u sources (PRBS %s engine)\n",
+           port->port_id, port->rx_source_count, prbs_lfsr ? "LFSR" : "cache");
 
     port->rx_running = true;
 
@@ -1363,21 +1682,10 @@ void *raw_rx_worker(void *arg)
         }
     }
 
-    // Pre-cache PRBS pointers for DPDK external TX ports
-#if DPDK_EXT_TX_ENABLED
-    // Port 12 receives from Port 2,3,4,5 (VL-ID 4291-4418)
-    // Port 13 receives from Port 0,6 (VL-ID 4099-4130)
-    uint8_t *dpdk_prbs_caches_port12[4] = {
-        get_prbs_cache_ext_for_port(2),
-        get_prbs_cache_ext_for_port(3),
-        get_prbs_cache_ext_for_port(4),
-        get_prbs_cache_ext_for_port(5)
-    };
-    uint8_t *dpdk_prbs_caches_port13[2] = {
-        get_prbs_cache_ext_for_port(0),
-        get_prbs_cache_ext_for_port(6)
-    };
+    // Kaynak port / PRBS akışı seçimi flow registry'den (flow_lookup)
+    const int raw_idx = (int)(port - raw_ports);
 
+#if DPDK_EXT_TX_ENABLED
     // Sequence tracking - separate for Port 12 and Port 13
     // Port 12: VL-ID 4291-4418 (128 entries)
     // Port 13: VL-ID 4099-4130 (32 entries)
@@ -1400,14 +1708,18 @@ void *raw_rx_worker(void *arg)
     }
 #endif
 
-    // Local counters for batch stats update (reduces spinlock overhead)
-    uint64_t local_dpdk_rx_pkts = 0;
-    uint64_t local_dpdk_rx_bytes = 0;
-    uint64_t local_dpdk_good = 0;
-    uint64_t local_dpdk_bad = 0;
-    uint64_t local_dpdk_bit_errors = 0;
-    uint64_t local_dpdk_lost = 0;
-    const uint32_t STATS_FLUSH_INTERVAL = 1024;  // Flush every 1024 packets
+    // Worker'a özel stats shard'ları: yerel sayaçlar RAW_RX_PUBLISH_BATCH pakette
+    // bir ve bloklayan poll'dan önce yayınlanır (spinlock yok)
+    struct stats_shard *ext_stats = stats_shard_create(STATS_DOM_RAW_EXT_RX, raw_idx, 0, 0,
+                                                       SOCKET_ID_ANY);
+    struct stats_shard *src_stats[MAX_RAW_TARGETS] = {NULL};
+    for (uint16_t s = 0; s < port->rx_source_count; s++)
+        src_stats[s] = stats_shard_create(STATS_DOM_RAW_RX, raw_idx, s, 0, SOCKET_ID_ANY);
+
+    struct stats_counters ext_lc = {0};
+    struct stats_counters src_lc[MAX_RAW_TARGETS];
+    memset(src_lc, 0, sizeof(src_lc));
+    uint32_t unpublished = 0;
     uint32_t empty_polls = 0;
     const uint32_t BUSY_POLL_COUNT = 64;  // Spin this many times before blocking poll
 
@@ -1424,21 +1736,9 @@ void *raw_rx_worker(void *arg)
                 continue;
             }
             // Flush local stats before blocking poll
-            if (local_dpdk_rx_pkts > 0) {
-                pthread_spin_lock(&port->dpdk_ext_rx_stats.lock);
-                port->dpdk_ext_rx_stats.rx_packets += local_dpdk_rx_pkts;
-                port->dpdk_ext_rx_stats.rx_bytes += local_dpdk_rx_bytes;
-                port->dpdk_ext_rx_stats.good_pkts += local_dpdk_good;
-                port->dpdk_ext_rx_stats.bad_pkts += local_dpdk_bad;
-                port->dpdk_ext_rx_stats.bit_errors += local_dpdk_bit_errors;
-                port->dpdk_ext_rx_stats.lost_pkts += local_dpdk_lost;
-                pthread_spin_unlock(&port->dpdk_ext_rx_stats.lock);
-                local_dpdk_rx_pkts = 0;
-                local_dpdk_rx_bytes = 0;
-                local_dpdk_good = 0;
-                local_dpdk_bad = 0;
-                local_dpdk_bit_errors = 0;
-                local_dpdk_lost = 0;
+            if (unpublished > 0) {
+                raw_rx_publish(ext_stats, &ext_lc, src_stats, src_lc, port->rx_source_count);
+                unpublished = 0;
             }
             struct pollfd pfd = {port->rx_socket, POLLIN, 0};
             poll(&pfd, 1, 1);  // 1ms blocking poll
@@ -1477,6 +1777,7 @@ void *raw_rx_worker(void *arg)
 
         // Extract VL-ID from DST MAC
         uint16_t vl_id = ((uint16_t)pkt_data[4] << 8) | pkt_data[5];
+        const struct flow_entry *flow = flow_lookup(vl_id);
 
         // ==========================================
         // DPDK EXTERNAL TX PACKET HANDLING
@@ -1485,8 +1786,8 @@ void *raw_rx_worker(void *arg)
         // Port 13: VL-ID 4099-4130 from Port 0,6
         // ==========================================
 #if DPDK_EXT_TX_ENABLED
-        int dpdk_src_port = dpdk_ext_tx_get_source_port(vl_id);
-        if (dpdk_src_port >= 0) {
+        if (flow->kind == FLOW_SRC_DPDK_EXT) {
+            const uint16_t dpdk_src_port = flow->src_port;
             // This is a DPDK external packet (VLAN stripped by switch)
             // Offsets for non-VLAN packet: ETH(14) + IP(20) + UDP(8) = 42
             uint8_t *payload = pkt_data + 14 + 20 + 8;
@@ -1494,8 +1795,8 @@ void *raw_rx_worker(void *arg)
             memcpy(&seq, payload, sizeof(seq));
 
             // Update local stats (no spinlock per packet!)
-            local_dpdk_rx_pkts++;
-            local_dpdk_rx_bytes += pkt_len;
+            ext_lc.pkts++;
+            ext_lc.bytes += pkt_len;
 
             // Sequence tracking for lost packet detection (port-specific)
             if (port->port_id == 12) {
@@ -1517,7 +1818,7 @@ void *raw_rx_worker(void *arg)
 #else
                         uint64_t expected = dpdk_ext_expected_seq_p12[vl_idx];
                         if (seq > expected) {
-                            local_dpdk_lost += (seq - expected);
+                            ext_lc.lost_pkts += (seq - expected);
                         }
                         dpdk_ext_expected_seq_p12[vl_idx] = seq + 1;
 #endif
@@ -1541,7 +1842,7 @@ void *raw_rx_worker(void *arg)
 #else
                         uint64_t expected = dpdk_ext_expected_seq_p13[vl_idx];
                         if (seq > expected) {
-                            local_dpdk_lost += (seq - expected);
+                            ext_lc.lost_pkts += (seq - expected);
                         }
                         dpdk_ext_expected_seq_p13[vl_idx] = seq + 1;
 #endif
@@ -1549,19 +1850,8 @@ void *raw_rx_worker(void *arg)
                 }
             }
 
-            // PRBS verification using pre-cached DPDK port's cache
-            // Port 12: dpdk_src_port 2,3,4,5 → index 0,1,2,3
-            // Port 13: dpdk_src_port 0,6 → index 0,1
-            int cache_idx = -1;
-            uint8_t *dpdk_prbs_cache = NULL;
-            if (port->port_id == 12) {
-                cache_idx = dpdk_src_port - 2;
-                dpdk_prbs_cache = (cache_idx >= 0 && cache_idx < 4) ? dpdk_prbs_caches_port12[cache_idx] : NULL;
-            } else if (port->port_id == 13) {
-                if (dpdk_src_port == 0) cache_idx = 0;
-                else if (dpdk_src_port == 6) cache_idx = 1;
-                dpdk_prbs_cache = (cache_idx >= 0 && cache_idx < 2) ? dpdk_prbs_caches_port13[cache_idx] : NULL;
-            }
+            // PRBS verification: kaynak DPDK portunun penceresi (flow registry)
+            const struct prbs_window *dpdk_prbs_cache = flow->prbs;
             if (dpdk_prbs_cache) {
                 uint8_t *recv_prbs = payload + 8;
                 // DPDK TX uses NUM_PRBS_BYTES for both offset calculation and data
@@ -1569,21 +1859,24 @@ void *raw_rx_worker(void *arg)
                 uint16_t cmp_bytes = pkt_len - 14 - 20 - 8 - 8; // ETH+IP+UDP+SEQ
                 if (cmp_bytes > NUM_PRBS_BYTES) cmp_bytes = NUM_PRBS_BYTES;
 
-                // CRITICAL: Use NUM_PRBS_BYTES for offset, same as TX side
-                uint64_t prbs_offset = (seq * (uint64_t)NUM_PRBS_BYTES) % PRBS_CACHE_SIZE;
-                uint8_t *expected_prbs = dpdk_prbs_cache + prbs_offset;
-
-                if (memcmp(recv_prbs, expected_prbs, cmp_bytes) == 0) {
-                    local_dpdk_good++;
+                // CRITICAL: Use NUM_PRBS_BYTES for offset, same as TX side (flow->prbs_step)
+                uint64_t prbs_offset = (seq * (uint64_t)flow->prbs_step) % PRBS_CACHE_SIZE;
+                uint32_t prbs_bit_errors = prbs_window_verify(dpdk_prbs_cache, prbs_offset, recv_prbs,
+                                                              cmp_bytes, prbs_lfsr);
+                if (likely(prbs_bit_errors == 0)) {
+                    ext_lc.good_pkts++;
                 } else {
                     static int debug_count = 0;
                     if (debug_count < 5) {
                         debug_count++;
+                        // Debug dökümü için beklenen byte'lar pencereden (LFSR engine'de de)
+                        const uint8_t *expected_prbs = prbs_window_at(dpdk_prbs_cache, prbs_offset,
+                                                                      cmp_bytes);
                         // Get IP header info
                         uint8_t ip_ver_ihl = pkt_data[14];
                         uint8_t ip_ihl = (ip_ver_ihl & 0x0F) * 4;  // IP header length in bytes
 
-                        printf("[DPDK-EXT RX DEBUG] PRBS Error #%d: VL-ID=%u, src_port=%d, seq=%lu, pkt_len=%u, cmp_bytes=%u\n",
+                        printf("[DPDK-EXT RX DEBUG] PRBS Error #%d: VL-ID=%u, src_port=%u, seq=%lu, pkt_len=%u, cmp_bytes=%u\n",
                                debug_count, vl_id, dpdk_src_port, seq, pkt_len, cmp_bytes);
                         printf("  IP: ver_ihl=0x%02x (IHL=%u bytes), EtherType=0x%02x%02x\n",
                                ip_ver_ihl, ip_ihl, pkt_data[12], pkt_data[13]);
@@ -1598,29 +1891,14 @@ void *raw_rx_worker(void *arg)
                                expected_prbs[0], expected_prbs[1], expected_prbs[2], expected_prbs[3],
                                expected_prbs[4], expected_prbs[5], expected_prbs[6], expected_prbs[7]);
                     }
-                    local_dpdk_bad++;
-                    for (int b = 0; b < cmp_bytes; b++) {
-                        local_dpdk_bit_errors += __builtin_popcount(recv_prbs[b] ^ expected_prbs[b]);
-                    }
+                    ext_lc.bad_pkts++;
+                    ext_lc.bit_errors += prbs_bit_errors;
                 }
             }
 
-            // Periodic stats flush
-            if (local_dpdk_rx_pkts >= STATS_FLUSH_INTERVAL) {
-                pthread_spin_lock(&port->dpdk_ext_rx_stats.lock);
-                port->dpdk_ext_rx_stats.rx_packets += local_dpdk_rx_pkts;
-                port->dpdk_ext_rx_stats.rx_bytes += local_dpdk_rx_bytes;
-                port->dpdk_ext_rx_stats.good_pkts += local_dpdk_good;
-                port->dpdk_ext_rx_stats.bad_pkts += local_dpdk_bad;
-                port->dpdk_ext_rx_stats.bit_errors += local_dpdk_bit_errors;
-                port->dpdk_ext_rx_stats.lost_pkts += local_dpdk_lost;
-                pthread_spin_unlock(&port->dpdk_ext_rx_stats.lock);
-                local_dpdk_rx_pkts = 0;
-                local_dpdk_rx_bytes = 0;
-                local_dpdk_good = 0;
-                local_dpdk_bad = 0;
-                local_dpdk_bit_errors = 0;
-                local_dpdk_lost = 0;
+            if (++unpublished >= RAW_RX_PUBLISH_BATCH) {
+                raw_rx_publish(ext_stats, &ext_lc, src_stats, src_lc, port->rx_source_count);
+                unpublished = 0;
             }
 
             hdr->tp_status = TP_STATUS_KERNEL;
@@ -1633,15 +1911,7 @@ void *raw_rx_worker(void *arg)
         // RAW SOCKET PACKET HANDLING (from Port 13)
         // ==========================================
         // Find which source this packet belongs to
-        int source_idx = -1;
-        for (int s = 0; s < port->rx_source_count; s++) {
-            struct raw_rx_source_state *source = &port->rx_sources[s];
-            if (vl_id >= source->config.vl_id_start &&
-                vl_id < source->config.vl_id_start + source->config.vl_id_count) {
-                source_idx = s;
-                break;
-            }
-        }
+        int source_idx = flow->raw_rx_source[raw_idx];
 
         if (source_idx < 0) {
             // Not from a known source, skip
@@ -1658,10 +1928,9 @@ void *raw_rx_worker(void *arg)
         uint64_t seq;
         memcpy(&seq, payload, sizeof(seq));
 
-        pthread_spin_lock(&source->stats.lock);
-        source->stats.rx_packets++;
-        source->stats.rx_bytes += pkt_len;
-        pthread_spin_unlock(&source->stats.lock);
+        struct stats_counters *slc = &src_lc[source_idx];
+        slc->pkts++;
+        slc->bytes += pkt_len;
 
         if (!first_rx[source_idx]) {
             printf("[Port %u RX] Source %d (<-P%u): First packet VL-ID=%u Seq=%lu\n",
@@ -1680,18 +1949,11 @@ void *raw_rx_worker(void *arg)
 
             if (seq != expected) {
                 if (seq > expected) {
-                    uint64_t gap = seq - expected;
-                    pthread_spin_lock(&source->stats.lock);
-                    source->stats.lost_pkts += gap;
-                    pthread_spin_unlock(&source->stats.lock);
+                    slc->lost_pkts += seq - expected;
+                } else if (seq == expected - 1) {
+                    slc->duplicate_pkts++;
                 } else {
-                    pthread_spin_lock(&source->stats.lock);
-                    if (seq == expected - 1) {
-                        source->stats.duplicate_pkts++;
-                    } else {
-                        source->stats.out_of_order_pkts++;
-                    }
-                    pthread_spin_unlock(&source->stats.lock);
+                    slc->out_of_order_pkts++;
                 }
             }
 
@@ -1712,43 +1974,38 @@ void *raw_rx_worker(void *arg)
             if (prbs_len > RAW_MAX_PRBS_BYTES) prbs_len = RAW_MAX_PRBS_BYTES;
 
             uint64_t prbs_offset = (seq * (uint64_t)RAW_MAX_PRBS_BYTES) % RAW_PRBS_CACHE_SIZE;
-            uint8_t *expected_prbs = partner->prbs_cache_ext + prbs_offset;
-
-            if (memcmp(recv_prbs, expected_prbs, prbs_len) == 0) {
-                pthread_spin_lock(&source->stats.lock);
-                source->stats.good_pkts++;
-                pthread_spin_unlock(&source->stats.lock);
+            uint32_t prbs_bit_errors = prbs_window_verify(&partner->prbs_win, prbs_offset, recv_prbs,
+                                                          prbs_len, prbs_lfsr);
+            if (likely(prbs_bit_errors == 0)) {
+                slc->good_pkts++;
             } else {
-                pthread_spin_lock(&source->stats.lock);
-                source->stats.bad_pkts++;
-                for (uint16_t i = 0; i < prbs_len; i++) {
-                    source->stats.bit_errors += __builtin_popcount(recv_prbs[i] ^ expected_prbs[i]);
-                }
-                pthread_spin_unlock(&source->stats.lock);
+                slc->bad_pkts++;
+                slc->bit_errors += prbs_bit_errors;
             }
 #else
             uint64_t prbs_offset = (seq * (uint64_t)RAW_PKT_PRBS_BYTES) % RAW_PRBS_CACHE_SIZE;
-            uint8_t *expected_prbs = partner->prbs_cache_ext + prbs_offset;
-
-            if (memcmp(recv_prbs, expected_prbs, RAW_PKT_PRBS_BYTES) == 0) {
-                pthread_spin_lock(&source->stats.lock);
-                source->stats.good_pkts++;
-                pthread_spin_unlock(&source->stats.lock);
+            uint32_t prbs_bit_errors = prbs_window_verify(&partner->prbs_win, prbs_offset, recv_prbs,
+                                                          RAW_PKT_PRBS_BYTES, prbs_lfsr);
+            if (likely(prbs_bit_errors == 0)) {
+                slc->good_pkts++;
             } else {
-                pthread_spin_lock(&source->stats.lock);
-                source->stats.bad_pkts++;
-                for (int i = 0; i < RAW_PKT_PRBS_BYTES; i++) {
-                    source->stats.bit_errors += __builtin_popcount(recv_prbs[i] ^ expected_prbs[i]);
-                }
-                pthread_spin_unlock(&source->stats.lock);
+                slc->bad_pkts++;
+                slc->bit_errors += prbs_bit_errors;
             }
 #endif
         }
 
+        if (++unpublished >= RAW_RX_PUBLISH_BATCH) {
+            raw_rx_publish(ext_stats, &ext_lc, src_stats, src_lc, port->rx_source_count);
+            unpublished = 0;
+        }
+
         hdr->tp_status = TP_STATUS_KERNEL;
         port->rx_ring_offset = (port->rx_ring_offset + 1) % RAW_SOCKET_RING_FRAME_NR;
     }
 
+    raw_rx_publish(ext_stats, &ext_lc, src_stats, src_lc, port->rx_source_count);
+
     printf("[Port %u RX Worker] Stopped\n", port->port_id);
     port->rx_running = false;
     return NULL;
@@ -1782,387 +2039,500 @@ static int set_thread_cpu_affinity(pthread_t thread, int cpu_core)
     return 0;
 }
 
-void *multi_queue_rx_worker(void *arg)
-{
-    struct multi_queue_worker_arg *warg = (struct multi_queue_worker_arg *)arg;
-    struct raw_socket_port *port = warg->port;
-    struct raw_rx_queue *queue = warg->queue;
+// Worker'ın yerel durumu: V2 (frame) ve V3 (blok) döngüleri aynı frame
+// işleyicisini kullanır
+struct mq_rx_ctx {
+    struct raw_socket_port *port;
+    struct raw_rx_queue *queue;
+    int raw_idx;
+    bool prbs_lfsr;
 
-    printf("[Port %u Q%d RX Worker] Started on CPU core %u\n",
-           port->port_id, queue->queue_id, queue->cpu_core);
+    struct stats_shard *ext_stats;
+    struct stats_shard *src_stats[MAX_RAW_TARGETS];
+    struct stats_counters ext_lc;
+    struct stats_counters src_lc[MAX_RAW_TARGETS];
+    uint32_t unpublished;
 
-    queue->running = true;
+    // VL-ID tracking (local, thread-safe)
+    uint16_t local_vl_min;
+    uint16_t local_vl_max;
+    uint8_t vl_id_seen[GLOBAL_SEQ_VL_ID_COUNT / 8 + 1];  // Bitmap
+};
 
-    // Pre-cache PRBS data pointers for DPDK external packet verification
-#if DPDK_EXT_TX_ENABLED
-    // Port 12 receives from Port 2,3,4,5
-    uint8_t *dpdk_prbs_caches_p12[4] = {
-        get_prbs_cache_ext_for_port(2),
-        get_prbs_cache_ext_for_port(3),
-        get_prbs_cache_ext_for_port(4),
-        get_prbs_cache_ext_for_port(5)
-    };
-    // Port 13 receives from Port 0,6
-    uint8_t *dpdk_prbs_caches_p13[2] = {
-        get_prbs_cache_ext_for_port(0),
-        get_prbs_cache_ext_for_port(6)
-    };
-    // Note: Using global sequence tracking (g_vl_seq) instead of per-queue
-#endif
+static void mq_rx_ctx_publish(struct mq_rx_ctx *c)
+{
+    mq_rx_publish(c->queue, c->ext_stats, &c->ext_lc, c->src_stats, c->src_lc,
+                  c->port->rx_source_count);
+    c->unpublished = 0;
+}
 
-    // Local counters for batch stats update
-    uint64_t local_rx_pkts = 0;
-    uint64_t local_rx_bytes = 0;
-    uint64_t local_good = 0;
-    uint64_t local_bad = 0;
-    uint64_t local_bit_errors = 0;
-    // Note: local_lost removed - using global sequence tracking instead
-    const uint32_t STATS_FLUSH_INTERVAL = 1024;
-    uint32_t empty_polls = 0;
-    const uint32_t BUSY_POLL_COUNT = 64;
+// Boşta: birikenleri yayınla, VL-ID aralığını güncelle
+static void mq_rx_idle_flush(struct mq_rx_ctx *c)
+{
+    struct raw_rx_queue *queue = c->queue;
 
-    // VL-ID tracking (local, thread-safe)
-    uint16_t local_vl_min = 0xFFFF;
-    uint16_t local_vl_max = 0;
-    uint8_t vl_id_seen[GLOBAL_SEQ_VL_ID_COUNT / 8 + 1];  // Bitmap
-    memset(vl_id_seen, 0, sizeof(vl_id_seen));
-    queue->vl_id_min = 0xFFFF;
-    queue->vl_id_max = 0;
-    queue->unique_vl_ids = 0;
+    if (c->unpublished == 0)
+        return;
+    mq_rx_ctx_publish(c);
+    if (c->local_vl_min < queue->vl_id_min) queue->vl_id_min = c->local_vl_min;
+    if (c->local_vl_max > queue->vl_id_max) queue->vl_id_max = c->local_vl_max;
+}
 
-    while (!port->stop_flag && (g_stop_flag == NULL || !*g_stop_flag)) {
-        struct tpacket2_hdr *hdr = (struct tpacket2_hdr *)(
-            (uint8_t *)queue->ring +
-            (queue->ring_offset * RAW_SOCKET_RING_FRAME_SIZE));
+// Kernel drop sayaçları: PACKET_STATISTICS her okumada sıfırlanır, biriktir
+// (AF_XDP: XDP_STATISTICS zaten birikimli)
+static void mq_rx_kernel_stats(struct raw_rx_queue *queue)
+{
+    if (queue->xdp) {
+        queue->kernel_drops = raw_xdp_queue_drops(queue->xdp);
+        return;
+    }
 
-        if (!(hdr->tp_status & TP_STATUS_USER)) {
-            empty_polls++;
-            if (empty_polls < BUSY_POLL_COUNT) {
-                _mm_pause();
-                continue;
-            }
-            // Flush local stats before blocking
-            if (local_rx_pkts > 0) {
-                pthread_spin_lock(&port->dpdk_ext_rx_stats.lock);
-                port->dpdk_ext_rx_stats.rx_packets += local_rx_pkts;
-                port->dpdk_ext_rx_stats.rx_bytes += local_rx_bytes;
-                port->dpdk_ext_rx_stats.good_pkts += local_good;
-                port->dpdk_ext_rx_stats.bad_pkts += local_bad;
-                port->dpdk_ext_rx_stats.bit_errors += local_bit_errors;
-                // Note: lost_pkts is calculated globally via get_global_sequence_lost()
-                pthread_spin_unlock(&port->dpdk_ext_rx_stats.lock);
-
-                // Also update per-queue stats (no lock needed, thread-local)
-                queue->rx_packets += local_rx_pkts;
-                queue->rx_bytes += local_rx_bytes;
-                queue->good_pkts += local_good;
-                queue->bad_pkts += local_bad;
-                queue->bit_errors += local_bit_errors;
-                // Note: lost_pkts per queue is not used with global tracking
-
-                // Get kernel drop statistics
-                struct tpacket_stats kstats;
-                socklen_t kstats_len = sizeof(kstats);
-                if (getsockopt(queue->socket_fd, SOL_PACKET, PACKET_STATISTICS,
-                               &kstats, &kstats_len) == 0) {
-                    queue->kernel_drops = kstats.tp_drops;
-                }
+    struct tpacket_stats_v3 kstats;
+    socklen_t kstats_len = sizeof(kstats);   // V2 soketinde kernel tpacket_stats kadarını yazar
 
-                // Update VL-ID tracking
-                if (local_vl_min < queue->vl_id_min) queue->vl_id_min = local_vl_min;
-                if (local_vl_max > queue->vl_id_max) queue->vl_id_max = local_vl_max;
+    memset(&kstats, 0, sizeof(kstats));
+    if (getsockopt(queue->socket_fd, SOL_PACKET, PACKET_STATISTICS,
+                   &kstats, &kstats_len) != 0)
+        return;
+    queue->kernel_drops += kstats.tp_drops;
+    if (queue->tpacket_v3)
+        queue->kernel_freezes += kstats.tp_freeze_q_cnt;
+}
 
-                local_rx_pkts = 0;
-                local_rx_bytes = 0;
-                local_good = 0;
-                local_bad = 0;
-                local_bit_errors = 0;
-            }
-            struct pollfd pfd = {queue->socket_fd, POLLIN, 0};
-            poll(&pfd, 1, 1);
-            empty_polls = 0;
-            continue;
-        }
-        empty_polls = 0;
+// Birden çok queue aynı VL'i güncelleyebilir (HASH fanout): atomic RMW
+static inline void global_seq_update_shared(struct global_vl_seq_state *vs, uint64_t seq)
+{
+    // Increment RX count
+    atomic_fetch_add(&vs->rx_count, 1);
 
-        // Skip our own outgoing TX packets (kernel marks them as PACKET_OUTGOING)
-        struct sockaddr_ll *sll = (struct sockaddr_ll *)(
-            (uint8_t *)hdr + TPACKET_ALIGN(sizeof(struct tpacket2_hdr)));
-        if (sll->sll_pkttype == PACKET_OUTGOING) {
-            hdr->tp_status = TP_STATUS_KERNEL;
-            queue->ring_offset = (queue->ring_offset + 1) % RAW_SOCKET_RING_FRAME_NR;
-            continue;
+    // Update min_seq (first seen sequence)
+    if (!atomic_load(&vs->initialized)) {
+        // First packet for this VL-ID - set min_seq
+        uint64_t expected = UINT64_MAX;
+        if (atomic_compare_exchange_strong(&vs->min_seq, &expected, seq)) {
+            atomic_store(&vs->initialized, true);
         }
+    }
 
-        uint8_t *pkt_data = (uint8_t *)hdr + hdr->tp_mac;
-        uint32_t pkt_len = hdr->tp_len;
-
-        // Validate minimum packet size
-        if (pkt_len < RAW_PKT_ETH_HDR_SIZE + RAW_PKT_IP_HDR_SIZE +
-                      RAW_PKT_UDP_HDR_SIZE + RAW_PKT_SEQ_BYTES) {
-            hdr->tp_status = TP_STATUS_KERNEL;
-            queue->ring_offset = (queue->ring_offset + 1) % RAW_SOCKET_RING_FRAME_NR;
-            continue;
+    // Update max_seq if this sequence is higher
+    uint64_t old_max = atomic_load(&vs->max_seq);
+    while (seq > old_max) {
+        if (atomic_compare_exchange_weak(&vs->max_seq, &old_max, seq)) {
+            break;
         }
+    }
 
-        // Check EtherType
-        uint16_t ethertype = (pkt_data[12] << 8) | pkt_data[13];
-        if (ethertype != 0x0800) {
-            hdr->tp_status = TP_STATUS_KERNEL;
-            queue->ring_offset = (queue->ring_offset + 1) % RAW_SOCKET_RING_FRAME_NR;
-            continue;
+    // Also update min if this is smaller (for late arrivals)
+    uint64_t old_min = atomic_load(&vs->min_seq);
+    while (seq < old_min) {
+        if (atomic_compare_exchange_weak(&vs->min_seq, &old_min, seq)) {
+            break;
         }
+    }
+}
 
-        // Extract VL-ID from DST MAC
-        uint16_t vl_id = ((uint16_t)pkt_data[4] << 8) | pkt_data[5];
+// VL steering: VL'in tek yazarı bu queue. Stats thread'i okuduğu için alanlar
+// atomic kalır ama RMW yok; max'tan küçük her seq sıra dışıdır (geç / tekrar).
+static inline void global_seq_update_steered(struct global_vl_seq_state *vs, uint64_t seq)
+{
+    const uint64_t cnt = atomic_load_explicit(&vs->rx_count, memory_order_relaxed);
+    atomic_store_explicit(&vs->rx_count, cnt + 1, memory_order_relaxed);
 
-#if DPDK_EXT_TX_ENABLED
-        int dpdk_src_port = dpdk_ext_tx_get_source_port(vl_id);
-        if (dpdk_src_port >= 0) {
-            uint8_t *payload = pkt_data + 14 + 20 + 8;
-            uint64_t seq;
-            memcpy(&seq, payload, sizeof(seq));
+    if (!atomic_load_explicit(&vs->initialized, memory_order_relaxed)) {
+        atomic_store_explicit(&vs->min_seq, seq, memory_order_relaxed);
+        atomic_store_explicit(&vs->max_seq, seq, memory_order_relaxed);
+        atomic_store_explicit(&vs->initialized, true, memory_order_release);
+        return;
+    }
 
-            local_rx_pkts++;
-            local_rx_bytes += pkt_len;
+    if (seq > atomic_load_explicit(&vs->max_seq, memory_order_relaxed)) {
+        atomic_store_explicit(&vs->max_seq, seq, memory_order_relaxed);
+        return;
+    }
 
-            // VL-ID tracking
-            if (vl_id < local_vl_min) local_vl_min = vl_id;
-            if (vl_id > local_vl_max) local_vl_max = vl_id;
+    const uint64_t reord = atomic_load_explicit(&vs->reordered, memory_order_relaxed);
+    atomic_store_explicit(&vs->reordered, reord + 1, memory_order_relaxed);
+    if (seq < atomic_load_explicit(&vs->min_seq, memory_order_relaxed))
+        atomic_store_explicit(&vs->min_seq, seq, memory_order_relaxed);
+}
 
-            // Global sequence tracking (shared across all queues, port-specific)
-            struct global_vl_seq_state *vs = NULL;
-            uint16_t vl_idx = 0;
+static inline void mq_rx_frame(struct mq_rx_ctx *c, uint8_t *pkt_data, uint32_t pkt_len)
+{
+    struct raw_socket_port *port = c->port;
 
-            if (port->port_id == 12) {
-                vl_idx = vl_id - GLOBAL_SEQ_VL_ID_START_P12;
-                if (vl_idx < GLOBAL_SEQ_VL_ID_COUNT_P12) {
-                    vs = &g_vl_seq_p12[vl_idx];
-                }
-            } else if (port->port_id == 13) {
-                vl_idx = vl_id - GLOBAL_SEQ_VL_ID_START_P13;
-                if (vl_idx < GLOBAL_SEQ_VL_ID_COUNT_P13) {
-                    vs = &g_vl_seq_p13[vl_idx];
-                }
-            }
+    // Validate minimum packet size
+    if (pkt_len < RAW_PKT_ETH_HDR_SIZE + RAW_PKT_IP_HDR_SIZE +
+                  RAW_PKT_UDP_HDR_SIZE + RAW_PKT_SEQ_BYTES) {
+        return;
+    }
 
-            if (vs != NULL) {
-                // Track unique VL-IDs (per-queue, for debugging)
-                uint8_t byte_idx = vl_idx / 8;
-                uint8_t bit_mask = 1 << (vl_idx % 8);
-                if (!(vl_id_seen[byte_idx] & bit_mask)) {
-                    vl_id_seen[byte_idx] |= bit_mask;
-                    queue->unique_vl_ids++;
-                }
+    // Check EtherType
+    uint16_t ethertype = (pkt_data[12] << 8) | pkt_data[13];
+    if (ethertype != 0x0800) {
+        return;
+    }
 
-                // Increment RX count
-                atomic_fetch_add(&vs->rx_count, 1);
+    // Extract VL-ID from DST MAC
+    uint16_t vl_id = ((uint16_t)pkt_data[4] << 8) | pkt_data[5];
+    const struct flow_entry *flow = flow_lookup(vl_id);
 
-                // Update min_seq (first seen sequence)
-                if (!atomic_load(&vs->initialized)) {
-                    // First packet for this VL-ID - set min_seq
-                    uint64_t expected = UINT64_MAX;
-                    if (atomic_compare_exchange_strong(&vs->min_seq, &expected, seq)) {
-                        atomic_store(&vs->initialized, true);
-                    }
-                }
+#if DPDK_EXT_TX_ENABLED
+    if (flow->kind == FLOW_SRC_DPDK_EXT) {
+        struct raw_rx_queue *queue = c->queue;
+        uint8_t *payload = pkt_data + 14 + 20 + 8;
+        uint64_t seq;
+        memcpy(&seq, payload, sizeof(seq));
 
-                // Update max_seq if this sequence is higher
-                uint64_t old_max = atomic_load(&vs->max_seq);
-                while (seq > old_max) {
-                    if (atomic_compare_exchange_weak(&vs->max_seq, &old_max, seq)) {
-                        break;
-                    }
-                }
+        c->ext_lc.pkts++;
+        c->ext_lc.bytes += pkt_len;
 
-                // Also update min if this is smaller (for late arrivals)
-                uint64_t old_min = atomic_load(&vs->min_seq);
-                while (seq < old_min) {
-                    if (atomic_compare_exchange_weak(&vs->min_seq, &old_min, seq)) {
-                        break;
-                    }
-                }
+        // VL-ID tracking
+        if (vl_id < c->local_vl_min) c->local_vl_min = vl_id;
+        if (vl_id > c->local_vl_max) c->local_vl_max = vl_id;
+
+        // Global sequence tracking (shared across all queues, port-specific)
+        struct global_vl_seq_state *vs = NULL;
+        uint16_t vl_idx = 0;
+
+        if (port->port_id == 12) {
+            vl_idx = vl_id - GLOBAL_SEQ_VL_ID_START_P12;
+            if (vl_idx < GLOBAL_SEQ_VL_ID_COUNT_P12) {
+                vs = &g_vl_seq_p12[vl_idx];
+            }
+        } else if (port->port_id == 13) {
+            vl_idx = vl_id - GLOBAL_SEQ_VL_ID_START_P13;
+            if (vl_idx < GLOBAL_SEQ_VL_ID_COUNT_P13) {
+                vs = &g_vl_seq_p13[vl_idx];
             }
+        }
 
-            // PRBS verification (port-specific cache selection)
-            uint8_t *dpdk_prbs_cache = NULL;
-            if (port->port_id == 12) {
-                // Port 12 receives from Port 2,3,4,5
-                int cache_idx = dpdk_src_port - 2;
-                if (cache_idx >= 0 && cache_idx < 4) {
-                    dpdk_prbs_cache = dpdk_prbs_caches_p12[cache_idx];
-                }
-            } else if (port->port_id == 13) {
-                // Port 13 receives from Port 0,6
-                int cache_idx = (dpdk_src_port == 0) ? 0 : ((dpdk_src_port == 6) ? 1 : -1);
-                if (cache_idx >= 0 && cache_idx < 2) {
-                    dpdk_prbs_cache = dpdk_prbs_caches_p13[cache_idx];
-                }
+        if (vs != NULL) {
+            // Track unique VL-IDs (per-queue, for debugging)
+            uint8_t byte_idx = vl_idx / 8;
+            uint8_t bit_mask = 1 << (vl_idx % 8);
+            if (!(c->vl_id_seen[byte_idx] & bit_mask)) {
+                c->vl_id_seen[byte_idx] |= bit_mask;
+                queue->unique_vl_ids++;
             }
-            if (dpdk_prbs_cache) {
-                uint8_t *recv_prbs = payload + 8;
-                uint16_t cmp_bytes = pkt_len - 14 - 20 - 8 - 8;
-                if (cmp_bytes > NUM_PRBS_BYTES) cmp_bytes = NUM_PRBS_BYTES;
 
-                uint64_t prbs_offset = (seq * (uint64_t)NUM_PRBS_BYTES) % PRBS_CACHE_SIZE;
-                uint8_t *expected_prbs = dpdk_prbs_cache + prbs_offset;
+            if (port->rx_vl_steered)
+                global_seq_update_steered(vs, seq);
+            else
+                global_seq_update_shared(vs, seq);
+        }
 
-                if (memcmp(recv_prbs, expected_prbs, cmp_bytes) == 0) {
-                    local_good++;
-                } else {
-                    local_bad++;
-                    // Count bit errors
-                    for (int b = 0; b < cmp_bytes; b++) {
-                        uint8_t diff = recv_prbs[b] ^ expected_prbs[b];
-                        local_bit_errors += __builtin_popcount(diff);
-                    }
-                }
+        // PRBS verification: kaynak DPDK portunun penceresi (flow registry)
+        const struct prbs_window *dpdk_prbs_cache = flow->prbs;
+        if (dpdk_prbs_cache) {
+            uint8_t *recv_prbs = payload + 8;
+            uint16_t cmp_bytes = pkt_len - 14 - 20 - 8 - 8;
+            if (cmp_bytes > NUM_PRBS_BYTES) cmp_bytes = NUM_PRBS_BYTES;
+
+            uint64_t prbs_offset = (seq * (uint64_t)flow->prbs_step) % PRBS_CACHE_SIZE;
+            uint32_t prbs_bit_errors = prbs_window_verify(dpdk_prbs_cache, prbs_offset, recv_prbs,
+                                                          cmp_bytes, c->prbs_lfsr);
+            if (likely(prbs_bit_errors == 0)) {
+                c->ext_lc.good_pkts++;
             } else {
-                local_good++;  // No cache, assume good
+                c->ext_lc.bad_pkts++;
+                c->ext_lc.bit_errors += prbs_bit_errors;
             }
+        } else {
+            c->ext_lc.good_pkts++;  // No cache, assume good
+        }
 
-            // Periodic stats flush
-            if (local_rx_pkts >= STATS_FLUSH_INTERVAL) {
-                pthread_spin_lock(&port->dpdk_ext_rx_stats.lock);
-                port->dpdk_ext_rx_stats.rx_packets += local_rx_pkts;
-                port->dpdk_ext_rx_stats.rx_bytes += local_rx_bytes;
-                port->dpdk_ext_rx_stats.good_pkts += local_good;
-                port->dpdk_ext_rx_stats.bad_pkts += local_bad;
-                port->dpdk_ext_rx_stats.bit_errors += local_bit_errors;
-                pthread_spin_unlock(&port->dpdk_ext_rx_stats.lock);
-
-                queue->rx_packets += local_rx_pkts;
-                queue->rx_bytes += local_rx_bytes;
-                queue->good_pkts += local_good;
-                queue->bad_pkts += local_bad;
-                queue->bit_errors += local_bit_errors;
-
-                local_rx_pkts = 0;
-                local_rx_bytes = 0;
-                local_good = 0;
-                local_bad = 0;
-                local_bit_errors = 0;
-            }
+        if (++c->unpublished >= RAW_RX_PUBLISH_BATCH)
+            mq_rx_ctx_publish(c);
 
-            // Packet handled, continue to next
-            hdr->tp_status = TP_STATUS_KERNEL;
-            queue->ring_offset = (queue->ring_offset + 1) % RAW_SOCKET_RING_FRAME_NR;
-            continue;
-        }
+        // Packet handled
+        return;
+    }
 #endif
 
-        // ==========================================
-        // RAW SOCKET SOURCE PACKET HANDLING (from Port 13)
-        // ==========================================
-        int source_idx = -1;
-        for (int s = 0; s < port->rx_source_count; s++) {
-            struct raw_rx_source_state *source = &port->rx_sources[s];
-            if (vl_id >= source->config.vl_id_start &&
-                vl_id < source->config.vl_id_start + source->config.vl_id_count) {
-                source_idx = s;
-                break;
-            }
-        }
+    // ==========================================
+    // RAW SOCKET SOURCE PACKET HANDLING (from Port 13)
+    // ==========================================
+    int source_idx = flow->raw_rx_source[c->raw_idx];
 
-        if (source_idx >= 0) {
-            struct raw_rx_source_state *source = &port->rx_sources[source_idx];
-            uint16_t vl_index = vl_id - source->config.vl_id_start;
+    if (source_idx >= 0) {
+        struct raw_rx_source_state *source = &port->rx_sources[source_idx];
+        uint16_t vl_index = vl_id - source->config.vl_id_start;
 
-            // Get sequence number from payload
-            uint8_t *payload = pkt_data + RAW_PKT_ETH_HDR_SIZE + RAW_PKT_IP_HDR_SIZE + RAW_PKT_UDP_HDR_SIZE;
-            uint64_t seq;
-            memcpy(&seq, payload, sizeof(seq));
+        // Get sequence number from payload
+        uint8_t *payload = pkt_data + RAW_PKT_ETH_HDR_SIZE + RAW_PKT_IP_HDR_SIZE + RAW_PKT_UDP_HDR_SIZE;
+        uint64_t seq;
+        memcpy(&seq, payload, sizeof(seq));
 
-            pthread_spin_lock(&source->stats.lock);
-            source->stats.rx_packets++;
-            source->stats.rx_bytes += pkt_len;
-            pthread_spin_unlock(&source->stats.lock);
+        struct stats_counters *slc = &c->src_lc[source_idx];
+        slc->pkts++;
+        slc->bytes += pkt_len;
 
-            // Sequence validation
+        // Sequence validation (VL steering'de VL'in tek yazarı bu queue: kilit yok)
+        const bool vl_lock = !port->rx_vl_steered;
+        if (vl_lock)
             pthread_spin_lock(&source->vl_sequences[vl_index].rx_lock);
 
-            if (!source->vl_sequences[vl_index].rx_initialized) {
-                source->vl_sequences[vl_index].rx_expected_seq = seq + 1;
-                source->vl_sequences[vl_index].rx_initialized = true;
-            } else {
-                uint64_t expected = source->vl_sequences[vl_index].rx_expected_seq;
-                if (seq > expected) {
-                    uint64_t gap = seq - expected;
-                    pthread_spin_lock(&source->stats.lock);
-                    source->stats.lost_pkts += gap;
-                    pthread_spin_unlock(&source->stats.lock);
-                }
-                source->vl_sequences[vl_index].rx_expected_seq = seq + 1;
+        if (!source->vl_sequences[vl_index].rx_initialized) {
+            source->vl_sequences[vl_index].rx_expected_seq = seq + 1;
+            source->vl_sequences[vl_index].rx_initialized = true;
+        } else {
+            uint64_t expected = source->vl_sequences[vl_index].rx_expected_seq;
+            if (seq > expected) {
+                slc->lost_pkts += seq - expected;
             }
+            source->vl_sequences[vl_index].rx_expected_seq = seq + 1;
+        }
 
+        if (vl_lock)
             pthread_spin_unlock(&source->vl_sequences[vl_index].rx_lock);
 
-            // PRBS verification - find partner port
-            struct raw_socket_port *partner = NULL;
-            uint16_t partner_port_id = source->config.source_port;
-            for (int i = 0; i < active_raw_port_count; i++) {
-                if (raw_ports[i].port_id == partner_port_id) {
-                    partner = &raw_ports[i];
-                    break;
-                }
+        // PRBS verification - find partner port
+        struct raw_socket_port *partner = NULL;
+        uint16_t partner_port_id = source->config.source_port;
+        for (int i = 0; i < active_raw_port_count; i++) {
+            if (raw_ports[i].port_id == partner_port_id) {
+                partner = &raw_ports[i];
+                break;
             }
+        }
 
-            if (partner && partner->prbs_initialized && partner->prbs_cache_ext) {
-                uint8_t *recv_prbs = payload + RAW_PKT_SEQ_BYTES;
+        if (partner && partner->prbs_initialized) {
+            uint8_t *recv_prbs = payload + RAW_PKT_SEQ_BYTES;
 #if IMIX_ENABLED
-                // IMIX: PRBS offset hesabı HEP MAX boyut ile yapılır
-                uint64_t prbs_offset = (seq * (uint64_t)RAW_MAX_PRBS_BYTES) % RAW_PRBS_CACHE_SIZE;
+            // IMIX: PRBS offset hesabı HEP MAX boyut ile yapılır
+            uint64_t prbs_offset = (seq * (uint64_t)RAW_MAX_PRBS_BYTES) % RAW_PRBS_CACHE_SIZE;
 #else
-                uint64_t prbs_offset = (seq * (uint64_t)RAW_PKT_PRBS_BYTES) % RAW_PRBS_CACHE_SIZE;
+            uint64_t prbs_offset = (seq * (uint64_t)RAW_PKT_PRBS_BYTES) % RAW_PRBS_CACHE_SIZE;
 #endif
-                uint8_t *expected_prbs = partner->prbs_cache_ext + prbs_offset;
+            uint16_t cmp_bytes = pkt_len - RAW_PKT_ETH_HDR_SIZE - RAW_PKT_IP_HDR_SIZE -
+                                 RAW_PKT_UDP_HDR_SIZE - RAW_PKT_SEQ_BYTES;
+            if (cmp_bytes > RAW_MAX_PRBS_BYTES) cmp_bytes = RAW_MAX_PRBS_BYTES;
+            uint32_t prbs_bit_errors = prbs_window_verify(&partner->prbs_win, prbs_offset,
+                                                          recv_prbs, cmp_bytes, c->prbs_lfsr);
+            if (likely(prbs_bit_errors == 0)) {
+                slc->good_pkts++;
+            } else {
+                slc->bad_pkts++;
+                slc->bit_errors += prbs_bit_errors;
+            }
+        } else {
+            slc->good_pkts++;
+        }
 
-                uint16_t cmp_bytes = pkt_len - RAW_PKT_ETH_HDR_SIZE - RAW_PKT_IP_HDR_SIZE -
-                                     RAW_PKT_UDP_HDR_SIZE - RAW_PKT_SEQ_BYTES;
-                if (cmp_bytes > RAW_MAX_PRBS_BYTES) cmp_bytes = RAW_MAX_PRBS_BYTES;
+        if (++c->unpublished >= RAW_RX_PUBLISH_BATCH)
+            mq_rx_ctx_publish(c);
+    }
+}
 
-                pthread_spin_lock(&source->stats.lock);
-                if (memcmp(recv_prbs, expected_prbs, cmp_bytes) == 0) {
-                    source->stats.good_pkts++;
-                } else {
-                    source->stats.bad_pkts++;
-                    for (int b = 0; b < cmp_bytes; b++) {
-                        uint8_t diff = recv_prbs[b] ^ expected_prbs[b];
-                        source->stats.bit_errors += __builtin_popcount(diff);
-                    }
-                }
-                pthread_spin_unlock(&source->stats.lock);
-            } else {
-                pthread_spin_lock(&source->stats.lock);
-                source->stats.good_pkts++;
-                pthread_spin_unlock(&source->stats.lock);
+// TPACKET_V2: frame başına status kontrolü
+static void mq_rx_loop_v2(struct mq_rx_ctx *c)
+{
+    struct raw_socket_port *port = c->port;
+    struct raw_rx_queue *queue = c->queue;
+    uint32_t empty_polls = 0;
+    const uint32_t BUSY_POLL_COUNT = 64;
+
+    while (!port->stop_flag && (g_stop_flag == NULL || !*g_stop_flag)) {
+        struct tpacket2_hdr *hdr = (struct tpacket2_hdr *)(
+            (uint8_t *)queue->ring +
+            (queue->ring_offset * RAW_SOCKET_RING_FRAME_SIZE));
+
+        if (!(hdr->tp_status & TP_STATUS_USER)) {
+            empty_polls++;
+            if (empty_polls < BUSY_POLL_COUNT) {
+                _mm_pause();
+                continue;
             }
+            // Flush local stats before blocking
+            if (c->unpublished > 0) {
+                mq_rx_idle_flush(c);
+                mq_rx_kernel_stats(queue);
+            }
+            struct pollfd pfd = {queue->socket_fd, POLLIN, 0};
+            poll(&pfd, 1, 1);
+            empty_polls = 0;
+            continue;
         }
+        empty_polls = 0;
+
+        // Skip our own outgoing TX packets (kernel marks them as PACKET_OUTGOING)
+        struct sockaddr_ll *sll = (struct sockaddr_ll *)(
+            (uint8_t *)hdr + TPACKET_ALIGN(sizeof(struct tpacket2_hdr)));
+        if (sll->sll_pkttype != PACKET_OUTGOING)
+            mq_rx_frame(c, (uint8_t *)hdr + hdr->tp_mac, hdr->tp_len);
 
         hdr->tp_status = TP_STATUS_KERNEL;
         queue->ring_offset = (queue->ring_offset + 1) % RAW_SOCKET_RING_FRAME_NR;
     }
+}
+
+// TPACKET_V3: kernel bloğu doldurunca veya retire timeout'unda verir; blok
+// başına tek status okuması, bloktaki frame'ler art arda işlenir
+static void mq_rx_loop_v3(struct mq_rx_ctx *c)
+{
+    struct raw_socket_port *port = c->port;
+    struct raw_rx_queue *queue = c->queue;
+    uint32_t block = 0;
+    uint32_t blocks_since_stats = 0;
+
+    while (!port->stop_flag && (g_stop_flag == NULL || !*g_stop_flag)) {
+        struct tpacket_block_desc *bd = (struct tpacket_block_desc *)(
+            (uint8_t *)queue->ring + (size_t)block * RAW_SOCKET_V3_BLOCK_SIZE);
+
+        if (!(__atomic_load_n(&bd->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER)) {
+            // Retire timer en geç RAW_SOCKET_V3_RETIRE_TOV_MS'de uyandırır;
+            // poll timeout sadece stop flag kontrolü için
+            mq_rx_idle_flush(c);
+            if (blocks_since_stats > 0) {
+                mq_rx_kernel_stats(queue);
+                blocks_since_stats = 0;
+            }
+            struct pollfd pfd = {queue->socket_fd, POLLIN | POLLERR, 0};
+            poll(&pfd, 1, RAW_SOCKET_V3_POLL_MS);
+            continue;
+        }
+
+        // Sıradaki blok: descriptor + ilk frame header'ı bu blok işlenirken gelsin
+        const uint32_t next = (block + 1) % queue->block_nr;
+        const uint8_t *next_bd = (const uint8_t *)queue->ring + (size_t)next * RAW_SOCKET_V3_BLOCK_SIZE;
+        __builtin_prefetch(next_bd);
+        __builtin_prefetch(next_bd + bd->hdr.bh1.offset_to_first_pkt);
+
+        const uint32_t num_pkts = bd->hdr.bh1.num_pkts;
+        struct tpacket3_hdr *ppd = (struct tpacket3_hdr *)(
+            (uint8_t *)bd + bd->hdr.bh1.offset_to_first_pkt);
+
+        for (uint32_t i = 0; i < num_pkts; i++) {
+            struct tpacket3_hdr *nppd = (struct tpacket3_hdr *)((uint8_t *)ppd + ppd->tp_next_offset);
+            if (i + 1 < num_pkts) {
+                __builtin_prefetch(nppd);
+                __builtin_prefetch((uint8_t *)nppd + RTE_CACHE_LINE_SIZE);  // tp_mac: ETH + IP + UDP + SEQ
+            }
+
+            // Skip our own outgoing TX packets (kernel marks them as PACKET_OUTGOING)
+            const struct sockaddr_ll *sll = (const struct sockaddr_ll *)(
+                (uint8_t *)ppd + TPACKET_ALIGN(sizeof(struct tpacket3_hdr)));
+            if (sll->sll_pkttype != PACKET_OUTGOING)
+                mq_rx_frame(c, (uint8_t *)ppd + ppd->tp_mac, ppd->tp_snaplen);
+            ppd = nppd;
+        }
+
+        __atomic_store_n(&bd->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+        block = next;
+        queue->blocks++;
+
+        // Yük altında boşta kalınmayabilir: drop sayaçları blok aralığıyla da okunur
+        if (++blocks_since_stats >= RAW_SOCKET_V3_STATS_BLOCKS) {
+            mq_rx_kernel_stats(queue);
+            blocks_since_stats = 0;
+        }
+    }
+}
+
+// AF_XDP: XDP programı bu queue'ya sadece bizim VL-ID'leri yönlendirir;
+// descriptor UMEM'deki frame'i gösterir, işlenen frame fill ring'e döner
+static void mq_rx_loop_xdp(struct mq_rx_ctx *c)
+{
+    struct raw_socket_port *port = c->port;
+    struct raw_rx_queue *queue = c->queue;
+    struct raw_xdp_queue *xq = queue->xdp;
+    uint8_t *umem = port->xdp->umem;
+    uint32_t batches_since_stats = 0;
+
+    while (!port->stop_flag && (g_stop_flag == NULL || !*g_stop_flag)) {
+        uint32_t idx_rx, idx_fill;
+        const uint32_t n = raw_xdp_cons_peek(&xq->rx, RAW_XDP_RX_BATCH, &idx_rx);
+
+        if (n == 0) {
+            mq_rx_idle_flush(c);
+            if (batches_since_stats > 0) {
+                mq_rx_kernel_stats(queue);
+                batches_since_stats = 0;
+            }
+            struct pollfd pfd = {xq->fd, POLLIN, 0};
+            poll(&pfd, 1, RAW_XDP_POLL_MS);
+            continue;
+        }
+
+        // Fill ring frame sayısı kadar: alınan her frame için yer vardır
+        while (raw_xdp_prod_reserve(&xq->fill, n, &idx_fill) != n)
+            _mm_pause();
+
+        for (uint32_t i = 0; i < n; i++) {
+            const struct xdp_desc *d = raw_xdp_desc(&xq->rx, idx_rx + i);
+            if (i + 1 < n)
+                __builtin_prefetch(umem + raw_xdp_desc(&xq->rx, idx_rx + i + 1)->addr);
+
+            mq_rx_frame(c, umem + d->addr, d->len);
+            // addr = chunk + headroom: chunk başı fill ring'e
+            *raw_xdp_addr(&xq->fill, idx_fill + i) = d->addr & ~(uint64_t)(RAW_XDP_FRAME_SIZE - 1);
+        }
+
+        raw_xdp_cons_release(&xq->rx, n);
+        raw_xdp_prod_submit(&xq->fill, n);
+
+        // Zero-copy'de sürücü boş fill ring'de durur: uyandır
+        if (xq->zerocopy && raw_xdp_needs_wakeup(port->xdp, &xq->fill))
+            recvfrom(xq->fd, NULL, 0, MSG_DONTWAIT, NULL, NULL);
+
+        if (++batches_since_stats >= RAW_XDP_STATS_BATCHES) {
+            mq_rx_kernel_stats(queue);
+            batches_since_stats = 0;
+        }
+    }
+}
+
+void *multi_queue_rx_worker(void *arg)
+{
+    struct multi_queue_worker_arg *warg = (struct multi_queue_worker_arg *)arg;
+    struct raw_socket_port *port = warg->port;
+    struct raw_rx_queue *queue = warg->queue;
+    struct mq_rx_ctx c;
+
+    memset(&c, 0, sizeof(c));
+    c.port = port;
+    c.queue = queue;
+    c.prbs_lfsr = prbs_verify_port_uses_lfsr(port->port_id);
+
+    printf("[Port %u Q%d RX Worker] Started on CPU core %u (%s, PRBS %s engine)\n",
+           port->port_id, queue->queue_id, queue->cpu_core,
+           queue->xdp ? "AF_XDP" : queue->tpacket_v3 ? "TPACKET_V3" : "TPACKET_V2",
+           c.prbs_lfsr ? "LFSR" : "cache");
+
+    queue->running = true;
+
+    // Kaynak port / PRBS akışı seçimi flow registry'den (flow_lookup)
+    // Note: Using global sequence tracking (g_vl_seq) instead of per-queue
+    c.raw_idx = (int)(port - raw_ports);
+
+    // Queue'ya özel stats shard'ları (instance = queue id)
+    // Note: lost_pkts is calculated globally via get_global_sequence_lost()
+    c.ext_stats = stats_shard_create(STATS_DOM_RAW_EXT_RX, c.raw_idx, 0,
+                                     queue->queue_id, SOCKET_ID_ANY);
+    for (uint16_t s = 0; s < port->rx_source_count; s++)
+        c.src_stats[s] = stats_shard_create(STATS_DOM_RAW_RX, c.raw_idx, s, queue->queue_id,
+                                            SOCKET_ID_ANY);
+
+    c.local_vl_min = 0xFFFF;
+    c.local_vl_max = 0;
+    queue->vl_id_min = 0xFFFF;
+    queue->vl_id_max = 0;
+    queue->unique_vl_ids = 0;
+
+    if (queue->xdp)
+        mq_rx_loop_xdp(&c);
+    else if (queue->tpacket_v3)
+        mq_rx_loop_v3(&c);
+    else
+        mq_rx_loop_v2(&c);
 
     // Final stats flush
-    if (local_rx_pkts > 0) {
-        pthread_spin_lock(&port->dpdk_ext_rx_stats.lock);
-        port->dpdk_ext_rx_stats.rx_packets += local_rx_pkts;
-        port->dpdk_ext_rx_stats.rx_bytes += local_rx_bytes;
-        port->dpdk_ext_rx_stats.good_pkts += local_good;
-        port->dpdk_ext_rx_stats.bad_pkts += local_bad;
-        port->dpdk_ext_rx_stats.bit_errors += local_bit_errors;
-        pthread_spin_unlock(&port->dpdk_ext_rx_stats.lock);
-
-        queue->rx_packets += local_rx_pkts;
-        queue->rx_bytes += local_rx_bytes;
-        queue->good_pkts += local_good;
-        queue->bad_pkts += local_bad;
-        queue->bit_errors += local_bit_errors;
-    }
-
-    printf("[Port %u Q%d RX Worker] Stopped (pkts=%lu, good=%lu, bad=%lu)\n",
+    mq_rx_ctx_publish(&c);
+    mq_rx_kernel_stats(queue);
+
+    printf("[Port %u Q%d RX Worker] Stopped (pkts=%lu, good=%lu, bad=%lu, kdrop=%lu)\n",
            port->port_id, queue->queue_id, queue->rx_packets,
-           queue->good_pkts, queue->bad_pkts);
+           queue->good_pkts, queue->bad_pkts, queue->kernel_drops);
     queue->running = false;
     return NULL;
 }
@@ -2248,6 +2618,10 @@ int start_raw_socket_workers(volatile bool *stop_flag)
     for (int i = 0; i < active_raw_port_count; i++) {
         raw_ports[i].stop_flag = false;
 
+        // AF_XDP: flow registry hazır, VL-ID yönlendirme haritası doldurulur
+        if (raw_ports[i].xdp && raw_xdp_port_steer(&raw_ports[i]) < 0)
+            return -1;
+
         if (raw_ports[i].use_multi_queue_rx) {
             if (start_multi_queue_rx_workers(&raw_ports[i], stop_flag) != 0) {
                 fprintf(stderr, "[Port %u] Failed to start multi-queue RX workers\n", raw_ports[i].port_id);
@@ -2322,8 +2696,53 @@ static uint64_t prev_rx_bytes[MAX_RAW_SOCKET_PORTS][MAX_RAW_TARGETS] = {{0}};
 static uint64_t prev_dpdk_ext_rx_bytes_p12 = 0;  // Port 12 DPDK RX tracking
 static uint64_t prev_dpdk_ext_rx_bytes_p13 = 0;  // Port 13 DPDK RX tracking
 static uint64_t last_stats_time_ns = 0;
+static uint64_t prev_rxq_cpu_ns[MAX_RAW_SOCKET_PORTS][RAW_SOCKET_RX_QUEUE_COUNT];
 
-void print_raw_socket_stats(void)
+// Queue thread'inin son aralıktaki CPU kullanımı (% tek core), ilk aralıkta -1
+static double rxq_cpu_pct(int raw_idx, int q, const struct raw_rx_queue *rq, double elapsed_sec)
+{
+    clockid_t cid;
+    struct timespec ts;
+
+    if (!rq->running || pthread_getcpuclockid(rq->thread, &cid) != 0 ||
+        clock_gettime(cid, &ts) != 0)
+        return -1.0;
+
+    const uint64_t ns = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    const uint64_t prev = prev_rxq_cpu_ns[raw_idx][q];
+    prev_rxq_cpu_ns[raw_idx][q] = ns;
+    if (prev == 0 || ns < prev)
+        return -1.0;
+    return (double)(ns - prev) * 100.0 / (elapsed_sec * 1e9);
+}
+
+// Multi-queue RX satırı: CPU%, kernel drop / freeze, V3'te blok başına frame
+static void print_rxq_line(int raw_idx, int q, const struct raw_rx_queue *rq, double elapsed_sec)
+{
+    const double cpu = rxq_cpu_pct(raw_idx, q, rq, elapsed_sec);
+    char cpu_s[16], mode_s[48];
+
+    if (cpu >= 0.0)
+        snprintf(cpu_s, sizeof(cpu_s), "%5.1f%%", cpu);
+    else
+        snprintf(cpu_s, sizeof(cpu_s), "%6s", "-");
+    if (rq->xdp)
+        snprintf(mode_s, sizeof(mode_s), "XDP %s/%s", rq->xdp->zerocopy ? "zc" : "copy",
+                 rq->xdp->drv_mode ? "drv" : "skb");
+    else if (rq->tpacket_v3)
+        snprintf(mode_s, sizeof(mode_s), "V3 Frz=%lu F/Blk=%.1f", rq->kernel_freezes,
+                 rq->blocks > 0 ? (double)rq->rx_packets / (double)rq->blocks : 0.0);
+    else
+        snprintf(mode_s, sizeof(mode_s), "V2");
+
+    printf("    Q%d (CPU %2u %s): RX=%9lu Good=%9lu KDrop=%8lu %s VL-ID=[%u-%u] (%u unique)\n",
+           q, rq->cpu_core, cpu_s, rq->rx_packets, rq->good_pkts, rq->kernel_drops, mode_s,
+           rq->vl_id_min == 0xFFFF ? 0 : rq->vl_id_min,
+           rq->vl_id_max,
+           rq->unique_vl_ids);
+}
+
+void print_raw_socket_stats(const struct stats_snapshot *snap)
 {
     uint64_t now_ns = get_time_ns();
     double elapsed_sec = 1.0;
@@ -2346,12 +2765,11 @@ void print_raw_socket_stats(void)
         // Print TX targets
         for (int t = 0; t < port->tx_target_count; t++) {
             struct raw_tx_target_state *target = &port->tx_targets[t];
+            const struct stats_counters *tx = &snap->raw_tx[p][t];
 
-            pthread_spin_lock(&target->stats.lock);
-
-            uint64_t tx_bytes_delta = target->stats.tx_bytes - prev_tx_bytes[p][t];
+            uint64_t tx_bytes_delta = tx->bytes - prev_tx_bytes[p][t];
             double tx_mbps = (tx_bytes_delta * 8.0) / (elapsed_sec * 1000000.0);
-            prev_tx_bytes[p][t] = target->stats.tx_bytes;
+            prev_tx_bytes[p][t] = tx->bytes;
 
             // Find corresponding RX stats from the destination port
             uint64_t rx_pkts = 0, good = 0, bad = 0, lost = 0, bit_err = 0;
@@ -2362,14 +2780,12 @@ void print_raw_socket_stats(void)
                     for (int s = 0; s < raw_ports[dp].rx_source_count; s++) {
                         if (raw_ports[dp].rx_sources[s].config.source_port == port->port_id &&
                             raw_ports[dp].rx_sources[s].config.vl_id_start == target->config.vl_id_start) {
-                            struct raw_rx_source_state *src = &raw_ports[dp].rx_sources[s];
-                            pthread_spin_lock(&src->stats.lock);
-                            rx_pkts = src->stats.rx_packets;
-                            good = src->stats.good_pkts;
-                            bad = src->stats.bad_pkts;
-                            lost = src->stats.lost_pkts;
-                            bit_err = src->stats.bit_errors;
-                            pthread_spin_unlock(&src->stats.lock);
+                            const struct stats_counters *rx = &snap->raw_rx[dp][s];
+                            rx_pkts = rx->pkts;
+                            good = rx->good_pkts;
+                            bad = rx->bad_pkts;
+                            lost = rx->lost_pkts;
+                            bit_err = rx->bit_errors;
                             break;
                         }
                     }
@@ -2386,10 +2802,8 @@ void print_raw_socket_stats(void)
 
             printf("║     P%-3u     ║     P%-3u     ║    %3u Mbps    ║ %19lu ║ %14.2f ║ %19lu ║ %19lu ║ %19lu ║ %19lu ║ %19lu ║ %23.2e ║\n",
                    port->port_id, target->config.dest_port, target->config.rate_mbps,
-                   target->stats.tx_packets, tx_mbps,
+                   tx->pkts, tx_mbps,
                    rx_pkts, good, bad, lost, bit_err, target_ber);
-
-            pthread_spin_unlock(&target->stats.lock);
         }
     }
 
@@ -2400,13 +2814,12 @@ void print_raw_socket_stats(void)
   if (active_raw_port_count <= NORMAL_RAW_SOCKET_PORT_COUNT) {
     struct raw_socket_port *port12 = &raw_ports[0]; // Port 12 is index 0
     if (port12->port_id == 12) {
-        pthread_spin_lock(&port12->dpdk_ext_rx_stats.lock);
-        uint64_t dpdk_rx = port12->dpdk_ext_rx_stats.rx_packets;
-        uint64_t dpdk_rx_bytes = port12->dpdk_ext_rx_stats.rx_bytes;
-        uint64_t dpdk_good = port12->dpdk_ext_rx_stats.good_pkts;
-        uint64_t dpdk_bad = port12->dpdk_ext_rx_stats.bad_pkts;
-        uint64_t dpdk_bit_err = port12->dpdk_ext_rx_stats.bit_errors;
-        pthread_spin_unlock(&port12->dpdk_ext_rx_stats.lock);
+        const struct stats_counters *ext = &snap->raw_ext_rx[0];
+        uint64_t dpdk_rx = ext->pkts;
+        uint64_t dpdk_rx_bytes = ext->bytes;
+        uint64_t dpdk_good = ext->good_pkts;
+        uint64_t dpdk_bad = ext->bad_pkts;
+        uint64_t dpdk_bit_err = ext->bit_errors;
 
         // Get lost count from global sequence tracking
         uint64_t dpdk_lost = get_global_sequence_lost();
@@ -2433,14 +2846,11 @@ void print_raw_socket_stats(void)
 
         // Show per-queue statistics if multi-queue is enabled
         if (port12->use_multi_queue_rx && port12->rx_queue_count > 0) {
-            printf("  Multi-Queue RX Stats (Lost is tracked globally across all queues):\n");
+            printf("  Multi-Queue RX Stats (Lost is tracked globally across all queues, %s, reordered=%lu):\n",
+                   port12->rx_vl_steered ? "VL steered" : "hash fanout",
+                   global_sequence_reordered(g_vl_seq_p12, GLOBAL_SEQ_VL_ID_COUNT_P12));
             for (int q = 0; q < port12->rx_queue_count; q++) {
-                struct raw_rx_queue *rq = &port12->rx_queues[q];
-                printf("    Q%d (CPU %2u): RX=%9lu Good=%9lu KDrop=%8lu VL-ID=[%u-%u] (%u unique)\n",
-                       q, rq->cpu_core, rq->rx_packets, rq->good_pkts, rq->kernel_drops,
-                       rq->vl_id_min == 0xFFFF ? 0 : rq->vl_id_min,
-                       rq->vl_id_max,
-                       rq->unique_vl_ids);
+                print_rxq_line(0, q, &port12->rx_queues[q], elapsed_sec);
             }
             // Debug: show per-VL-ID sequence stats
             print_global_sequence_debug();
@@ -2450,13 +2860,12 @@ void print_raw_socket_stats(void)
     // Port 13 DPDK External RX Stats (from Port 0,6)
     struct raw_socket_port *port13 = &raw_ports[1]; // Port 13 is index 1
     if (port13->port_id == 13) {
-        pthread_spin_lock(&port13->dpdk_ext_rx_stats.lock);
-        uint64_t dpdk_rx_p13 = port13->dpdk_ext_rx_stats.rx_packets;
-        uint64_t dpdk_rx_bytes_p13 = port13->dpdk_ext_rx_stats.rx_bytes;
-        uint64_t dpdk_good_p13 = port13->dpdk_ext_rx_stats.good_pkts;
-        uint64_t dpdk_bad_p13 = port13->dpdk_ext_rx_stats.bad_pkts;
-        uint64_t dpdk_bit_err_p13 = port13->dpdk_ext_rx_stats.bit_errors;
-        pthread_spin_unlock(&port13->dpdk_ext_rx_stats.lock);
+        const struct stats_counters *ext_p13 = &snap->raw_ext_rx[1];
+        uint64_t dpdk_rx_p13 = ext_p13->pkts;
+        uint64_t dpdk_rx_bytes_p13 = ext_p13->bytes;
+        uint64_t dpdk_good_p13 = ext_p13->good_pkts;
+        uint64_t dpdk_bad_p13 = ext_p13->bad_pkts;
+        uint64_t dpdk_bit_err_p13 = ext_p13->bit_errors;
         // Get lost from global sequence tracking (not from stats struct)
         uint64_t dpdk_lost_p13 = get_global_sequence_lost_p13();
 
@@ -2482,14 +2891,11 @@ void print_raw_socket_stats(void)
 
         // Show per-queue statistics if multi-queue is enabled for Port 13
         if (port13->use_multi_queue_rx && port13->rx_queue_count > 0) {
-            printf("  Multi-Queue RX Stats:\n");
+            printf("  Multi-Queue RX Stats (%s, reordered=%lu):\n",
+                   port13->rx_vl_steered ? "VL steered" : "hash fanout",
+                   global_sequence_reordered(g_vl_seq_p13, GLOBAL_SEQ_VL_ID_COUNT_P13));
             for (int q = 0; q < port13->rx_queue_count; q++) {
-                struct raw_rx_queue *rq = &port13->rx_queues[q];
-                printf("    Q%d (CPU %2u): RX=%9lu Good=%9lu KDrop=%8lu VL-ID=[%u-%u] (%u unique)\n",
-                       q, rq->cpu_core, rq->rx_packets, rq->good_pkts, rq->kernel_drops,
-                       rq->vl_id_min == 0xFFFF ? 0 : rq->vl_id_min,
-                       rq->vl_id_max,
-                       rq->unique_vl_ids);
+                print_rxq_line(1, q, &port13->rx_queues[q], elapsed_sec);
             }
         }
     }
@@ -2499,31 +2905,10 @@ void print_raw_socket_stats(void)
 
 void reset_raw_socket_stats(void)
 {
-    for (int p = 0; p < active_raw_port_count; p++) {
-        struct raw_socket_port *port = &raw_ports[p];
-
-        for (int t = 0; t < port->tx_target_count; t++) {
-            pthread_spin_lock(&port->tx_targets[t].stats.lock);
-            memset(&port->tx_targets[t].stats, 0, sizeof(struct raw_target_stats));
-            pthread_spin_init(&port->tx_targets[t].stats.lock, PTHREAD_PROCESS_PRIVATE);
-            pthread_spin_unlock(&port->tx_targets[t].stats.lock);
-            prev_tx_bytes[p][t] = 0;
-        }
-
-        for (int s = 0; s < port->rx_source_count; s++) {
-            pthread_spin_lock(&port->rx_sources[s].stats.lock);
-            memset(&port->rx_sources[s].stats, 0, sizeof(struct raw_target_stats));
-            pthread_spin_init(&port->rx_sources[s].stats.lock, PTHREAD_PROCESS_PRIVATE);
-            pthread_spin_unlock(&port->rx_sources[s].stats.lock);
-            prev_rx_bytes[p][s] = 0;
-        }
-
-        // Reset DPDK external RX stats
-        pthread_spin_lock(&port->dpdk_ext_rx_stats.lock);
-        memset(&port->dpdk_ext_rx_stats, 0, sizeof(struct raw_target_stats));
-        pthread_spin_init(&port->dpdk_ext_rx_stats.lock, PTHREAD_PROCESS_PRIVATE);
-        pthread_spin_unlock(&port->dpdk_ext_rx_stats.lock);
-    }
+    // Shard sayaçları stats_reset() (init_rx_stats) ile baseline'a alınır;
+    // burada sadece hız hesabının önceki değerleri sıfırlanır
+    memset(prev_tx_bytes, 0, sizeof(prev_tx_bytes));
+    memset(prev_rx_bytes, 0, sizeof(prev_rx_bytes));
     prev_dpdk_ext_rx_bytes_p12 = 0;
     prev_dpdk_ext_rx_bytes_p13 = 0;
     last_stats_time_ns = 0;
@@ -2546,6 +2931,12 @@ void cleanup_raw_socket_ports(void)
 
         port->stop_flag = true;
 
+        // AF_XDP: program, XSK soketleri ve UMEM (TX ve RX birlikte)
+        raw_xdp_port_close(port);
+
+        // sendmmsg / io_uring: uçuştaki yazmalar beklenir, havuz serbest
+        raw_tx_batch_close(port);
+
         if (port->tx_ring && port->tx_ring != MAP_FAILED) {
             munmap(port->tx_ring, port->tx_ring_size);
         }
@@ -2573,34 +2964,21 @@ void cleanup_raw_socket_ports(void)
             if (port->rx_socket >= 0) close(port->rx_socket);
         }
 
-        if (port->prbs_cache) free(port->prbs_cache);
-        if (port->prbs_cache_ext) free(port->prbs_cache_ext);
-
-        for (int t = 0; t < port->tx_target_count; t++) {
-            if (port->tx_targets[t].vl_sequences) {
-                for (uint16_t v = 0; v < port->tx_targets[t].config.vl_id_count; v++) {
-                    pthread_spin_destroy(&port->tx_targets[t].vl_sequences[v].tx_lock);
-                    pthread_spin_destroy(&port->tx_targets[t].vl_sequences[v].rx_lock);
-                }
-                free(port->tx_targets[t].vl_sequences);
-            }
-            pthread_spin_destroy(&port->tx_targets[t].stats.lock);
+        if (port->prbs_initialized) {
+            prbs_window_free(&port->prbs_win);
+            port->prbs_initialized = false;
         }
 
+        // TX sequence blokları ve stats shard'ları registry'de kalır (snapshot API için)
         for (int s = 0; s < port->rx_source_count; s++) {
             if (port->rx_sources[s].vl_sequences) {
                 for (uint16_t v = 0; v < port->rx_sources[s].config.vl_id_count; v++) {
-                    pthread_spin_destroy(&port->rx_sources[s].vl_sequences[v].tx_lock);
                     pthread_spin_destroy(&port->rx_sources[s].vl_sequences[v].rx_lock);
                 }
                 free(port->rx_sources[s].vl_sequences);
             }
-            pthread_spin_destroy(&port->rx_sources[s].stats.lock);
         }
 
-        // Cleanup DPDK external RX stats
-        pthread_spin_destroy(&port->dpdk_ext_rx_stats.lock);
-
         printf("[Raw Port %d] Cleanup complete\n", port->port_id);
     }
 
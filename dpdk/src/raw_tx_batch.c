@@ -0,0 +1,450 @@
+#define _GNU_SOURCE
+#include "raw_tx_batch.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+#include <linux/io_uring.h>
+#include <arpa/inet.h>
+
+// ==========================================
+// IO_URING SYSCALL WRAPPERS (liburing yok)
+// ==========================================
+
+struct raw_tx_uring {
+    int fd;
+
+    // SQ ring
+    uint32_t *sq_head;
+    uint32_t *sq_tail;
+    uint32_t sq_mask;
+    uint32_t *sq_array;
+    struct io_uring_sqe *sqes;
+
+    // CQ ring
+    uint32_t *cq_head;
+    uint32_t *cq_tail;
+    uint32_t cq_mask;
+    struct io_uring_cqe *cqes;
+
+    void *sq_map;
+    size_t sq_map_size;
+    void *cq_map;                       // SINGLE_MMAP: sq_map ile aynı
+    size_t cq_map_size;
+    size_t sqes_size;
+};
+
+static int sys_io_uring_setup(unsigned entries, struct io_uring_params *p)
+{
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+static int sys_io_uring_register(int fd, unsigned opcode, const void *arg, unsigned nr_args)
+{
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+const char *raw_tx_submit_name(uint8_t mode)
+{
+    switch (mode) {
+    case RAW_TX_SUBMIT_SENDMMSG: return "sendmmsg";
+    case RAW_TX_SUBMIT_IO_URING: return "io_uring";
+    default:                     return "ring";
+    }
+}
+
+// ==========================================
+// IO_URING SETUP
+// ==========================================
+
+static void uring_free(struct raw_tx_uring *u)
+{
+    if (u == NULL)
+        return;
+    if (u->sqes && u->sqes != MAP_FAILED)
+        munmap(u->sqes, u->sqes_size);
+    if (u->cq_map && u->cq_map != MAP_FAILED && u->cq_map != u->sq_map)
+        munmap(u->cq_map, u->cq_map_size);
+    if (u->sq_map && u->sq_map != MAP_FAILED)
+        munmap(u->sq_map, u->sq_map_size);
+    if (u->fd >= 0)
+        close(u->fd);
+    free(u);
+}
+
+// Ring + registered buffer (tüm havuz tek iovec) + registered file (TX soketi)
+static struct raw_tx_uring *uring_open(uint16_t port_id, int sock_fd, uint8_t *pool, size_t pool_size)
+{
+    struct raw_tx_uring *u = calloc(1, sizeof(*u));
+    if (u == NULL)
+        return NULL;
+
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    // COOP_TASKRUN: io-wq completion'ları bir sonraki enter'da işlenir (IPI yok)
+    p.flags = IORING_SETUP_COOP_TASKRUN;
+    u->fd = sys_io_uring_setup(RAW_TX_BATCH_FRAMES, &p);
+    if (u->fd < 0 && errno == EINVAL) {
+        memset(&p, 0, sizeof(p));
+        u->fd = sys_io_uring_setup(RAW_TX_BATCH_FRAMES, &p);
+    }
+    if (u->fd < 0) {
+        fprintf(stderr, "[Port %u TX] io_uring_setup failed: %s\n", port_id, strerror(errno));
+        free(u);
+        return NULL;
+    }
+
+    u->sq_map_size = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+    u->cq_map_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (u->cq_map_size > u->sq_map_size)
+            u->sq_map_size = u->cq_map_size;
+        u->cq_map_size = u->sq_map_size;
+    }
+
+    u->sq_map = mmap(NULL, u->sq_map_size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, u->fd, IORING_OFF_SQ_RING);
+    if (u->sq_map == MAP_FAILED)
+        goto fail_mmap;
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        u->cq_map = u->sq_map;
+    } else {
+        u->cq_map = mmap(NULL, u->cq_map_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, u->fd, IORING_OFF_CQ_RING);
+        if (u->cq_map == MAP_FAILED)
+            goto fail_mmap;
+    }
+    u->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    u->sqes = mmap(NULL, u->sqes_size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, u->fd, IORING_OFF_SQES);
+    if (u->sqes == MAP_FAILED)
+        goto fail_mmap;
+
+    uint8_t *sq = u->sq_map;
+    uint8_t *cq = u->cq_map;
+    u->sq_head = (uint32_t *)(sq + p.sq_off.head);
+    u->sq_tail = (uint32_t *)(sq + p.sq_off.tail);
+    u->sq_mask = *(uint32_t *)(sq + p.sq_off.ring_mask);
+    u->sq_array = (uint32_t *)(sq + p.sq_off.array);
+    u->cq_head = (uint32_t *)(cq + p.cq_off.head);
+    u->cq_tail = (uint32_t *)(cq + p.cq_off.tail);
+    u->cq_mask = *(uint32_t *)(cq + p.cq_off.ring_mask);
+    u->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+
+    // SQ array'i sabit: slot i → sqe i
+    for (uint32_t i = 0; i < p.sq_entries; i++)
+        u->sq_array[i] = i;
+
+    struct iovec reg = { .iov_base = pool, .iov_len = pool_size };
+    if (sys_io_uring_register(u->fd, IORING_REGISTER_BUFFERS, &reg, 1) < 0) {
+        fprintf(stderr, "[Port %u TX] io_uring buffer register failed: %s (RLIMIT_MEMLOCK?)\n",
+                port_id, strerror(errno));
+        goto fail;
+    }
+    if (sys_io_uring_register(u->fd, IORING_REGISTER_FILES, &sock_fd, 1) < 0) {
+        fprintf(stderr, "[Port %u TX] io_uring file register failed: %s\n",
+                port_id, strerror(errno));
+        goto fail;
+    }
+    return u;
+
+fail_mmap:
+    fprintf(stderr, "[Port %u TX] io_uring ring mmap failed: %s\n", port_id, strerror(errno));
+fail:
+    uring_free(u);
+    return NULL;
+}
+
+// Completion'ları al: zincirdeki ilk başarısız yazmanın konumu ve hatası
+// (sonrakiler -ECANCELED ile döner). Frame'ler batch bitince geri verilir.
+static void uring_reap(struct raw_tx_batch *b)
+{
+    struct raw_tx_uring *u = b->uring;
+    uint32_t head = *u->cq_head;
+    const uint32_t tail = __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE);
+
+    while (head != tail) {
+        const struct io_uring_cqe *cqe = &u->cqes[head & u->cq_mask];
+        const uint32_t pos = (uint32_t)cqe->user_data;
+        if (unlikely(cqe->res < 0) && pos < b->fail_pos) {
+            b->fail_pos = pos;
+            b->fail_res = cqe->res;
+        }
+        b->in_flight--;
+        head++;
+    }
+    __atomic_store_n(u->cq_head, head, __ATOMIC_RELEASE);
+}
+
+// Batch'in [first, count) kısmını tek WRITE_FIXED zinciri olarak gönder ve
+// tüm completion'larını bekle. fail_pos = ilk başarısız konum (yoksa count).
+static int uring_send_chain(struct raw_tx_batch *b, uint32_t first)
+{
+    struct raw_tx_uring *u = b->uring;
+    const uint32_t tail = *u->sq_tail;
+    const uint32_t n = b->count - first;
+
+    for (uint32_t i = 0; i < n; i++) {
+        const uint32_t pos = first + i;
+        struct io_uring_sqe *sqe = &u->sqes[(tail + i) & u->sq_mask];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_WRITE_FIXED;
+        sqe->fd = 0;                                // Registered file 0 = TX soketi
+        sqe->flags = IOSQE_FIXED_FILE;
+        // Batch içi sıra: zincir (son eleman hariç)
+        if (i + 1 < n)
+            sqe->flags |= IOSQE_IO_LINK;
+        sqe->addr = (uint64_t)(uintptr_t)b->iov[pos].iov_base;
+        sqe->len = (uint32_t)b->iov[pos].iov_len;
+        sqe->buf_index = 0;
+        sqe->user_data = pos;
+    }
+    __atomic_store_n(u->sq_tail, tail + n, __ATOMIC_RELEASE);
+    b->in_flight += n;
+    b->fail_pos = b->count;
+    b->fail_res = 0;
+
+    uint32_t left = n;
+    while (left > 0) {
+        int ret = sys_io_uring_enter(u->fd, left, 0, 0);
+        if (ret < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                // CQ dolu / kaynak yok: completion'ları al, tekrar dene
+                uring_reap(b);
+                continue;
+            }
+            // Kernel'in almadığı SQE'leri geri çek (sonraki enter göndermesin)
+            __atomic_store_n(u->sq_tail, tail + n - left, __ATOMIC_RELEASE);
+            b->in_flight -= left;
+            break;
+        }
+        left -= (uint32_t)ret;
+    }
+
+    // Inline gönderilenler enter dönünce CQ'dadır; io-wq'ya düşenleri bekle
+    uring_reap(b);
+    while (b->in_flight > 0) {
+        if (sys_io_uring_enter(u->fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+            return -1;
+        uring_reap(b);
+    }
+    return left > 0 ? -1 : 0;
+}
+
+// sendmmsg yolu ile aynı kural: NIC kuyruğu doluyken (bypass'lı soket ENOBUFS)
+// başarısız frame'den itibaren kalan zincir sırayla tekrar gönderilir.
+// Sonraki batch bu batch bitmeden gönderilmez, sıra korunur.
+static int uring_submit(struct raw_tx_batch *b)
+{
+    uint32_t first = 0;
+    int retry = 0;
+    int ret = 0;
+
+    while (first < b->count) {
+        if (uring_send_chain(b, first) < 0) {
+            // Ring kullanılamıyor: onaylanmamış frame'ler kayıp sayılır
+            b->errors += b->count - first;
+            if (b->in_flight > 0) {
+                // Frame'ler hâlâ kernel'de: yuvaları havuza geri verilmez
+                b->count = 0;
+                return -1;
+            }
+            ret = -1;
+            break;
+        }
+        if (b->fail_pos >= b->count)
+            break;
+
+        if (b->fail_pos > first)
+            retry = 0;          // İlerleme var
+        first = b->fail_pos;
+        const int err = -b->fail_res;
+        if ((err == ENOBUFS || err == EAGAIN || err == EINTR) &&
+            ++retry < RAW_TX_BATCH_RETRY) {
+            sched_yield();
+            continue;
+        }
+        b->errors += b->count - first;
+        ret = -1;
+        break;
+    }
+
+    for (uint32_t i = 0; i < b->count; i++)
+        b->free_idx[b->free_count++] = b->idx[i];
+    b->count = 0;
+    return ret;
+}
+
+// ==========================================
+// SENDMMSG
+// ==========================================
+
+static int mmsg_submit(struct raw_tx_batch *b)
+{
+    uint32_t sent = 0;
+    int retry = 0;
+    int ret = 0;
+
+    while (sent < b->count) {
+        int n = sendmmsg(b->fd, &b->msgs[sent], b->count - sent, 0);
+        if (n > 0) {
+            sent += (uint32_t)n;
+            retry = 0;
+            continue;
+        }
+        // Bypass'lı soket NIC kuyruğu doluyken ENOBUFS döner: kısa bekle, aynı
+        // frame'i tekrar dene (frame atlanırsa alıcı sequence boşluğu görür)
+        if ((errno == ENOBUFS || errno == EAGAIN || errno == EINTR) &&
+            ++retry < RAW_TX_BATCH_RETRY) {
+            sched_yield();
+            continue;
+        }
+        b->errors += b->count - sent;
+        ret = -1;
+        break;
+    }
+
+    for (uint32_t i = 0; i < b->count; i++)
+        b->free_idx[b->free_count++] = b->idx[i];
+    b->count = 0;
+    return ret;
+}
+
+// ==========================================
+// PUBLIC API
+// ==========================================
+
+uint32_t raw_tx_batch_submit(struct raw_tx_batch *b)
+{
+    if (b->count > 0) {
+        if (b->uring)
+            uring_submit(b);
+        else
+            mmsg_submit(b);
+    }
+
+    // Wait sırasında kaybolanlar da bir sonraki flush'ta raporlanır
+    const uint32_t lost = (uint32_t)(b->errors - b->errors_reported);
+    b->errors_reported = b->errors;
+    return lost;
+}
+
+int raw_tx_batch_wait(struct raw_tx_batch *b)
+{
+    // Batch bitince frame'leri havuza döner (io_uring: completion'lar dahil)
+    if (b->count > 0)
+        raw_tx_batch_submit(b);
+    return b->free_count > 0 ? 0 : -1;
+}
+
+int raw_tx_batch_open(struct raw_socket_port *port, uint8_t mode)
+{
+    struct raw_tx_batch *b = calloc(1, sizeof(*b));
+    if (b == NULL)
+        return -1;
+
+    const size_t pool_size = (size_t)RAW_TX_BATCH_FRAMES * RAW_TX_BATCH_FRAME_SIZE;
+    b->frames = mmap(NULL, pool_size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (b->frames == MAP_FAILED) {
+        free(b);
+        return -1;
+    }
+    for (uint32_t i = 0; i < RAW_TX_BATCH_FRAMES; i++)
+        b->free_idx[b->free_count++] = (uint16_t)(RAW_TX_BATCH_FRAMES - 1 - i);
+    b->msgs = calloc(RAW_TX_BATCH_MAX, sizeof(*b->msgs));
+    if (b->msgs == NULL) {
+        munmap(b->frames, pool_size);
+        free(b);
+        return -1;
+    }
+    for (uint32_t i = 0; i < RAW_TX_BATCH_MAX; i++) {
+        b->msgs[i].msg_hdr.msg_iov = &b->iov[i];
+        b->msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    // TX ring'siz soket: packet_sendmsg ring varken kullanıcı buffer'ını yok sayar
+    b->fd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+    if (b->fd < 0) {
+        fprintf(stderr, "[Port %u TX] Failed to create TX socket: %s\n",
+                port->port_id, strerror(errno));
+        goto fail;
+    }
+
+    // TX ring ile aynı: qdisc'i atla (doluyken ENOBUFS, mmsg_submit / uring_submit tekrar dener)
+    int bypass = 1;
+    if (setsockopt(b->fd, SOL_PACKET, PACKET_QDISC_BYPASS, &bypass, sizeof(bypass)) < 0)
+        printf("[Port %u TX] Warning: PACKET_QDISC_BYPASS not supported: %s\n",
+               port->port_id, strerror(errno));
+
+    // Havuzun tamamı sndbuf'a sığsın: batch ortasında bloklanmasın
+    int sndbuf = (int)(pool_size * 2);
+    if (setsockopt(b->fd, SOL_SOCKET, SO_SNDBUFFORCE, &sndbuf, sizeof(sndbuf)) < 0)
+        setsockopt(b->fd, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+
+    struct sockaddr_ll sll = {0};
+    sll.sll_family = AF_PACKET;
+    sll.sll_ifindex = port->if_index;
+    sll.sll_protocol = htons(ETH_P_ALL);
+    if (bind(b->fd, (struct sockaddr *)&sll, sizeof(sll)) < 0) {
+        fprintf(stderr, "[Port %u TX] Failed to bind TX socket: %s\n",
+                port->port_id, strerror(errno));
+        goto fail;
+    }
+
+    if (mode == RAW_TX_SUBMIT_IO_URING) {
+        b->uring = uring_open(port->port_id, b->fd, b->frames, pool_size);
+        if (b->uring == NULL) {
+            printf("[Port %u TX] io_uring unavailable, using sendmmsg\n", port->port_id);
+            mode = RAW_TX_SUBMIT_SENDMMSG;
+        }
+    }
+    b->mode = mode;
+
+    port->tx_socket = b->fd;
+    port->tx_batch = b;
+    printf("[Port %u TX] Batched TX ready (%s, %u frames, batch ≤ %u)\n",
+           port->port_id, raw_tx_submit_name(mode), RAW_TX_BATCH_FRAMES, RAW_TX_BATCH_MAX);
+    return 0;
+
+fail:
+    if (b->fd >= 0)
+        close(b->fd);
+    munmap(b->frames, pool_size);
+    free(b->msgs);
+    free(b);
+    return -1;
+}
+
+void raw_tx_batch_close(struct raw_socket_port *port)
+{
+    struct raw_tx_batch *b = port->tx_batch;
+    if (b == NULL)
+        return;
+
+    // Uçuştaki yazmalar bitsin (buffer'lar unmap edilmeden önce)
+    if (b->uring) {
+        while (b->in_flight > 0) {
+            if (sys_io_uring_enter(b->uring->fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+                break;
+            uring_reap(b);
+        }
+        uring_free(b->uring);
+    }
+    munmap(b->frames, (size_t)RAW_TX_BATCH_FRAMES * RAW_TX_BATCH_FRAME_SIZE);
+    free(b->msgs);
+    free(b);
+    port->tx_batch = NULL;
+}
@@ -0,0 +1,526 @@
+#define _GNU_SOURCE
+#include "raw_xdp.h"
+#include "flow_registry.h"
+#include "socket.h"  // for get_unused_cores()
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <net/if.h>
+#include <arpa/inet.h>
+#include <linux/bpf.h>
+#include <linux/if_link.h>
+#include <linux/if_ether.h>
+#include <linux/ethtool.h>
+#include <linux/sockios.h>
+
+#ifndef AF_XDP
+#define AF_XDP 44
+#endif
+#ifndef SOL_XDP
+#define SOL_XDP 283
+#endif
+
+// ==========================================
+// BPF SYSCALL WRAPPERS (libbpf yok)
+// ==========================================
+
+static int sys_bpf(int cmd, union bpf_attr *attr)
+{
+    return (int)syscall(__NR_bpf, cmd, attr, sizeof(*attr));
+}
+
+static int xdp_map_create(uint32_t type, uint32_t value_size, uint32_t max_entries, const char *name)
+{
+    union bpf_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.map_type = type;
+    attr.key_size = sizeof(uint32_t);
+    attr.value_size = value_size;
+    attr.max_entries = max_entries;
+    strncpy(attr.map_name, name, sizeof(attr.map_name) - 1);
+    return sys_bpf(BPF_MAP_CREATE, &attr);
+}
+
+static int xdp_map_update(int map_fd, uint32_t key, uint32_t value)
+{
+    union bpf_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.map_fd = (uint32_t)map_fd;
+    attr.key = (uint64_t)(uintptr_t)&key;
+    attr.value = (uint64_t)(uintptr_t)&value;
+    attr.flags = BPF_ANY;
+    return sys_bpf(BPF_MAP_UPDATE_ELEM, &attr);
+}
+
+// ==========================================
+// STEERING PROGRAM
+// ==========================================
+// Elle kurulmuş eBPF (C karşılığı):
+//
+//   if (data + ETH_HLEN > data_end || eth->h_proto != htons(ETH_P_IP))
+//       return XDP_PASS;
+//   u32 vl = dst[4] << 8 | dst[5];
+//   u32 *ours = bpf_map_lookup_elem(&vl_map, &vl);
+//   if (!ours || !*ours)
+//       return XDP_PASS;
+//   return bpf_redirect_map(&xsk_map, ctx->rx_queue_index, XDP_PASS);
+//
+// redirect_map'in flags argümanı, queue'da soket yoksa dönülecek aksiyon.
+
+#define XI(c, d, s, o, i) \
+    ((struct bpf_insn){ .code = (c), .dst_reg = (d), .src_reg = (s), .off = (o), .imm = (i) })
+#define XI_MOV_REG(d, s)      XI(BPF_ALU64 | BPF_MOV | BPF_X, d, s, 0, 0)
+#define XI_MOV_IMM(d, i)      XI(BPF_ALU64 | BPF_MOV | BPF_K, d, 0, 0, i)
+#define XI_ALU_IMM(op, d, i)  XI(BPF_ALU64 | (op) | BPF_K, d, 0, 0, i)
+#define XI_ALU_REG(op, d, s)  XI(BPF_ALU64 | (op) | BPF_X, d, s, 0, 0)
+#define XI_LDX(sz, d, s, o)   XI(BPF_LDX | (sz) | BPF_MEM, d, s, o, 0)
+#define XI_STX(sz, d, s, o)   XI(BPF_STX | (sz) | BPF_MEM, d, s, o, 0)
+#define XI_JMP_REG(op, d, s, o) XI(BPF_JMP | (op) | BPF_X, d, s, o, 0)
+#define XI_JMP_IMM(op, d, i, o) XI(BPF_JMP | (op) | BPF_K, d, 0, o, i)
+#define XI_LD_MAP(d, fd)      XI(BPF_LD | BPF_DW | BPF_IMM, d, BPF_PSEUDO_MAP_FD, 0, fd), XI(0, 0, 0, 0, 0)
+#define XI_CALL(fn)           XI(BPF_JMP | BPF_CALL, 0, 0, 0, fn)
+#define XI_EXIT()             XI(BPF_JMP | BPF_EXIT, 0, 0, 0, 0)
+
+#define XDP_PROG_PASS_PC 27   // "return XDP_PASS" komutunun index'i
+
+static int xdp_prog_load(int vl_map_fd, int xsk_map_fd, uint16_t port_id)
+{
+    const struct bpf_insn insns[] = {
+        /*  0 */ XI_MOV_REG(BPF_REG_6, BPF_REG_1),
+        /*  1 */ XI_LDX(BPF_W, BPF_REG_2, BPF_REG_6, offsetof(struct xdp_md, data)),
+        /*  2 */ XI_LDX(BPF_W, BPF_REG_3, BPF_REG_6, offsetof(struct xdp_md, data_end)),
+        /*  3 */ XI_MOV_REG(BPF_REG_1, BPF_REG_2),
+        /*  4 */ XI_ALU_IMM(BPF_ADD, BPF_REG_1, ETH_HLEN),
+        /*  5 */ XI_JMP_REG(BPF_JGT, BPF_REG_1, BPF_REG_3, XDP_PROG_PASS_PC - 6),
+        /*  6 */ XI_LDX(BPF_H, BPF_REG_1, BPF_REG_2, 12),
+        /*  7 */ XI_JMP_IMM(BPF_JNE, BPF_REG_1, htons(ETH_P_IP), XDP_PROG_PASS_PC - 8),
+        /*  8 */ XI_LDX(BPF_B, BPF_REG_1, BPF_REG_2, 4),
+        /*  9 */ XI_ALU_IMM(BPF_LSH, BPF_REG_1, 8),
+        /* 10 */ XI_LDX(BPF_B, BPF_REG_4, BPF_REG_2, 5),
+        /* 11 */ XI_ALU_REG(BPF_OR, BPF_REG_1, BPF_REG_4),
+        /* 12 */ XI_STX(BPF_W, BPF_REG_10, BPF_REG_1, -4),
+        /* 13 */ XI_MOV_REG(BPF_REG_2, BPF_REG_10),
+        /* 14 */ XI_ALU_IMM(BPF_ADD, BPF_REG_2, -4),
+        /* 15 */ XI_LD_MAP(BPF_REG_1, vl_map_fd),
+        /* 17 */ XI_CALL(BPF_FUNC_map_lookup_elem),
+        /* 18 */ XI_JMP_IMM(BPF_JEQ, BPF_REG_0, 0, XDP_PROG_PASS_PC - 19),
+        /* 19 */ XI_LDX(BPF_W, BPF_REG_1, BPF_REG_0, 0),
+        /* 20 */ XI_JMP_IMM(BPF_JEQ, BPF_REG_1, 0, XDP_PROG_PASS_PC - 21),
+        /* 21 */ XI_LDX(BPF_W, BPF_REG_2, BPF_REG_6, offsetof(struct xdp_md, rx_queue_index)),
+        /* 22 */ XI_LD_MAP(BPF_REG_1, xsk_map_fd),
+        /* 24 */ XI_MOV_IMM(BPF_REG_3, XDP_PASS),
+        /* 25 */ XI_CALL(BPF_FUNC_redirect_map),
+        /* 26 */ XI_EXIT(),
+        /* 27 */ XI_MOV_IMM(BPF_REG_0, XDP_PASS),
+        /* 28 */ XI_EXIT(),
+    };
+    static char log_buf[16384];
+    union bpf_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.prog_type = BPF_PROG_TYPE_XDP;
+    attr.insns = (uint64_t)(uintptr_t)insns;
+    attr.insn_cnt = sizeof(insns) / sizeof(insns[0]);
+    attr.license = (uint64_t)(uintptr_t)"GPL";
+    snprintf(attr.prog_name, sizeof(attr.prog_name), "vl_steer_p%u", port_id);
+
+    int fd = sys_bpf(BPF_PROG_LOAD, &attr);
+    if (fd >= 0)
+        return fd;
+
+    // Verifier çıktısı sadece hata durumunda (ikinci yükleme log ile)
+    const int err = errno;
+    attr.log_buf = (uint64_t)(uintptr_t)log_buf;
+    attr.log_size = sizeof(log_buf);
+    attr.log_level = 1;
+    log_buf[0] = '\0';
+    if (sys_bpf(BPF_PROG_LOAD, &attr) < 0 && log_buf[0] != '\0')
+        fprintf(stderr, "[Port %u XDP] Verifier log:\n%s\n", port_id, log_buf);
+    errno = err;
+    return -1;
+}
+
+// Native (DRV) mod, olmazsa generic (SKB). BPF link: fd kapanınca sökülür.
+static int xdp_prog_attach(int prog_fd, int if_index, bool *drv_mode)
+{
+    const uint32_t modes[2] = { XDP_FLAGS_DRV_MODE, XDP_FLAGS_SKB_MODE };
+    union bpf_attr attr;
+
+    for (int m = 0; m < 2; m++) {
+        memset(&attr, 0, sizeof(attr));
+        attr.link_create.prog_fd = (uint32_t)prog_fd;
+        attr.link_create.target_ifindex = (uint32_t)if_index;
+        attr.link_create.attach_type = BPF_XDP;
+        attr.link_create.flags = modes[m];
+
+        int fd = sys_bpf(BPF_LINK_CREATE, &attr);
+        if (fd >= 0) {
+            *drv_mode = (m == 0);
+            return fd;
+        }
+    }
+    return -1;
+}
+
+// ==========================================
+// XSK SOCKETS
+// ==========================================
+
+// NIC RX queue sayısı (ethtool channels), okunamazsa 1
+static int xdp_rx_channel_count(const char *if_name)
+{
+    struct ethtool_channels ch = { .cmd = ETHTOOL_GCHANNELS };
+    struct ifreq ifr;
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    int count = 1;
+
+    if (sock < 0)
+        return 1;
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, if_name, IFNAMSIZ - 1);
+    ifr.ifr_data = (char *)&ch;
+    if (ioctl(sock, SIOCETHTOOL, &ifr) == 0 && ch.rx_count + ch.combined_count > 0)
+        count = (int)(ch.rx_count + ch.combined_count);
+    close(sock);
+    return count;
+}
+
+static int xdp_ring_map(int fd, struct raw_xdp_ring *r, const struct xdp_ring_offset *off,
+                        uint32_t size, size_t desc_size, uint64_t pgoff, bool producer)
+{
+    r->map_size = off->desc + size * desc_size;
+    r->map = mmap(NULL, r->map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  fd, (off_t)pgoff);
+    if (r->map == MAP_FAILED) {
+        r->map = NULL;
+        return -1;
+    }
+    r->producer = (uint32_t *)((uint8_t *)r->map + off->producer);
+    r->consumer = (uint32_t *)((uint8_t *)r->map + off->consumer);
+    r->flags = (uint32_t *)((uint8_t *)r->map + off->flags);
+    r->ring = (uint8_t *)r->map + off->desc;
+    r->size = size;
+    r->mask = size - 1;
+    r->cached_prod = *r->producer;
+    r->cached_cons = *r->consumer + (producer ? size : 0);
+    return 0;
+}
+
+static void xdp_ring_unmap(struct raw_xdp_ring *r)
+{
+    if (r->map)
+        munmap(r->map, r->map_size);
+    memset(r, 0, sizeof(*r));
+}
+
+static int xdp_setsockopt_u32(int fd, int opt, uint32_t val)
+{
+    return setsockopt(fd, SOL_XDP, opt, &val, sizeof(val));
+}
+
+// Queue 0: UMEM sahibi + TX; diğerleri queue 0'ın UMEM'ini paylaşır
+static int xdp_queue_open(struct raw_socket_port *port, struct raw_xdp_port *x, int q)
+{
+    struct raw_xdp_queue *xq = &x->queues[q];
+    const bool owner = (q == 0);
+    struct xdp_mmap_offsets off;
+    socklen_t optlen = sizeof(off);
+
+    xq->queue_id = (uint16_t)q;
+    xq->fd = socket(AF_XDP, SOCK_RAW, 0);
+    if (xq->fd < 0) {
+        fprintf(stderr, "[Port %u XDP Q%d] Failed to create XSK socket: %s\n",
+                port->port_id, q, strerror(errno));
+        return -1;
+    }
+
+    if (owner) {
+        struct xdp_umem_reg reg = {
+            .addr = (uint64_t)(uintptr_t)x->umem,
+            .len = x->umem_size,
+            .chunk_size = RAW_XDP_FRAME_SIZE,
+            .headroom = 0,
+        };
+        if (setsockopt(xq->fd, SOL_XDP, XDP_UMEM_REG, &reg, sizeof(reg)) < 0) {
+            fprintf(stderr, "[Port %u XDP] UMEM register failed: %s\n",
+                    port->port_id, strerror(errno));
+            return -1;
+        }
+    }
+
+    // Paylaşılan UMEM'de farklı queue id için fill / completion ring zorunlu
+    if (xdp_setsockopt_u32(xq->fd, XDP_UMEM_FILL_RING, RAW_XDP_RX_FRAMES) < 0 ||
+        xdp_setsockopt_u32(xq->fd, XDP_UMEM_COMPLETION_RING,
+                           owner ? RAW_XDP_TX_FRAMES : RAW_XDP_RX_FRAMES) < 0 ||
+        xdp_setsockopt_u32(xq->fd, XDP_RX_RING, RAW_XDP_RX_FRAMES) < 0 ||
+        (owner && xdp_setsockopt_u32(xq->fd, XDP_TX_RING, RAW_XDP_TX_FRAMES) < 0)) {
+        fprintf(stderr, "[Port %u XDP Q%d] Ring setup failed: %s\n",
+                port->port_id, q, strerror(errno));
+        return -1;
+    }
+
+    if (getsockopt(xq->fd, SOL_XDP, XDP_MMAP_OFFSETS, &off, &optlen) < 0 ||
+        xdp_ring_map(xq->fd, &xq->fill, &off.fr, RAW_XDP_RX_FRAMES, sizeof(uint64_t),
+                     XDP_UMEM_PGOFF_FILL_RING, true) < 0 ||
+        xdp_ring_map(xq->fd, &xq->comp, &off.cr, owner ? RAW_XDP_TX_FRAMES : RAW_XDP_RX_FRAMES,
+                     sizeof(uint64_t), XDP_UMEM_PGOFF_COMPLETION_RING, false) < 0 ||
+        xdp_ring_map(xq->fd, &xq->rx, &off.rx, RAW_XDP_RX_FRAMES, sizeof(struct xdp_desc),
+                     XDP_PGOFF_RX_RING, false) < 0 ||
+        (owner && xdp_ring_map(xq->fd, &xq->tx, &off.tx, RAW_XDP_TX_FRAMES,
+                               sizeof(struct xdp_desc), XDP_PGOFF_TX_RING, true) < 0)) {
+        fprintf(stderr, "[Port %u XDP Q%d] Ring mmap failed: %s\n",
+                port->port_id, q, strerror(errno));
+        return -1;
+    }
+
+    struct sockaddr_xdp sxdp = {
+        .sxdp_family = AF_XDP,
+        .sxdp_ifindex = (uint32_t)port->if_index,
+        .sxdp_queue_id = (uint32_t)q,
+    };
+    if (owner) {
+        // Zero-copy sürücü desteği ister; yoksa copy mode (veth, generic XDP)
+        sxdp.sxdp_flags = XDP_ZEROCOPY | XDP_USE_NEED_WAKEUP;
+        if (bind(xq->fd, (struct sockaddr *)&sxdp, sizeof(sxdp)) == 0) {
+            xq->zerocopy = true;
+        } else {
+            sxdp.sxdp_flags = XDP_COPY | XDP_USE_NEED_WAKEUP;
+            if (bind(xq->fd, (struct sockaddr *)&sxdp, sizeof(sxdp)) < 0) {
+                fprintf(stderr, "[Port %u XDP Q0] Bind failed: %s\n",
+                        port->port_id, strerror(errno));
+                return -1;
+            }
+        }
+        x->need_wakeup = true;
+    } else {
+        // Mod ve need_wakeup UMEM sahibinden gelir
+        sxdp.sxdp_flags = XDP_SHARED_UMEM;
+        sxdp.sxdp_shared_umem_fd = (uint32_t)x->queues[0].fd;
+        if (bind(xq->fd, (struct sockaddr *)&sxdp, sizeof(sxdp)) < 0) {
+            fprintf(stderr, "[Port %u XDP Q%d] Shared UMEM bind failed: %s\n",
+                    port->port_id, q, strerror(errno));
+            return -1;
+        }
+        xq->zerocopy = x->queues[0].zerocopy;
+    }
+
+    // Queue'nun RX frame aralığının tamamı fill ring'e
+    const uint64_t base = (uint64_t)(RAW_XDP_TX_FRAMES + q * RAW_XDP_RX_FRAMES) * RAW_XDP_FRAME_SIZE;
+    uint32_t idx;
+    if (raw_xdp_prod_reserve(&xq->fill, RAW_XDP_RX_FRAMES, &idx) != RAW_XDP_RX_FRAMES)
+        return -1;
+    for (uint32_t i = 0; i < RAW_XDP_RX_FRAMES; i++)
+        *raw_xdp_addr(&xq->fill, idx + i) = base + (uint64_t)i * RAW_XDP_FRAME_SIZE;
+    raw_xdp_prod_submit(&xq->fill, RAW_XDP_RX_FRAMES);
+
+    if (xdp_map_update(x->xsk_map_fd, (uint32_t)q, (uint32_t)xq->fd) < 0) {
+        fprintf(stderr, "[Port %u XDP Q%d] XSKMAP update failed: %s\n",
+                port->port_id, q, strerror(errno));
+        return -1;
+    }
+    return 0;
+}
+
+static void xdp_queue_close(struct raw_xdp_queue *xq)
+{
+    xdp_ring_unmap(&xq->rx);
+    xdp_ring_unmap(&xq->fill);
+    xdp_ring_unmap(&xq->tx);
+    xdp_ring_unmap(&xq->comp);
+    if (xq->fd >= 0)
+        close(xq->fd);
+    xq->fd = -1;
+}
+
+// ==========================================
+// PORT SETUP / TEARDOWN
+// ==========================================
+
+int raw_xdp_port_open(struct raw_socket_port *port)
+{
+    const int max_queues = port->config.is_1g_port ? 4 : 2;
+    int channels = xdp_rx_channel_count(port->config.interface_name);
+
+    printf("\n=== Setting up AF_XDP for Port %u (%s) ===\n",
+           port->port_id, port->config.interface_name);
+
+    // Her NIC queue'sunda soket olmalı: fazlası kernel'e düşer (XDP_PASS)
+    if (channels > max_queues) {
+        printf("[Port %u XDP] Warning: %d RX channels, only %d get a socket "
+               "(ethtool -L %s combined %d)\n", port->port_id, channels, max_queues,
+               port->config.interface_name, max_queues);
+        channels = max_queues;
+    }
+
+    struct raw_xdp_port *x = calloc(1, sizeof(*x));
+    if (x == NULL)
+        return -1;
+    x->prog_fd = x->link_fd = x->xsk_map_fd = x->vl_map_fd = -1;
+    for (int q = 0; q < RAW_SOCKET_RX_QUEUE_COUNT; q++)
+        x->queues[q].fd = -1;
+    port->xdp = x;
+
+    x->queue_count = channels;
+    x->umem_size = (size_t)(RAW_XDP_TX_FRAMES + channels * RAW_XDP_RX_FRAMES) * RAW_XDP_FRAME_SIZE;
+    x->umem = mmap(NULL, x->umem_size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (x->umem == MAP_FAILED) {
+        x->umem = NULL;
+        fprintf(stderr, "[Port %u XDP] UMEM alloc failed: %s\n", port->port_id, strerror(errno));
+        goto fail;
+    }
+
+    x->xsk_map_fd = xdp_map_create(BPF_MAP_TYPE_XSKMAP, sizeof(uint32_t),
+                                   RAW_SOCKET_RX_QUEUE_COUNT, "raw_xsk");
+    x->vl_map_fd = xdp_map_create(BPF_MAP_TYPE_ARRAY, sizeof(uint32_t),
+                                  RAW_XDP_VL_MAP_SIZE, "raw_vl");
+    if (x->xsk_map_fd < 0 || x->vl_map_fd < 0) {
+        fprintf(stderr, "[Port %u XDP] BPF map create failed: %s\n",
+                port->port_id, strerror(errno));
+        goto fail;
+    }
+
+    for (int q = 0; q < channels; q++) {
+        if (xdp_queue_open(port, x, q) < 0)
+            goto fail;
+    }
+
+    x->prog_fd = xdp_prog_load(x->vl_map_fd, x->xsk_map_fd, port->port_id);
+    if (x->prog_fd < 0) {
+        fprintf(stderr, "[Port %u XDP] Program load failed: %s\n", port->port_id, strerror(errno));
+        goto fail;
+    }
+    bool drv_mode = false;
+    x->link_fd = xdp_prog_attach(x->prog_fd, port->if_index, &drv_mode);
+    if (x->link_fd < 0) {
+        fprintf(stderr, "[Port %u XDP] Program attach failed: %s\n", port->port_id, strerror(errno));
+        goto fail;
+    }
+
+    // TX havuzu: UMEM'in ilk RAW_XDP_TX_FRAMES frame'i
+    for (uint32_t i = 0; i < RAW_XDP_TX_FRAMES; i++)
+        x->tx_free[i] = (uint64_t)(RAW_XDP_TX_FRAMES - 1 - i) * RAW_XDP_FRAME_SIZE;
+    x->tx_free_count = RAW_XDP_TX_FRAMES;
+
+    // Multi-queue RX yapısı AF_PACKET ile aynı (worker / stats kodu ortak)
+    int cores_found = get_unused_cores(channels, port->rx_cpu_cores);
+    if (cores_found < channels) {
+        fprintf(stderr, "[Port %u] Warning: Only %d cores available for %d RX queues\n",
+                port->port_id, cores_found, channels);
+    }
+    port->rx_queue_count = channels;
+    for (int q = 0; q < channels; q++) {
+        struct raw_rx_queue *queue = &port->rx_queues[q];
+
+        x->queues[q].drv_mode = drv_mode;
+        queue->queue_id = (uint16_t)q;
+        queue->cpu_core = (q < cores_found) ? port->rx_cpu_cores[q] : 0;
+        queue->socket_fd = -1;              // Soket raw_xdp_port'ta
+        queue->xdp = &x->queues[q];
+        printf("  Queue %d: XSK fd=%d, %u RX frames, CPU core=%u\n",
+               q, x->queues[q].fd, RAW_XDP_RX_FRAMES, queue->cpu_core);
+    }
+    port->use_multi_queue_rx = true;
+
+    printf("[Port %u XDP] %d queue(s), %s mode, program %s, UMEM %zu KB\n",
+           port->port_id, channels, x->queues[0].zerocopy ? "zero-copy" : "copy",
+           drv_mode ? "native" : "generic (SKB)", x->umem_size / 1024);
+    return 0;
+
+fail:
+    raw_xdp_port_close(port);
+    return -1;
+}
+
+int raw_xdp_port_steer(struct raw_socket_port *port)
+{
+    struct raw_xdp_port *x = port->xdp;
+    int steered = 0;
+
+    if (x == NULL)
+        return -1;
+
+    // mq_rx_frame'in işlediği her VL: bu portun raw kaynakları + DPDK ext
+    for (uint32_t vl = 0; vl < RAW_XDP_VL_MAP_SIZE; vl++) {
+        const struct flow_entry *f = flow_lookup((uint16_t)vl);
+        bool ours = f->raw_rx_source[port->raw_index] != FLOW_RAW_SOURCE_NONE;
+#if DPDK_EXT_TX_ENABLED
+        ours = ours || f->kind == FLOW_SRC_DPDK_EXT;
+#endif
+        if (!ours)
+            continue;
+        if (xdp_map_update(x->vl_map_fd, vl, 1) < 0) {
+            fprintf(stderr, "[Port %u XDP] VL map update failed: %s\n",
+                    port->port_id, strerror(errno));
+            return -1;
+        }
+        steered++;
+    }
+
+    printf("[Port %u XDP] %d VL-IDs steered to AF_XDP, other traffic -> kernel (XDP_PASS)\n",
+           port->port_id, steered);
+    return steered;
+}
+
+void raw_xdp_port_close(struct raw_socket_port *port)
+{
+    struct raw_xdp_port *x = port->xdp;
+
+    if (x == NULL)
+        return;
+
+    // Önce program: yeni frame yönlendirilmez
+    if (x->link_fd >= 0) close(x->link_fd);
+    if (x->prog_fd >= 0) close(x->prog_fd);
+    for (int q = RAW_SOCKET_RX_QUEUE_COUNT - 1; q >= 0; q--) {
+        xdp_queue_close(&x->queues[q]);
+        if (port->rx_queues[q].xdp == &x->queues[q])
+            port->rx_queues[q].xdp = NULL;
+    }
+    if (x->xsk_map_fd >= 0) close(x->xsk_map_fd);
+    if (x->vl_map_fd >= 0) close(x->vl_map_fd);
+    if (x->umem)
+        munmap(x->umem, x->umem_size);
+
+    free(x);
+    port->xdp = NULL;
+}
+
+// ==========================================
+// RUNTIME
+// ==========================================
+
+uint64_t raw_xdp_queue_drops(const struct raw_xdp_queue *xq)
+{
+    struct xdp_statistics st;
+    socklen_t len = sizeof(st);
+
+    memset(&st, 0, sizeof(st));
+    if (xq->fd < 0 || getsockopt(xq->fd, SOL_XDP, XDP_STATISTICS, &st, &len) != 0)
+        return 0;
+    return st.rx_dropped + st.rx_ring_full;
+}
+
+int raw_xdp_tx_kick(struct raw_xdp_port *x)
+{
+    const struct raw_xdp_queue *xq = &x->queues[0];
+
+    if (!raw_xdp_needs_wakeup(x, &xq->tx))
+        return 0;
+    if (sendto(xq->fd, NULL, 0, MSG_DONTWAIT, NULL, 0) >= 0)
+        return 0;
+    // Kernel TX ring'i işliyor / sürücü kuyruğu dolu: sonraki kick'te devam
+    if (errno == EAGAIN || errno == EBUSY || errno == ENOBUFS || errno == ENETDOWN)
+        return 0;
+    return -1;
+}
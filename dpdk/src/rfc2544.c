@@ -0,0 +1,379 @@
+#include "rfc2544.h"
+#include "tx_live.h"
+#include "tx_rx_manager.h"      // merge_rx_sequence_stats, tx_lcore_stats
+#include "stats_shard.h"
+#include "traffic_profile.h"    // traffic_port_rate_gbps
+#include "packet.h"             // imix_pattern, PACKET_SIZE
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <rte_cycles.h>
+#include <rte_ethdev.h>
+#include <rte_lcore.h>
+
+#if RFC2544_ENABLED
+
+#if !TX_LIVE_ACTIVE
+#error "RFC2544_ENABLED canlı rate değişimi gerektirir (LIVE_CTL_ENABLED=1, token bucket / BAG kapalı)"
+#endif
+
+#define RFC2544_WIRE_OVERHEAD 24    // Preamble 8 + IFG 12 + FCS 4
+
+struct rfc2544_row {
+    uint16_t frame_size;            // IMIX satırında ortalama
+    bool imix;
+    bool skipped;                   // [IMIX_MIN, IMIX_MAX] dışında
+    bool tester_limited;            // En az bir FAIL, TX offered'a yetişemediği için
+    double gbps;                    // Kayıpsız en yüksek rate (port başına, L2), 0 = yok
+    double max_gbps;                // Arama üst sınırı (link L2 veya RFC2544_MAX_GBPS)
+    uint32_t trials;
+};
+
+struct rfc2544_trial {
+    bool pass;
+    bool tester_limited;
+    uint64_t rx_pkts;
+    uint64_t lost;
+    uint64_t bad;
+    uint64_t bit_errors;
+    double tx_pct;                  // Gönderilen / offered
+};
+
+static struct stats_snapshot rfc_snap_a;
+static struct stats_snapshot rfc_snap_b;
+
+// ==========================================
+// HELPERS
+// ==========================================
+
+// stop_flag'i kontrol ederek bekle (Ctrl+C trial ortasında da çalışsın)
+static bool rfc_sleep_ms(unsigned int ms, volatile bool *stop_flag)
+{
+    while (ms > 0 && !*stop_flag) {
+        const unsigned int step = ms < 100 ? ms : 100;
+        usleep(step * 1000);
+        ms -= step;
+    }
+    return !*stop_flag;
+}
+
+static inline bool rfc_in_mask(uint32_t mask, uint16_t port_id)
+{
+    return port_id < 32 && (mask & (1u << port_id)) != 0;
+}
+
+// Gruptaki en yavaş linkin L2 kapasitesi (Gbps), link bilinmiyorsa RFC2544_MAX_GBPS
+static double rfc_group_max_gbps(const struct ports_config *pc, uint32_t mask, double frame_size)
+{
+    double max_gbps = 0.0;
+
+    for (uint16_t i = 0; i < pc->nb_ports; i++) {
+        const uint16_t port_id = pc->ports[i].port_id;
+        if (!rfc_in_mask(mask, port_id))
+            continue;
+        struct rte_eth_link link;
+        memset(&link, 0, sizeof(link));
+        if (rte_eth_link_get_nowait(port_id, &link) != 0 || link.link_speed == 0 ||
+            link.link_speed == RTE_ETH_SPEED_NUM_UNKNOWN)
+            continue;
+        const double l2 = (double)link.link_speed / 1000.0 *
+                          frame_size / (frame_size + RFC2544_WIRE_OVERHEAD);
+        if (max_gbps == 0.0 || l2 < max_gbps)
+            max_gbps = l2;
+    }
+
+    if (RFC2544_MAX_GBPS > 0.0 && (max_gbps == 0.0 || RFC2544_MAX_GBPS < max_gbps))
+        max_gbps = RFC2544_MAX_GBPS;
+    if (max_gbps > TX_LIVE_MAX_GBPS)
+        max_gbps = TX_LIVE_MAX_GBPS;
+    return max_gbps;
+}
+
+static int rfc_set_group_rate(const struct ports_config *pc, uint32_t mask, double gbps)
+{
+    for (uint16_t i = 0; i < pc->nb_ports; i++) {
+        const uint16_t port_id = pc->ports[i].port_id;
+        if (!rfc_in_mask(mask, port_id))
+            continue;
+        int ret = tx_live_set_rate(port_id, gbps);
+        if (ret < 0) {
+            printf("[RFC2544] Port %u: rate %.3f Gbps not applied (%d)\n", port_id, gbps, ret);
+            return ret;
+        }
+    }
+    return 0;
+}
+
+static void rfc_restore_group(const struct ports_config *pc, uint32_t mask)
+{
+    for (uint16_t i = 0; i < pc->nb_ports; i++) {
+        const uint16_t port_id = pc->ports[i].port_id;
+        if (rfc_in_mask(mask, port_id))
+            tx_live_set_rate(port_id, traffic_port_rate_gbps(port_id));
+    }
+}
+
+// Gruptaki portların TX worker'larının gönderdiği toplam paket
+static uint64_t rfc_group_tx_pkts(uint32_t mask)
+{
+    uint64_t sum = 0;
+    for (unsigned lc = 0; lc < RTE_MAX_LCORE; lc++) {
+        const struct tx_lcore_stats *ls = &tx_lcore_stats[lc];
+        if (ls->active && rfc_in_mask(mask, ls->port_id))
+            sum += ls->tx_pkts;
+    }
+    return sum;
+}
+
+static void rfc_snapshot(struct stats_snapshot *snap)
+{
+    // Stats döngüsü ile aynı sıra: önce VL sequence merge, sonra shard'lar
+    merge_rx_sequence_stats(false);
+    stats_snapshot_take(snap);
+}
+
+// ==========================================
+// TRIAL
+// ==========================================
+
+static int rfc_trial(const struct ports_config *pc, uint32_t mask, uint16_t nb_group_ports,
+                     double gbps, double avg_frame, volatile bool *stop_flag,
+                     struct rfc2544_trial *t)
+{
+    memset(t, 0, sizeof(*t));
+
+    if (rfc_set_group_rate(pc, mask, gbps) != 0)
+        return -1;
+    if (!rfc_sleep_ms(RFC2544_SETTLE_MS, stop_flag))
+        return -1;
+
+    const uint64_t tsc_hz = rte_get_tsc_hz();
+    rfc_snapshot(&rfc_snap_a);
+    const uint64_t tx_a = rfc_group_tx_pkts(mask);
+    const uint64_t t_a = rte_get_tsc_cycles();
+
+    if (!rfc_sleep_ms(RFC2544_TRIAL_SEC * 1000, stop_flag))
+        return -1;
+
+    rfc_snapshot(&rfc_snap_b);
+    const uint64_t tx_b = rfc_group_tx_pkts(mask);
+    const double elapsed = (double)(rte_get_tsc_cycles() - t_a) / (double)tsc_hz;
+
+    // Kayıp grubun trafiğini alan (paired) RX portlarında sayılır
+    for (uint16_t i = 0; i < pc->nb_ports; i++) {
+        const uint16_t port_id = pc->ports[i].port_id;
+        if (!rfc_in_mask(mask, port_id))
+            continue;
+        const uint16_t rx = paired_port(port_id);
+        if (rx >= MAX_PORTS)
+            continue;
+        const struct stats_counters *a = &rfc_snap_a.port_rx[rx];
+        const struct stats_counters *b = &rfc_snap_b.port_rx[rx];
+        t->rx_pkts += b->pkts - a->pkts;
+        t->lost += b->lost_pkts - a->lost_pkts;
+        t->bad += b->bad_pkts - a->bad_pkts;
+        t->bit_errors += b->bit_errors - a->bit_errors;
+    }
+
+    const double offered = gbps * 1e9 / 8.0 / avg_frame * elapsed * nb_group_ports;
+    t->tx_pct = offered > 0.0 ? (double)(tx_b - tx_a) * 100.0 / offered : 0.0;
+    t->tester_limited = t->tx_pct < RFC2544_TX_MIN_PCT;
+
+    const bool loss_ok = (double)t->lost * 1e6 <= (double)RFC2544_LOSS_TOL_PPM * (double)t->rx_pkts;
+    t->pass = t->rx_pkts > 0 && loss_ok && t->bad == 0 && t->bit_errors == 0 && !t->tester_limited;
+    return 0;
+}
+
+// ==========================================
+// SEARCH
+// ==========================================
+
+static int rfc_search(const struct ports_config *pc, uint32_t mask, uint16_t nb_group_ports,
+                      volatile bool *stop_flag, struct rfc2544_row *row)
+{
+    const double avg = (double)row->frame_size;
+    const double max_gbps = rfc_group_max_gbps(pc, mask, avg);
+    const double resolution = max_gbps * RFC2544_RESOLUTION_PCT / 100.0;
+    double lo = 0.0, hi = max_gbps;
+    double gbps = max_gbps;         // İlk trial üst sınırda
+    struct rfc2544_trial t;
+
+    row->max_gbps = max_gbps;
+    if (max_gbps < TX_LIVE_MIN_GBPS) {
+        printf("[RFC2544] No usable upper bound (link down? set RFC2544_MAX_GBPS)\n");
+        return -1;
+    }
+
+    while (row->trials < RFC2544_MAX_TRIALS) {
+        if (rfc_trial(pc, mask, nb_group_ports, gbps, avg, stop_flag, &t) != 0)
+            return -1;
+        row->trials++;
+        row->tester_limited |= t.tester_limited;
+
+        printf("[RFC2544]   %4u B  trial %2u: %8.3f Gbps  %s  rx=%lu lost=%lu bad=%lu biterr=%lu tx=%.1f%%%s\n",
+               row->frame_size, row->trials, gbps, t.pass ? "PASS" : "FAIL",
+               (unsigned long)t.rx_pkts, (unsigned long)t.lost, (unsigned long)t.bad,
+               (unsigned long)t.bit_errors, t.tx_pct, t.tester_limited ? " (tester-limited)" : "");
+        fflush(stdout);
+
+        if (t.pass)
+            lo = gbps;
+        else
+            hi = gbps;
+        if (t.pass && gbps >= max_gbps)
+            break;                  // Hat hızında kayıpsız
+        if (hi - lo <= resolution)
+            break;
+        gbps = (lo + hi) / 2.0;
+        if (gbps < TX_LIVE_MIN_GBPS)
+            break;
+    }
+
+    row->gbps = lo;
+    return 0;
+}
+
+// Tüm TX worker'larına tek boyutlu (veya profil) IMIX pattern
+static int rfc_set_frame(const uint16_t *pattern)
+{
+    int ret = tx_live_set_imix(pattern);
+    if (ret < 0)
+        printf("[RFC2544] Frame size change not applied (%d)\n", ret);
+    return ret < 0 ? ret : 0;
+}
+
+static void rfc_print_group(uint32_t mask, const struct rfc2544_row *rows, int nb_rows)
+{
+    printf("\n[RFC2544] Throughput, ports {");
+    bool first = true;
+    for (uint16_t p = 0; p < 32; p++) {
+        if (rfc_in_mask(mask, p)) {
+            printf("%s%u", first ? "" : ",", p);
+            first = false;
+        }
+    }
+    printf("}: loss-free rate per port, %u s trials, loss tolerance %u ppm\n",
+           RFC2544_TRIAL_SEC, RFC2544_LOSS_TOL_PPM);
+    printf("  ┌────────────┬────────────┬────────────┬────────────┬──────────┬────────┐\n");
+    printf("  │   Frame    │ Gbps (L2)  │    Mpps    │  Max Gbps  │  %% max   │ Trials │\n");
+    printf("  ├────────────┼────────────┼────────────┼────────────┼──────────┼────────┤\n");
+    for (int i = 0; i < nb_rows; i++) {
+        const struct rfc2544_row *r = &rows[i];
+        char frame[16];
+        if (r->imix)
+            snprintf(frame, sizeof(frame), "IMIX %4u", r->frame_size);
+        else
+            snprintf(frame, sizeof(frame), "%4u", r->frame_size);
+
+        if (r->skipped) {
+            printf("  │ %10s │ %10s │ %10s │ %10s │ %8s │ %6s │  outside %u..%u B\n",
+                   frame, "-", "-", "-", "-", "-", IMIX_MIN_PACKET_SIZE, IMIX_MAX_PACKET_SIZE);
+            continue;
+        }
+        const double mpps = r->gbps * 1e9 / 8.0 / (double)r->frame_size / 1e6;
+        const double pct = r->max_gbps > 0.0 ? r->gbps * 100.0 / r->max_gbps : 0.0;
+        printf("  │ %10s │ %10.3f │ %10.3f │ %10.3f │ %7.2f%% │ %6u │%s\n",
+               frame, r->gbps, mpps, r->max_gbps, pct, r->trials,
+               r->tester_limited ? "  tester-limited" : "");
+    }
+    printf("  └────────────┴────────────┴────────────┴────────────┴──────────┴────────┘\n");
+    fflush(stdout);
+}
+
+// ==========================================
+// ENTRY
+// ==========================================
+
+int rfc2544_run(const struct ports_config *ports_config, volatile bool *stop_flag)
+{
+    static const uint32_t cfg_groups[] = RFC2544_PORT_GROUPS_INIT;
+    uint32_t groups[32];
+    int nb_groups = 0;
+
+    // 0 = her aktif port kendi grubu
+    for (size_t g = 0; g < RTE_DIM(cfg_groups) && nb_groups < (int)RTE_DIM(groups); g++) {
+        if (cfg_groups[g] != 0) {
+            groups[nb_groups++] = cfg_groups[g];
+            continue;
+        }
+        for (uint16_t i = 0; i < ports_config->nb_ports && nb_groups < (int)RTE_DIM(groups); i++) {
+            if (ports_config->ports[i].port_id < 32)
+                groups[nb_groups++] = 1u << ports_config->ports[i].port_id;
+        }
+    }
+
+#if IMIX_ENABLED
+    static const uint16_t sizes[] = RFC2544_FRAME_SIZES_INIT;
+    uint16_t profile_imix[IMIX_PATTERN_SIZE];
+    memcpy(profile_imix, imix_pattern, sizeof(profile_imix));
+#else
+    static const uint16_t sizes[] = { PACKET_SIZE };
+#endif
+    struct rfc2544_row rows[RTE_DIM(sizes) + 1];
+
+    printf("\n=== RFC 2544 Throughput Search (%d group%s, %zu frame size%s%s) ===\n",
+           nb_groups, nb_groups == 1 ? "" : "s", RTE_DIM(sizes), RTE_DIM(sizes) == 1 ? "" : "s",
+           (IMIX_ENABLED && RFC2544_IMIX_ROW) ? " + IMIX" : "");
+
+    int ret = 0;
+    for (int g = 0; g < nb_groups && ret == 0; g++) {
+        const uint32_t mask = groups[g];
+        uint16_t nb_group_ports = 0;
+        for (uint16_t i = 0; i < ports_config->nb_ports; i++)
+            nb_group_ports += rfc_in_mask(mask, ports_config->ports[i].port_id);
+        if (nb_group_ports == 0) {
+            printf("[RFC2544] Group 0x%x has no active DPDK port, skipped\n", mask);
+            continue;
+        }
+
+        int nb_rows = 0;
+        memset(rows, 0, sizeof(rows));
+        printf("\n[RFC2544] Group %d/%d (mask 0x%x, %u ports)\n", g + 1, nb_groups, mask, nb_group_ports);
+
+        for (size_t s = 0; s < RTE_DIM(sizes) && ret == 0; s++) {
+            struct rfc2544_row *row = &rows[nb_rows++];
+            row->frame_size = sizes[s];
+#if IMIX_ENABLED
+            if (sizes[s] < IMIX_MIN_PACKET_SIZE || sizes[s] > IMIX_MAX_PACKET_SIZE) {
+                row->skipped = true;
+                continue;
+            }
+            uint16_t uniform[IMIX_PATTERN_SIZE];
+            for (int i = 0; i < IMIX_PATTERN_SIZE; i++)
+                uniform[i] = sizes[s];
+            ret = rfc_set_frame(uniform);
+            if (ret != 0)
+                break;
+#endif
+            ret = rfc_search(ports_config, mask, nb_group_ports, stop_flag, row);
+        }
+
+#if IMIX_ENABLED && RFC2544_IMIX_ROW
+        if (ret == 0) {
+            struct rfc2544_row *row = &rows[nb_rows++];
+            row->imix = true;
+            row->frame_size = (uint16_t)imix_avg_packet_size;
+            ret = rfc_set_frame(profile_imix);
+            if (ret == 0)
+                ret = rfc_search(ports_config, mask, nb_group_ports, stop_flag, row);
+        }
+#endif
+
+        rfc_restore_group(ports_config, mask);
+        rfc_print_group(mask, rows, ret == 0 ? nb_rows : nb_rows - 1);
+    }
+
+#if IMIX_ENABLED
+    // Profil pattern'ine dön (arama ortasında durulduysa da)
+    tx_live_set_imix(profile_imix);
+#endif
+
+    if (ret != 0)
+        printf("[RFC2544] Search aborted%s\n", *stop_flag ? " (stop requested)" : "");
+    else
+        printf("\n=== RFC 2544 search complete ===\n");
+    return ret != 0 ? -1 : 0;
+}
+
+#endif /* RFC2544_ENABLED */
@@ -0,0 +1,486 @@
+#include "rx_bag.h"
+#include "bag_sched.h"
+#include "health_monitor.h"
+#include "vl_map.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <rte_cycles.h>
+#include <rte_malloc.h>
+#include <rte_spinlock.h>
+#include <rte_ethdev.h>
+
+uint32_t rx_bag_epoch = 0;
+
+// Kayıtlı queue'lar (yalnızca eklenir, process ömrü boyunca silinmez)
+static struct rx_bag_queue *rx_bag_queues[RX_BAG_MAX_QUEUES];
+static uint32_t rx_bag_nb_queues = 0;
+static rte_spinlock_t rx_bag_reg_lock = RTE_SPINLOCK_INITIALIZER;
+
+// Port başına NIC saati → TSC çarpanı (32.32, 0 = TSC kullan), init_port_txrx yazar
+static uint64_t rx_bag_hw_mult[MAX_PORTS];
+static int rx_bag_ts_off = -1;
+static uint64_t rx_bag_ts_flag = 0;
+
+// rx_bag_reset anındaki DUT policing sayaçları (rapor bunlara göre artışı basar)
+static struct health_port_policing rx_bag_base_ast[HEALTH_MAX_PORTS];
+static struct health_port_policing rx_bag_base_mgr[HEALTH_MAX_PORTS];
+
+static inline uint32_t rx_bag_queue_count(void)
+{
+    return __atomic_load_n(&rx_bag_nb_queues, __ATOMIC_ACQUIRE);
+}
+
+static inline uint64_t rx_bag_us_to_cycles(uint64_t us, uint64_t tsc_hz)
+{
+    return us * tsc_hz / 1000000ULL;
+}
+
+// VL başına beklenen BAG ve ihlal eşiği (bag_sched ile aynı profil)
+static uint32_t rx_bag_build_expect(struct rx_bag_expect *exp, uint16_t vl_count)
+{
+    const uint64_t tsc_hz = rte_get_tsc_hz();
+    uint32_t known = 0;
+
+    for (uint16_t i = 0; i < vl_count; i++) {
+        uint32_t bag_us;
+        uint16_t jitter_us;
+
+        exp[i].bag = 0;
+        exp[i].floor = 0;
+        if (!bag_profile_vl(vl_map_vl_id(i), &bag_us, &jitter_us) || bag_us == 0)
+            continue;
+
+        const uint64_t bag = rx_bag_us_to_cycles(bag_us, tsc_hz);
+        const uint64_t jb = rx_bag_us_to_cycles(jitter_us, tsc_hz);
+        exp[i].bag = bag;
+        exp[i].floor = jb < bag ? bag - jb : 0;
+        known++;
+    }
+    return known;
+}
+
+static void rx_bag_queue_init(struct rx_bag_queue *q)
+{
+    memset(q->vl, 0, (size_t)q->vl_count * sizeof(struct rx_bag_vl));
+    memset(&q->jit, 0, sizeof(q->jit));
+    __atomic_store_n(&q->no_ts, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&q->invalid, 0, __ATOMIC_RELAXED);
+}
+
+struct rx_bag_queue *rx_bag_queue_create(uint16_t port_id, uint16_t queue_id,
+                                         uint16_t vl_count, int socket_id)
+{
+    struct rx_bag_queue *q = NULL;
+
+    if (vl_count == 0)
+        return NULL;
+
+    rte_spinlock_lock(&rx_bag_reg_lock);
+
+    // Worker yeniden başlatıldıysa mevcut kayıtları döndür
+    for (uint32_t i = 0; i < rx_bag_nb_queues; i++) {
+        struct rx_bag_queue *e = rx_bag_queues[i];
+        if (e->port_id == port_id && e->queue_id == queue_id && e->vl_count == vl_count) {
+            q = e;
+            goto out;
+        }
+    }
+
+    if (rx_bag_nb_queues >= RX_BAG_MAX_QUEUES) {
+        printf("Error: RX BAG analyzer registry full (%u queues)\n", RX_BAG_MAX_QUEUES);
+        goto out;
+    }
+
+    q = rte_zmalloc_socket("rx_bag_queue", sizeof(*q), RTE_CACHE_LINE_SIZE, socket_id);
+    if (q == NULL)
+        goto out;
+
+    q->vl = rte_zmalloc_socket("rx_bag_vl", (size_t)vl_count * sizeof(struct rx_bag_vl),
+                               RTE_CACHE_LINE_SIZE, socket_id);
+    q->exp = rte_zmalloc_socket("rx_bag_exp", (size_t)vl_count * sizeof(struct rx_bag_expect),
+                                RTE_CACHE_LINE_SIZE, socket_id);
+    if (q->vl == NULL || q->exp == NULL) {
+        rte_free(q->vl);
+        rte_free(q->exp);
+        rte_free(q);
+        q = NULL;
+        goto out;
+    }
+
+    q->vl_count = vl_count;
+    q->port_id = port_id;
+    q->queue_id = queue_id;
+    q->dtn_port = 0xFFFF;
+
+    const uint32_t known = rx_bag_build_expect(q->exp, vl_count);
+
+    // Zaman kaynağı: port kalibre edildiyse NIC timestamp, değilse burst TSC
+    if (port_id < MAX_PORTS && rx_bag_hw_mult[port_id] != 0) {
+        q->ts_mult = rx_bag_hw_mult[port_id];
+        q->ts_flag = rx_bag_ts_flag;
+        q->ts_off = rx_bag_ts_off;
+    } else {
+        q->ts_mult = RX_BAG_MULT_ONE;
+        q->ts_flag = 0;
+        q->ts_off = -1;
+    }
+
+    rx_bag_queue_init(q);
+    q->epoch = __atomic_load_n(&rx_bag_epoch, __ATOMIC_ACQUIRE);
+
+    rx_bag_queues[rx_bag_nb_queues] = q;
+    __atomic_store_n(&rx_bag_nb_queues, rx_bag_nb_queues + 1, __ATOMIC_RELEASE);
+
+    printf("  RX BAG analyzer: Port %u Q%u, %u VL (%u with BAG), %s timestamps\n",
+           port_id, queue_id, vl_count, known, q->ts_flag ? "NIC" : "burst TSC");
+
+out:
+    rte_spinlock_unlock(&rx_bag_reg_lock);
+    return q;
+}
+
+void rx_bag_hw_ts_setup(uint16_t port_id)
+{
+#if RX_BAG_HW_TIMESTAMP
+    uint64_t c0, c1, t0, t1;
+
+    if (port_id >= MAX_PORTS)
+        return;
+
+    // PMD offload açıkken alanı zaten kaydeder; aynı offset / flag döner
+    if (rx_bag_ts_flag == 0 &&
+        rte_mbuf_dyn_rx_timestamp_register(&rx_bag_ts_off, &rx_bag_ts_flag) != 0) {
+        printf("Warning: Port %u: RX timestamp dynfield unavailable, RX BAG analyzer uses TSC\n",
+               port_id);
+        rx_bag_ts_flag = 0;
+        return;
+    }
+
+    // NIC saati birimi PMD'ye özel (ns veya cycle): TSC'ye göre oranı ölç
+    t0 = rte_rdtsc();
+    if (rte_eth_read_clock(port_id, &c0) != 0) {
+        printf("Warning: Port %u: rte_eth_read_clock not supported, RX BAG analyzer uses TSC\n",
+               port_id);
+        return;
+    }
+    rte_delay_ms(RX_BAG_CALIB_MS);
+    t1 = rte_rdtsc();
+    if (rte_eth_read_clock(port_id, &c1) != 0 || c1 <= c0) {
+        printf("Warning: Port %u: NIC clock calibration failed, RX BAG analyzer uses TSC\n",
+               port_id);
+        return;
+    }
+
+    rx_bag_hw_mult[port_id] = (uint64_t)(((unsigned __int128)(t1 - t0) << 32) / (c1 - c0));
+    printf("Port %u: NIC RX timestamps enabled (clock %.3f MHz)\n", port_id,
+           (double)(c1 - c0) * (double)rte_get_tsc_hz() / (double)(t1 - t0) / 1e6);
+#else
+    RTE_SET_USED(port_id);
+#endif
+}
+
+void rx_bag_reset(void)
+{
+    // Health monitor hiç cevap almadıysa tüm portlar valid = false kalır
+    get_health_port_policing(rx_bag_base_ast, rx_bag_base_mgr);
+    __atomic_store_n(&rx_bag_epoch, rx_bag_epoch + 1, __ATOMIC_RELEASE);
+}
+
+void rx_bag_queue_clear(struct rx_bag_queue *q)
+{
+    // Epoch eşleşmediği sürece snapshot bu queue'yu okumaz
+    rx_bag_queue_init(q);
+    __atomic_store_n(&q->epoch, __atomic_load_n(&rx_bag_epoch, __ATOMIC_ACQUIRE),
+                     __ATOMIC_RELEASE);
+}
+
+// ==========================================
+// SNAPSHOT (stats lcore)
+// ==========================================
+
+// Başka worker'ın VL kaydını oku: önce gaps (acquire), sonra kalan alanlar
+static bool rx_bag_vl_read(const struct rx_bag_vl *src, struct rx_bag_vl *dst)
+{
+    dst->gaps = __atomic_load_n(&src->gaps, __ATOMIC_ACQUIRE);
+    if (dst->gaps == 0)
+        return false;
+    dst->sum_gap = __atomic_load_n(&src->sum_gap, __ATOMIC_RELAXED);
+    dst->min_gap = __atomic_load_n(&src->min_gap, __ATOMIC_RELAXED);
+    dst->max_gap = __atomic_load_n(&src->max_gap, __ATOMIC_RELAXED);
+    dst->max_jitter = __atomic_load_n(&src->max_jitter, __ATOMIC_RELAXED);
+    dst->violations = __atomic_load_n(&src->violations, __ATOMIC_RELAXED);
+    return true;
+}
+
+static void rx_bag_row_add(struct rx_bag_row *row, const struct rx_bag_vl *v,
+                           const struct rx_bag_expect *e)
+{
+    row->gaps += v->gaps;
+    row->violations += v->violations;
+    row->vls++;
+    if (v->violations != 0)
+        row->viol_vls++;
+    if (e->bag != 0) {
+        const double ratio = (double)v->min_gap / (double)e->bag;
+        if (row->vls_known == 0 || ratio < row->min_ratio)
+            row->min_ratio = ratio;
+        row->vls_known++;
+    }
+}
+
+void rx_bag_snapshot_take(struct rx_bag_snapshot *snap)
+{
+    const uint32_t epoch = __atomic_load_n(&rx_bag_epoch, __ATOMIC_ACQUIRE);
+    const uint32_t n = rx_bag_queue_count();
+    const double us_per_cycle = 1e6 / (double)rte_get_tsc_hz();
+    struct lat_hist jit;
+    struct rx_bag_vl v;
+
+    memset(snap, 0, sizeof(*snap));
+
+    for (uint32_t i = 0; i < n; i++) {
+        const struct rx_bag_queue *q = rx_bag_queues[i];
+        if (__atomic_load_n(&q->epoch, __ATOMIC_ACQUIRE) != epoch)
+            continue;
+
+        snap->no_ts += __atomic_load_n(&q->no_ts, __ATOMIC_RELAXED);
+        snap->invalid += __atomic_load_n(&q->invalid, __ATOMIC_RELAXED);
+
+        struct rx_bag_row *prow = q->port_id < MAX_PORTS ? &snap->port[q->port_id] : NULL;
+#if STATS_MODE_DTN
+        struct rx_bag_row *drow = q->dtn_port < DTN_PORT_COUNT ? &snap->dtn[q->dtn_port] : NULL;
+#endif
+        lat_hist_read(&q->jit, &jit);
+        if (prow != NULL)
+            lat_hist_merge(&prow->jit, &jit);
+#if STATS_MODE_DTN
+        if (drow != NULL)
+            lat_hist_merge(&drow->jit, &jit);
+#endif
+
+        for (uint16_t k = 0; k < q->vl_count; k++) {
+            const struct rx_bag_expect *e = &q->exp[k];
+
+            if (!rx_bag_vl_read(&q->vl[k], &v))
+                continue;
+
+            snap->violations += v.violations;
+            if (prow != NULL)
+                rx_bag_row_add(prow, &v, e);
+#if STATS_MODE_DTN
+            if (drow != NULL)
+                rx_bag_row_add(drow, &v, e);
+#endif
+            if (e->bag == 0)
+                continue;
+
+            // En kötü VL'ler: min_gap / BAG artan (eşitlikte ilk bulunan kalır)
+            const double ratio = (double)v.min_gap / (double)e->bag;
+            uint32_t pos = snap->nb_worst;
+            while (pos > 0 && snap->worst[pos - 1].ratio > ratio)
+                pos--;
+            if (pos >= RX_BAG_TOP_VLS)
+                continue;
+
+            const uint32_t last = (snap->nb_worst < RX_BAG_TOP_VLS) ?
+                                  snap->nb_worst : RX_BAG_TOP_VLS - 1;
+            for (uint32_t j = last; j > pos; j--)
+                snap->worst[j] = snap->worst[j - 1];
+
+            struct rx_bag_worst_vl *w = &snap->worst[pos];
+            w->port_id = q->port_id;
+            w->queue_id = q->queue_id;
+            w->vl_id = vl_map_vl_id(k);
+            w->ratio = ratio;
+            w->min_gap_us = (double)v.min_gap * us_per_cycle;
+            w->bag_us = (double)e->bag * us_per_cycle;
+            w->max_jitter_us = (double)v.max_jitter * us_per_cycle;
+            w->violations = v.violations;
+            if (snap->nb_worst < RX_BAG_TOP_VLS)
+                snap->nb_worst++;
+        }
+    }
+}
+
+// ==========================================
+// REPORT
+// ==========================================
+
+// Switch sayacı reset'ten bu yana artış (switch kendi sayacını sıfırladıysa mevcut değer)
+static inline uint64_t rx_bag_delta(uint64_t now, uint64_t base)
+{
+    return now >= base ? now - base : now;
+}
+
+struct rx_bag_dut {
+    uint64_t policy_drop;
+    uint64_t max_delay_err;
+    uint32_t ports;             // Sayaçları artan switch portu
+};
+
+// Health monitor policing sayaçları (A + M), isteğe bağlı port bazında liste
+// Monitor durdurulduktan sonra da son döngünün değerleri okunur (test sonu raporu)
+// @return false if no switch port was ever received
+static bool rx_bag_dut_collect(struct rx_bag_dut *dut, bool print_ports)
+{
+    static struct health_port_policing ast[HEALTH_MAX_PORTS], mgr[HEALTH_MAX_PORTS];
+    bool any = false;
+
+    memset(dut, 0, sizeof(*dut));
+    get_health_port_policing(ast, mgr);
+
+    for (int p = 0; p < HEALTH_MAX_PORTS; p++) {
+        any |= ast[p].valid || mgr[p].valid;
+
+        const uint64_t pd_a = ast[p].valid ? rx_bag_delta(ast[p].traffic_policy_drop,
+                                                          rx_bag_base_ast[p].traffic_policy_drop) : 0;
+        const uint64_t pd_m = mgr[p].valid ? rx_bag_delta(mgr[p].traffic_policy_drop,
+                                                          rx_bag_base_mgr[p].traffic_policy_drop) : 0;
+        const uint64_t md_a = ast[p].valid ? rx_bag_delta(ast[p].max_delay_err,
+                                                          rx_bag_base_ast[p].max_delay_err) : 0;
+        const uint64_t md_m = mgr[p].valid ? rx_bag_delta(mgr[p].max_delay_err,
+                                                          rx_bag_base_mgr[p].max_delay_err) : 0;
+
+        if (pd_a + pd_m + md_a + md_m == 0)
+            continue;
+
+        dut->policy_drop += pd_a + pd_m;
+        dut->max_delay_err += md_a + md_m;
+        dut->ports++;
+        if (print_ports)
+            printf("  │ %6d │ %12lu │ %12lu │ %12lu │ %12lu │\n",
+                   p, pd_a, pd_m, md_a, md_m);
+    }
+    return any;
+}
+
+static void rx_bag_print_header(const char *key)
+{
+    printf("  ┌────────┬──────────────┬────────┬──────────┬──────────────┬──────────┬──────────┬──────────┬──────────┐\n");
+    printf("  │ %-6s │   Gaps       │  VLs   │ Viol VLs │  Violations  │ MinG/BAG │ J50 (us) │ J99 (us) │ Jmax(us) │\n", key);
+    printf("  ├────────┼──────────────┼────────┼──────────┼──────────────┼──────────┼──────────┼──────────┼──────────┤\n");
+}
+
+static void rx_bag_print_footer(void)
+{
+    printf("  └────────┴──────────────┴────────┴──────────┴──────────────┴──────────┴──────────┴──────────┴──────────┘\n");
+}
+
+static void rx_bag_print_row(const char *label, const struct rx_bag_row *r)
+{
+    struct lat_summary j;
+    char ratio[16];
+
+    lat_hist_summarize(&r->jit, &j);
+    if (r->vls_known > 0)
+        snprintf(ratio, sizeof(ratio), "%8.3f", r->min_ratio);
+    else
+        snprintf(ratio, sizeof(ratio), "%8s", "-");
+
+    printf("  │ %-6s │ %12lu │ %6u │ %8u │ %12lu │ %s │ %8.2f │ %8.2f │ %8.2f │\n",
+           label, r->gaps, r->vls, r->viol_vls, r->violations, ratio,
+           j.p50_ns / 1000.0, j.p99_ns / 1000.0, j.max_ns / 1000.0);
+}
+
+void rx_bag_print_stats(const struct rx_bag_snapshot *snap)
+{
+    struct rx_bag_dut dut;
+    char label[16];
+
+    printf("\n  RX BAG Conformance (inter-arrival, J = |gap - BAG|, ihlal: gap < BAG - jitter):\n");
+#if STATS_MODE_DTN
+    rx_bag_print_header("DTN");
+    for (uint16_t d = 0; d < DTN_PORT_COUNT; d++) {
+        if (snap->dtn[d].vls == 0)
+            continue;
+        snprintf(label, sizeof(label), "%u", d);
+        rx_bag_print_row(label, &snap->dtn[d]);
+    }
+#else
+    rx_bag_print_header("Port");
+    for (uint16_t p = 0; p < MAX_PORTS; p++) {
+        if (snap->port[p].vls == 0)
+            continue;
+        snprintf(label, sizeof(label), "%u", p);
+        rx_bag_print_row(label, &snap->port[p]);
+    }
+#endif
+    rx_bag_print_footer();
+
+    if (snap->nb_worst > 0) {
+        printf("  En düşük MinGap/BAG VL'ler:");
+        for (uint32_t k = 0; k < snap->nb_worst; k++) {
+            const struct rx_bag_worst_vl *w = &snap->worst[k];
+            printf(" P%u/Q%u/VL%u=%.1f/%.1fus", w->port_id, w->queue_id, w->vl_id,
+                   w->min_gap_us, w->bag_us);
+        }
+        printf("\n");
+    }
+
+    // Çapraz kontrol: alıcıda görülen ihlal ↔ switch'in policing sayaçları
+    if (rx_bag_dut_collect(&dut, false))
+        printf("  RX BAG violations: %lu | DUT PolicyDrop: %lu | DUT MaxDelayErr: %lu (%u switch port)\n",
+               snap->violations, dut.policy_drop, dut.max_delay_err, dut.ports);
+    if (snap->no_ts > 0)
+        printf("  ⚠ NIC timestamp'siz frame: %lu (ölçülmedi)\n", snap->no_ts);
+    if (snap->invalid > 0)
+        printf("  ⚠ Zaman geri gitti (ts < önceki): %lu frame\n", snap->invalid);
+}
+
+void rx_bag_print_vl_report(void)
+{
+    const uint32_t epoch = __atomic_load_n(&rx_bag_epoch, __ATOMIC_ACQUIRE);
+    const uint32_t n = rx_bag_queue_count();
+    const double us_per_cycle = 1e6 / (double)rte_get_tsc_hz();
+    uint64_t total_vls = 0, bad_vls = 0, unknown_vls = 0;
+    struct rx_bag_vl v;
+    struct rx_bag_dut dut;
+
+    printf("\n=== RX BAG Conformance per VL ===\n");
+
+    for (uint32_t i = 0; i < n; i++) {
+        const struct rx_bag_queue *q = rx_bag_queues[i];
+        if (__atomic_load_n(&q->epoch, __ATOMIC_ACQUIRE) != epoch)
+            continue;
+
+        bool first = true;
+        for (uint16_t k = 0; k < q->vl_count; k++) {
+            const struct rx_bag_expect *e = &q->exp[k];
+
+            if (!rx_bag_vl_read(&q->vl[k], &v))
+                continue;
+            total_vls++;
+            if (e->bag == 0)
+                unknown_vls++;
+            if (v.violations == 0)
+                continue;
+            bad_vls++;
+
+            if (first) {
+                printf("\n  Port %u Queue %u:\n", q->port_id, q->queue_id);
+                printf("  VL-ID  |      Gaps    |  Violations  | BAG (us) | Min (us) | Avg (us) | Max (us) | Jmax (us)\n");
+                first = false;
+            }
+            printf("  %6u | %12lu | %12lu | %8.1f | %8.1f | %8.1f | %8.1f | %9.1f\n",
+                   vl_map_vl_id(k), v.gaps, v.violations, (double)e->bag * us_per_cycle,
+                   (double)v.min_gap * us_per_cycle,
+                   (double)v.sum_gap / (double)v.gaps * us_per_cycle,
+                   (double)v.max_gap * us_per_cycle, (double)v.max_jitter * us_per_cycle);
+        }
+    }
+
+    printf("\n  VL: %lu ölçüldü, %lu BAG ihlali olan, %lu profilsiz (sadece jitter)\n",
+           total_vls, bad_vls, unknown_vls);
+
+    printf("\n  DUT policing (health monitor, reset'ten bu yana, A = assistant, M = manager):\n");
+    printf("  ┌────────┬──────────────┬──────────────┬──────────────┬──────────────┐\n");
+    printf("  │ SW Port│ PolDrop (A)  │ PolDrop (M)  │ MaxDelay (A) │ MaxDelay (M) │\n");
+    printf("  ├────────┼──────────────┼──────────────┼──────────────┼──────────────┤\n");
+    const bool dut_seen = rx_bag_dut_collect(&dut, true);
+    printf("  └────────┴──────────────┴──────────────┴──────────────┴──────────────┘\n");
+    if (!dut_seen)
+        printf("  Health monitor cevabı yok (kapalı veya DUT cevap vermedi)\n");
+    printf("  Toplam: PolicyDrop=%lu MaxDelayErr=%lu (%u port)\n",
+           dut.policy_drop, dut.max_delay_err, dut.ports);
+}
@@ -0,0 +1,168 @@
+#include "rx_sequence.h"
+#include "config.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <rte_malloc.h>
+#include <rte_spinlock.h>
+
+uint32_t rx_seq_epoch = 0;
+
+// Kayıtlı queue'lar (yalnızca eklenir, process ömrü boyunca silinmez)
+static struct rx_seq_queue *rx_seq_queues[RX_SEQ_MAX_QUEUES];
+static uint32_t rx_seq_nb_queues = 0;
+static rte_spinlock_t rx_seq_reg_lock = RTE_SPINLOCK_INITIALIZER;
+
+static inline uint32_t rx_seq_queue_count(void)
+{
+    return __atomic_load_n(&rx_seq_nb_queues, __ATOMIC_ACQUIRE);
+}
+
+struct rx_seq_queue *rx_seq_queue_create(uint16_t port_id, uint16_t queue_id,
+                                         uint16_t vl_count, int socket_id)
+{
+    struct rx_seq_queue *q = NULL;
+
+    if (vl_count == 0)
+        return NULL;
+
+    rte_spinlock_lock(&rx_seq_reg_lock);
+
+    // Worker yeniden başlatıldıysa mevcut diziyi döndür
+    for (uint32_t i = 0; i < rx_seq_nb_queues; i++) {
+        struct rx_seq_queue *e = rx_seq_queues[i];
+        if (e->port_id == port_id && e->queue_id == queue_id && e->vl_count == vl_count) {
+            q = e;
+            goto out;
+        }
+    }
+
+    if (rx_seq_nb_queues >= RX_SEQ_MAX_QUEUES) {
+        printf("Error: RX sequence registry full (%u queues)\n", RX_SEQ_MAX_QUEUES);
+        goto out;
+    }
+
+    q = rte_zmalloc_socket("rx_seq_queue", sizeof(*q), RTE_CACHE_LINE_SIZE, socket_id);
+    if (q == NULL)
+        goto out;
+
+    q->vl = rte_zmalloc_socket("rx_seq_track", (size_t)vl_count * sizeof(struct rx_seq_track),
+                               RTE_CACHE_LINE_SIZE, socket_id);
+    if (q->vl == NULL) {
+        rte_free(q);
+        q = NULL;
+        goto out;
+    }
+
+    q->epoch = __atomic_load_n(&rx_seq_epoch, __ATOMIC_ACQUIRE);
+    q->vl_count = vl_count;
+    q->port_id = port_id;
+    q->queue_id = queue_id;
+
+    rx_seq_queues[rx_seq_nb_queues] = q;
+    __atomic_store_n(&rx_seq_nb_queues, rx_seq_nb_queues + 1, __ATOMIC_RELEASE);
+
+out:
+    rte_spinlock_unlock(&rx_seq_reg_lock);
+    return q;
+}
+
+void rx_seq_reset(void)
+{
+    __atomic_store_n(&rx_seq_epoch, rx_seq_epoch + 1, __ATOMIC_RELEASE);
+}
+
+void rx_seq_queue_clear(struct rx_seq_queue *q)
+{
+    // Epoch eşleşmediği sürece merge bu queue'yu okumaz
+    memset(q->vl, 0, (size_t)q->vl_count * sizeof(struct rx_seq_track));
+    __atomic_store_n(&q->epoch, __atomic_load_n(&rx_seq_epoch, __ATOMIC_ACQUIRE),
+                     __ATOMIC_RELEASE);
+}
+
+// Bu portun reset'i uygulamış queue'ları
+static uint32_t rx_seq_port_queues(uint16_t port_id, const struct rx_seq_queue **qs)
+{
+    const uint32_t epoch = __atomic_load_n(&rx_seq_epoch, __ATOMIC_ACQUIRE);
+    uint32_t n = rx_seq_queue_count();
+    uint32_t nq = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        const struct rx_seq_queue *q = rx_seq_queues[i];
+        if (q->port_id != port_id)
+            continue;
+        if (__atomic_load_n(&q->epoch, __ATOMIC_ACQUIRE) != epoch)
+            continue;
+        qs[nq++] = q;
+    }
+    return nq;
+}
+
+static void rx_seq_merge_one(const struct rx_seq_queue **qs, uint32_t nq, uint16_t idx,
+                             struct rx_seq_totals *out)
+{
+    uint64_t pkts = 0, late = 0;
+    uint64_t lo = UINT64_MAX, hi = 0;
+
+    for (uint32_t i = 0; i < nq; i++) {
+        if (idx >= qs[i]->vl_count)
+            continue;
+
+        const struct rx_seq_track *t = &qs[i]->vl[idx];
+        uint64_t cnt = __atomic_load_n(&t->pkt_count, __ATOMIC_ACQUIRE);
+        if (cnt == 0)
+            continue;
+
+        uint64_t mx = __atomic_load_n(&t->max_seq, __ATOMIC_RELAXED);
+        uint64_t mn = __atomic_load_n(&t->min_seq, __ATOMIC_RELAXED);
+        if (mx > hi)
+            hi = mx;
+        if (mn < lo)
+            lo = mn;
+        late += __atomic_load_n(&t->late_count, __ATOMIC_RELAXED);
+        pkts += cnt;
+    }
+
+    if (pkts == 0)
+        return;
+
+    // Watermark: TX sequence'ları warm-up reset'inde sıfırlanmaz, span ilk
+    // görülen sequence'tan başlar (hi + 1 reset öncesini kayıp sayardı)
+    uint64_t span = hi - lo + 1;
+    if (span > pkts)
+        out->lost += span - pkts;
+    else
+        out->duplicate += pkts - span;
+
+    out->out_of_order += late;
+    out->pkts += pkts;
+}
+
+uint32_t rx_seq_merge(uint16_t port_id, uint32_t vl_start, uint32_t vl_end,
+                      struct rx_seq_totals *out)
+{
+    const struct rx_seq_queue *qs[RX_SEQ_MAX_QUEUES];
+    uint32_t nq = rx_seq_port_queues(port_id, qs);
+
+    memset(out, 0, sizeof(*out));
+
+    for (uint32_t vl = vl_start; vl < vl_end && vl <= 0xFFFF; vl++) {
+        uint16_t idx = vl_map_index((uint16_t)vl);
+        if (idx != VL_MAP_INVALID)
+            rx_seq_merge_one(qs, nq, idx, out);
+    }
+    return nq;
+}
+
+uint32_t rx_seq_merge_all(uint16_t port_id, struct rx_seq_totals *out)
+{
+    const struct rx_seq_queue *qs[RX_SEQ_MAX_QUEUES];
+    uint32_t nq = rx_seq_port_queues(port_id, qs);
+    uint16_t count = vl_map_count();
+
+    memset(out, 0, sizeof(*out));
+
+    for (uint16_t idx = 0; idx < count; idx++)
+        rx_seq_merge_one(qs, nq, idx, out);
+    return nq;
+}
@@ -0,0 +1,191 @@
+#include "stats_shard.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <rte_malloc.h>
+#include <rte_pause.h>
+#include <rte_spinlock.h>
+
+// Kayıtlı shard'lar (yalnızca eklenir, process ömrü boyunca silinmez)
+static struct stats_shard *stats_shards[STATS_MAX_SHARDS];
+static uint32_t stats_nb_shards = 0;
+static rte_spinlock_t stats_reg_lock = RTE_SPINLOCK_INITIALIZER;
+
+// VL sequence merge sonuçları (sadece stats lcore yazar/okur)
+struct stats_seq_result {
+    uint64_t lost;
+    uint64_t out_of_order;
+    uint64_t duplicate;
+};
+
+static struct stats_seq_result stats_port_seq[MAX_PORTS];
+#if STATS_MODE_DTN
+static struct stats_seq_result stats_dtn_seq[DTN_PORT_COUNT];
+#endif
+
+static inline uint32_t stats_shard_count(void)
+{
+    return __atomic_load_n(&stats_nb_shards, __ATOMIC_ACQUIRE);
+}
+
+struct stats_shard *stats_shard_create(enum stats_domain domain, uint16_t group,
+                                       uint16_t sub, uint16_t instance, int socket_id)
+{
+    struct stats_shard *s = NULL;
+
+    rte_spinlock_lock(&stats_reg_lock);
+
+    // Worker yeniden başlatıldıysa mevcut shard'ı döndür
+    for (uint32_t i = 0; i < stats_nb_shards; i++) {
+        struct stats_shard *e = stats_shards[i];
+        if (e->domain == domain && e->group == group &&
+            e->sub == sub && e->instance == instance) {
+            s = e;
+            goto out;
+        }
+    }
+
+    if (stats_nb_shards >= STATS_MAX_SHARDS) {
+        printf("Error: Stats shard registry full (%u shards)\n", STATS_MAX_SHARDS);
+        goto out;
+    }
+
+    s = rte_zmalloc_socket("stats_shard", sizeof(*s), RTE_CACHE_LINE_SIZE, socket_id);
+    if (s == NULL)
+        goto out;
+
+    s->domain = (uint8_t)domain;
+    s->group = group;
+    s->sub = sub;
+    s->instance = instance;
+    s->dtn_port = STATS_DTN_NONE;
+
+    stats_shards[stats_nb_shards] = s;
+    __atomic_store_n(&stats_nb_shards, stats_nb_shards + 1, __ATOMIC_RELEASE);
+
+out:
+    rte_spinlock_unlock(&stats_reg_lock);
+    return s;
+}
+
+// Shard'ın tutarlı kopyası (seqcount, yazar tek ve kısa)
+static void stats_shard_read(const struct stats_shard *s, struct stats_counters *out)
+{
+    const uint64_t *src = (const uint64_t *)&s->c;
+    uint64_t *dst = (uint64_t *)out;
+    uint32_t seq0, seq1;
+
+    do {
+        while ((seq0 = __atomic_load_n(&s->seq, __ATOMIC_ACQUIRE)) & 1)
+            rte_pause();
+        for (size_t i = 0; i < STATS_COUNTER_WORDS; i++)
+            dst[i] = __atomic_load_n(&src[i], __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        seq1 = __atomic_load_n(&s->seq, __ATOMIC_RELAXED);
+    } while (seq0 != seq1);
+}
+
+// dst += a - b
+static inline void stats_counters_add_delta(struct stats_counters *dst,
+                                            const struct stats_counters *a,
+                                            const struct stats_counters *b)
+{
+    uint64_t *d = (uint64_t *)dst;
+    const uint64_t *x = (const uint64_t *)a;
+    const uint64_t *y = (const uint64_t *)b;
+
+    for (size_t i = 0; i < STATS_COUNTER_WORDS; i++)
+        d[i] += x[i] - y[i];
+}
+
+static inline void stats_seq_apply(struct stats_counters *c, const struct stats_seq_result *r)
+{
+    c->lost_pkts += r->lost;
+    c->out_of_order_pkts += r->out_of_order;
+    c->duplicate_pkts += r->duplicate;
+}
+
+// Shard'ın snapshot'taki satırı (aralık dışı ise NULL)
+static struct stats_counters *stats_row(struct stats_snapshot *snap, const struct stats_shard *s)
+{
+    switch (s->domain) {
+    case STATS_DOM_PORT_RX:
+        return s->group < MAX_PORTS ? &snap->port_rx[s->group] : NULL;
+    case STATS_DOM_RAW_TX:
+        return (s->group < MAX_RAW_SOCKET_PORTS && s->sub < MAX_RAW_TARGETS) ?
+               &snap->raw_tx[s->group][s->sub] : NULL;
+    case STATS_DOM_RAW_RX:
+        return (s->group < MAX_RAW_SOCKET_PORTS && s->sub < MAX_RAW_TARGETS) ?
+               &snap->raw_rx[s->group][s->sub] : NULL;
+    case STATS_DOM_RAW_EXT_RX:
+        return s->group < MAX_RAW_SOCKET_PORTS ? &snap->raw_ext_rx[s->group] : NULL;
+    case STATS_DOM_EXT_TX:
+        return s->group < DPDK_EXT_TX_PORT_COUNT ? &snap->ext_tx[s->group] : NULL;
+    default:
+        return NULL;
+    }
+}
+
+void stats_snapshot_take(struct stats_snapshot *snap)
+{
+    const uint32_t n = stats_shard_count();
+
+    memset(snap, 0, sizeof(*snap));
+
+    for (uint32_t i = 0; i < n; i++) {
+        const struct stats_shard *s = stats_shards[i];
+        struct stats_counters cur;
+        struct stats_counters *row = stats_row(snap, s);
+
+        if (row == NULL)
+            continue;
+
+        stats_shard_read(s, &cur);
+        stats_counters_add_delta(row, &cur, &s->base);
+
+#if STATS_MODE_DTN
+        if (s->domain == STATS_DOM_PORT_RX && s->dtn_port < DTN_PORT_COUNT)
+            stats_counters_add_delta(&snap->dtn[s->dtn_port], &cur, &s->base);
+#endif
+    }
+
+    for (uint16_t p = 0; p < MAX_PORTS; p++)
+        stats_seq_apply(&snap->port_rx[p], &stats_port_seq[p]);
+#if STATS_MODE_DTN
+    for (uint16_t d = 0; d < DTN_PORT_COUNT; d++)
+        stats_seq_apply(&snap->dtn[d], &stats_dtn_seq[d]);
+#endif
+}
+
+void stats_reset(void)
+{
+    const uint32_t n = stats_shard_count();
+
+    for (uint32_t i = 0; i < n; i++) {
+        struct stats_shard *s = stats_shards[i];
+        stats_shard_read(s, &s->base);
+    }
+
+    memset(stats_port_seq, 0, sizeof(stats_port_seq));
+#if STATS_MODE_DTN
+    memset(stats_dtn_seq, 0, sizeof(stats_dtn_seq));
+#endif
+}
+
+void stats_publish_port_seq(uint16_t port_id, uint64_t lost,
+                            uint64_t out_of_order, uint64_t duplicate)
+{
+    if (port_id >= MAX_PORTS)
+        return;
+    stats_port_seq[port_id] = (struct stats_seq_result){ lost, out_of_order, duplicate };
+}
+
+#if STATS_MODE_DTN
+void stats_publish_dtn_seq(uint16_t dtn_port, uint64_t lost,
+                           uint64_t out_of_order, uint64_t duplicate)
+{
+    if (dtn_port >= DTN_PORT_COUNT)
+        return;
+    stats_dtn_seq[dtn_port] = (struct stats_seq_result){ lost, out_of_order, duplicate };
+}
+#endif
@@ -0,0 +1,791 @@
+#include "traffic_profile.h"
+#include "tx_rx_manager.h"      // port_vlans, VL_RANGE_SIZE_PER_QUEUE
+#include "raw_socket_port.h"    // raw_port_configs, raw_imix_pattern
+#include "raw_tx_batch.h"       // raw_tx_submit_name
+#include "dpdk_external_tx.h"   // dpdk_ext_tx_configs
+#include "packet.h"             // imix_pattern, VLAN_HDR_SIZE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <rte_common.h>
+
+// ==========================================
+// PARSED PROFILE (staging)
+// ==========================================
+// Dosya EAL'den önce okunur; mod (normal / ATE) henüz belli olmadığı için
+// port / raw / ext bölümleri burada bekler, apply fonksiyonları mod
+// tablolarının üzerine yazar.
+
+enum tp_mode {
+    TP_MODE_ANY = 0,
+    TP_MODE_NORMAL,
+    TP_MODE_ATE,
+};
+
+struct tp_port {
+    bool rate_set;
+    bool tx_vlans_set, tx_vl_ids_set;
+    bool rx_vlans_set, rx_vl_ids_set;
+    double rate_gbps;
+    uint16_t tx_vlan_count, tx_vl_count;
+    uint16_t rx_vlan_count, rx_vl_count;
+    uint16_t tx_vlans[MAX_TX_VLANS_PER_PORT];
+    uint16_t tx_vl_ids[MAX_TX_VLANS_PER_PORT];
+    uint16_t rx_vlans[MAX_RX_VLANS_PER_PORT];
+    uint16_t rx_vl_ids[MAX_RX_VLANS_PER_PORT];
+};
+
+struct tp_raw {
+    uint16_t port_id;
+    bool targets_set, sources_set;
+    bool backend_set, tx_submit_set;
+    uint8_t backend;                    // enum raw_port_backend
+    uint8_t tx_submit;                  // enum raw_tx_submit
+    char iface[IFNAMSIZ];               // Boş = config.h arayüzü (örn. veth testi)
+    uint16_t target_count, source_count;
+    struct raw_tx_target_config targets[MAX_RAW_TARGETS];
+    struct raw_rx_source_config sources[MAX_RAW_TARGETS];
+};
+
+#if DPDK_EXT_TX_ENABLED
+struct tp_ext {
+    uint16_t port_id;
+    bool dest_set, targets_set;
+    uint16_t dest_port;
+    uint16_t target_count;
+    struct dpdk_ext_tx_target targets[DPDK_EXT_TX_QUEUES_PER_PORT];
+};
+#endif
+
+enum tp_section {
+    TP_SEC_GLOBAL = 0,
+    TP_SEC_PORT,
+    TP_SEC_RAW,
+    TP_SEC_EXT,
+};
+
+static struct {
+    bool loaded;
+    enum tp_mode mode;
+    char path[256];
+    bool imix_set;
+    uint16_t imix[IMIX_PATTERN_SIZE];
+    bool port_used[MAX_PORTS_CONFIG];
+    struct tp_port port[MAX_PORTS_CONFIG];
+    struct tp_raw raw[MAX_RAW_SOCKET_PORTS];
+    uint16_t raw_count;
+#if DPDK_EXT_TX_ENABLED
+    struct tp_ext ext[DPDK_EXT_TX_PORT_COUNT];
+    uint16_t ext_count;
+#endif
+} g_tp;
+
+// Port rate tablosu (traffic_profile_apply_ports doldurur)
+static double port_rate_gbps[MAX_PORTS_CONFIG];
+static const char *port_rate_class[MAX_PORTS_CONFIG];
+static bool port_rates_ready = false;
+
+// ==========================================
+// PARSER HELPERS
+// ==========================================
+
+static char *tp_trim(char *s)
+{
+    while (isspace((unsigned char)*s))
+        s++;
+    char *end = s + strlen(s);
+    while (end > s && isspace((unsigned char)end[-1]))
+        *--end = '\0';
+    return s;
+}
+
+static int tp_parse_uint(const char *s, unsigned long max, unsigned long *out)
+{
+    char *end;
+    errno = 0;
+    unsigned long v = strtoul(s, &end, 0);
+    if (errno != 0 || end == s || *tp_trim(end) != '\0' || v > max || *s == '-')
+        return -1;
+    *out = v;
+    return 0;
+}
+
+/**
+ * Virgülle ayrılmış sayı listesi, her eleman [min, max] içinde
+ * @return eleman sayısı, hata ise -1
+ */
+static int tp_parse_list(char *val, unsigned long min, unsigned long max,
+                         unsigned long *out, int cap)
+{
+    int n = 0;
+    char *save = NULL;
+
+    for (char *tok = strtok_r(val, ",", &save); tok != NULL; tok = strtok_r(NULL, ",", &save)) {
+        unsigned long v;
+        if (n >= cap || tp_parse_uint(tp_trim(tok), max, &v) != 0 || v < min)
+            return -1;
+        out[n++] = v;
+    }
+    return n;
+}
+
+static int tp_parse_u16_list(char *val, unsigned long min, unsigned long max,
+                             uint16_t *out, int cap, uint16_t *count)
+{
+    unsigned long tmp[MAX_TX_VLANS_PER_PORT > MAX_RX_VLANS_PER_PORT ?
+                      MAX_TX_VLANS_PER_PORT : MAX_RX_VLANS_PER_PORT];
+    if (cap > (int)RTE_DIM(tmp))
+        cap = (int)RTE_DIM(tmp);
+
+    int n = tp_parse_list(val, min, max, tmp, cap);
+    if (n <= 0)
+        return -1;
+    for (int i = 0; i < n; i++)
+        out[i] = (uint16_t)tmp[i];
+    *count = (uint16_t)n;
+    return 0;
+}
+
+static const char *build_pacing_name(void)
+{
+#if BAG_SCHED_ENABLED
+    return "bag";
+#elif TOKEN_BUCKET_TX_ENABLED
+    return "token_bucket";
+#else
+    return "rate_limiter";
+#endif
+}
+
+// ==========================================
+// SECTION HANDLERS
+// ==========================================
+
+static int tp_global_key(const char *key, char *val)
+{
+    if (strcmp(key, "mode") == 0) {
+        if (strcmp(val, "any") == 0)
+            g_tp.mode = TP_MODE_ANY;
+        else if (strcmp(val, "normal") == 0)
+            g_tp.mode = TP_MODE_NORMAL;
+        else if (strcmp(val, "ate") == 0)
+            g_tp.mode = TP_MODE_ATE;
+        else
+            return -1;
+        return 0;
+    }
+
+    if (strcmp(key, "pacing") == 0) {
+        if (strcmp(val, "rate_limiter") != 0 && strcmp(val, "token_bucket") != 0 &&
+            strcmp(val, "bag") != 0)
+            return -1;
+        if (strcmp(val, build_pacing_name()) != 0) {
+            printf("[PROFILE] pacing = %s, but this build uses %s "
+                   "(TOKEN_BUCKET_TX_ENABLED / BAG_SCHED_ENABLED)\n", val, build_pacing_name());
+            return -1;
+        }
+        return 0;
+    }
+
+    if (strcmp(key, "imix") == 0) {
+#if IMIX_ENABLED
+        unsigned long sizes[IMIX_PATTERN_SIZE];
+        if (tp_parse_list(val, IMIX_MIN_PACKET_SIZE, IMIX_MAX_PACKET_SIZE,
+                          sizes, IMIX_PATTERN_SIZE) != IMIX_PATTERN_SIZE) {
+            printf("[PROFILE] imix needs exactly %d sizes in [%d, %d]\n",
+                   IMIX_PATTERN_SIZE, IMIX_MIN_PACKET_SIZE, IMIX_MAX_PACKET_SIZE);
+            return -1;
+        }
+        for (int i = 0; i < IMIX_PATTERN_SIZE; i++)
+            g_tp.imix[i] = (uint16_t)sizes[i];
+        g_tp.imix_set = true;
+        return 0;
+#else
+        RTE_SET_USED(val);
+        printf("[PROFILE] imix given, but this build has IMIX_ENABLED=0\n");
+        return -1;
+#endif
+    }
+
+    return -1;
+}
+
+static int tp_port_key(struct tp_port *p, const char *key, char *val)
+{
+    if (strcmp(key, "rate_gbps") == 0) {
+        char *end;
+        errno = 0;
+        double v = strtod(val, &end);
+        if (errno != 0 || end == val || *tp_trim(end) != '\0' || !(v > 0.0) || v > 400.0)
+            return -1;
+        p->rate_gbps = v;
+        p->rate_set = true;
+        return 0;
+    }
+    if (strcmp(key, "tx_vlans") == 0) {
+        p->tx_vlans_set = true;
+        return tp_parse_u16_list(val, 1, 4094, p->tx_vlans, MAX_TX_VLANS_PER_PORT, &p->tx_vlan_count);
+    }
+    if (strcmp(key, "rx_vlans") == 0) {
+        p->rx_vlans_set = true;
+        return tp_parse_u16_list(val, 1, 4094, p->rx_vlans, MAX_RX_VLANS_PER_PORT, &p->rx_vlan_count);
+    }
+    // VL aralığı [start, start + VL_RANGE_SIZE_PER_QUEUE) 16 bit'e sığmalı
+    if (strcmp(key, "tx_vl_ids") == 0) {
+        p->tx_vl_ids_set = true;
+        return tp_parse_u16_list(val, 0, 0x10000 - VL_RANGE_SIZE_PER_QUEUE, p->tx_vl_ids,
+                                 MAX_TX_VLANS_PER_PORT, &p->tx_vl_count);
+    }
+    if (strcmp(key, "rx_vl_ids") == 0) {
+        p->rx_vl_ids_set = true;
+        return tp_parse_u16_list(val, 0, 0x10000 - VL_RANGE_SIZE_PER_QUEUE, p->rx_vl_ids,
+                                 MAX_RX_VLANS_PER_PORT, &p->rx_vl_count);
+    }
+    return -1;
+}
+
+static int tp_raw_key(struct tp_raw *r, const char *key, char *val)
+{
+    unsigned long f[5];
+
+    // Veri yolu ve arayüz her pacing modunda değiştirilebilir
+    if (strcmp(key, "backend") == 0) {
+        if (strcmp(val, "af_packet") == 0)
+            r->backend = RAW_BACKEND_AF_PACKET;
+        else if (strcmp(val, "af_xdp") == 0)
+            r->backend = RAW_BACKEND_AF_XDP;
+        else
+            return -1;
+        r->backend_set = true;
+        return 0;
+    }
+    if (strcmp(key, "tx_submit") == 0) {
+        if (strcmp(val, "ring") == 0)
+            r->tx_submit = RAW_TX_SUBMIT_RING;
+        else if (strcmp(val, "sendmmsg") == 0)
+            r->tx_submit = RAW_TX_SUBMIT_SENDMMSG;
+        else if (strcmp(val, "io_uring") == 0)
+            r->tx_submit = RAW_TX_SUBMIT_IO_URING;
+        else
+            return -1;
+        r->tx_submit_set = true;
+        return 0;
+    }
+    if (strcmp(key, "interface") == 0) {
+        if (val[0] == '\0' || strlen(val) >= sizeof(r->iface))
+            return -1;
+        strcpy(r->iface, val);
+        return 0;
+    }
+
+#if TOKEN_BUCKET_TX_ENABLED
+    // Token bucket raw VL düzeni (TB_PORT_*_VL_BLOCK_*) derleme zamanı sabiti
+    RTE_SET_USED(r);
+    RTE_SET_USED(key);
+    RTE_SET_USED(val);
+    RTE_SET_USED(f);
+    printf("[PROFILE] raw port targets are fixed in token bucket builds\n");
+    return -1;
+#else
+    if (strcmp(key, "target") == 0) {
+        if (!r->targets_set) {
+            r->targets_set = true;
+            r->target_count = 0;
+        }
+        if (r->target_count >= MAX_RAW_TARGETS ||
+            tp_parse_list(val, 0, 0xFFFF, f, 5) != 5 ||
+            f[2] == 0 || f[4] == 0 || f[3] + f[4] > 0x10000)
+            return -1;
+        struct raw_tx_target_config *t = &r->targets[r->target_count++];
+        t->target_id = (uint16_t)f[0];
+        t->dest_port = (uint16_t)f[1];
+        t->rate_mbps = (uint32_t)f[2];
+        t->vl_id_start = (uint16_t)f[3];
+        t->vl_id_count = (uint16_t)f[4];
+        return 0;
+    }
+    if (strcmp(key, "source") == 0) {
+        if (!r->sources_set) {
+            r->sources_set = true;
+            r->source_count = 0;
+        }
+        if (r->source_count >= MAX_RAW_TARGETS ||
+            tp_parse_list(val, 0, 0xFFFF, f, 3) != 3 ||
+            f[2] == 0 || f[1] + f[2] > 0x10000)
+            return -1;
+        struct raw_rx_source_config *s = &r->sources[r->source_count++];
+        s->source_port = (uint16_t)f[0];
+        s->vl_id_start = (uint16_t)f[1];
+        s->vl_id_count = (uint16_t)f[2];
+        return 0;
+    }
+    return -1;
+#endif
+}
+
+#if DPDK_EXT_TX_ENABLED
+static int tp_ext_key(struct tp_ext *e, const char *key, char *val)
+{
+    unsigned long f[5];
+
+    if (strcmp(key, "dest_port") == 0) {
+        if (tp_parse_uint(val, 0xFFFF, &f[0]) != 0)
+            return -1;
+        e->dest_port = (uint16_t)f[0];
+        e->dest_set = true;
+        return 0;
+    }
+    if (strcmp(key, "target") == 0) {
+#if TOKEN_BUCKET_TX_ENABLED
+        printf("[PROFILE] external TX targets are fixed in token bucket builds\n");
+        return -1;
+#else
+        if (!e->targets_set) {
+            e->targets_set = true;
+            e->target_count = 0;
+        }
+        if (e->target_count >= DPDK_EXT_TX_QUEUES_PER_PORT ||
+            tp_parse_list(val, 0, 0xFFFF, f, 5) != 5 ||
+            f[1] == 0 || f[1] > 4094 || f[3] == 0 || f[4] == 0 || f[2] + f[3] > 0x10000)
+            return -1;
+        struct dpdk_ext_tx_target *t = &e->targets[e->target_count++];
+        t->queue_id = (uint16_t)f[0];
+        t->vlan_id = (uint16_t)f[1];
+        t->vl_id_start = (uint16_t)f[2];
+        t->vl_id_count = (uint16_t)f[3];
+        t->rate_mbps = (uint32_t)f[4];
+        return 0;
+#endif
+    }
+    return -1;
+}
+#endif
+
+// "[port 2]" → bölüm türü + index; aynı port ikinci kez açılırsa devam edilir
+static int tp_open_section(const char *hdr, enum tp_section *sec, int *idx)
+{
+    char kind[16];
+    unsigned long id;
+    char tail;
+
+    if (sscanf(hdr, "%15s %lu %c", kind, &id, &tail) != 2 || id > 0xFFFF)
+        return -1;
+
+    if (strcmp(kind, "port") == 0) {
+        if (id >= MAX_PORTS_CONFIG)
+            return -1;
+        g_tp.port_used[id] = true;
+        *sec = TP_SEC_PORT;
+        *idx = (int)id;
+        return 0;
+    }
+
+    if (strcmp(kind, "raw") == 0) {
+        for (int i = 0; i < g_tp.raw_count; i++) {
+            if (g_tp.raw[i].port_id == id) {
+                *sec = TP_SEC_RAW;
+                *idx = i;
+                return 0;
+            }
+        }
+        if (g_tp.raw_count >= MAX_RAW_SOCKET_PORTS)
+            return -1;
+        g_tp.raw[g_tp.raw_count].port_id = (uint16_t)id;
+        *sec = TP_SEC_RAW;
+        *idx = g_tp.raw_count++;
+        return 0;
+    }
+
+#if DPDK_EXT_TX_ENABLED
+    if (strcmp(kind, "ext") == 0) {
+        // Ext port listesi sabit (lcore / queue 4 ataması), sadece hedefler değişir
+        bool known = false;
+        for (int i = 0; i < DPDK_EXT_TX_PORT_COUNT; i++)
+            known |= (dpdk_ext_tx_configs[i].port_id == id);
+        if (!known) {
+            printf("[PROFILE] port %lu is not an external TX port\n", id);
+            return -1;
+        }
+        for (int i = 0; i < g_tp.ext_count; i++) {
+            if (g_tp.ext[i].port_id == id) {
+                *sec = TP_SEC_EXT;
+                *idx = i;
+                return 0;
+            }
+        }
+        g_tp.ext[g_tp.ext_count].port_id = (uint16_t)id;
+        *sec = TP_SEC_EXT;
+        *idx = g_tp.ext_count++;
+        return 0;
+    }
+#endif
+
+    return -1;
+}
+
+// Bölüm içi tutarlılık (dosya sonunda, tüm satırlar okunduktan sonra)
+static int tp_validate(void)
+{
+    for (uint16_t p = 0; p < MAX_PORTS_CONFIG; p++) {
+        const struct tp_port *tp = &g_tp.port[p];
+        if (!g_tp.port_used[p])
+            continue;
+        if (tp->tx_vlans_set != tp->tx_vl_ids_set || tp->tx_vlan_count != tp->tx_vl_count) {
+            printf("[PROFILE] [port %u]: tx_vlans and tx_vl_ids must be given together, same length\n", p);
+            return -1;
+        }
+        if (tp->rx_vlans_set != tp->rx_vl_ids_set || tp->rx_vlan_count != tp->rx_vl_count) {
+            printf("[PROFILE] [port %u]: rx_vlans and rx_vl_ids must be given together, same length\n", p);
+            return -1;
+        }
+        if (tp->tx_vlans_set && tp->tx_vlan_count < NUM_TX_CORES) {
+            printf("[PROFILE] [port %u]: %u TX VLANs, need one per TX queue (%d)\n",
+                   p, tp->tx_vlan_count, NUM_TX_CORES);
+            return -1;
+        }
+        if (tp->rx_vlans_set && tp->rx_vlan_count < NUM_RX_CORES) {
+            printf("[PROFILE] [port %u]: %u RX VLANs, need one per RX queue (%d)\n",
+                   p, tp->rx_vlan_count, NUM_RX_CORES);
+            return -1;
+        }
+    }
+
+#if DPDK_EXT_TX_ENABLED
+    for (int i = 0; i < g_tp.ext_count; i++) {
+        const struct tp_ext *e = &g_tp.ext[i];
+        // Worker tek rate ile tüm hedefleri round-robin gezer, VL'ler art arda olmalı
+        for (int t = 1; t < e->target_count; t++) {
+            if (e->targets[t].vl_id_start != e->targets[t - 1].vl_id_start + e->targets[t - 1].vl_id_count) {
+                printf("[PROFILE] [ext %u]: target VL ranges must be contiguous\n", e->port_id);
+                return -1;
+            }
+        }
+    }
+#endif
+    return 0;
+}
+
+// ==========================================
+// LOAD
+// ==========================================
+
+// Dosyayı g_tp'ye oku ve doğrula (global tablolara dokunmaz)
+static int tp_parse_file(const char *path)
+{
+    memset(&g_tp, 0, sizeof(g_tp));
+
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        printf("[PROFILE] Cannot open %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    char line[TRAFFIC_PROFILE_MAX_LINE];
+    enum tp_section sec = TP_SEC_GLOBAL;
+    int idx = 0;
+    int lineno = 0;
+    int ret = 0;
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        lineno++;
+        if (strchr(line, '\n') == NULL && !feof(f)) {
+            printf("[PROFILE] %s:%d: line too long\n", path, lineno);
+            ret = -1;
+            break;
+        }
+
+        char *hash = strchr(line, '#');
+        if (hash != NULL)
+            *hash = '\0';
+        char *s = tp_trim(line);
+        if (*s == '\0')
+            continue;
+
+        if (*s == '[') {
+            char *close = strchr(s, ']');
+            if (close == NULL || *tp_trim(close + 1) != '\0') {
+                printf("[PROFILE] %s:%d: bad section header\n", path, lineno);
+                ret = -1;
+                break;
+            }
+            *close = '\0';
+            if (tp_open_section(tp_trim(s + 1), &sec, &idx) != 0) {
+                printf("[PROFILE] %s:%d: unknown section [%s]\n", path, lineno, tp_trim(s + 1));
+                ret = -1;
+                break;
+            }
+            continue;
+        }
+
+        char *eq = strchr(s, '=');
+        if (eq == NULL) {
+            printf("[PROFILE] %s:%d: expected key = value\n", path, lineno);
+            ret = -1;
+            break;
+        }
+        *eq = '\0';
+        char *key = tp_trim(s);
+        char *val = tp_trim(eq + 1);
+
+        int rc = -1;
+        switch (sec) {
+        case TP_SEC_GLOBAL: rc = tp_global_key(key, val); break;
+        case TP_SEC_PORT:   rc = tp_port_key(&g_tp.port[idx], key, val); break;
+        case TP_SEC_RAW:    rc = tp_raw_key(&g_tp.raw[idx], key, val); break;
+#if DPDK_EXT_TX_ENABLED
+        case TP_SEC_EXT:    rc = tp_ext_key(&g_tp.ext[idx], key, val); break;
+#else
+        case TP_SEC_EXT:    break;
+#endif
+        }
+        if (rc != 0) {
+            printf("[PROFILE] %s:%d: invalid '%s'\n", path, lineno, key);
+            ret = -1;
+            break;
+        }
+    }
+    fclose(f);
+
+    if (ret == 0)
+        ret = tp_validate();
+    if (ret != 0) {
+        memset(&g_tp, 0, sizeof(g_tp));
+        return -1;
+    }
+
+    g_tp.loaded = true;
+    snprintf(g_tp.path, sizeof(g_tp.path), "%s", path);
+    return 0;
+}
+
+int traffic_profile_load(const char *path)
+{
+    const bool explicit_path = (path != NULL);
+    if (path == NULL)
+        path = TRAFFIC_PROFILE_PATH;
+
+    if (!explicit_path && (path[0] == '\0' || access(path, R_OK) != 0)) {
+        memset(&g_tp, 0, sizeof(g_tp));
+        printf("[PROFILE] No traffic profile, using config.h defaults (pacing: %s)\n",
+               build_pacing_name());
+        return 0;
+    }
+
+    if (tp_parse_file(path) != 0)
+        return -1;
+
+#if IMIX_ENABLED
+    if (g_tp.imix_set) {
+        uint32_t sum = 0;
+        for (int i = 0; i < IMIX_PATTERN_SIZE; i++) {
+            imix_pattern[i] = g_tp.imix[i];
+            raw_imix_pattern[i] = (uint16_t)(g_tp.imix[i] - VLAN_HDR_SIZE);   // Raw: VLAN'sız
+            sum += g_tp.imix[i];
+        }
+        imix_avg_packet_size = sum / IMIX_PATTERN_SIZE;
+        raw_imix_avg_packet_size = imix_avg_packet_size - VLAN_HDR_SIZE;
+    }
+#endif
+
+    static const char *const mode_names[] = { "any", "normal", "ate" };
+    printf("[PROFILE] Loaded %s (mode: %s, pacing: %s, %u raw / %u ext sections)\n",
+           g_tp.path, mode_names[g_tp.mode], build_pacing_name(), g_tp.raw_count,
+#if DPDK_EXT_TX_ENABLED
+           g_tp.ext_count
+#else
+           0
+#endif
+    );
+#if IMIX_ENABLED
+    printf("[PROFILE] IMIX pattern:");
+    for (int i = 0; i < IMIX_PATTERN_SIZE; i++)
+        printf(" %u", imix_pattern[i]);
+    printf(" (avg=%u bytes)\n", imix_avg_packet_size);
+#endif
+    return 0;
+}
+
+const char *traffic_profile_path(void)
+{
+    return g_tp.loaded ? g_tp.path : NULL;
+}
+
+int traffic_profile_read_live(const char *path, bool ate_mode, struct traffic_profile_live *out)
+{
+    // Başlangıç profili (apply_raw vb. için) korunur, yeni dosya geçici okunur
+    static __typeof__(g_tp) saved;      // Büyük yapı, stack yerine (kontrol tarafı tek thread)
+    saved = g_tp;
+
+    memset(out, 0, sizeof(*out));
+    int ret = tp_parse_file(path);
+    if (ret == 0) {
+        const bool mode_ok = g_tp.mode == TP_MODE_ANY ||
+                             g_tp.mode == (ate_mode ? TP_MODE_ATE : TP_MODE_NORMAL);
+        for (uint16_t p = 0; mode_ok && p < MAX_PORTS_CONFIG; p++) {
+            const struct tp_port *tp = &g_tp.port[p];
+            if (!g_tp.port_used[p])
+                continue;
+            out->rate_set[p] = tp->rate_set;
+            out->rate_gbps[p] = tp->rate_gbps;
+            out->restart_needed |= tp->tx_vlans_set || tp->rx_vlans_set;
+        }
+        out->restart_needed |= (g_tp.raw_count != 0);
+#if DPDK_EXT_TX_ENABLED
+        out->restart_needed |= (g_tp.ext_count != 0);
+#endif
+        out->mode_mismatch = !mode_ok;
+        out->imix_set = g_tp.imix_set;
+        memcpy(out->imix, g_tp.imix, sizeof(out->imix));
+    }
+
+    g_tp = saved;
+    return ret;
+}
+
+void traffic_port_rate_update(uint16_t port_id, double rate_gbps)
+{
+    if (port_id >= MAX_PORTS_CONFIG || !port_rates_ready)
+        return;
+    port_rate_gbps[port_id] = rate_gbps;
+    port_rate_class[port_id] = "LIVE";
+}
+
+static bool tp_mode_matches(bool ate_mode)
+{
+    if (!g_tp.loaded)
+        return false;
+    if (g_tp.mode == TP_MODE_ANY || g_tp.mode == (ate_mode ? TP_MODE_ATE : TP_MODE_NORMAL))
+        return true;
+    printf("[PROFILE] Profile is for %s mode, running %s: port/raw/ext sections ignored\n",
+           g_tp.mode == TP_MODE_ATE ? "ATE" : "normal", ate_mode ? "ATE" : "normal");
+    return false;
+}
+
+// ==========================================
+// APPLY
+// ==========================================
+
+void traffic_profile_apply_ports(bool ate_mode)
+{
+    // Mod varsayılanı: ATE tüm portlarda FAST, normal modda port sınıfı
+    for (uint16_t p = 0; p < MAX_PORTS_CONFIG; p++) {
+        if (ate_mode) {
+            port_rate_gbps[p] = TARGET_GBPS_FAST;
+            port_rate_class[p] = "FAST";
+        } else {
+            port_rate_gbps[p] = GET_PORT_TARGET_GBPS(p);
+            port_rate_class[p] = IS_FAST_PORT(p) ? "FAST" : IS_MID_PORT(p) ? "MID" : "SLOW";
+        }
+    }
+    port_rates_ready = true;
+
+    if (!tp_mode_matches(ate_mode))
+        return;
+
+    for (uint16_t p = 0; p < MAX_PORTS_CONFIG; p++) {
+        const struct tp_port *tp = &g_tp.port[p];
+        struct port_vlan_config *pv = &port_vlans[p];
+        if (!g_tp.port_used[p])
+            continue;
+
+        if (tp->rate_set) {
+            port_rate_gbps[p] = tp->rate_gbps;
+            port_rate_class[p] = "PROFILE";
+        }
+        if (tp->tx_vlans_set) {
+            memcpy(pv->tx_vlans, tp->tx_vlans, tp->tx_vlan_count * sizeof(uint16_t));
+            memcpy(pv->tx_vl_ids, tp->tx_vl_ids, tp->tx_vlan_count * sizeof(uint16_t));
+            pv->tx_vlan_count = tp->tx_vlan_count;
+        }
+        if (tp->rx_vlans_set) {
+            memcpy(pv->rx_vlans, tp->rx_vlans, tp->rx_vlan_count * sizeof(uint16_t));
+            memcpy(pv->rx_vl_ids, tp->rx_vl_ids, tp->rx_vlan_count * sizeof(uint16_t));
+            pv->rx_vlan_count = tp->rx_vlan_count;
+        }
+        printf("[PROFILE] Port %2u: %.2f Gbps (%s), %u TX / %u RX VLANs\n",
+               p, port_rate_gbps[p], port_rate_class[p], pv->tx_vlan_count, pv->rx_vlan_count);
+    }
+
+#if DPDK_EXT_TX_ENABLED
+    for (int i = 0; i < g_tp.ext_count; i++) {
+        const struct tp_ext *e = &g_tp.ext[i];
+        for (int c = 0; c < DPDK_EXT_TX_PORT_COUNT; c++) {
+            struct dpdk_ext_tx_port_config *cfg = &dpdk_ext_tx_configs[c];
+            if (cfg->port_id != e->port_id)
+                continue;
+            if (e->dest_set)
+                cfg->dest_port = e->dest_port;
+            if (e->targets_set) {
+                memcpy(cfg->targets, e->targets, e->target_count * sizeof(e->targets[0]));
+                cfg->target_count = e->target_count;
+            }
+            printf("[PROFILE] Ext TX port %u -> %u: %u targets\n",
+                   cfg->port_id, cfg->dest_port, cfg->target_count);
+        }
+    }
+#endif
+}
+
+void traffic_profile_apply_raw(bool ate_mode)
+{
+    if (!tp_mode_matches(ate_mode))
+        return;
+
+    for (int i = 0; i < g_tp.raw_count; i++) {
+        const struct tp_raw *r = &g_tp.raw[i];
+        struct raw_socket_port_config *cfg = NULL;
+
+        for (int c = 0; c < active_raw_port_count; c++) {
+            if (raw_port_configs[c].port_id == r->port_id)
+                cfg = &raw_port_configs[c];
+        }
+        if (cfg == NULL) {
+            printf("[PROFILE] Raw port %u is not active in this mode, section ignored\n",
+                   r->port_id);
+            continue;
+        }
+        if (r->targets_set) {
+            memcpy(cfg->tx_targets, r->targets, r->target_count * sizeof(r->targets[0]));
+            cfg->tx_target_count = r->target_count;
+        }
+        if (r->sources_set) {
+            memcpy(cfg->rx_sources, r->sources, r->source_count * sizeof(r->sources[0]));
+            cfg->rx_source_count = r->source_count;
+        }
+        if (r->backend_set)
+            cfg->backend = r->backend;
+        if (r->tx_submit_set)
+            cfg->tx_submit = r->tx_submit;
+        if (r->iface[0] != '\0')
+            cfg->interface_name = r->iface;     // g_tp ömür boyu yaşar
+        printf("[PROFILE] Raw port %u: %u TX targets, %u RX sources, %s (TX %s) on %s\n",
+               cfg->port_id, cfg->tx_target_count, cfg->rx_source_count,
+               cfg->backend == RAW_BACKEND_AF_XDP ? "AF_XDP" : "AF_PACKET",
+               raw_tx_submit_name(cfg->tx_submit), cfg->interface_name);
+    }
+}
+
+// ==========================================
+// LOOKUP
+// ==========================================
+
+double traffic_port_rate_gbps(uint16_t port_id)
+{
+    if (port_id >= MAX_PORTS_CONFIG)
+        return TARGET_GBPS_SLOW;
+    if (!port_rates_ready)
+        return GET_PORT_TARGET_GBPS(port_id);
+    return port_rate_gbps[port_id];
+}
+
+const char *traffic_port_rate_class(uint16_t port_id)
+{
+    if (port_id >= MAX_PORTS_CONFIG || !port_rates_ready)
+        return IS_FAST_PORT(port_id) ? "FAST" : IS_MID_PORT(port_id) ? "MID" : "SLOW";
+    return port_rate_class[port_id];
+}
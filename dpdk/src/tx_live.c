@@ -0,0 +1,320 @@
+#include "tx_live.h"
+#include "packet.h"         // imix_pattern, imix_avg_packet_size, PACKET_SIZE
+
+#include <stdio.h>
+#include <errno.h>
+#include <string.h>
+#include <rte_cycles.h>
+#include <rte_malloc.h>
+#include <rte_spinlock.h>
+#include <rte_pause.h>
+
+// Kayıtlı slot'lar (yalnızca eklenir, process ömrü boyunca silinmez)
+static struct tx_live_slot *tx_live_slots[TX_LIVE_MAX_SLOTS];
+static uint32_t tx_live_nb_slots = 0;
+static rte_spinlock_t tx_live_reg_lock = RTE_SPINLOCK_INITIALIZER;
+
+// Kontrol tarafı tek thread'dir (main lcore); set_* çağrıları sıralı
+static uint16_t tx_live_imix_cur[IMIX_PATTERN_SIZE];
+static bool tx_live_imix_init = false;
+
+static inline uint32_t tx_live_slot_count(void)
+{
+    return __atomic_load_n(&tx_live_nb_slots, __ATOMIC_ACQUIRE);
+}
+
+static uint32_t tx_live_avg_size(const uint16_t *pattern)
+{
+#if IMIX_ENABLED
+    uint32_t sum = 0;
+    for (int i = 0; i < IMIX_PATTERN_SIZE; i++)
+        sum += pattern[i];
+    return sum / IMIX_PATTERN_SIZE;
+#else
+    RTE_SET_USED(pattern);
+    return PACKET_SIZE;
+#endif
+}
+
+// init_rate_limiter + tx_worker pacing ile aynı hesap: port rate'i queue'lara eşit bölünür
+static uint64_t tx_live_delay(double rate_gbps, uint32_t avg_bytes)
+{
+    const uint64_t tsc_hz = rte_get_tsc_hz();
+    const uint64_t bytes_per_sec = (uint64_t)(rate_gbps / (double)NUM_TX_CORES * 1000000000.0 / 8.0);
+    const uint64_t pps = bytes_per_sec / avg_bytes;
+    return pps > 0 ? tsc_hz / pps : tsc_hz;
+}
+
+static void tx_live_fill(struct tx_live_params *p, double rate_gbps, uint16_t vl_count,
+                         const uint16_t *imix)
+{
+    memcpy(p->imix, imix, sizeof(p->imix));
+    p->imix_avg = tx_live_avg_size(p->imix);
+    p->rate_gbps = rate_gbps;
+    p->vl_count = vl_count;
+    p->delay_cycles = tx_live_delay(rate_gbps, p->imix_avg);
+}
+
+struct tx_live_slot *tx_live_register(uint16_t port_id, uint16_t queue_id,
+                                      uint16_t vl_range, double rate_gbps, int socket_id)
+{
+    struct tx_live_slot *s = NULL;
+
+    if (vl_range == 0)
+        return NULL;
+
+    rte_spinlock_lock(&tx_live_reg_lock);
+
+    if (!tx_live_imix_init) {
+        memcpy(tx_live_imix_cur, imix_pattern, sizeof(tx_live_imix_cur));
+        tx_live_imix_init = true;
+    }
+
+    // Worker yeniden başlatıldıysa mevcut slot'u döndür (canlı değerler korunur)
+    for (uint32_t i = 0; i < tx_live_nb_slots; i++) {
+        struct tx_live_slot *e = tx_live_slots[i];
+        if (e->port_id == port_id && e->queue_id == queue_id && e->vl_range == vl_range) {
+            s = e;
+            goto out;
+        }
+    }
+
+    if (tx_live_nb_slots >= TX_LIVE_MAX_SLOTS) {
+        printf("Error: TX live slot registry full (%u slots)\n", TX_LIVE_MAX_SLOTS);
+        goto out;
+    }
+
+    s = rte_zmalloc_socket("tx_live_slot", sizeof(*s), RTE_CACHE_LINE_SIZE, socket_id);
+    if (s == NULL)
+        goto out;
+    s->cur = rte_zmalloc_socket("tx_live_params", sizeof(*s->cur), RTE_CACHE_LINE_SIZE, socket_id);
+    if (s->cur == NULL) {
+        rte_free(s);
+        s = NULL;
+        goto out;
+    }
+
+    tx_live_fill(s->cur, rate_gbps, vl_range, tx_live_imix_cur);
+    s->cur->gen = 1;
+    s->port_id = port_id;
+    s->queue_id = queue_id;
+    s->vl_range = vl_range;
+    s->socket_id = socket_id;
+
+    tx_live_slots[tx_live_nb_slots] = s;
+    __atomic_store_n(&tx_live_nb_slots, tx_live_nb_slots + 1, __ATOMIC_RELEASE);
+
+out:
+    rte_spinlock_unlock(&tx_live_reg_lock);
+    return s;
+}
+
+// ==========================================
+// PUBLISH (kontrol tarafı)
+// ==========================================
+
+// Onay geldiyse (veya worker durduysa) eski bloğu serbest bırak
+static bool tx_live_reclaim(struct tx_live_slot *s)
+{
+    if (s->retired == NULL)
+        return true;
+    // cur store'u (publish) running load'undan önce görünsün: tx_live_attach ile eşli
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&s->running, __ATOMIC_ACQUIRE) &&
+        __atomic_load_n(&s->seen_gen, __ATOMIC_ACQUIRE) < s->cur->gen)
+        return false;
+    rte_free(s->retired);
+    s->retired = NULL;
+    return true;
+}
+
+// Yeni blok (henüz yayınlanmamış), slot'un NUMA node'unda
+static struct tx_live_params *tx_live_prepare(const struct tx_live_slot *s, double rate_gbps,
+                                              uint16_t vl_count, const uint16_t *imix)
+{
+    struct tx_live_params *n = rte_zmalloc_socket("tx_live_params", sizeof(*n),
+                                                  RTE_CACHE_LINE_SIZE, s->socket_id);
+    if (n == NULL)
+        return NULL;
+
+    tx_live_fill(n, rate_gbps, vl_count, imix);
+    n->gen = s->cur->gen + 1;
+    return n;
+}
+
+// Slot'ta onay bekleyen blok olmamalı (tx_live_reclaim true dönmüş)
+static void tx_live_publish(struct tx_live_slot *s, struct tx_live_params *n)
+{
+    s->retired = s->cur;
+    __atomic_store_n(&s->cur, n, __ATOMIC_RELEASE);
+    s->changes++;
+}
+
+// Grace period: yayınlanan bloklar için worker onaylarını bekle
+static void tx_live_wait_grace(void)
+{
+    const uint64_t deadline = rte_get_tsc_cycles() + rte_get_tsc_hz() / 1000 * TX_LIVE_GRACE_MS;
+    const uint32_t n = tx_live_slot_count();
+    bool pending = true;
+
+    while (pending && rte_get_tsc_cycles() < deadline) {
+        pending = false;
+        for (uint32_t i = 0; i < n; i++)
+            pending |= !tx_live_reclaim(tx_live_slots[i]);
+        if (pending)
+            rte_pause();
+    }
+    if (pending)
+        printf("[LIVE] Warning: some TX workers have not switched yet, old blocks kept\n");
+}
+
+typedef bool (*tx_live_match_fn)(const struct tx_live_slot *s, uint16_t port_id);
+
+static bool tx_live_match_port(const struct tx_live_slot *s, uint16_t port_id)
+{
+    return s->port_id == port_id;
+}
+
+static bool tx_live_match_all(const struct tx_live_slot *s, uint16_t port_id)
+{
+    RTE_SET_USED(s);
+    RTE_SET_USED(port_id);
+    return true;
+}
+
+/**
+ * Eşleşen her slot için yeni blok: rate / VL sayısı / IMIX, negatif değer = değiştirme
+ * Hepsi ya da hiçbiri: bir queue önceki değişikliği henüz görmediyse veya blok
+ * ayrılamazsa hiçbir queue değişmez (port karışık rate'lerle kalmaz).
+ */
+static int tx_live_update(tx_live_match_fn match, uint16_t port_id, double rate_gbps,
+                          int vl_count, const uint16_t *imix)
+{
+    const uint32_t n = tx_live_slot_count();
+    struct tx_live_params *blk[TX_LIVE_MAX_SLOTS] = { NULL };
+    int matched = 0;
+    bool busy = false;
+
+    for (uint32_t i = 0; i < n; i++) {
+        struct tx_live_slot *s = tx_live_slots[i];
+        if (!match(s, port_id))
+            continue;
+        matched++;
+        if (!tx_live_reclaim(s)) {
+            printf("[LIVE] Port %u Queue %u: previous change not yet seen by worker\n",
+                   s->port_id, s->queue_id);
+            busy = true;
+        }
+    }
+    if (matched == 0)
+        return -ENOENT;
+    if (busy)
+        return -EBUSY;
+
+    // Önce tüm bloklar: yarıda ENOMEM ile kısmi değişiklik olmasın
+    for (uint32_t i = 0; i < n; i++) {
+        struct tx_live_slot *s = tx_live_slots[i];
+        if (!match(s, port_id))
+            continue;
+
+        const struct tx_live_params *c = s->cur;
+        const uint16_t vls = vl_count < 0 ? c->vl_count :
+                             (uint16_t)RTE_MIN((uint16_t)vl_count, s->vl_range);
+        blk[i] = tx_live_prepare(s, rate_gbps < 0.0 ? c->rate_gbps : rate_gbps, vls,
+                                 imix != NULL ? imix : c->imix);
+        if (blk[i] == NULL) {
+            printf("[LIVE] Port %u Queue %u: allocation failed\n", s->port_id, s->queue_id);
+            for (uint32_t j = 0; j < i; j++)
+                rte_free(blk[j]);
+            return -ENOMEM;
+        }
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+        if (blk[i] != NULL)
+            tx_live_publish(tx_live_slots[i], blk[i]);
+    }
+    tx_live_wait_grace();
+    return matched;
+}
+
+int tx_live_port_queues(uint16_t port_id)
+{
+    const uint32_t n = tx_live_slot_count();
+    int count = 0;
+
+    for (uint32_t i = 0; i < n; i++)
+        count += tx_live_slots[i]->port_id == port_id;
+    return count;
+}
+
+int tx_live_set_rate(uint16_t port_id, double rate_gbps)
+{
+#if TX_LIVE_ACTIVE
+    if (!(rate_gbps >= TX_LIVE_MIN_GBPS) || rate_gbps > TX_LIVE_MAX_GBPS)
+        return -EINVAL;
+    return tx_live_update(tx_live_match_port, port_id, rate_gbps, -1, NULL);
+#else
+    RTE_SET_USED(port_id);
+    RTE_SET_USED(rate_gbps);
+    return -ENOTSUP;
+#endif
+}
+
+int tx_live_set_vls(uint16_t port_id, uint16_t vl_count)
+{
+#if TX_LIVE_ACTIVE
+    if (vl_count == 0)
+        return -EINVAL;
+    return tx_live_update(tx_live_match_port, port_id, -1.0, vl_count, NULL);
+#else
+    RTE_SET_USED(port_id);
+    RTE_SET_USED(vl_count);
+    return -ENOTSUP;
+#endif
+}
+
+int tx_live_set_imix(const uint16_t *pattern)
+{
+#if TX_LIVE_ACTIVE && IMIX_ENABLED
+    for (int i = 0; i < IMIX_PATTERN_SIZE; i++) {
+        if (pattern[i] < IMIX_MIN_PACKET_SIZE || pattern[i] > IMIX_MAX_PACKET_SIZE)
+            return -EINVAL;
+    }
+    int ret = tx_live_update(tx_live_match_all, 0, -1.0, -1, pattern);
+    if (ret > 0)
+        memcpy(tx_live_imix_cur, pattern, sizeof(tx_live_imix_cur));
+    return ret;
+#else
+    RTE_SET_USED(pattern);
+    return -ENOTSUP;
+#endif
+}
+
+size_t tx_live_format_status(char *buf, size_t len)
+{
+    const uint32_t n = tx_live_slot_count();
+    const double tsc_hz = (double)rte_get_tsc_hz();
+    size_t off = 0;
+
+#define TX_LIVE_OUT(...) do { \
+        if (off < len) \
+            off += (size_t)snprintf(buf + off, len - off, __VA_ARGS__); \
+    } while (0)
+
+    TX_LIVE_OUT("%u TX slots%s\n", n, TX_LIVE_ACTIVE ? "" : " (live TX changes disabled in this build)");
+    for (uint32_t i = 0; i < n; i++) {
+        const struct tx_live_slot *s = tx_live_slots[i];
+        const struct tx_live_params *c = s->cur;
+        TX_LIVE_OUT(" Port %2u Q%u: gen %lu%s, %.3f Gbps/port, %.2f us/pkt, VLs %u/%u, "
+                    "IMIX avg %u B, %lu changes%s\n",
+                    s->port_id, s->queue_id, (unsigned long)c->gen,
+                    __atomic_load_n(&s->seen_gen, __ATOMIC_ACQUIRE) == c->gen ? "" : " (pending)",
+                    c->rate_gbps, (double)c->delay_cycles * 1e6 / tsc_hz,
+                    c->vl_count, s->vl_range, c->imix_avg, (unsigned long)s->changes,
+                    __atomic_load_n(&s->running, __ATOMIC_ACQUIRE) ? "" : ", stopped");
+    }
+#undef TX_LIVE_OUT
+
+    return off < len ? off : len - 1;
+}
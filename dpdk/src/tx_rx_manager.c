@@ -1,6 +1,11 @@
 #include "tx_rx_manager.h"
 #include "raw_socket_port.h"  // For external packet PRBS verification
 #include "dpdk_external_tx.h" // For integrated external TX
+#include "prbs_verify.h"      // SIMD PRBS compare + bit error count
+#include "flow_registry.h"    // VL-ID → kaynak port / PRBS akışı
+#include "bag_sched.h"        // AFDX BAG timer wheel (BAG_SCHED_ENABLED)
+#include "traffic_profile.h"  // Port rate tablosu (profil / config.h varsayılanı)
+#include "tx_live.h"          // Canlı rate / VL / IMIX (live_ctl)
 #include "embedded_latency/embedded_latency.h" // For ate_mode_enabled()
 #include <rte_lcore.h>
 #include <rte_launch.h>
@@ -32,13 +37,7 @@ void port_vlans_load_config(bool ate_mode)
     }
 }
 
-// Global RX statistics per port
-struct rx_stats rx_stats_per_port[MAX_PORTS];
-
 #if STATS_MODE_DTN
-// DTN port bazlı istatistikler
-struct dtn_port_stats dtn_stats[DTN_PORT_COUNT];
-
 // DTN port mapping tablosu
 struct dtn_port_map_entry dtn_port_map[DTN_PORT_COUNT] = DTN_PORT_MAP_INIT;
 
@@ -50,17 +49,9 @@ uint8_t vlan_to_dtn_port[DTN_VLAN_LOOKUP_SIZE];
 static struct rte_flow *dtn_flow_handles[MAX_PORTS][DTN_MAX_FLOW_RULES_PER_PORT] = {{NULL}};
 #endif /* STATS_MODE_DTN */
 
-// Global VL-ID sequence trackers per port (for RX validation)
-struct port_vl_tracker port_vl_trackers[MAX_PORTS];
-
-// Per-port, per-VL-ID TX sequence counter
-struct tx_vl_sequence
-{
-    uint64_t sequence[MAX_VL_ID + 1];    // Sequence counter for each VL-ID
-    rte_spinlock_t locks[MAX_VL_ID + 1]; // Lock per VL-ID
-};
+// RX VL-ID sequence tracker'ları queue'ya özeldir (rx_sequence.h)
 
-static struct tx_vl_sequence tx_vl_sequences[MAX_PORTS];
+// TX sequence'ları worker'a ait bloklarda tutulur (tx_sequence.h)
 
 // ==========================================
 // VL ID RANGE DEFINITIONS (Port-Aware)
@@ -73,61 +64,6 @@ static struct tx_vl_sequence tx_vl_sequences[MAX_PORTS];
 // HELPER FUNCTIONS - VL-ID BASED SEQUENCE
 // ==========================================
 
-/**
- * Initialize TX VL-ID sequences
- */
-static void init_tx_vl_sequences(void)
-{
-    for (int port = 0; port < MAX_PORTS; port++)
-    {
-        for (int vl = 0; vl <= MAX_VL_ID; vl++)
-        {
-            tx_vl_sequences[port].sequence[vl] = 0;
-            rte_spinlock_init(&tx_vl_sequences[port].locks[vl]);
-        }
-    }
-    printf("TX VL-ID sequence counters initialized\n");
-}
-
-/**
- * Get next sequence for a VL-ID (thread-safe)
- */
-static inline uint64_t get_next_tx_sequence(uint16_t port_id, uint16_t vl_id)
-{
-    if (vl_id > MAX_VL_ID || port_id >= MAX_PORTS)
-        return 0;
-
-    rte_spinlock_lock(&tx_vl_sequences[port_id].locks[vl_id]);
-    uint64_t seq = tx_vl_sequences[port_id].sequence[vl_id]++;
-    rte_spinlock_unlock(&tx_vl_sequences[port_id].locks[vl_id]);
-
-    return seq;
-}
-
-/**
- * Peek current sequence for a VL-ID without incrementing (thread-safe)
- * Use with commit_tx_sequence() for send-then-commit pattern.
- */
-static inline uint64_t peek_tx_sequence(uint16_t port_id, uint16_t vl_id)
-{
-    if (vl_id > MAX_VL_ID || port_id >= MAX_PORTS)
-        return 0;
-
-    return tx_vl_sequences[port_id].sequence[vl_id];
-}
-
-/**
- * Commit (increment) sequence for a VL-ID after successful send.
- * Only call after confirming the packet was actually transmitted.
- */
-static inline void commit_tx_sequence(uint16_t port_id, uint16_t vl_id)
-{
-    if (vl_id > MAX_VL_ID || port_id >= MAX_PORTS)
-        return;
-
-    tx_vl_sequences[port_id].sequence[vl_id]++;
-}
-
 /**
  * Extract VL-ID from packet DST MAC
  */
@@ -252,7 +188,7 @@ static void init_rate_limiter(struct rate_limiter *limiter,
     // Minimum bucket size to allow at least one burst
     // IMIX: Ortalama paket boyutu kullan
 #if IMIX_ENABLED
-    uint64_t min_bucket = BURST_SIZE * IMIX_AVG_PACKET_SIZE * 2;
+    uint64_t min_bucket = BURST_SIZE * imix_avg_packet_size * 2;
 #else
     uint64_t min_bucket = BURST_SIZE * PACKET_SIZE * 2;
 #endif
@@ -380,31 +316,97 @@ void init_vlan_config(void)
 
 void init_rx_stats(void)
 {
-    for (int i = 0; i < MAX_PORTS; i++)
+    // Worker shard'larına yazılmaz: mevcut değerler baseline olur
+    stats_reset();
+
+    // Queue'ya özel VL-ID tracker'ları: her worker bir sonraki burst'te sıfırlar
+    rx_seq_reset();
+#if INBAND_LATENCY_ENABLED
+    lat_reset();
+#endif
+#if RX_BAG_MONITOR_ENABLED
+    rx_bag_reset();
+#endif
+    printf("RX statistics and VL-ID sequence trackers initialized for all ports\n");
+}
+
+// ==========================================
+// RX SEQUENCE MERGE (stats lcore)
+// ==========================================
+
+void merge_rx_sequence_stats(bool final)
+{
+#if STATS_MODE_DTN
+    // DTN modu: her queue = 1 VLAN = 1 DTN port, VL aralıkları çakışmaz
+    struct rx_seq_totals dtn_tot[DTN_PORT_COUNT];
+    bool dtn_seen[DTN_PORT_COUNT] = {false};
+    memset(dtn_tot, 0, sizeof(dtn_tot));
+#endif
+
+    for (uint16_t port_id = 0; port_id < MAX_PORTS; port_id++)
     {
-        // Initialize atomic counters
-        rte_atomic64_init(&rx_stats_per_port[i].total_rx_pkts);
-        rte_atomic64_init(&rx_stats_per_port[i].good_pkts);
-        rte_atomic64_init(&rx_stats_per_port[i].bad_pkts);
-        rte_atomic64_init(&rx_stats_per_port[i].bit_errors);
-        rte_atomic64_init(&rx_stats_per_port[i].out_of_order_pkts);
-        rte_atomic64_init(&rx_stats_per_port[i].lost_pkts);
-        rte_atomic64_init(&rx_stats_per_port[i].duplicate_pkts);
-        rte_atomic64_init(&rx_stats_per_port[i].short_pkts);
-        rte_atomic64_init(&rx_stats_per_port[i].external_pkts);
-        // Raw socket RX counters (non-VLAN packets from raw socket ports)
-        rte_atomic64_init(&rx_stats_per_port[i].raw_socket_rx_pkts);
-        rte_atomic64_init(&rx_stats_per_port[i].raw_socket_rx_bytes);
-
-        // Initialize VL-ID sequence trackers (lock-free, watermark-based)
-        for (int vl = 0; vl <= MAX_VL_ID; vl++)
+        struct rx_seq_totals tot = {0};
+        uint32_t nq;
+
+#if STATS_MODE_DTN
+        nq = 0;
+        for (uint16_t q = 0; q < NUM_RX_CORES && q < port_vlans[port_id].rx_vlan_count; q++)
+        {
+            struct rx_seq_totals qt;
+            uint16_t vl_start = get_rx_vl_id_range_start(port_id, q);
+            uint16_t vl_end = get_rx_vl_id_range_end(port_id, q);
+
+            nq = rx_seq_merge(port_id, vl_start, vl_end, &qt);
+            if (nq == 0)
+                break;
+
+            tot.pkts += qt.pkts;
+            tot.lost += qt.lost;
+            tot.out_of_order += qt.out_of_order;
+            tot.duplicate += qt.duplicate;
+
+            uint16_t rx_vlan = port_vlans[port_id].rx_vlans[q];
+            uint8_t dtn = (rx_vlan < DTN_VLAN_LOOKUP_SIZE) ? vlan_to_dtn_port[rx_vlan]
+                                                           : DTN_VLAN_INVALID;
+            if (dtn < DTN_PORT_COUNT)
+            {
+                dtn_tot[dtn].lost += qt.lost;
+                dtn_tot[dtn].out_of_order += qt.out_of_order;
+                dtn_tot[dtn].duplicate += qt.duplicate;
+                dtn_seen[dtn] = true;
+            }
+
+            if (final && qt.lost > 0)
+            {
+                printf("RX Port %u Q%u (DTN %u): %lu lost packets (VL-ID %u-%u)\n",
+                       port_id, q, dtn != DTN_VLAN_INVALID ? dtn : 0xFF,
+                       qt.lost, vl_start, vl_end - 1);
+            }
+        }
+#else
+        nq = rx_seq_merge_all(port_id, &tot);
+#endif
+        if (nq == 0)
+            continue;
+
+        stats_publish_port_seq(port_id, tot.lost, tot.out_of_order, tot.duplicate);
+
+        if (final && (tot.lost || tot.out_of_order || tot.duplicate))
         {
-            port_vl_trackers[i].vl_trackers[vl].max_seq = 0;
-            port_vl_trackers[i].vl_trackers[vl].pkt_count = 0;
-            port_vl_trackers[i].vl_trackers[vl].initialized = 0;  // 0=false, 1=true
+            printf("RX Port %u: %lu lost, %lu out-of-order, %lu duplicate (watermark, %u queues)\n",
+                   port_id, tot.lost, tot.out_of_order, tot.duplicate, nq);
         }
     }
-    printf("RX statistics and VL-ID sequence trackers initialized for all ports\n");
+
+#if STATS_MODE_DTN
+    for (int d = 0; d < DTN_PORT_COUNT; d++)
+    {
+        if (!dtn_seen[d])
+            continue;
+        stats_publish_dtn_seq((uint16_t)d, dtn_tot[d].lost, dtn_tot[d].out_of_order,
+                              dtn_tot[d].duplicate);
+    }
+#endif
 }
 
 #if STATS_MODE_DTN
@@ -450,21 +452,6 @@ void init_dtn_port_map(void)
     printf("================================================\n\n");
 }
 
-void init_dtn_stats(void)
-{
-    for (int i = 0; i < DTN_PORT_COUNT; i++) {
-        rte_atomic64_init(&dtn_stats[i].good_pkts);
-        rte_atomic64_init(&dtn_stats[i].bad_pkts);
-        rte_atomic64_init(&dtn_stats[i].bit_errors);
-        rte_atomic64_init(&dtn_stats[i].lost_pkts);
-        rte_atomic64_init(&dtn_stats[i].out_of_order_pkts);
-        rte_atomic64_init(&dtn_stats[i].duplicate_pkts);
-        rte_atomic64_init(&dtn_stats[i].short_pkts);
-        rte_atomic64_init(&dtn_stats[i].total_rx_pkts);
-    }
-    printf("DTN port statistics initialized for %d ports\n", DTN_PORT_COUNT);
-}
-
 // ==========================================
 // DTN VLAN-BASED FLOW STEERING
 // ==========================================
@@ -572,6 +559,182 @@ void dtn_flow_rules_remove(uint16_t port_id)
 }
 #endif /* STATS_MODE_DTN */
 
+#if RAW_VL_FLOW_STEERING_ENABLED
+// ==========================================
+// RAW VL-ID FLOW STEERING
+// ==========================================
+// Raw portlardan gelen VLAN'sız paketler: VL aralığı → tek RX queue.
+// Böylece her VL'in tek yazarı olur, rx_seq merge'de reorder/kayıp kesinleşir.
+
+enum raw_vl_match {
+    RAW_VL_MATCH_ETH_DST = 0,   // DST MAC byte 4-5
+    RAW_VL_MATCH_IPV4_DST,      // DST IP 224.224.X.X byte 2-3
+    RAW_VL_MATCH_COUNT
+};
+
+static const char *const raw_vl_match_names[RAW_VL_MATCH_COUNT] = { "ETH dst", "IPv4 dst" };
+
+static struct rte_flow *raw_vl_flow_handles[MAX_PORTS][RAW_VL_FLOW_MAX_RULES_PER_PORT];
+static uint16_t raw_vl_flow_counts[MAX_PORTS];
+
+// Kural kurulumu sırasında VL-ID → queue (0xFF = bu porta gelen raw VL değil)
+static uint8_t raw_vl_queue_map[65536];
+
+// [base, base + ~mask] bloğunu queue'ya yönlendiren tek kural
+static struct rte_flow *raw_vl_flow_create(uint16_t port_id, enum raw_vl_match how,
+                                           uint16_t vl_base, uint16_t vl_mask,
+                                           uint16_t queue, struct rte_flow_error *error)
+{
+    struct rte_flow_attr attr;
+    struct rte_flow_item pattern[3];
+    struct rte_flow_action action[2];
+    struct rte_flow_action_queue queue_action = { .index = queue };
+    struct rte_flow_item_eth eth_spec, eth_mask;
+    struct rte_flow_item_ipv4 ip_spec, ip_mask;
+
+    memset(&attr, 0, sizeof(attr));
+    memset(pattern, 0, sizeof(pattern));
+    memset(action, 0, sizeof(action));
+    memset(&eth_spec, 0, sizeof(eth_spec));
+    memset(&eth_mask, 0, sizeof(eth_mask));
+    memset(&ip_spec, 0, sizeof(ip_spec));
+    memset(&ip_mask, 0, sizeof(ip_mask));
+
+    attr.ingress = 1;
+    attr.priority = 1;  // DTN VLAN kurallarıyla aynı, PTP'den düşük
+
+    action[0].type = RTE_FLOW_ACTION_TYPE_QUEUE;
+    action[0].conf = &queue_action;
+    action[1].type = RTE_FLOW_ACTION_TYPE_END;
+
+    pattern[0].type = RTE_FLOW_ITEM_TYPE_ETH;
+    if (how == RAW_VL_MATCH_ETH_DST) {
+        // Tip 0x0800: VLAN tag'li DPDK trafiği bu kurala girmez
+        eth_spec.dst.addr_bytes[4] = (uint8_t)(vl_base >> 8);
+        eth_spec.dst.addr_bytes[5] = (uint8_t)(vl_base & 0xFF);
+        eth_mask.dst.addr_bytes[4] = (uint8_t)(vl_mask >> 8);
+        eth_mask.dst.addr_bytes[5] = (uint8_t)(vl_mask & 0xFF);
+        eth_spec.type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+        eth_mask.type = 0xFFFF;
+        pattern[0].spec = &eth_spec;
+        pattern[0].mask = &eth_mask;
+        pattern[1].type = RTE_FLOW_ITEM_TYPE_END;
+    } else {
+        // ETH (tag'siz) → IPv4
+        eth_mask.has_vlan = 1;
+        pattern[0].spec = &eth_spec;
+        pattern[0].mask = &eth_mask;
+        ip_spec.hdr.dst_addr = rte_cpu_to_be_32((224u << 24) | (224u << 16) | vl_base);
+        ip_mask.hdr.dst_addr = rte_cpu_to_be_32(0xFFFF0000u | vl_mask);
+        pattern[1].type = RTE_FLOW_ITEM_TYPE_IPV4;
+        pattern[1].spec = &ip_spec;
+        pattern[1].mask = &ip_mask;
+        pattern[2].type = RTE_FLOW_ITEM_TYPE_END;
+    }
+
+    if (rte_flow_validate(port_id, &attr, pattern, action, error) != 0)
+        return NULL;
+    return rte_flow_create(port_id, &attr, pattern, action, error);
+}
+
+// raw_vl_queue_map'i hizalı 2^k bloklara bölüp kur; ilk hatada durur
+static int raw_vl_flow_install_blocks(uint16_t port_id, enum raw_vl_match how,
+                                      struct rte_flow_error *error)
+{
+    for (uint32_t v = 0; v < 65536;) {
+        const uint8_t q = raw_vl_queue_map[v];
+        if (q == 0xFF) {
+            v++;
+            continue;
+        }
+
+        // En büyük blok: v, 2*size'a hizalı ve ikinci yarı da aynı queue
+        uint32_t size = 1;
+        while ((v & (2 * size - 1)) == 0 && v + 2 * size <= 65536) {
+            uint32_t i = v + size;
+            while (i < v + 2 * size && raw_vl_queue_map[i] == q)
+                i++;
+            if (i < v + 2 * size)
+                break;
+            size *= 2;
+        }
+
+        if (raw_vl_flow_counts[port_id] >= RAW_VL_FLOW_MAX_RULES_PER_PORT) {
+            memset(error, 0, sizeof(*error));
+            error->message = "too many VL blocks (RAW_VL_FLOW_MAX_RULES_PER_PORT)";
+            return -1;
+        }
+        struct rte_flow *flow = raw_vl_flow_create(port_id, how, (uint16_t)v,
+                                                   (uint16_t)~(size - 1), q, error);
+        if (!flow)
+            return -1;
+        raw_vl_flow_handles[port_id][raw_vl_flow_counts[port_id]++] = flow;
+        v += size;
+    }
+    return 0;
+}
+
+int raw_vl_flow_rules_install(uint16_t port_id, uint16_t nb_queues)
+{
+    if (port_id >= MAX_PORTS || nb_queues < 2)
+        return 0;
+
+    raw_vl_flow_rules_remove(port_id);  // Yeniden başlatmada eski kurallar
+
+    // Bu porta gelen raw hedefleri: hedef sırası % queue → tüm VL aralığı o queue'da
+    memset(raw_vl_queue_map, 0xFF, sizeof(raw_vl_queue_map));
+    uint16_t slot = 0;
+
+    for (int r = 0; r < active_raw_port_count && r < MAX_RAW_SOCKET_PORTS; r++) {
+        const struct raw_socket_port_config *cfg = &raw_port_configs[r];
+        for (int t = 0; t < cfg->tx_target_count; t++) {
+            const struct raw_tx_target_config *tc = &cfg->tx_targets[t];
+            if (tc->dest_port != port_id || tc->vl_id_count == 0)
+                continue;
+            const uint8_t q = (uint8_t)(slot++ % nb_queues);
+            for (uint16_t i = 0; i < tc->vl_id_count; i++)
+                raw_vl_queue_map[flow_raw_target_vl(cfg->port_id, tc, i)] = q;
+            printf("  Raw Port %u target %d: VL-ID %u-%u (%u) → Queue %u\n",
+                   cfg->port_id, t, tc->vl_id_start,
+                   flow_raw_target_vl(cfg->port_id, tc, tc->vl_id_count - 1),
+                   tc->vl_id_count, q);
+        }
+    }
+    if (slot == 0)
+        return 0;
+
+    for (int how = 0; how < RAW_VL_MATCH_COUNT; how++) {
+        struct rte_flow_error error;
+        memset(&error, 0, sizeof(error));
+
+        if (raw_vl_flow_install_blocks(port_id, (enum raw_vl_match)how, &error) == 0) {
+            printf("Raw VL Flow: Port %u: %u rules installed (%s match)\n",
+                   port_id, raw_vl_flow_counts[port_id], raw_vl_match_names[how]);
+            return raw_vl_flow_counts[port_id];
+        }
+        printf("Raw VL Flow: Port %u %s match rejected: %s\n", port_id,
+               raw_vl_match_names[how], error.message ? error.message : "unknown");
+        raw_vl_flow_rules_remove(port_id);
+    }
+
+    printf("Warning: Raw VL flow steering unavailable on port %u, raw traffic stays on RSS\n",
+           port_id);
+    return -1;
+}
+
+void raw_vl_flow_rules_remove(uint16_t port_id)
+{
+    if (port_id >= MAX_PORTS) return;
+
+    for (uint16_t i = 0; i < raw_vl_flow_counts[port_id]; i++) {
+        struct rte_flow_error error;
+        rte_flow_destroy(port_id, raw_vl_flow_handles[port_id][i], &error);
+        raw_vl_flow_handles[port_id][i] = NULL;
+    }
+    raw_vl_flow_counts[port_id] = 0;
+}
+#endif /* RAW_VL_FLOW_STEERING_ENABLED */
+
 // ==========================================
 // VLAN CONFIGURATION FUNCTIONS
 // ==========================================
@@ -855,6 +1018,20 @@ int init_port_txrx(uint16_t port_id, struct txrx_config *config)
 #endif
 
     port_conf.txmode.mq_mode = RTE_ETH_MQ_TX_NONE;
+#if TX_ZEROCOPY_PRBS_ENABLED
+    // Zero-copy PRBS 2 segmentli mbuf gönderir; destek yoksa worker kopya yoluna düşer
+    if (dev_info.tx_offload_capa & RTE_ETH_TX_OFFLOAD_MULTI_SEGS)
+        port_conf.txmode.offloads |= RTE_ETH_TX_OFFLOAD_MULTI_SEGS;
+    else
+        printf("Port %u: MULTI_SEGS TX offload not supported, zero-copy PRBS disabled\n", port_id);
+#endif
+#if RX_BAG_MONITOR_ENABLED && RX_BAG_HW_TIMESTAMP
+    // RX BAG analizörü: NIC RX timestamp, yoksa burst TSC
+    if (dev_info.rx_offload_capa & RTE_ETH_RX_OFFLOAD_TIMESTAMP)
+        port_conf.rxmode.offloads |= RTE_ETH_RX_OFFLOAD_TIMESTAMP;
+    else
+        printf("Port %u: RX timestamp offload not supported, RX BAG analyzer uses TSC\n", port_id);
+#endif
 
     ret = rte_eth_dev_configure(
         port_id,
@@ -903,6 +1080,11 @@ int init_port_txrx(uint16_t port_id, struct txrx_config *config)
         return ret;
     }
 
+#if RX_BAG_MONITOR_ENABLED && RX_BAG_HW_TIMESTAMP
+    if (port_conf.rxmode.offloads & RTE_ETH_RX_OFFLOAD_TIMESTAMP)
+        rx_bag_hw_ts_setup(port_id);
+#endif
+
 #if STATS_MODE_DTN
     // DTN modu: VLAN-based flow steering kur (port start sonrası)
     if (config->nb_rx_queues > 1)
@@ -1070,10 +1252,213 @@ static void init_tx_test_counters(void)
            TX_WAIT_FOR_RX_FLUSH_MS);
 }
 
+// ==========================================
+// PER-LCORE TX PPS
+// ==========================================
+// Her TX worker kendi lcore slot'una yazar (tek yazıcı, cache-line ayrık).
+// NUM_TX_CORES boyutlandırması için lcore başına ulaşılan pps raporlanır.
+
+struct tx_lcore_stats tx_lcore_stats[RTE_MAX_LCORE];
+
+#define TX_LCORE_STATS_FLUSH 1024
+
+static inline void tx_lcore_stats_flush(struct tx_lcore_stats *ls,
+                                        uint64_t *local_pkts, uint64_t *local_bursts)
+{
+    ls->tx_pkts += *local_pkts;
+    ls->tx_bursts += *local_bursts;
+    *local_pkts = 0;
+    *local_bursts = 0;
+}
+
+void print_tx_lcore_stats(void)
+{
+    static uint64_t prev_pkts[RTE_MAX_LCORE];
+    static uint64_t prev_tsc = 0;
+
+    uint64_t now = rte_get_tsc_cycles();
+    uint64_t tsc_hz = rte_get_tsc_hz();
+    double interval_sec = prev_tsc ? (double)(now - prev_tsc) / (double)tsc_hz : 0.0;
+    prev_tsc = now;
+
+    printf("\n  TX Lcore Throughput (%s):\n",
+           TX_BURST_MODE_ENABLED ? "BURST" :
+           (TOKEN_BUCKET_TX_ENABLED ? "TOKEN BUCKET" : "SMOOTH"));
+    printf("  ┌───────┬──────┬───────┬────────────────┬────────────────┬────────────┐\n");
+    printf("  │ Lcore │ Port │ Queue │   pps (son)    │   pps (ort.)   │ pkts/burst │\n");
+    printf("  ├───────┼──────┼───────┼────────────────┼────────────────┼────────────┤\n");
+
+    for (unsigned lc = 0; lc < RTE_MAX_LCORE; lc++) {
+        struct tx_lcore_stats *ls = &tx_lcore_stats[lc];
+        if (!ls->active)
+            continue;
+
+        uint64_t pkts = ls->tx_pkts;
+        uint64_t bursts = ls->tx_bursts;
+        double pps_now = interval_sec > 0.0 ? (double)(pkts - prev_pkts[lc]) / interval_sec : 0.0;
+        double run_sec = (double)(now - ls->start_tsc) / (double)tsc_hz;
+        double pps_avg = run_sec > 0.0 ? (double)pkts / run_sec : 0.0;
+        double per_burst = bursts ? (double)pkts / (double)bursts : 0.0;
+        prev_pkts[lc] = pkts;
+
+        printf("  │ %5u │  %2u  │  %3u  │ %14.0f │ %14.0f │ %10.2f │\n",
+               lc, ls->port_id, ls->queue_id, pps_now, pps_avg, per_burst);
+    }
+    printf("  └───────┴──────┴───────┴────────────────┴────────────────┴────────────┘\n");
+}
+
+/**
+ * Tek TX paketini hazırla (smooth ve burst modu ortak)
+ * Worker başında render edilen VL template'i tek 64 byte kopya ile basılır,
+ * ardından [SEQ][PRBS] payload yazılır. TX_ZEROCOPY_PRBS_ENABLED iken PRBS
+ * kopyalanmaz, PRBS penceresine işaret eden ikinci segment olarak zincirlenir.
+ * INBAND_LATENCY_ENABLED iken SEQ'in arkasına tx_tsc yazılır (pacing'in zaten
+ * okuduğu TSC, paket başına ek rdtsc yok); PRBS o 8 byte kadar kaydırılır.
+ */
+static inline void tx_prepare_packet(struct rte_mbuf *pkt,
+                                     const struct hdr_template_set *tmpl_set,
+                                     struct prbs_zc_ctx *zc,
+                                     uint16_t curr_vl, uint64_t seq,
+                                     uint16_t pkt_size, uint64_t tx_tsc)
+{
+    const uint16_t prbs_len = (uint16_t)(pkt_size - tmpl_set->l2_len - IP_HDR_SIZE -
+                                         UDP_HDR_SIZE - SEQ_BYTES);
+
+    hdr_template_stamp(pkt, tmpl_set, hdr_template_get(tmpl_set, curr_vl), seq, pkt_size);
+#if TX_ZEROCOPY_PRBS_ENABLED
+    prbs_zc_attach_payload(zc, pkt, tmpl_set->l2_len, seq, prbs_len, INBAND_TS_BYTES);
+#else
+    fill_prbs_after_template(pkt, zc->win, tmpl_set->l2_len, seq, prbs_len);
+#endif
+#if INBAND_LATENCY_ENABLED
+    // Kopya yolunda TSC, PRBS'in ilk 8 byte'ının üzerine yazılır: kalan
+    // byte'lar (seq × MAX_PRBS_BYTES + 8) offset'inden devam eder, ZC ile aynı
+    uint8_t *ts_ptr = rte_pktmbuf_mtod_offset(pkt, uint8_t *, tmpl_set->l2_len + IP_HDR_SIZE +
+                                              UDP_HDR_SIZE + SEQ_BYTES);
+    memcpy(ts_ptr, &tx_tsc, INBAND_TS_BYTES);
+#else
+    RTE_SET_USED(tx_tsc);
+#endif
+}
+
+#if TX_BURST_MODE_ENABLED && TX_TEST_MODE_ENABLED
+#error "TX_TEST_MODE_ENABLED tek paket modunu gerektirir (TX_BURST_MODE_ENABLED=0)"
+#endif
+
+#if BAG_SCHED_ENABLED && (TX_TEST_MODE_ENABLED || TX_BURST_MODE_ENABLED)
+#error "BAG_SCHED_ENABLED kendi burst'ünü yapar; TX_TEST_MODE_ENABLED / TX_BURST_MODE_ENABLED ile kullanılamaz"
+#endif
+
+#if BAG_SCHED_ENABLED
+/**
+ * BAG scheduler TX döngüsü (smooth / burst pacing yerine)
+ * Zamanı gelen VL'ler wheel'den alınır ve TX_BURST_MAX_PKTS'e kadar tek
+ * burst'te gönderilir; her VL kendi Lmax boyutunda çıkar. Sequence yalnızca
+ * NIC'in kabul ettiği frame'ler için ilerler (burst modu ile aynı).
+ */
+static void tx_bag_loop(struct tx_worker_params *params, struct bag_sched *bs,
+                        const struct hdr_template_set *tmpl_set, struct prbs_zc_ctx *zc,
+                        struct tx_seq_block *seqb, struct tx_lcore_stats *lstats)
+{
+    struct rte_mbuf *pkts[TX_BURST_MAX_PKTS];
+    uint16_t due[TX_BURST_MAX_PKTS];
+    uint64_t local_tx_pkts = 0;
+    uint64_t local_tx_bursts = 0;
+    bool first_pkt_sent = false;
+
+    while (!(*params->stop_flag))
+    {
+        bag_sched_sync(bs);
+
+        const uint64_t now = rte_get_tsc_cycles();
+        const uint16_t nb_due = bag_sched_poll(bs, now, due, TX_BURST_MAX_PKTS);
+        if (nb_due == 0)
+        {
+            rte_pause();
+            continue;
+        }
+
+        // mbuf yoksa frame'ler kaçırılır, BAG fazı korunur
+        if (unlikely(rte_pktmbuf_alloc_bulk(params->mbuf_pool, pkts, nb_due) != 0))
+        {
+            bag_sched_commit(bs, due, nb_due, 0, now);
+            continue;
+        }
+
+        for (uint16_t i = 0; i < nb_due; i++)
+        {
+            const uint16_t idx = due[i];
+            tx_prepare_packet(pkts[i], tmpl_set, zc, (uint16_t)(bs->vl_start + idx),
+                              tx_seq_peek(seqb, idx), bag_sched_pkt_size(bs, idx), now);
+        }
+
+        uint16_t nb_tx = rte_eth_tx_burst(params->port_id, params->queue_id, pkts, nb_due);
+
+        if (unlikely(!first_pkt_sent && nb_tx > 0))
+        {
+            printf("TX Worker: First BAG burst sent on Port %u Queue %u (%u pkts)\n",
+                   params->port_id, params->queue_id, nb_tx);
+            first_pkt_sent = true;
+        }
+
+        for (uint16_t i = 0; i < nb_tx; i++)
+            tx_seq_commit(seqb, due[i]);
+        if (unlikely(nb_tx < nb_due))
+            rte_pktmbuf_free_bulk(&pkts[nb_tx], nb_due - nb_tx);
+
+        bag_sched_commit(bs, due, nb_due, nb_tx, now);
+
+        local_tx_pkts += nb_tx;
+        local_tx_bursts += (nb_tx > 0);
+        if (local_tx_pkts >= TX_LCORE_STATS_FLUSH)
+            tx_lcore_stats_flush(lstats, &local_tx_pkts, &local_tx_bursts);
+    }
+
+    tx_lcore_stats_flush(lstats, &local_tx_pkts, &local_tx_bursts);
+}
+#endif
+
+#if TX_BURST_MODE_ENABLED
+/**
+ * burst_cap: TX_BURST_MAX_PKTS, microburst byte sınırı ve aktif VL sayısı ile sınırlı.
+ * VL sınırı: bir burst içinde aynı VL-ID iki kez olmaz, böylece peek/commit
+ * sequence deseni burst içinde de geçerli kalır.
+ * window_cycles: en fazla (burst_cap - 1) slot bekle, fazlası tek burst'e sığmaz.
+ */
+static void tx_burst_limits(uint16_t vl_count, uint64_t delay_cycles, uint64_t tsc_hz,
+                            uint16_t *burst_cap, uint64_t *window_cycles)
+{
+#if IMIX_ENABLED
+    const uint64_t max_pkt_bytes = IMIX_MAX_PACKET_SIZE;
+#else
+    const uint64_t max_pkt_bytes = PACKET_SIZE;
+#endif
+    uint16_t cap = TX_BURST_MAX_PKTS;
+    if (TX_BURST_MAX_MICROBURST_BYTES / max_pkt_bytes < cap)
+        cap = (uint16_t)(TX_BURST_MAX_MICROBURST_BYTES / max_pkt_bytes);
+    if (vl_count < cap)
+        cap = vl_count;
+    if (cap == 0)
+        cap = 1;
+
+    uint64_t window = tsc_hz * TX_BURST_WINDOW_US / 1000000ULL;
+    if (window > (uint64_t)(cap - 1) * delay_cycles)
+        window = (uint64_t)(cap - 1) * delay_cycles;
+
+    *burst_cap = cap;
+    *window_cycles = window;
+}
+#endif
+
 int tx_worker(void *arg)
 {
     struct tx_worker_params *params = (struct tx_worker_params *)arg;
+#if TX_BURST_MODE_ENABLED
+    struct rte_mbuf *pkts[TX_BURST_MAX_PKTS];
+    uint16_t burst_vl_idx[TX_BURST_MAX_PKTS];
+#elif !BAG_SCHED_ENABLED
     struct rte_mbuf *pkt;  // Tek paket modu (burst yerine)
+#endif
     bool first_pkt_sent = false;
 
 #if VLAN_ENABLED
@@ -1094,6 +1479,14 @@ int tx_worker(void *arg)
         return -1;
     }
 
+    struct tx_seq_block *seqb = params->seq_block;
+    if (seqb == NULL)
+    {
+        printf("Error: No TX sequence block for Port %u Queue %u\n",
+               params->port_id, params->queue_id);
+        return -1;
+    }
+
     // PORT-AWARE: Her port için config'deki tx_vl_ids değerlerini kullan
     const uint16_t vl_start = get_tx_vl_id_range_start(params->port_id, params->queue_id);
 #if TOKEN_BUCKET_TX_ENABLED
@@ -1110,6 +1503,30 @@ int tx_worker(void *arg)
     uint64_t imix_counter = 0;  // Paket sayacı (IMIX pattern için)
 #endif
 
+    // ==========================================
+    // HEADER TEMPLATES: VL aralığındaki her VL-ID için hazır header
+    // ==========================================
+    struct hdr_template_set tmpl_set;
+    if (hdr_template_set_alloc(&tmpl_set, vl_start, vl_range_size, l2_len,
+                               PACKET_SIZE, rte_socket_id()) != 0)
+    {
+        printf("Error: Header templates unavailable for Port %u Queue %u\n",
+               params->port_id, params->queue_id);
+        return -1;
+    }
+    hdr_template_set_render(&tmpl_set, &params->pkt_config);
+
+    // PRBS kaynağı: zero-copy kapalıyken sadece pencere kullanılır (kopya yolu)
+    struct prbs_zc_ctx zc = { .win = &port_prbs_cache[params->port_id].win };
+#if TX_ZEROCOPY_PRBS_ENABLED
+    if (prbs_zc_init(&zc, params->port_id, params->queue_id,
+                     &port_prbs_cache[params->port_id].win, rte_socket_id()) != 0)
+    {
+        hdr_template_set_free(&tmpl_set);
+        return -1;
+    }
+#endif
+
     // ==========================================
     // PACING SETUP
     // ==========================================
@@ -1124,7 +1541,7 @@ int tx_worker(void *arg)
     // Rate hesaplama: limiter.tokens_per_sec zaten bytes/sec
     // IMIX: Ortalama paket boyutu kullanarak packets_per_sec hesapla
 #if IMIX_ENABLED
-    const uint64_t avg_bytes_per_packet = IMIX_AVG_PACKET_SIZE;
+    const uint64_t avg_bytes_per_packet = imix_avg_packet_size;
 #else
     const uint64_t avg_bytes_per_packet = PACKET_SIZE;
 #endif
@@ -1132,6 +1549,32 @@ int tx_worker(void *arg)
     uint64_t delay_cycles = (packets_per_sec > 0) ? (tsc_hz / packets_per_sec) : tsc_hz;
 #endif
 
+    // Aktif VL sayısı ve IMIX tablosu: canlı değişebilir (live_ctl), aksi halde sabit
+#if TX_LIVE_ACTIVE
+    struct tx_live_slot *live = params->live;
+    const struct tx_live_params *live_p = NULL;
+    uint16_t vl_active = vl_range_size;
+#if IMIX_ENABLED
+    const uint16_t *imix_tbl = imix_pattern;
+#endif
+    if (live != NULL)
+    {
+        // Slot daha önce değiştirildiyse (worker restart) son canlı değerlerle başla
+        live_p = tx_live_attach(live);
+        delay_cycles = live_p->delay_cycles;
+        packets_per_sec = tsc_hz / delay_cycles;
+        vl_active = live_p->vl_count;
+#if IMIX_ENABLED
+        imix_tbl = live_p->imix;
+#endif
+    }
+#else
+    const uint16_t vl_active = vl_range_size;
+#if IMIX_ENABLED
+    const uint16_t *imix_tbl = imix_pattern;
+#endif
+#endif
+
     // Mikrosaniye cinsinden paket arası süre
     double inter_packet_us = (double)delay_cycles * 1000000.0 / (double)tsc_hz;
 
@@ -1154,11 +1597,13 @@ int tx_worker(void *arg)
 
     printf("TX Worker started: Port %u, Queue %u, Lcore %u, VLAN %u, VL_RANGE [%u..%u)\n",
            params->port_id, params->queue_id, params->lcore_id, params->vlan_id, vl_start, vl_end);
-#if TOKEN_BUCKET_TX_ENABLED
+#if BAG_SCHED_ENABLED
+    // BAG profili ve wheel özeti scheduler kurulunca basılır
+#elif TOKEN_BUCKET_TX_ENABLED
     printf("  *** TOKEN BUCKET MODE - %u VL-IDX, 1ms window ***\n", vl_range_size);
 #elif IMIX_ENABLED
     printf("  *** IMIX MODE ENABLED - Variable packet sizes ***\n");
-    printf("  -> IMIX pattern: 100, 200, 400, 800, 1200x3, 1518x3 (avg=%lu bytes)\n", avg_bytes_per_packet);
+    printf("  -> IMIX pattern: %d entries (avg=%lu bytes)\n", IMIX_PATTERN_SIZE, avg_bytes_per_packet);
     printf("  -> Worker offset: %u (hybrid shuffle)\n", imix_offset);
 #else
     printf("  *** SMOOTH PACING - 1 saniyeye yayılmış trafik ***\n");
@@ -1166,7 +1611,34 @@ int tx_worker(void *arg)
     printf("  -> Pacing: %.1f us/paket (%.0f paket/s), stagger=%ums\n",
            inter_packet_us, (double)packets_per_sec, (unsigned)(stagger_offset * 1000 / tsc_hz));
     printf("  VL-ID Based Sequence: Each VL-ID has independent sequence counter\n");
-    printf("  Strategy: Round-robin through ALL VL-IDs in range (%u VL-IDs)\n", vl_range_size);
+#if !BAG_SCHED_ENABLED
+    printf("  Strategy: Round-robin through active VL-IDs in range (%u/%u VL-IDs)\n",
+           vl_active, vl_range_size);
+#endif
+
+#if TX_BURST_MODE_ENABLED
+    // ==========================================
+    // BURST SETUP
+    // ==========================================
+    uint16_t burst_cap;
+    uint64_t window_cycles;
+    tx_burst_limits(vl_active, delay_cycles, tsc_hz, &burst_cap, &window_cycles);
+
+    printf("  *** BURST TX - window=%.1f us, max %u pkt/burst (~%.1f pkt/burst beklenen) ***\n",
+           (double)window_cycles * 1000000.0 / (double)tsc_hz, burst_cap,
+           (double)(window_cycles / delay_cycles) + 1.0);
+#endif
+
+    // Per-lcore pps sayaçları
+    struct tx_lcore_stats *lstats = &tx_lcore_stats[rte_lcore_id()];
+    lstats->port_id = params->port_id;
+    lstats->queue_id = params->queue_id;
+    lstats->tx_pkts = 0;
+    lstats->tx_bursts = 0;
+    lstats->start_tsc = rte_get_tsc_cycles();
+    lstats->active = true;
+    uint64_t local_tx_pkts = 0;
+    uint64_t local_tx_bursts = 0;
 
 #if TX_TEST_MODE_ENABLED
     printf("  TEST MODE: Skipping every %d-th packet, max %d packets per port\n",
@@ -1179,8 +1651,136 @@ int tx_worker(void *arg)
     // Local packet counter for this worker
     uint64_t local_pkt_counter = 0;
 
+#if BAG_SCHED_ENABLED
+    // ==========================================
+    // BAG SCHEDULER: VL başına BAG / Lmax / jitter (round-robin yerine)
+    // Profilde olmayan VL'lerin BAG'i = mevcut round-robin periyodu
+    // ==========================================
+    struct bag_sched *bs = bag_sched_create(params->port_id, params->queue_id, vl_start,
+                                            vl_range_size, delay_cycles * vl_range_size,
+                                            (int)rte_socket_id());
+    if (bs == NULL)
+    {
+        printf("Error: Cannot create BAG scheduler for Port %u Queue %u\n",
+               params->port_id, params->queue_id);
+        lstats->active = false;
+#if TX_ZEROCOPY_PRBS_ENABLED
+        prbs_zc_free(&zc);
+#endif
+        hdr_template_set_free(&tmpl_set);
+        return -1;
+    }
+    bag_sched_print_config(bs);
+    bag_sched_start(bs, next_send_time);
+    tx_bag_loop(params, bs, &tmpl_set, &zc, seqb, lstats);
+    RTE_SET_USED(current_vl_offset);
+    RTE_SET_USED(local_pkt_counter);
+    RTE_SET_USED(first_pkt_sent);
+    RTE_SET_USED(vl_active);
+#if IMIX_ENABLED
+    RTE_SET_USED(imix_counter);
+    RTE_SET_USED(imix_offset);
+    RTE_SET_USED(imix_tbl);
+#endif
+#else
     while (!(*params->stop_flag))
     {
+#if TX_LIVE_ACTIVE
+        // Yeni parametre bloğu yayınlandıysa geç (döngü başına tek pointer karşılaştırma).
+        // Sequence bloğu ve next_send_time korunur: zamanlanmış slot eski periyotla
+        // çıkar, sonrakiler yeni periyotla.
+        if (live != NULL && unlikely(tx_live_sync(live, &live_p)))
+        {
+            delay_cycles = live_p->delay_cycles;
+            vl_active = live_p->vl_count;
+            if (current_vl_offset >= vl_active)
+                current_vl_offset = 0;
+#if IMIX_ENABLED
+            imix_tbl = live_p->imix;
+#endif
+#if TX_BURST_MODE_ENABLED
+            tx_burst_limits(vl_active, delay_cycles, tsc_hz, &burst_cap, &window_cycles);
+#endif
+        }
+#endif
+#if TX_BURST_MODE_ENABLED
+        // ==========================================
+        // BURST PACING: Pencere dolana kadar bekle, zamanı gelen slotları topla
+        // Paket slot zamanından önce çıkmaz, en fazla window_cycles geç çıkar
+        // ==========================================
+        const uint64_t gather_until = next_send_time + window_cycles;
+        uint64_t now = rte_get_tsc_cycles();
+
+        while (now < gather_until) {
+            rte_pause();
+            now = rte_get_tsc_cycles();
+        }
+
+        uint64_t slots_due = (now - next_send_time) / delay_cycles + 1;
+        uint16_t nb_pkts;
+
+        if (likely(slots_due <= burst_cap)) {
+            nb_pkts = (uint16_t)slots_due;
+            next_send_time += slots_due * delay_cycles;
+        } else {
+#if TOKEN_BUCKET_TX_ENABLED
+            // Geride kalırsak PHASE-PRESERVING SKIP: fazla slotlar atlanır,
+            // worker'lar arası phase offset korunur
+            next_send_time += slots_due * delay_cycles;
+#else
+            // Geride kalırsak CATCH-UP YAPMA: birikmiş slotlar atlanır
+            next_send_time = now + delay_cycles;
+#endif
+            nb_pkts = burst_cap;  // Microburst üst sınırı
+        }
+
+        // Toplu tahsis - BAŞARISIZ OLURSA BİLE TIMING KORUNUR
+        if (unlikely(rte_pktmbuf_alloc_bulk(params->mbuf_pool, pkts, nb_pkts) != 0)) {
+            continue;
+        }
+
+        for (uint16_t i = 0; i < nb_pkts; i++) {
+            uint16_t curr_vl = vl_start + current_vl_offset;
+#if IMIX_ENABLED
+            uint16_t pkt_size = get_imix_packet_size_from(imix_tbl, imix_counter, imix_offset);
+            imix_counter++;
+#else
+            const uint16_t pkt_size = PACKET_SIZE;
+#endif
+            // Peek sequence WITHOUT incrementing — burst_cap <= vl_active
+            // olduğundan bir burst içinde aynı VL-ID tekrar etmez
+            uint64_t seq = tx_seq_peek(seqb, current_vl_offset);
+            // Burst'teki tüm paketler gather sonu TSC'sini taşır
+            tx_prepare_packet(pkts[i], &tmpl_set, &zc, curr_vl, seq, pkt_size, now);
+            burst_vl_idx[i] = current_vl_offset;
+
+            current_vl_offset++;
+            if (current_vl_offset >= vl_active)
+                current_vl_offset = 0;
+        }
+
+        uint16_t nb_tx = rte_eth_tx_burst(params->port_id, params->queue_id, pkts, nb_pkts);
+
+        if (unlikely(!first_pkt_sent && nb_tx > 0))
+        {
+            printf("TX Worker: First burst sent on Port %u Queue %u (%u pkts)\n",
+                   params->port_id, params->queue_id, nb_tx);
+            first_pkt_sent = true;
+        }
+
+        // Sequence'ı sadece gönderilen paketler için artır (NIC sırayla kabul eder)
+        for (uint16_t i = 0; i < nb_tx; i++)
+            tx_seq_commit(seqb, burst_vl_idx[i]);
+
+        // TX queue dolu — gönderilemeyenleri at, sequence'ları tekrar kullanılacak
+        if (unlikely(nb_tx < nb_pkts))
+            rte_pktmbuf_free_bulk(&pkts[nb_tx], nb_pkts - nb_tx);
+
+        local_tx_pkts += nb_tx;
+        local_tx_bursts += (nb_tx > 0);
+        if (local_tx_pkts >= TX_LCORE_STATS_FLUSH)
+            tx_lcore_stats_flush(lstats, &local_tx_pkts, &local_tx_bursts);
+#else
 #if TX_TEST_MODE_ENABLED
         // Check if port reached max packet limit
         uint64_t current_port_count = rte_atomic64_read(&tx_packet_count_per_port[params->port_id]);
@@ -1252,51 +1852,34 @@ int tx_worker(void *arg)
         if (pkt_num % TX_SKIP_EVERY_N_PACKETS == 0)
         {
             // Test mode: intentional skip — consume sequence to create gap
-            uint64_t skip_seq = get_next_tx_sequence(params->port_id, curr_vl);
+            uint64_t skip_seq = tx_seq_next(seqb, current_vl_offset);
             printf("TX Worker Port %u: SKIPPING packet #%lu (VL %u, seq %lu)\n",
                    params->port_id, pkt_num, curr_vl, skip_seq);
             rte_pktmbuf_free(pkt);
             current_vl_offset++;
-            if (current_vl_offset >= vl_range_size)
+            if (current_vl_offset >= vl_active)
                 current_vl_offset = 0;
             continue;
         }
 
         // Peek sequence WITHOUT incrementing — only commit after successful send
-        uint64_t seq = peek_tx_sequence(params->port_id, curr_vl);
+        uint64_t seq = tx_seq_peek(seqb, current_vl_offset);
 #else
         uint16_t curr_vl = vl_start + current_vl_offset;
 
         // Peek sequence WITHOUT incrementing — only commit after successful send
-        uint64_t seq = peek_tx_sequence(params->port_id, curr_vl);
+        uint64_t seq = tx_seq_peek(seqb, current_vl_offset);
 #endif
 
         // Paket oluştur
-        struct packet_config cfg = params->pkt_config;
-        cfg.vl_id = curr_vl;
-        cfg.dst_mac.addr_bytes[0] = 0x03;
-        cfg.dst_mac.addr_bytes[1] = 0x00;
-        cfg.dst_mac.addr_bytes[2] = 0x00;
-        cfg.dst_mac.addr_bytes[3] = 0x00;
-        cfg.dst_mac.addr_bytes[4] = (uint8_t)((curr_vl >> 8) & 0xFF);
-        cfg.dst_mac.addr_bytes[5] = (uint8_t)(curr_vl & 0xFF);
-        cfg.dst_ip = (uint32_t)((224U << 24) | (224U << 16) |
-                                ((uint32_t)((curr_vl >> 8) & 0xFF) << 8) |
-                                (uint32_t)(curr_vl & 0xFF));
-
 #if IMIX_ENABLED
         // IMIX: Paket boyutunu pattern'den al
-        uint16_t pkt_size = get_imix_packet_size(imix_counter, imix_offset);
-        uint16_t prbs_len = calc_prbs_size(pkt_size);
+        uint16_t pkt_size = get_imix_packet_size_from(imix_tbl, imix_counter, imix_offset);
         imix_counter++;
-
-        // Dinamik boyutlu paket oluştur
-        build_packet_dynamic(pkt, &cfg, pkt_size);
-        fill_payload_with_prbs31_dynamic(pkt, params->port_id, seq, l2_len, prbs_len);
 #else
-        build_packet_mbuf(pkt, &cfg);
-        fill_payload_with_prbs31(pkt, params->port_id, seq, l2_len);
+        const uint16_t pkt_size = PACKET_SIZE;
 #endif
+        tx_prepare_packet(pkt, &tmpl_set, &zc, curr_vl, seq, pkt_size, now);
 
         // Tek paket gönder
         uint16_t nb_tx = rte_eth_tx_burst(params->port_id, params->queue_id, &pkt, 1);
@@ -1311,7 +1894,11 @@ int tx_worker(void *arg)
         if (likely(nb_tx > 0))
         {
             // Sequence'ı sadece paket başarıyla gönderildikten sonra artır
-            commit_tx_sequence(params->port_id, curr_vl);
+            tx_seq_commit(seqb, current_vl_offset);
+            local_tx_pkts++;
+            local_tx_bursts++;
+            if (local_tx_pkts >= TX_LCORE_STATS_FLUSH)
+                tx_lcore_stats_flush(lstats, &local_tx_pkts, &local_tx_bursts);
         }
         else
         {
@@ -1321,9 +1908,35 @@ int tx_worker(void *arg)
         }
 
         current_vl_offset++;
-        if (current_vl_offset >= vl_range_size)
+        if (current_vl_offset >= vl_active)
             current_vl_offset = 0;
+#endif /* TX_BURST_MODE_ENABLED */
     }
+#endif /* BAG_SCHED_ENABLED */
+
+#if TX_LIVE_ACTIVE
+    if (live != NULL)
+        tx_live_detach(live);
+#endif
+
+    // Final flush + lcore başına ortalama pps
+    tx_lcore_stats_flush(lstats, &local_tx_pkts, &local_tx_bursts);
+    {
+        double run_sec = (double)(rte_get_tsc_cycles() - lstats->start_tsc) / (double)tsc_hz;
+        printf("TX Worker Port %u Queue %u Lcore %u: %lu pkts, avg %.0f pps, %.2f pkts/burst\n",
+               params->port_id, params->queue_id, params->lcore_id,
+               (unsigned long)lstats->tx_pkts,
+               run_sec > 0.0 ? (double)lstats->tx_pkts / run_sec : 0.0,
+               lstats->tx_bursts ? (double)lstats->tx_pkts / (double)lstats->tx_bursts : 0.0);
+    }
+    lstats->active = false;
+#if TX_ZEROCOPY_PRBS_ENABLED
+    printf("TX Worker Port %u Queue %u: %lu zero-copy, %lu copy-fallback packets\n",
+           params->port_id, params->queue_id,
+           (unsigned long)zc.zc_pkts, (unsigned long)zc.copy_pkts);
+    prbs_zc_free(&zc);
+#endif
+    hdr_template_set_free(&tmpl_set);
 
 #if TX_TEST_MODE_ENABLED
     printf("TX Worker stopped: Port %u, Queue %u (sent %lu packets locally, port total: %lu)\n",
@@ -1339,54 +1952,6 @@ int tx_worker(void *arg)
 // RX WORKER - VL-ID BASED SEQUENCE VALIDATION
 // ==========================================
 
-/**
- * Check if VL-ID is within valid TX range for source port (any queue)
- * This is used to detect external packets - if VL-ID doesn't match
- * what the source port would send, it's from an external source.
- */
-static inline bool is_valid_tx_vl_id_for_source_port(uint16_t vl_id, uint16_t src_port_id)
-{
-    if (src_port_id >= MAX_PORTS_CONFIG)
-        return false;
-
-    // Check all TX queues for source port
-    uint16_t queue_count = port_vlans[src_port_id].tx_vlan_count;
-    for (uint16_t q = 0; q < queue_count; q++)
-    {
-        uint16_t start = port_vlans[src_port_id].tx_vl_ids[q];
-        uint16_t end = start + VL_RANGE_SIZE_PER_QUEUE;
-        if (vl_id >= start && vl_id < end)
-            return true;
-    }
-    return false;
-}
-
-/**
- * Find raw socket port that sent this VL-ID (for external packet PRBS verification)
- * Returns pointer to raw_socket_port if found, NULL otherwise
- */
-static inline struct raw_socket_port* find_raw_socket_port_by_vl_id(uint16_t vl_id)
-{
-    for (int p = 0; p < MAX_RAW_SOCKET_PORTS; p++)
-    {
-        struct raw_socket_port *port = &raw_ports[p];
-        if (!port->prbs_initialized)
-            continue;
-
-        // Check all TX targets of this raw socket port
-        for (int t = 0; t < port->tx_target_count; t++)
-        {
-            struct raw_tx_target_config *target = &port->config.tx_targets[t];
-            if (vl_id >= target->vl_id_start &&
-                vl_id < target->vl_id_start + target->vl_id_count)
-            {
-                return port;
-            }
-        }
-    }
-    return NULL;
-}
-
 int rx_worker(void *arg)
 {
     struct rx_worker_params *params = (struct rx_worker_params *)arg;
@@ -1413,38 +1978,54 @@ int rx_worker(void *arg)
         return -1;
     }
 
-    uint8_t *prbs_cache_ext = port_prbs_cache[params->src_port_id].cache_ext;
-    if (!prbs_cache_ext)
+    if (params->seq_queue == NULL || params->stats == NULL)
     {
-        printf("Error: PRBS cache_ext is NULL\n");
+        printf("Error: No RX sequence trackers / stats shard for port %u queue %u\n",
+               params->port_id, params->queue_id);
         return -1;
     }
 
+    const struct prbs_window *prbs_win = &port_prbs_cache[params->src_port_id].win;
+    const bool prbs_lfsr = prbs_verify_port_uses_lfsr(params->port_id);
+
     printf("RX Worker: Port %u, Queue %u, VLAN %u (VL-ID Based Sequence Validation)\n",
            params->port_id, params->queue_id, params->vlan_id);
-    printf("  Source Port: %u (for PRBS verification)\n", params->src_port_id);
+    printf("  Source Port: %u (for PRBS verification, %s engine)\n", params->src_port_id,
+           prbs_lfsr ? "LFSR" : "cache");
     printf("  Dynamic L2 detection: VLAN (0x8100)->%u bytes, Non-VLAN (0x0800)->%u bytes\n",
            l2_len_vlan, l2_len_novlan);
 
-    uint64_t local_rx = 0, local_good = 0, local_bad = 0, local_bits = 0;
-    uint64_t local_lost = 0, local_ooo = 0, local_dup = 0, local_short = 0;
-    uint64_t local_external = 0;  // External packets (VL-ID outside expected range)
-    uint64_t local_raw_rx = 0, local_raw_bytes = 0;  // Raw socket packet counters
-    const uint32_t FLUSH = 131072;
-
-#if STATS_MODE_DTN
-    // DTN modunda: queue_id → VLAN → DTN port (1:1 mapping, flow steering aktif)
-    const uint16_t rx_vlan_for_queue = port_vlans[params->port_id].rx_vlans[params->queue_id];
-    const uint8_t my_dtn_port = (rx_vlan_for_queue < DTN_VLAN_LOOKUP_SIZE)
-                                    ? vlan_to_dtn_port[rx_vlan_for_queue]
-                                    : DTN_VLAN_INVALID;
-#endif
+    // Yerel sayaçlar burst sonunda bu queue'nun shard'ına yayınlanır
+    // (external_pkts: VL-ID kaynak aralığı dışı, raw_*: non-VLAN raw socket paketleri)
+    struct stats_counters lc = {0};
+    // DTN modunda shard, queue → VLAN → DTN port eşlemesini taşır (start_txrx_workers)
+    struct stats_shard *stats = params->stats;
 
     bool first_good = false, first_bad = false;
     bool first_raw_rx = false;  // Track first raw socket packet
 
-    // Get VL-ID tracker for this port
-    struct port_vl_tracker *vl_tracker = &port_vl_trackers[params->port_id];
+    // Bu queue'ya özel VL-ID sequence tracker'ları (tek yazar: bu worker)
+    struct rx_seq_queue *seq_q = params->seq_queue;
+
+#if INBAND_LATENCY_ENABLED
+    struct lat_queue *lat_q = params->lat_queue;
+    if (lat_q == NULL)
+    {
+        printf("Error: No latency histograms for port %u queue %u\n",
+               params->port_id, params->queue_id);
+        return -1;
+    }
+#endif
+
+#if RX_BAG_MONITOR_ENABLED
+    struct rx_bag_queue *bag_q = params->bag_queue;
+    if (bag_q == NULL)
+    {
+        printf("Error: No RX BAG analyzer for port %u queue %u\n",
+               params->port_id, params->queue_id);
+        return -1;
+    }
+#endif
 
     const uint16_t INNER_LOOPS = 8;
 
@@ -1458,13 +2039,25 @@ int rx_worker(void *arg)
             if (unlikely(nb_rx == 0))
                 continue;
 
+            rx_seq_queue_sync(seq_q);
+#if INBAND_LATENCY_ENABLED || RX_BAG_MONITOR_ENABLED
+            // Burst başına tek TSC: paket başı rdtsc yerine (burst içi bekleme dahil)
+            const uint64_t rx_tsc = rte_rdtsc();
+#endif
+#if INBAND_LATENCY_ENABLED
+            lat_queue_sync(lat_q);
+#endif
+#if RX_BAG_MONITOR_ENABLED
+            rx_bag_queue_sync(bag_q);
+#endif
+
             if (unlikely(!first_packet_received))
             {
                 printf("RX: First packet on Port %u Queue %u\n", params->port_id, params->queue_id);
                 first_packet_received = true;
             }
 
-            local_rx += nb_rx;
+            lc.pkts += nb_rx;
 
             // Aggressive prefetch
             for (uint16_t i = 0; i + 7 < nb_rx; i++)
@@ -1515,8 +2108,8 @@ int rx_worker(void *arg)
                     // NON-VLAN PACKET (from raw socket Port 12/13)
                     // PRBS validation using raw socket port's cache
                     // ==========================================
-                    local_raw_rx++;
-                    local_raw_bytes += m->pkt_len;
+                    lc.raw_pkts++;
+                    lc.raw_bytes += m->pkt_len;
 
                     if (unlikely(!first_raw_rx))
                     {
@@ -1534,7 +2127,7 @@ int rx_worker(void *arg)
 #endif
                     if (unlikely(m->pkt_len < min_raw_pkt_len))
                     {
-                        local_short++;
+                        lc.short_pkts++;
                         continue;
                     }
 
@@ -1545,9 +2138,14 @@ int rx_worker(void *arg)
                     // DST MAC format: 03:00:00:00:XX:XX where XX:XX = VL-ID
                     uint16_t raw_vl_id = ((uint16_t)pkt[4] << 8) | pkt[5];
 
-                    // Find raw socket port that sent this packet
-                    struct raw_socket_port *raw_port = find_raw_socket_port_by_vl_id(raw_vl_id);
-                    if (raw_port != NULL && raw_port->prbs_cache_ext != NULL)
+                    // Flow registry: hangi raw socket portu gönderdi (TB blok düzeni dahil)
+                    const uint16_t raw_vl_idx = vl_map_index(raw_vl_id);
+                    const struct flow_entry *raw_flow = flow_at(raw_vl_idx);
+#if RX_BAG_MONITOR_ENABLED
+                    if (likely(raw_vl_idx < bag_q->vl_count))
+                        rx_bag_rx(bag_q, raw_vl_idx, m, rx_tsc);
+#endif
+                    if (raw_flow->kind == FLOW_SRC_RAW && raw_flow->prbs != NULL)
                     {
                         // Get sequence number from payload
                         uint64_t raw_seq = *(uint64_t *)(pkt + raw_payload_off);
@@ -1558,102 +2156,49 @@ int rx_worker(void *arg)
                         uint16_t raw_prbs_len = m->pkt_len - l2_len_novlan - 20 - 8 - RAW_PKT_SEQ_BYTES;
                         if (raw_prbs_len > MAX_PRBS_BYTES) raw_prbs_len = MAX_PRBS_BYTES;
 
-                        uint64_t prbs_offset = (raw_seq * (uint64_t)MAX_PRBS_BYTES) % 268435456ULL;
-                        uint8_t *expected_prbs = raw_port->prbs_cache_ext + prbs_offset;
+                        uint64_t prbs_offset = (raw_seq * (uint64_t)raw_flow->prbs_step) % 268435456ULL;
                         uint8_t *recv_prbs = pkt + raw_payload_off + RAW_PKT_SEQ_BYTES;
 
                         // Compare PRBS data (dinamik boyut)
-                        if (memcmp(recv_prbs, expected_prbs, raw_prbs_len) == 0)
+                        uint32_t prbs_bit_errors = prbs_window_verify(raw_flow->prbs, prbs_offset,
+                                                                      recv_prbs, raw_prbs_len, prbs_lfsr);
+                        if (likely(prbs_bit_errors == 0))
                         {
-                            local_good++;
+                            lc.good_pkts++;
                         }
                         else
                         {
-                            local_bad++;
-                            // Count bit errors
-                            for (uint32_t b = 0; b < raw_prbs_len; b++)
-                            {
-                                local_bits += __builtin_popcount(recv_prbs[b] ^ expected_prbs[b]);
-                            }
+                            lc.bad_pkts++;
+                            lc.bit_errors += prbs_bit_errors;
                         }
 #else
                         // Calculate PRBS offset (same formula as raw_socket_port.c)
                         // RAW_PRBS_CACHE_SIZE = 268435456 (256MB)
-                        uint64_t prbs_offset = (raw_seq * (uint64_t)RAW_PKT_PRBS_BYTES) % 268435456ULL;
-                        uint8_t *expected_prbs = raw_port->prbs_cache_ext + prbs_offset;
+                        uint64_t prbs_offset = (raw_seq * (uint64_t)raw_flow->prbs_step) % 268435456ULL;
                         uint8_t *recv_prbs = pkt + raw_payload_off + RAW_PKT_SEQ_BYTES;
 
                         // Compare PRBS data
-                        if (memcmp(recv_prbs, expected_prbs, RAW_PKT_PRBS_BYTES) == 0)
+                        uint32_t prbs_bit_errors = prbs_window_verify(raw_flow->prbs, prbs_offset,
+                                                                      recv_prbs, raw_flow->prbs_len, prbs_lfsr);
+                        if (likely(prbs_bit_errors == 0))
                         {
-                            local_good++;
+                            lc.good_pkts++;
                         }
                         else
                         {
-                            local_bad++;
-                            // Count bit errors
-                            for (uint32_t b = 0; b < RAW_PKT_PRBS_BYTES; b++)
-                            {
-                                local_bits += __builtin_popcount(recv_prbs[b] ^ expected_prbs[b]);
-                            }
+                            lc.bad_pkts++;
+                            lc.bit_errors += prbs_bit_errors;
                         }
 #endif
 
                         // Sequence tracking for raw socket packets
-                        if (raw_vl_id <= MAX_VL_ID)
+                        // Multi-queue NOT: Raw socket paketler VLAN tag'sız gelir; raw VL
+                        // flow kuralları (RAW_VL_FLOW_STEERING_ENABLED) her VL'i tek queue'ya
+                        // sabitler. Kural kurulamadıysa RSS dağıtır, kayıp tespiti yine
+                        // merge'de tüm queue'lar üzerinden watermark ile yapılır.
+                        if (likely(raw_vl_idx < seq_q->vl_count))
                         {
-                            struct vl_sequence_tracker *raw_seq_tracker = &vl_tracker->vl_trackers[raw_vl_id];
-
-                            // Check if initialized
-                            int was_init = __atomic_load_n(&raw_seq_tracker->initialized, __ATOMIC_ACQUIRE);
-                            if (!was_init)
-                            {
-                                int expected_init = 0;
-                                if (__atomic_compare_exchange_n(&raw_seq_tracker->initialized,
-                                                                &expected_init, 1,
-                                                                false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
-                                {
-#if TOKEN_BUCKET_TX_ENABLED
-                                    __atomic_store_n(&raw_seq_tracker->min_seq, raw_seq, __ATOMIC_RELEASE);
-#endif
-                                    __atomic_store_n(&raw_seq_tracker->expected_seq, raw_seq + 1, __ATOMIC_RELEASE);
-                                }
-                            }
-                            else
-                            {
-#if TOKEN_BUCKET_TX_ENABLED
-                                // Multi-queue NOT: Raw socket paketler VLAN tag'sız geldiği için
-                                // NIC RSS onları farklı RX queue'lara dağıtabilir. Bu durumda
-                                // Q1 daha yüksek seq'i Q0'dan önce işleyebilir → false positive gap.
-                                // Bu yüzden real-time gap detection KULLANILMAZ.
-                                // Kayıp tespiti watermark-based (max_seq+1 - pkt_count) ile yapılır
-#else
-                                // Real-time gap detection
-                                uint64_t expected = __atomic_load_n(&raw_seq_tracker->expected_seq, __ATOMIC_ACQUIRE);
-                                if (raw_seq > expected)
-                                {
-                                    local_lost += (raw_seq - expected);
-                                }
-                                if (raw_seq >= expected)
-                                {
-                                    __atomic_store_n(&raw_seq_tracker->expected_seq, raw_seq + 1, __ATOMIC_RELEASE);
-                                }
-#endif
-                            }
-
-                            // Update max_seq if this sequence is higher
-                            uint64_t current_max;
-                            do {
-                                current_max = __atomic_load_n(&raw_seq_tracker->max_seq, __ATOMIC_ACQUIRE);
-                                if (raw_seq <= current_max) {
-                                    break;
-                                }
-                            } while (!__atomic_compare_exchange_n(&raw_seq_tracker->max_seq,
-                                                                   &current_max, raw_seq,
-                                                                   false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST));
-
-                            // Increment packet count
-                            __atomic_fetch_add(&raw_seq_tracker->pkt_count, 1, __ATOMIC_RELAXED);
+                            rx_seq_update(seq_q, raw_vl_idx, raw_seq);
                         }
                     }
                     continue;  // Done with raw socket packet
@@ -1669,7 +2214,7 @@ int rx_worker(void *arg)
                 if (unlikely(m->pkt_len < min_len_vlan))
 #endif
                 {
-                    local_short++;
+                    lc.short_pkts++;
                     continue;
                 }
 
@@ -1678,19 +2223,26 @@ int rx_worker(void *arg)
 
                 //  Extract VL-ID from DST MAC (last 2 bytes)
                 uint16_t vl_id = extract_vl_id_from_packet(pkt, l2_len_vlan);
+                const uint16_t vl_idx = vl_map_index(vl_id);
+                const struct flow_entry *flow = flow_at(vl_idx);
+
+#if RX_BAG_MONITOR_ENABLED
+                // Inter-arrival: kaynağından bağımsız (DPDK, external, raw) her VL
+                if (likely(vl_idx < bag_q->vl_count))
+                    rx_bag_rx(bag_q, vl_idx, m, rx_tsc);
+#endif
 
                 // ==========================================
                 // VL-ID RANGE CHECK - External packet detection
                 // If VL-ID doesn't match what the source port (paired DPDK port)
                 // would send, it's from an external source (1G/100M lines)
                 // ==========================================
-                if (!is_valid_tx_vl_id_for_source_port(vl_id, params->src_port_id))
+                if (!flow_is_dpdk_src(flow, params->src_port_id))
                 {
-                    local_external++;
+                    lc.external_pkts++;
 
-                    // Try to find the raw socket port that sent this packet
-                    struct raw_socket_port *raw_port = find_raw_socket_port_by_vl_id(vl_id);
-                    if (raw_port != NULL && raw_port->prbs_cache_ext != NULL)
+                    // Raw socket portundan geldiyse onun PRBS akışıyla doğrula
+                    if (flow->kind == FLOW_SRC_RAW && flow->prbs != NULL)
                     {
                         // Get sequence number from payload
                         uint64_t ext_seq = *(uint64_t *)(pkt + payload_off);
@@ -1701,111 +2253,55 @@ int rx_worker(void *arg)
                         uint16_t ext_prbs_len = m->pkt_len - l2_len_vlan - 20 - 8 - SEQ_BYTES;
                         if (ext_prbs_len > MAX_PRBS_BYTES) ext_prbs_len = MAX_PRBS_BYTES;
 
-                        uint64_t prbs_offset = (ext_seq * (uint64_t)MAX_PRBS_BYTES) % 268435456ULL;
-                        uint8_t *expected_prbs = raw_port->prbs_cache_ext + prbs_offset;
+                        uint64_t prbs_offset = (ext_seq * (uint64_t)flow->prbs_step) % 268435456ULL;
                         uint8_t *recv_prbs = pkt + payload_off + SEQ_BYTES;
 
                         // Compare PRBS data (dinamik boyut)
-                        if (memcmp(recv_prbs, expected_prbs, ext_prbs_len) == 0)
+                        uint32_t prbs_bit_errors = prbs_window_verify(flow->prbs, prbs_offset,
+                                                                      recv_prbs, ext_prbs_len, prbs_lfsr);
+                        if (likely(prbs_bit_errors == 0))
                         {
-                            local_good++;
+                            lc.good_pkts++;
                         }
                         else
                         {
-                            local_bad++;
-                            // Count bit errors
-                            for (uint32_t i = 0; i < ext_prbs_len; i++)
-                            {
-                                local_bits += __builtin_popcount(recv_prbs[i] ^ expected_prbs[i]);
-                            }
+                            lc.bad_pkts++;
+                            lc.bit_errors += prbs_bit_errors;
                         }
 #else
                         // Calculate PRBS offset (same formula as raw_socket_port.c)
                         // RAW_PRBS_CACHE_SIZE = 268435456 (256MB)
-                        uint64_t prbs_offset = (ext_seq * (uint64_t)RAW_PKT_PRBS_BYTES) % 268435456ULL;
-                        uint8_t *expected_prbs = raw_port->prbs_cache_ext + prbs_offset;
+                        uint64_t prbs_offset = (ext_seq * (uint64_t)flow->prbs_step) % 268435456ULL;
                         uint8_t *recv_prbs = pkt + payload_off + SEQ_BYTES;
 
                         // Compare PRBS data (use smaller size for comparison)
                         // RAW_PKT_PRBS_BYTES = 1459, NUM_PRBS_BYTES may differ
-                        uint32_t cmp_len = RAW_PKT_PRBS_BYTES;
+                        uint32_t cmp_len = flow->prbs_len;
                         if (cmp_len > NUM_PRBS_BYTES) cmp_len = NUM_PRBS_BYTES;
 
-                        if (memcmp(recv_prbs, expected_prbs, cmp_len) == 0)
+                        uint32_t prbs_bit_errors = prbs_window_verify(flow->prbs, prbs_offset,
+                                                                      recv_prbs, cmp_len, prbs_lfsr);
+                        if (likely(prbs_bit_errors == 0))
                         {
-                            local_good++;
+                            lc.good_pkts++;
                         }
                         else
                         {
-                            local_bad++;
-                            // Count bit errors
-                            for (uint32_t i = 0; i < cmp_len; i++)
-                            {
-                                local_bits += __builtin_popcount(recv_prbs[i] ^ expected_prbs[i]);
-                            }
+                            lc.bad_pkts++;
+                            lc.bit_errors += prbs_bit_errors;
                         }
 #endif
 
                         // ==========================================
                         // SEQUENCE TRACKING FOR EXTERNAL PACKETS
-                        // Real-time gap detection + watermark tracking
+                        // Queue'ya özel tracker, kayıp/reorder merge'de hesaplanır
                         // ==========================================
-                        if (vl_id <= MAX_VL_ID)
+                        if (likely(vl_idx < seq_q->vl_count))
                         {
-                            struct vl_sequence_tracker *ext_seq_tracker = &vl_tracker->vl_trackers[vl_id];
-
-                            // Check if initialized
-                            int was_init = __atomic_load_n(&ext_seq_tracker->initialized, __ATOMIC_ACQUIRE);
-                            if (!was_init)
-                            {
-                                int expected_init = 0;
-                                if (__atomic_compare_exchange_n(&ext_seq_tracker->initialized,
-                                                                &expected_init, 1,
-                                                                false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
-                                {
-#if TOKEN_BUCKET_TX_ENABLED
-                                    __atomic_store_n(&ext_seq_tracker->min_seq, ext_seq, __ATOMIC_RELEASE);
-#endif
-                                    __atomic_store_n(&ext_seq_tracker->expected_seq, ext_seq + 1, __ATOMIC_RELEASE);
-                                }
-                            }
-                            else
-                            {
-#if TOKEN_BUCKET_TX_ENABLED
-                                // Multi-queue NOT: External/raw socket paketler VLAN tag'sız
-                                // geldiği için NIC RSS onları farklı RX queue'lara dağıtabilir.
-                                // Gap detection (expected_seq) multi-queue OOO'da false positive verir.
-                                // Kayıp tespiti watermark-based (max_seq+1 - pkt_count) ile yapılır.
-#else
-                                // Real-time gap detection
-                                uint64_t expected = __atomic_load_n(&ext_seq_tracker->expected_seq, __ATOMIC_ACQUIRE);
-                                if (ext_seq > expected)
-                                {
-                                    local_lost += (ext_seq - expected);
-                                }
-                                if (ext_seq >= expected)
-                                {
-                                    __atomic_store_n(&ext_seq_tracker->expected_seq, ext_seq + 1, __ATOMIC_RELEASE);
-                                }
-#endif
-                            }
-
-                            // Update max_seq if this sequence is higher (CAS loop)
-                            uint64_t current_max;
-                            do {
-                                current_max = __atomic_load_n(&ext_seq_tracker->max_seq, __ATOMIC_ACQUIRE);
-                                if (ext_seq <= current_max) {
-                                    break;  // Not higher, no update needed
-                                }
-                            } while (!__atomic_compare_exchange_n(&ext_seq_tracker->max_seq,
-                                                                   &current_max, ext_seq,
-                                                                   false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST));
-
-                            // Increment packet count
-                            __atomic_fetch_add(&ext_seq_tracker->pkt_count, 1, __ATOMIC_RELAXED);
+                            rx_seq_update(seq_q, vl_idx, ext_seq);
                         }
                     }
-                    // If raw_port not found, just count as external (no PRBS check)
+                    // Raw kaynak değilse (DPDK ext / bilinmiyor), just count as external (no PRBS check)
 
                     continue;  // Skip internal PRBS validation
                 }
@@ -1815,68 +2311,33 @@ int rx_worker(void *arg)
 
                 // ==========================================
                 // VL-ID BASED SEQUENCE TRACKING
-                // Real-time gap detection + watermark tracking
+                // Queue'ya özel tracker (atomic RMW yok), watermark merge stats lcore'da
                 // ==========================================
-                if (vl_id <= MAX_VL_ID)
+                if (likely(vl_idx < seq_q->vl_count))
                 {
-                    struct vl_sequence_tracker *seq_tracker = &vl_tracker->vl_trackers[vl_id];
-
-                    // Check if initialized
-                    int was_init = __atomic_load_n(&seq_tracker->initialized, __ATOMIC_ACQUIRE);
-                    if (!was_init)
-                    {
-                        // First packet for this VL-ID
-                        int expected_init = 0;
-                        if (__atomic_compare_exchange_n(&seq_tracker->initialized,
-                                                        &expected_init, 1,
-                                                        false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
-                        {
-                            // We won the race - initialize expected_seq
 #if TOKEN_BUCKET_TX_ENABLED
-                            __atomic_store_n(&seq_tracker->min_seq, seq, __ATOMIC_RELEASE);
-#endif
-                            __atomic_store_n(&seq_tracker->expected_seq, seq + 1, __ATOMIC_RELEASE);
-                        }
-                    }
-                    else
+                    uint64_t gap = rx_seq_update(seq_q, vl_idx, seq);
+                    if (unlikely(gap))
                     {
-                        // Real-time gap detection
-                        uint64_t expected = __atomic_load_n(&seq_tracker->expected_seq, __ATOMIC_ACQUIRE);
-                        if (seq > expected)
-                        {
-                            // Gap detected - packets lost
-                            local_lost += (seq - expected);
-#if TOKEN_BUCKET_TX_ENABLED
-                            printf("*** LOSS DETECTED [DPDK] Port %u Q%u: VL-ID=%u expected_seq=%lu got_seq=%lu gap=%lu (src_port=%u) ***\n",
-                                   params->port_id, params->queue_id, vl_id, expected, seq, seq - expected, params->src_port_id);
-#endif
-                        }
-                        // Update expected_seq (even if seq < expected, move forward)
-                        if (seq >= expected)
-                        {
-                            __atomic_store_n(&seq_tracker->expected_seq, seq + 1, __ATOMIC_RELEASE);
-                        }
+                        printf("*** LOSS DETECTED [DPDK] Port %u Q%u: VL-ID=%u expected_seq=%lu got_seq=%lu gap=%lu (src_port=%u) ***\n",
+                               params->port_id, params->queue_id, vl_id, seq - gap, seq, gap, params->src_port_id);
                     }
-
-                    // Update max_seq if this sequence is higher (CAS loop)
-                    uint64_t current_max;
-                    do {
-                        current_max = __atomic_load_n(&seq_tracker->max_seq, __ATOMIC_ACQUIRE);
-                        if (seq <= current_max) {
-                            break;  // Not higher, no update needed
-                        }
-                    } while (!__atomic_compare_exchange_n(&seq_tracker->max_seq,
-                                                           &current_max, seq,
-                                                           false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST));
-
-                    // Increment packet count
-                    __atomic_fetch_add(&seq_tracker->pkt_count, 1, __ATOMIC_RELAXED);
+#else
+                    rx_seq_update(seq_q, vl_idx, seq);
+#endif
+#if INBAND_LATENCY_ENABLED
+                    uint64_t tx_tsc;
+                    memcpy(&tx_tsc, pkt + payload_off + SEQ_BYTES, sizeof(tx_tsc));
+                    lat_record(lat_q, vl_idx, tx_tsc, rx_tsc);
+#endif
                 }
 
                 // ==========================================
                 // PRBS-31 VERIFICATION
+                // INBAND_TS_BYTES: TX TSC PRBS'in ilk byte'larının yerinde,
+                // karşılaştırma TSC'den sonra aynı akış offset'inden devam eder
                 // ==========================================
-                uint8_t *recv = pkt + payload_off + SEQ_BYTES;
+                uint8_t *recv = pkt + payload_off + SEQ_BYTES + INBAND_TS_BYTES;
 
 #if IMIX_ENABLED
                 // IMIX: PRBS offset hesabı HEP MAX_PRBS_BYTES ile yapılır
@@ -1884,20 +2345,20 @@ int rx_worker(void *arg)
                 uint16_t prbs_len = m->pkt_len - l2_len_vlan - 20 - 8 - SEQ_BYTES;
                 if (prbs_len > MAX_PRBS_BYTES) prbs_len = MAX_PRBS_BYTES;
 
-                uint64_t off = (seq * (uint64_t)MAX_PRBS_BYTES) % (uint64_t)PRBS_CACHE_SIZE;
-                uint8_t *exp = prbs_cache_ext + off;
-
-                int diff = memcmp(recv, exp, prbs_len);
+                uint64_t off = (seq * (uint64_t)MAX_PRBS_BYTES + INBAND_TS_BYTES) %
+                               (uint64_t)PRBS_CACHE_SIZE;
+                uint32_t berr = prbs_window_verify(prbs_win, off, recv,
+                                                   prbs_len - INBAND_TS_BYTES, prbs_lfsr);
 #else
-                uint64_t off = (seq * (uint64_t)NUM_PRBS_BYTES) % (uint64_t)PRBS_CACHE_SIZE;
-                uint8_t *exp = prbs_cache_ext + off;
-
-                int diff = memcmp(recv, exp, NUM_PRBS_BYTES);
+                uint64_t off = (seq * (uint64_t)NUM_PRBS_BYTES + INBAND_TS_BYTES) %
+                               (uint64_t)PRBS_CACHE_SIZE;
+                uint32_t berr = prbs_window_verify(prbs_win, off, recv,
+                                                   NUM_PRBS_BYTES - INBAND_TS_BYTES, prbs_lfsr);
 #endif
 
-                if (likely(diff == 0))
+                if (likely(berr == 0))
                 {
-                    local_good++;
+                    lc.good_pkts++;
                     if (unlikely(!first_good))
                     {
                         printf("✓ GOOD: Port %u Q%u VL-ID %u Seq %lu\n",
@@ -1907,7 +2368,7 @@ int rx_worker(void *arg)
                 }
                 else
                 {
-                    local_bad++;
+                    lc.bad_pkts++;
                     if (unlikely(!first_bad))
                     {
                         printf("✗ BAD: Port %u Q%u VL-ID %u Seq %lu\n",
@@ -1915,37 +2376,7 @@ int rx_worker(void *arg)
                         first_bad = true;
                     }
 
-                    // Bit error counting
-                    uint64_t berr = 0;
-                    const uint64_t *r64 = (const uint64_t *)recv;
-                    const uint64_t *e64 = (const uint64_t *)exp;
-#if IMIX_ENABLED
-                    const uint16_t nq = prbs_len / 8;
-#else
-                    const uint16_t nq = NUM_PRBS_BYTES / 8;
-#endif
-
-                    for (uint16_t k = 0; k < nq; k++)
-                    {
-                        berr += __builtin_popcountll(r64[k] ^ e64[k]);
-                    }
-
-#if IMIX_ENABLED
-                    uint16_t rem = prbs_len & 7;
-#else
-                    uint16_t rem = NUM_PRBS_BYTES & 7;
-#endif
-                    if (rem)
-                    {
-                        const uint8_t *r8 = (const uint8_t *)(r64 + nq);
-                        const uint8_t *e8 = (const uint8_t *)(e64 + nq);
-                        for (uint16_t k = 0; k < rem; k++)
-                        {
-                            berr += __builtin_popcount(r8[k] ^ e8[k]);
-                        }
-                    }
-
-                    local_bits += berr;
+                    lc.bit_errors += berr;
                 }
             }
 
@@ -1955,152 +2386,12 @@ int rx_worker(void *arg)
                 rte_pktmbuf_free(pkts[i]);
             }
 
-            if (unlikely(local_rx >= FLUSH))
-            {
-                rte_atomic64_add(&rx_stats_per_port[params->port_id].total_rx_pkts, local_rx);
-                rte_atomic64_add(&rx_stats_per_port[params->port_id].good_pkts, local_good);
-                rte_atomic64_add(&rx_stats_per_port[params->port_id].bad_pkts, local_bad);
-                rte_atomic64_add(&rx_stats_per_port[params->port_id].bit_errors, local_bits);
-                rte_atomic64_add(&rx_stats_per_port[params->port_id].lost_pkts, local_lost);
-                rte_atomic64_add(&rx_stats_per_port[params->port_id].out_of_order_pkts, local_ooo);
-                rte_atomic64_add(&rx_stats_per_port[params->port_id].duplicate_pkts, local_dup);
-                rte_atomic64_add(&rx_stats_per_port[params->port_id].short_pkts, local_short);
-                rte_atomic64_add(&rx_stats_per_port[params->port_id].external_pkts, local_external);
-                // Raw socket RX counters
-                rte_atomic64_add(&rx_stats_per_port[params->port_id].raw_socket_rx_pkts, local_raw_rx);
-                rte_atomic64_add(&rx_stats_per_port[params->port_id].raw_socket_rx_bytes, local_raw_bytes);
-
-#if STATS_MODE_DTN
-                // DTN port bazlı PRBS stats (queue = VLAN = DTN port)
-                if (my_dtn_port != DTN_VLAN_INVALID) {
-                    rte_atomic64_add(&dtn_stats[my_dtn_port].total_rx_pkts, local_rx);
-                    rte_atomic64_add(&dtn_stats[my_dtn_port].good_pkts, local_good);
-                    rte_atomic64_add(&dtn_stats[my_dtn_port].bad_pkts, local_bad);
-                    rte_atomic64_add(&dtn_stats[my_dtn_port].bit_errors, local_bits);
-                    rte_atomic64_add(&dtn_stats[my_dtn_port].lost_pkts, local_lost);
-                    rte_atomic64_add(&dtn_stats[my_dtn_port].out_of_order_pkts, local_ooo);
-                    rte_atomic64_add(&dtn_stats[my_dtn_port].duplicate_pkts, local_dup);
-                    rte_atomic64_add(&dtn_stats[my_dtn_port].short_pkts, local_short);
-                }
-#endif
-                local_rx = local_good = local_bad = local_bits = 0;
-                local_lost = local_ooo = local_dup = local_short = local_external = 0;
-                local_raw_rx = local_raw_bytes = 0;
-            }
+            // Burst başına yayın (tek yazar, plain store): düşük hızda da güncel
+            stats_shard_publish(stats, &lc);
         }
     }
 
-    // Final flush
-    if (local_rx || local_raw_rx || local_external)
-    {
-        rte_atomic64_add(&rx_stats_per_port[params->port_id].total_rx_pkts, local_rx);
-        rte_atomic64_add(&rx_stats_per_port[params->port_id].good_pkts, local_good);
-        rte_atomic64_add(&rx_stats_per_port[params->port_id].bad_pkts, local_bad);
-        rte_atomic64_add(&rx_stats_per_port[params->port_id].bit_errors, local_bits);
-        rte_atomic64_add(&rx_stats_per_port[params->port_id].lost_pkts, local_lost);
-        rte_atomic64_add(&rx_stats_per_port[params->port_id].out_of_order_pkts, local_ooo);
-        rte_atomic64_add(&rx_stats_per_port[params->port_id].duplicate_pkts, local_dup);
-        rte_atomic64_add(&rx_stats_per_port[params->port_id].short_pkts, local_short);
-        rte_atomic64_add(&rx_stats_per_port[params->port_id].external_pkts, local_external);
-        // Raw socket RX counters
-        rte_atomic64_add(&rx_stats_per_port[params->port_id].raw_socket_rx_pkts, local_raw_rx);
-        rte_atomic64_add(&rx_stats_per_port[params->port_id].raw_socket_rx_bytes, local_raw_bytes);
-
-#if STATS_MODE_DTN
-        if (my_dtn_port != DTN_VLAN_INVALID) {
-            rte_atomic64_add(&dtn_stats[my_dtn_port].total_rx_pkts, local_rx);
-            rte_atomic64_add(&dtn_stats[my_dtn_port].good_pkts, local_good);
-            rte_atomic64_add(&dtn_stats[my_dtn_port].bad_pkts, local_bad);
-            rte_atomic64_add(&dtn_stats[my_dtn_port].bit_errors, local_bits);
-            rte_atomic64_add(&dtn_stats[my_dtn_port].lost_pkts, local_lost);
-            rte_atomic64_add(&dtn_stats[my_dtn_port].out_of_order_pkts, local_ooo);
-            rte_atomic64_add(&dtn_stats[my_dtn_port].duplicate_pkts, local_dup);
-            rte_atomic64_add(&dtn_stats[my_dtn_port].short_pkts, local_short);
-        }
-#endif
-    }
-
-    // ==========================================
-    // CALCULATE LOST PACKETS (watermark-based)
-    // Lost = (max_seq + 1) - pkt_count for each VL-ID
-    // ==========================================
-#if STATS_MODE_DTN
-    // DTN modu: Her queue kendi VL-ID aralığı için lost hesaplar
-    // (Flow steering ile her queue = 1 VLAN = 1 DTN port, aralıklar çakışmaz)
-    {
-        uint64_t queue_lost = 0;
-        uint16_t vl_start = get_rx_vl_id_range_start(params->port_id, params->queue_id);
-        uint16_t vl_end = get_rx_vl_id_range_end(params->port_id, params->queue_id);
-
-        for (uint16_t vl = vl_start; vl < vl_end && vl <= MAX_VL_ID; vl++)
-        {
-            struct vl_sequence_tracker *seq_tracker = &vl_tracker->vl_trackers[vl];
-            if (__atomic_load_n(&seq_tracker->initialized, __ATOMIC_ACQUIRE))
-            {
-                uint64_t max_seq = __atomic_load_n(&seq_tracker->max_seq, __ATOMIC_ACQUIRE);
-                uint64_t pkt_count = __atomic_load_n(&seq_tracker->pkt_count, __ATOMIC_ACQUIRE);
-
-#if TOKEN_BUCKET_TX_ENABLED
-                uint64_t min_seq = __atomic_load_n(&seq_tracker->min_seq, __ATOMIC_ACQUIRE);
-                uint64_t expected_count = max_seq - min_seq + 1;
-#else
-                uint64_t expected_count = max_seq + 1;
-#endif
-                if (expected_count > pkt_count)
-                {
-                    queue_lost += (expected_count - pkt_count);
-                }
-            }
-        }
-
-        if (queue_lost > 0)
-        {
-            rte_atomic64_add(&rx_stats_per_port[params->port_id].lost_pkts, queue_lost);
-            if (my_dtn_port != DTN_VLAN_INVALID) {
-                rte_atomic64_add(&dtn_stats[my_dtn_port].lost_pkts, queue_lost);
-            }
-            printf("RX Worker Port %u Q%u (DTN %u): %lu lost packets (VL-ID %u-%u)\n",
-                   params->port_id, params->queue_id,
-                   my_dtn_port != DTN_VLAN_INVALID ? my_dtn_port : 0xFF,
-                   queue_lost, vl_start, vl_end - 1);
-        }
-    }
-#else
-    // Eski mod: Sadece queue 0 tüm VL-ID'ler için hesaplar (double-counting önlenir)
-    if (params->queue_id == 0)
-    {
-        uint64_t total_lost = 0;
-
-        for (uint16_t vl = 0; vl <= MAX_VL_ID; vl++)
-        {
-            struct vl_sequence_tracker *seq_tracker = &vl_tracker->vl_trackers[vl];
-            if (__atomic_load_n(&seq_tracker->initialized, __ATOMIC_ACQUIRE))
-            {
-                uint64_t max_seq = __atomic_load_n(&seq_tracker->max_seq, __ATOMIC_ACQUIRE);
-                uint64_t pkt_count = __atomic_load_n(&seq_tracker->pkt_count, __ATOMIC_ACQUIRE);
-
-#if TOKEN_BUCKET_TX_ENABLED
-                uint64_t min_seq = __atomic_load_n(&seq_tracker->min_seq, __ATOMIC_ACQUIRE);
-                uint64_t expected_count = max_seq - min_seq + 1;
-#else
-                uint64_t expected_count = max_seq + 1;
-#endif
-                if (expected_count > pkt_count)
-                {
-                    total_lost += (expected_count - pkt_count);
-                }
-            }
-        }
-
-        if (total_lost > 0)
-        {
-            rte_atomic64_add(&rx_stats_per_port[params->port_id].lost_pkts, total_lost);
-            printf("RX Worker Port %u Q%u: Calculated %lu lost packets (watermark-based)\n",
-                   params->port_id, params->queue_id, total_lost);
-        }
-    }
-#endif
-
+    // Kayıp / reorder / duplicate: merge_rx_sequence_stats (stats lcore)
     printf("RX Worker stopped: Port %u Q%u\n", params->port_id, params->queue_id);
     return 0;
 }
@@ -2126,8 +2417,9 @@ int start_txrx_workers(struct ports_config *ports_config, volatile bool *stop_fl
     printf("  VLAN: Header tag (separate from VL ID)\n\n");
 
     //  CRITICAL: Initialize VL-ID based TX sequences
+    // Bloklar worker başına aşağıda oluşturulur; yeniden başlatmada sıfırla
     printf("Initializing VL-ID based sequence counters...\n");
-    init_tx_vl_sequences();
+    tx_seq_reset_domain(TX_SEQ_DOMAIN_DPDK);
 
 #if TX_TEST_MODE_ENABLED
     // Initialize TX test mode counters
@@ -2140,6 +2432,17 @@ int start_txrx_workers(struct ports_config *ports_config, volatile bool *stop_fl
     uint16_t tx_param_idx = 0;
     uint16_t rx_param_idx = 0;
 
+    // RX tracker dizileri vl_map_count() ile boyutlanır: önce flow registry
+    // (tüm VL'ler vl_map'e kaydedilir, raw ve DPDK ext init'leri bitmiş olmalı)
+    if (flow_registry_build() != 0)
+        return -1;
+
+#if RAW_VL_FLOW_STEERING_ENABLED
+    // Raw portların VLAN'sız trafiği: VL aralığı başına tek RX queue (RSS yerine)
+    for (uint16_t port_idx = 0; port_idx < ports_config->nb_ports; port_idx++)
+        raw_vl_flow_rules_install(ports_config->ports[port_idx].port_id, NUM_RX_CORES);
+#endif
+
     // ==========================================
     // PHASE 1: Start ALL RX workers first
     // ==========================================
@@ -2149,7 +2452,7 @@ int start_txrx_workers(struct ports_config *ports_config, volatile bool *stop_fl
     {
         struct port *port = &ports_config->ports[port_idx];
         uint16_t port_id = port->port_id;
-        uint16_t paired_port_id = (port_id % 2 == 0) ? (uint16_t)(port_id + 1) : (uint16_t)(port_id - 1);
+        uint16_t paired_port_id = paired_port(port_id);
 
         printf("\n--- Port %u RX (Receiving from Port %u) ---\n", port_id, paired_port_id);
 
@@ -2174,6 +2477,54 @@ int start_txrx_workers(struct ports_config *ports_config, volatile bool *stop_fl
             rx_params[rx_param_idx].vlan_id = rx_vlan;
             rx_params[rx_param_idx].vl_id = rx_vl_id;
             rx_params[rx_param_idx].stop_flag = stop_flag;
+            rx_params[rx_param_idx].seq_queue = rx_seq_queue_create(
+                port_id, q, vl_map_count(), (int)rte_lcore_to_socket_id(lcore_id));
+            if (rx_params[rx_param_idx].seq_queue == NULL)
+            {
+                printf("Error: Cannot allocate RX sequence trackers for port %u queue %u\n",
+                       port_id, q);
+                return -1;
+            }
+
+            struct stats_shard *rx_shard = stats_shard_create(
+                STATS_DOM_PORT_RX, port_id, q, 0, (int)rte_lcore_to_socket_id(lcore_id));
+            if (rx_shard == NULL)
+            {
+                printf("Error: Cannot allocate RX stats shard for port %u queue %u\n", port_id, q);
+                return -1;
+            }
+#if STATS_MODE_DTN
+            // queue = VLAN = DTN port (1:1 mapping, flow steering aktif)
+            if (rx_vlan < DTN_VLAN_LOOKUP_SIZE && vlan_to_dtn_port[rx_vlan] < DTN_PORT_COUNT)
+                rx_shard->dtn_port = vlan_to_dtn_port[rx_vlan];
+#endif
+            rx_params[rx_param_idx].stats = rx_shard;
+
+#if INBAND_LATENCY_ENABLED
+            struct lat_queue *lat_q = lat_queue_create(
+                port_id, q, vl_map_count(), (int)rte_lcore_to_socket_id(lcore_id));
+            if (lat_q == NULL)
+            {
+                printf("Error: Cannot allocate latency histograms for port %u queue %u\n",
+                       port_id, q);
+                return -1;
+            }
+            lat_q->dtn_port = rx_shard->dtn_port;
+            rx_params[rx_param_idx].lat_queue = lat_q;
+#endif
+
+#if RX_BAG_MONITOR_ENABLED
+            struct rx_bag_queue *bag_q = rx_bag_queue_create(
+                port_id, q, vl_map_count(), (int)rte_lcore_to_socket_id(lcore_id));
+            if (bag_q == NULL)
+            {
+                printf("Error: Cannot allocate RX BAG analyzer for port %u queue %u\n",
+                       port_id, q);
+                return -1;
+            }
+            bag_q->dtn_port = rx_shard->dtn_port;
+            rx_params[rx_param_idx].bag_queue = bag_q;
+#endif
 
             printf("  RX Queue %u -> Lcore %2u -> VLAN %u <- Port %u (VL-ID Based Seq Validation)\n",
                    q, lcore_id, rx_vlan, paired_port_id);
@@ -2207,7 +2558,7 @@ int start_txrx_workers(struct ports_config *ports_config, volatile bool *stop_fl
     {
         struct port *port = &ports_config->ports[port_idx];
         uint16_t port_id = port->port_id;
-        uint16_t paired_port_id = (port_id % 2 == 0) ? (uint16_t)(port_id + 1) : (uint16_t)(port_id - 1);
+        uint16_t paired_port_id = paired_port(port_id);
 
         printf("\n--- Port %u TX (Sending to Port %u) ---\n", port_id, paired_port_id);
 
@@ -2222,7 +2573,7 @@ int start_txrx_workers(struct ports_config *ports_config, volatile bool *stop_fl
                 continue;
             }
 
-            double port_target_gbps = ate_mode_enabled() ? TARGET_GBPS_FAST : GET_PORT_TARGET_GBPS(port_id);
+            double port_target_gbps = traffic_port_rate_gbps(port_id);
             init_rate_limiter(&tx_params[tx_param_idx].limiter, port_target_gbps, NUM_TX_CORES);
 
             uint16_t tx_vlan = get_tx_vlan_for_queue(port_id, q);
@@ -2233,6 +2584,29 @@ int start_txrx_workers(struct ports_config *ports_config, volatile bool *stop_fl
             tx_params[tx_param_idx].lcore_id = lcore_id;
             tx_params[tx_param_idx].vlan_id = tx_vlan;
             tx_params[tx_param_idx].stop_flag = stop_flag;
+
+            // Worker'a ait sequence bloğu (lcore'un NUMA node'unda, lock'suz)
+#if TOKEN_BUCKET_TX_ENABLED
+            const uint16_t seq_vl_count = GET_TB_VL_RANGE_SIZE(port_id);
+#else
+            const uint16_t seq_vl_count = get_vl_id_range_size();
+#endif
+            tx_params[tx_param_idx].seq_block = tx_seq_block_create_contig(
+                TX_SEQ_DOMAIN_DPDK, port_id, get_tx_vl_id_range_start(port_id, q),
+                seq_vl_count, (int)rte_lcore_to_socket_id(lcore_id));
+            if (tx_params[tx_param_idx].seq_block == NULL)
+            {
+                printf("Error: Cannot allocate TX sequence block for port %u queue %u\n",
+                       port_id, q);
+                return -1;
+            }
+#if TX_LIVE_ACTIVE
+            // Canlı parametre slot'u: yoksa worker başlangıç değerleriyle sabit çalışır
+            tx_params[tx_param_idx].live = tx_live_register(
+                port_id, q, seq_vl_count, port_target_gbps, (int)rte_lcore_to_socket_id(lcore_id));
+            if (tx_params[tx_param_idx].live == NULL)
+                printf("Warning: No live control slot for port %u queue %u\n", port_id, q);
+#endif
 #if TOKEN_BUCKET_TX_ENABLED
             tx_params[tx_param_idx].nb_ports = ports_config->nb_ports;
 #endif
@@ -2268,7 +2642,7 @@ int start_txrx_workers(struct ports_config *ports_config, volatile bool *stop_fl
             printf("  TX Queue %u -> Lcore %2u -> VLAN %u, VL RANGE [%u..%u) Rate: %.1f Gbps (%s)\n",
                    q, lcore_id, tx_vlan,
                    get_tx_vl_id_range_start(port_id, q), get_tx_vl_id_range_end(port_id, q),
-                   port_target_gbps, IS_FAST_PORT(port_id) ? "FAST" : "SLOW");
+                   port_target_gbps, traffic_port_rate_class(port_id));
 
             int ret = rte_eal_remote_launch(tx_worker,
                                             &tx_params[tx_param_idx],
@@ -2404,10 +2778,11 @@ static int build_latency_test_packet(struct rte_mbuf *mbuf,
 
     // PRBS data
     uint16_t prbs_len = payload_len - SEQ_BYTES - TX_TIMESTAMP_BYTES;
-    uint8_t *prbs_cache = get_prbs_cache_ext_for_port(port_id);
-    if (prbs_cache) {
+    const struct prbs_window *prbs_win = get_prbs_window_for_port(port_id);
+    if (prbs_win) {
         uint64_t prbs_offset = (sequence * (uint64_t)MAX_PRBS_BYTES) % PRBS_CACHE_SIZE;
-        memcpy(payload + LATENCY_PAYLOAD_OFFSET, prbs_cache + prbs_offset, prbs_len);
+        memcpy(payload + LATENCY_PAYLOAD_OFFSET, prbs_window_at(prbs_win, prbs_offset, prbs_len),
+               prbs_len);
     }
 
     // Set mbuf lengths
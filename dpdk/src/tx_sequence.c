@@ -0,0 +1,138 @@
+#include "tx_sequence.h"
+
+#include <stdio.h>
+#include <rte_malloc.h>
+#include <rte_spinlock.h>
+
+// Kayıtlı bloklar (yalnızca eklenir, process ömrü boyunca silinmez)
+static struct tx_seq_block *tx_seq_blocks[TX_SEQ_MAX_BLOCKS];
+static uint32_t tx_seq_nb_blocks = 0;
+static rte_spinlock_t tx_seq_reg_lock = RTE_SPINLOCK_INITIALIZER;
+
+static inline uint32_t tx_seq_block_count(void)
+{
+    return __atomic_load_n(&tx_seq_nb_blocks, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * VL-ID'yi blok içindeki dense index'e çevir
+ * @return true if vl_id belongs to block
+ */
+static bool tx_seq_vl_to_idx(const struct tx_seq_block *b, uint16_t vl_id, uint16_t *idx)
+{
+    if (vl_id < b->vl_start)
+        return false;
+
+    uint32_t off = (uint32_t)(vl_id - b->vl_start);
+    uint32_t blk = off / b->block_step;
+    uint32_t in_blk = off % b->block_step;
+    uint32_t i = blk * b->block_size + in_blk;
+
+    if (in_blk >= b->block_size || i >= b->vl_count)
+        return false;
+
+    *idx = (uint16_t)i;
+    return true;
+}
+
+struct tx_seq_block *tx_seq_block_create(enum tx_seq_domain domain, uint16_t port_id,
+                                         uint16_t vl_start, uint16_t vl_count,
+                                         uint16_t block_size, uint16_t block_step,
+                                         int socket_id)
+{
+    struct tx_seq_block *b = NULL;
+
+    if (vl_count == 0 || block_size == 0 || block_step < block_size)
+        return NULL;
+
+    rte_spinlock_lock(&tx_seq_reg_lock);
+
+    // Worker yeniden başlatıldıysa mevcut bloğu döndür (sequence sürekliliği)
+    for (uint32_t i = 0; i < tx_seq_nb_blocks; i++) {
+        struct tx_seq_block *e = tx_seq_blocks[i];
+        if (e->domain == domain && e->port_id == port_id &&
+            e->vl_start == vl_start && e->vl_count == vl_count) {
+            b = e;
+            goto out;
+        }
+    }
+
+    if (tx_seq_nb_blocks >= TX_SEQ_MAX_BLOCKS) {
+        printf("Error: TX sequence registry full (%u blocks)\n", TX_SEQ_MAX_BLOCKS);
+        goto out;
+    }
+
+    b = rte_zmalloc_socket("tx_seq_block", sizeof(*b), RTE_CACHE_LINE_SIZE, socket_id);
+    if (b == NULL)
+        goto out;
+
+    b->seq = rte_zmalloc_socket("tx_seq_array", (size_t)vl_count * sizeof(uint64_t),
+                                RTE_CACHE_LINE_SIZE, socket_id);
+    if (b->seq == NULL) {
+        rte_free(b);
+        b = NULL;
+        goto out;
+    }
+
+    b->vl_start = vl_start;
+    b->vl_count = vl_count;
+    b->block_size = block_size;
+    b->block_step = block_step;
+    b->port_id = port_id;
+    b->domain = (uint8_t)domain;
+
+    tx_seq_blocks[tx_seq_nb_blocks] = b;
+    __atomic_store_n(&tx_seq_nb_blocks, tx_seq_nb_blocks + 1, __ATOMIC_RELEASE);
+
+out:
+    rte_spinlock_unlock(&tx_seq_reg_lock);
+    return b;
+}
+
+void tx_seq_reset_domain(enum tx_seq_domain domain)
+{
+    uint32_t n = tx_seq_block_count();
+
+    for (uint32_t i = 0; i < n; i++) {
+        struct tx_seq_block *b = tx_seq_blocks[i];
+        if (b->domain != domain)
+            continue;
+        for (uint16_t v = 0; v < b->vl_count; v++)
+            __atomic_store_n(&b->seq[v], 0, __ATOMIC_RELAXED);
+    }
+}
+
+bool tx_seq_snapshot(enum tx_seq_domain domain, uint16_t port_id, uint16_t vl_id,
+                     uint64_t *seq)
+{
+    uint32_t n = tx_seq_block_count();
+
+    for (uint32_t i = 0; i < n; i++) {
+        const struct tx_seq_block *b = tx_seq_blocks[i];
+        uint16_t idx;
+
+        if (b->domain != domain || b->port_id != port_id)
+            continue;
+        if (!tx_seq_vl_to_idx(b, vl_id, &idx))
+            continue;
+
+        *seq = __atomic_load_n(&b->seq[idx], __ATOMIC_RELAXED);
+        return true;
+    }
+    return false;
+}
+
+uint64_t tx_seq_snapshot_port_total(enum tx_seq_domain domain, uint16_t port_id)
+{
+    uint32_t n = tx_seq_block_count();
+    uint64_t total = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        const struct tx_seq_block *b = tx_seq_blocks[i];
+        if (b->domain != domain || b->port_id != port_id)
+            continue;
+        for (uint16_t v = 0; v < b->vl_count; v++)
+            total += __atomic_load_n(&b->seq[v], __ATOMIC_RELAXED);
+    }
+    return total;
+}
@@ -0,0 +1,79 @@
+#include "vl_map.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// Boş sayfa: tüm girişler VL_MAP_INVALID, dir başlangıçta hep buna bakar
+static const uint16_t vl_map_empty_page[256] = { [0 ... 255] = VL_MAP_INVALID };
+static uint16_t vl_map_pages[VL_MAP_MAX_PAGES][256];
+static uint16_t vl_map_nb_pages = 0;
+
+static uint16_t vl_map_rev[VL_MAP_MAX_ENTRIES];
+static uint16_t vl_map_nb_entries = 0;
+
+const uint16_t *vl_map_dir[256] = { [0 ... 255] = vl_map_empty_page };
+
+static uint16_t *vl_map_page_for(uint16_t vl_id)
+{
+    uint8_t hi = (uint8_t)(vl_id >> 8);
+
+    if (vl_map_dir[hi] != vl_map_empty_page)
+        return (uint16_t *)vl_map_dir[hi];
+
+    if (vl_map_nb_pages >= VL_MAP_MAX_PAGES) {
+        printf("Error: VL-ID map out of pages (%u), VL-ID %u not registered\n",
+               VL_MAP_MAX_PAGES, vl_id);
+        return NULL;
+    }
+
+    uint16_t *page = vl_map_pages[vl_map_nb_pages++];
+    memset(page, 0xFF, 256 * sizeof(uint16_t));
+    vl_map_dir[hi] = page;
+    return page;
+}
+
+uint16_t vl_map_add(uint16_t vl_id)
+{
+    uint16_t idx = vl_map_index(vl_id);
+    if (idx != VL_MAP_INVALID)
+        return idx;
+
+    if (vl_map_nb_entries >= VL_MAP_MAX_ENTRIES) {
+        printf("Error: VL-ID map full (%u entries), VL-ID %u not registered\n",
+               VL_MAP_MAX_ENTRIES, vl_id);
+        return VL_MAP_INVALID;
+    }
+
+    uint16_t *page = vl_map_page_for(vl_id);
+    if (page == NULL)
+        return VL_MAP_INVALID;
+
+    idx = vl_map_nb_entries++;
+    page[vl_id & 0xFF] = idx;
+    vl_map_rev[idx] = vl_id;
+    return idx;
+}
+
+int vl_map_add_range(uint16_t vl_start, uint16_t vl_count,
+                     uint16_t block_size, uint16_t block_step)
+{
+    if (block_size == 0)
+        return 0;
+
+    for (uint32_t i = 0; i < vl_count; i++) {
+        uint32_t vl = (uint32_t)vl_start + (i / block_size) * block_step + i % block_size;
+        if (vl > 0xFFFF || vl_map_add((uint16_t)vl) == VL_MAP_INVALID)
+            return -1;
+    }
+    return 0;
+}
+
+uint16_t vl_map_count(void)
+{
+    return vl_map_nb_entries;
+}
+
+uint16_t vl_map_vl_id(uint16_t idx)
+{
+    return idx < vl_map_nb_entries ? vl_map_rev[idx] : 0;
+}
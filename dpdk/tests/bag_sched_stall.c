@@ -0,0 +1,126 @@
+// ==========================================
+// BAG SCHEDULER STALL TEST
+// ==========================================
+// Karışık (2'nin kuvveti olmayan) BAG'lerle birkaç scheduler kurulur, zaman
+// sentetik ilerletilir (tick başına bir poll) ve araya en büyük BAG'e yakın
+// (resync eşiğinin hemen altı) duraklamalar sokulur. Her pop'ta:
+//   - aynı VL'in ardışık iki çıkışı arası ≥ BAG - jitter bütçesi olmalı
+//   - max_jitter, geçen süreden büyük olamaz (due > now → unsigned taşma)
+//
+//   make test                 (--no-huge, root gerekmez)
+//   ./tests/bag_sched_stall <EAL args> [-- <stalls>]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <rte_eal.h>
+#include <rte_cycles.h>
+
+// Grup başına: en büyük BAG + ondan küçük, birbirinin katı olmayan BAG'ler (us),
+// jitter bütçesi 1 us (atlama mantığı en geç noktaya yakın planlar)
+#define BAG_PROFILE_INIT { \
+    {   0,   3, 4000, 0, 1 }, {   4,   7, 3000, 0, 1 }, {   8,  11, 1700, 0, 1 }, \
+    {  16,  19, 5000, 0, 1 }, {  20,  23, 3700, 0, 1 }, {  24,  27,  900, 0, 1 }, \
+    {  32,  35, 6100, 0, 1 }, {  36,  39, 4500, 0, 1 }, {  40,  43, 2300, 0, 1 }, \
+    {  48,  51, 7300, 0, 1 }, {  52,  55, 5900, 0, 1 }, {  56,  59, 3100, 0, 1 }, \
+    {  64,  67, 2900, 0, 1 }, {  68,  71, 2100, 0, 1 }, {  72,  75, 1100, 0, 1 }, \
+}
+#include "../src/bag_sched.c"
+
+#define TEST_GROUPS         5
+#define TEST_GROUP_VLS      12
+#define TEST_GROUP_STRIDE   16
+#define TEST_DEFAULT_STALLS 200
+#define TEST_STALL_EVERY    3           // Duraklamalar arası en büyük BAG sayısı
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t rng_next(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+// Tek scheduler: violations döner
+static uint64_t run_group(struct bag_sched *s, uint32_t stalls, uint64_t *pops)
+{
+    const uint64_t tick = 1ULL << s->tick_shift;
+    uint64_t last[TEST_GROUP_VLS] = {0};
+    uint16_t out[64];
+    uint64_t bad = 0;
+    uint64_t now = rte_get_tsc_hz();            // Sıfırdan farklı, keyfi başlangıç
+
+    bag_sched_start(s, now);
+
+    for (uint32_t k = 0; k < stalls; k++) {
+        const uint64_t run_ticks = s->max_bag * TEST_STALL_EVERY;
+        for (uint64_t t = 0; t < run_ticks; t++) {
+            now += tick;
+            uint16_t n = bag_sched_poll(s, now, out, 64);
+            for (uint16_t i = 0; i < n; i++) {
+                const uint16_t idx = out[i];
+                const uint64_t min_gap = ((uint64_t)s->vl[idx].bag << s->tick_shift) -
+                                         s->vl[idx].jitter_budget;
+                if (last[idx] != 0 && now - last[idx] < min_gap) {
+                    if (bad < 5)
+                        printf("  Port %u VL %u: gap %lu < %lu cycles (BAG %u us)\n",
+                               s->port_id, s->vl_start + idx,
+                               (unsigned long)(now - last[idx]), (unsigned long)min_gap,
+                               s->bag_us[idx]);
+                    bad++;
+                }
+                if (s->st[idx].max_jitter > now - s->base) {
+                    if (bad < 5)
+                        printf("  Port %u VL %u: max_jitter %lu underflow\n",
+                               s->port_id, s->vl_start + idx,
+                               (unsigned long)s->st[idx].max_jitter);
+                    bad++;
+                }
+                last[idx] = now;
+            }
+            *pops += n;
+        }
+
+        // Resync eşiğinin (max_bag) hemen altında duraklama, rastgele faz
+        now += (s->max_bag - 1 - rng_next() % (s->max_bag / 8 + 1)) * tick;
+    }
+    return bad;
+}
+
+int main(int argc, char **argv)
+{
+    int ret = rte_eal_init(argc, argv);
+    if (ret < 0) {
+        fprintf(stderr, "EAL init failed\n");
+        return 1;
+    }
+    argc -= ret;
+    argv += ret;
+    const uint32_t stalls = (argc > 1 && atoi(argv[1]) > 0) ? (uint32_t)atoi(argv[1])
+                                                            : TEST_DEFAULT_STALLS;
+    uint64_t bad = 0, pops = 0;
+
+    for (uint16_t g = 0; g < TEST_GROUPS; g++) {
+        struct bag_sched *s = bag_sched_create(g, 0, (uint16_t)(g * TEST_GROUP_STRIDE),
+                                               TEST_GROUP_VLS, 0, SOCKET_ID_ANY);
+        if (s == NULL) {
+            fprintf(stderr, "bag_sched_create failed\n");
+            return 1;
+        }
+        const uint64_t group_bad = run_group(s, stalls, &pops);
+        uint64_t skipped = 0;
+        for (uint16_t i = 0; i < s->vl_count; i++)
+            skipped += s->st[i].skipped;
+        printf("  group %u: max BAG %lu ticks, wheel %u slots, %lu skipped, %lu resyncs, %lu violations\n",
+               g, (unsigned long)s->max_bag, s->wheel_mask + 1, (unsigned long)skipped,
+               (unsigned long)s->resyncs, (unsigned long)group_bad);
+        bad += group_bad;
+    }
+
+    printf("bag_sched_stall: %u stalls/group, %lu pops, %lu violations: %s\n",
+           stalls, (unsigned long)pops, (unsigned long)bad, bad == 0 ? "PASS" : "FAIL");
+
+    rte_eal_cleanup();
+    return bad == 0 ? 0 : 1;
+}
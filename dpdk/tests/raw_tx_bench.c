@@ -0,0 +1,488 @@
+// ==========================================
+// RAW TX SUBMISSION BENCHMARK (ring / sendmmsg / io_uring)
+// ==========================================
+// Aynı paced trafiği üç gönderim yoluyla sırayla gönderir, karşı uçta
+// (kablo ile bağlı ikinci port veya veth peer) alır ve karşılaştırır:
+//
+//   Mbps        alıcıda ölçülen rate (ilk → son paket)
+//   lost/reord  sequence ile (alıcı tarafı)
+//   cpu ns/pkt  TX thread'inin gönderimde (acquire + commit + flush) harcadığı
+//               CPU süresi; pacing beklemesi dahil değil
+//   jitter      alıcıdaki paketler arası sürenin nominal aralıktan sapması
+//               (SO_TIMESTAMPNS): stdev, p99 ve max |sapma|
+//
+// Ring yolu raw_socket_port.c ile aynıdır (TPACKET_V2, send(NULL) kick,
+// ring doluyken 100 turdan sonra poll(POLLOUT, 1 ms)); sendmmsg / io_uring
+// doğrudan raw_tx_batch.c'dir.
+//
+//   make raw-tx-bench
+//   sudo ./tests/raw_tx_bench <tx_if> <rx_if> [Mbps=960] [packets=200000] [size=1509]
+//   Mbps = 0: pacing yok (en yüksek rate)
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+#include <poll.h>
+#include <pthread.h>
+#include <net/if.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+#include "raw_socket_port.h"
+#include "raw_tx_batch.h"
+
+#define BENCH_ETHERTYPE     0x88B5          // IEEE local experimental
+#define BENCH_MAGIC         0x52545842u     // "RTXB"
+#define BENCH_BATCH         32              // Flush eşiği (worker'ın BATCH_SIZE'ı gibi)
+#define BENCH_DRAIN_MS      200             // Son paketten sonra alıcı bekleme
+#define BENCH_RING_BLOCK_NR 64              // Ring: 64 × 32 KB (uygulamada 256)
+
+struct bench_hdr {
+    uint8_t dst[6];
+    uint8_t src[6];
+    uint16_t ethertype;
+    uint32_t magic;
+    uint32_t run;
+    uint64_t seq;
+} __attribute__((packed));
+
+struct bench_result {
+    uint64_t sent;
+    uint64_t tx_dropped;        // Gönderim yolunun bildirdiği kayıp
+    uint64_t cpu_ns;            // Gönderim çağrılarında TX thread CPU'su
+    uint64_t received;
+    uint64_t lost;
+    uint64_t reordered;
+    double rx_mbps;
+    double gap_mean_us;
+    double jitter_stdev_us;
+    double jitter_p99_us;
+    double jitter_max_us;
+};
+
+// ==========================================
+// TX (ring veya raw_tx_batch)
+// ==========================================
+
+struct bench_tx {
+    uint8_t mode;
+    struct raw_socket_port port;        // raw_tx_batch_open: port_id, if_index
+    uint8_t *ring;
+    size_t ring_size;
+    uint32_t ring_frames;
+    uint32_t ring_off;
+};
+
+static int bench_ring_open(struct bench_tx *tx)
+{
+    int fd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+    if (fd < 0)
+        return -1;
+
+    int version = TPACKET_V2;
+    int bypass = 1;
+    setsockopt(fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version));
+    setsockopt(fd, SOL_PACKET, PACKET_QDISC_BYPASS, &bypass, sizeof(bypass));
+
+    struct tpacket_req req = {0};
+    req.tp_block_size = RAW_SOCKET_RING_BLOCK_SIZE;
+    req.tp_block_nr = BENCH_RING_BLOCK_NR;
+    req.tp_frame_size = RAW_SOCKET_RING_FRAME_SIZE;
+    req.tp_frame_nr = (RAW_SOCKET_RING_BLOCK_SIZE / RAW_SOCKET_RING_FRAME_SIZE) * BENCH_RING_BLOCK_NR;
+    if (setsockopt(fd, SOL_PACKET, PACKET_TX_RING, &req, sizeof(req)) < 0)
+        goto fail;
+
+    tx->ring_size = (size_t)req.tp_block_size * req.tp_block_nr;
+    tx->ring_frames = req.tp_frame_nr;
+    tx->ring = mmap(NULL, tx->ring_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (tx->ring == MAP_FAILED)
+        goto fail;
+
+    struct sockaddr_ll sll = {0};
+    sll.sll_family = AF_PACKET;
+    sll.sll_ifindex = tx->port.if_index;
+    sll.sll_protocol = htons(ETH_P_ALL);
+    if (bind(fd, (struct sockaddr *)&sll, sizeof(sll)) < 0) {
+        munmap(tx->ring, tx->ring_size);
+        goto fail;
+    }
+    tx->port.tx_socket = fd;
+    tx->ring_off = 0;
+    return 0;
+
+fail:
+    fprintf(stderr, "ring setup failed: %s\n", strerror(errno));
+    close(fd);
+    return -1;
+}
+
+static int bench_tx_open(struct bench_tx *tx, uint8_t mode, int if_index)
+{
+    memset(tx, 0, sizeof(*tx));
+    tx->port.port_id = 0;
+    tx->port.if_index = if_index;
+    tx->port.tx_socket = -1;
+
+    if (mode == RAW_TX_SUBMIT_RING) {
+        tx->mode = mode;
+        return bench_ring_open(tx);
+    }
+    if (raw_tx_batch_open(&tx->port, mode) < 0)
+        return -1;
+    tx->mode = tx->port.tx_batch->mode;     // io_uring kurulamazsa sendmmsg
+    return 0;
+}
+
+static void bench_tx_close(struct bench_tx *tx)
+{
+    if (tx->port.tx_batch)
+        raw_tx_batch_close(&tx->port);
+    if (tx->ring)
+        munmap(tx->ring, tx->ring_size);
+    if (tx->port.tx_socket >= 0)
+        close(tx->port.tx_socket);
+}
+
+static inline struct tpacket2_hdr *bench_ring_hdr(struct bench_tx *tx)
+{
+    return (struct tpacket2_hdr *)(tx->ring + (size_t)tx->ring_off * RAW_SOCKET_RING_FRAME_SIZE);
+}
+
+// raw_tx_frame_acquire ile aynı bekleme
+static uint8_t *bench_tx_acquire(struct bench_tx *tx, uint32_t *batch_count)
+{
+    if (tx->port.tx_batch) {
+        uint8_t *frame;
+        while ((frame = raw_tx_batch_frame(tx->port.tx_batch)) == NULL) {
+            raw_tx_batch_wait(tx->port.tx_batch);
+            *batch_count = 0;
+        }
+        return frame;
+    }
+
+    struct tpacket2_hdr *hdr = bench_ring_hdr(tx);
+    int wait_count = 0;
+    while (hdr->tp_status != TP_STATUS_AVAILABLE) {
+        if (*batch_count > 0) {
+            send(tx->port.tx_socket, NULL, 0, 0);
+            *batch_count = 0;
+        }
+        if (++wait_count > 100) {
+            struct pollfd pfd = {tx->port.tx_socket, POLLOUT, 0};
+            poll(&pfd, 1, 1);
+            wait_count = 0;
+        }
+    }
+    return (uint8_t *)hdr + TPACKET2_HDRLEN - sizeof(struct sockaddr_ll);
+}
+
+static void bench_tx_commit(struct bench_tx *tx, uint8_t *frame, uint16_t len)
+{
+    if (tx->port.tx_batch) {
+        raw_tx_batch_add(tx->port.tx_batch, frame, len);
+        return;
+    }
+    struct tpacket2_hdr *hdr = bench_ring_hdr(tx);
+    hdr->tp_len = len;
+    __atomic_store_n(&hdr->tp_status, TP_STATUS_SEND_REQUEST, __ATOMIC_RELEASE);
+    tx->ring_off = (tx->ring_off + 1) % tx->ring_frames;
+}
+
+static uint32_t bench_tx_flush(struct bench_tx *tx)
+{
+    if (tx->port.tx_batch)
+        return raw_tx_batch_submit(tx->port.tx_batch);
+    send(tx->port.tx_socket, NULL, 0, 0);
+    return 0;
+}
+
+// Ring: kernel'in bütün frame'leri göndermesini bekle
+static void bench_tx_drain(struct bench_tx *tx)
+{
+    if (tx->ring == NULL)
+        return;
+    for (uint32_t i = 0; i < tx->ring_frames; i++) {
+        struct tpacket2_hdr *hdr = (struct tpacket2_hdr *)(tx->ring + (size_t)i * RAW_SOCKET_RING_FRAME_SIZE);
+        while (__atomic_load_n(&hdr->tp_status, __ATOMIC_ACQUIRE) & (TP_STATUS_SEND_REQUEST | TP_STATUS_SENDING)) {
+            send(tx->port.tx_socket, NULL, 0, 0);
+            struct pollfd pfd = {tx->port.tx_socket, POLLOUT, 0};
+            poll(&pfd, 1, 1);
+        }
+    }
+}
+
+// ==========================================
+// RX (alıcı thread)
+// ==========================================
+
+struct bench_rx {
+    int fd;
+    uint32_t run;
+    uint64_t capacity;
+    uint64_t count;
+    uint64_t *seq;
+    uint64_t *ts_ns;
+    volatile bool stop;
+};
+
+static uint64_t now_ns(clockid_t clk)
+{
+    struct timespec ts;
+    clock_gettime(clk, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int bench_rx_open(struct bench_rx *rx, int if_index)
+{
+    rx->fd = socket(AF_PACKET, SOCK_RAW, htons(BENCH_ETHERTYPE));
+    if (rx->fd < 0)
+        return -1;
+
+    int on = 1;
+    int rcvbuf = 64 * 1024 * 1024;
+    setsockopt(rx->fd, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on));
+    if (setsockopt(rx->fd, SOL_SOCKET, SO_RCVBUFFORCE, &rcvbuf, sizeof(rcvbuf)) < 0)
+        setsockopt(rx->fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    struct sockaddr_ll sll = {0};
+    sll.sll_family = AF_PACKET;
+    sll.sll_ifindex = if_index;
+    sll.sll_protocol = htons(BENCH_ETHERTYPE);
+    if (bind(rx->fd, (struct sockaddr *)&sll, sizeof(sll)) < 0) {
+        close(rx->fd);
+        return -1;
+    }
+    return 0;
+}
+
+static void *bench_rx_main(void *arg)
+{
+    struct bench_rx *rx = arg;
+    uint8_t buf[2048];
+    uint8_t ctrl[CMSG_SPACE(sizeof(struct timespec))];
+
+    while (!rx->stop || rx->count < rx->capacity) {
+        struct pollfd pfd = {rx->fd, POLLIN, 0};
+        if (poll(&pfd, 1, 10) <= 0) {
+            if (rx->stop)
+                break;
+            continue;
+        }
+
+        struct iovec iov = {buf, sizeof(buf)};
+        struct msghdr msg = {0};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = ctrl;
+        msg.msg_controllen = sizeof(ctrl);
+        ssize_t n = recvmsg(rx->fd, &msg, MSG_DONTWAIT);
+        if (n < (ssize_t)sizeof(struct bench_hdr))
+            continue;
+
+        const struct bench_hdr *h = (const struct bench_hdr *)buf;
+        if (h->magic != BENCH_MAGIC || h->run != rx->run || rx->count >= rx->capacity)
+            continue;
+
+        uint64_t ts = 0;
+        for (struct cmsghdr *c = CMSG_FIRSTHDR(&msg); c; c = CMSG_NXTHDR(&msg, c)) {
+            if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_TIMESTAMPNS) {
+                struct timespec t;
+                memcpy(&t, CMSG_DATA(c), sizeof(t));
+                ts = (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+            }
+        }
+        rx->seq[rx->count] = h->seq;
+        rx->ts_ns[rx->count] = ts ? ts : now_ns(CLOCK_REALTIME);
+        rx->count++;
+    }
+    return NULL;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+    const double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void bench_rx_analyze(const struct bench_rx *rx, uint64_t sent, uint32_t size,
+                             double nominal_ns, struct bench_result *r)
+{
+    r->received = rx->count;
+    r->lost = sent > rx->count ? sent - rx->count : 0;
+    if (rx->count < 2)
+        return;
+
+    uint64_t max_seq = rx->seq[0];
+    for (uint64_t i = 1; i < rx->count; i++) {
+        if (rx->seq[i] < max_seq)
+            r->reordered++;
+        else
+            max_seq = rx->seq[i];
+    }
+
+    const uint64_t n = rx->count - 1;
+    const double span_ns = (double)(rx->ts_ns[n] - rx->ts_ns[0]);
+    r->rx_mbps = span_ns > 0 ? (double)n * size * 8.0 * 1000.0 / span_ns : 0.0;
+    r->gap_mean_us = span_ns / (double)n / 1000.0;
+
+    // Pacing yoksa nominal aralık = ortalama aralık
+    const double ref_ns = nominal_ns > 0 ? nominal_ns : span_ns / (double)n;
+    double *dev = malloc(n * sizeof(*dev));
+    if (dev == NULL)
+        return;
+    double sum = 0.0, sum2 = 0.0;
+    for (uint64_t i = 0; i < n; i++) {
+        const double d = (double)(int64_t)(rx->ts_ns[i + 1] - rx->ts_ns[i]) - ref_ns;
+        sum += d;
+        sum2 += d * d;
+        dev[i] = fabs(d);
+    }
+    const double mean = sum / (double)n;
+    r->jitter_stdev_us = sqrt(fmax(sum2 / (double)n - mean * mean, 0.0)) / 1000.0;
+    qsort(dev, n, sizeof(*dev), cmp_double);
+    r->jitter_p99_us = dev[(uint64_t)((double)(n - 1) * 0.99)] / 1000.0;
+    r->jitter_max_us = dev[n - 1] / 1000.0;
+    free(dev);
+}
+
+// ==========================================
+// RUN
+// ==========================================
+
+static int bench_run(uint8_t mode, uint32_t run, int tx_if, int rx_if, double mbps,
+                     uint64_t packets, uint32_t size, struct bench_result *r, uint8_t *used_mode)
+{
+    struct bench_tx tx;
+    struct bench_rx rx = {0};
+    pthread_t rx_thread;
+
+    memset(r, 0, sizeof(*r));
+    if (bench_tx_open(&tx, mode, tx_if) < 0)
+        return -1;
+    *used_mode = tx.mode;
+
+    rx.run = run;
+    rx.capacity = packets;
+    rx.seq = malloc(packets * sizeof(*rx.seq));
+    rx.ts_ns = malloc(packets * sizeof(*rx.ts_ns));
+    if (rx.seq == NULL || rx.ts_ns == NULL || bench_rx_open(&rx, rx_if) < 0) {
+        fprintf(stderr, "RX setup failed: %s\n", strerror(errno));
+        bench_tx_close(&tx);
+        free(rx.seq);
+        free(rx.ts_ns);
+        return -1;
+    }
+    pthread_create(&rx_thread, NULL, bench_rx_main, &rx);
+
+    const double interval_ns = mbps > 0 ? (double)size * 8.0 * 1000.0 / mbps : 0.0;
+    uint32_t batch_count = 0;
+    uint64_t cpu = 0;
+    const uint64_t start = now_ns(CLOCK_MONOTONIC);
+
+    for (uint64_t seq = 0; seq < packets; seq++) {
+        const uint64_t due = start + (uint64_t)(interval_ns * (double)seq);
+        uint64_t now = now_ns(CLOCK_MONOTONIC);
+        if (now < due) {
+            // Sıradaki paket henüz zamanı gelmedi: bekleyenleri gönder, bekle
+            if (batch_count > 0) {
+                const uint64_t c0 = now_ns(CLOCK_THREAD_CPUTIME_ID);
+                r->tx_dropped += bench_tx_flush(&tx);
+                cpu += now_ns(CLOCK_THREAD_CPUTIME_ID) - c0;
+                batch_count = 0;
+            }
+            while (now_ns(CLOCK_MONOTONIC) < due)
+                ;
+        }
+
+        const uint64_t c0 = now_ns(CLOCK_THREAD_CPUTIME_ID);
+        uint8_t *frame = bench_tx_acquire(&tx, &batch_count);
+        struct bench_hdr *h = (struct bench_hdr *)frame;
+        memset(h->dst, 0xFF, sizeof(h->dst));
+        memcpy(h->src, (const uint8_t[]){0x02, 0, 0, 0, 0, 0x01}, sizeof(h->src));
+        h->ethertype = htons(BENCH_ETHERTYPE);
+        h->magic = BENCH_MAGIC;
+        h->run = run;
+        h->seq = seq;
+        bench_tx_commit(&tx, frame, (uint16_t)size);
+        if (++batch_count >= BENCH_BATCH) {
+            r->tx_dropped += bench_tx_flush(&tx);
+            batch_count = 0;
+        }
+        cpu += now_ns(CLOCK_THREAD_CPUTIME_ID) - c0;
+    }
+    if (batch_count > 0)
+        r->tx_dropped += bench_tx_flush(&tx);
+    bench_tx_drain(&tx);
+    r->sent = packets;
+    r->cpu_ns = cpu;
+
+    usleep(BENCH_DRAIN_MS * 1000);
+    rx.stop = true;
+    pthread_join(rx_thread, NULL);
+
+    bench_rx_analyze(&rx, packets, size, interval_ns, r);
+
+    close(rx.fd);
+    free(rx.seq);
+    free(rx.ts_ns);
+    bench_tx_close(&tx);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <tx_if> <rx_if> [Mbps=960] [packets=200000] [size=1509]\n", argv[0]);
+        return 1;
+    }
+    const int tx_if = (int)if_nametoindex(argv[1]);
+    const int rx_if = (int)if_nametoindex(argv[2]);
+    const double mbps = argc > 3 ? atof(argv[3]) : 960.0;
+    const uint64_t packets = argc > 4 ? strtoull(argv[4], NULL, 0) : 200000;
+    const uint32_t size = argc > 5 ? (uint32_t)atoi(argv[5]) : 1509;
+
+    if (tx_if == 0 || rx_if == 0) {
+        fprintf(stderr, "unknown interface\n");
+        return 1;
+    }
+    if (size < sizeof(struct bench_hdr) || size > RAW_TX_BATCH_FRAME_SIZE - TPACKET2_HDRLEN ||
+        packets < 2) {
+        fprintf(stderr, "size must be %zu..%zu B, packets >= 2\n", sizeof(struct bench_hdr),
+                (size_t)(RAW_TX_BATCH_FRAME_SIZE - TPACKET2_HDRLEN));
+        return 1;
+    }
+
+    printf("Raw TX submission benchmark: %s -> %s, %u B, %lu packets, %s\n",
+           argv[1], argv[2], size, (unsigned long)packets,
+           mbps > 0 ? "paced" : "unpaced");
+    if (mbps > 0)
+        printf("  target %.1f Mbps, nominal gap %.3f us\n", mbps, (double)size * 8.0 / mbps);
+    printf("%-9s %9s %8s %7s %6s %9s %10s %9s %12s %10s %10s\n",
+           "mode", "recv", "lost", "reord", "txdrop", "Mbps", "cpu ns/pkt",
+           "gap us", "jitter sd us", "p99 us", "max us");
+
+    const uint8_t modes[] = {RAW_TX_SUBMIT_RING, RAW_TX_SUBMIT_SENDMMSG, RAW_TX_SUBMIT_IO_URING};
+    int ret = 0;
+    for (uint32_t i = 0; i < sizeof(modes); i++) {
+        struct bench_result r;
+        uint8_t used;
+        if (bench_run(modes[i], i + 1, tx_if, rx_if, mbps, packets, size, &r, &used) < 0) {
+            printf("%-9s setup failed\n", raw_tx_submit_name(modes[i]));
+            ret = 1;
+            continue;
+        }
+        printf("%-9s %9lu %8lu %7lu %6lu %9.1f %10.0f %9.3f %12.3f %10.3f %10.3f%s\n",
+               raw_tx_submit_name(used), (unsigned long)r.received, (unsigned long)r.lost,
+               (unsigned long)r.reordered, (unsigned long)r.tx_dropped, r.rx_mbps,
+               (double)r.cpu_ns / (double)r.sent, r.gap_mean_us, r.jitter_stdev_us,
+               r.jitter_p99_us, r.jitter_max_us, used != modes[i] ? " (fallback)" : "");
+    }
+    return ret;
+}
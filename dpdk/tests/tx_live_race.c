@@ -0,0 +1,136 @@
+// ==========================================
+// TX LIVE ATTACH / PUBLISH RACE TEST
+// ==========================================
+// Kontrol thread'i sürekli yeni parametre bloğu yayınlarken (tx_live_set_rate)
+// worker thread'i attach → sync → detach döngüsündedir (worker yeniden
+// başlatılması). tx_live.c doğrudan derlenir, rte_free yerine karantina
+// kullanılır: serbest bırakılan blok zehirlenir ve bir süre geri verilmez.
+// Worker'ın elindeki blok zehirliyse tx_live_reclaim onu erken bırakmıştır.
+//
+//   make test                 (--no-huge, root gerekmez)
+//   ./tests/tx_live_race <EAL args> [-- <seconds>]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <rte_eal.h>
+#include <rte_malloc.h>
+#include <rte_cycles.h>
+
+static void tx_live_test_free(void *ptr);
+#define rte_free(p) tx_live_test_free(p)
+#include "../src/tx_live.c"
+#undef rte_free
+
+// tx_live.c packet.h'tan alır (packet_manager.c burada link edilmiyor)
+uint16_t imix_pattern[IMIX_PATTERN_SIZE] = IMIX_PATTERN_INIT;
+
+#define TEST_PORT           0
+#define TEST_VL_RANGE       8
+#define TEST_DEFAULT_SEC    3
+#define TEST_QUARANTINE     4096            // Geri verilmeden tutulan blok
+#define TEST_SYNCS          16              // Attach başına sync turu
+#define TEST_POISON         0xA5A5A5A5A5A5A5A5ULL
+
+static void *quarantine[TEST_QUARANTINE];
+static uint32_t quarantine_pos = 0;
+static uint64_t freed_blocks = 0;
+
+static volatile bool test_stop = false;
+static uint64_t worker_attaches = 0;
+static uint64_t worker_switches = 0;
+static uint64_t worker_poisoned = 0;
+
+// Yalnızca kontrol thread'i çağırır (tx_live_reclaim)
+static void tx_live_test_free(void *ptr)
+{
+    if (ptr == NULL)
+        return;
+    memset(ptr, 0xA5, sizeof(struct tx_live_params));
+    if (quarantine[quarantine_pos] != NULL)
+        rte_free(quarantine[quarantine_pos]);
+    quarantine[quarantine_pos] = ptr;
+    quarantine_pos = (quarantine_pos + 1) % TEST_QUARANTINE;
+    freed_blocks++;
+}
+
+static inline void check_block(const struct tx_live_params *p)
+{
+    if (unlikely(__atomic_load_n(&p->gen, __ATOMIC_RELAXED) == TEST_POISON ||
+                 __atomic_load_n(&p->vl_count, __ATOMIC_RELAXED) == 0xA5A5))
+        worker_poisoned++;
+}
+
+static void *worker_main(void *arg)
+{
+    struct tx_live_slot *s = arg;
+
+    while (!test_stop) {
+        const struct tx_live_params *p = tx_live_attach(s);
+        for (int i = 0; i < TEST_SYNCS; i++) {
+            check_block(p);
+            if (tx_live_sync(s, &p))
+                worker_switches++;
+            check_block(p);
+        }
+        tx_live_detach(s);
+        worker_attaches++;
+    }
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    int ret = rte_eal_init(argc, argv);
+    if (ret < 0) {
+        fprintf(stderr, "EAL init failed\n");
+        return 1;
+    }
+    argc -= ret;
+    argv += ret;
+    const int seconds = (argc > 1 && atoi(argv[1]) > 0) ? atoi(argv[1]) : TEST_DEFAULT_SEC;
+
+#if !TX_LIVE_ACTIVE
+    printf("tx_live_race: SKIPPED (live TX changes disabled in this build)\n");
+    rte_eal_cleanup();
+    return 0;
+#endif
+
+    struct tx_live_slot *s = tx_live_register(TEST_PORT, 0, TEST_VL_RANGE, 1.0, SOCKET_ID_ANY);
+    if (s == NULL) {
+        fprintf(stderr, "tx_live_register failed\n");
+        return 1;
+    }
+
+    pthread_t worker;
+    if (pthread_create(&worker, NULL, worker_main, s) != 0) {
+        fprintf(stderr, "pthread_create failed\n");
+        return 1;
+    }
+
+    const uint64_t deadline = rte_get_tsc_cycles() + rte_get_tsc_hz() * (uint64_t)seconds;
+    uint64_t publishes = 0, busy = 0;
+    double rate = 1.0;
+
+    while (rte_get_tsc_cycles() < deadline) {
+        rate = rate == 1.0 ? 2.0 : 1.0;
+        if (tx_live_set_rate(TEST_PORT, rate) > 0)
+            publishes++;
+        else
+            busy++;
+    }
+
+    test_stop = true;
+    pthread_join(worker, NULL);
+
+    const bool ok = worker_poisoned == 0 && publishes > 0 && worker_attaches > 0;
+    printf("tx_live_race: %lu publishes (%lu busy), %lu blocks freed, %lu attaches, "
+           "%lu switches, %lu freed-block reads: %s\n",
+           (unsigned long)publishes, (unsigned long)busy, (unsigned long)freed_blocks,
+           (unsigned long)worker_attaches, (unsigned long)worker_switches,
+           (unsigned long)worker_poisoned, ok ? "PASS" : "FAIL");
+
+    rte_eal_cleanup();
+    return ok ? 0 : 1;
+}